@@ -1,11 +1,11 @@
-I = h5info('FLU_VAR.h5');
-[TN, seq_T] = sort({I.Groups(:).Name});
-N = size(seq_T,2);
-rho_p = h5read('FLU_VAR.h5',[TN{2},'/RHO']);
-u_p   = h5read('FLU_VAR.h5',[TN{2},'/U']);
-e_p   = h5read('FLU_VAR.h5',[TN{2},'/E'])-0.5*u_p.^2;
-x_p   = h5read('FLU_VAR.h5',[TN{2},'/X']);
-time_plot = h5readatt('FLU_VAR.h5',TN{2},'time_plot');
+% Each dataset is an (m*N) array of the N snapshots.
+time_plot = h5readatt('FLU_VAR.h5','/','time_plot');
+N = length(time_plot);
+rho_p = h5read('FLU_VAR.h5','/RHO',[1,N],[Inf,1]);
+u_p   = h5read('FLU_VAR.h5','/U',[1,N],[Inf,1]);
+e_p   = h5read('FLU_VAR.h5','/E',[1,N],[Inf,1])-0.5*u_p.^2;
+x_p   = h5read('FLU_VAR.h5','/X',[1,N],[Inf,1]);
+time_plot = time_plot(N);
 figure(1)
 hold on
 plot(x_p,rho_p,'rx');
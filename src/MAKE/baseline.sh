@@ -0,0 +1,155 @@
+#!/bin/bash
+
+### Performance baselines of the benchmark suite and the comparison of new runs against them
+# Run in 'src/MAKE' after building the hydrocodes (e.g. 'make all baseline RELEASE=1', 'make perf_compare').
+#   bash baseline.sh record   Run the suite BENCH_REPEAT times and write the baseline file.
+#   bash baseline.sh compare  Run the suite again and flag the significant slowdowns against the baseline.
+#   bash baseline.sh bisect   Compare as above and rank the phases by their slowdowns,
+#                             the exit status is that of 'git bisect run' (0: good, 1: bad, 125: skip).
+# The baseline file is a CSV file of format version 1, its comment lines record the commit and the host,
+# and each row is the sample number, mean and standard deviation of a metric of a case over the repeated runs:
+#   hydrocode,example,scheme,coordinate,scale,threads,metric,n,mean,sd
+# The metrics are the cell updates per second, the solver wall time and the wall times of the phases.
+# A slowdown is flagged if the lower bound of its 95% confidence interval (Welch) is above BENCH_TOL.
+#   BENCH_BASELINE: Baseline file (Default: data_out/benchmark/baseline.csv), it may be committed for a machine.
+#   BENCH_REPEAT:   Number of the repeated runs of each case (Default: 5)
+#   BENCH_TOL:      Relative slowdown tolerated (Default: 0.02)
+#   BENCH_PHASE:    Metric deciding the exit status of 'bisect' (Default: cell_updates_per_s), e.g. riemann_s.
+#   BENCH_COMPARE:  CSV output of the comparison (Default: data_out/benchmark/compare.csv)
+#   BENCH_CASES, BENCH_THREADS and MRun are passed to 'benchmark.sh', BENCH_SCALES defaults to "1".
+
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+MODE=${1:-compare}
+BASE=${BENCH_BASELINE:-$SRC/../data_out/benchmark/baseline.csv}
+REPEAT=${BENCH_REPEAT:-5}
+TOL=${BENCH_TOL:-0.02}
+METRIC=${BENCH_PHASE:-cell_updates_per_s}
+OUT=${BENCH_COMPARE:-$SRC/../data_out/benchmark/compare.csv}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+# run the suite REPEAT times into one benchmark CSV file
+suite() {
+    local r
+    for r in $(seq 1 $REPEAT); do
+	echo "Repeat $r of $REPEAT"
+	BENCH_SCALES=${BENCH_SCALES:-1} BENCH_OUT=$TMP/bench.csv bash "$SRC/MAKE/benchmark.sh" > /dev/null
+    done
+}
+
+# sample number, mean and standard deviation of each metric of each case of the successful runs of a benchmark CSV file
+aggregate() {
+    awk -F, 'NR == 1 {
+		 m = split("solver_s,cell_updates_per_s,slope_s,boundary_s,riemann_s,flux_s,update_s,cfl_s,output_s", name, ",")
+		 for (i = 1; i <= NF; i++) col[$i] = i
+		 next
+	     }
+	     $NF == "ok" {
+		 key = $3 "," $4 "," $5 "," $6 "," $7 "," $8
+		 if (!(key in seen)) { seen[key] = 1; order[++nk] = key }
+		 for (i = 1; i <= m; i++) {
+		     x = $col[name[i]]
+		     if (x == "") continue
+		     k = key SUBSEP name[i]
+		     n[k]++; s[k] += x; ss[k] += x*x
+		 }
+	     }
+	     END {
+		 for (j = 1; j <= nk; j++)
+		     for (i = 1; i <= m; i++) {
+			 k = order[j] SUBSEP name[i]
+			 if (!(k in n)) continue
+			 mu = s[k] / n[k]
+			 v  = n[k] > 1 ? (ss[k] - n[k]*mu*mu) / (n[k] - 1) : 0
+			 printf "%s,%s,%d,%.6g,%.6g\n", order[j], name[i], n[k], mu, (v > 0 ? sqrt(v) : 0)
+		     }
+	     }' "$1"
+}
+
+# compare the aggregated metrics of a new run with the baseline, one CSV row of each metric
+#   change: relative slowdown (>0: slower), [lo, hi]: its 95% confidence interval
+compare() {
+    awk -F, -v tol=$TOL 'BEGIN {
+		 split("12.706 4.303 3.182 2.776 2.571 2.447 2.365 2.306 2.262 2.228 2.201 2.179 2.160 2.145 2.131 " \
+		       "2.120 2.110 2.101 2.093 2.086 2.080 2.074 2.069 2.064 2.060 2.056 2.052 2.048 2.045 2.042", tq, " ")
+		 print "hydrocode,example,scheme,coordinate,scale,threads,metric,base_mean,new_mean,change,lo,hi,flag"
+	     }
+	     # the two-sided 95% quantile of the t distribution
+	     function t95(df) { df = int(df); return df < 1 ? tq[1] : (df <= 30 ? tq[df] : (df <= 60 ? 2.000 : 1.960)) }
+	     FNR == NR {
+		 if ($0 ~ /^#/ || $1 == "hydrocode") next
+		 k = $1 "," $2 "," $3 "," $4 "," $5 "," $6 "," $7
+		 bn[k] = $8; bm[k] = $9; bs[k] = $10
+		 next
+	     }
+	     {
+		 k = $1 "," $2 "," $3 "," $4 "," $5 "," $6 "," $7
+		 if (!(k in bm) || bm[k] <= 0) { printf "%s,,%s,,,,new\n", k, $9; next }
+		 n = $8; mu = $9; sd = $10
+		 va = bs[k]^2 / bn[k]; vb = sd^2 / n
+		 se = sqrt(va + vb)
+		 df = (va + vb > 0 && bn[k] > 1 && n > 1) ? (va + vb)^2 / (va^2/(bn[k]-1) + vb^2/(n-1)) : 0
+		 d  = mu - bm[k]; h = (df > 0 ? t95(df) * se : 0)
+		 # The throughput is slower if it decreases, the wall times if they increase.
+		 sg = ($7 == "cell_updates_per_s" ? -1 : 1)
+		 c  = sg * d / bm[k]
+		 lo = (sg * d - h) / bm[k]; hi = (sg * d + h) / bm[k]
+		 flag = (df > 0 && lo > tol) ? "SLOWER" : ((df > 0 && hi < -tol) ? "faster" : "")
+		 printf "%s,%.6g,%.6g,%.4f,%.4f,%.4f,%s\n", k, bm[k], mu, c, lo, hi, flag
+	     }' "$BASE" -
+}
+
+case $MODE in
+    record)
+	suite
+	[ -s "$TMP/bench.csv" ] || { echo "No benchmark results!"; exit 1; }
+	mkdir -p "$(dirname "$BASE")"
+	{
+	    echo "# hydrocode performance baseline, format 1"
+	    echo "# commit=$(git -C "$SRC" rev-parse --short HEAD 2>/dev/null || echo unknown) date=$(date +%Y-%m-%dT%H:%M:%S) host=$(hostname) repeats=$REPEAT"
+	    echo "hydrocode,example,scheme,coordinate,scale,threads,metric,n,mean,sd"
+	    aggregate "$TMP/bench.csv"
+	} > "$BASE"
+	echo "The performance baseline is written to '$BASE'."
+	;;
+    compare|bisect)
+	if [ ! -s "$BASE" ]; then
+	    echo "No performance baseline '$BASE', run 'bash baseline.sh record' first."
+	    exit $([ $MODE = bisect ] && echo 125 || echo 1)
+	fi
+	grep "^# commit=" "$BASE" | sed 's/^# /Baseline: /'
+	suite
+	if [ ! -s "$TMP/bench.csv" ]; then
+	    echo "No benchmark results!"
+	    exit $([ $MODE = bisect ] && echo 125 || echo 1)
+	fi
+	mkdir -p "$(dirname "$OUT")"
+	aggregate "$TMP/bench.csv" | compare > "$OUT"
+	if [ $MODE = compare ]; then
+	    awk -F, 'NR > 1 && ($7 == "cell_updates_per_s" || $13 != "") {
+			 printf "%-28s %-40s %-6s %-6s %-3s %-18s %10s -> %-10s %+7.2f%% [%+7.2f%%, %+7.2f%%] %s\n",
+				$1, $2, $3, $4, $6, $7, $8, $9, 100*$10, 100*$11, 100*$12, $13
+		     }' "$OUT"
+	    BAD=$(awk -F, '$7 == "cell_updates_per_s" && $13 == "SLOWER"' "$OUT" | wc -l)
+	else
+	    # the phases of each case from the most slowed down
+	    awk -F, 'NR > 1 && $7 ~ /_s$/ && $7 != "solver_s" && $7 != "cell_updates_per_s" && $11 != ""' "$OUT" | sort -t, -k1,6 -k11,11gr \
+		| awk -F, '{
+			     key = $1 "," $2 "," $3 "," $4 "," $5 "," $6
+			     if (key != last) printf "%s %s %s %s (scale = %s, threads = %s)\n", $1, $2, $3, $4, $5, $6
+			     last = key
+			     printf "    %-12s %+7.2f%% [%+7.2f%%, %+7.2f%%] %s\n", $7, 100*$10, 100*$11, 100*$12, $13
+			 }'
+	    BAD=$(awk -F, -v m=$METRIC '$7 == m && $13 == "SLOWER"' "$OUT" | wc -l)
+	fi
+	echo "The comparison is written to '$OUT'."
+	if [ $BAD -gt 0 ]; then
+	    echo "Significant slowdowns of $([ $MODE = bisect ] && echo $METRIC || echo the throughput) in $BAD case(s)!"
+	    exit 1
+	fi
+	;;
+    *)
+	echo "Usage: bash baseline.sh record|compare|bisect"
+	exit 4
+	;;
+esac
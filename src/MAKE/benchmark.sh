@@ -0,0 +1,143 @@
+#!/bin/bash
+
+### Benchmark suite of the hydrocodes
+# Run in 'src/MAKE' after building the hydrocodes (e.g. 'make all benchmark RELEASE=1').
+# Each case is refined by the grid scales and run with the thread counts, one CSV row per run.
+# The refined initial data are written into 'data_in/<dim>/_bench/', which is ignored by git.
+#   BENCH_SCALES:  Refinement factors of the initial grids (Default: "1 2 4")
+#   BENCH_THREADS: OpenMP thread counts (Default: "1 nproc")
+#   BENCH_CASES:   File of the cases, one 'hydrocode_dir example order[_scheme] coordinate n=C …' per line
+#   BENCH_OUT:     CSV output file (Default: data_out/benchmark/benchmark.csv)
+#   MRun:          MATLAB/Octave command producing the initial data by 'value_start.m' (Default: octave if found)
+
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+DATA_IN=$SRC/../data_in
+SCALES=${BENCH_SCALES:-"1 2 4"}
+THREADS=${BENCH_THREADS:-"1 $(nproc 2>/dev/null || echo 1)"}
+OUT=${BENCH_OUT:-$SRC/../data_out/benchmark/benchmark.csv}
+if [ -z "$MRun" ] && command -v octave > /dev/null; then
+    MRun="octave --no-gui --quiet"
+fi
+
+## Reference cases
+CASES_DEFAULT="
+hydrocode_1D                GRP_Book/6_1_LAG                          2_GRP LAG
+hydrocode_1D                GRP_Book/6_1_EUL                          2_GRP EUL
+hydrocode_1D                GRP_direct/9_1_b                          2_GRP EUL 41=1.0
+hydrocode_2D                RP2D_Positive/Config7                     2_GRP EUL
+hydrocode_2DUnstruct_2Fluid Two_Component/A3_shell/A3_shell_quarter   2_GRP Shell
+hydrocode_Radial_Lag        Radial_Symmetry/Two_Component/A3_shell    2_GRP 2 42=-2
+"
+if [ -n "$BENCH_CASES" ]; then
+    CASES=$(cat "$BENCH_CASES")
+else
+    CASES=$CASES_DEFAULT
+fi
+
+# dimension of the data_in folder of a hydrocode
+dim_dir() {
+    case $1 in
+	hydrocode_1D|hydrocode_Radial_Lag) echo one-dim ;;
+	*)                                 echo two-dim ;;
+    esac
+}
+
+# make the initial data of a case by 'value_start.m' if there is none
+data_make() {
+    local dir=$1
+    ls "$dir"/RHO.* > /dev/null 2>&1 && return 0
+    [ -f "$dir/value_start.m" ] && [ -n "$MRun" ] || return 1
+    ( cd "$dir" && $MRun --eval "value_start" > /dev/null 2>&1 )
+    ls "$dir"/RHO.* > /dev/null 2>&1
+}
+
+# refine the initial data piecewise-constantly by the factor k into a new folder
+#   $1: source folder, $2: target folder, $3: factor k, $4: 1 or 2 (dimension)
+data_refine() {
+    local src=$1 dst=$2 k=$3 d=$4 f
+    rm -rf "$dst"
+    mkdir -p "$dst"
+    for f in "$src"/*.txt "$src"/*.dat; do
+	[ -f "$f" ] || continue
+	case $(basename "$f") in
+	    time_plot.*)
+		cp "$f" "$dst" ;;
+	    config.*) # the grid sizes are refined and the grid numbers are counted again
+		awk -v k=$k -v d=$d '$1 == 3 || $1 == 13 || $1 == 14 {next}
+		     $1 == 10 || ($1 == 11 && d == 2) {$2 = $2 / k}
+		     {print}' "$f" > "$dst/$(basename "$f")" ;;
+	    *)
+		awk -v k=$k -v d=$d '{
+			 row = ""
+			 for (i = 1; i <= NF; i++)
+			     for (j = 0; j < k; j++)
+				 row = row $i "\t"
+			 for (j = 0; j < (d == 2 ? k : 1); j++)
+			     print row
+		     }' "$f" > "$dst/$(basename "$f")" ;;
+	esac
+    done
+}
+
+# value of a row of the phase timer report
+phase() {
+    awk -v name="$1" 'index($0, name "  ") == 1 {
+	     $0 = substr($0, length(name) + 1)
+	     print (NF >= 2 ? $2 : $1); exit
+	 }' "$2"
+}
+
+mkdir -p "$(dirname "$OUT")"
+if [ ! -s "$OUT" ]; then
+    echo "date,commit,hydrocode,example,scheme,coordinate,scale,threads,cells,steps,solver_s,total_s,step_s,cell_updates_per_s,peak_rss_kB,slope_s,boundary_s,riemann_s,flux_s,update_s,cfl_s,output_s,status" > "$OUT"
+fi
+DATE=$(date +%Y-%m-%dT%H:%M:%S)
+COMMIT=$(git -C "$SRC" rev-parse --short HEAD 2>/dev/null || echo unknown)
+LOG=$(mktemp)
+
+echo "$CASES" | while read -r HC EXAMPLE ORDER COORD EXTRA; do
+    [ -z "$HC" ] || [ "${HC:0:1}" = "#" ] && continue
+    DIM=$(dim_dir $HC)
+    D=1; [ $DIM = two-dim ] && D=2
+    if [ ! -x "$SRC/$HC/hydrocode.out" ]; then
+	echo "$DATE,$COMMIT,$HC,$EXAMPLE,$ORDER,$COORD,,,,,,,,,,,,,,,,,no_executable" >> "$OUT"
+	continue
+    fi
+    if ! data_make "$DATA_IN/$DIM/$EXAMPLE"; then
+	echo "$DATE,$COMMIT,$HC,$EXAMPLE,$ORDER,$COORD,,,,,,,,,,,,,,,,,no_data" >> "$OUT"
+	echo "No initial data of '$EXAMPLE', run 'value_start.m' in its folder."
+	continue
+    fi
+    for K in $SCALES; do
+	# The unstructured meshes are not refined.
+	[ $HC = hydrocode_2DUnstruct_2Fluid ] && [ $K != 1 ] && continue
+	CASE=$EXAMPLE
+	NAME=_bench/${EXAMPLE//\//_}_x$K
+	if [ $K != 1 ]; then
+	    CASE=$NAME
+	    data_refine "$DATA_IN/$DIM/$EXAMPLE" "$DATA_IN/$DIM/$CASE" $K $D
+	fi
+	for T in $THREADS; do
+	    echo "Benchmark: $HC $CASE $ORDER $COORD $EXTRA (threads = $T)"
+	    ( cd "$SRC/$HC" && OMP_NUM_THREADS=$T LD_LIBRARY_PATH=lib:$LD_LIBRARY_PATH \
+		  ./hydrocode.out $CASE $NAME $ORDER $COORD $EXTRA ) 2>&1 \
+		| sed 's/\x1b\[[0-9;]*m//g' | tr '\r' '\n' | grep -v "STEP=" > "$LOG"
+	    STATUS=${PIPESTATUS[0]}
+	    CELLS=$(grep -o "grid cell number = [0-9]*" "$LOG" | tail -1 | awk '{print $NF}')
+	    [ -z "$CELLS" ] && CELLS=$(grep -o "line = [0-9]*, column = [0-9]*" "$LOG" | tail -1 | tr -dc '0-9 ' | awk '{print $1*$2}')
+	    STEPS=$(grep -o "Time is up at time step [0-9]*" "$LOG" | tail -1 | awk '{print $NF}')
+	    SOLVER=$(grep -o "wall-clock time .* is [0-9.e+-]* seconds" "$LOG" | tail -1 | awk '{print $(NF-1)}')
+	    awk -v c="$CELLS" -v s="$STEPS" -v w="$SOLVER" -v total="$(phase Total "$LOG")" \
+		-v rss="$(phase 'Peak RSS (kB)' "$LOG")" -v st="$STATUS" \
+		-v ph="$(phase 'Slope limiter' "$LOG"),$(phase 'Boundary condition' "$LOG"),$(phase 'Riemann/GRP solver' "$LOG"),$(phase 'Flux assembly' "$LOG"),$(phase 'Conservative update' "$LOG"),$(phase 'CFL condition' "$LOG"),$(phase 'Output' "$LOG")" \
+		-v pre="$DATE,$COMMIT,$HC,$EXAMPLE,$ORDER,$COORD,$K,$T" 'BEGIN {
+		     ok = (st == 0 && s > 0 && w > 0)
+		     printf "%s,%s,%s,%s,%s,", pre, c, s, w, total
+		     if (ok) printf "%.6g,%.6g,", w/s, c*s/w; else printf ",,"
+		     printf "%s,%s,%s\n", rss, ph, (ok ? "ok" : "exit_" st)
+		 }' >> "$OUT"
+	done
+    done
+done
+rm -f "$LOG"
+echo "The benchmark results are appended to '$OUT'."
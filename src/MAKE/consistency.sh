@@ -0,0 +1,77 @@
+#!/bin/bash
+
+### Bitwise consistency check of the 1-D Lagrangian GRP paths
+# Run in 'src/MAKE' after building 'hydrocode_1D' (e.g. 'make consistency').
+# Each case is run by the default solver and by the fused sweep with each tile size, config[80],
+# and the output '.dat' files of the fused sweep should be identical byte for byte with those of the default solver.
+# If 'check_hydro_api' is built, the time steps of the library API (hydro_1D_step) are compared with the default solver
+# on the examples of the cases (without their n=C) as well.
+# The exit status is the number of the runs which differ.
+#   CONSIST_CASES: File of the cases, one 'example n=C …' per line (Default: the shipped 1-D Lagrangian cases)
+#   CONSIST_TILES: Tile sizes of the fused sweep (Default: "1 8 64")
+
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+DATA_OUT=$SRC/../data_out/one-dim/LAG_2_order
+TILES=${CONSIST_TILES:-"1 8 64"}
+
+## Reference cases
+CASES_DEFAULT="
+GRP_Book/6_1_LAG
+GRP_Book/6_2_1
+GRP_Book/6_2_3
+"
+if [ -n "$CONSIST_CASES" ]; then
+    CASES=$(cat "$CONSIST_CASES")
+else
+    CASES=$CASES_DEFAULT
+fi
+
+# run a case into the output folder '_consistency/<name>'
+#   $1: example, $2: name, $3…: n=C
+run() {
+    local example=$1 name=$2
+    shift 2
+    ( cd "$SRC/hydrocode_1D" && LD_LIBRARY_PATH=lib:$LD_LIBRARY_PATH \
+	  ./hydrocode.out "$example" "_consistency/$name" 2_GRP LAG "$@" ) > /dev/null 2>&1
+}
+
+if [ ! -x "$SRC/hydrocode_1D/hydrocode.out" ]; then
+    echo "Build 'hydrocode_1D' first!"
+    exit 1
+fi
+N_DIFF=0
+while read -r EXAMPLE EXTRA; do
+    [ -z "$EXAMPLE" ] || [ "${EXAMPLE:0:1}" = "#" ] && continue
+    NAME=${EXAMPLE//\//_}
+    if ! run $EXAMPLE ${NAME}_default $EXTRA; then
+	echo "Consistency: $EXAMPLE${EXTRA:+ $EXTRA} failed in the default solver."
+	N_DIFF=$((N_DIFF+1))
+	continue
+    fi
+    for T in $TILES; do
+	STATUS=identical
+	if ! run $EXAMPLE ${NAME}_fused$T $EXTRA 80=$T; then
+	    STATUS=failed
+	else
+	    for F in "$DATA_OUT/_consistency/${NAME}_default"/*.dat; do
+		[ "$(basename "$F")" = log.dat ] && continue
+		cmp -s "$F" "$DATA_OUT/_consistency/${NAME}_fused$T/$(basename "$F")" || STATUS="different in $(basename "$F")"
+	    done
+	fi
+	echo "Consistency: $EXAMPLE${EXTRA:+ $EXTRA}, fused sweep of tile $T: $STATUS"
+	[ "$STATUS" = identical ] || N_DIFF=$((N_DIFF+1))
+    done
+done <<< "$CASES"
+rm -rf "${DATA_OUT:?}/_consistency"
+
+## Library API
+if [ -x "$SRC/check_hydro_api/check_hydro_api.out" ]; then
+    EXAMPLES=$(while read -r EXAMPLE EXTRA; do
+		   [ -z "$EXAMPLE" ] || [ "${EXAMPLE:0:1}" = "#" ] || echo "$EXAMPLE"
+	       done <<< "$CASES")
+    OUT=$(cd "$SRC/check_hydro_api" && LD_LIBRARY_PATH=lib:$LD_LIBRARY_PATH ./check_hydro_api.out $EXAMPLES 2>&1)
+    STATUS=$?
+    grep "^Consistency" <<< "$OUT"
+    [ $STATUS -eq 0 ] || N_DIFF=$((N_DIFF+1))
+fi
+exit $N_DIFF
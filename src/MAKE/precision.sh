@@ -0,0 +1,110 @@
+#!/bin/bash
+
+### Accuracy report of the mixed-precision mode of the 2-D structured solvers
+# Run in 'src/MAKE' (e.g. 'make precision').
+# 'hydrocode_2D' is built twice, with and without '-DMIXED_PRECISION', and each case is run by both builds.
+# The differences of the output RHO, U, V and P against the all-double run are appended as one CSV row per case,
+# and 'hydrocode_2D' is rebuilt in the default double precision at last.
+#   PREC_CASES: File of the cases, one 'example order[_scheme] coordinate n=C …' per line
+#   PREC_OUT:   CSV output file (Default: data_out/precision/precision.csv)
+#   MRun:       MATLAB/Octave command producing the initial data by 'value_start.m' (Default: octave if found)
+
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+DATA_IN=$SRC/../data_in/two-dim
+DATA_OUT=$SRC/../data_out/two-dim
+OUT=${PREC_OUT:-$SRC/../data_out/precision/precision.csv}
+if [ -z "$MRun" ] && command -v octave > /dev/null; then
+    MRun="octave --no-gui --quiet"
+fi
+
+## Reference cases
+CASES_DEFAULT="
+RP2D_Positive/Config3   2_GRP EUL
+RP2D_Positive/Config7   2_GRP EUL
+RP2D_Positive/Config12  2_GRP EUL
+"
+if [ -n "$PREC_CASES" ]; then
+    CASES=$(cat "$PREC_CASES")
+else
+    CASES=$CASES_DEFAULT
+fi
+
+# make the initial data of a case by 'value_start.m' if there is none
+data_make() {
+    local dir=$1
+    ls "$dir"/RHO.* > /dev/null 2>&1 && return 0
+    [ -f "$dir/value_start.m" ] && [ -n "$MRun" ] || return 1
+    ( cd "$dir" && $MRun --eval "value_start" > /dev/null 2>&1 )
+    ls "$dir"/RHO.* > /dev/null 2>&1
+}
+
+# build 'hydrocode_2D' with the macro definitions $1 and copy it into the folder $2
+build() {
+    ( cd "$SRC/hydrocode_2D" && make clean > /dev/null && make CFLAGD="$1" > /dev/null 2>&1 ) || return 1
+    if [ -n "$2" ]; then
+	mkdir -p "$2"
+	cp -r "$SRC/hydrocode_2D/hydrocode.out" "$SRC/hydrocode_2D/lib" "$2"
+    fi
+}
+
+# L1 relative error and Linf absolute error of the fields in file $1 against file $2
+field_err() {
+    awk 'NR == FNR {for (i = 1; i <= NF; i++) r[FNR, i] = $i; nr = FNR; next}
+	 {
+	     for (i = 1; i <= NF; i++) {
+		 d = $i - r[FNR, i]; d = d < 0 ? -d : d
+		 a = r[FNR, i] < 0 ? -r[FNR, i] : r[FNR, i]
+		 s_d += d; s_a += a
+		 if (d > m) m = d
+	     }
+	 }
+	 END {printf "%.6g,%.6g", (s_a > 0 ? s_d/s_a : s_d), m}' "$2" "$1"
+}
+
+mkdir -p "$(dirname "$OUT")"
+if [ ! -s "$OUT" ]; then
+    echo "date,commit,example,scheme,coordinate,RHO_L1,RHO_Linf,U_L1,U_Linf,V_L1,V_Linf,P_L1,P_Linf,solver_double_s,solver_mixed_s,status" > "$OUT"
+fi
+DATE=$(date +%Y-%m-%dT%H:%M:%S)
+COMMIT=$(git -C "$SRC" rev-parse --short HEAD 2>/dev/null || echo unknown)
+TMP=$(mktemp -d)
+
+CFLAGD_DEF="-DHDF5PLOT -DNOTECPLOT"
+if ! build "$CFLAGD_DEF -DMIXED_PRECISION" "$TMP/mixed" || ! build "$CFLAGD_DEF" "$TMP/double"; then
+    echo "Building 'hydrocode_2D' failed!"
+    rm -rf "$TMP"
+    exit 1
+fi
+
+echo "$CASES" | while read -r EXAMPLE ORDER COORD EXTRA; do
+    [ -z "$EXAMPLE" ] || [ "${EXAMPLE:0:1}" = "#" ] && continue
+    if ! data_make "$DATA_IN/$EXAMPLE"; then
+	echo "$DATE,$COMMIT,$EXAMPLE,$ORDER,$COORD,,,,,,,,,,,no_data" >> "$OUT"
+	echo "No initial data of '$EXAMPLE', run 'value_start.m' in its folder."
+	continue
+    fi
+    STATUS=ok
+    for P in double mixed; do
+	NAME=_precision/${EXAMPLE//\//_}_$P
+	echo "Precision: $EXAMPLE $ORDER $COORD $EXTRA ($P)"
+	( cd "$SRC/hydrocode_2D" && LD_LIBRARY_PATH=$TMP/$P/lib:$LD_LIBRARY_PATH \
+	      "$TMP/$P/hydrocode.out" $EXAMPLE $NAME $ORDER $COORD $EXTRA ) 2>&1 \
+	    | sed 's/\x1b\[[0-9;]*m//g' | tr '\r' '\n' | grep -v "STEP=" > "$TMP/$P.log"
+	[ ${PIPESTATUS[0]} = 0 ] || STATUS=exit_$P
+	eval "SOLVER_$P=$(grep -o "wall-clock time .* is [0-9.e+-]* seconds" "$TMP/$P.log" | tail -1 | awk '{print $(NF-1)}')"
+	eval "DIR_$P=$DATA_OUT/${COORD}_${ORDER%%_*}_order/$NAME"
+    done
+    ERR=""
+    for F in RHO U V P; do
+	if [ "$STATUS" = ok ] && [ -f "$DIR_double/$F.dat" ] && [ -f "$DIR_mixed/$F.dat" ]; then
+	    ERR=$ERR$(field_err "$DIR_mixed/$F.dat" "$DIR_double/$F.dat"),
+	else
+	    ERR=$ERR,,
+	    [ "$STATUS" = ok ] && STATUS=no_output
+	fi
+    done
+    echo "$DATE,$COMMIT,$EXAMPLE,$ORDER,$COORD,$ERR$SOLVER_double,$SOLVER_mixed,$STATUS" >> "$OUT"
+done
+rm -rf "$TMP"
+( cd "$SRC/hydrocode_2D" && make clean > /dev/null && make > /dev/null 2>&1 )
+echo "The precision report is appended to '$OUT'."
@@ -0,0 +1,32 @@
+#!/bin/bash
+
+### Tuning of the tile lengths of the 2-D flux sweeps and updates
+# Run in 'src/MAKE' after building 'hydrocode_2D' (e.g. 'make tiling RELEASE=1').
+# The case is run by 'benchmark.sh' with each pair of tile lengths 'b_y x b_x', config[49] and config[50],
+# and the benchmark rows are appended to the CSV output with the tile lengths in front.
+#   TILE_SIZES:  Pairs of tile lengths 'b_y:b_x' (Default: "1:1 32:8 64:16 128:16 256:16 256:64 4096:1")
+#   TILE_CASE:   The case 'example order[_scheme] coordinate n=C …' (Default: RP2D_Positive/Config7 2_GRP EUL)
+#   TILE_SCALES: Refinement factors of the initial grids (Default: "4")
+#   TILE_OUT:    CSV output file (Default: data_out/benchmark/tiling.csv)
+#   BENCH_THREADS and MRun are passed to 'benchmark.sh'.
+
+SRC=$(cd "$(dirname "$0")/.." && pwd)
+SIZES=${TILE_SIZES:-"1:1 32:8 64:16 128:16 256:16 256:64 4096:1"}
+CASE=${TILE_CASE:-"RP2D_Positive/Config7 2_GRP EUL"}
+OUT=${TILE_OUT:-$SRC/../data_out/benchmark/tiling.csv}
+TMP=$(mktemp -d)
+
+mkdir -p "$(dirname "$OUT")"
+for S in $SIZES; do
+    B_Y=${S%%:*}
+    B_X=${S##*:}
+    echo "hydrocode_2D $CASE 49=$B_Y 50=$B_X" > "$TMP/case"
+    rm -f "$TMP/bench.csv"
+    BENCH_CASES=$TMP/case BENCH_SCALES=${TILE_SCALES:-4} BENCH_OUT=$TMP/bench.csv bash "$SRC/MAKE/benchmark.sh"
+    if [ ! -s "$OUT" ]; then
+	echo "b_y,b_x,$(head -1 "$TMP/bench.csv")" > "$OUT"
+    fi
+    tail -n +2 "$TMP/bench.csv" | sed "s/^/$B_Y,$B_X,/" >> "$OUT"
+done
+rm -rf "$TMP"
+echo "The tiling results are appended to '$OUT'."
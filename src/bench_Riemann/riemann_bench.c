@@ -0,0 +1,733 @@
+/**
+ * @file  riemann_bench.c
+ * @brief This is a C file of the main function of the Riemann solver microbenchmark and accuracy harness.
+ */
+
+/**
+ * @mainpage Microbenchmark and accuracy harness of the Riemann solvers
+ * @brief This program times the exact/approximate Riemann solvers and the GRP solvers on sets of interface states,
+ *        and measures their errors against a reference exact Riemann solver in extended precision.
+ *
+ * @section State_sets State sets
+ *          The states are drawn by a xorshift generator from the seed, so that the sets are reproducible.
+ * <table>
+ * <tr><th> random         <td> Moderate jumps of density, velocity and pressure (γ = 1.4)
+ * <tr><th> strong_shock   <td> Pressure ratios from 1e2 to 1e6 and colliding streams (γ = 1.4)
+ * <tr><th> near_vacuum    <td> Receding streams up to 99% of the vacuum generation velocity (γ = 1.4)
+ * <tr><th> gamma_contrast <td> A gas of 1.05 ≤ γ ≤ 1.67 against a stiff fluid of 3 ≤ γ ≤ 7 with density ratios up to 1e5
+ * </table>
+ *          The single-component solvers are not run on the set 'gamma_contrast'.
+ *
+ * @section Errors Errors
+ *          The outputs of a solver are compared with the reference solution in one of three kinds.
+ * <table>
+ * <tr><th> star <td> Velocity and pressure in the star region, relative to (c_L+c_R) and p_star
+ * <tr><th> axis <td> Density, velocity and pressure at the t-axis, relative to the largest initial density, speed and pressure
+ * <tr><th> flux <td> Mass, momentum and energy fluxes at the t-axis, relative to the scales of the largest initial state
+ * </table>
+ *          The largest of the component errors of an interface is given as its error.
+ *
+ * @section Program_structure Program structure
+ * <table>
+ * <tr><th> include/                          <td> Header files
+ * <tr><th> tools/                            <td> Tool functions
+ * <tr><th> riemann_solver/                   <td> Riemann solver programs
+ * <tr><th> bench_Riemann/riemann_bench.c     <td> Main program
+ * </table>
+ *
+ * @section Exit_status Program exit status code
+ * <table>
+ * <tr><th> exit(0)  <td> EXIT_SUCCESS
+ * <tr><th> exit(4)  <td> Arguments error
+ * <tr><th> exit(5)  <td> Memory error
+ * </table>
+ *
+ * @section Usage_description Usage description
+ *          - Compile in 'src/bench_Riemann': Run 'make' (or 'make RELEASE=1' for the timings) on the terminal.
+ *          - Run 'riemann_bench.out [number_of_states [repetitions [seed]]]' command on the terminal,
+ *            e.g. 'shell/riemann_bench_run.sh'.
+ *            - number_of_states: Number of interfaces in each set (default 4096).
+ *            - repetitions: Number of timed sweeps over each set, whose fastest one is reported (default 20).
+ *            - seed: Seed of the state generator (default 1).
+ *          - The time per interface includes the packing of the states into the interfacial variables,
+ *            as in the finite volume schemes.
+ *          - The errors of the vector math of the batched solvers are compared with those of the scalar libm
+ *            by a second build with 'make RELEASE=1 CFLAGD="-DMULTIFLUID_BASICS -DVMATH_SCALAR"'.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "../include/var_struc.h"
+#include "../include/riemann_solver.h"
+#include "../include/tools.h"
+
+
+struct run_ctx run_ctx_global; //!< Run context of the process.
+
+#define N_SET 4 //!< Number of the state sets.
+static const char * set_name[N_SET] = {"random", "strong_shock", "near_vacuum", "gamma_contrast"};
+
+//! Kinds of the outputs of a solver compared with the reference solution.
+enum bench_kind {
+	BK_STAR, //!< (u_star, p_star)
+	BK_AXIS, //!< (rho, u, p) at the t-axis
+	BK_FLUX  //!< (mass, momentum, energy) fluxes at the t-axis
+};
+static const char * kind_name[] = {"star", "axis", "flux"};
+
+//! A set of interface states (structure of arrays) and its reference solution.
+struct bench_set {
+	int n;                               //!< Number of interfaces.
+	double * rho[2], * u[2], * p[2];     //!< Left/Right initial states.
+	double * c[2], * gamma[2];           //!< Left/Right sound speeds and specific heat ratios.
+	double * zero, * one;                //!< Zero slopes and tangential velocities, unit normal x-coordinates.
+	double * ref[3];                     //!< Reference outputs, in the order of the kind.
+	double * scale[3];                   //!< Scales of the errors of the reference outputs.
+	long double * u_star, * p_star;      //!< Reference star state.
+	long double * axis[3], * flux[3];    //!< Reference state and fluxes at the t-axis.
+};
+
+//! Outputs of a sweep of a solver over a set (structure of arrays).
+struct bench_out {
+	double * D[4], * U[6], * F[4], * lm; //!< Scratch outputs of the solvers.
+	double * q[3];                       //!< Outputs compared with the reference, pointing into the scratch.
+};
+
+typedef void bench_fn(const struct bench_set * s, struct bench_out * o);
+
+//! A solver call under test.
+struct bench_solver {
+	const char * name;    //!< Name of the solver function.
+	const char * call;    //!< 'scalar' or 'batch' call.
+	enum bench_kind kind; //!< Kind of the compared outputs.
+	_Bool two_gamma;      //!< Whether the solver allows different specific heat ratios on both sides.
+	bench_fn * fn;        //!< Sweep of the solver over a set.
+};
+
+static struct gamma_const gc_bench; //!< Constants of γ = 1.4 for the solvers with a constant gamma.
+volatile double bench_sink;         //!< Sink of the outputs, which keeps the timed sweeps from being optimized away.
+
+
+/**
+ * @brief xorshift64* pseudo-random number generator.
+ * @param[in,out] x: State of the generator (nonzero).
+ * @return A uniformly distributed number in [0,1).
+ */
+static double rand_uniform(unsigned long long * x)
+{
+	*x ^= *x >> 12;
+	*x ^= *x << 25;
+	*x ^= *x >> 27;
+	return (double)((*x * 2685821657736338717ULL) >> 11) * 0x1.0p-53;
+}
+
+static double rand_range(unsigned long long * x, const double a, const double b)
+{
+	return a + (b-a)*rand_uniform(x);
+}
+
+//! A log-uniformly distributed number in [a,b).
+static double rand_log(unsigned long long * x, const double a, const double b)
+{
+	return a*pow(b/a, rand_uniform(x));
+}
+
+
+/**
+ * @brief The pressure function of the exact Riemann solver on one side in extended precision.
+ * @param[out] df: Derivative of the function.
+ * @param[in] p: Pressure in the star region.
+ * @param[in] rho_K, p_K, c_K, gamma: Initial state on the side.
+ * @return Velocity change across the wave on the side.
+ */
+static long double ref_f(long double * df, const long double p,
+			 const long double rho_K, const long double p_K, const long double c_K, const long double gamma)
+{
+	if (p > p_K)
+		{
+			const long double A = 2.0L/((gamma+1.0L)*rho_K), B = (gamma-1.0L)/(gamma+1.0L)*p_K;
+			const long double sq = sqrtl(A/(p+B));
+			*df = sq*(1.0L - 0.5L*(p-p_K)/(p+B));
+			return (p-p_K)*sq;
+		}
+	const long double pr = p/p_K;
+	*df = powl(pr, -0.5L*(gamma+1.0L)/gamma)/(rho_K*c_K);
+	return 2.0L*c_K/(gamma-1.0L)*(powl(pr, 0.5L*(gamma-1.0L)/gamma) - 1.0L);
+}
+
+/**
+ * @brief The reference exact Riemann solver, which samples the solution at the t-axis in extended precision.
+ * @details The pressure is found by the Newton iteration safeguarded by bisection on a bracket,
+ *          so that it converges to the rounding error of long double for all states without vacuum.
+ * @param[in] s: The state set.
+ * @param[in] i: Index of the interface.
+ */
+static void ref_solve(struct bench_set * s, const int i)
+{
+	const long double rho_L = s->rho[0][i], rho_R = s->rho[1][i];
+	const long double u_L = s->u[0][i], u_R = s->u[1][i], p_L = s->p[0][i], p_R = s->p[1][i];
+	const long double gL = s->gamma[0][i], gR = s->gamma[1][i];
+	const long double c_L = sqrtl(gL*p_L/rho_L), c_R = sqrtl(gR*p_R/rho_R);
+	long double dfL, dfR, f, lo = 0.0L, hi = fmaxl(p_L, p_R), p, dp;
+	int k;
+
+	while (ref_f(&dfL, hi, rho_L, p_L, c_L, gL) + ref_f(&dfR, hi, rho_R, p_R, c_R, gR) + u_R-u_L < 0.0L)
+		hi *= 2.0L;
+	p = 0.5L*hi;
+	for (k = 0; k < 500; k++)
+		{
+			f = ref_f(&dfL, p, rho_L, p_L, c_L, gL) + ref_f(&dfR, p, rho_R, p_R, c_R, gR) + u_R-u_L;
+			if (f < 0.0L)
+				lo = p;
+			else
+				hi = p;
+			dp = f/(dfL+dfR);
+			if (p-dp <= lo || p-dp >= hi)
+				dp = p - 0.5L*(lo+hi);
+			p -= dp;
+			if (fabsl(dp) <= 4.0L*LDBL_EPSILON*p || hi-lo <= 4.0L*LDBL_EPSILON*p)
+				break;
+		}
+	const long double u = 0.5L*(u_L+u_R) + 0.5L*(ref_f(&dfR, p, rho_R, p_R, c_R, gR) - ref_f(&dfL, p, rho_L, p_L, c_L, gL));
+	s->u_star[i] = u;
+	s->p_star[i] = p;
+
+	// sampling at x/t = 0 on the side of the contact discontinuity
+	const _Bool left = u >= 0.0L;
+	const long double sg  = left ? 1.0L : -1.0L;
+	const long double rho_K = left ? rho_L : rho_R, u_K = left ? u_L : u_R, p_K = left ? p_L : p_R;
+	const long double c_K = left ? c_L : c_R, gamma = left ? gL : gR;
+	const long double zeta = (gamma-1.0L)/(gamma+1.0L);
+	long double rho, v, pr;
+	if (p > p_K) // shock wave
+		{
+			const long double S = u_K - sg*c_K*sqrtl(0.5L*(gamma+1.0L)/gamma*p/p_K + 0.5L*(gamma-1.0L)/gamma);
+			if (sg*S >= 0.0L)
+				{ rho = rho_K; v = u_K; pr = p_K; }
+			else
+				{ rho = rho_K*(p/p_K + zeta)/(zeta*p/p_K + 1.0L); v = u; pr = p; }
+		}
+	else // rarefaction wave
+		{
+			const long double c_star = c_K*powl(p/p_K, 0.5L*(gamma-1.0L)/gamma);
+			if (sg*(u_K - sg*c_K) >= 0.0L)
+				{ rho = rho_K; v = u_K; pr = p_K; }
+			else if (sg*(u - sg*c_star) <= 0.0L)
+				{ rho = rho_K*powl(p/p_K, 1.0L/gamma); v = u; pr = p; }
+			else // inside the fan
+				{
+					const long double c = 2.0L/(gamma+1.0L)*(c_K + sg*0.5L*(gamma-1.0L)*u_K);
+					rho = rho_K*powl(c/c_K, 2.0L/(gamma-1.0L));
+					v   = sg*c;
+					pr  = p_K*powl(c/c_K, 2.0L*gamma/(gamma-1.0L));
+				}
+		}
+	s->axis[0][i] = rho;
+	s->axis[1][i] = v;
+	s->axis[2][i] = pr;
+	s->flux[0][i] = rho*v;
+	s->flux[1][i] = rho*v*v + pr;
+	s->flux[2][i] = (pr/(gamma-1.0L) + 0.5L*rho*v*v + pr)*v;
+}
+
+
+/**
+ * @brief This function draws the states of a set and solves its reference solution.
+ * @param[out] s: The state set.
+ * @param[in] k: Index of the set.
+ * @param[in,out] x: State of the generator.
+ */
+static void set_generate(struct bench_set * s, const int k, unsigned long long * x)
+{
+	int i, l, r;
+	double d, a, du;
+	for (i = 0; i < s->n; i++)
+		{
+			l = rand_uniform(x) < 0.5; // random side of the larger value
+			r = 1-l;
+			s->gamma[0][i] = s->gamma[1][i] = 1.4;
+			switch (k)
+				{
+				case 0:
+					for (l = 0; l < 2; l++)
+						{
+							s->rho[l][i] = rand_log(x, 0.1, 10.0);
+							s->p[l][i]   = rand_log(x, 0.1, 10.0);
+							s->u[l][i]   = rand_range(x, -1.0, 1.0);
+						}
+					break;
+				case 1:
+					s->rho[0][i] = rand_log(x, 0.1, 10.0);
+					s->rho[1][i] = rand_log(x, 0.1, 10.0);
+					if (rand_uniform(x) < 0.5) // blast wave
+						{
+							s->p[l][i] = rand_log(x, 1.0, 1e3);
+							s->p[r][i] = s->p[l][i]/rand_log(x, 1e2, 1e6);
+							s->u[0][i] = s->u[1][i] = rand_range(x, -1.0, 1.0);
+						}
+					else // colliding streams
+						{
+							s->p[0][i] = rand_log(x, 0.01, 1e3);
+							s->p[1][i] = rand_log(x, 0.01, 1e3);
+							d = rand_log(x, 1.0, 30.0)*sqrt(1.4*s->p[0][i]/s->rho[0][i]);
+							s->u[0][i] =  d;
+							s->u[1][i] = -rand_log(x, 1.0, 30.0)*sqrt(1.4*s->p[1][i]/s->rho[1][i]);
+						}
+					break;
+				case 2:
+					for (l = 0; l < 2; l++)
+						{
+							s->rho[l][i] = rand_log(x, 0.1, 10.0);
+							s->p[l][i]   = rand_log(x, 0.1, 10.0);
+						}
+					// the velocity jump is a fraction of the vacuum generation velocity 2(c_L+c_R)/(γ-1)
+					du = rand_range(x, 0.5, 0.99)*5.0*(sqrt(1.4*s->p[0][i]/s->rho[0][i]) + sqrt(1.4*s->p[1][i]/s->rho[1][i]));
+					a  = rand_range(x, -1.0, 1.0);
+					s->u[0][i] = a - 0.5*du;
+					s->u[1][i] = a + 0.5*du;
+					break;
+				case 3:
+					s->gamma[l][i] = rand_log(x, 1.05, 1.67);
+					s->gamma[r][i] = rand_range(x, 3.0, 7.0);
+					s->rho[l][i]   = rand_log(x, 0.01, 1.0);
+					s->rho[r][i]   = rand_log(x, 10.0, 1e3);
+					s->p[0][i]     = rand_log(x, 0.1, 1e3);
+					s->p[1][i]     = rand_log(x, 0.1, 1e3);
+					s->u[0][i]     = rand_range(x, -1.0, 1.0);
+					s->u[1][i]     = rand_range(x, -1.0, 1.0);
+					break;
+				}
+			for (l = 0; l < 2; l++)
+				s->c[l][i] = sqrt(s->gamma[l][i]*s->p[l][i]/s->rho[l][i]);
+			s->zero[i] = 0.0;
+			s->one[i]  = 1.0;
+
+			ref_solve(s, i);
+		}
+}
+
+/**
+ * @brief This function sets the reference outputs and the error scales of a set for a kind of outputs.
+ * @param[in,out] s: The state set.
+ * @param[in] kind: Kind of the outputs.
+ */
+static void set_reference(struct bench_set * s, const enum bench_kind kind)
+{
+	int i, j;
+	double rs, cs, ps;
+	for (i = 0; i < s->n; i++)
+		{
+			rs = fmax(s->rho[0][i], s->rho[1][i]);
+			ps = fmax(s->p[0][i], s->p[1][i]);
+			cs = fmax(s->c[0][i], s->c[1][i]) + fmax(fabs(s->u[0][i]), fabs(s->u[1][i]));
+			switch (kind)
+				{
+				case BK_STAR:
+					s->ref[0][i] = (double)s->u_star[i];
+					s->ref[1][i] = (double)s->p_star[i];
+					s->scale[0][i] = s->c[0][i] + s->c[1][i];
+					s->scale[1][i] = (double)s->p_star[i];
+					s->ref[2][i] = s->scale[2][i] = 0.0;
+					break;
+				case BK_AXIS:
+					for (j = 0; j < 3; j++)
+						s->ref[j][i] = (double)s->axis[j][i];
+					s->scale[0][i] = rs;
+					s->scale[1][i] = cs;
+					s->scale[2][i] = ps;
+					break;
+				case BK_FLUX:
+					for (j = 0; j < 3; j++)
+						s->ref[j][i] = (double)s->flux[j][i];
+					s->scale[0][i] = rs*cs;
+					s->scale[1][i] = rs*cs*cs + ps;
+					s->scale[2][i] = (rs*cs*cs + ps)*cs;
+					break;
+				}
+		}
+}
+
+
+//! Packs the states of the interface i into the interfacial variables.
+static void ifv_pack(struct i_f_var * ifv_L, struct i_f_var * ifv_R, const struct bench_set * s, const int i)
+{
+	memset(ifv_L, 0, sizeof(struct i_f_var));
+	memset(ifv_R, 0, sizeof(struct i_f_var));
+	ifv_L->RHO = s->rho[0][i]; ifv_L->U = s->u[0][i]; ifv_L->P = s->p[0][i]; ifv_L->gamma = s->gamma[0][i];
+	ifv_R->RHO = s->rho[1][i]; ifv_R->U = s->u[1][i]; ifv_R->P = s->p[1][i]; ifv_R->gamma = s->gamma[1][i];
+	ifv_L->n_x = ifv_R->n_x = 1.0;
+	ifv_L->Z_a = ifv_L->PHI = 1.0;
+}
+
+//! Points the batched interfacial variables to the left (side 0) or right (side 1) states of a set.
+static void ifvb_pack(struct i_f_var_batch * b, const struct bench_set * s, const int side)
+{
+	b->RHO = s->rho[side]; b->U = s->u[side]; b->P = s->p[side]; b->gamma = s->gamma[side];
+	b->s_rho = b->s_u = b->s_p = s->zero;
+	b->V = s->zero;
+	b->n_x = s->one; b->n_y = s->zero;
+}
+
+static void star_out(struct bench_out * o, const int i, const double u_star, const double p_star)
+{
+	o->U[0][i] = u_star;
+	o->U[1][i] = p_star;
+	o->q[0] = o->U[0]; o->q[1] = o->U[1];
+}
+
+#define BENCH_EXACT(name, call)						\
+static void name(const struct bench_set * s, struct bench_out * o)	\
+{									\
+	double u_star, p_star;						\
+	_Bool CRW[2];							\
+	int i;								\
+	for (i = 0; i < s->n; i++)					\
+		{							\
+			const double gammaL = s->gamma[0][i], gammaR = s->gamma[1][i]; \
+			const double u_L = s->u[0][i], u_R = s->u[1][i], p_L = s->p[0][i], p_R = s->p[1][i]; \
+			const double c_L = sqrt(gammaL*p_L/s->rho[0][i]), c_R = sqrt(gammaR*p_R/s->rho[1][i]); \
+			(void)gammaR;					\
+			call;						\
+			star_out(o, i, u_star, p_star);			\
+		}							\
+}
+
+BENCH_EXACT(run_exact, Riemann_solver_exact(&u_star, &p_star, gammaL, gammaR, u_L, u_R, p_L, p_R, c_L, c_R, CRW, EPS, EPS, 500))
+BENCH_EXACT(run_exact_Ben, Riemann_solver_exact_Ben(&u_star, &p_star, gammaL, u_L, u_R, p_L, p_R, c_L, c_R, CRW, EPS, EPS, 500))
+BENCH_EXACT(run_exact_Toro, Riemann_solver_exact_Toro(&u_star, &p_star, gammaL, u_L, u_R, p_L, p_R, c_L, c_R, CRW, EPS, EPS, 500))
+BENCH_EXACT(run_starPU, Riemann_solver_starPU(&u_star, &p_star, gammaL, gammaR, u_L, u_R, p_L, p_R, c_L, c_R, CRW, EPS, EPS, 500))
+BENCH_EXACT(run_HLLC_star, double S[2]; HLLC_star(&u_star, &p_star, S, CRW, gammaL, gammaR, s->rho[0][i], s->rho[1][i], u_L, u_R, p_L, p_R, c_L, c_R))
+
+static void run_GRP_LAG(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var ifv_L, ifv_R;
+	double D[4], U[4];
+	int i;
+	for (i = 0; i < s->n; i++)
+		{
+			ifv_pack(&ifv_L, &ifv_R, s, i);
+			linear_GRP_solver_LAG(D, U, &ifv_L, &ifv_R, EPS, EPS);
+			star_out(o, i, U[1], U[2]);
+		}
+}
+
+static void run_GRP_LAG_batch(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var_batch b_L, b_R;
+	ifvb_pack(&b_L, s, 0);
+	ifvb_pack(&b_R, s, 1);
+	linear_GRP_solver_LAG_batch(s->n, o->D, o->U, &b_L, &b_R, EPS, EPS);
+	o->q[0] = o->U[1]; o->q[1] = o->U[2];
+}
+
+static void run_GRP_LAG_batch_gc(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var_batch b_L, b_R;
+	ifvb_pack(&b_L, s, 0);
+	ifvb_pack(&b_R, s, 1);
+	linear_GRP_solver_LAG_batch_gc(s->n, o->D, o->U, &b_L, &b_R, &gc_bench, EPS, EPS);
+	o->q[0] = o->U[1]; o->q[1] = o->U[2];
+}
+
+static void run_GRP_Edir(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var ifv_L, ifv_R;
+	double D[3], U[3];
+	int i, j;
+	for (i = 0; i < s->n; i++)
+		{
+			ifv_pack(&ifv_L, &ifv_R, s, i);
+			linear_GRP_solver_Edir(D, U, &ifv_L, &ifv_R, EPS, EPS);
+			for (j = 0; j < 3; j++)
+				o->U[j][i] = U[j];
+		}
+	for (j = 0; j < 3; j++)
+		o->q[j] = o->U[j];
+}
+
+static void run_GRP_Edir_batch(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var_batch b_L, b_R;
+	int j;
+	ifvb_pack(&b_L, s, 0);
+	ifvb_pack(&b_R, s, 1);
+	linear_GRP_solver_Edir_batch(s->n, o->D, o->U, &b_L, &b_R, EPS, EPS);
+	for (j = 0; j < 3; j++)
+		o->q[j] = o->U[j];
+}
+
+static void run_GRP_Edir_batch_gc(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var_batch b_L, b_R;
+	int j;
+	ifvb_pack(&b_L, s, 0);
+	ifvb_pack(&b_R, s, 1);
+	linear_GRP_solver_Edir_batch_gc(s->n, o->D, o->U, &b_L, &b_R, &gc_bench, EPS, EPS);
+	for (j = 0; j < 3; j++)
+		o->q[j] = o->U[j];
+}
+
+static void run_GRP_Q1D(const struct bench_set * s, struct bench_out * o, const _Bool hllc)
+{
+	struct i_f_var ifv_L, ifv_R;
+	double wave_speed[2], D[6], U[6], U_star[6];
+	int i;
+	for (i = 0; i < s->n; i++)
+		{
+			ifv_pack(&ifv_L, &ifv_R, s, i);
+			linear_GRP_solver_Edir_Q1D_gt(wave_speed, D, U, U_star, &ifv_L, &ifv_R, NULL, EPS, EPS, hllc);
+			star_out(o, i, U_star[1], U_star[3]);
+		}
+}
+
+static void run_GRP_Q1D_exact(const struct bench_set * s, struct bench_out * o)
+{
+	run_GRP_Q1D(s, o, 0);
+}
+
+static void run_GRP_Q1D_HLLC(const struct bench_set * s, struct bench_out * o)
+{
+	run_GRP_Q1D(s, o, 1);
+}
+
+//! Copies the mass, normal momentum and energy fluxes of a 2-D solver.
+static void flux_out(struct bench_out * o, const int i, const double * F, const int e)
+{
+	o->F[0][i] = F[0];
+	o->F[1][i] = F[1];
+	o->F[3][i] = F[e];
+}
+
+static void run_Roe(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var ifv_L, ifv_R;
+	double F[4];
+	int i;
+	for (i = 0; i < s->n; i++)
+		{
+			ifv_pack(&ifv_L, &ifv_R, s, i);
+			Roe_solver(F, o->lm+i, &ifv_L, &ifv_R, 0.2);
+			flux_out(o, i, F, 2);
+		}
+	o->q[0] = o->F[0]; o->q[1] = o->F[1]; o->q[2] = o->F[3];
+}
+
+static void run_Roe_2D(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var ifv_L, ifv_R;
+	double F[4];
+	int i;
+	for (i = 0; i < s->n; i++)
+		{
+			ifv_pack(&ifv_L, &ifv_R, s, i);
+			Roe_2D_solver(F, o->lm+i, &ifv_L, &ifv_R, 0.2);
+			flux_out(o, i, F, 3);
+		}
+	o->q[0] = o->F[0]; o->q[1] = o->F[1]; o->q[2] = o->F[3];
+}
+
+static void run_Roe_2D_batch(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var_batch b_L, b_R;
+	ifvb_pack(&b_L, s, 0);
+	ifvb_pack(&b_R, s, 1);
+	Roe_2D_solver_batch(s->n, o->F, o->lm, &b_L, &b_R, 0.2);
+	o->q[0] = o->F[0]; o->q[1] = o->F[1]; o->q[2] = o->F[3];
+}
+
+static void run_HLL_2D(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var ifv_L, ifv_R;
+	double F[4];
+	int i;
+	for (i = 0; i < s->n; i++)
+		{
+			ifv_pack(&ifv_L, &ifv_R, s, i);
+			HLL_2D_solver(F, o->lm+i, &ifv_L, &ifv_R);
+			flux_out(o, i, F, 3);
+		}
+	o->q[0] = o->F[0]; o->q[1] = o->F[1]; o->q[2] = o->F[3];
+}
+
+static void run_HLL_2D_batch(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var_batch b_L, b_R;
+	ifvb_pack(&b_L, s, 0);
+	ifvb_pack(&b_R, s, 1);
+	HLL_2D_solver_batch(s->n, o->F, o->lm, &b_L, &b_R);
+	o->q[0] = o->F[0]; o->q[1] = o->F[1]; o->q[2] = o->F[3];
+}
+
+static void run_HLLC_2D(const struct bench_set * s, struct bench_out * o)
+{
+	struct i_f_var ifv_L, ifv_R;
+	double F[4], U[6];
+	int i;
+	for (i = 0; i < s->n; i++)
+		{
+			ifv_pack(&ifv_L, &ifv_R, s, i);
+			HLLC_2D_solver(F, o->lm+i, U, &ifv_L, &ifv_R);
+			flux_out(o, i, F, 3);
+		}
+	o->q[0] = o->F[0]; o->q[1] = o->F[1]; o->q[2] = o->F[3];
+}
+
+static const struct bench_solver solver[] = {
+	{"Riemann_solver_exact",          "scalar", BK_STAR, 1, run_exact},
+	{"Riemann_solver_exact_Ben",      "scalar", BK_STAR, 0, run_exact_Ben},
+	{"Riemann_solver_exact_Toro",     "scalar", BK_STAR, 0, run_exact_Toro},
+	{"Riemann_solver_starPU",         "scalar", BK_STAR, 1, run_starPU},
+	{"HLLC_star",                     "scalar", BK_STAR, 1, run_HLLC_star},
+	{"linear_GRP_solver_LAG",         "scalar", BK_STAR, 1, run_GRP_LAG},
+	{"linear_GRP_solver_LAG",         "batch",  BK_STAR, 1, run_GRP_LAG_batch},
+	{"linear_GRP_solver_LAG_gc",      "batch",  BK_STAR, 0, run_GRP_LAG_batch_gc},
+	{"linear_GRP_solver_Edir_Q1D",    "scalar", BK_STAR, 1, run_GRP_Q1D_exact},
+	{"linear_GRP_solver_Edir_Q1D+HLLC", "scalar", BK_STAR, 1, run_GRP_Q1D_HLLC},
+	{"linear_GRP_solver_Edir",        "scalar", BK_AXIS, 0, run_GRP_Edir},
+	{"linear_GRP_solver_Edir",        "batch",  BK_AXIS, 0, run_GRP_Edir_batch},
+	{"linear_GRP_solver_Edir_gc",     "batch",  BK_AXIS, 0, run_GRP_Edir_batch_gc},
+	{"Roe_solver",                    "scalar", BK_FLUX, 0, run_Roe},
+	{"Roe_2D_solver",                 "scalar", BK_FLUX, 0, run_Roe_2D},
+	{"Roe_2D_solver",                 "batch",  BK_FLUX, 0, run_Roe_2D_batch},
+	{"HLL_2D_solver",                 "scalar", BK_FLUX, 0, run_HLL_2D},
+	{"HLL_2D_solver",                 "batch",  BK_FLUX, 0, run_HLL_2D_batch},
+	{"HLLC_2D_solver",                "scalar", BK_FLUX, 1, run_HLLC_2D}
+};
+
+
+/**
+ * @brief This function times a solver on a set and prints its time per interface and errors.
+ * @param[in] sv: The solver.
+ * @param[in] s: The state set with the reference outputs of the kind of the solver.
+ * @param[in,out] o: Scratch outputs.
+ * @param[in] rep: Number of timed sweeps.
+ */
+static void bench_run(const struct bench_solver * sv, const struct bench_set * s, struct bench_out * o, const int rep)
+{
+	const int nq = sv->kind == BK_STAR ? 2 : 3;
+	double t, t_min = INFINITY, err, err_max = 0.0, err_sum = 0.0, e;
+	int r, i, j, n_bad = 0;
+
+	for (r = 0; r < rep; r++)
+		{
+			t = wall_time();
+			sv->fn(s, o);
+			t = wall_time() - t;
+			t_min = fmin(t_min, t);
+			bench_sink = o->q[0][s->n-1];
+		}
+
+	for (i = 0; i < s->n; i++)
+		{
+			err = 0.0;
+			for (j = 0; j < nq; j++)
+				{
+					e = fabs(o->q[j][i] - s->ref[j][i])/s->scale[j][i];
+					err = isfinite(e) ? fmax(err, e) : INFINITY;
+				}
+			if (!isfinite(err))
+				{
+					n_bad++;
+					continue;
+				}
+			err_max  = fmax(err_max, err);
+			err_sum += err;
+		}
+	printf("  %-32s %-6s %4s %10.1f %12.3e %12.3e %7d\n", sv->name, sv->call, kind_name[sv->kind],
+	       1e9*t_min/s->n, err_max, n_bad < s->n ? err_sum/(s->n-n_bad) : NAN, n_bad);
+}
+
+
+/**
+ * @brief This is the main function which times the Riemann solvers and measures their errors on each state set.
+ * @param[in] argc: ARGument Counter.
+ * @param[in] argv: ARGument Values.
+ *            - argv[1]: Number of interfaces in each set.
+ *            - argv[2]: Number of timed sweeps.
+ *            - argv[3]: Seed of the state generator.
+ * @return Program exit status code.
+ */
+int main(int argc, char *argv[])
+{
+	const int n   = argc > 1 ? atoi(argv[1]) : 4096;
+	const int rep = argc > 2 ? atoi(argv[2]) : 20;
+	unsigned long long seed = argc > 3 ? strtoull(argv[3], NULL, 10) : 1;
+	if (argc > 4 || n <= 0 || rep <= 0)
+		{
+			fprintf(stderr, "Usage: %s [number_of_states [repetitions [seed]]]\n", argv[0]);
+			exit(4);
+		}
+	seed = seed*0x9E3779B97F4A7C15ULL + 1; // nonzero state of the generator
+
+	struct bench_set s;
+	struct bench_out o;
+	const int n_d = 10 + 2 + 6 + 4+6+4+1;
+	double * pool = malloc((size_t)n_d*n*sizeof(double));
+	long double * pool_l = malloc((size_t)8*n*sizeof(long double));
+	if (pool == NULL || pool_l == NULL)
+		{
+			fprintf(stderr, "Not enough memory for %d states!\n", n);
+			exit(5);
+		}
+	double * q = pool;
+	int j, k;
+	for (j = 0; j < 2; j++)
+		{
+			s.rho[j]   = q; q += n;
+			s.u[j]     = q; q += n;
+			s.p[j]     = q; q += n;
+			s.c[j]     = q; q += n;
+			s.gamma[j] = q; q += n;
+		}
+	s.zero = q; q += n;
+	s.one  = q; q += n;
+	for (j = 0; j < 3; j++)
+		{
+			s.ref[j]   = q; q += n;
+			s.scale[j] = q; q += n;
+		}
+	for (j = 0; j < 4; j++)
+		{
+			o.D[j] = q; q += n;
+			o.F[j] = q; q += n;
+		}
+	for (j = 0; j < 6; j++)
+		{
+			o.U[j] = q; q += n;
+		}
+	o.lm = q;
+	s.u_star = pool_l;
+	s.p_star = pool_l + n;
+	for (j = 0; j < 3; j++)
+		{
+			s.axis[j] = pool_l + (2+j)*n;
+			s.flux[j] = pool_l + (5+j)*n;
+		}
+	s.n = n;
+	gamma_const_set(&gc_bench, 1.4);
+
+	printf("Riemann solver benchmark: %d states per set, %d repetitions, seed %s\n", n, rep, argc > 3 ? argv[3] : "1");
+	printf("Vector math of the batched solvers: %s\n", VMATH_MODE);
+	for (k = 0; k < N_SET; k++)
+		{
+			set_generate(&s, k, &seed);
+			printf("\n[%s]\n  %-32s %-6s %4s %10s %12s %12s %7s\n", set_name[k],
+			       "solver", "call", "out", "ns/iface", "max err", "mean err", "failed");
+			for (j = 0; j < 3; j++)
+				{
+					set_reference(&s, (enum bench_kind)j);
+					for (size_t m = 0; m < sizeof(solver)/sizeof(solver[0]); m++)
+						if ((int)solver[m].kind == j && (solver[m].two_gamma || k != 3))
+							bench_run(solver+m, &s, &o, rep);
+				}
+		}
+
+	free(pool);
+	free(pool_l);
+	return 0;
+}
@@ -0,0 +1,13 @@
+#!/bin/bash
+
+export LD_LIBRARY_PATH=lib:$LD_LIBRARY_PATH
+
+### Run the benchmark
+EXE=./riemann_bench.out  #EXEcutable program
+
+## number_of_states repetitions seed
+ $EXE 4096 20 1
+:<<!
+ $EXE 65536 10 1
+ $EXE 4096  20 2
+!
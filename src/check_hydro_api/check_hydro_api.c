@@ -0,0 +1,189 @@
+/**
+ * @file  check_hydro_api.c
+ * @brief This is a C file of the main function of the consistency check of the library API of the 1-D hydrocode.
+ */
+
+/**
+ * @mainpage Consistency check of the library API of the 1-D Lagrangian GRP scheme
+ * @brief This program runs the time steps of hydro_1D_step() on the shipped 1-D test examples,
+ *        and compares the results with those of GRP_solver_LAG_source() on the same initial data.
+ *
+ * @section Comparison Comparison
+ *          Each example is solved up to its total time config[1] with no plotting time between,
+ *          so that the two runs take the same time steps.
+ *          The density, velocity and pressure of the cells and the grid point coordinates are compared,
+ *          and the example is 'identical' if they agree bit for bit.
+ *          The masses of the cells of the API are given by the grid point coordinates instead of the spatial step config[10],
+ *          so the results of the non-identical examples differ at the level of the rounding errors,
+ *          whose largest relative difference is reported.
+ *
+ * @section Program_structure Program structure
+ * <table>
+ * <tr><th> include/                          <td> Header files
+ * <tr><th> tools/                            <td> Tool functions
+ * <tr><th> file_io/                          <td> Program reads and writes files
+ * <tr><th> riemann_solver/                   <td> Riemann solver programs
+ * <tr><th> inter_process/                    <td> Intermediate processes in finite volume scheme
+ * <tr><th> finite_volume/                    <td> Finite volume scheme programs
+ * <tr><th> hydro_api/                        <td> Library API of the hydrocodes
+ * <tr><th> check_hydro_api/check_hydro_api.c <td> Main program
+ * </table>
+ *
+ * @section Exit_status Program exit status code
+ * <table>
+ * <tr><th> exit(0)  <td> All the examples agree within the tolerance
+ * <tr><th> exit(3)  <td> Calculation error or difference beyond the tolerance
+ * <tr><th> exit(4)  <td> Arguments error
+ * <tr><th> exit(5)  <td> Memory error
+ * </table>
+ *
+ * @section Usage_description Usage description
+ *          - Compile in 'src/check_hydro_api': Run 'make' on the terminal.
+ *          - Run 'check_hydro_api.out name_of_test_example [name_of_test_example …]' command on the terminal,
+ *            e.g. 'shell/check_hydro_api_run.sh'.
+ *          - The largest relative difference allowed is config[4] (eps) of each example.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/var_struc.h"
+#include "../include/file_io.h"
+#include "../include/finite_volume.h"
+#include "../include/hydro_api.h"
+#include "../include_cii/arena.h"
+
+
+struct run_ctx run_ctx_global; //!< Run context of the process.
+
+/**
+ * @brief This function gives the largest relative difference between two arrays.
+ * @param[in] n: Length of the arrays.
+ * @param[in] a, b: Arrays compared.
+ * @return    The largest |a-b|/max(|a|,|b|) (0 for the identical ones).
+ */
+static double rel_diff(const int n, const double * a, const double * b)
+{
+	double d = 0.0, s;
+	int j;
+	for (j = 0; j < n; j++)
+		if (a[j] != b[j])
+			{
+				s = fmax(fabs(a[j]), fabs(b[j]));
+				d = fmax(d, fabs(a[j] - b[j]) / s);
+			}
+	return d;
+}
+
+/**
+ * @brief This function solves an example by GRP_solver_LAG_source() and by hydro_1D_step(), and compares the results.
+ * @param[in] example: Name of the test example.
+ * @return Program exit status code of the example.
+ */
+static int check_example(const char * example)
+{
+	struct run_ctx * const ctx = &run_ctx_global;
+	double conf[N_CONF];
+	int N, N_plot, j, k, n_step, err, retval = 0;
+	double * time_plot = NULL;
+	for (k = 0; k < N_CONF; k++)
+		ctx->conf[k] = INFINITY;
+	ctx->conf[0] = 1.0; // dimension
+	ctx->conf[8] = 1.0; // Lagrangian coordinate
+	ctx->conf[9] = 2.0; // second order
+	struct flu_var FV0 = initialize_1D(ctx, example, &N, &N_plot, &time_plot);
+	const int    m     = (int)ctx->conf[3];
+	const double t_all = ctx->conf[1], eps = ctx->conf[4], h = ctx->conf[10], gamma = ctx->conf[6];
+	if (!isfinite(t_all) || (int)ctx->conf[2] > 1)
+		{
+			printf("'%s' is not a single-fluid example with a total time!\n", example);
+			retval = 4;
+			goto return_NULL;
+		}
+	memcpy(conf, ctx->conf, sizeof(conf));
+
+	// the arrays of the default solver (one level) and of the API
+	double * block = (double *)malloc((size_t)(7*m + 2) * sizeof(double));
+	if (block == NULL)
+		{
+			printf("NOT enough memory! check_hydro_api\n");
+			retval = 5;
+			goto return_NULL;
+		}
+	double * E = block, * X = block + m, * RHO = X + m+1, * U = RHO + m, * P = U + m, * X_api = P + m;
+	double cpu_time[1];
+	struct cell_var_stru CV = {NULL};
+	CV.RHO = &FV0.RHO;
+	CV.U   = &FV0.U;
+	CV.P   = &FV0.P;
+	CV.E   = &E;
+	for (j = 0; j <= m; j++)
+		X[j] = X_api[j] = h * j;
+	for (j = 0; j < m; j++)
+		{
+			E[j]   = 0.5*FV0.U[j]*FV0.U[j] + FV0.P[j]/(gamma - 1.0)/FV0.RHO[j];
+			RHO[j] = FV0.RHO[j];
+			U[j]   = FV0.U[j];
+			P[j]   = FV0.P[j];
+		}
+
+	N_plot = 1; // no plotting time between
+	GRP_solver_LAG_source(ctx, m, CV, &X, cpu_time, example, 1, &N_plot, time_plot);
+
+	struct hydro_1D * hd = hydro_1D_init(N_CONF, conf, m, RHO, U, P, X_api);
+	if (hd == NULL)
+		retval = 5;
+	else if ((err = hydro_1D_advance(hd, t_all, &n_step)))
+		{
+			printf("'%s': the API stopped with the error %d at time %g.\n", example, err, hydro_1D_time(hd));
+			retval = 3;
+		}
+	else
+		{
+			const double d = fmax(fmax(rel_diff(m, FV0.RHO, RHO), rel_diff(m, FV0.U, U)),
+					      fmax(rel_diff(m, FV0.P, P), rel_diff(m+1, X, X_api)));
+			if (d == 0.0)
+				printf("Consistency: %s, API of %d time steps: identical\n", example, n_step);
+			else
+				printf("Consistency: %s, API of %d time steps: largest relative difference %g\n", example, n_step, d);
+			if (n_step != (int)ctx->conf[5] || d > eps)
+				retval = 3;
+		}
+	hydro_1D_finalize(hd);
+	free(block);
+
+ return_NULL:
+	free(FV0.RHO);
+	free(FV0.U);
+	free(FV0.P);
+	free(FV0.Y);
+	free(time_plot);
+	return retval;
+}
+
+/**
+ * @brief This is the main function which checks the test examples in order.
+ * @param[in] argc: ARGument Counter.
+ * @param[in] argv: ARGument Values.
+ *            - argv[1,2,…]: Names of the test examples (e.g. GRP_Book/6_2_1).
+ * @return Program exit status code (the largest one of the examples).
+ */
+int main(int argc, char *argv[])
+{
+	int i, status, retval = 0;
+	if (argc < 2)
+		{
+			fprintf(stderr, "Usage: %s name_of_test_example [name_of_test_example …]\n", argv[0]);
+			exit(4);
+		}
+	for (i = 1; i < argc; i++)
+		{
+			status = check_example(argv[i]);
+			retval = status > retval ? status : retval;
+		}
+	Arena_workspace_dispose();
+	return retval;
+}
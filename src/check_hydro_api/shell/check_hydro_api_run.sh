@@ -0,0 +1,9 @@
+#!/bin/bash
+
+export LD_LIBRARY_PATH=lib:$LD_LIBRARY_PATH
+
+### Run the consistency check of the library API
+EXE=./check_hydro_api.out  #EXEcutable program
+
+## name_of_test_example …
+ $EXE GRP_Book/6_1_LAG GRP_Book/6_2_1 GRP_Book/6_2_3
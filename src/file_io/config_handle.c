@@ -34,38 +34,39 @@
 
 /**
  * @brief This function check whether the configuration data is reasonable and set the default.
- *        All configuration data is in tha array 'config[]'.
+ *        All configuration data is in tha array 'ctx->conf[]'.
+ * @param[in,out] ctx: Pointer to the run context.
  */
-static void config_check(void)
+static void config_check(struct run_ctx * ctx)
 {
-    const int dim = (int)config[0];
+    const int dim = (int)ctx->conf[0];
     printf("  dimension\t= %d\n", dim);
 
     // Maximum number of time steps
-    if(isfinite(config[1]) && config[1] >= 0.0)
+    if(isfinite(ctx->conf[1]) && ctx->conf[1] >= 0.0)
 	{
-	    config[5] = isfinite(config[5]) ? config[5] : (double)INT_MAX;
-	    printf("  total time\t= %g\n", config[1]);
+	    ctx->conf[5] = isfinite(ctx->conf[5]) ? ctx->conf[5] : (double)INT_MAX;
+	    printf("  total time\t= %g\n", ctx->conf[1]);
 	}
-    else if(!isfinite(config[5]))
+    else if(!isfinite(ctx->conf[5]))
 	{
 	    fprintf(stderr, "The total time or the maximum number of time steps must be setted properly!\n");
 	    exit(2);
 	}
     else
 	{
-	    config[1] = INFINITY;
-	    if(isfinite(config[16]))
+	    ctx->conf[1] = INFINITY;
+	    if(isfinite(ctx->conf[16]))
 		{
-		    printf("  total time\t= %g * %d = %g\n", config[16], (int)config[5], config[16]*(int)config[5]);
-		    printf("  delta_t\t= %g\n", config[16]);
+		    printf("  total time\t= %g * %d = %g\n", ctx->conf[16], (int)ctx->conf[5], ctx->conf[16]*(int)ctx->conf[5]);
+		    printf("  delta_t\t= %g\n", ctx->conf[16]);
 		}
 	}
-    printf("  time step\t= %d\n", (int)config[5]);
+    printf("  time step\t= %d\n", (int)ctx->conf[5]);
 	    
-    if(isinf(config[4]))
-	config[4] = EPS;
-    double eps = config[4];
+    if(isinf(ctx->conf[4]))
+	ctx->conf[4] = EPS;
+    double eps = ctx->conf[4];
     if(eps < 0.0 || eps > 0.01)
 	{
 	    fprintf(stderr, "eps(%f) should in (0, 0.01)!\n", eps);
@@ -73,93 +74,196 @@ static void config_check(void)
 	}
     printf("  eps\t\t= %g\n", eps);
 
-    if(isinf(config[6]))
-	config[6] = 1.4;
-    else if(config[6] < 1.0 + eps)
+    if(isinf(ctx->conf[6]))
+	ctx->conf[6] = 1.4;
+    else if(ctx->conf[6] < 1.0 + eps)
 	{
-	    fprintf(stderr, "The constant of the perfect gas(%f) should be larger than 1.0!\n", config[6]);
+	    fprintf(stderr, "The constant of the perfect gas(%f) should be larger than 1.0!\n", ctx->conf[6]);
 	    exit(2);
 	}
-    printf("  gamma\t\t= %g\n", config[6]);
+    printf("  gamma\t\t= %g\n", ctx->conf[6]);
 
-    if (isinf(config[7]))
+    if (isinf(ctx->conf[7]))
 	{
 	    switch(dim)
 		{
 		case 1:
-		    config[7] = 0.9;  break;
+		    ctx->conf[7] = 0.9;  break;
 		case 2:
-		    config[7] = 0.45; break;
+		    ctx->conf[7] = 0.45; break;
 		}
 	}
-    else if(config[7] > 1.0 - eps)
+    else if(ctx->conf[7] > 1.0 - eps)
 	{
-	    fprintf(stderr, "The CFL number(%f) should be smaller than 1.0.\n", config[7]);
+	    fprintf(stderr, "The CFL number(%f) should be smaller than 1.0.\n", ctx->conf[7]);
 	    exit(2);
 	}
-    printf("  CFL number\t= %g\n", config[7]);
+    printf("  CFL number\t= %g\n", ctx->conf[7]);
 
-    if(isinf(config[41]))
-	config[41] = 1.9;
-    else if(config[41] < -eps || config[41] > 2.0)
+    if(isinf(ctx->conf[41]))
+	ctx->conf[41] = 1.9;
+    else if(ctx->conf[41] < -eps || ctx->conf[41] > 2.0)
 	{
-	    fprintf(stderr, "The parameter in minmod limiter(%f) should in [0, 2)!\n", config[41]);
+	    fprintf(stderr, "The parameter in minmod limiter(%f) should in [0, 2)!\n", ctx->conf[41]);
 	    exit(2);
 	}
   
-    if(isinf(config[110]))
-	config[110] = 0.72;	
-    else if(config[110] < eps)
+    if(isinf(ctx->conf[110]))
+	ctx->conf[110] = 0.72;	
+    else if(ctx->conf[110] < eps)
 	{
-	    fprintf(stderr, "The specific heat at constant volume(%f) should be larger than 0.0!\n", config[110]);
+	    fprintf(stderr, "The specific heat at constant volume(%f) should be larger than 0.0!\n", ctx->conf[110]);
 	    exit(2);
 	}
 
     // Specie number
-    config[2]   = isfinite(config[2])   ? config[2]   : (double)1;	
+    ctx->conf[2]   = isfinite(ctx->conf[2])   ? ctx->conf[2]   : (double)1;	
     // Coordinate framework (EUL/LAG/ALE)
-    config[8]   = isfinite(config[8])   ? config[8]   : (double)0;
+    ctx->conf[8]   = isfinite(ctx->conf[8])   ? ctx->conf[8]   : (double)0;
     // r_0
-    config[20]  = isfinite(config[20])  ? config[20]  : config[10];
+    ctx->conf[20]  = isfinite(ctx->conf[20])  ? ctx->conf[20]  : ctx->conf[10];
     // Reconstruction approach (interfacial value / lsq)
-    config[30]  = isfinite(config[30])  ? config[30]  : (double)0;
+    ctx->conf[30]  = isfinite(ctx->conf[30])  ? ctx->conf[30]  : (double)0;
     // Reconstruction variable (prim_var/cons_var)
-    config[31]  = isfinite(config[31])  ? config[31]  : (double)0;
+    ctx->conf[31]  = isfinite(ctx->conf[31])  ? ctx->conf[31]  : (double)0;
     // Output initial data
-    config[32]  = isfinite(config[32])  ? config[32]  : (double)true;
+    ctx->conf[32]  = isfinite(ctx->conf[32])  ? ctx->conf[32]  : (double)true;
     // Dimensional splitting
-    config[33]  = isfinite(config[33])  ? config[33]  : (double)false;
+    ctx->conf[33]  = isfinite(ctx->conf[33])  ? ctx->conf[33]  : (double)false;
+    // Streaming output
+    ctx->conf[34]  = isfinite(ctx->conf[34])  ? ctx->conf[34]  : (double)false;
+    // Warm start of the exact Riemann solvers
+    ctx->conf[35]  = isfinite(ctx->conf[35])  ? ctx->conf[35]  : (double)false;
+    // Skipping the GRP solver in quiescent regions
+    ctx->conf[36]  = isfinite(ctx->conf[36])  ? ctx->conf[36]  : (double)false;
+    // Number of the local time levels of the 1D Lagrangian GRP scheme
+    ctx->conf[37]  = isfinite(ctx->conf[37])  ? ctx->conf[37]  : (double)0;
+    // Number of the refinement levels of the 1D Eulerian GRP scheme
+    ctx->conf[38]  = isfinite(ctx->conf[38])  ? ctx->conf[38]  : (double)0;
+    // Relative threshold of the density and pressure variations for the refinement
+    ctx->conf[39]  = isfinite(ctx->conf[39])  ? ctx->conf[39]  : 0.05;
     // Slope limiter for least square procedure (Venkatakrishnan/Barth-Jespersen)
-    config[40]  = isfinite(config[40])  ? config[40]  : (double)0;
+    ctx->conf[40]  = isfinite(ctx->conf[40])  ? ctx->conf[40]  : (double)0;
     // Parameter α in minmod limiter
-    config[41]  = isfinite(config[41])  ? config[41]  : 1.9;
+    ctx->conf[41]  = isfinite(ctx->conf[41])  ? ctx->conf[41]  : 1.9;
     // Slope limiter for minmod VIP
-    config[42]  = isfinite(config[42])  ? config[42]  : (double)1;
-    // Runge-Kutta time discretization
-    config[53]  = isfinite(config[53])  ? config[53]  : (double)false;
+    ctx->conf[42]  = isfinite(ctx->conf[42])  ? ctx->conf[42]  : (double)1;
+    // Number of the time steps between the checkpoints
+    ctx->conf[43]  = isfinite(ctx->conf[43])  ? ctx->conf[43]  : (double)0;
+    // Restart from the checkpoint
+    ctx->conf[44]  = isfinite(ctx->conf[44])  ? ctx->conf[44]  : (double)false;
+    // Compression filter of the HDF5 output
+    ctx->conf[45]  = isfinite(ctx->conf[45])  ? ctx->conf[45]  : (double)0;
+    // Shuffle filter of the HDF5 output
+    ctx->conf[46]  = isfinite(ctx->conf[46])  ? ctx->conf[46]  : (double)true;
+    // Asynchronous output of the unstructured solver
+    ctx->conf[47]  = isfinite(ctx->conf[47])  ? ctx->conf[47]  : (double)true;
+    // zlib compression level of the VTU output
+    ctx->conf[48]  = isfinite(ctx->conf[48])  ? ctx->conf[48]  : (double)0;
+    // Tile lengths of the 2-D sweeps along y and x, a tile of about 2048 cells is kept in a 512 KiB L2 cache
+    ctx->conf[49]  = isfinite(ctx->conf[49])  ? ctx->conf[49]  : (double)128;
+    ctx->conf[50]  = isfinite(ctx->conf[50])  ? ctx->conf[50]  : (double)16;
+    // Face-based flux evaluation of the unstructured solver
+    ctx->conf[51]  = isfinite(ctx->conf[51])  ? ctx->conf[51]  : (double)false;
+    // Renumbering of the unstructured mesh for the cache locality
+    ctx->conf[52]  = isfinite(ctx->conf[52])  ? ctx->conf[52]  : (double)0;
+    // Stages of the SSP Runge-Kutta time discretization (0: forward Euler)
+    ctx->conf[53]  = isfinite(ctx->conf[53])  ? ctx->conf[53]  : (double)0;
+    // Output of the renumbered unstructured mesh in the file order
+    ctx->conf[54]  = isfinite(ctx->conf[54])  ? ctx->conf[54]  : (double)false;
+    // Preprocessed mesh file '.msh.cache' of the unstructured mesh
+    ctx->conf[55]  = isfinite(ctx->conf[55])  ? ctx->conf[55]  : (double)false;
+    // Number of the time steps between the in-situ diagnostics of the radially symmetric solution
+    ctx->conf[56]  = isfinite(ctx->conf[56])  ? ctx->conf[56]  : (double)0;
+    // config[57-59]: Radii of the probes of the in-situ diagnostics (INFINITY: no probe)
     // Conservative variable (U_gamma) ργ
-    config[60]  = isfinite(config[60])  ? config[60]  : (double)false;
+    ctx->conf[60]  = isfinite(ctx->conf[60])  ? ctx->conf[60]  : (double)false;
     // v_fix: Shear velocity
-    config[61]  = isfinite(config[61])  ? config[61]  : (double)0;
+    ctx->conf[61]  = isfinite(ctx->conf[61])  ? ctx->conf[61]  : (double)0;
+    // Distance of the states of a weak jump taking the acoustic path of the 2-D GRP flux
+    ctx->conf[62]  = isfinite(ctx->conf[62])  ? ctx->conf[62]  : ctx->conf[4];
+    // Star states of the 2-D GRP flux given by the HLLC solver instead of the exact Riemann solver
+    ctx->conf[63]  = isfinite(ctx->conf[63])  ? ctx->conf[63]  : (double)false;
+    // Memory report at the plotting times
+    ctx->conf[64]  = isfinite(ctx->conf[64])  ? ctx->conf[64]  : (double)false;
+    // Dry run printing the predicted memory footprint
+    ctx->conf[65]  = isfinite(ctx->conf[65])  ? ctx->conf[65]  : (double)false;
+    // Wall-clock interval (s) of the telemetry records (0: no telemetry file)
+    ctx->conf[66]  = isfinite(ctx->conf[66])  ? ctx->conf[66]  : 0.0;
+    // Progress bar (-1: shown if the standard output is a terminal)
+    ctx->conf[67]  = isfinite(ctx->conf[67])  ? ctx->conf[67]  : (double)-1;
+    // Columns of the tiles of the task-pipelined 2-D time steps (0: phases separated by the barriers)
+    ctx->conf[68]  = isfinite(ctx->conf[68])  ? ctx->conf[68]  : (double)0;
+    // Cost-weighted chunks per thread of the flux loop of the unstructured solver (0: dynamic schedule)
+    ctx->conf[69]  = isfinite(ctx->conf[69])  ? ctx->conf[69]  : (double)8;
     // Offset of the upper and downside periodic boundary
-    config[70]  = isfinite(config[70])  ? config[70]  : (double)0;
+    ctx->conf[70]  = isfinite(ctx->conf[70])  ? ctx->conf[70]  : (double)0;
+    // Number of the passively advected species (0: No species)
+    ctx->conf[71]  = isfinite(ctx->conf[71])  ? ctx->conf[71]  : (double)0;
+    // Time steps between the batch checks of the interfaces of the 1-D GRP solvers (> 1: trusted mode)
+    ctx->conf[72]  = isfinite(ctx->conf[72])  ? ctx->conf[72]  : (double)1;
+    // Tolerance of the relative residuals of the steady state (0: No steady-state mode)
+    ctx->conf[73]  = isfinite(ctx->conf[73])  ? ctx->conf[73]  : (double)0;
+    // Local time stepping of the steady-state mode on the unstructured grids
+    ctx->conf[74]  = isfinite(ctx->conf[74])  ? ctx->conf[74]  : (double)0;
+    // Lane width of the members of an ensemble run by the batched GRP solver (0: members run one by one)
+    ctx->conf[75]  = isfinite(ctx->conf[75])  ? ctx->conf[75]  : (double)0;
+    // Minimum time step shared by the members in the lanes
+    ctx->conf[76]  = isfinite(ctx->conf[76])  ? ctx->conf[76]  : (double)0;
+    // Reproducible reductions: exact sums independent of the numbers of the threads and the processes
+    ctx->conf[77]  = isfinite(ctx->conf[77])  ? ctx->conf[77]  : (double)0;
+    // Binary Tecplot output (0: ASCII '.tec', 1: '.plt', 2: '.plt' grid file and solution files)
+    ctx->conf[78]  = isfinite(ctx->conf[78])  ? ctx->conf[78]  : (double)0;
+    // Start time of the run (time of the coarse solution of the warm start)
+    ctx->conf[79]  = isfinite(ctx->conf[79])  ? ctx->conf[79]  : (double)0;
+    // Tile size of the fused 1D Lagrangian sweep
+    ctx->conf[80]  = isfinite(ctx->conf[80])  ? ctx->conf[80]  : (double)0;
+    // Thread placement (0: by the system, 1: compact cores, 2: spread over the sockets)
+    ctx->conf[81]  = isfinite(ctx->conf[81])  ? ctx->conf[81]  : (double)0;
+    // Transparent huge pages of the large fields
+    ctx->conf[82]  = isfinite(ctx->conf[82])  ? ctx->conf[82]  : (double)0;
+    // Snapshot store (0: No, 1: lossless, 2: error-bounded lossy), which keeps the snapshots of the streaming output
+    ctx->conf[83]  = isfinite(ctx->conf[83])  ? ctx->conf[83]  : (double)0;
+    if (ctx->conf[83] > 0.0)
+	ctx->conf[34] = (double)true;
+    // Absolute error bound of the lossy snapshot store
+    ctx->conf[84]  = isfinite(ctx->conf[84])  ? ctx->conf[84]  : (double)1e-6;
+    // Interval of the time steps of the trace of the phases (0: No trace)
+    ctx->conf[85]  = isfinite(ctx->conf[85])  ? ctx->conf[85]  : (double)0;
+    // Events kept in the ring of the trace of each thread
+    ctx->conf[86]  = isfinite(ctx->conf[86])  ? ctx->conf[86]  : (double)65536;
+    // Wall-clock interval (s) of the live publish of the fields into the shared memory (0: No)
+    ctx->conf[87]  = isfinite(ctx->conf[87])  ? ctx->conf[87]  : (double)0;
+    // Stride of the downsampling of the live publish
+    ctx->conf[88]  = isfinite(ctx->conf[88])  ? ctx->conf[88]  : (double)1;
+    // Threshold of the relative jumps of the sensor of the hybrid GRP flux (0: No hybrid flux)
+    ctx->conf[89]  = isfinite(ctx->conf[89])  ? ctx->conf[89]  : (double)0;
+    // Fraction of the mean cell width below which the radial Lagrangian cells are rezoned (0: No rezoning)
+    ctx->conf[90]  = isfinite(ctx->conf[90])  ? ctx->conf[90]  : (double)0;
+    // Rate of the relaxation of the ALE grids toward the target spacing per time step
+    ctx->conf[91]  = isfinite(ctx->conf[91])  ? ctx->conf[91]  : (double)0.1;
+    // Width (cells) of the smoothing of the target spacing of the ALE grids
+    ctx->conf[92]  = isfinite(ctx->conf[92])  ? ctx->conf[92]  : (double)8;
+    // Fields of the '.dat' and HDF5 output (bits of enum out_field): RHO, U, V, P and E
+    ctx->conf[94]  = isfinite(ctx->conf[94])  ? ctx->conf[94]  : (double)31;
     // offset_x: Grid offset in x direction
-    config[210] = isfinite(config[210]) ? config[210] : 0.0;
+    ctx->conf[210] = isfinite(ctx->conf[210]) ? ctx->conf[210] : 0.0;
     // offset_y: Grid offset in y direction
-    config[211] = isfinite(config[211]) ? config[211] : 0.0;
+    ctx->conf[211] = isfinite(ctx->conf[211]) ? ctx->conf[211] : 0.0;
     // offset_z: Grid offset in z direction
-    config[212] = isfinite(config[212]) ? config[212] : 0.0;
+    ctx->conf[212] = isfinite(ctx->conf[212]) ? ctx->conf[212] : 0.0;
 }
 
 /**
  * @brief This function read the configuration data file, and
- *        store the configuration data in the array 'config[]'.
+ *        store the configuration data in the array 'ctx->conf[]'.
+ * @param[in,out] ctx: Pointer to the run context.
  * @param[in] fp: The pointer to the configuration data file.
  * @return    Configuration data file read status.
  *    @retval 1: Success to read in configuration data file. 
  *    @retval 0: Failure to read in configuration data file. 
  */
-static int config_read(FILE * fp)
+static int config_read(struct run_ctx * ctx, FILE * fp)
 {	
 	char one_line[200]; // String to store one line.
 	char *endptr;
@@ -182,11 +286,15 @@ static int config_read(FILE * fp)
 						fprintf(stderr, "Value range error of %d-th configuration in line %d of configuration file!\n", i, line_num);
 						return 1;
 					    }
-					else if(isinf(config[i]))
-					    printf("%3d-th configuration: %g\n", i, config[i] = tmp);
-					else if(fabs(config[i] - tmp) > EPS)
-					    printf("%3d-th configuration is repeatedly assigned with %g and %g(abandon)!\n", i, config[i], tmp);
+					else if(isinf(ctx->conf[i]))
+					    printf("%3d-th configuration: %g\n", i, ctx->conf[i] = tmp);
+					else if(fabs(ctx->conf[i] - tmp) > EPS)
+					    printf("%3d-th configuration is repeatedly assigned with %g and %g(abandon)!\n", i, ctx->conf[i], tmp);
 				}
+			else if (strncmp(endptr, "init", 4) == 0 && isspace(endptr[4]))
+				; // the analytic initial data read by init_gen()
+			else if (strncmp(endptr, "warm", 4) == 0 && isspace(endptr[4]))
+				; // the coarse solution read by warm_start()
 			else if (i != 0 || (*endptr != '#' && *endptr != '\0'))
 				fprintf(stderr, "Warning: unknown row occurrs in line %d of configuration file!\n", line_num);
 			line_num++;
@@ -203,9 +311,10 @@ static int config_read(FILE * fp)
 /**
  * @brief This function controls configuration data reading and validation.
  * @details The parameters in the configuration data file refer to 'doc/config.csv'.
+ * @param[in,out] ctx: Pointer to the run context.
  * @param[in] add_in: Adress of the initial data folder of the test example.
  */
-void configurate(const char * add_in)
+void configurate(struct run_ctx * ctx, const char * add_in)
 {
   FILE * fp_data;
   char add[FILENAME_MAX+40];
@@ -225,7 +334,7 @@ void configurate(const char * add_in)
       }
 
   // Read the configuration data file.
-  if(config_read(fp_data) == 0)
+  if(config_read(ctx, fp_data) == 0)
       {
 	  fclose(fp_data);
 	  exit(2);
@@ -238,22 +347,34 @@ void configurate(const char * add_in)
   printf("\x1b[42;36mConfigurated:\x1b[0m\n");
 #endif
   // Check the configuration data.
-  config_check();
+  config_check(ctx);
 }
 
 
+/**
+ * @brief This function validates the configuration data given by a caller without any configuration file,
+ *        such as the callers of the library API.
+ * @details The values not given are INFINITY, which are set to the defaults as those of configurate().
+ * @param[in,out] ctx: Pointer to the run context.
+ */
+void configurate_conf(struct run_ctx * ctx)
+{
+  config_check(ctx);
+}
+
 /**
  * @brief This function write configuration data and program record into the file 'log.dat'.
  * @details The parameters in the log file refer to 'doc/config.csv'.
- * @remark  The code of recording CPU time is commented out.
+ * @remark  The performance of the run is recorded in 'perf.json' by perf_report_write().
+ * @param[in] ctx:      Pointer to the run context.
  * @param[in] add_out:  Address of the output data folder of the test example.
  * @param[in] cpu_time: Array of the CPU time recording.
  * @param[in] name:     Name of the test example.
  */
-void config_write(const char * add_out, const double * cpu_time, const char * name)
+void config_write(const struct run_ctx * ctx, const char * add_out, const double * cpu_time, const char * name)
 {
     char file_data[FILENAME_MAX+40];
-	const int dim = (int)config[0];
+	const int dim = (int)ctx->conf[0];
     FILE * fp_write;
 
 //======================Write Log File============================
@@ -266,38 +387,23 @@ void config_write(const char * add_out, const double * cpu_time, const char * na
     exit(1);
   }
 
-  fprintf(fp_write, "%s is initialized with %d grids.\n\n", name, (int)config[3]);
+  fprintf(fp_write, "%s is initialized with %d grids.\n\n", name, (int)ctx->conf[3]);
   fprintf(fp_write, "Configurated:\n");
   fprintf(fp_write, "dim\t\t= %d\n", dim);
-  if(isfinite(config[1]))
-      fprintf(fp_write, "t_all\t= %d\n", (int)config[1]);
-  else if(isfinite(config[16]))
-      fprintf(fp_write, "tau\t\t= %g\n", config[16]);
-  fprintf(fp_write, "eps\t\t= %g\n", config[4]);
-  fprintf(fp_write, "gamma\t= %g\n", config[6]);
-  fprintf(fp_write, "CFL\t\t= %g\n", config[7]);
-  fprintf(fp_write, "h\t\t= %g\n", config[10]);
-  fprintf(fp_write, "bond\t= %d\n", (int)config[17]);
+  if(isfinite(ctx->conf[1]))
+      fprintf(fp_write, "t_all\t= %d\n", (int)ctx->conf[1]);
+  else if(isfinite(ctx->conf[16]))
+      fprintf(fp_write, "tau\t\t= %g\n", ctx->conf[16]);
+  fprintf(fp_write, "eps\t\t= %g\n", ctx->conf[4]);
+  fprintf(fp_write, "gamma\t= %g\n", ctx->conf[6]);
+  fprintf(fp_write, "CFL\t\t= %g\n", ctx->conf[7]);
+  fprintf(fp_write, "h\t\t= %g\n", ctx->conf[10]);
+  fprintf(fp_write, "bond\t= %d\n", (int)ctx->conf[17]);
   if(dim == 2)
       {
-	  fprintf(fp_write, "h_y\t\t= %g\n", config[11]);
-	  fprintf(fp_write, "bond_y\t= %d\n", (int)config[18]);
+	  fprintf(fp_write, "h_y\t\t= %g\n", ctx->conf[11]);
+	  fprintf(fp_write, "bond_y\t= %d\n", (int)ctx->conf[18]);
       }
-  fprintf(fp_write, "\nA total of %d time steps are computed.\n", (int)config[5]);
-  /*
-  double * sum = (double*)calloc(N, sizeof(double));
-  sum[0] = 0.0;
-  fprintf(fp_write, "CPU time for each step:");
-  for(k = 1; k < N; ++k)
-  {
-    fprintf(fp_write, "%.18f  ", cpu_time[k]);
-    sum[k] = sum[k-1] + cpu_time[k];
-  }
-  fprintf(fp_write, "\nTotal CPU time at each step:");
-  for(k = 1; k < N; ++k)
-    fprintf(fp_write, "%.18f  ", sum[k]);
-  free(sum);
-  sum = NULL;
-  */
+  fprintf(fp_write, "\nA total of %d time steps are computed.\n", (int)ctx->conf[5]);
   fclose(fp_write);
 }
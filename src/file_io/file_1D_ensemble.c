@@ -0,0 +1,224 @@
+/**
+ * @file  file_1D_ensemble.c
+ * @brief This is a set of functions which read the ensemble specification and write the results of 1-D runs.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/var_struc.h"
+#include "../include/tools.h"
+
+
+#define N_ENS_VALUE 64 //!< Maximum number of the values of one swept configuration.
+
+/**
+ * @brief This function reads the ensemble specification of 1-D runs.
+ * @details Each line of the specification file is a case of the form
+ *          'name_of_test_example order[_scheme] coordinate n=C1,C2,… …' as the command line arguments of
+ *          'hydrocode.out', where the values separated by commas are swept. The members of the ensemble
+ *          are the Cartesian product of the swept values of every case. A line beginning with '#' is a comment.
+ * @param[in]  add:      Address of the ensemble specification file.
+ * @param[out] EC:       Pointer to the array of the cases.
+ * @param[out] n_case:   Pointer to the number of the cases.
+ * @param[out] EM:       Pointer to the array of the members.
+ * @return \b n_member:  The number of the members (-1: reading error).
+ */
+int ensemble_1D_read(const char * add, struct ens_case ** EC, int * n_case, struct ens_member ** EM)
+{
+    FILE * fp;
+    char one_line[1024], * tok, * endptr;
+    int line_num = 0, n_member = 0, n_sweep, i, j, k, c, stride;
+    int i_conf[N_ENS_CONF], n_val[N_ENS_CONF];
+    double val[N_ENS_CONF][N_ENS_VALUE];
+    struct ens_case * C;
+    struct ens_member * M;
+
+    *EC = NULL;
+    *EM = NULL;
+    *n_case = 0;
+    if((fp = fopen(add, "r")) == NULL)
+	{
+	    printf("Cannot open ensemble specification file!\n");
+	    perror(add);
+	    return -1;
+	}
+
+    while (fgets(one_line, sizeof(one_line), fp) != NULL)
+	{
+	    line_num++;
+	    tok = strtok(one_line, " \t\r\n");
+	    if(tok == NULL || *tok == '#')
+		continue;
+	    C = (struct ens_case *)realloc(*EC, (*n_case+1) * sizeof(struct ens_case));
+	    if(C == NULL)
+		{
+		    printf("NOT enough memory! Ensemble case\n");
+		    goto return_err;
+		}
+	    *EC = C;
+	    C += *n_case;
+	    strncpy(C->example, tok, sizeof(C->example)-1);
+	    C->example[sizeof(C->example)-1] = '\0';
+	    C->order[0] = C->coord[0] = '\0';
+	    if((tok = strtok(NULL, " \t\r\n")) != NULL)
+		{
+		    strncpy(C->order, tok, sizeof(C->order)-1);
+		    C->order[sizeof(C->order)-1] = '\0';
+		}
+	    if((tok = strtok(NULL, " \t\r\n")) != NULL)
+		{
+		    strncpy(C->coord, tok, sizeof(C->coord)-1);
+		    C->coord[sizeof(C->coord)-1] = '\0';
+		}
+	    if(C->coord[0] == '\0')
+		{
+		    printf("The order or coordinate of the case is missing in line %d of ensemble specification!\n", line_num);
+		    goto return_err;
+		}
+
+	    // configuration supplements n=C1,C2,…
+	    n_sweep = 0;
+	    while((tok = strtok(NULL, " \t\r\n")) != NULL)
+		{
+		    if(n_sweep == N_ENS_CONF)
+			{
+			    printf("Too many configuration supplements in line %d of ensemble specification!\n", line_num);
+			    goto return_err;
+			}
+		    errno = 0;
+		    i_conf[n_sweep] = strtoul(tok, &endptr, 10);
+		    if(errno == ERANGE || *endptr != '=' || i_conf[n_sweep] <= 0 || i_conf[n_sweep] >= N_CONF)
+			{
+			    printf("Configuration error before '=' in line %d of ensemble specification!\n", line_num);
+			    goto return_err;
+			}
+		    n_val[n_sweep] = 0;
+		    do
+			{
+			    endptr++;
+			    errno = 0;
+			    if(n_val[n_sweep] == N_ENS_VALUE)
+				{
+				    printf("Too many swept values in line %d of ensemble specification!\n", line_num);
+				    goto return_err;
+				}
+			    val[n_sweep][n_val[n_sweep]++] = strtod(endptr, &endptr);
+			    if(errno == ERANGE || (*endptr != ',' && *endptr != '\0'))
+				{
+				    printf("Configuration error after '=' in line %d of ensemble specification!\n", line_num);
+				    goto return_err;
+				}
+			}
+		    while(*endptr == ',');
+		    n_sweep++;
+		}
+
+	    // Cartesian product of the swept values
+	    for(k = 1, i = 0; i < n_sweep; ++i)
+		k *= n_val[i];
+	    M = (struct ens_member *)realloc(*EM, (n_member+k) * sizeof(struct ens_member));
+	    if(M == NULL)
+		{
+		    printf("NOT enough memory! Ensemble member\n");
+		    goto return_err;
+		}
+	    *EM = M;
+	    for(c = 0; c < k; ++c)
+		{
+		    M = *EM + n_member + c;
+		    memset(M, 0, sizeof(struct ens_member));
+		    M->c      = *n_case;
+		    M->n_conf = n_sweep;
+		    for(stride = 1, i = n_sweep-1; i >= 0; --i)
+			{
+			    j = (c / stride) % n_val[i];
+			    M->i_conf[i] = i_conf[i];
+			    M->v_conf[i] = val[i][j];
+			    stride *= n_val[i];
+			}
+		}
+	    n_member += k;
+	    (*n_case)++;
+	}
+    if(ferror(fp))
+	{
+	    printf("Read error occurrs in ensemble specification file!\n");
+	    goto return_err;
+	}
+    fclose(fp);
+    return n_member;
+
+ return_err:
+    fclose(fp);
+    free(*EC);
+    free(*EM);
+    *EC = NULL;
+    *EM = NULL;
+    return -1;
+}
+
+
+/**
+ * @brief This function writes the results of the ensemble of 1-D runs into one file.
+ * @details The file 'ensemble.dat' begins with a table of one row for each member, followed by
+ *          the cell centers, density, velocity and pressure of each member at the final time.
+ * @param[in] results:  Name of the numerical results of the ensemble.
+ * @param[in] EC:       Array of the cases.
+ * @param[in] EM:       Array of the members.
+ * @param[in] n_member: Number of the members.
+ */
+void ensemble_1D_write(const char * results, const struct ens_case * EC, const struct ens_member * EM, const int n_member)
+{
+    char add_out[FILENAME_MAX+40];
+    FILE * fp_write;
+    int k, i, j;
+
+    strcpy(add_out, "../../data_out/one-dim/ensemble/");
+    strcat(add_out, results);
+    if(CreateDir(add_out) == 1)
+	{
+	    fprintf(stderr, "Output directory '%s' construction failed!\n", add_out);
+	    exit(1);
+	}
+    strcat(add_out, "/ensemble.dat");
+    if((fp_write = fopen(add_out, "w")) == NULL)
+	{
+	    printf("Cannot open ensemble output file!\n");
+	    exit(1);
+	}
+
+    fprintf(fp_write, "# member\tcase\texample\torder\tcoordinate\tstatus\tcells\tsteps\ttime\twall_time\tmass\tmomentum\tenergy\tconfiguration\n");
+    for(k = 0; k < n_member; ++k)
+	{
+	    fprintf(fp_write, "%d\t%d\t%s\t%s\t%s\t%d\t%d\t%d\t%.10g\t%.6g\t%.15g\t%.15g\t%.15g\t", k, EM[k].c,
+		    EC[EM[k].c].example, EC[EM[k].c].order, EC[EM[k].c].coord, EM[k].status, EM[k].m, EM[k].steps,
+		    EM[k].time, EM[k].wall, EM[k].mass, EM[k].mom, EM[k].ene);
+	    for(i = 0; i < EM[k].n_conf; ++i)
+		fprintf(fp_write, "%s%d=%.10g", i ? " " : "", EM[k].i_conf[i], EM[k].v_conf[i]);
+	    fprintf(fp_write, "\n");
+	}
+
+    for(k = 0; k < n_member; ++k)
+	{
+	    if(EM[k].X == NULL)
+		continue;
+	    fprintf(fp_write, "\n# member %d: X RHO U P\n", k);
+	    for(j = 0; j < EM[k].m; ++j)
+		fprintf(fp_write, "%.10g\t", EM[k].X[j]);
+	    fprintf(fp_write, "\n");
+	    for(j = 0; j < EM[k].m; ++j)
+		fprintf(fp_write, "%.10g\t", EM[k].RHO[j]);
+	    fprintf(fp_write, "\n");
+	    for(j = 0; j < EM[k].m; ++j)
+		fprintf(fp_write, "%.10g\t", EM[k].U[j]);
+	    fprintf(fp_write, "\n");
+	    for(j = 0; j < EM[k].m; ++j)
+		fprintf(fp_write, "%.10g\t", EM[k].P[j]);
+	    fprintf(fp_write, "\n");
+	}
+    fclose(fp_write);
+    printf("The results of %d runs are written in '%s'.\n", n_member, add_out);
+}
@@ -17,63 +17,34 @@
 #define N_MAX_1D 1000
 
 /**
- * @brief Count out and read in 1-D data of the initial fluid variable 'sfv'.
+ * @brief Count out and read in 1-D data of the initial fluid variable 'sfv' using function 'flu_var_load()'.
  *        If the initial data file does not exist, 'err_exit=1' means the program exits,
  *        while 'err_exit=0' means the program continues.
  */
 #define STR_FLU_INI(sfv, err_exit)					\
     do {								\
-	strcpy(add, add_in);						\
-	strcat(add, #sfv ".txt");					\
-	if((fp = fopen(add, "r")) == NULL)				\
-	    {								\
-		strcpy(add, add_in);					\
-		strcat(add, #sfv ".dat");				\
-	    }								\
-	if((fp = fopen(add, "r")) == NULL)				\
+	if((e = flu_var_load(add_in, #sfv, &FV0.sfv, &line, &num_cell, false)) > 1) \
+	    exit(e);							\
+	r = !e;								\
+	if(!r)								\
 	    {								\
 		printf("Cannot open initial data file: %s!\n", #sfv);	\
 		if(err_exit)						\
 		    exit(1);						\
 		r = false;						\
-	    }								\
-	if(r)								\
-	    {								\
-		num_cell = flu_var_count(fp, add);			\
-		if (num_cell < 1)					\
-		    {							\
-			printf("Error in counting fluid variables in initial data file: %s!\n", #sfv); \
-			fclose(fp);					\
-			exit(2);					\
-		    }							\
-		if(isinf(config[3]))					\
-		    config[3] = (double)num_cell;			\
-		else if(num_cell != (int)config[3])			\
-		    {							\
-			printf("Input unequal! num_%s=%d, num_cell=%d.\n", #sfv, num_cell, (int)config[3]); \
-			exit(2);					\
-		    }							\
 		FV0.sfv = (double*)malloc(num_cell * sizeof(double));	\
 		if(FV0.sfv == NULL)					\
 		    {							\
 			printf("NOT enough memory! %s\n", #sfv);	\
 			exit(5);					\
 		    }							\
-		if(flu_var_read(fp, FV0.sfv, num_cell))			\
-		    {							\
-			fclose(fp);					\
-			exit(2);					\
-		    }							\
-		fclose(fp);						\
 	    }								\
-	else								\
+	else if(isinf(ctx->conf[3]))					\
+	    ctx->conf[3] = (double)num_cell;				\
+	else if(num_cell != (int)ctx->conf[3])				\
 	    {								\
-		FV0.sfv = (double*)malloc(num_cell * sizeof(double));	\
-		if(FV0.sfv == NULL)					\
-		    {							\
-			printf("NOT enough memory! %s\n", #sfv);	\
-			exit(5);					\
-		    }							\
+		printf("Input unequal! num_%s=%d, num_cell=%d.\n", #sfv, num_cell, (int)ctx->conf[3]); \
+		exit(2);						\
 	    }								\
     } while(0)
 
@@ -83,6 +54,7 @@
   * @details    The function initialize the extern pointer FV0.RHO/U/P pointing to the
   *             position of a block of memory consisting m variables* of type double.
   *             These m variables are the initial value and the value of m is stored in config[3].
+  * @param[in,out] ctx:    Pointer to the run context.
   * @param[in]  name:      Name of the test example.
   * @param[in]  N:         Pointer to the number of 1-D data dimension storing fluid variables in memory.
   * @param[out] N_plot:    Pointer to the number of time steps for plotting.
@@ -90,28 +62,34 @@
   * @return  \b FV0:  Structure of initial fluid variable data array pointer.
   * @note This function contains the function procedures 'time_plot_read()' and 'configurate()'.
   */
-struct flu_var initialize_1D(const char * name, int * N, int * N_plot, double * time_plot[])
+struct flu_var initialize_1D(struct run_ctx * ctx, const char * name, int * N, int * N_plot, double * time_plot[])
 {
     struct flu_var FV0 = {NULL}; // Structure of initial data array pointer.
 
     char add_in[FILENAME_MAX+40]; 
     // Get the address of the initial data folder of the test example.
-    example_io(name, add_in, 1);
+    example_io(ctx, name, add_in, 1);
     
     /* 
      * Read the configuration data.
      * The detail could be seen in the definition of array config
      * referring to file 'doc/config.csv'.
      */
-    configurate(add_in);
-    printf("  delta_x\t= %g\n", config[10]);
-    printf("  bondary\t= %d\n", (int)config[17]);
+    configurate(ctx, add_in);
+    printf("  delta_x\t= %g\n", ctx->conf[10]);
+    printf("  bondary\t= %d\n", (int)ctx->conf[17]);
 
-    (*N) = time_plot_read(add_in, N_MAX_1D, N_plot, time_plot);
+    (*N) = time_plot_read(ctx, add_in, N_MAX_1D, N_plot, time_plot);
 
-    char add[FILENAME_MAX+40]; // The address of the velocity/pressure/density file to read in.
-    FILE * fp;      // The pointer to the above data files.
-    int num_cell = (int)config[3]; // The number of the numbers in the above data files.
+    if(init_gen(ctx, add_in, 1, &FV0)) // the analytic initial data of the 'init' rows
+	{
+	    species_load(ctx, add_in, (int)ctx->conf[3], false, &FV0);
+	    printf("'%s' data initialized, grid cell number = %d.\n", add_in, (int)ctx->conf[3]);
+	    return FV0;
+	}
+
+    int num_cell = (int)ctx->conf[3]; // The number of the numbers in the above data files.
+    int line, e;    // e: Error of reading the data file.
     _Bool r = true; // r: Whether to read data file successfully.
 
     // Open the initial data files and initializes the reading of data.
@@ -139,13 +117,15 @@ struct flu_var initialize_1D(const char * name, int * N, int * N_plot, double *
     if(!r)
 	{
 	    for(int i = 0; i < num_cell; i++)
-		FV0.gamma[i] = 1.0 + 1.0 / (FV0.Z_a[i]/(config[6]-1.0) + (1.0-FV0.Z_a[i])/(config[106]-1.0));
+		FV0.gamma[i] = 1.0 + 1.0 / (FV0.Z_a[i]/(ctx->conf[6]-1.0) + (1.0-FV0.Z_a[i])/(ctx->conf[106]-1.0));
 	    printf("\t Initial specific heat rate 'gamma' is initialized by volume fraction 'Z_a'.\n");
 	    r = true;
 	}
 #endif
 #endif
 
+    species_load(ctx, add_in, num_cell, false, &FV0);
+
     printf("'%s' data initialized, grid cell number = %d.\n", add_in, num_cell);
     return FV0;
 }
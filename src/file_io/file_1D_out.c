@@ -7,37 +7,93 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <time.h>
 
 #include "../include/var_struc.h"
+#include "../include/tools.h"
 #include "../include/file_io.h"
 
 
+//! Size of the buffer of the text output of a '.dat' file in bytes.
+#define TEXT_BUF_SIZE (1 << 22)
+
+//! A field of the 1-D output computed line by line from the levels of the solution when it is written.
+struct text_field_1D {
+    const struct run_ctx * ctx;
+    const struct cell_var_stru * CV; //!< the levels of the solution.
+    int f;  //!< the field (enum out_field).
+    int nt; //!< level of the first row.
+};
+
 /**
- * @brief Print out fluid variable 'v' with array data element 'v_print'.
+ * @brief This function writes the rows of a fluid variable into a '.dat' file through a large buffer.
+ * @details It writes the same text as 'fprintf(fp, "%.10g\t", v[k][j])' row by row, and a newline after each row,
+ *          but the numbers are formatted by double_to_str() and the buffer is written in one call once it is full.
+ * @param[in] add_out: Address of the output data folder.
+ * @param[in] name:    Name of the fluid variable.
+ * @param[in] mode:    Mode of opening the file ("w" or "a").
+ * @param[in] N:       The number of rows.
+ * @param[in] m:       The number of spatial points in a row.
+ * @param[in] v:       Array of the rows of the fluid variable.
+ * @param[in] mid:     Whether to write the middle values 0.5*(v[k][j]+v[k][j+1]) of the points instead.
+ * @param[in] d:       The field computed row by row instead of 'v' (NULL: the rows 'v' are written).
  */
-#define PRINT_NC(v, v_print)						\
-    do {								\
-	strcpy(file_data, add_out);					\
-	strcat(file_data, #v);						\
-	strcat(file_data, ".dat");					\
-	if((fp_write = fopen(file_data, "w")) == NULL)			\
-	    {								\
-		printf("Cannot open solution output file: %s!\n", #v);	\
-		exit(1);						\
-	    }								\
-	for(k = 0; k < N; ++k)						\
-	    {								\
-		for(j = 0; j < m; ++j)					\
-		    fprintf(fp_write, "%.10g\t", (v_print));		\
-		fprintf(fp_write, "\n");				\
-	    }								\
-	fclose(fp_write);						\
-    } while (0)
+static void text_write_1D(const char * add_out, const char * name, const char * mode,
+			  const int N, const int m, double * const v[], const _Bool mid, const struct text_field_1D * d)
+{
+    char file_data[FILENAME_MAX+40];
+    FILE * fp_write;
+    char * buf, * b;
+    double * row = NULL;
+    const double * r;
+    int k, j;
+
+    strcpy(file_data, add_out);
+    strcat(file_data, name);
+    strcat(file_data, ".dat");
+    if((fp_write = fopen(file_data, mode)) == NULL)
+	{
+	    printf("Cannot open solution output file: %s!\n", name);
+	    exit(1);
+	}
+    if((buf = (char *)malloc(TEXT_BUF_SIZE)) == NULL || (d && (row = (double *)malloc(m * sizeof(double))) == NULL))
+	{
+	    printf("NOT enough memory! Output buffer of %s\n", name);
+	    exit(5);
+	}
+    b = buf;
+    for(k = 0; k < N; ++k)
+	{
+	    if(d)
+		out_field_1D(d->ctx, d->f, m, d->CV, d->nt + k, row);
+	    r = d ? row : v[k];
+	    for(j = 0; j < m; ++j)
+		{
+		    if(b - buf > TEXT_BUF_SIZE - 32)
+			{
+			    fwrite(buf, 1, b - buf, fp_write);
+			    b = buf;
+			}
+		    b += double_to_str(b, mid ? 0.5 * (r[j] + r[j+1]) : r[j]);
+		    *b++ = '\t';
+		}
+	    *b++ = '\n';
+	}
+    if(fwrite(buf, 1, b - buf, fp_write) != (size_t)(b - buf) || fclose(fp_write) != 0)
+	{
+	    printf("Write error occurrs in solution output file: %s!\n", name);
+	    exit(1);
+	}
+    free(buf);
+    free(row);
+}
 
 /**
  * @brief This function write the 1-D solution into output '.dat' files.
+ * @details The fields selected by config[94] are written, the derived ones are computed row by row (out_field_1D()).
  * @note  It is quite simple so there will be no more comments.
+ * @param[in] ctx: Pointer to the run context.
  * @param[in] m:   The number of spatial points in the output data.
  * @param[in] N:   The number of time steps in the output data.
  * @param[in] CV:  Structure of grid variable data in computational grid cells.
@@ -46,7 +102,7 @@
  * @param[in] problem:   Name of the numerical results for the test problem.
  * @param[in] time_plot: Array of the plotting time recording.
  */
-void file_1D_write(const int m, const int N, const struct cell_var_stru CV, 
+void file_1D_write(const struct run_ctx * ctx, const int m, const int N, const struct cell_var_stru CV, 
                     double * X[], const double * cpu_time, const char * problem, const double time_plot[])
 {
   // Records the time when the program is running.
@@ -60,23 +116,35 @@ void file_1D_write(const int m, const int N, const struct cell_var_stru CV,
   */
     char add_out[FILENAME_MAX+40];
     // Get the address of the output data folder of the test example.
-    example_io(problem, add_out, 0);
+    example_io(ctx, problem, add_out, 0);
     
     char file_data[FILENAME_MAX+40];
     FILE * fp_write;
 
 //===================Write Output Data File=========================
 
-    int k, j;
-    PRINT_NC(RHO, CV.RHO[k][j]);
-    PRINT_NC(U,   CV.U[k][j]);
-    PRINT_NC(P,   CV.P[k][j]);
-    PRINT_NC(E,   CV.E[k][j]);
+    int k, f[OUT_FIELD_N];
+    const int n_f = out_field_list(ctx, 1, f);
 #ifdef RADIAL_BASICS
-    PRINT_NC(R,   X[k][j]);
+    const char * name_X = "R";
+    const _Bool mid = false;
 #else
-    PRINT_NC(X, 0.5 * (X[k][j] + X[k][j+1]));
+    const char * name_X = "X";
+    const _Bool mid = true; // cell centers
 #endif
+    double ** const var[OUT_FIELD_N] = {CV.RHO, CV.U, NULL, CV.P, CV.E}; // the fields of the levels
+    // Each file is written by a thread, and the derived fields are computed row by row.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for(k = 0; k <= n_f; ++k)
+	{
+	    const struct text_field_1D d = {ctx, &CV, k < n_f ? f[k] : 0, 0};
+	    if(k == n_f)
+		text_write_1D(add_out, name_X, "w", N, m, X, mid, NULL);
+	    else
+		text_write_1D(add_out, out_field_name[f[k]], "w", N, m, var[f[k]], false, var[f[k]] ? NULL : &d);
+	}
 
     strcpy(file_data, add_out);
     strcat(file_data, "time_plot.dat");
@@ -91,5 +159,191 @@ void file_1D_write(const int m, const int N, const struct cell_var_stru CV,
     fclose(fp_write);
 
 //======================Write Log File============================
-    config_write(add_out, cpu_time, problem);
+    config_write(ctx, add_out, cpu_time, problem);
+}
+
+
+/**
+ * @brief This function writes the mass fractions of the species of the 1-D Lagrangian solution into 'Y_s.dat'.
+ * @details The species are passively advected with the mass of the Lagrangian cells, so the mass fractions
+ *          of a cell are those of the initial data at all of the N plotting times, which are the N rows of the files.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in] m:   The number of spatial points in the output data.
+ * @param[in] N:   The number of time steps in the output data.
+ * @param[in] FV:  Structure of fluid variable data with the rows of the species 'FV.Y' (NULL: No species).
+ * @param[in] problem: Name of the numerical results for the test problem.
+ */
+void file_1D_write_species(const struct run_ctx * ctx, const int m, const int N, const struct flu_var FV, const char * problem)
+{
+    char add_out[FILENAME_MAX+40], name[40];
+    double ** v;
+    int s, k;
+
+    if(FV.Y == NULL)
+	return;
+    example_io(ctx, problem, add_out, 0);
+    if((v = (double **)malloc(N * sizeof(double *))) == NULL)
+	{
+	    printf("NOT enough memory! Output of the species\n");
+	    exit(5);
+	}
+    for(s = 0; s < (int)ctx->conf[71]; ++s)
+	{
+	    for(k = 0; k < N; ++k)
+		v[k] = FV.Y + (size_t)s*FV.n_Y;
+	    sprintf(name, "Y_%d", s+1);
+	    text_write_1D(add_out, name, "w", N, m, v, false, NULL);
+	}
+    free(v);
+}
+
+
+/**
+ * @brief This function writes the 1-D levels of the snapshot store into the output files of the streaming output.
+ * @details The levels are decompressed one at a time, and the log file is written with the last one.
+ * @param[in] ctx:      Pointer to the run context.
+ * @param[in] m:        The number of spatial points in the output data.
+ * @param[in] cpu_time: Array of the CPU time recording.
+ * @param[in] problem:  Name of the numerical results for the test problem.
+ */
+static void file_1D_write_store(const struct run_ctx * ctx, const int m, const double * cpu_time, const char * problem)
+{
+    double * w = (double *)malloc((5*m + 1) * sizeof(double));
+    // The fields at their offsets in the snapshot (snap_store_put_1D).
+    double * RHO = w, * U = w + m, * P = w + 2*m, * E = w + 3*m, * X = w + 4*m;
+    struct cell_var_stru CV = {NULL};
+    double time;
+    int k, n_field;
+    if(w == NULL)
+	{
+	    printf("NOT enough memory! Snapshot store\n");
+	    exit(5);
+	}
+    CV.RHO = &RHO;
+    CV.U   = &U;
+    CV.P   = &P;
+    CV.E   = &E;
+    const int N = snap_store_drain(true);
+    for(k = 0; k < N; ++k)
+	{
+	    n_field = snap_store_get(k, w, &time);
+	    file_1D_write_stream(ctx, m, k, CV, 0, n_field > 4 ? X : NULL, k == N-1 ? cpu_time : NULL, problem, time);
+	}
+    snap_store_drain(false);
+    free(w);
+}
+
+/**
+ * @brief This function appends one 1-D snapshot to the output files (streaming output).
+ * @details The k-th snapshot is written as the k-th line of the '.dat' files, so the files
+ *          are the same as those written by file_1D_write() once all snapshots are appended.
+ *          The files are truncated when k = 0.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in] m:   The number of spatial points in the output data.
+ * @param[in] k:   Index of the snapshot in the output data.
+ * @param[in] CV:  Structure of grid variable data in computational grid cells.
+ * @param[in] nt:  Index of the level of 'CV' storing the snapshot.
+ * @param[in] X:   Array of the coordinate data of the snapshot (NULL: Eulerian grid of size config[10]).
+ * @param[in] cpu_time: Array of the CPU time recording (not NULL: the last snapshot, write the log file).
+ * @param[in] problem:  Name of the numerical results for the test problem.
+ * @param[in] time:     The plotting time of the snapshot.
+ */
+void file_1D_write_stream(const struct run_ctx * ctx, const int m, const int k, const struct cell_var_stru CV, const int nt,
+			  const double * X, const double * cpu_time, const char * problem, const double time)
+{
+    // The snapshot store (config[83]) keeps the snapshots till the last one.
+    if(snap_store_put_1D(ctx, m, k, CV, nt, X, time))
+	{
+	    if(cpu_time)
+		file_1D_write_store(ctx, m, cpu_time, problem);
+	    return;
+	}
+#ifndef NODATPLOT
+    char add_out[FILENAME_MAX+40];
+    // Get the address of the output data folder of the test example.
+    example_io(ctx, problem, add_out, 0);
+    
+    char file_data[FILENAME_MAX+40];
+    FILE * fp_write;
+
+//===================Append Output Data File=========================
+
+    const char * mode = k ? "a" : "w";
+    double * XX = (double *)X;
+    double ** const var[OUT_FIELD_N] = {CV.RHO, CV.U, NULL, CV.P, CV.E};
+    int l, f[OUT_FIELD_N];
+    const int n_f = out_field_list(ctx, 1, f);
+    for(l = 0; l < n_f; ++l)
+	{
+	    const struct text_field_1D d = {ctx, &CV, f[l], nt};
+	    text_write_1D(add_out, out_field_name[f[l]], mode, 1, m, var[f[l]] ? var[f[l]] + nt : NULL, false, var[f[l]] ? NULL : &d);
+	}
+#ifdef RADIAL_BASICS
+    text_write_1D(add_out, "R",   mode, 1, m, &XX, false, NULL);
+#else
+    const double h = ctx->conf[10];
+    int j;
+    if(X == NULL)
+	{
+	    if((XX = (double *)malloc((m+1) * sizeof(double))) == NULL)
+		{
+		    printf("NOT enough memory! Output grids\n");
+		    exit(5);
+		}
+	    for(j = 0; j <= m; ++j)
+		XX[j] = h * j;
+	}
+    text_write_1D(add_out, "X",   mode, 1, m, &XX, true, NULL);
+    if(X == NULL)
+	free(XX);
+#endif
+
+    strcpy(file_data, add_out);
+    strcat(file_data, "time_plot.dat");
+    if((fp_write = fopen(file_data, k ? "a" : "w")) == NULL)
+	{
+	    printf("Cannot open solution output file: time_plot!\n");
+	    exit(1);
+	}
+    fprintf(fp_write, "%.10g\n", time);
+    fclose(fp_write);
+
+//======================Write Log File============================
+    if(cpu_time)
+	{
+	    printf("%s\n",file_data);
+	    config_write(ctx, add_out, cpu_time, problem);
+	}
+#endif
+#ifdef HDF5PLOT
+    file_1D_write_HDF5_stream(ctx, m, k, CV, nt, X, cpu_time, problem, time);
+#endif
+}
+
+
+/**
+ * @brief This function publishes the current 1-D solution live into the shared memory when a frame is due (config[87]).
+ * @details The fields RHO, U, P, E and the coordinates X of the cell centers are published, no file is written.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in] m:   The number of the grid cells.
+ * @param[in] k:   The time step.
+ * @param[in] CV:  Structure of grid variable data in computational grid cells.
+ * @param[in] nt:  Index of the current level of 'CV'.
+ * @param[in] X:   Array of the coordinates of the grid nodes (NULL: Eulerian grid of size config[10]).
+ * @param[in] time: The current time.
+ */
+void file_1D_publish(const struct run_ctx * ctx, const int m, const int k, const struct cell_var_stru CV, const int nt,
+		     const double * X, const double time)
+{
+    static const char * const name[] = {"RHO", "U", "P", "E", "X"};
+    double * XC;
+    int j;
+
+    if(!live_publish_due())
+	return;
+    XC = live_publish_buffer((size_t)m); // kept by the live publish
+    for(j = 0; j < m; ++j)
+	XC[j] = X ? 0.5*(X[j] + X[j+1]) : ctx->conf[10]*(j + 0.5);
+    double * const * const v[] = {CV.RHO + nt, CV.U + nt, CV.P + nt, CV.E + nt, &XC};
+    live_publish_frame(k, time, 5, name, v, 1, m);
 }
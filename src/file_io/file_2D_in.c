@@ -13,7 +13,7 @@
 #include "../include/file_io.h"
 
 
-//! The maximum number of 2-D data dimension storing fluid variables in memory.
+//! The maximum number of 2-D data dimension storing fluid variables in memory (streaming output keeps only one, config[34]).
 #define N_MAX_2D 5
 
 /**
@@ -21,49 +21,39 @@
  * @details The value of (line*column) is stored in config[3];
  *          the value (line) number is stored in config[13];
  *          the value (column) number is stored in config[14];
- * @param[in]  add: Adress of the initial data file.
- * @param[in]  fp:  Pointer to the input data file.
- * @return  Pointer to the position of a block of memory consisting (line*column) variables of type double.
+ * @param[in,out] ctx: Pointer to the run context.
+ * @param[in]  add_in: Adress of the initial data folder of the test example.
+ * @param[in]  name:   Name of the fluid variable.
+ * @param[out] sfv:    Pointer to the position of a block of memory consisting (line*column) variables of type double.
+ * @return  Whether the initial data file exists.
  */
-static double * flu_var_init(const char * add, FILE *fp)
+static _Bool flu_var_init(struct run_ctx * ctx, const char * add_in, const char * name, double ** sfv)
 {
-    double * sfv;
     int num_cell, line, column;  // The number of the numbers in the above data files.
+    int e; // Error of reading the data file.
 
-    line = flu_var_count_line(fp, add, &column);
+    // The column number of a binary data file is given by n_x.
+    column = isinf(ctx->conf[13]) ? 0 : (int)ctx->conf[13];
+    if((e = flu_var_load(add_in, name, sfv, &line, &column, true)) == 1)
+	return false;
+    else if(e)
+	exit(e);
     num_cell = line * column;
-    if (num_cell < 1)
+    if(isinf(ctx->conf[3]))
+	ctx->conf[3] = (double)num_cell;
+    if(isinf(ctx->conf[13]))
+	ctx->conf[13] = (double)column;
+    if(isinf(ctx->conf[14]))
+	ctx->conf[14] = (double)line;
+    else if(num_cell != (int)ctx->conf[3] || column != (int)ctx->conf[13] || line != (int)ctx->conf[14])
 	{
-	    printf("Error in counting fluid variables in initial data file! %s\n", add);
-	    fclose(fp);
+	    printf("Input unequal! %s\n", name);
+	    printf(" num=%d, num_cell=%d;", num_cell, (int)ctx->conf[3]);
+	    printf(" column=%d, n_x=%d;", column, (int)ctx->conf[13]);
+	    printf(" line=%d, n_y=%d.\n", line, (int)ctx->conf[14]);
 	    exit(2);
 	}
-    if(isinf(config[3]))
-	config[3] = (double)num_cell;
-    if(isinf(config[13]))
-	config[13] = (double)column;
-    if(isinf(config[14]))
-	config[14] = (double)line;
-    else if(num_cell != (int)config[3] || column != (int)config[13] || line != (int)config[14])
-	{
-	    printf("Input unequal! %s\n", add);
-	    printf(" num=%d, num_cell=%d;", num_cell, (int)config[3]);
-	    printf(" column=%d, n_x=%d;", column, (int)config[13]);
-	    printf(" line=%d, n_y=%d.\n", line, (int)config[14]);
-	    exit(2);
-	}
-    sfv = (double*)malloc(num_cell * sizeof(double));
-    if(sfv == NULL)
-	{
-	    printf("NOT enough memory! %s\n", add);
-	    exit(5);
-	}
-    if(flu_var_read(fp, sfv, num_cell))
-	{
-	    fclose(fp);
-	    exit(2);
-	}
-    return sfv;
+    return true;
 }
 
 
@@ -74,28 +64,14 @@ static double * flu_var_init(const char * add, FILE *fp)
  */
 #define STR_FLU_INI(sfv, err_exit)					\
     do {								\
-    strcpy(add, add_in);						\
-    strcat(add, #sfv ".txt");						\
-    if((fp = fopen(add, "r")) == NULL)					\
-	{								\
-	    strcpy(add, add_in);					\
-	    strcat(add, #sfv ".dat");					\
-	}								\
-    if((fp = fopen(add, "r")) == NULL)					\
+    r = flu_var_init(ctx, add_in, #sfv, &FV0.sfv);			\
+    if(!r)								\
 	{								\
 	    printf("Cannot open initial data file: %s!\n", #sfv);	\
 	    if(err_exit)						\
 		exit(1);						\
 	    r = false;							\
-	}								\
-    if(r)								\
-	{								\
-	    FV0.sfv = flu_var_init(add, fp);				\
-	    fclose(fp);							\
-	}								\
-    else								\
-	{								\
-	    FV0.sfv = (double*)malloc((int)config[3] * sizeof(double)); \
+	    FV0.sfv = (double*)malloc((int)ctx->conf[3] * sizeof(double)); \
 	    if(FV0.sfv == NULL)						\
 		{							\
 		    printf("NOT enough memory! %s\n", #sfv);		\
@@ -109,6 +85,7 @@ static double * flu_var_init(const char * add, FILE *fp)
   * @details    The function initialize the extern pointer FV0.RHO/U/V/P pointing to the
   *             position of a block of memory consisting (line*column) variables* of type double.
   *             These (line*column) variables are the initial value.
+  * @param[in,out] ctx:    Pointer to the run context.
   * @param[in]  name:      Name of the test example.
   * @param[in]  N:         Pointer to the number of 2-D data dimension storing fluid variables in memory.
   * @param[out] N_plot:    Pointer to the number of time steps for plotting.
@@ -116,31 +93,36 @@ static double * flu_var_init(const char * add, FILE *fp)
   * @return  \b FV0:  Structure of initial fluid variable data array pointer.
   * @note This function contains the function procedures 'time_plot_read()' and 'configurate()'.
   */
-struct flu_var initialize_2D(const char * name, int * N, int * N_plot, double * time_plot[])
+struct flu_var initialize_2D(struct run_ctx * ctx, const char * name, int * N, int * N_plot, double * time_plot[])
 {
     struct flu_var FV0 = {NULL};
 
     char add_in[FILENAME_MAX+40]; 
     // Get the address of the initial data folder of the test example.
-    example_io(name, add_in, 1);
+    example_io(ctx, name, add_in, 1);
     
     /* 
      * Read the configuration data.
      * The detail could be seen in the definition of array config
      * referring to file 'doc/config.csv'.
      */
-    configurate(add_in);
-    printf("  delta_x\t= %g\n", config[10]);
-    printf("  delta_y\t= %g\n", config[11]);
-    printf("  bondary_x\t= %d\n", (int)config[17]);
-    printf("  bondary_y\t= %d\n", (int)config[18]);
+    configurate(ctx, add_in);
+    printf("  delta_x\t= %g\n", ctx->conf[10]);
+    printf("  delta_y\t= %g\n", ctx->conf[11]);
+    printf("  bondary_x\t= %d\n", (int)ctx->conf[17]);
+    printf("  bondary_y\t= %d\n", (int)ctx->conf[18]);
 
-    (*N) = time_plot_read(add_in, N_MAX_2D, N_plot, time_plot);
+    (*N) = time_plot_read(ctx, add_in, N_MAX_2D, N_plot, time_plot);
 
-    char add[FILENAME_MAX+40]; // The address of the velocity/pressure/density file to read in.
-    FILE * fp;      // The pointer to the above data files.
     _Bool r = true; // r: Whether to read data file successfully.
 
+    if(init_gen(ctx, add_in, 2, &FV0)) // the analytic initial data of the 'init' rows
+	{
+	    species_load(ctx, add_in, (int)ctx->conf[3], true, &FV0);
+	    printf("'%s' data initialized, line = %d, column = %d.\n", add_in, (int)ctx->conf[14], (int)ctx->conf[13]);
+	    return FV0;
+	}
+
     // Open the initial data files and initializes the reading of data.
     STR_FLU_INI(RHO,  1);
     STR_FLU_INI(U,    1);
@@ -158,7 +140,7 @@ struct flu_var initialize_2D(const char * name, int * N, int * N_plot, double *
     STR_FLU_INI(Z_a,  0);
     if(!r)
 	{
-	    for(int i = 0; i < (int)config[3]; i++)
+	    for(int i = 0; i < (int)ctx->conf[3]; i++)
 		FV0.Z_a[i] = FV0.PHI[i];
 	    printf("\t Initial volume fraction 'Z_a' is initialized by mass fraction 'PHI'.\n");
 	    r = true;
@@ -166,14 +148,16 @@ struct flu_var initialize_2D(const char * name, int * N, int * N_plot, double *
     STR_FLU_INI(gamma,0);
     if(!r)
 	{
-	    for(int i = 0; i < (int)config[3]; i++)
-		FV0.gamma[i] = 1.0 + 1.0 / (FV0.Z_a[i]/(config[6]-1.0) + (1.0-FV0.Z_a[i])/(config[106]-1.0));
+	    for(int i = 0; i < (int)ctx->conf[3]; i++)
+		FV0.gamma[i] = 1.0 + 1.0 / (FV0.Z_a[i]/(ctx->conf[6]-1.0) + (1.0-FV0.Z_a[i])/(ctx->conf[106]-1.0));
 	    printf("\t Initial specific heat rate 'gamma' is initialized by volume fraction 'Z_a'.\n");
 	    r = true;
 	}
 #endif
 #endif
 
-    printf("'%s' data initialized, line = %d, column = %d.\n", add_in, (int)config[14], (int)config[13]);
+    species_load(ctx, add_in, (int)ctx->conf[3], true, &FV0);
+
+    printf("'%s' data initialized, line = %d, column = %d.\n", add_in, (int)ctx->conf[14], (int)ctx->conf[13]);
     return FV0;
 }
@@ -7,26 +7,34 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <time.h>
 
 #include "../include/var_struc.h"
+#include "../include/tools.h"
 #include "../include/file_io.h"
 
 
 /**
  * @brief Print out fluid variable 'v' with array data element 'v_print'.
+ * @details The file is opened with the mode 'mode' ("w" or "a"), and the N levels 'l' are written.
  */
-#define PRINT_NC(v, v_print)						\
+#define PRINT_NC(v, v_print) PRINT_NS(#v, v_print)
+
+/**
+ * @brief Print out the fluid variable named by the string 'name' with array data element 'v_print'.
+ */
+#define PRINT_NS(name, v_print)						\
     do {								\
     strcpy(file_data, add_out);						\
-    strcat(file_data, #v);						\
+    strcat(file_data, name);						\
     strcat(file_data, ".dat");						\
-    if((fp_write = fopen(file_data, "w")) == NULL)			\
+    if((fp_write = fopen(file_data, mode)) == NULL)			\
 	{								\
-	    printf("Cannot open solution output file: %s!\n", #v);	\
+	    printf("Cannot open solution output file: %s!\n", name);	\
 	    exit(1);							\
 	}								\
-    for(k = 0; k < N; ++k)						\
+    for(l = 0; l < N; ++l)						\
 	{								\
 	    for(i = 0; i < n_y; ++i)					\
 		{							\
@@ -41,7 +49,9 @@
 
 /**
  * @brief This function write the 2-D solution into output '.dat' files.
+ * @details The fields selected by config[94] are written, the derived ones are computed cell by cell (out_field_2D()).
  * @note  It is quite simple so there will be no more comments.
+ * @param[in] ctx: Pointer to the run context.
  * @param[in] n_x: The number of x-spatial points in the output data.
  * @param[in] n_y: The number of y-spatial points in the output data.
  * @param[in] N:   The number of time steps in the output data.
@@ -52,24 +62,23 @@
  * @param[in] problem:   Name of the numerical results for the test problem.
  * @param[in] time_plot: Array of the plotting time recording.
  */
-void file_2D_write(const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
+void file_2D_write(const struct run_ctx * ctx, const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
 		    double ** X, double ** Y, const double * cpu_time, const char * problem, const double time_plot[])
 {
     char add_out[FILENAME_MAX+40];
     // Get the address of the output data folder of the test example.
-    example_io(problem, add_out, 0);
+    example_io(ctx, problem, add_out, 0);
     
     char file_data[FILENAME_MAX+40];
     FILE * fp_write;
 
 //===================Write Solution File=========================
 
-    int k, i, j;
-    PRINT_NC(RHO, CV[k].RHO[j][i]);
-    PRINT_NC(U,   CV[k].U[j][i]);
-    PRINT_NC(V,   CV[k].V[j][i]);
-    PRINT_NC(P,   CV[k].P[j][i]);
-    PRINT_NC(E,   CV[k].E[j][i]);
+    const char * mode = "w";
+    int k, l, i, j, f[OUT_FIELD_N];
+    const int n_f = out_field_list(ctx, 2, f);
+    for(k = 0; k < n_f; ++k)
+	PRINT_NS(out_field_name[f[k]], out_field_2D(ctx, f[k], n_x, n_y, CV + l, X, Y, j, i));
     PRINT_NC(X, 0.25*(X[j][i] + X[j][i+1] + X[j+1][i] + X[j+1][i+1]));
     PRINT_NC(Y, 0.25*(Y[j][i] + Y[j][i+1] + Y[j+1][i] + Y[j+1][i+1]));
     
@@ -84,12 +93,196 @@ void file_2D_write(const int n_x, const int n_y, const int N, const struct cell_
 	fprintf(fp_write, "%.10g\n", time_plot[k]);
     fclose(fp_write);
 
-    config_write(add_out, cpu_time, problem);
+    config_write(ctx, add_out, cpu_time, problem);
+}
+
+
+/**
+ * @brief This function writes the 2-D levels of the snapshot store into the output files of the streaming output.
+ * @details The levels are decompressed one at a time, and the log file is written with the last one.
+ * @param[in] ctx:      Pointer to the run context.
+ * @param[in] n_x:      The number of x-spatial points in the output data.
+ * @param[in] n_y:      The number of y-spatial points in the output data.
+ * @param[in] X:        Array of the x-coordinate data.
+ * @param[in] Y:        Array of the y-coordinate data.
+ * @param[in] cpu_time: Array of the CPU time recording.
+ * @param[in] problem:  Name of the numerical results for the test problem.
+ */
+static void file_2D_write_store(const struct run_ctx * ctx, const int n_x, const int n_y, double ** X, double ** Y,
+				const double * cpu_time, const char * problem)
+{
+    const size_t c = (size_t)n_x * n_y;
+    double * w = (double *)malloc(5 * c * sizeof(double));
+    double ** v[5] = {NULL};
+    struct cell_var_stru CV = {NULL};
+    double time;
+    int k, f, j;
+    for(f = 0; f < 5; ++f)
+	if((v[f] = (double **)malloc(n_x * sizeof(double *))) == NULL || w == NULL)
+	    {
+		printf("NOT enough memory! Snapshot store\n");
+		exit(5);
+	    }
+    // The rows of the fields are those of the decompressed level.
+    for(f = 0; f < 5; ++f)
+	for(j = 0; j < n_x; ++j)
+	    v[f][j] = w + f*c + (size_t)j*n_y;
+    CV.RHO = v[0];
+    CV.U   = v[1];
+    CV.V   = v[2];
+    CV.P   = v[3];
+    CV.E   = v[4];
+    const int N = snap_store_drain(true);
+    for(k = 0; k < N; ++k)
+	{
+	    snap_store_get(k, w, &time);
+	    file_2D_write_stream(ctx, n_x, n_y, k, &CV, X, Y, k == N-1 ? cpu_time : NULL, problem, time);
+	}
+    snap_store_drain(false);
+    for(f = 0; f < 5; ++f)
+	free(v[f]);
+    free(w);
 }
 
 
+/**
+ * @brief This function appends one 2-D snapshot to the output files (streaming output).
+ * @details The k-th snapshot is written as the k-th block of the '.dat' files, so the files
+ *          are the same as those written by file_2D_write() once all snapshots are appended.
+ *          The files are truncated when k = 0.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in] n_x: The number of x-spatial points in the output data.
+ * @param[in] n_y: The number of y-spatial points in the output data.
+ * @param[in] k:   Index of the snapshot in the output data.
+ * @param[in] CV:  Structure of variable data of the snapshot.
+ * @param[in] X:   Array of the x-coordinate data.
+ * @param[in] Y:   Array of the y-coordinate data.
+ * @param[in] cpu_time: Array of the CPU time recording (not NULL: the last snapshot, write the log file).
+ * @param[in] problem:  Name of the numerical results for the test problem.
+ * @param[in] time:     The plotting time of the snapshot.
+ */
+void file_2D_write_stream(const struct run_ctx * ctx, const int n_x, const int n_y, const int k, const struct cell_var_stru * CV,
+			  double ** X, double ** Y, const double * cpu_time, const char * problem, const double time)
+{
+    // The snapshot store (config[83]) keeps the snapshots till the last one.
+    if(snap_store_put_2D(ctx, n_x, n_y, k, CV, time))
+	{
+	    if(cpu_time)
+		file_2D_write_store(ctx, n_x, n_y, X, Y, cpu_time, problem);
+	    return;
+	}
+#ifndef NODATPLOT
+    char add_out[FILENAME_MAX+40];
+    // Get the address of the output data folder of the test example.
+    example_io(ctx, problem, add_out, 0);
+    
+    char file_data[FILENAME_MAX+40];
+    FILE * fp_write;
+
+//===================Append Solution File=========================
+
+    const char * mode = k ? "a" : "w";
+    const int N = 1; // The snapshot is the only level written.
+    int l, i, j, v, f[OUT_FIELD_N];
+    const int n_f = out_field_list(ctx, 2, f);
+    for(v = 0; v < n_f; ++v)
+	PRINT_NS(out_field_name[f[v]], out_field_2D(ctx, f[v], n_x, n_y, CV, X, Y, j, i));
+    PRINT_NC(X, 0.25*(X[j][i] + X[j][i+1] + X[j+1][i] + X[j+1][i+1]));
+    PRINT_NC(Y, 0.25*(Y[j][i] + Y[j][i+1] + Y[j+1][i] + Y[j+1][i+1]));
+
+    strcpy(file_data, add_out);
+    strcat(file_data, "time_plot.dat");
+    if((fp_write = fopen(file_data, mode)) == NULL)
+	{
+	    printf("Cannot open solution output file: time_plot!\n");
+	    exit(1);
+	}
+    fprintf(fp_write, "%.10g\n", time);
+    fclose(fp_write);
+
+    if(cpu_time)
+	config_write(ctx, add_out, cpu_time, problem);
+#endif
+#ifdef HDF5PLOT
+    file_2D_write_HDF5_stream(ctx, n_x, n_y, k, CV, X, Y, cpu_time, problem, time);
+#endif
+}
+
+
+/**
+ * @brief This function write the 2-D solution into a binary Tecplot '.plt' file with the ordered zones and the variables
+ *        of the ASCII '.tec' file, the coordinates of the cell centers are written in the first zone and shared by the others.
+ * @param[in] n_x: The number of x-spatial points in the output data.
+ * @param[in] n_y: The number of y-spatial points in the output data.
+ * @param[in] N:   The number of time steps in the output data.
+ * @param[in] CV:  Structure of variable data in computational grid cells.
+ * @param[in] X:   Array of the x-coordinate data.
+ * @param[in] Y:   Array of the y-coordinate data.
+ * @param[in] add_out:   Output folder of the test example.
+ * @param[in] time_plot: Array of the plotting time recording.
+ * @param[in] eps:       The largest value could be seen as zero.
+ */
+static void file_2D_write_POINT_PLT(const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
+				    double ** X, double ** Y, const char * add_out, const double time_plot[], const double eps)
+{
+    const char * var[] = {"X", "Y", "P", "RHO", "U", "V", "E"};
+    const int nv = sizeof(var) / sizeof(var[0]);
+    const long n_c = (long)n_x * n_y;
+    long n[sizeof(var) / sizeof(var[0])];
+    double * buf, * v[sizeof(var) / sizeof(var[0])];
+    char file_data[FILENAME_MAX+40], zone[40];
+    FILE * fp;
+    int k, i, j, l;
+
+    if ((buf = (double *)malloc(nv * n_c * sizeof(double))) == NULL)
+	{
+	    printf("NOT enough memory! Tecplot output\n");
+	    exit(5);
+	}
+    for (l = 0; l < nv; l++)
+	{
+	    v[l] = buf + l * n_c;
+	    n[l] = n_c;
+	}
+    sprintf(file_data, "%sFLU_VAR_%.8g.plt", add_out, time_plot[N-1] + eps);
+    if ((fp = tec_plt_open(file_data, TEC_FULL, "FE-Volume Point Data", nv, var)) == NULL)
+	{
+	    fprintf(stderr, "Cannot open solution output TECPLOT file of '%s'!\n", add_out);
+	    exit(1);
+	}
+    for (k = 0; k < N; ++k)
+	{
+	    sprintf(zone, "ZONE %03d", k+1);
+	    tec_plt_zone(fp, zone, time_plot[k], TEC_ORDERED, n_x, n_y, nv, NULL);
+	}
+    tec_plt_eoh(fp);
+    for (i = 0; i < n_y; ++i)
+	for (j = 0; j < n_x; ++j)
+	    {
+		v[0][i*n_x + j] = 0.25*(X[j][i] + X[j][i+1] + X[j+1][i] + X[j+1][i+1]);
+		v[1][i*n_x + j] = 0.25*(Y[j][i] + Y[j][i+1] + Y[j+1][i] + Y[j+1][i+1]);
+	    }
+    for (k = 0; k < N; ++k)
+	{
+	    for (i = 0; i < n_y; ++i)
+		for (j = 0; j < n_x; ++j)
+		    {
+			v[2][i*n_x + j] = CV[k].P[j][i];
+			v[3][i*n_x + j] = CV[k].RHO[j][i];
+			v[4][i*n_x + j] = CV[k].U[j][i];
+			v[5][i*n_x + j] = CV[k].V[j][i];
+			v[6][i*n_x + j] = CV[k].E[j][i];
+		    }
+	    tec_plt_data(fp, nv, (const double * const *)v, n, 0, -1, NULL, 0);
+	    v[0] = v[1] = NULL; // the coordinates of the first zone
+	}
+    fclose(fp);
+    free(buf);
+}
+
 /**
  * @brief This function write the 2-D solution into Tecplot output files with point data.
+ * @param[in] ctx: Pointer to the run context.
  * @param[in] n_x: The number of x-spatial points in the output data.
  * @param[in] n_y: The number of y-spatial points in the output data.
  * @param[in] N:   The number of time steps in the output data.
@@ -100,19 +293,25 @@ void file_2D_write(const int n_x, const int n_y, const int N, const struct cell_
  * @param[in] problem:   Name of the numerical results.
  * @param[in] time_plot: Array of the plotting time recording.
  */
-void file_2D_write_POINT_TEC(const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
+void file_2D_write_POINT_TEC(const struct run_ctx * ctx, const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
 			double ** X, double ** Y, const double * cpu_time, const char * problem, const double time_plot[])
 {
-    double const eps = config[4];
+    double const eps = ctx->conf[4];
     char add_out[FILENAME_MAX+40];
     // Get the address of the output data folder of the test example.
-    example_io(problem, add_out, 0);
+    example_io(ctx, problem, add_out, 0);
     
     char file_data[FILENAME_MAX+40];
     FILE * fp;
     int k, i, j;
     char str_tmp[40];
 
+    if ((int)ctx->conf[78] > 0)
+	{
+	    file_2D_write_POINT_PLT(n_x, n_y, N, CV, X, Y, add_out, time_plot, eps);
+	    return;
+	}
+
     //===================Write solution File=========================
     strcpy(file_data, add_out);
     sprintf(str_tmp, "FLU_VAR_%.8g.tec", time_plot[N-1] + eps);
@@ -149,3 +348,22 @@ void file_2D_write_POINT_TEC(const int n_x, const int n_y, const int N, const st
 	}
     fclose(fp);
 }
+
+
+/**
+ * @brief This function publishes the current 2-D solution live into the shared memory when a frame is due (config[87]).
+ * @details The fields RHO, U, V, P of n_x rows of n_y cells are published, no file is written.
+ * @param[in] n_x: The number of x-spatial points.
+ * @param[in] n_y: The number of y-spatial points.
+ * @param[in] k:   The time step.
+ * @param[in] CV:  Structure of the current variable data.
+ * @param[in] time: The current time.
+ */
+void file_2D_publish(const int n_x, const int n_y, const int k, const struct cell_var_stru * CV, const double time)
+{
+    static const char * const name[] = {"RHO", "U", "V", "P"};
+    if(!live_publish_due())
+	return;
+    double * const * const v[] = {CV->RHO, CV->U, CV->V, CV->P};
+    live_publish_frame(k, time, 4, name, v, n_x, n_y);
+}
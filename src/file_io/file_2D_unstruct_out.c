@@ -7,6 +7,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdbool.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
+#ifdef VTUZLIB
+#include <zlib.h>
+#endif
 
 #include "../include/var_struc.h"
 #include "../include/tools.h"
@@ -33,6 +43,242 @@
 	fprintf(fp,"\n");			\
     } while (0)
 
+//! Fluid variables on the cells, staged by the asynchronous output and permuted for the output in the file order.
+#ifdef MULTIFLUID_BASICS
+#ifdef MULTIPHASE_BASICS
+#define FV_STAGE(S) S(RHO); S(U); S(V); S(P); S(Z_a); S(PHI); S(gamma); S(RHO_b); S(U_b); S(V_b); S(P_b)
+#else
+#define FV_STAGE(S) S(RHO); S(U); S(V); S(P); S(Z_a); S(PHI); S(gamma)
+#endif
+#else
+#define FV_STAGE(S) S(RHO); S(U); S(V); S(P)
+#endif
+
+
+//! Lock of the caches of the mesh shared by the writer threads (the VTU series and the binary Tecplot grid files).
+#ifdef _WIN32
+static SRWLOCK vtu_lock = SRWLOCK_INIT;
+#define VTU_LOCK()   AcquireSRWLockExclusive(&vtu_lock)
+#define VTU_UNLOCK() ReleaseSRWLockExclusive(&vtu_lock)
+#else
+static pthread_mutex_t vtu_lock = PTHREAD_MUTEX_INITIALIZER;
+#define VTU_LOCK()   pthread_mutex_lock(&vtu_lock)
+#define VTU_UNLOCK() pthread_mutex_unlock(&vtu_lock)
+#endif
+
+/**
+ * @brief This function gives a copy of the mesh and the fluid variables in the serial numbers of the mesh file,
+ *        if the mesh has been renumbered by mesh_reorder() and config[54] is true.
+ * @details The copy is made at each output, so that the writers on different threads do not share it.
+ * @param[in]  FV:   Structure of fluid variable data array in computational grid.
+ * @param[in]  mv:   Structure of meshing variable data.
+ * @param[out] FV_f: Fluid variables in the file order.
+ * @param[out] mv_f: Meshing variables in the file order.
+ * @return     Whether the copy is made (0: the output is in the order of the computation).
+ */
+static int file_order_copy(const struct flu_var * FV, const struct mesh_var * mv, struct flu_var * FV_f, struct mesh_var * mv_f)
+{
+    const int num_cell = (int)config[3];
+    const int * cperm = mv->cell_perm, * pperm = mv->pt_perm;
+    int k, i, n_c = 0;
+    int * con;
+
+    if (!(_Bool)config[54] || cperm == NULL || pperm == NULL)
+	return 0;
+    *mv_f = *mv;
+    mv_f->cell_perm = mv_f->pt_perm = NULL;
+    for(k = 0; k < num_cell; k++)
+	n_c += mv->cell_pt[k][0] + 1;
+    mv_f->X = (double *)malloc(2 * mv->num_pt * sizeof(double));
+    mv_f->cell_pt = (int **)malloc(num_cell * sizeof(int *) + n_c * sizeof(int));
+    memset(FV_f, 0, sizeof(struct flu_var));
+#define FV_F_ALLOC(v) if ((FV_f->v = (double *)malloc(num_cell * sizeof(double))) == NULL) n_c = -1
+    FV_STAGE(FV_F_ALLOC);
+#undef FV_F_ALLOC
+    if (mv_f->X == NULL || mv_f->cell_pt == NULL || n_c < 0)
+	{
+	    printf("NOT enough memory! Output in the file order\n");
+	    exit(5);
+	}
+    mv_f->Y = mv_f->X + mv->num_pt;
+    con = (int *)(mv_f->cell_pt + num_cell); // nodes of the cells after the pointers
+    for(k = 0; k < mv->num_pt; k++)
+	{
+	    mv_f->X[pperm[k]] = mv->X[k];
+	    mv_f->Y[pperm[k]] = mv->Y[k];
+	}
+    for(k = 0, n_c = 0; k < num_cell; k++)
+	{
+	    mv_f->cell_pt[cperm[k]] = con + n_c;
+	    con[n_c] = mv->cell_pt[k][0];
+	    for(i = 1; i <= mv->cell_pt[k][0]; i++)
+		con[n_c+i] = pperm[mv->cell_pt[k][i]];
+	    n_c += mv->cell_pt[k][0] + 1;
+	}
+#define FV_F_COPY(v) for(k = 0; k < num_cell; k++) FV_f->v[cperm[k]] = FV->v[k]
+    FV_STAGE(FV_F_COPY);
+#undef FV_F_COPY
+    if (FV->Y != NULL) // the rows of the species
+	{
+	    const int K = (int)config[71];
+	    if ((FV_f->Y = (double *)malloc((size_t)K * num_cell * sizeof(double))) == NULL)
+		{
+		    printf("NOT enough memory! Output in the file order\n");
+		    exit(5);
+		}
+	    FV_f->n_Y = num_cell;
+	    for(i = 0; i < K; i++)
+		for(k = 0; k < num_cell; k++)
+		    FV_f->Y[(size_t)i*num_cell + cperm[k]] = FV->Y[(size_t)i*FV->n_Y + k];
+	}
+    return 1;
+}
+
+//! Free the copy in the file order given by file_order_copy().
+static void file_order_free(struct flu_var * FV_f, struct mesh_var * mv_f)
+{
+    free(mv_f->X);
+    free(mv_f->cell_pt);
+#define FV_F_FREE(v) free(FV_f->v)
+    FV_STAGE(FV_F_FREE);
+#undef FV_F_FREE
+    free(FV_f->Y);
+}
+
+//! Write the output in the file order by the writer 'write' and return, if the mesh has been renumbered.
+#define FILE_ORDER_WRITE(write)						\
+    do {								\
+	struct flu_var FV_f;						\
+	struct mesh_var mv_f;						\
+	if (file_order_copy(&FV, &mv, &FV_f, &mv_f))			\
+	    {								\
+		write(FV_f, mv_f, problem, time);			\
+		file_order_free(&FV_f, &mv_f);				\
+		return;							\
+	    }								\
+    } while (0)
+
+//! Output folder of the mesh file 'FLU_VAR_grid.plt' written for the binary Tecplot solution files.
+static char plt_grid[FILENAME_MAX];
+
+/**
+ * @brief This function write the 2-D solution into binary Tecplot '.plt' files with the zone and the variables
+ *        of the ASCII '.tec' files.
+ * @details The file of a plotting time has the mesh and the solution if config[78] = 1. If config[78] = 2,
+ *          the nodes and the connectivity are written once into the 'GRID' file 'FLU_VAR_grid.plt' of the output folder,
+ *          which is loaded together with the 'SOLUTION' files 'FLU_VAR_t.plt' of the cell-centered variables.
+ * @param[in] FV: Structure of fluid variable data array in computational grid.
+ * @param[in] mv: Structure of meshing variable data.
+ * @param[in] problem: Name of the numerical results for the test problem.
+ * @param[in] time: The plotting time.
+ */
+static void file_write_2D_BLOCK_PLT(const struct flu_var FV, const struct mesh_var mv, const char * problem, const double time)
+{
+    const double eps = config[4];
+    const int num_cell = (int)config[3];
+    const _Bool split = (int)config[78] == 2;
+    const char * var[] = {"X", "Y", "P", "RHO", "U", "V",
+#ifdef MULTIFLUID_BASICS
+			  "Z_a",
+#ifdef MULTIPHASE_BASICS
+			  "P_b", "RHO_b", "U_b", "V_b",
+#else
+			  "PHI", "gamma",
+#endif
+#endif
+    };
+    const double * v[] = {mv.X, mv.Y, FV.P, FV.RHO, FV.U, FV.V,
+#ifdef MULTIFLUID_BASICS
+			  FV.Z_a,
+#ifdef MULTIPHASE_BASICS
+			  FV.P_b, FV.RHO_b, FV.U_b, FV.V_b,
+#else
+			  FV.PHI, FV.gamma,
+#endif
+#endif
+    };
+    const int nv = sizeof(var) / sizeof(var[0]);
+    long n[sizeof(var) / sizeof(var[0])];
+    int loc[sizeof(var) / sizeof(var[0])];
+    int k, i, cell_type = 0, zone_type;
+    int * con = NULL;
+    _Bool grid;
+    char folder[FILENAME_MAX], file_data[FILENAME_MAX+40];
+    FILE * fp;
+
+    for (k = 0; k < num_cell; k++)
+	cell_type = MAX(mv.cell_pt[k][0], cell_type);
+    if (cell_type == 3)
+	zone_type = TEC_FETRIANGLE;
+    else if (cell_type == 4)
+	zone_type = TEC_FEQUADRILATERAL;
+    else
+	{
+	    printf("NON ZONETYPE!");
+	    exit(2);
+	}
+    for (i = 0; i < nv; i++)
+	{
+	    n[i]   = i < 2 ? mv.num_pt : num_cell;
+	    loc[i] = i >= 2;
+	}
+    example_io(&run_ctx_global, problem, folder, 0);
+    VTU_LOCK();
+    grid = !split || strcmp(plt_grid, folder) != 0;
+    if (split && grid)
+	strcpy(plt_grid, folder);
+    VTU_UNLOCK();
+    if (grid)
+	{
+	    if ((con = (int *)malloc((size_t)num_cell * cell_type * sizeof(int))) == NULL)
+		{
+		    printf("NOT enough memory! Tecplot connectivity\n");
+		    exit(5);
+		}
+	    for (k = 0; k < num_cell; k++)
+		for (i = 1; i <= cell_type; i++)
+		    con[k*cell_type + i-1] = mv.cell_pt[k][MIN(i, mv.cell_pt[k][0])];
+	}
+
+    if (split && grid) // the mesh written once
+	{
+	    sprintf(file_data, "%sFLU_VAR_grid.plt", folder);
+	    if ((fp = tec_plt_open(file_data, TEC_GRID, "FE-Volume Brick Data", 2, var)) == NULL)
+		{
+		    fprintf(stderr, "Cannot open grid output Tecplot file!\n");
+		    exit(1);
+		}
+	    tec_plt_zone(fp, "Fluid Region", time + eps, zone_type, mv.num_pt, num_cell, 2, NULL);
+	    tec_plt_eoh(fp);
+	    tec_plt_data(fp, 2, v, n, -1, -1, con, (long)num_cell * cell_type);
+	    fclose(fp);
+	}
+    sprintf(file_data, "%sFLU_VAR_%.8g.plt", folder, time + eps);
+    if (split)
+	fp = tec_plt_open(file_data, TEC_SOLUTION, "FE-Volume Brick Data", nv-2, var+2);
+    else
+	fp = tec_plt_open(file_data, TEC_FULL, "FE-Volume Brick Data", nv, var);
+    if (fp == NULL)
+	{
+	    fprintf(stderr, "Cannot open solution output Tecplot file!\n");
+	    exit(1);
+	}
+    if (split)
+	{
+	    tec_plt_zone(fp, "Fluid Region", time + eps, zone_type, mv.num_pt, num_cell, nv-2, loc+2);
+	    tec_plt_eoh(fp);
+	    tec_plt_data(fp, nv-2, v+2, n+2, -1, -1, NULL, 0);
+	}
+    else
+	{
+	    tec_plt_zone(fp, "Fluid Region", time + eps, zone_type, mv.num_pt, num_cell, nv, loc);
+	    tec_plt_eoh(fp);
+	    tec_plt_data(fp, nv, v, n, -1, -1, con, (long)num_cell * cell_type);
+	}
+    fclose(fp);
+    free(con);
+}
+
 /**
  * @brief This function write the 2-D solution into Tecplot output '.tec' files with unstructured block data.
  * @param[in] FV: Structure of fluid variable data array in computational grid.
@@ -42,16 +288,22 @@
  */
 void file_write_2D_BLOCK_TEC(const struct flu_var FV, const struct mesh_var mv, const char * problem, const double time)
 {
+    FILE_ORDER_WRITE(file_write_2D_BLOCK_TEC);
+    if ((int)config[78] > 0)
+	{
+	    file_write_2D_BLOCK_PLT(FV, mv, problem, time);
+	    return;
+	}
     const double eps = config[4];
     const int num_cell = (int)config[3];
 
     int k, num_data;
     int cell_type = 0;
     for (k = 0; k < num_cell; k++)
-	cell_type = MAX(mv.cell_pt[0][0], cell_type);
+	cell_type = MAX(mv.cell_pt[k][0], cell_type);
   
     char file_data[FILENAME_MAX];	
-    example_io(problem, file_data, 0);
+    example_io(&run_ctx_global, problem, file_data, 0);
 
     FILE * fp;
     char str_tmp[40];
@@ -166,11 +418,12 @@ void file_write_2D_BLOCK_TEC(const struct flu_var FV, const struct mesh_var mv,
  */
 void file_write_3D_VTK(const struct flu_var FV, const struct mesh_var mv, const char * problem, const double time)
 {
+    FILE_ORDER_WRITE(file_write_3D_VTK);
     const double eps = config[4];
 	const int num_cell = (int)config[3];
 
 	char file_data[FILENAME_MAX];	
-	example_io(problem, file_data, 0);
+	example_io(&run_ctx_global, problem, file_data, 0);
 
 	FILE * fp;
     char str_tmp[40];
@@ -238,3 +491,548 @@ void file_write_3D_VTK(const struct flu_var FV, const struct mesh_var mv, const
 
 	fclose(fp);
 }
+
+
+//! Cache of the VTU series: the encoded mesh blocks and the frames listed in the '.pvd' file.
+static struct vtu_cache {
+	const double * X;     //!< coordinates of the mesh which the blocks are encoded from.
+	int num_pt, num_cell; //!< numbers of the grid nodes and cells of the mesh.
+	char * mesh;          //!< encoded appended blocks of the points, connectivity, offsets and types.
+	long mesh_size;       //!< size of the encoded mesh blocks in bytes.
+	long off[4];          //!< offsets of the mesh blocks in the appended data.
+	_Bool zlib;           //!< whether the blocks are zlib-compressed.
+	double * t;           //!< plotting times of the frames written.
+	int n_t;              //!< number of the frames written.
+	int num_piece;        //!< number of the pieces written by the parts of the grids (0: no '.pvtu' index).
+	char pvtu[FILENAME_MAX]; //!< output folder of the '.pvtu' index of the pieces.
+	double * t_p;         //!< plotting times of the '.pvtu' frames written.
+	int n_tp;             //!< number of the '.pvtu' frames written.
+} vtu_c;
+
+/**
+ * @brief This function encodes a data array as a block of the appended data of a VTU file.
+ * @details The block is the raw bytes following a UInt64 header of its size, or the zlib-compressed
+ *          bytes following the header of a single compressed block (compiled with VTUZLIB and config[48] > 0).
+ * @param[in,out] buf:  Pointer to the growing buffer of the blocks.
+ * @param[in,out] size: Pointer to the size of the buffer in bytes.
+ * @param[in] p:        Address of the data array.
+ * @param[in] n:        Size of the data array in bytes.
+ * @return    Whether there is an error (0: Success, 5: Memory error).
+ */
+static int vtu_block(char ** buf, long * size, const void * p, const unsigned long long n)
+{
+    unsigned long long h[4] = {1, n, n, n};
+    char * b;
+#ifdef VTUZLIB
+    const int level = (int)config[48];
+    uLongf n_z = compressBound((uLong)n);
+    if (level > 0)
+	{
+	    if ((b = (char *)realloc(*buf, *size + sizeof(h) + n_z)) == NULL)
+		return 5;
+	    *buf = b;
+	    if (compress2((Bytef *)(b + *size + sizeof(h)), &n_z, (const Bytef *)p, (uLong)n, level) != Z_OK)
+		return 5;
+	    h[3] = n_z;
+	    memcpy(b + *size, h, sizeof(h));
+	    *size += sizeof(h) + n_z;
+	    return 0;
+	}
+#endif
+    if ((b = (char *)realloc(*buf, *size + sizeof(h[0]) + n)) == NULL)
+	return 5;
+    *buf = b;
+    memcpy(b + *size, h + 1, sizeof(h[0]));
+    memcpy(b + *size + sizeof(h[0]), p, n);
+    *size += sizeof(h[0]) + n;
+    return 0;
+}
+
+/**
+ * @brief This function encodes the points, connectivity, offsets and cell types of the mesh once for the VTU series.
+ * @param[in] mv:       Structure of meshing variable data.
+ * @param[in] num_cell: Number of the grid cells.
+ * @return    Whether there is an error (0: Success, 5: Memory error).
+ */
+static int vtu_mesh_encode(const struct mesh_var mv, const int num_cell)
+{
+    int k, i, n_c = 0, err = 0;
+    double * pt;
+    int * con, * off;
+    unsigned char * type;
+
+    for(k = 0; k < num_cell; k++)
+	n_c += mv.cell_pt[k][0];
+    pt   = (double *)malloc(3 * mv.num_pt * sizeof(double));
+    con  = (int *)malloc(n_c * sizeof(int));
+    off  = (int *)malloc(num_cell * sizeof(int));
+    type = (unsigned char *)malloc(num_cell);
+    free(vtu_c.mesh);
+    vtu_c.X         = NULL;
+    vtu_c.mesh      = NULL;
+    vtu_c.mesh_size = 0;
+    if (pt == NULL || con == NULL || off == NULL || type == NULL)
+	{
+	    err = 5;
+	    goto return_err;
+	}
+    for(k = 0; k < mv.num_pt; k++)
+	{
+	    pt[3*k]   = mv.X[k];
+	    pt[3*k+1] = mv.Y[k];
+	    pt[3*k+2] = 0.0;
+	}
+    for(n_c = 0, k = 0; k < num_cell; k++)
+	{
+	    for(i = 1; i <= mv.cell_pt[k][0]; i++)
+		con[n_c++] = mv.cell_pt[k][i];
+	    off[k]  = n_c;
+	    type[k] = 7; // VTK_POLYGON
+	}
+#ifdef VTUZLIB
+    vtu_c.zlib   = (int)config[48] > 0;
+#else
+    vtu_c.zlib   = false;
+#endif
+    vtu_c.off[0] = vtu_c.mesh_size;
+    err = vtu_block(&vtu_c.mesh, &vtu_c.mesh_size, pt,  3ULL * mv.num_pt * sizeof(double));
+    vtu_c.off[1] = vtu_c.mesh_size;
+    err = err ? err : vtu_block(&vtu_c.mesh, &vtu_c.mesh_size, con, (unsigned long long)n_c * sizeof(int));
+    vtu_c.off[2] = vtu_c.mesh_size;
+    err = err ? err : vtu_block(&vtu_c.mesh, &vtu_c.mesh_size, off, (unsigned long long)num_cell * sizeof(int));
+    vtu_c.off[3] = vtu_c.mesh_size;
+    err = err ? err : vtu_block(&vtu_c.mesh, &vtu_c.mesh_size, type, (unsigned long long)num_cell);
+    if (err == 0)
+	{
+	    vtu_c.X        = mv.X;
+	    vtu_c.num_pt   = mv.num_pt;
+	    vtu_c.num_cell = num_cell;
+	}
+ return_err:
+    free(pt);
+    free(con);
+    free(off);
+    free(type);
+    return err;
+}
+
+//! Compare two plotting times for qsort.
+static int vtu_time_cmp(const void * a, const void * b)
+{
+    const double d = *(const double *)a - *(const double *)b;
+    return (d > 0.0) - (d < 0.0);
+}
+
+/**
+ * @brief This function adds a frame to the VTU series and rewrites the '.pvd' index of the series.
+ * @param[in] file_pvd: Address of the '.pvd' file.
+ * @param[in] ext:      Extension of the files of the frames ("vtu" or "pvtu").
+ * @param[in,out] t_s:  Pointer to the plotting times of the frames written.
+ * @param[in,out] n_t:  Pointer to the number of the frames written.
+ * @param[in] time:     The plotting time of the frame.
+ */
+static void vtu_pvd_write(const char * file_pvd, const char * ext, double ** t_s, int * n_t, const double time)
+{
+    const double eps = config[4];
+    double * t;
+    FILE * fp;
+    int i;
+
+    for(i = 0; i < *n_t; i++)
+	if ((*t_s)[i] == time)
+	    break;
+    if (i == *n_t)
+	{
+	    if ((t = (double *)realloc(*t_s, (*n_t+1) * sizeof(double))) == NULL)
+		{
+		    printf("NOT enough memory! PVD frames\n");
+		    return;
+		}
+	    *t_s = t;
+	    t[(*n_t)++] = time;
+	    // The frames may be written by the threads in any order.
+	    qsort(t, *n_t, sizeof(double), vtu_time_cmp);
+	}
+    if ((fp = fopen(file_pvd, "w")) == NULL)
+	{
+	    fprintf(stderr, "Cannot open solution output PVD file!\n");
+	    exit(1);
+	}
+    fprintf(fp, "<?xml version=\"1.0\"?>\n");
+    fprintf(fp, "<VTKFile type=\"Collection\" version=\"1.0\">\n<Collection>\n");
+    for(i = 0; i < *n_t; i++)
+	fprintf(fp, "<DataSet timestep=\"%.8g\" part=\"0\" file=\"FLU_VAR_%.8g.%s\"/>\n", (*t_s)[i] + eps, (*t_s)[i] + eps, ext);
+    fprintf(fp, "</Collection>\n</VTKFile>\n");
+    fclose(fp);
+}
+
+/**
+ * @brief This function writes the '.pvtu' index of the pieces of a frame and adds it to the series 'FLU_VAR.pvd' of the index.
+ * @param[in] byte_order: Byte order of the pieces.
+ * @param[in] time:       The plotting time of the frame.
+ */
+static void vtu_pvtu_write(const char * byte_order, const double time)
+{
+    const double eps = config[4];
+    char file_pvtu[FILENAME_MAX+40], file_pvd[FILENAME_MAX+40];
+    FILE * fp;
+    int r;
+
+    sprintf(file_pvtu, "%sFLU_VAR_%.8g.pvtu", vtu_c.pvtu, time + eps);
+    sprintf(file_pvd,  "%sFLU_VAR.pvd", vtu_c.pvtu);
+    if ((fp = fopen(file_pvtu, "w")) == NULL)
+	{
+	    fprintf(stderr, "Cannot open solution output PVTU file!\n");
+	    exit(1);
+	}
+    fprintf(fp, "<?xml version=\"1.0\"?>\n");
+    fprintf(fp, "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n", byte_order);
+    fprintf(fp, "<PUnstructuredGrid GhostLevel=\"0\">\n");
+    fprintf(fp, "<PPoints>\n<PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n</PPoints>\n");
+    fprintf(fp, "<PCellData Scalars=\"P\" Vectors=\"velocity\">\n");
+    fprintf(fp, "<PDataArray type=\"Float64\" Name=\"P\" NumberOfComponents=\"1\"/>\n");
+    fprintf(fp, "<PDataArray type=\"Float64\" Name=\"RHO\" NumberOfComponents=\"1\"/>\n");
+#ifdef MULTIFLUID_BASICS
+    fprintf(fp, "<PDataArray type=\"Float64\" Name=\"Z_a\" NumberOfComponents=\"1\"/>\n");
+#ifdef MULTIPHASE_BASICS
+    fprintf(fp, "<PDataArray type=\"Float64\" Name=\"P_b\" NumberOfComponents=\"1\"/>\n");
+    fprintf(fp, "<PDataArray type=\"Float64\" Name=\"RHO_b\" NumberOfComponents=\"1\"/>\n");
+    fprintf(fp, "<PDataArray type=\"Float64\" Name=\"U_b\" NumberOfComponents=\"1\"/>\n");
+    fprintf(fp, "<PDataArray type=\"Float64\" Name=\"V_b\" NumberOfComponents=\"1\"/>\n");
+#else
+    fprintf(fp, "<PDataArray type=\"Float64\" Name=\"PHI\" NumberOfComponents=\"1\"/>\n");
+    fprintf(fp, "<PDataArray type=\"Float64\" Name=\"gamma\" NumberOfComponents=\"1\"/>\n");
+#endif
+#endif
+    for(r = 0; r < (int)config[71]; r++)
+	fprintf(fp, "<PDataArray type=\"Float64\" Name=\"Y_%d\" NumberOfComponents=\"1\"/>\n", r+1);
+    fprintf(fp, "<PDataArray type=\"Float64\" Name=\"velocity\" NumberOfComponents=\"3\"/>\n");
+    fprintf(fp, "</PCellData>\n");
+    for(r = 0; r < vtu_c.num_piece; r++)
+	fprintf(fp, "<Piece Source=\"rank_%d/FLU_VAR_%.8g.vtu\"/>\n", r, time + eps);
+    fprintf(fp, "</PUnstructuredGrid>\n</VTKFile>\n");
+    fclose(fp);
+    vtu_pvd_write(file_pvd, "pvtu", &vtu_c.t_p, &vtu_c.n_tp, time);
+}
+
+/**
+ * @brief Print out the XML header of the cell data array 'v' and encode its appended block.
+ */
+#define VTU_CELL_DATA(v, p, n_comp)					\
+    do {								\
+	fprintf(fp, "<DataArray type=\"Float64\" Name=\"%s\" NumberOfComponents=\"%d\" format=\"appended\" offset=\"%ld\"/>\n", \
+		v, n_comp, vtu_c.mesh_size + size);			\
+	err = err ? err : vtu_block(&buf, &size, p, (unsigned long long)n_comp * num_cell * sizeof(double)); \
+    } while (0)
+
+/**
+ * @brief This function write the 2-D solution into VTK XML output '.vtu' files with appended binary data,
+ *        and lists the files in the time series index 'FLU_VAR.pvd'.
+ * @details The mesh is encoded once and the same blocks are appended to every frame of the series,
+ *          so only the fluid variables are encoded at each plotting time.
+ * @param[in] FV: Structure of fluid variable data array in computational grid.
+ * @param[in] mv: Structure of meshing variable data.
+ * @param[in] problem: Name of the numerical results for the test problem.
+ * @param[in] time: The plotting time.
+ */
+void file_write_2D_VTU(const struct flu_var FV, const struct mesh_var mv, const char * problem, const double time)
+{
+    FILE_ORDER_WRITE(file_write_2D_VTU);
+    const double eps = config[4];
+    const int num_cell = (int)config[3];
+    const unsigned short endian = 1;
+    const char * byte_order = *(const unsigned char *)&endian ? "LittleEndian" : "BigEndian";
+
+    char file_data[FILENAME_MAX], file_pvd[FILENAME_MAX];
+    char str_tmp[40];
+    char * buf = NULL;
+    long size = 0;
+    double * vel;
+    int k, err = 0;
+    FILE * fp;
+
+    example_io(&run_ctx_global, problem, file_data, 0);
+    strcpy(file_pvd, file_data);
+    strcat(file_pvd, "FLU_VAR.pvd");
+    sprintf(str_tmp, "FLU_VAR_%.8g.vtu", time + eps);
+    strcat(file_data, str_tmp);
+
+    VTU_LOCK();
+    if ((vtu_c.X != mv.X || vtu_c.num_pt != mv.num_pt || vtu_c.num_cell != num_cell) && vtu_mesh_encode(mv, num_cell) != 0)
+	{
+	    VTU_UNLOCK();
+	    printf("NOT enough memory! VTU mesh\n");
+	    exit(5);
+	}
+    VTU_UNLOCK();
+
+    if ((fp = fopen(file_data, "wb")) == NULL)
+	{
+	    fprintf(stderr, "Cannot open solution output VTU file!\n");
+	    exit(1);
+	}
+    fprintf(fp, "<?xml version=\"1.0\"?>\n");
+    fprintf(fp, "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\"%s>\n",
+	    byte_order, vtu_c.zlib ? " compressor=\"vtkZLibDataCompressor\"" : "");
+    fprintf(fp, "<UnstructuredGrid>\n<Piece NumberOfPoints=\"%d\" NumberOfCells=\"%d\">\n", mv.num_pt, num_cell);
+    fprintf(fp, "<Points>\n<DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\"%ld\"/>\n</Points>\n", vtu_c.off[0]);
+    fprintf(fp, "<Cells>\n");
+    fprintf(fp, "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"appended\" offset=\"%ld\"/>\n", vtu_c.off[1]);
+    fprintf(fp, "<DataArray type=\"Int32\" Name=\"offsets\" format=\"appended\" offset=\"%ld\"/>\n", vtu_c.off[2]);
+    fprintf(fp, "<DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"%ld\"/>\n", vtu_c.off[3]);
+    fprintf(fp, "</Cells>\n<CellData Scalars=\"P\" Vectors=\"velocity\">\n");
+
+    vel = (double *)malloc(3 * num_cell * sizeof(double));
+    if (vel == NULL)
+	err = 5;
+    else
+	for(k = 0; k < num_cell; k++)
+	    {
+		vel[3*k]   = FV.U[k];
+		vel[3*k+1] = FV.V[k];
+		vel[3*k+2] = 0.0;
+	    }
+    VTU_CELL_DATA("P",   FV.P,   1);
+    VTU_CELL_DATA("RHO", FV.RHO, 1);
+#ifdef MULTIFLUID_BASICS
+    VTU_CELL_DATA("Z_a", FV.Z_a, 1);
+#ifdef MULTIPHASE_BASICS
+    VTU_CELL_DATA("P_b",   FV.P_b,   1);
+    VTU_CELL_DATA("RHO_b", FV.RHO_b, 1);
+    VTU_CELL_DATA("U_b",   FV.U_b,   1);
+    VTU_CELL_DATA("V_b",   FV.V_b,   1);
+#else
+    VTU_CELL_DATA("PHI",   FV.PHI,   1);
+    VTU_CELL_DATA("gamma", FV.gamma, 1);
+#endif
+#endif
+    for(k = 0; FV.Y != NULL && k < (int)config[71]; k++)
+	{
+	    sprintf(str_tmp, "Y_%d", k+1);
+	    VTU_CELL_DATA(str_tmp, FV.Y + (size_t)k*FV.n_Y, 1);
+	}
+    if (vel)
+	VTU_CELL_DATA("velocity", vel, 3);
+    free(vel);
+    if (err)
+	{
+	    printf("NOT enough memory! VTU data\n");
+	    fclose(fp);
+	    remove(file_data);
+	    exit(5);
+	}
+    fprintf(fp, "</CellData>\n</Piece>\n</UnstructuredGrid>\n");
+    fprintf(fp, "<AppendedData encoding=\"raw\">\n_");
+    // The mesh blocks are not changed after being encoded.
+    fwrite(vtu_c.mesh, 1, vtu_c.mesh_size, fp);
+    fwrite(buf, 1, size, fp);
+    fprintf(fp, "\n</AppendedData>\n</VTKFile>\n");
+    fclose(fp);
+    free(buf);
+
+    VTU_LOCK();
+    vtu_pvd_write(file_pvd, "vtu", &vtu_c.t, &vtu_c.n_t, time);
+    if (vtu_c.num_piece > 1)
+	vtu_pvtu_write(byte_order, time);
+    VTU_UNLOCK();
+}
+
+/**
+ * @brief This function sets the '.pvtu' index of the VTU pieces written by the parts of the grids into their folders 'rank_r/'.
+ * @details It is called by one of the processes, which then writes 'FLU_VAR_t.pvtu' of each plotting time
+ *          and their series 'FLU_VAR.pvd' into the output folder of the whole grids.
+ * @param[in] problem:   Name of the numerical results for the test problem.
+ * @param[in] num_piece: Number of the parts of the grids.
+ */
+void file_write_2D_PVTU_init(const char * problem, const int num_piece)
+{
+    example_io(&run_ctx_global, problem, vtu_c.pvtu, 0);
+    vtu_c.num_piece = num_piece;
+}
+
+/**
+ * @brief This function frees the cache of the VTU series.
+ */
+void file_write_2D_VTU_free(void)
+{
+    free(vtu_c.mesh);
+    free(vtu_c.t);
+    free(vtu_c.t_p);
+    memset(&vtu_c, 0, sizeof(vtu_c));
+}
+
+
+/**
+ * @brief This function writes the copy of the fluid variables in a staging slot into the output files.
+ * @details It runs on its own thread, so that the time loop goes on while the ASCII data are formatted and written.
+ * @param[in] arg: Pointer to the staging slot.
+ */
+#ifdef _WIN32
+static unsigned __stdcall out_slot_thread(void * arg)
+#else
+static void * out_slot_thread(void * arg)
+#endif
+{
+    const struct out_slot * s = (const struct out_slot *)arg;
+    if (s->plot & 1)
+	file_write_2D_BLOCK_TEC(s->FV, *s->mv, s->problem, s->time);
+    if (s->plot & 2)
+	file_write_3D_VTK(s->FV, *s->mv, s->problem, s->time);
+    if (s->plot & 4)
+	file_write_2D_VTU(s->FV, *s->mv, s->problem, s->time);
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @brief This function waits for the thread writing a staging slot.
+ * @param[in,out] s: Pointer to the staging slot.
+ */
+static void out_slot_wait(struct out_slot * s)
+{
+    if (s->thread == NULL)
+	return;
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)s->thread, INFINITE);
+    CloseHandle((HANDLE)s->thread);
+#else
+    pthread_join(*(pthread_t *)s->thread, NULL);
+    free(s->thread);
+#endif
+    s->thread = NULL;
+}
+
+/**
+ * @brief This function initializes the double-buffered queue of the asynchronous output on unstructured grids.
+ * @details The output is written synchronously if config[47] is false or there is not enough memory for the staging slots.
+ * @param[out] q:       Pointer to the output queue.
+ * @param[in]  mv:      Pointer to the meshing variables, which are kept unchanged during the run.
+ * @param[in]  problem: Name of the numerical results for the test problem.
+ * @param[in]  num_cell: Number of the grid cells.
+ * @return     Whether the output is asynchronous (0: Synchronous, 1: Asynchronous).
+ */
+int file_2D_unstruct_async_init(struct out_queue * q, const struct mesh_var * mv, const char * problem, const int num_cell)
+{
+    int i;
+    memset(q, 0, sizeof(struct out_queue));
+    q->num_cell = num_cell;
+    for (i = 0; i < 2; i++)
+	{
+	    q->slot[i].mv      = mv;
+	    q->slot[i].problem = problem;
+	}
+    q->sync = !(_Bool)config[47];
+    if (q->sync)
+	return 0;
+#define FV_ALLOC(v) if ((q->slot[i].FV.v = (double *)malloc(num_cell * sizeof(double))) == NULL) q->sync = true
+    for (i = 0; i < 2; i++)
+	{
+	    FV_STAGE(FV_ALLOC);
+	    if ((int)config[71] > 0) // the rows of the species
+		{
+		    q->slot[i].FV.n_Y = num_cell;
+		    if ((q->slot[i].FV.Y = (double *)malloc((size_t)config[71] * num_cell * sizeof(double))) == NULL)
+			q->sync = true;
+		}
+	}
+#undef FV_ALLOC
+    if (q->sync)
+	{
+	    printf("NOT enough memory! Asynchronous output is off.\n");
+	    file_2D_unstruct_async_free(q);
+	    q->sync = true;
+	    return 0;
+	}
+    return 1;
+}
+
+/**
+ * @brief This function writes the fluid variables of a plotting time through the output queue.
+ * @details The fluid variables are copied into the next staging slot and written by another thread
+ *          while the time loop goes on. If that slot is still being written, which means the writer falls
+ *          behind by two outputs, the time loop waits for it at first.
+ * @param[in,out] q:  Pointer to the output queue.
+ * @param[in]     FV: Pointer to the fluid variables in computational grid.
+ * @param[in]   time: The plotting time.
+ * @param[in]   plot: Files to be written (bits 1: Tecplot, 2: VTK, 4: VTU).
+ */
+void file_2D_unstruct_async_write(struct out_queue * q, const struct flu_var * FV, const double time, const int plot)
+{
+    struct out_slot * s = q->slot + q->next;
+    if (q->sync)
+	{
+	    if (plot & 1)
+		file_write_2D_BLOCK_TEC(*FV, *s->mv, s->problem, time);
+	    if (plot & 2)
+		file_write_3D_VTK(*FV, *s->mv, s->problem, time);
+	    if (plot & 4)
+		file_write_2D_VTU(*FV, *s->mv, s->problem, time);
+	    return;
+	}
+    out_slot_wait(s);
+#define FV_COPY(v) memcpy(s->FV.v, FV->v, q->num_cell * sizeof(double))
+    FV_STAGE(FV_COPY);
+#undef FV_COPY
+    for (int k = 0; FV->Y != NULL && k < (int)config[71]; k++)
+	memcpy(s->FV.Y + (size_t)k*q->num_cell, FV->Y + (size_t)k*FV->n_Y, q->num_cell * sizeof(double));
+    s->time = time;
+    s->plot = plot;
+#ifdef _WIN32
+    s->thread = (void *)_beginthreadex(NULL, 0, out_slot_thread, s, 0, NULL);
+    if (s->thread == NULL)
+	out_slot_thread(s);
+#else
+    s->thread = malloc(sizeof(pthread_t));
+    if (s->thread == NULL || pthread_create((pthread_t *)s->thread, NULL, out_slot_thread, s) != 0)
+	{
+	    free(s->thread);
+	    s->thread = NULL;
+	    out_slot_thread(s); // Write it synchronously.
+	}
+#endif
+    q->next ^= 1;
+}
+
+/**
+ * @brief This function waits for the writing of the staging slots and frees the output queue.
+ * @param[in,out] q: Pointer to the output queue.
+ */
+void file_2D_unstruct_async_free(struct out_queue * q)
+{
+    int i;
+#define FV_FREE(v) free(q->slot[i].FV.v); q->slot[i].FV.v = NULL
+    for (i = 0; i < 2; i++)
+	{
+	    out_slot_wait(q->slot + q->next);
+	    q->next ^= 1;
+	}
+    for (i = 0; i < 2; i++)
+	{
+	    FV_STAGE(FV_FREE);
+	    FV_FREE(Y);
+	}
+#undef FV_FREE
+}
+
+
+/**
+ * @brief This function publishes the current solution on the unstructured mesh live into the shared memory
+ *        when a frame is due (config[87]).
+ * @details The fields RHO, U, V, P of the cells (in the order of the mesh) are published, no file is written.
+ * @param[in] FV:   Structure of the fluid variables in the cells.
+ * @param[in] num_cell: Number of the cells.
+ * @param[in] k:    The time step.
+ * @param[in] time: The current time.
+ */
+void file_2D_unstruct_publish(const struct flu_var * FV, const int num_cell, const int k, const double time)
+{
+    static const char * const name[] = {"RHO", "U", "V", "P"};
+    if(!live_publish_due())
+	return;
+    double * const rho = FV->RHO, * const u = FV->U, * const v_ = FV->V, * const p = FV->P;
+    double * const * const v[] = {&rho, &u, &v_, &p};
+    live_publish_frame(k, time, 4, name, v, 1, num_cell);
+}
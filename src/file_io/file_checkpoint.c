@@ -0,0 +1,313 @@
+/**
+ * @file  file_checkpoint.c
+ * @brief This is a set of functions which write and read the binary checkpoints of the time loops.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "../include/var_struc.h"
+#include "../include/file_io.h"
+
+
+static const char ckpt_magic[8] = {'H','Y','D','R','O','C','K','1'}; // file signature and version
+
+/**
+ * @brief This function writes the buffer of a checkpoint into a temporary file and renames it as the checkpoint file.
+ * @details It runs on its own thread, so that the previous checkpoint file is kept until the new one is complete.
+ * @param[in,out] arg: Pointer to the structure of the checkpoint.
+ */
+#ifdef _WIN32
+static unsigned __stdcall checkpoint_thread(void * arg)
+#else
+static void * checkpoint_thread(void * arg)
+#endif
+{
+    struct ckpt_var * cv = (struct ckpt_var *)arg;
+    char add_tmp[FILENAME_MAX+40];
+    FILE * fp;
+
+    strcpy(add_tmp, cv->add);
+    strcat(add_tmp, ".tmp");
+    if((fp = fopen(add_tmp, "wb")) == NULL)
+	{
+	    printf("Cannot open checkpoint file!\n");
+	    cv->err = 1;
+	}
+    else
+	{
+	    if(fwrite(cv->buf, 1, cv->buf_size, fp) != (size_t)cv->buf_size)
+		{
+		    printf("Write error occurrs in checkpoint file!\n");
+		    cv->err = 1;
+		}
+	    if(fclose(fp) != 0)
+		cv->err = 1;
+#ifdef _WIN32
+	    remove(cv->add);
+#endif
+	    if(!cv->err && rename(add_tmp, cv->add) != 0)
+		{
+		    printf("Cannot rename checkpoint file!\n");
+		    cv->err = 1;
+		}
+	}
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @brief This function waits for the thread writing the last checkpoint.
+ * @param[in,out] cv: Pointer to the structure of the checkpoint.
+ */
+static void checkpoint_wait(struct ckpt_var * cv)
+{
+    if(cv->thread == NULL)
+	return;
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)cv->thread, INFINITE);
+    CloseHandle((HANDLE)cv->thread);
+#else
+    pthread_join(*(pthread_t *)cv->thread, NULL);
+    free(cv->thread);
+#endif
+    cv->thread = NULL;
+}
+
+/**
+ * @brief This function initializes the checkpoint of a run in the output folder of the test problem.
+ * @param[in]  ctx:     Pointer to the run context.
+ * @param[out] cv:      Pointer to the structure of the checkpoint.
+ * @param[in]  problem: Name of the numerical results for the test problem.
+ * @return     Whether there is an error (0: Success, 1: Memory error).
+ */
+int checkpoint_init(const struct run_ctx * ctx, struct ckpt_var * cv, const char * problem)
+{
+    memset(cv, 0, sizeof(struct ckpt_var));
+    cv->add = (char *)malloc(FILENAME_MAX+40);
+    if(cv->add == NULL)
+	{
+	    printf("NOT enough memory! Checkpoint\n");
+	    cv->err = 1;
+	    return 1;
+	}
+    // Get the address of the output data folder of the test example.
+    example_io(ctx, problem, cv->add, 0);
+    strcat(cv->add, "checkpoint.bin");
+    return 0;
+}
+
+/**
+ * @brief This function appends a memory block of the state of the time loop to the checkpoint.
+ * @details The blocks are written and read in the order of appending,
+ *          so a run and its restart append the same blocks.
+ * @param[in,out] cv: Pointer to the structure of the checkpoint.
+ * @param[in] p:      Address of the memory block.
+ * @param[in] size:   Size of the memory block in bytes.
+ */
+void checkpoint_add(struct ckpt_var * cv, void * p, const long size)
+{
+    void ** PP;
+    long * SS;
+    if(cv->err)
+	return;
+    PP = (void **)realloc(cv->p,    (cv->n+1) * sizeof(void *));
+    if(PP != NULL)
+	cv->p = PP;
+    SS = (long *) realloc(cv->size, (cv->n+1) * sizeof(long));
+    if(SS != NULL)
+	cv->size = SS;
+    if(PP == NULL || SS == NULL)
+	{
+	    printf("NOT enough memory! Checkpoint block\n");
+	    cv->err = 1;
+	    return;
+	}
+    cv->p[cv->n]    = p;
+    cv->size[cv->n] = size;
+    cv->n++;
+}
+
+/**
+ * @brief This function appends the stored levels of the 1-D fluid variables to the checkpoint.
+ * @param[in,out] cv: Pointer to the structure of the checkpoint.
+ * @param[in] m:      Number of the grids.
+ * @param[in] N_T:    Number of levels storing fluid variables in memory.
+ * @param[in] CV:     Structure of cell variable data.
+ * @param[in] X:      Array of the coordinate data (NULL: Eulerian grids).
+ */
+void checkpoint_add_1D(struct ckpt_var * cv, const int m, const int N_T, const struct cell_var_stru CV, double ** X)
+{
+    int k;
+    for(k = 0; k < N_T; ++k)
+	{
+	    checkpoint_add(cv, CV.RHO[k], m * sizeof(double));
+	    checkpoint_add(cv, CV.U[k],   m * sizeof(double));
+	    checkpoint_add(cv, CV.P[k],   m * sizeof(double));
+	    checkpoint_add(cv, CV.E[k],   m * sizeof(double));
+	    if(X)
+		checkpoint_add(cv, X[k], (m+1) * sizeof(double));
+	}
+}
+
+/**
+ * @brief This function appends the stored levels of the 2-D fluid variables and the slopes to the checkpoint.
+ * @param[in,out] cv: Pointer to the structure of the checkpoint.
+ * @param[in] m:      Number of the x-grids: n_x.
+ * @param[in] n:      Number of the y-grids: n_y.
+ * @param[in] N_T:    Number of 2-D data dimension storing fluid variables in memory.
+ * @param[in] CV:     Structure of cell variable data.
+ */
+void checkpoint_add_2D(struct ckpt_var * cv, const int m, const int n, const int N_T, const struct cell_var_stru * CV)
+{
+    int k, j;
+    for(k = 0; k < N_T; ++k)
+	for(j = 0; j < m; ++j)
+	    {
+		checkpoint_add(cv, CV[k].RHO[j], n * sizeof(double));
+		checkpoint_add(cv, CV[k].U[j],   n * sizeof(double));
+		checkpoint_add(cv, CV[k].V[j],   n * sizeof(double));
+		checkpoint_add(cv, CV[k].P[j],   n * sizeof(double));
+		checkpoint_add(cv, CV[k].E[j],   n * sizeof(double));
+	    }
+    for(j = 0; j < m; ++j)
+	{
+	    checkpoint_add(cv, CV->s_rho[j], n * sizeof(Real_Store));
+	    checkpoint_add(cv, CV->s_u[j],   n * sizeof(Real_Store));
+	    checkpoint_add(cv, CV->s_v[j],   n * sizeof(Real_Store));
+	    checkpoint_add(cv, CV->s_p[j],   n * sizeof(Real_Store));
+	    checkpoint_add(cv, CV->t_rho[j], n * sizeof(Real_Store));
+	    checkpoint_add(cv, CV->t_u[j],   n * sizeof(Real_Store));
+	    checkpoint_add(cv, CV->t_v[j],   n * sizeof(Real_Store));
+	    checkpoint_add(cv, CV->t_p[j],   n * sizeof(Real_Store));
+	}
+}
+
+/**
+ * @brief This function writes a checkpoint of the current state asynchronously.
+ * @details The memory blocks are copied into the buffer, and the buffer is written by another thread
+ *          while the time loop goes on. The writing of the last checkpoint is waited for at first.
+ * @param[in,out] cv: Pointer to the structure of the checkpoint.
+ * @return     Whether there is an error (0: Success, 1: Error in the list or in the last writing).
+ */
+int checkpoint_write(struct ckpt_var * cv)
+{
+    long size = sizeof(ckpt_magic) + sizeof(int) + cv->n * sizeof(long);
+    char * b;
+    int i;
+
+    checkpoint_wait(cv);
+    if(cv->err)
+	return 1;
+    for(i = 0; i < cv->n; ++i)
+	size += cv->size[i];
+    if(size != cv->buf_size)
+	{
+	    free(cv->buf);
+	    cv->buf_size = size;
+	    if((cv->buf = (char *)malloc(size)) == NULL)
+		{
+		    printf("NOT enough memory! Checkpoint buffer\n");
+		    cv->buf_size = 0;
+		    cv->err = 1;
+		    return 1;
+		}
+	}
+    b = cv->buf;
+    memcpy(b, ckpt_magic, sizeof(ckpt_magic));
+    b += sizeof(ckpt_magic);
+    memcpy(b, &cv->n, sizeof(int));
+    b += sizeof(int);
+    memcpy(b, cv->size, cv->n * sizeof(long));
+    b += cv->n * sizeof(long);
+    for(i = 0; i < cv->n; ++i)
+	{
+	    memcpy(b, cv->p[i], cv->size[i]);
+	    b += cv->size[i];
+	}
+
+#ifdef _WIN32
+    cv->thread = (void *)_beginthreadex(NULL, 0, checkpoint_thread, cv, 0, NULL);
+    if(cv->thread == NULL)
+	checkpoint_thread(cv);
+#else
+    cv->thread = malloc(sizeof(pthread_t));
+    if(cv->thread == NULL || pthread_create((pthread_t *)cv->thread, NULL, checkpoint_thread, cv) != 0)
+	{
+	    free(cv->thread);
+	    cv->thread = NULL;
+	    checkpoint_thread(cv); // Write it synchronously.
+	}
+#endif
+    return cv->thread ? 0 : cv->err;
+}
+
+/**
+ * @brief This function reads the checkpoint file into the memory blocks to restart the time loop.
+ * @param[in,out] cv: Pointer to the structure of the checkpoint.
+ * @return     Whether there is an error (0: Success, 1: Reading error or mismatch of the blocks).
+ */
+int checkpoint_read(struct ckpt_var * cv)
+{
+    FILE * fp;
+    char magic[sizeof(ckpt_magic)];
+    int i, n;
+    long size;
+
+    if(cv->err)
+	return 1;
+    if((fp = fopen(cv->add, "rb")) == NULL)
+	{
+	    printf("Cannot open checkpoint file '%s'!\n", cv->add);
+	    return 1;
+	}
+    if(fread(magic, sizeof(magic), 1, fp) != 1 || memcmp(magic, ckpt_magic, sizeof(magic)) != 0 ||
+       fread(&n, sizeof(int), 1, fp) != 1 || n != cv->n)
+	{
+	    printf("The checkpoint file is not written by this scheme!\n");
+	    goto return_err;
+	}
+    for(i = 0; i < n; ++i)
+	if(fread(&size, sizeof(long), 1, fp) != 1 || size != cv->size[i])
+	    {
+		printf("The %d-th block of the checkpoint does not match the run, check the grids and plotting times!\n", i);
+		goto return_err;
+	    }
+    for(i = 0; i < n; ++i)
+	if(fread(cv->p[i], 1, cv->size[i], fp) != (size_t)cv->size[i])
+	    {
+		printf("Read error occurrs in checkpoint file!\n");
+		goto return_err;
+	    }
+    fclose(fp);
+    printf("The run restarts from the checkpoint '%s'.\n", cv->add);
+    return 0;
+
+ return_err:
+    fclose(fp);
+    return 1;
+}
+
+/**
+ * @brief This function waits for the writing of the last checkpoint and frees the checkpoint.
+ * @param[in,out] cv: Pointer to the structure of the checkpoint.
+ */
+void checkpoint_free(struct ckpt_var * cv)
+{
+    checkpoint_wait(cv);
+    free(cv->p);
+    free(cv->size);
+    free(cv->buf);
+    free(cv->add);
+    memset(cv, 0, sizeof(struct ckpt_var));
+}
@@ -0,0 +1,268 @@
+/**
+ * @file  file_init_gen.c
+ * @brief This is a set of functions which generate the analytic initial data described by the 'init' rows of 'config.txt'.
+ * @details Each row 'init <kind> key=value ...' is applied to the cell centers in order, a later row overrides the
+ *          fluid variables given in it on the cells it covers:
+ *          - init state  rho=1 u=0 p=1                   : uniform state of the whole domain;
+ *          - init box    x0=0.5 x1=1 y0= y1= rho=0.125   : piecewise-constant data in a box (the bounds are infinite by default),
+ *                                                          such as the states of a Riemann problem;
+ *          - init ball   x=0.5 y=0.5 r0=0.1 r=0.2 phi=1  : bubble (r0 = 0) or shell of the radii r0 <= r < r with a material;
+ *          - init sine   kx=1 ky=0 phase=0 rho=0.2       : smooth waves adding the amplitudes times
+ *                                                          sin(2π(kx x/L_x + ky y/L_y) + phase), such as the entropy waves.
+ *          The keys of the fluid variables are rho, u, v, p and the materials phi, z_a, gamma (or z_a, rho_b, u_b, v_b, p_b
+ *          of the two-phase flows). The cells are config[3] (1-D) or config[13] x config[14] (2-D) with the spatial
+ *          grid lengths config[10] and config[11], so that no initial data file is read.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <limits.h>
+#include <stdbool.h>
+
+#include "../include/var_struc.h"
+#include "../include/file_io.h"
+#include "../include/tools.h"
+
+#ifndef M_PI
+#define M_PI acos(-1.0)
+#endif
+
+//! The maximum number of the 'init' rows.
+#define N_INIT_OP 64
+
+//! Kinds of the 'init' rows.
+enum init_kind {INIT_STATE, INIT_BOX, INIT_BALL, INIT_SINE};
+
+//! Fluid variables generated and the keys of the 'init' rows.
+#ifdef MULTIFLUID_BASICS
+#ifdef MULTIPHASE_BASICS
+#define INIT_VAR(S) S(RHO, "rho") S(U, "u") S(V, "v") S(P, "p") S(Z_a, "z_a") S(RHO_b, "rho_b") S(U_b, "u_b") S(V_b, "v_b") S(P_b, "p_b")
+#else
+#define INIT_VAR(S) S(RHO, "rho") S(U, "u") S(V, "v") S(P, "p") S(PHI, "phi") S(Z_a, "z_a") S(gamma, "gamma")
+#endif
+#else
+#define INIT_VAR(S) S(RHO, "rho") S(U, "u") S(V, "v") S(P, "p")
+#endif
+
+#define INIT_ID(v, key)  IG_##v,
+#define INIT_KEY(v, key) key,
+enum init_var_id {INIT_VAR(INIT_ID) IG_NUM};
+static const char * const init_key[] = {INIT_VAR(INIT_KEY)};
+
+//! An 'init' row.
+struct init_op {
+	int kind;
+	double x0, x1, y0, y1; //!< bounds of a box.
+	double xc, yc, r0, r1; //!< center and radii of a ball.
+	double kx, ky, phase;  //!< wave numbers and phase of a sine wave.
+	double val[IG_NUM];    //!< values or amplitudes of the fluid variables (NAN: not given).
+};
+
+
+/**
+ * @brief This function parses an 'init' row.
+ * @param[in]  s:  The row after 'init'.
+ * @param[out] op: The 'init' row parsed.
+ * @return     Whether the row is valid.
+ */
+static _Bool init_op_parse(const char * s, struct init_op * op)
+{
+    char kind[16], key[16];
+    double tmp;
+    int v, n;
+    const struct init_op op0 = {INIT_STATE, -INFINITY, INFINITY, -INFINITY, INFINITY, 0.0, 0.0, 0.0, INFINITY, 1.0, 0.0, 0.0, {0.0}};
+
+    *op = op0;
+    for (v = 0; v < IG_NUM; v++)
+	op->val[v] = NAN;
+    if (sscanf(s, "%15s%n", kind, &n) != 1)
+	return false;
+    if (strcmp(kind, "state") == 0)
+	op->kind = INIT_STATE;
+    else if (strcmp(kind, "box") == 0)
+	op->kind = INIT_BOX;
+    else if (strcmp(kind, "ball") == 0)
+	op->kind = INIT_BALL;
+    else if (strcmp(kind, "sine") == 0)
+	{
+	    op->kind = INIT_SINE;
+	    op->kx   = 1.0;
+	}
+    else
+	return false;
+    for (s += n; sscanf(s, " %15[^= \t\n]=%lf%n", key, &tmp, &n) == 2; s += n)
+	{
+	    for (v = 0; v < IG_NUM && strcmp(key, init_key[v]) != 0; v++) ;
+	    if (v < IG_NUM)
+		op->val[v] = tmp;
+	    else if (strcmp(key, "x0") == 0)
+		op->x0 = tmp;
+	    else if (strcmp(key, "x1") == 0)
+		op->x1 = tmp;
+	    else if (strcmp(key, "y0") == 0)
+		op->y0 = tmp;
+	    else if (strcmp(key, "y1") == 0)
+		op->y1 = tmp;
+	    else if (strcmp(key, "x") == 0)
+		op->xc = tmp;
+	    else if (strcmp(key, "y") == 0)
+		op->yc = tmp;
+	    else if (strcmp(key, "r0") == 0)
+		op->r0 = tmp;
+	    else if (strcmp(key, "r") == 0)
+		op->r1 = tmp;
+	    else if (strcmp(key, "kx") == 0)
+		op->kx = tmp;
+	    else if (strcmp(key, "ky") == 0)
+		op->ky = tmp;
+	    else if (strcmp(key, "phase") == 0)
+		op->phase = tmp;
+	    else
+		return false;
+	}
+    for ( ; isspace((unsigned char)*s); s++) ;
+    return *s == '\0' || *s == '#';
+}
+
+/**
+ * @brief This function generates the initial data of the 'init' rows of the configuration file, if there is any.
+ * @details The fluid variables are evaluated on the cells in parallel. As the initial data files,
+ *          the volume fraction 'z_a' defaults to the mass fraction 'phi' and the specific heat ratio 'gamma'
+ *          to that of the mixture of the volume fraction.
+ * @param[in,out] ctx: Pointer to the run context, config[3] is set as the number of the cells of the 2-D grids.
+ * @param[in]  add_in: Adress of the initial data folder of the test example.
+ * @param[in]  dim:    Dimension of the grids (1 or 2).
+ * @param[out] FV0:    Initial fluid variables.
+ * @return     Whether the initial data are generated (0: No 'init' row, the initial data files are read).
+ */
+int init_gen(struct run_ctx * ctx, const char * add_in, const int dim, struct flu_var * FV0)
+{
+    char add[FILENAME_MAX+40], one_line[200], * s;
+    struct init_op op[N_INIT_OP];
+    int n_op = 0, line_num = 0, v, k, o;
+    _Bool given[IG_NUM] = {false};
+    double * arr[IG_NUM] = {NULL};
+    FILE * fp;
+
+    strcpy(add, add_in);
+    strcat(add, "config.txt");
+    if ((fp = fopen(add, "r")) == NULL)
+	return 0;
+    while (fgets(one_line, sizeof(one_line), fp) != NULL)
+	{
+	    line_num++;
+	    for (s = one_line; isspace((unsigned char)*s); s++) ;
+	    if (strncmp(s, "init", 4) != 0 || !isspace((unsigned char)s[4]))
+		continue;
+	    if (n_op == N_INIT_OP)
+		{
+		    fprintf(stderr, "Too many 'init' rows (> %d) in configuration file!\n", N_INIT_OP);
+		    exit(2);
+		}
+	    if (!init_op_parse(s + 4, op + n_op))
+		{
+		    fprintf(stderr, "Invalid 'init' row in line %d of configuration file!\n", line_num);
+		    exit(2);
+		}
+	    for (v = 0; v < IG_NUM; v++)
+		given[v] = given[v] || !isnan(op[n_op].val[v]);
+	    n_op++;
+	}
+    fclose(fp);
+    if (n_op == 0)
+	return 0;
+
+    if (dim == 2)
+	ctx->conf[3] = ctx->conf[13] * ctx->conf[14];
+    if (!(ctx->conf[3] >= 1.0 && ctx->conf[3] < INT_MAX) || !(ctx->conf[10] > 0.0) || (dim == 2 && !(ctx->conf[11] > 0.0)))
+	{
+	    fprintf(stderr, "The numbers of the cells (config[3] or config[13], config[14]) and the spatial grid lengths are needed by the 'init' rows!\n");
+	    exit(2);
+	}
+    const int n_x = dim == 2 ? (int)ctx->conf[13] : (int)ctx->conf[3];
+    const int num_cell = (int)ctx->conf[3];
+    const double h_x = ctx->conf[10], h_y = dim == 2 ? ctx->conf[11] : 1.0;
+    const double L_x = n_x * h_x, L_y = dim == 2 ? (num_cell / n_x) * h_y : 1.0;
+#ifdef MULTIFLUID_BASICS
+#ifndef MULTIPHASE_BASICS
+    given[IG_Z_a] = given[IG_gamma] = true; // the defaults of the volume fraction and the specific heat ratio
+#endif
+#endif
+    if (dim == 1)
+	given[IG_V] = false;
+    for (v = 0; v < IG_NUM; v++)
+	if (given[v] && (arr[v] = (double *)malloc(num_cell * sizeof(double))) == NULL)
+	    {
+		printf("NOT enough memory! %s\n", init_key[v]);
+		exit(5);
+	    }
+
+    int err = -1; // the first fluid variable not given on a cell
+#pragma omp parallel for private(v, o) reduction(max:err)
+    for (k = 0; k < num_cell; k++)
+	{
+	    double w[IG_NUM], x, y, r, q;
+	    x = ((k % n_x) + 0.5) * h_x;
+	    y = dim == 2 ? ((k / n_x) + 0.5) * h_y : 0.0;
+	    for (v = 0; v < IG_NUM; v++)
+		w[v] = NAN;
+	    for (o = 0; o < n_op; o++)
+		{
+		    switch (op[o].kind)
+			{
+			case INIT_BOX:
+			    if (x < op[o].x0 || x >= op[o].x1 || y < op[o].y0 || y >= op[o].y1)
+				continue;
+			    break;
+			case INIT_BALL:
+			    r = sqrt((x - op[o].xc)*(x - op[o].xc) + (dim == 2 ? (y - op[o].yc)*(y - op[o].yc) : 0.0));
+			    if (r < op[o].r0 || r >= op[o].r1)
+				continue;
+			    break;
+			case INIT_SINE:
+			    q = sin(2.0*M_PI*(op[o].kx*x/L_x + op[o].ky*y/L_y) + op[o].phase);
+			    for (v = 0; v < IG_NUM; v++)
+				if (!isnan(op[o].val[v]))
+				    w[v] += op[o].val[v] * q;
+			    continue;
+			}
+		    for (v = 0; v < IG_NUM; v++)
+			if (!isnan(op[o].val[v]))
+			    w[v] = op[o].val[v];
+		}
+#ifdef MULTIFLUID_BASICS
+#ifndef MULTIPHASE_BASICS
+	    if (isnan(w[IG_Z_a]))
+		w[IG_Z_a] = w[IG_PHI];
+	    if (isnan(w[IG_gamma]))
+		w[IG_gamma] = 1.0 + 1.0 / (w[IG_Z_a]/(ctx->conf[6]-1.0) + (1.0-w[IG_Z_a])/(ctx->conf[106]-1.0));
+#endif
+#endif
+	    for (v = 0; v < IG_NUM; v++)
+		if (arr[v] != NULL)
+		    {
+			if (!isfinite(w[v]))
+			    err = MAX(err, IG_NUM - v);
+			arr[v][k] = w[v];
+		    }
+	}
+    if (err >= 0)
+	{
+	    fprintf(stderr, "Initial '%s' is not given on all the cells by the 'init' rows!\n", init_key[IG_NUM - err]);
+	    exit(2);
+	}
+    for (v = 0; v < IG_NUM; v++)
+	if (arr[v] == NULL && (dim == 2 || v != IG_V))
+	    {
+		fprintf(stderr, "Initial '%s' is not given by the 'init' rows!\n", init_key[v]);
+		exit(2);
+	    }
+#define INIT_SET(v, key) FV0->v = arr[IG_##v];
+    INIT_VAR(INIT_SET)
+#undef INIT_SET
+    printf("Initial data generated by %d 'init' row(s) of the configuration file.\n", n_op);
+    return 1;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file  file_out_field.c
+ * @brief This is a set of functions which select the fields of the output of the structured solutions
+ *        and compute the derived ones when they are written.
+ * @details The bit 1 << f of config[94] selects the field f (enum out_field) of the '.dat' and HDF5 output.
+ *          Only the fields of the schemes (RHO, U, V, P and E) are kept in the levels of the solution,
+ *          the derived fields are computed from them line by line or point by point while a file is written,
+ *          so that they are never stored, and the fields not selected are never written.
+ *          The coordinates of the cell centers (X, Y or R) are always written.
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "../include/var_struc.h"
+#include "../include/file_io.h"
+
+
+//! Names of the output files (or datasets) of the fields.
+const char * const out_field_name[OUT_FIELD_N] = {"RHO", "U", "V", "P", "E", "e_int", "c", "Ma", "S", "omega"};
+
+/**
+ * @brief This function lists the fields of the output selected by config[94].
+ * @details V and the vorticity are 2-D fields, which are left out of the 1-D output.
+ * @param[in]  ctx: Pointer to the run context.
+ * @param[in]  dim: Dimensionality of the solution.
+ * @param[out] f:   The selected fields in order (at most OUT_FIELD_N).
+ * @return     The number of the selected fields.
+ */
+int out_field_list(const struct run_ctx * ctx, const int dim, int * f)
+{
+    const int sel = (int)ctx->conf[94];
+    int v, n = 0;
+    for(v = 0; v < OUT_FIELD_N; ++v)
+	if(sel & (1 << v) && (dim > 1 || (v != OUT_V && v != OUT_VORT)))
+	    f[n++] = v;
+    return n;
+}
+
+/**
+ * @brief This function tells whether the field is in the output.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in] f:   The field (enum out_field).
+ * @return    Whether the field is selected by config[94].
+ */
+_Bool out_field_on(const struct run_ctx * ctx, const int f)
+{
+    return ((int)ctx->conf[94] >> f) & 1;
+}
+
+/**
+ * @brief This function computes a derived field of a cell from the primitive variables of the ideal gas.
+ * @param[in] f:     The derived field (OUT_EINT, OUT_SOUND, OUT_MACH or OUT_ENTROPY).
+ * @param[in] gamma: Constant of the perfect gas.
+ * @param[in] rho:   Density.
+ * @param[in] q:     Speed.
+ * @param[in] p:     Pressure.
+ * @return    The specific internal energy, the sound speed, the Mach number, or the specific entropy in units of
+ *            the gas constant ln(p/rho^gamma)/(gamma-1).
+ */
+static double out_derived(const int f, const double gamma, const double rho, const double q, const double p)
+{
+    switch(f)
+	{
+	case OUT_EINT:
+	    return p / (gamma - 1.0) / rho;
+	case OUT_SOUND:
+	    return sqrt(gamma * p / rho);
+	case OUT_MACH:
+	    return q / sqrt(gamma * p / rho);
+	default:
+	    return log(p / pow(rho, gamma)) / (gamma - 1.0);
+	}
+}
+
+/**
+ * @brief This function computes a line of a field of the 1-D output.
+ * @param[in]  ctx: Pointer to the run context.
+ * @param[in]  f:   The field (enum out_field, not OUT_V or OUT_VORT).
+ * @param[in]  m:   The number of the grid cells.
+ * @param[in]  CV:  Structure of grid variable data in computational grid cells.
+ * @param[in]  nt:  Index of the level of 'CV'.
+ * @param[out] v:   The values of the field in the cells (m doubles).
+ */
+void out_field_1D(const struct run_ctx * ctx, const int f, const int m, const struct cell_var_stru * CV, const int nt, double * v)
+{
+    const double gamma = ctx->conf[6];
+    const double * RHO = CV->RHO[nt], * U = CV->U[nt], * P = CV->P[nt];
+    const double * const w[5] = {RHO, U, NULL, P, f == OUT_E ? CV->E[nt] : NULL};
+    int j;
+    if(f < OUT_EINT)
+	for(j = 0; j < m; ++j)
+	    v[j] = w[f][j];
+    else
+	for(j = 0; j < m; ++j)
+	    v[j] = out_derived(f, gamma, RHO[j], fabs(U[j]), P[j]);
+}
+
+//! The coordinate Z of the center of the cell (j, i).
+#define OUT_CENTER(Z, j, i) (0.25*(Z[j][i] + Z[j][(i)+1] + Z[(j)+1][i] + Z[(j)+1][(i)+1]))
+
+/**
+ * @brief This function computes a field of the 2-D output in a cell.
+ * @details The vorticity dV/dx-dU/dy is given by the central differences of the velocity between the cell centers,
+ *          which are one-sided in the cells on the boundaries.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in] f:   The field (enum out_field).
+ * @param[in] n_x: The number of x-spatial points.
+ * @param[in] n_y: The number of y-spatial points.
+ * @param[in] CV:  Structure of variable data of the level.
+ * @param[in] X:   Array of the x-coordinate data.
+ * @param[in] Y:   Array of the y-coordinate data.
+ * @param[in] j:   x-index of the cell.
+ * @param[in] i:   y-index of the cell.
+ * @return    The value of the field in the cell.
+ */
+double out_field_2D(const struct run_ctx * ctx, const int f, const int n_x, const int n_y, const struct cell_var_stru * CV,
+		    double ** X, double ** Y, const int j, const int i)
+{
+    const double gamma = ctx->conf[6];
+    const int jl = j > 0 ? j-1 : j, jr = j < n_x-1 ? j+1 : j;
+    const int il = i > 0 ? i-1 : i, ir = i < n_y-1 ? i+1 : i;
+    double dv_x = 0.0, du_y = 0.0;
+    switch(f)
+	{
+	case OUT_RHO:
+	    return CV->RHO[j][i];
+	case OUT_U:
+	    return CV->U[j][i];
+	case OUT_V:
+	    return CV->V[j][i];
+	case OUT_P:
+	    return CV->P[j][i];
+	case OUT_E:
+	    return CV->E[j][i];
+	case OUT_VORT:
+	    if(jr > jl)
+		dv_x = (CV->V[jr][i] - CV->V[jl][i]) / (OUT_CENTER(X, jr, i) - OUT_CENTER(X, jl, i));
+	    if(ir > il)
+		du_y = (CV->U[j][ir] - CV->U[j][il]) / (OUT_CENTER(Y, j, ir) - OUT_CENTER(Y, j, il));
+	    return dv_x - du_y;
+	default:
+	    return out_derived(f, gamma, CV->RHO[j][i], sqrt(CV->U[j][i]*CV->U[j][i] + CV->V[j][i]*CV->V[j][i]), CV->P[j][i]);
+	}
+}
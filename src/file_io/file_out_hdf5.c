@@ -1,6 +1,9 @@
 /**
  * @file file_out_hdf5.c
  * @brief This is a set of functions which control the readout of 1-D and 2-D data in HDF5 file format.
+ * @details Each fluid variable is an extendible dataset '/v' of the snapshots (the first dimension is time),
+ *          which is stored in chunks of a snapshot and may be compressed (config[45], config[46]).
+ *          The plotting times and the CPU time are the attributes 'time_plot' and 'cpu_time' of the root group.
  * @attention  Library Dependency: HDF5®
  */
 
@@ -14,6 +17,13 @@
 #include "hdf5.h"
 
 
+/* Create the dataspace information items in the metadata of the dataset.
+ * dataspace_id = H5Screate_simple(int rank (spatial dimension),
+ *                                 const hsize_t* current_dims (number of elements per dimension),
+ *                                 const hsize_t* max_dims, (upper limit on the number of elements per dimension)
+ *                                  - NULL: same as current_dim.
+ *                                  - H5S_UNLIMITED: no upper limit, but the dataset must be chunked.);
+ */
 /* Create the data itself in the dataset.
  * dataset_id = H5Dcreate(loc_id (location id), const char *name (dataset name),
  *                        hid_t dtype_id (data type) hid_t space_id (dataspace id),
@@ -31,18 +41,266 @@
  *                                const void * buf (the location of data in memory) );
  */
 
+//! The maximum number of elements in a chunk of the datasets.
+#define CHUNK_MAX (1<<22)
+
 /**
- * @brief Print out fluid variable 'v' with data array 'v_array'.
+ * @brief This function creates the property list of the datasets with the chunks and the filters.
+ * @param[in] ctx:   Pointer to the run context.
+ * @param[in] rank:  Rank of the datasets (with the time dimension).
+ * @param[in] dims:  Dimensions of a snapshot in the datasets (dims[0] = 1).
+ * @return  The identifier of the property list.
  */
-#define PRINT_NC(v, v_array)						\
-    do {								\
-	dataset_id = H5Dcreate(group_id, #v, H5T_NATIVE_FLOAT, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT); \
-	status = H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, v_array); \
-	status = H5Dclose(dataset_id);					\
-    } while (0)
+static hid_t hdf5_dcpl(const struct run_ctx * ctx, const int rank, const hsize_t * dims)
+{
+    const int zip = (int)ctx->conf[45];
+    hsize_t chunk[3];
+    unsigned int info;
+    hid_t dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+
+    // A chunk is a snapshot, or some of its lines for a large snapshot.
+    for(int i = 0; i < rank; ++i)
+	chunk[i] = dims[i];
+    if(chunk[rank-1] > CHUNK_MAX)
+	chunk[rank-1] = CHUNK_MAX;
+    if(rank == 3 && chunk[1] * chunk[2] > CHUNK_MAX)
+	chunk[1] = CHUNK_MAX / chunk[2] ? CHUNK_MAX / chunk[2] : 1;
+    H5Pset_chunk(dcpl_id, rank, chunk);
+
+    if(zip > 0 && (int)ctx->conf[46])
+	H5Pset_shuffle(dcpl_id);
+    if(zip > 0 && zip < 10)
+	{
+	    if(H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+		H5Pset_deflate(dcpl_id, zip);
+	    else
+		printf("The gzip filter of HDF5 is not available, the data is not compressed!\n");
+	}
+    else if(zip == 10)
+	{
+	    if(H5Zfilter_avail(H5Z_FILTER_SZIP) > 0 && H5Zget_filter_info(H5Z_FILTER_SZIP, &info) >= 0 &&
+	       (info & H5Z_FILTER_CONFIG_ENCODE_ENABLED))
+		H5Pset_szip(dcpl_id, H5_SZIP_NN_OPTION_MASK, 16);
+	    else
+		printf("The szip filter of HDF5 is not available, the data is not compressed!\n");
+	}
+    return dcpl_id;
+}
+
+/**
+ * @brief This function opens the output HDF5 file of the test problem.
+ * @details The file is created when k = 0, otherwise it is opened to append the k-th snapshot.
+ * @param[in] ctx:     Pointer to the run context.
+ * @param[in] problem: Name of the numerical results for the test problem.
+ * @param[in] k:       Index of the first snapshot to write.
+ * @return  The identifier of the file.
+ */
+static hid_t hdf5_open(const struct run_ctx * ctx, const char * problem, const int k)
+{
+    char file_data[FILENAME_MAX+40];
+    hid_t file_id;
+    // Get the address of the output data folder of the test example.
+    example_io(ctx, problem, file_data, 0);
+    strcat(file_data, "FLU_VAR.h5");
+    /*
+     * file_id = H5Fcreate(const char *filename,
+     *                     unsigned overlay_flag,
+     *                      - H5F_ACC_TRUNC->can overlay
+     *                      - H5F_ACC_EXCL ->cannot overlay, error
+     *                     hid_t created_property, hid_t accessed_property);
+     * file_id = H5Fopen(const char *filename, 
+     *                   unsigned read-write_flag,
+     *                    - H5F_ACC_RDWR   read-write
+     *                    - H5F_ACC_RDONLY read only
+     *                   hid_t accessed_property);
+     */
+    if(k)
+	file_id = H5Fopen(file_data, H5F_ACC_RDWR, H5P_DEFAULT);
+    else
+	file_id = H5Fcreate(file_data, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if(file_id < 0)
+	{
+	    printf("Cannot open solution output file: FLU_VAR.h5!\n");
+	    exit(1);
+	}
+    return file_id;
+}
+
+/**
+ * @brief This function writes the k-th snapshot of a fluid variable into its extendible dataset.
+ * @details The dataset is created when k = 0, otherwise its extent is set to (k+1) snapshots,
+ *          so that the snapshots after a restart are overwritten.
+ * @param[in] ctx:     Pointer to the run context.
+ * @param[in] file_id: Identifier of the HDF5 file.
+ * @param[in] name:    Name of the dataset.
+ * @param[in] rank:    Rank of the dataset (with the time dimension).
+ * @param[in] dims:    Dimensions of a snapshot in the dataset (dims[0] = 1).
+ * @param[in] k:       Index of the snapshot.
+ * @param[in] v:       Data array of the snapshot.
+ */
+static void hdf5_append(const struct run_ctx * ctx, const hid_t file_id, const char * name,
+			const int rank, const hsize_t * dims, const int k, const double * v)
+{
+    hsize_t ext[3], max_dims[3], start[3] = {0, 0, 0};
+    hid_t dataset_id, dataspace_id, memspace_id, dcpl_id;
+    herr_t status;
+
+    for(int i = 0; i < rank; ++i)
+	{
+	    ext[i]      = dims[i];
+	    max_dims[i] = dims[i];
+	}
+    ext[0]      = (hsize_t)k + 1;
+    max_dims[0] = H5S_UNLIMITED;
+    start[0]    = (hsize_t)k;
+    if(k && H5Lexists(file_id, name, H5P_DEFAULT) > 0)
+	{
+	    dataset_id = H5Dopen(file_id, name, H5P_DEFAULT);
+	    status = H5Dset_extent(dataset_id, ext);
+	}
+    else
+	{
+	    dcpl_id      = hdf5_dcpl(ctx, rank, dims);
+	    dataspace_id = H5Screate_simple(rank, ext, max_dims);
+	    dataset_id   = H5Dcreate(file_id, name, H5T_NATIVE_FLOAT, dataspace_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+	    status = H5Sclose(dataspace_id);
+	    status = H5Pclose(dcpl_id);
+	}
+    dataspace_id = H5Dget_space(dataset_id);
+    status = H5Sselect_hyperslab(dataspace_id, H5S_SELECT_SET, start, NULL, dims, NULL);
+    memspace_id  = H5Screate_simple(rank, dims, NULL);
+    status = H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, memspace_id, dataspace_id, H5P_DEFAULT, v);
+    if(status < 0)
+	printf("Write error occurrs in the dataset '%s' of FLU_VAR.h5!\n", name);
+    H5Sclose(memspace_id);
+    H5Sclose(dataspace_id);
+    H5Dclose(dataset_id);
+}
+
+/**
+ * @brief This function writes an array attribute of the root group, which replaces the old one.
+ * @param[in] file_id: Identifier of the HDF5 file.
+ * @param[in] name:    Name of the attribute.
+ * @param[in] n:       Length of the attribute.
+ * @param[in] v:       Data array of the attribute.
+ */
+static void hdf5_attr(const hid_t file_id, const char * name, const int n, const double * v)
+{
+    const hsize_t dimsA[1] = {(hsize_t)n};
+    hid_t attr_id, dataspaceA_id;
+
+    if(H5Aexists(file_id, name) > 0)
+	H5Adelete(file_id, name);
+    dataspaceA_id = H5Screate_simple(1, dimsA, NULL);
+    attr_id = H5Acreate(file_id, name, H5T_NATIVE_DOUBLE, dataspaceA_id, H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attr_id, H5T_NATIVE_DOUBLE, v);
+    H5Aclose(attr_id);
+    H5Sclose(dataspaceA_id);
+}
+
+/**
+ * @brief This function sets the k-th plotting time in the attribute 'time_plot' of the root group.
+ * @param[in] file_id: Identifier of the HDF5 file.
+ * @param[in] k:       Index of the snapshot.
+ * @param[in] time:    The plotting time of the snapshot.
+ */
+static void hdf5_time_append(const hid_t file_id, const int k, const double time)
+{
+    double * t = (double *)calloc(k+1, sizeof(double)), * t_old = NULL;
+    hid_t attr_id, dataspaceA_id;
+    hssize_t n = 0; // The number of the plotting times written.
+    if(t == NULL)
+	{
+	    printf("NOT enough memory! time_plot\n");
+	    exit(5);
+	}
+    if(k && H5Aexists(file_id, "time_plot") > 0)
+	{
+	    attr_id       = H5Aopen(file_id, "time_plot", H5P_DEFAULT);
+	    dataspaceA_id = H5Aget_space(attr_id);
+	    n = H5Sget_simple_extent_npoints(dataspaceA_id);
+	    if(n >= k && (t_old = (double *)malloc(n * sizeof(double))) != NULL &&
+	       H5Aread(attr_id, H5T_NATIVE_DOUBLE, t_old) >= 0)
+		memcpy(t, t_old, k * sizeof(double));
+	    free(t_old);
+	    H5Sclose(dataspaceA_id);
+	    H5Aclose(attr_id);
+	}
+    t[k] = time;
+    hdf5_attr(file_id, "time_plot", k+1, t);
+    free(t);
+}
+
+/**
+ * @brief Print out the k-th snapshot of fluid variable 'v' with data array 'v_array'.
+ */
+#define PRINT_NC(v, v_array) hdf5_append(ctx, file_id, #v, rank, dims, k, v_array)
+
+/**
+ * @brief This function gives the names of the datasets of the output, which are the fields selected by config[94]
+ *        and the coordinates of the cell centers.
+ * @param[in]  ctx:  Pointer to the run context.
+ * @param[in]  dim:  Dimensionality of the solution.
+ * @param[out] name: Names of the datasets (at most OUT_FIELD_N+2).
+ * @return     The number of the datasets.
+ */
+static int hdf5_names(const struct run_ctx * ctx, const int dim, const char ** name)
+{
+#ifdef RADIAL_BASICS
+    const char * name_X = "R";
+#else
+    const char * name_X = "X";
+#endif
+    int f[OUT_FIELD_N], v;
+    const int n_f = out_field_list(ctx, dim, f);
+    for(v = 0; v < n_f; ++v)
+	name[v] = out_field_name[f[v]];
+    name[v++] = dim > 1 ? "X" : name_X;
+    if(dim > 1)
+	name[v++] = "Y";
+    return v;
+}
+
+/**
+ * @brief This function writes the k-th 1-D snapshot of the fluid variables into the HDF5 file.
+ * @param[in] ctx:     Pointer to the run context.
+ * @param[in] file_id: Identifier of the HDF5 file.
+ * @param[in] m:       The number of spatial points in the output data.
+ * @param[in] k:       Index of the snapshot in the output data.
+ * @param[in] CV:      Structure of grid variable data in computational grid cells.
+ * @param[in] nt:      Index of the level of 'CV' storing the snapshot.
+ * @param[in] X:       Array of the coordinate data of the snapshot (NULL: Eulerian grid of size config[10]).
+ * @param[out] XX:     Array of the output coordinate data (m doubles).
+ */
+static void hdf5_snapshot_1D(const struct run_ctx * ctx, const hid_t file_id, const int m, const int k,
+			     const struct cell_var_stru CV, const int nt, const double * X, double * XX)
+{
+    const double h = ctx->conf[10];
+    const int rank = 2;
+    const hsize_t dims[2] = {1, (hsize_t)m};
+    int v, f[OUT_FIELD_N];
+    const int n_f = out_field_list(ctx, 1, f);
+
+    // The fields are computed one by one in the buffer of the coordinates.
+    for(v = 0; v < n_f; ++v)
+	{
+	    out_field_1D(ctx, f[v], m, &CV, nt, XX);
+	    hdf5_append(ctx, file_id, out_field_name[f[v]], rank, dims, k, XX);
+	}
+#ifdef RADIAL_BASICS
+    (void)h;
+    (void)XX;
+    PRINT_NC(R, X);
+#else
+    for(int j = 0; j < m; ++j)
+	XX[j] = X ? 0.5 * (X[j] + X[j+1]) : 0.5 * (h * j + h * (j+1));
+    PRINT_NC(X, XX);
+#endif
+}
 
 /**
  * @brief This function write the 1-D solution into HDF5 output '.h5' files.
+ * @param[in] ctx: Pointer to the run context.
  * @param[in] m:   The number of spatial points in the output data.
  * @param[in] N:   The number of time steps in the output data.
  * @param[in] CV:  Structure of grid variable data in computational grid cells.
@@ -51,17 +309,9 @@
  * @param[in] problem:   Name of the numerical results for the test problem.
  * @param[in] time_plot: Array of the plotting time recording.
  */
-void file_1D_write_HDF5(const int m, const int N, const struct cell_var_stru CV, 
+void file_1D_write_HDF5(const struct run_ctx * ctx, const int m, const int N, const struct cell_var_stru CV, 
 			double * X[], const double * cpu_time, const char * problem, double time_plot[])
 {
-    char add_out[FILENAME_MAX+40];
-    // Get the address of the output data folder of the test example.
-    example_io(problem, add_out, 0);
-    
-    char file_data[FILENAME_MAX+40];
-    strcpy(file_data, add_out);
-    strcat(file_data, "FLU_VAR.h5");
-    
     double *XX = (double*)malloc(m * sizeof(double));
     if(XX == NULL)
 	{
@@ -69,86 +319,152 @@ void file_1D_write_HDF5(const int m, const int N, const struct cell_var_stru CV,
 	    exit(5);
 	}
 
-    hid_t file_id, group_id, attr_id, dataspace_id, dataspaceA_id, dataset_id;
-    herr_t status;
-    const unsigned rank = 1;
-    const hsize_t dims[1] = {(hsize_t)m}, dimsA[1] = {1};
-    /*
-     * file_id = H5Fcreate(const char *filename,
-     *                     unsigned overlay_flag,
-     *                      - H5F_ACC_TRUNC->can overlay
-     *                      - H5F_ACC_EXCL ->cannot overlay, error
-     *                     hid_t created_property, hid_t accessed_property);
-     */
-    file_id = H5Fcreate(file_data, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-    /* Create the dataspace information items in the metadata of the dataset.
-     * dataspace_id = H5Screate_simple(int rank (spatial dimension),
-     *                                 const hsize_t* current_dims (number of elements per dimension),
-     *                                 const hsize_t* max_dims, (upper limit on the number of elements per dimension)
-     *                                  - NULL: same as current_dim.
-     *                                  - H5S_UNLIMITED: no upper limit, but the dataset must be chunked.);
-     */
-    dataspace_id  = H5Screate_simple(rank, dims,  NULL);
-    dataspaceA_id = H5Screate_simple(rank, dimsA, NULL);
-
-    char group_name[14];
+    hid_t file_id = hdf5_open(ctx, problem, 0);
     for(int k = 0; k < N; k++)
+	hdf5_snapshot_1D(ctx, file_id, m, k, CV, k, X[k], XX);
+    hdf5_attr(file_id, "time_plot", N, time_plot);
+    hdf5_attr(file_id, "cpu_time",  N, cpu_time);
+    H5Fclose(file_id);
+    
+    free(XX);
+    XX = NULL;
+}
+
+/**
+ * @brief This function writes the HDF5 file of the whole 1-D grids decomposed into the parts of the processes.
+ * @details Each fluid variable is a virtual dataset of the N*M cells, which maps the datasets
+ *          of the files 'rank_r/FLU_VAR.h5' of the parts, so the data of the whole grids are read in order
+ *          without being gathered by a process.
+ * @param[in] ctx:   Pointer to the run context.
+ * @param[in] M:     The number of cells of the whole grids.
+ * @param[in] N:     The number of time steps in the output data.
+ * @param[in] num_p: The number of the parts.
+ * @param[in] part:  First cells and numbers of the cells of the parts {j0, m, ...}.
+ * @param[in] cpu_time:  Array of the CPU time recording (NULL: no record).
+ * @param[in] problem:   Name of the numerical results for the test problem.
+ * @param[in] time_plot: Array of the plotting time recording.
+ */
+void file_1D_write_HDF5_parts(const struct run_ctx * ctx, const int M, const int N, const int num_p, const int * part,
+			      const double * cpu_time, const char * problem, double time_plot[])
+{
+    const char * name[OUT_FIELD_N+2];
+    const int n_v = hdf5_names(ctx, 1, name);
+    const hsize_t dims[2] = {(hsize_t)N, (hsize_t)M};
+    hsize_t start[2] = {0, 0}, count[2] = {(hsize_t)N, 0};
+    char file_p[40];
+    hid_t file_id = hdf5_open(ctx, problem, 0), dataspace_id, src_space_id, dcpl_id, dataset_id;
+    int v, r;
+
+    dataspace_id = H5Screate_simple(2, dims, NULL);
+    for(v = 0; v < n_v; ++v)
 	{
-	    sprintf(group_name, "/T%d", k);
-	    /*
-	     * new_group_id = H5Gcreate2(group_id, absolute or relative group link name,
-	     *                           link created_propertygroup created_property, group accessed_property);
-	     */
-	    group_id = H5Gcreate(file_id, group_name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	    // group2_id = H5Gcreate(group_id, "/MyGroup1/MyGroup2",  H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-	    // group2_id = H5Gcreate(group_id, "./MyGroup2",  H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-
-	    /* Create an attribute. */
-	    attr_id = H5Acreate(group_id, "time_plot", H5T_NATIVE_FLOAT, dataspaceA_id, H5P_DEFAULT, H5P_DEFAULT);
-	    status  = H5Awrite(attr_id, H5T_NATIVE_DOUBLE, time_plot+k);
-	    status  = H5Aclose(attr_id);
-
-	    PRINT_NC(RHO, CV.RHO[k]);
-	    PRINT_NC(U,   CV.U[k]);
-	    PRINT_NC(P,   CV.P[k]);
-	    PRINT_NC(E,   CV.E[k]);
-#ifdef RADIAL_BASICS
-	    PRINT_NC(R, X[k]);
-#else
-	    for(int j = 0; j < m; ++j)
-		XX[j] = 0.5 * (X[k][j] + X[k][j+1]);
-	    PRINT_NC(X, XX);
-#endif
+	    dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+	    for(r = 0; r < num_p; ++r)
+		{
+		    start[1] = (hsize_t)part[2*r];
+		    count[1] = (hsize_t)part[2*r+1];
+		    H5Sselect_hyperslab(dataspace_id, H5S_SELECT_SET, start, NULL, count, NULL);
+		    src_space_id = H5Screate_simple(2, count, NULL);
+		    sprintf(file_p, "rank_%d/FLU_VAR.h5", r);
+		    H5Pset_virtual(dcpl_id, dataspace_id, file_p, name[v], src_space_id);
+		    H5Sclose(src_space_id);
+		}
+	    H5Sselect_all(dataspace_id);
+	    dataset_id = H5Dcreate(file_id, name[v], H5T_NATIVE_FLOAT, dataspace_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+	    if(dataset_id < 0)
+		printf("Write error occurrs in the virtual dataset '%s' of FLU_VAR.h5!\n", name[v]);
+	    else
+		H5Dclose(dataset_id);
+	    H5Pclose(dcpl_id);
+	}
+    H5Sclose(dataspace_id);
+    hdf5_attr(file_id, "time_plot", N, time_plot);
+    if(cpu_time)
+	hdf5_attr(file_id, "cpu_time",  N, cpu_time);
+    H5Fclose(file_id);
+}
 
-	    status = H5Gclose(group_id);
+
+/**
+ * @brief This function appends one 1-D snapshot into HDF5 output '.h5' files (streaming output).
+ * @details The file is created when k = 0, and it is closed after each snapshot,
+ *          so the snapshots written may be read while the run goes on.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in] m:   The number of spatial points in the output data.
+ * @param[in] k:   Index of the snapshot in the output data.
+ * @param[in] CV:  Structure of grid variable data in computational grid cells.
+ * @param[in] nt:  Index of the level of 'CV' storing the snapshot.
+ * @param[in] X:   Array of the coordinate data of the snapshot (NULL: Eulerian grid of size config[10]).
+ * @param[in] cpu_time: Array of the CPU time recording (not NULL: the last snapshot).
+ * @param[in] problem:  Name of the numerical results for the test problem.
+ * @param[in] time:     The plotting time of the snapshot.
+ */
+void file_1D_write_HDF5_stream(const struct run_ctx * ctx, const int m, const int k, const struct cell_var_stru CV, const int nt,
+			       const double * X, const double * cpu_time, const char * problem, double time)
+{
+    double *XX = (double*)malloc(m * sizeof(double));
+    if(XX == NULL)
+	{
+	    printf("NOT enough memory! plot X\n");
+	    exit(5);
 	}
 
-    status = H5Sclose(dataspaceA_id);
-    status = H5Sclose(dataspace_id);
-    status = H5Fclose(file_id);
+    hid_t file_id = hdf5_open(ctx, problem, k);
+    hdf5_snapshot_1D(ctx, file_id, m, k, CV, nt, X, XX);
+    hdf5_time_append(file_id, k, time);
+    if(cpu_time)
+	hdf5_attr(file_id, "cpu_time", 1, cpu_time+nt);
+    H5Fclose(file_id);
     
     free(XX);
     XX = NULL;
-    if(status)
-        return;
-    /*
-     * file_id = H5Fopen(const char *filename, 
-     *                   unsigned read-write_flag,
-     *                    - H5F_ACC_RDWR   read-write
-     *                    - H5F_ACC_RDONLY read only
-     *                   hid_t accessed_property);
-     */
-    // file_id = H5Fopen(file_data, H5F_ACC_RDWR, H5P_DEFAULT);
-    /*
-     * group_id = H5Gopen2(father group_id, absolute or relative group link name,
-     *                     group accessed_property);
-     */
-    // group_id = H5Gopen(file_id, "MyGroup1/MyGroup2", H5P_DEFAULT);
 }
 
 
+/**
+ * @brief This function writes the k-th 2-D snapshot of the fluid variables into the HDF5 file.
+ * @details The datasets of a snapshot are (n_y*n_x) arrays, whose lines are the x-lines of the grid.
+ * @param[in] ctx:     Pointer to the run context.
+ * @param[in] file_id: Identifier of the HDF5 file.
+ * @param[in] n_x:     The number of x-spatial points in the output data.
+ * @param[in] n_y:     The number of y-spatial points in the output data.
+ * @param[in] k:       Index of the snapshot in the output data.
+ * @param[in] CV:      Structure of variable data of the snapshot.
+ * @param[in] X:       Array of the x-coordinate data.
+ * @param[in] Y:       Array of the y-coordinate data.
+ * @param[out] buf:    Buffer of a snapshot of a variable (n_x*n_y doubles).
+ */
+static void hdf5_snapshot_2D(const struct run_ctx * ctx, const hid_t file_id, const int n_x, const int n_y, const int k,
+			     const struct cell_var_stru CV, double ** X, double ** Y, double * buf)
+{
+    const int rank = 3;
+    const hsize_t dims[3] = {1, (hsize_t)n_y, (hsize_t)n_x};
+    int i, j, v, f[OUT_FIELD_N];
+    const int n_f = out_field_list(ctx, 2, f);
+
+#define PRINT_NC_2D(v, v_print)				\
+    do {						\
+	for(i = 0; i < n_y; ++i)			\
+	    for(j = 0; j < n_x; ++j)			\
+		buf[i*n_x + j] = (v_print);		\
+	PRINT_NC(v, buf);				\
+    } while (0)
+
+    for(v = 0; v < n_f; ++v)
+	{
+	    for(i = 0; i < n_y; ++i)
+		for(j = 0; j < n_x; ++j)
+		    buf[i*n_x + j] = out_field_2D(ctx, f[v], n_x, n_y, &CV, X, Y, j, i);
+	    hdf5_append(ctx, file_id, out_field_name[f[v]], rank, dims, k, buf);
+	}
+    PRINT_NC_2D(X,   0.25*(X[j][i] + X[j][i+1] + X[j+1][i] + X[j+1][i+1]));
+    PRINT_NC_2D(Y,   0.25*(Y[j][i] + Y[j][i+1] + Y[j+1][i] + Y[j+1][i+1]));
+#undef PRINT_NC_2D
+}
+
 /**
  * @brief This function write the 2-D solution into HDF5 output '.h5' files.
+ * @param[in] ctx: Pointer to the run context.
  * @param[in] n_x: The number of x-spatial points in the output data.
  * @param[in] n_y: The number of y-spatial points in the output data.
  * @param[in] N:   The number of time steps in the output data.
@@ -159,88 +475,117 @@ void file_1D_write_HDF5(const int m, const int N, const struct cell_var_stru CV,
  * @param[in] problem:   Name of the numerical results for the test problem.
  * @param[in] time_plot: Array of the plotting time recording.
  */
-void file_2D_write_HDF5(const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
+void file_2D_write_HDF5(const struct run_ctx * ctx, const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
 			double ** X, double ** Y, const double * cpu_time, const char * problem, double time_plot[])
 {
-    char add_out[FILENAME_MAX+40];
-    // Get the address of the output data folder of the test example.
-    example_io(problem, add_out, 0);
-    
-    char file_data[FILENAME_MAX+40];
-    strcpy(file_data, add_out);
-    strcat(file_data, "FLU_VAR.h5");
-
-    double ** XX, ** YY;
-    XX = (double **)malloc(n_x * sizeof(double *));
-    YY = (double **)malloc(n_x * sizeof(double *));
-    if(XX == NULL || YY == NULL)
+    double * buf = (double *)malloc((size_t)n_x * n_y * sizeof(double));
+    if(buf == NULL)
 	{
-	    printf("NOT enough memory! plot X or Y\n");
+	    printf("NOT enough memory! plot HDF5\n");
 	    exit(5);
 	}
-    for(int j = 0; j < n_x; ++j)
-	{
-	    XX[j] = (double *)malloc(n_y * sizeof(double));
-	    YY[j] = (double *)malloc(n_y * sizeof(double));
-	    if(XX[j] == NULL || YY[j] == NULL)
-		{
-		    printf("NOT enough memory! plot X[%d] or Y[%d]\n", j, j);
-		    exit(5);
-		}
-	}
 
-    hid_t file_id, group_id, attr_id, dataspace_id, dataspaceA_id, dataset_id;
-    herr_t status;
-    const unsigned rank = 2;
-    const hsize_t dims[2] = {(hsize_t)n_y, (hsize_t)n_x}, dimsA[1] = {1};
+    hid_t file_id = hdf5_open(ctx, problem, 0);
+    for(int k = 0; k < N; k++)
+	hdf5_snapshot_2D(ctx, file_id, n_x, n_y, k, CV[k], X, Y, buf);
+    hdf5_attr(file_id, "time_plot", N, time_plot);
+    hdf5_attr(file_id, "cpu_time",  N, cpu_time);
+    H5Fclose(file_id);
 
-    file_id = H5Fcreate(file_data, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-    dataspace_id  = H5Screate_simple(rank, dims,  NULL);
-    dataspaceA_id = H5Screate_simple(rank, dimsA, NULL);
+    free(buf);
+    buf = NULL;
+}
 
-    char group_name[14];
-    for(int k = 0; k < N; k++)
+/**
+ * @brief This function appends one 2-D snapshot into HDF5 output '.h5' files (streaming output).
+ * @details The file is created when k = 0, and it is closed after each snapshot,
+ *          so the snapshots written may be read while the run goes on.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in] n_x: The number of x-spatial points in the output data.
+ * @param[in] n_y: The number of y-spatial points in the output data.
+ * @param[in] k:   Index of the snapshot in the output data.
+ * @param[in] CV:  Structure of variable data of the snapshot.
+ * @param[in] X:   Array of the x-coordinate data.
+ * @param[in] Y:   Array of the y-coordinate data.
+ * @param[in] cpu_time: Array of the CPU time recording (not NULL: the last snapshot).
+ * @param[in] problem:  Name of the numerical results for the test problem.
+ * @param[in] time:     The plotting time of the snapshot.
+ */
+void file_2D_write_HDF5_stream(const struct run_ctx * ctx, const int n_x, const int n_y, const int k, const struct cell_var_stru * CV,
+			       double ** X, double ** Y, const double * cpu_time, const char * problem, double time)
+{
+    double * buf = (double *)malloc((size_t)n_x * n_y * sizeof(double));
+    if(buf == NULL)
 	{
-	    sprintf(group_name, "/T%d", k);
-	    group_id = H5Gcreate(file_id, group_name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-
-	    attr_id = H5Acreate(group_id, "time_plot", H5T_NATIVE_FLOAT, dataspaceA_id, H5P_DEFAULT, H5P_DEFAULT);
-	    status  = H5Awrite(attr_id, H5T_NATIVE_DOUBLE, time_plot+k);
-	    status  = H5Aclose(attr_id);
+	    printf("NOT enough memory! plot HDF5\n");
+	    exit(5);
+	}
 
-	    PRINT_NC(RHO, CV[k].RHO);
-	    PRINT_NC(U,   CV[k].U);
-	    PRINT_NC(V,   CV[k].V);
-	    PRINT_NC(P,   CV[k].P);
-	    PRINT_NC(E,   CV[k].E);
-	    for(int i = 0; i < n_y; ++i)
-		for(int j = 0; j < n_x; ++j)
-		    {			    
-			XX[j][i] = 0.25*(X[j][i] + X[j][i+1] + X[j+1][i] + X[j+1][i+1]);
-			YY[j][i] = 0.25*(Y[j][i] + Y[j][i+1] + Y[j+1][i] + Y[j+1][i+1]);
-		    }
-	    PRINT_NC(X, XX);
-	    PRINT_NC(Y, YY);
+    hid_t file_id = hdf5_open(ctx, problem, k);
+    hdf5_snapshot_2D(ctx, file_id, n_x, n_y, k, *CV, X, Y, buf);
+    hdf5_time_append(file_id, k, time);
+    if(cpu_time)
+	hdf5_attr(file_id, "cpu_time", 1, cpu_time);
+    H5Fclose(file_id);
 
-	    status = H5Gclose(group_id);
-	}
+    free(buf);
+    buf = NULL;
+}
 
-    status = H5Sclose(dataspaceA_id);
-    status = H5Sclose(dataspace_id);
-    status = H5Fclose(file_id);
+/**
+ * @brief This function writes the HDF5 output '.h5' file of the whole 2-D grids, which are decomposed into blocks.
+ * @details The solution of the b-th block is written into 'rank_b/FLU_VAR.h5' in the output folder by its own process.
+ *          Each fluid variable of the whole grids is a virtual dataset '/v' of (N*n_y*n_x) values,
+ *          which maps the datasets '/v' of the blocks, so no data is copied.
+ * @param[in] ctx:   Pointer to the run context.
+ * @param[in] n_x:   The number of x-spatial points of the whole grids.
+ * @param[in] n_y:   The number of y-spatial points of the whole grids.
+ * @param[in] N:     The number of time steps in the output data.
+ * @param[in] num_b: The number of the blocks.
+ * @param[in] blk:   Array of the first x/y-grids and the number of the x/y-grids of the blocks {j0, i0, m, n, …}.
+ * @param[in] cpu_time:  Array of the CPU time recording (NULL: no record of the snapshots, e.g. for streaming output).
+ * @param[in] problem:   Name of the numerical results for the test problem.
+ * @param[in] time_plot: Array of the plotting time recording.
+ */
+void file_2D_write_HDF5_blocks(const struct run_ctx * ctx, const int n_x, const int n_y, const int N, const int num_b, const int * blk,
+			       const double * cpu_time, const char * problem, double time_plot[])
+{
+    const char * name[OUT_FIELD_N+2];
+    const int n_v = hdf5_names(ctx, 2, name);
+    const hsize_t dims[3] = {(hsize_t)N, (hsize_t)n_y, (hsize_t)n_x};
+    hsize_t start[3] = {0, 0, 0}, count[3] = {(hsize_t)N, 0, 0};
+    char file_b[40];
+    hid_t file_id = hdf5_open(ctx, problem, 0), dataspace_id, src_space_id, dcpl_id, dataset_id;
+    int v, b;
 
-    for(int j = 0; j < n_x; ++j)
+    dataspace_id = H5Screate_simple(3, dims, NULL);
+    for(v = 0; v < n_v; ++v)
 	{
-	    free(XX[j]);
-	    free(YY[j]);
-	    XX[j] = NULL;
-	    YY[j] = NULL;
+	    dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+	    for(b = 0; b < num_b; ++b)
+		{
+		    start[1] = (hsize_t)blk[4*b+1];
+		    start[2] = (hsize_t)blk[4*b];
+		    count[1] = (hsize_t)blk[4*b+3];
+		    count[2] = (hsize_t)blk[4*b+2];
+		    H5Sselect_hyperslab(dataspace_id, H5S_SELECT_SET, start, NULL, count, NULL);
+		    src_space_id = H5Screate_simple(3, count, NULL);
+		    sprintf(file_b, "rank_%d/FLU_VAR.h5", b);
+		    H5Pset_virtual(dcpl_id, dataspace_id, file_b, name[v], src_space_id);
+		    H5Sclose(src_space_id);
+		}
+	    H5Sselect_all(dataspace_id);
+	    dataset_id = H5Dcreate(file_id, name[v], H5T_NATIVE_FLOAT, dataspace_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+	    if(dataset_id < 0)
+		printf("Write error occurrs in the virtual dataset '%s' of FLU_VAR.h5!\n", name[v]);
+	    else
+		H5Dclose(dataset_id);
+	    H5Pclose(dcpl_id);
 	}
-    free(XX);
-    free(YY);
-    XX = NULL;
-    YY = NULL;
-    if(status)
-	return;
+    H5Sclose(dataspace_id);
+    hdf5_attr(file_id, "time_plot", N, time_plot);
+    if(cpu_time)
+	hdf5_attr(file_id, "cpu_time",  N, cpu_time);
+    H5Fclose(file_id);
 }
 #endif
@@ -0,0 +1,89 @@
+/**
+ * @file  file_perf_out.c
+ * @brief This is a function which writes the performance report of a run.
+ * @details The report 'perf.json' of the output folder is a JSON object, so that the performance of the runs can be
+ *          collected by the dashboards. It replaces the CPU times of the plotting times, which were the only
+ *          performance record in 'log.dat'.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "../include/var_struc.h"
+#include "../include/file_io.h"
+#include "../include/tools.h"
+
+
+/**
+ * @brief This function prints a real number of JSON (null if not finite).
+ */
+static void perf_number(FILE * fp, const char * key, const double x, const char * sep)
+{
+    if (isfinite(x))
+	fprintf(fp, "\"%s\": %.10g%s", key, x, sep);
+    else
+	fprintf(fp, "\"%s\": null%s", key, sep);
+}
+
+/**
+ * @brief This function writes the performance report of the run at its end.
+ * @details The time steps and tau are those reported by telemetry_step(), the wall times of the phases are those
+ *          of the phase timers of the master thread, and the peak memory is the peak resident set size and the
+ *          peak of the accounted fields (mem_account()).
+ * @param[in] ctx:     Pointer to the run context.
+ * @param[in] problem: Name of the numerical results.
+ * @param[in] n_cell:  Number of the cells of the whole grids.
+ * @param[in] n_rank:  Number of the processes.
+ * @param[in] rs:      Statistics of the Newton iterations of the exact Riemann solvers (Riemann_exact_stat()).
+ */
+void perf_report_write(const struct run_ctx * ctx, const char * problem, const long n_cell, const int n_rank, const struct riemann_stat * rs)
+{
+    char add_out[FILENAME_MAX+40];
+    FILE * fp;
+    double tau[3], wall, t;
+    long count;
+    const char * name;
+    int ph, n_thread = 1;
+    const int n_step = telemetry_stat(tau, &wall);
+#ifdef _OPENMP
+    n_thread = omp_get_max_threads();
+#endif
+
+    example_io(ctx, problem, add_out, 0);
+    strcat(add_out, "perf.json");
+    if((fp = fopen(add_out, "w")) == NULL)
+	{
+	    printf("Cannot open performance report file!\n");
+	    return;
+	}
+    fprintf(fp, "{\n  \"problem\": \"%s\",\n  \"dim\": %d,\n  \"order\": %d,\n", problem, (int)ctx->conf[0], (int)ctx->conf[9]);
+    fprintf(fp, "  \"cells\": %ld,\n  \"threads\": %d,\n  \"ranks\": %d,\n  \"steps\": %d,\n  ", n_cell, n_thread, n_rank, n_step);
+    perf_number(fp, "wall_time", wall, ",\n  ");
+    perf_number(fp, "cell_updates_per_s", wall > 0.0 ? (double)n_cell * n_step / wall : NAN, ",\n");
+    fprintf(fp, "  \"tau\": {");
+    perf_number(fp, "min", n_step ? tau[0] : NAN, ", ");
+    perf_number(fp, "mean", n_step ? tau[1] : NAN, ", ");
+    perf_number(fp, "max", n_step ? tau[2] : NAN, "},\n");
+    warm_start_report(fp); // the grid-sequenced warm start of the run
+    snap_store_report(fp); // the snapshots kept compressed in memory
+    fprintf(fp, "  \"phases\": {");
+    for (ph = 0; ph <= PT_NUM; ph++)
+	if ((t = phase_timer_get(ph, &count, &name)) >= 0.0)
+	    {
+		fprintf(fp, "%s\n    \"%s\": {\"calls\": %ld, ", ph ? "," : "", name, count);
+		perf_number(fp, "wall_time", t, "}");
+	    }
+    fprintf(fp, "\n  },\n");
+    fprintf(fp, "  \"newton\": {\"solutions\": %ld, \"iterations\": %ld, ", rs->solve, rs->iter);
+    perf_number(fp, "iterations_per_solution", rs->solve ? (double)rs->iter / rs->solve : NAN, ", ");
+    fprintf(fp, "\"without_iteration\": %ld},\n", rs->exact);
+    if (rs->hyb[0] + rs->hyb[1])
+	fprintf(fp, "  \"hybrid_flux\": {\"smooth\": %ld, \"flagged\": %ld},\n", rs->hyb[0], rs->hyb[1]);
+    fprintf(fp, "  \"memory\": {\"peak_rss_kB\": %ld, \"peak_fields_kB\": %ld}\n}\n",
+	    peak_rss_kb(), (mem_account_peak(MA_NUM)+1023)/1024);
+    fclose(fp);
+}
@@ -27,10 +27,10 @@ void file_radial_write_TEC(const struct flu_var FV, const double * R, const char
     double const dtheta =      config[11];
 
     char file_data[FILENAME_MAX];
-    example_io(problem, file_data, 0);
+    example_io(&run_ctx_global, problem, file_data, 0);
 
     FILE * out;
-    int i, j;
+    int i, j, k;
     char str_tmp[40];
 
     //===================Write solution File=========================
@@ -50,6 +50,8 @@ void file_radial_write_TEC(const struct flu_var FV, const double * R, const char
     fprintf(out, ", \"gamma\"");
 #endif
 #endif
+    for(k = 0; FV.Y != NULL && k < (int)config[71]; k++)
+	fprintf(out, ", \"Y_%d\"", k+1);
     fprintf(out, "\n");
 
     fprintf(out, "ZONE I=%d, J=%d, F=POINT, SOLUTIONTIME=%.8g\n", Tcell+1, Ncell+1, time);
@@ -66,7 +68,102 @@ void file_radial_write_TEC(const struct flu_var FV, const double * R, const char
 		fprintf(out,"%.10g\t",FV.gamma[i]);
 #endif
 #endif
+		for(k = 0; FV.Y != NULL && k < (int)config[71]; k++)
+		    fprintf(out,"%.10g\t",FV.Y[(size_t)k*FV.n_Y + i]);
 		fprintf(out,"\n");
 	    }
     fclose(out);
 }
+
+
+/**
+ * @brief This function appends the in-situ diagnostics of the radially symmetric solution to the time series file 'diag.dat'.
+ * @details A line of the file holds the time step, the time and the following reductions:
+ *          - R_int:   radius of the first material interface (nan without an interface);
+ *          - RHO_max: peak density, and R_RHO_max its centroidal radius;
+ *          - E_k, E_i: total kinetic and internal energy per unit angle;
+ *          - R_shock: radius of the cell boundary with the steepest pressure gradient;
+ *          - RHO, U, P of the cells at the probe radii config[57-59] (INFINITY: no probe).
+ * @param[in,out] out:  Pointer to the time series file, which is opened at the first call (NULL: not opened).
+ * @param[in] FV:       Structure of fluid variable data array in computational grid.
+ * @param[in] E:        Array of the specific total energy.
+ * @param[in] mass:     Array of the mass of the cells.
+ * @param[in] rmv:      Structure of radially symmetric meshing variable data.
+ * @param[in] problem:  Name of the numerical results for the test problem.
+ * @param[in] k:        The time step.
+ * @param[in] time:     The time of the solution.
+ */
+void file_radial_write_diag(FILE ** out, const struct flu_var FV, const double * E, const double * mass,
+			    const struct radial_mesh_var * rmv, const char * problem, const int k, const double time)
+{
+    double const eps   =      config[4];
+    int    const Ncell = (int)config[3];  // Number of computing cells in r direction
+    const double * Rb  = rmv->Rb;
+    const double * RR  = rmv->RR;
+
+    double R_int = NAN, RHO_max = FV.RHO[0], R_RHO_max = RR[0], E_k = 0.0, E_i = 0.0, R_shock = NAN;
+    double dp, dp_max = 0.0, r;
+    int i, p, i_lo, i_hi;
+
+    for(i = 0; i <= Ncell; i++)
+	{
+	    E_k += mass[i]*0.5*FV.U[i]*FV.U[i];
+	    E_i += mass[i]*(E[i] - 0.5*FV.U[i]*FV.U[i]);
+	    if (FV.RHO[i] > RHO_max)
+		{
+		    RHO_max   = FV.RHO[i];
+		    R_RHO_max = RR[i];
+		}
+	    if (i == Ncell)
+		break;
+	    dp = fabs(FV.P[i+1] - FV.P[i])/(RR[i+1] - RR[i]);
+	    if (dp > dp_max)
+		{
+		    dp_max  = dp;
+		    R_shock = Rb[i+1];
+		}
+#ifdef MULTIFLUID_BASICS
+	    if (isnan(R_int) && i > 0 && fabs(FV.gamma[i+1] - FV.gamma[i]) > eps)
+		R_int = Rb[i+1];
+#endif
+	}
+
+    if (*out == NULL)
+	{
+	    char file_data[FILENAME_MAX];
+	    example_io(&run_ctx_global, problem, file_data, 0);
+	    strcat(file_data, "diag.dat");
+	    if ((*out = fopen(file_data, "w")) == NULL)
+		{
+		    fprintf(stderr, "Cannot open the diagnostics output file!\n");
+		    exit(1);
+		}
+	    fprintf(*out, "# step\ttime\tR_int\tRHO_max\tR_RHO_max\tE_k\tE_i\tR_shock");
+	    for(p = 57; p <= 59; p++)
+		if (isfinite(config[p]))
+		    fprintf(*out, "\tRHO(%g)\tU(%g)\tP(%g)", config[p], config[p], config[p]);
+	    fprintf(*out, "\n");
+	}
+
+    fprintf(*out, "%d\t%.10g\t%.10g\t%.10g\t%.10g\t%.10g\t%.10g\t%.10g", k, time, R_int, RHO_max, R_RHO_max, E_k, E_i, R_shock);
+    for(p = 57; p <= 59; p++)
+	{
+	    if (!isfinite(config[p]))
+		continue;
+	    // the cell i with Rb[i] <= r < Rb[i+1]
+	    r    = config[p];
+	    i_lo = 0;
+	    i_hi = Ncell;
+	    while (i_lo < i_hi)
+		{
+		    i = (i_lo + i_hi + 1) / 2;
+		    if (Rb[i] <= r)
+			i_lo = i;
+		    else
+			i_hi = i - 1;
+		}
+	    fprintf(*out, "\t%.10g\t%.10g\t%.10g", FV.RHO[i_lo], FV.U[i_lo], FV.P[i_lo]);
+	}
+    fprintf(*out, "\n");
+    fflush(*out);
+}
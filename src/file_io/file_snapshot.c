@@ -0,0 +1,545 @@
+/**
+ * @file  file_snapshot.c
+ * @brief This is a set of functions which keep the snapshots of the plotting times compressed in memory (snapshot store).
+ * @details With config[83] > 0, the streaming output (config[34]) hands each snapshot to the store instead of the files.
+ *          The snapshot is copied into a staging level and compressed on a background thread while the time loop goes on,
+ *          so that only the current level of fluid variables and the compressed levels are kept in memory.
+ *          The fields are compressed one by one:
+ *          - config[83] = 1, lossless: the bits of each value are XORed with those of its neighbour, and the bytes are
+ *            shuffled into byte planes, so that the equal signs, exponents and leading mantissas become runs of zeros;
+ *          - config[83] = 2, error-bounded lossy: the values are quantized by the absolute tolerance config[84], and
+ *            the residuals of the linear prediction from the two neighbours are written as zigzag variable-length integers.
+ *          Both are followed by the run-length encoding of the zero bytes. A field that cannot be quantized
+ *          (too large for the tolerance, or not finite) is kept lossless.
+ *          With the last snapshot, the levels are decompressed one at a time into the output files of the streaming
+ *          output ('.dat' and HDF5), which are the same as those of file_1D_write() or file_2D_write() (lossless).
+ */
+
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "../include/var_struc.h"
+#include "../include/file_io.h"
+#include "../include/tools.h"
+
+
+//! The maximum number of the fields of a snapshot.
+#define SNAP_FIELD_MAX 6
+//! The longest run of the run-length encoding.
+#define SNAP_RUN 128
+
+//! Codecs of the fields.
+enum snap_codec {SNAP_OFF, SNAP_LOSSLESS, SNAP_LOSSY};
+
+//! A compressed field.
+struct snap_field {
+	unsigned char * buf; //!< compressed bytes.
+	size_t len;          //!< number of the compressed bytes.
+	size_t n;            //!< number of the values.
+	size_t off;          //!< offset of the values in the snapshot.
+	int codec;           //!< codec of the field (enum snap_codec).
+};
+
+//! A compressed snapshot of a plotting time.
+struct snap_level {
+	double time;          //!< plotting time.
+	int n_field;          //!< number of the fields (0: No snapshot).
+	struct snap_field f[SNAP_FIELD_MAX];
+};
+
+//! The snapshot store.
+static struct {
+	int codec;                    //!< codec of the store (enum snap_codec).
+	double tol;                   //!< absolute error bound of the lossy codec.
+	_Bool drain;                  //!< whether the levels are being written into the files.
+	struct snap_level * level;    //!< the compressed levels.
+	int n_level, cap_level;       //!< number and capacity of the levels.
+	int k_job;                    //!< level compressed by the background thread (-1: none).
+	double * stage;               //!< staging copy of the fields of the snapshot compressed.
+	size_t n_job[SNAP_FIELD_MAX]; //!< numbers of the values of the staged fields.
+	size_t off_job[SNAP_FIELD_MAX]; //!< offsets of the staged fields in the snapshot.
+	int n_field_job;              //!< number of the staged fields.
+	size_t cap_stage;             //!< capacity of the staging copy.
+	unsigned char * tmp;          //!< shuffled or variable-length bytes of a field before the run-length encoding.
+	size_t cap_tmp;               //!< capacity of 'tmp'.
+	void * thread;                //!< handle of the background thread.
+	int err;                      //!< memory error of the background thread.
+	long raw, packed;             //!< bytes of the snapshots and of the compressed levels.
+	double err_max;               //!< maximum absolute error of the lossy codec.
+	double wall;                  //!< wall-clock time of the compression.
+} snap = {SNAP_OFF, 0.0, false, NULL, 0, 0, -1, NULL, {0}, {0}, 0, 0, NULL, 0, NULL, 0, 0, 0, 0.0, 0.0};
+
+
+/**
+ * @brief This function writes the run-length encoding of the zero bytes.
+ * @details Each run starts with a byte t: t < SNAP_RUN is followed by t+1 literal bytes,
+ *          and t >= SNAP_RUN stands for t-SNAP_RUN+1 zero bytes.
+ * @param[in]  in:  The bytes to be encoded.
+ * @param[in]  n:   Number of the bytes.
+ * @param[out] out: The encoded bytes (at most n + n/SNAP_RUN + 1 bytes).
+ * @return     Number of the encoded bytes.
+ */
+static size_t snap_rle_pack(const unsigned char * in, const size_t n, unsigned char * out)
+{
+    size_t i = 0, o = 0, r;
+    while (i < n)
+	{
+	    for (r = 0; i + r < n && r < SNAP_RUN && in[i+r] == 0; r++) ;
+	    if (r >= 2 || (r == 1 && i + 1 == n))
+		{
+		    out[o++] = (unsigned char)(SNAP_RUN + r - 1);
+		    i += r;
+		    continue;
+		}
+	    // literal bytes up to the next two zero bytes
+	    for (r = 1; i + r < n && r < SNAP_RUN && !(in[i+r] == 0 && (i + r + 1 == n || in[i+r+1] == 0)); r++) ;
+	    out[o++] = (unsigned char)(r - 1);
+	    memcpy(out + o, in + i, r);
+	    o += r;
+	    i += r;
+	}
+    return o;
+}
+
+/**
+ * @brief This function decodes the run-length encoding of snap_rle_pack().
+ * @param[in]  in:  The encoded bytes.
+ * @param[in]  len: Number of the encoded bytes.
+ * @param[out] out: The decoded bytes.
+ * @return     Number of the decoded bytes.
+ */
+static size_t snap_rle_unpack(const unsigned char * in, const size_t len, unsigned char * out)
+{
+    size_t i = 0, o = 0, r;
+    while (i < len)
+	{
+	    if (in[i] >= SNAP_RUN)
+		{
+		    r = in[i++] - SNAP_RUN + 1;
+		    memset(out + o, 0, r);
+		}
+	    else
+		{
+		    r = in[i++] + 1;
+		    memcpy(out + o, in + i, r);
+		    i += r;
+		}
+	    o += r;
+	}
+    return o;
+}
+
+//! Bits of a double value.
+static uint64_t snap_bits(const double x)
+{
+    uint64_t w;
+    memcpy(&w, &x, sizeof(w));
+    return w;
+}
+
+/**
+ * @brief This function compresses a field into a compressed field.
+ * @param[in]  x:   Values of the field.
+ * @param[in]  n:   Number of the values.
+ * @param[out] f:   The compressed field.
+ * @return     Whether there is a memory error.
+ */
+static int snap_field_pack(const double * x, const size_t n, struct snap_field * f)
+{
+    const double step = 2.0 * snap.tol, lim = 4.0e15; // quantized values within 2^52
+    unsigned char * t = snap.tmp;
+    size_t i, b, n_t = 0;
+    int codec = snap.codec;
+
+    if (codec == SNAP_LOSSY)
+	for (i = 0; i < n; i++)
+	    if (!(fabs(x[i]) < lim * step))
+		{
+		    codec = SNAP_LOSSLESS;
+		    break;
+		}
+    if (codec == SNAP_LOSSY)
+	{
+	    int64_t q, q1 = 0, q2 = 0, p;
+	    uint64_t z;
+	    for (i = 0; i < n; i++)
+		{
+		    q = (int64_t)llround(x[i] / step);
+		    p = i >= 2 ? 2*q1 - q2 : q1;
+		    z = ((uint64_t)(q - p) << 1) ^ (uint64_t)((q - p) < 0 ? -1 : 0);
+		    for ( ; z >= 0x80; z >>= 7)
+			t[n_t++] = (unsigned char)(z | 0x80);
+		    t[n_t++] = (unsigned char)z;
+		    snap.err_max = MAX(snap.err_max, fabs((double)q * step - x[i]));
+		    q2 = q1;
+		    q1 = q;
+		}
+	}
+    else
+	{
+	    uint64_t w, w0 = 0;
+	    for (i = 0; i < n; i++)
+		{
+		    w  = snap_bits(x[i]);
+		    for (b = 0; b < 8; b++)
+			t[b*n + i] = (unsigned char)((w ^ w0) >> (8*b));
+		    w0 = w;
+		}
+	    n_t = 8 * n;
+	}
+    f->buf = (unsigned char *)malloc(n_t + n_t / SNAP_RUN + 1);
+    if (f->buf == NULL)
+	return 1;
+    f->len   = snap_rle_pack(t, n_t, f->buf);
+    f->n     = n;
+    f->codec = codec;
+    if ((t = (unsigned char *)realloc(f->buf, MAX(f->len, (size_t)1))) != NULL)
+	f->buf = t; // the compressed bytes only
+    return 0;
+}
+
+/**
+ * @brief This function decompresses a compressed field.
+ * @param[in]  f: The compressed field.
+ * @param[out] x: Values of the field.
+ */
+static void snap_field_unpack(const struct snap_field * f, double * x)
+{
+    const double step = 2.0 * snap.tol;
+    const size_t n = f->n;
+    unsigned char * t = snap.tmp;
+    size_t i, b, n_t;
+
+    n_t = snap_rle_unpack(f->buf, f->len, t);
+    if (f->codec == SNAP_LOSSY)
+	{
+	    int64_t q, q1 = 0, q2 = 0;
+	    uint64_t z;
+	    int s;
+	    for (i = 0, b = 0; i < n && b < n_t; i++)
+		{
+		    for (z = 0, s = 0; t[b] & 0x80; s += 7)
+			z |= (uint64_t)(t[b++] & 0x7f) << s;
+		    z |= (uint64_t)t[b++] << s;
+		    q  = (i >= 2 ? 2*q1 - q2 : q1) + ((int64_t)(z >> 1) ^ -(int64_t)(z & 1));
+		    x[i] = (double)q * step;
+		    q2 = q1;
+		    q1 = q;
+		}
+	}
+    else
+	{
+	    uint64_t w = 0, d;
+	    for (i = 0; i < n; i++)
+		{
+		    for (d = 0, b = 0; b < 8; b++)
+			d |= (uint64_t)t[b*n + i] << (8*b);
+		    w ^= d;
+		    memcpy(x + i, &w, sizeof(w));
+		}
+	}
+}
+
+/**
+ * @brief This function compresses the staged fields into the level k_job.
+ * @details It runs on the background thread.
+ * @param[in,out] arg: Not used.
+ */
+#ifdef _WIN32
+static unsigned __stdcall snap_thread(void * arg)
+#else
+static void * snap_thread(void * arg)
+#endif
+{
+    struct snap_level * L = snap.level + snap.k_job;
+    const double t0 = wall_time();
+    int v;
+    (void)arg;
+    for (v = 0; v < snap.n_field_job; v++)
+	{
+	    if (snap_field_pack(snap.stage + snap.off_job[v], snap.n_job[v], L->f + v))
+		{
+		    snap.err = 1;
+		    break;
+		}
+	    L->f[v].off = snap.off_job[v];
+	    snap.packed += (long)L->f[v].len;
+	}
+    L->n_field = v;
+    snap.wall += wall_time() - t0;
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @brief This function waits for the background thread compressing the last staged snapshot.
+ */
+static void snap_wait(void)
+{
+    if (snap.thread != NULL)
+	{
+#ifdef _WIN32
+	    WaitForSingleObject((HANDLE)snap.thread, INFINITE);
+	    CloseHandle((HANDLE)snap.thread);
+#else
+	    pthread_join(*(pthread_t *)snap.thread, NULL);
+	    free(snap.thread);
+#endif
+	    snap.thread = NULL;
+	}
+    if (snap.err)
+	{
+	    printf("NOT enough memory! Snapshot store\n");
+	    exit(5);
+	}
+}
+
+/**
+ * @brief This function frees the compressed fields of a level.
+ * @param[in,out] L: The level.
+ */
+static void snap_level_free(struct snap_level * L)
+{
+    int v;
+    for (v = 0; v < L->n_field; v++)
+	{
+	    free(L->f[v].buf);
+	    snap.packed -= (long)L->f[v].len;
+	}
+    L->n_field = 0;
+}
+
+/**
+ * @brief This function stages the fields of the snapshot of level k, and compresses them on the background thread.
+ * @details Each field keeps its offset in the snapshot, so that a field which is not kept (n = 0)
+ *          does not move the others.
+ * @param[in] k:       Index of the snapshot in the output data.
+ * @param[in] time:    The plotting time of the snapshot.
+ * @param[in] n_field: Number of the fields.
+ * @param[in] n:       Numbers of the values of the fields.
+ * @param[in] off:     Offsets of the fields in the snapshot.
+ * @return    The staging copy of the snapshot, whose fields are filled at their offsets
+ *            and compressed once snap_start() is called.
+ */
+static double * snap_stage(const int k, const double time, const int n_field, const size_t n[], const size_t off[])
+{
+    size_t n_all = 0, n_end = 0;
+    int v;
+
+    snap_wait();
+    if (snap.n_level == 0 && snap.level == NULL)
+	{
+	    if (snap.codec == SNAP_LOSSY)
+		printf("@@ Snapshot store: the snapshots are kept in memory with the error bound %g.\n", snap.tol);
+	    else
+		printf("@@ Snapshot store: the snapshots are kept lossless in memory.\n");
+	}
+    if (k >= snap.cap_level)
+	{
+	    const int cap = MAX(2 * snap.cap_level, k + 16);
+	    struct snap_level * L = (struct snap_level *)realloc(snap.level, cap * sizeof(struct snap_level));
+	    if (L == NULL)
+		{
+		    printf("NOT enough memory! Snapshot store\n");
+		    exit(5);
+		}
+	    memset(L + snap.cap_level, 0, (cap - snap.cap_level) * sizeof(struct snap_level));
+	    snap.level = L;
+	    snap.cap_level = cap;
+	}
+    snap_level_free(snap.level + k);
+    snap.n_level = MAX(snap.n_level, k + 1);
+    snap.level[k].time = time;
+    for (v = 0; v < n_field; v++)
+	{
+	    n_all += n[v];
+	    n_end  = MAX(n_end, off[v] + n[v]);
+	}
+    if (n_end > snap.cap_stage)
+	{
+	    free(snap.stage);
+	    free(snap.tmp);
+	    snap.cap_tmp = 10 * n_end;  // the longest variable-length integers
+	    snap.stage   = (double *)malloc(n_end * sizeof(double));
+	    snap.tmp     = (unsigned char *)malloc(snap.cap_tmp);
+	    if (snap.stage == NULL || snap.tmp == NULL)
+		{
+		    printf("NOT enough memory! Snapshot store\n");
+		    exit(5);
+		}
+	    snap.cap_stage = n_end;
+	}
+    memcpy(snap.n_job, n, n_field * sizeof(size_t));
+    memcpy(snap.off_job, off, n_field * sizeof(size_t));
+    snap.n_field_job = n_field;
+    snap.k_job = k;
+    snap.raw += (long)(n_all * sizeof(double));
+    return snap.stage;
+}
+
+/**
+ * @brief This function starts the background thread compressing the staged snapshot.
+ */
+static void snap_start(void)
+{
+#ifdef _WIN32
+    snap.thread = (void *)_beginthreadex(NULL, 0, snap_thread, NULL, 0, NULL);
+    if (snap.thread == NULL)
+	snap_thread(NULL);
+#else
+    snap.thread = malloc(sizeof(pthread_t));
+    if (snap.thread == NULL || pthread_create((pthread_t *)snap.thread, NULL, snap_thread, NULL) != 0)
+	{
+	    free(snap.thread);
+	    snap.thread = NULL;
+	    snap_thread(NULL); // Compress it synchronously.
+	}
+#endif
+}
+
+/**
+ * @brief This function sets the codec of the snapshot store from the run context.
+ * @param[in] ctx: Pointer to the run context.
+ * @return    Whether the snapshot is kept in the store.
+ */
+static _Bool snap_on(const struct run_ctx * ctx)
+{
+    if (snap.drain || !(_Bool)ctx->conf[34] || ctx->conf[83] <= 0.0)
+	return false;
+    snap.codec = (int)ctx->conf[83] == 2 ? SNAP_LOSSY : SNAP_LOSSLESS;
+    snap.tol   = ctx->conf[84];
+    if (snap.codec == SNAP_LOSSY && !(snap.tol > 0.0))
+	{
+	    printf("The error bound of the lossy snapshot store (84) should be positive!\n");
+	    exit(2);
+	}
+    return true;
+}
+
+/**
+ * @brief This function keeps a 1-D snapshot in the snapshot store.
+ * @param[in] ctx:  Pointer to the run context.
+ * @param[in] m:    The number of spatial points in the output data.
+ * @param[in] k:    Index of the snapshot in the output data.
+ * @param[in] CV:   Structure of grid variable data in computational grid cells.
+ * @param[in] nt:   Index of the level of 'CV' storing the snapshot.
+ * @param[in] X:    Array of the coordinate data of the snapshot (NULL: Eulerian grid).
+ * @param[in] time: The plotting time of the snapshot.
+ * @return    Whether the snapshot is kept in the store (false: It is written into the files).
+ */
+_Bool snap_store_put_1D(const struct run_ctx * ctx, const int m, const int k, const struct cell_var_stru CV, const int nt,
+			const double * X, const double time)
+{
+    if (!snap_on(ctx))
+	return false;
+    // RHO, U, P, E and X at the offsets f*m, E is not kept if it is not written (config[94]).
+    const size_t m_E = out_field_on(ctx, OUT_E) ? (size_t)m : 0;
+#ifdef RADIAL_BASICS
+    const size_t n[5] = {(size_t)m, (size_t)m, (size_t)m, m_E, (size_t)m};
+#else
+    const size_t n[5] = {(size_t)m, (size_t)m, (size_t)m, m_E, (size_t)m+1};
+#endif
+    const size_t off[5] = {0, (size_t)m, 2*(size_t)m, 3*(size_t)m, 4*(size_t)m};
+    double * const v[5] = {CV.RHO[nt], CV.U[nt], CV.P[nt], CV.E[nt], (double *)X};
+    double * s = snap_stage(k, time, X ? 5 : 4, n, off);
+    int f;
+    for (f = 0; f < 5; f++)
+	if (n[f] && v[f])
+	    memcpy(s + off[f], v[f], n[f] * sizeof(double));
+    snap_start();
+    return true;
+}
+
+/**
+ * @brief This function keeps a 2-D snapshot in the snapshot store.
+ * @param[in] ctx:  Pointer to the run context.
+ * @param[in] n_x:  The number of x-spatial points in the output data.
+ * @param[in] n_y:  The number of y-spatial points in the output data.
+ * @param[in] k:    Index of the snapshot in the output data.
+ * @param[in] CV:   Structure of variable data of the snapshot.
+ * @param[in] time: The plotting time of the snapshot.
+ * @return    Whether the snapshot is kept in the store (false: It is written into the files).
+ */
+_Bool snap_store_put_2D(const struct run_ctx * ctx, const int n_x, const int n_y, const int k, const struct cell_var_stru * CV,
+			const double time)
+{
+    if (!snap_on(ctx))
+	return false;
+    // RHO, U, V, P and E at the offsets f*c, E is not kept if it is not written (config[94]).
+    const size_t c = (size_t)n_x * n_y, n[5] = {c, c, c, c, out_field_on(ctx, OUT_E) ? c : 0};
+    const size_t off[5] = {0, c, 2*c, 3*c, 4*c};
+    double ** const v[5] = {CV->RHO, CV->U, CV->V, CV->P, CV->E};
+    double * s = snap_stage(k, time, 5, n, off);
+    int f, j;
+    for (f = 0; f < 5; f++)
+	for (j = 0; j < n_x && n[f]; j++)
+	    memcpy(s + off[f] + (size_t)j*n_y, v[f][j], n_y * sizeof(double));
+    snap_start();
+    return true;
+}
+
+/**
+ * @brief This function starts or ends writing the levels of the snapshot store into the output files.
+ * @details While the levels are written, the snapshots given to the streaming output are written into the files.
+ * @param[in] on: Whether the levels start to be written.
+ * @return    Number of the levels to be written (0: No level, or on = false).
+ */
+int snap_store_drain(const _Bool on)
+{
+    snap.drain = false;
+    if (!on)
+	return 0;
+    snap_wait();
+    if (snap.n_level == 0)
+	return 0;
+    printf("@@ Snapshot store: %d levels, %ld kB in %ld kB (%.1fx), compressed in %g s", snap.n_level, (snap.raw+1023)/1024,
+	   (snap.packed+1023)/1024, snap.packed > 0 ? (double)snap.raw / snap.packed : 0.0, snap.wall);
+    if (snap.codec == SNAP_LOSSY)
+	printf(", maximum error %g", snap.err_max);
+    printf(".\n");
+    snap.drain = true;
+    return snap.n_level;
+}
+
+/**
+ * @brief This function decompresses a level of the snapshot store.
+ * @param[in]  k:    Index of the snapshot in the output data.
+ * @param[out] x:    The values of the fields, each at its offset in the snapshot.
+ * @param[out] time: The plotting time of the snapshot.
+ * @return     Number of the fields of the snapshot.
+ */
+int snap_store_get(const int k, double * x, double * time)
+{
+    const struct snap_level * L = snap.level + k;
+    int v;
+    *time = L->time;
+    for (v = 0; v < L->n_field; v++)
+	snap_field_unpack(L->f + v, x + L->f[v].off);
+    return L->n_field;
+}
+
+/**
+ * @brief This function writes the member 'snapshot_store' of the performance report, if the snapshots are kept in the store.
+ * @param[in] fp: Pointer to the performance report file.
+ */
+void snap_store_report(FILE * fp)
+{
+    if (snap.n_level == 0)
+	return;
+    fprintf(fp, "  \"snapshot_store\": {\"codec\": \"%s\", \"levels\": %d, \"raw_bytes\": %ld, \"compressed_bytes\": %ld, ",
+	    snap.codec == SNAP_LOSSY ? "lossy" : "lossless", snap.n_level, snap.raw, snap.packed);
+    fprintf(fp, "\"max_error\": %.10g, \"wall_time\": %.10g},\n", snap.err_max, snap.wall);
+}
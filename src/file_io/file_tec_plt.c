@@ -0,0 +1,168 @@
+/**
+ * @file  file_tec_plt.c
+ * @brief This is a set of functions which write the native binary Tecplot files ('.plt', format #!TDV112).
+ * @details A file is a header section, which has the title, the variable names and the headers of the zones,
+ *          and a data section of the zones after the end-of-header marker. The data are written in double precision
+ *          and the native byte order. The variables and the connectivity of a zone may be shared with an earlier zone
+ *          of the file, and a 'GRID' file of the mesh may be loaded together with the 'SOLUTION' files of the time steps,
+ *          so that the mesh is written only once. The files are opened by Tecplot as the ASCII '.tec' files with the
+ *          same zones and variables.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../include/var_struc.h"
+#include "../include/file_io.h"
+
+#define TEC_ZONE_MARKER 299.0f //!< marker of the zones.
+#define TEC_EOH_MARKER  357.0f //!< marker of the end of the header section.
+
+
+static void tec_int(FILE * fp, const int32_t i)
+{
+    fwrite(&i, sizeof(i), 1, fp);
+}
+
+static void tec_float(FILE * fp, const float f)
+{
+    fwrite(&f, sizeof(f), 1, fp);
+}
+
+//! A string is written as the characters in INT32 and a null terminator.
+static void tec_string(FILE * fp, const char * s)
+{
+    while (*s)
+	tec_int(fp, (unsigned char)*s++);
+    tec_int(fp, 0);
+}
+
+/**
+ * @brief This function opens a binary Tecplot file and writes the title and the variable names.
+ * @param[in] file:      Name of the file.
+ * @param[in] file_type: Type of the file (TEC_FULL, TEC_GRID or TEC_SOLUTION).
+ * @param[in] title:     Title of the data set.
+ * @param[in] nv:        Number of the variables.
+ * @param[in] var:       Names of the variables.
+ * @return    Pointer to the file (NULL: it cannot be opened).
+ */
+FILE * tec_plt_open(const char * file, const int file_type, const char * title, const int nv, const char * const var[])
+{
+    FILE * fp;
+    int v;
+    if ((fp = fopen(file, "wb")) == NULL)
+	return NULL;
+    fwrite("#!TDV112", 1, 8, fp);
+    tec_int(fp, 1); // byte order
+    tec_int(fp, file_type);
+    tec_string(fp, title);
+    tec_int(fp, nv);
+    for (v = 0; v < nv; v++)
+	tec_string(fp, var[v]);
+    return fp;
+}
+
+/**
+ * @brief This function writes the header of a zone.
+ * @param[in] fp:        Pointer to the file.
+ * @param[in] name:      Name of the zone.
+ * @param[in] time:      Solution time of the zone.
+ * @param[in] zone_type: Type of the zone (TEC_ORDERED, TEC_FETRIANGLE or TEC_FEQUADRILATERAL).
+ * @param[in] n_1:       IMax of an ordered zone or the number of the nodes of a finite-element zone.
+ * @param[in] n_2:       JMax of an ordered zone or the number of the elements of a finite-element zone.
+ * @param[in] nv:        Number of the variables of the file.
+ * @param[in] loc:       Locations of the variables (0: nodes, 1: cell-centered; NULL: all at the nodes).
+ */
+void tec_plt_zone(FILE * fp, const char * name, const double time, const int zone_type,
+		  const int n_1, const int n_2, const int nv, const int loc[])
+{
+    int v;
+    tec_float(fp, TEC_ZONE_MARKER);
+    tec_string(fp, name);
+    tec_int(fp, -1); // parent zone
+    tec_int(fp, -2); // strand ID assigned by Tecplot as the '.tec' zones of the solution times
+    fwrite(&time, sizeof(time), 1, fp);
+    tec_int(fp, -1); // zone color
+    tec_int(fp, zone_type);
+    tec_int(fp, loc != NULL);
+    for (v = 0; loc != NULL && v < nv; v++)
+	tec_int(fp, loc[v]);
+    tec_int(fp, 0); // no face neighbors
+    tec_int(fp, 0); // no user-defined face neighbor connections
+    if (zone_type == TEC_ORDERED)
+	{
+	    tec_int(fp, n_1);
+	    tec_int(fp, n_2);
+	    tec_int(fp, 1);
+	}
+    else
+	{
+	    tec_int(fp, n_1);
+	    tec_int(fp, n_2);
+	    tec_int(fp, 0);
+	    tec_int(fp, 0);
+	    tec_int(fp, 0);
+	}
+    tec_int(fp, 0); // no auxiliary data
+}
+
+/**
+ * @brief This function ends the header section.
+ */
+void tec_plt_eoh(FILE * fp)
+{
+    tec_float(fp, TEC_EOH_MARKER);
+}
+
+/**
+ * @brief This function writes the data of a zone in the order of the zone headers.
+ * @param[in] fp:    Pointer to the file.
+ * @param[in] nv:    Number of the variables of the file.
+ * @param[in] v:     Arrays of the values of the variables (NULL: shared with the zone 'share').
+ * @param[in] n:     Numbers of the values of the variables.
+ * @param[in] share: Zero-based number of the zone whose variables (v[i] = NULL) are shared.
+ * @param[in] con_share: Zero-based number of the zone whose connectivity is shared (-1: No sharing).
+ * @param[in] con:   Zero-based nodes of the elements of a finite-element zone (NULL: no connectivity).
+ * @param[in] n_con: Number of the nodes in the connectivity.
+ */
+void tec_plt_data(FILE * fp, const int nv, const double * const v[], const long n[], const int share,
+		  const int con_share, const int * con, const long n_con)
+{
+    int i;
+    long k;
+    double m[2];
+    int32_t c;
+    _Bool shared = false;
+    tec_float(fp, TEC_ZONE_MARKER);
+    for (i = 0; i < nv; i++)
+	{
+	    tec_int(fp, 2); // double
+	    shared = shared || v[i] == NULL;
+	}
+    tec_int(fp, 0); // no passive variable
+    tec_int(fp, shared);
+    for (i = 0; shared && i < nv; i++)
+	tec_int(fp, v[i] == NULL ? share : -1);
+    tec_int(fp, con_share);
+    for (i = 0; i < nv; i++)
+	if (v[i] != NULL)
+	    {
+		m[0] = m[1] = n[i] > 0 ? v[i][0] : 0.0;
+		for (k = 1; k < n[i]; k++)
+		    {
+			m[0] = v[i][k] < m[0] ? v[i][k] : m[0];
+			m[1] = v[i][k] > m[1] ? v[i][k] : m[1];
+		    }
+		fwrite(m, sizeof(double), 2, fp);
+	    }
+    for (i = 0; i < nv; i++)
+	if (v[i] != NULL)
+	    fwrite(v[i], sizeof(double), n[i], fp);
+    for (k = 0; con != NULL && con_share < 0 && k < n_con; k++)
+	{
+	    c = con[k];
+	    fwrite(&c, sizeof(c), 1, fp);
+	}
+}
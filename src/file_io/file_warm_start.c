@@ -0,0 +1,518 @@
+/**
+ * @file  file_warm_start.c
+ * @brief This is a set of functions which start a run from the solution of a coarser run (grid-sequenced warm start).
+ * @details The row 'warm <numerical results> x=0 y=0' of 'config.txt' names the output folder of a coarse run of the 2-D
+ *          Eulerian hydrocode (relative to 'data_out/two-dim/', e.g. 'EUL_2_order/Sod_coarse'), whose coarse grid may be
+ *          translated by (x, y). The last snapshot of the coarse run is read from 'FLU_VAR.h5' (with HDF5PLOT defined)
+ *          or from the '.dat' files of RHO, U, V, P, X and Y with 'time_plot.dat'.
+ *          The conservative variables of the coarse cells are remapped onto the cells of the fine structured grids or
+ *          unstructured grids by the areas of their intersections, so that the mass, the momentum and the total energy
+ *          on the cells covered by the coarse grid are conserved. The fine run goes on from the last plotting time of
+ *          the coarse run, which is config[79]. A fine run may be the coarse run of the next level.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <stdbool.h>
+
+#include "../include/var_struc.h"
+#include "../include/file_io.h"
+#include "../include/tools.h"
+#ifdef HDF5PLOT
+#include "hdf5.h"
+#endif
+
+//! The maximum number of the vertices of a fine cell clipped by a coarse cell.
+#define WARM_MAX_PT 64
+
+//! The coarse solution of the warm start.
+struct warm_coarse {
+	int n_x, n_y;         //!< numbers of the coarse cells in x and y.
+	double x0, y0;        //!< lower left corner of the coarse grid.
+	double h_x, h_y;      //!< spatial grid lengths of the coarse grid.
+	double t0;            //!< time of the coarse solution.
+	double * Q[4];        //!< conservative variables (ρ, ρu, ρv, E) of the coarse cells [i*n_x + j].
+};
+
+//! Statistics of the warm start of the run for the performance report.
+static struct {
+	_Bool on;             //!< whether the run starts from a coarse solution.
+	char coarse[FILENAME_MAX+120];
+	long n_coarse;        //!< number of the coarse cells.
+	double t0;            //!< start time.
+	double coverage;      //!< ratio of the area of the fine cells covered by the coarse grid.
+	double wall;          //!< wall-clock time (s) of the reading and the remap.
+} warm_stat;
+
+
+/**
+ * @brief This function reads the last snapshot of a fluid variable of the '.dat' files of a coarse run.
+ * @param[in]  add:  Address of the output folder of the coarse run.
+ * @param[in]  name: Name of the fluid variable.
+ * @param[in]  N:    Number of the snapshots in the file.
+ * @param[out] n_x:  Number of the columns (coarse cells in x).
+ * @param[out] n_y:  Number of the lines of a snapshot (coarse cells in y).
+ * @return  The data array of the last snapshot (NULL: Error).
+ */
+static double * warm_dat_read(const char * add, const char * name, const int N, int * n_x, int * n_y)
+{
+    char file[FILENAME_MAX+140];
+    FILE * fp;
+    int num, ch, flg = 0;
+    double * v, * last;
+
+    sprintf(file, "%s%s.dat", add, name);
+    if((fp = fopen(file, "r")) == NULL)
+	{
+	    printf("Cannot open the coarse solution file '%s'!\n", file);
+	    return NULL;
+	}
+    // The numbers of the first line are the columns.
+    for(*n_x = 0; (ch = getc(fp)) != EOF && ch != '\n'; )
+	if(isspace(ch))
+	    flg = 0;
+	else if(!flg)
+	    {
+		flg = 1;
+		(*n_x)++;
+	    }
+    rewind(fp);
+    num = flu_var_count(fp, file);
+    if(*n_x < 1 || N < 1 || num % (N * *n_x))
+	{
+	    printf("The coarse solution file '%s' is not of %d snapshots!\n", file, N);
+	    fclose(fp);
+	    return NULL;
+	}
+    *n_y = num / (N * *n_x);
+    if((v = (double *)malloc(num * sizeof(double))) == NULL)
+	{
+	    printf("NOT enough memory! %s\n", name);
+	    fclose(fp);
+	    exit(5);
+	}
+    if(flu_var_read(fp, v, num))
+	{
+	    fclose(fp);
+	    free(v);
+	    return NULL;
+	}
+    fclose(fp);
+    last = (double *)malloc((size_t)*n_x * *n_y * sizeof(double));
+    if(last == NULL)
+	{
+	    printf("NOT enough memory! %s\n", name);
+	    exit(5);
+	}
+    memcpy(last, v + num - *n_x * *n_y, (size_t)*n_x * *n_y * sizeof(double));
+    free(v);
+    return last;
+}
+
+#ifdef HDF5PLOT
+/**
+ * @brief This function reads the last snapshot of a fluid variable of 'FLU_VAR.h5' of a coarse run.
+ * @param[in]  file_id: Identifier of the HDF5 file.
+ * @param[in]  name:    Name of the dataset of the fluid variable.
+ * @param[out] n_x:     Number of the coarse cells in x.
+ * @param[out] n_y:     Number of the coarse cells in y.
+ * @return  The data array of the last snapshot (NULL: Error).
+ */
+static double * warm_hdf5_read(const hid_t file_id, const char * name, int * n_x, int * n_y)
+{
+    hid_t dataset_id, dataspace_id, memspace_id;
+    hsize_t dims[3], start[3] = {0, 0, 0}, count[3];
+    double * v = NULL;
+
+    if(H5Lexists(file_id, name, H5P_DEFAULT) <= 0)
+	{
+	    printf("There is no dataset '%s' of the coarse solution!\n", name);
+	    return NULL;
+	}
+    dataset_id   = H5Dopen(file_id, name, H5P_DEFAULT);
+    dataspace_id = H5Dget_space(dataset_id);
+    if(H5Sget_simple_extent_ndims(dataspace_id) != 3 || H5Sget_simple_extent_dims(dataspace_id, dims, NULL) < 0 || dims[0] < 1)
+	{
+	    printf("The dataset '%s' of the coarse solution is not of the 2-D snapshots!\n", name);
+	    goto return_id;
+	}
+    *n_y = (int)dims[1];
+    *n_x = (int)dims[2];
+    start[0] = dims[0] - 1; // the last snapshot
+    count[0] = 1;
+    count[1] = dims[1];
+    count[2] = dims[2];
+    if((v = (double *)malloc((size_t)*n_x * *n_y * sizeof(double))) == NULL)
+	{
+	    printf("NOT enough memory! %s\n", name);
+	    exit(5);
+	}
+    H5Sselect_hyperslab(dataspace_id, H5S_SELECT_SET, start, NULL, count, NULL);
+    memspace_id = H5Screate_simple(3, count, NULL);
+    if(H5Dread(dataset_id, H5T_NATIVE_DOUBLE, memspace_id, dataspace_id, H5P_DEFAULT, v) < 0)
+	{
+	    printf("Read error occurrs in the dataset '%s' of the coarse solution!\n", name);
+	    free(v);
+	    v = NULL;
+	}
+    H5Sclose(memspace_id);
+ return_id:
+    H5Sclose(dataspace_id);
+    H5Dclose(dataset_id);
+    return v;
+}
+#endif
+
+/**
+ * @brief This function reads the last snapshot of a coarse run and computes the conservative variables of the coarse cells.
+ * @param[in]  ctx: Pointer to the run context.
+ * @param[in]  add: Address of the output folder of the coarse run.
+ * @param[in]  x_s, y_s: Translation of the coarse grid.
+ * @param[out] wc:  The coarse solution.
+ * @return  Whether the coarse solution is read (0: Success, 1: File error, 2: Data error).
+ */
+static int warm_coarse_read(const struct run_ctx * ctx, const char * add, const double x_s, const double y_s, struct warm_coarse * wc)
+{
+    const char * const var[6] = {"RHO", "U", "V", "P", "X", "Y"};
+    double * v[6] = {NULL};
+    int n_x[6], n_y[6], N, i, r = 0;
+    char file[FILENAME_MAX+140];
+    FILE * fp;
+
+    memset(wc, 0, sizeof(struct warm_coarse));
+#ifdef HDF5PLOT
+    hid_t file_id = -1, attr_id, space_id;
+    sprintf(file, "%sFLU_VAR.h5", add);
+    if((fp = fopen(file, "rb")) != NULL)
+	{
+	    fclose(fp);
+	    file_id = H5Fopen(file, H5F_ACC_RDONLY, H5P_DEFAULT);
+	}
+    if(file_id >= 0)
+	{
+	    double * t;
+	    hssize_t n_t = 0;
+	    for(i = 0; i < 6; i++)
+		if((v[i] = warm_hdf5_read(file_id, var[i], n_x + i, n_y + i)) == NULL)
+		    r = 2;
+	    if(H5Aexists(file_id, "time_plot") > 0)
+		{
+		    attr_id  = H5Aopen(file_id, "time_plot", H5P_DEFAULT);
+		    space_id = H5Aget_space(attr_id);
+		    n_t = H5Sget_simple_extent_npoints(space_id);
+		    if(n_t > 0 && (t = (double *)malloc(n_t * sizeof(double))) != NULL)
+			{
+			    if(H5Aread(attr_id, H5T_NATIVE_DOUBLE, t) >= 0)
+				wc->t0 = t[n_t-1];
+			    else
+				n_t = 0;
+			    free(t);
+			}
+		    H5Sclose(space_id);
+		    H5Aclose(attr_id);
+		}
+	    H5Fclose(file_id);
+	    if(n_t <= 0)
+		{
+		    printf("There are no plotting times of the coarse solution!\n");
+		    r = 2;
+		}
+	    printf("The coarse solution is read from '%s'.\n", file);
+	}
+    else
+#endif
+    {
+	sprintf(file, "%stime_plot.dat", add);
+	if((fp = fopen(file, "r")) == NULL)
+	    {
+		printf("Cannot open the plotting times '%s' of the coarse solution!\n", file);
+		return 1;
+	    }
+	N = flu_var_count(fp, file);
+	double * t = (double *)malloc((N+1) * sizeof(double));
+	if(t == NULL)
+	    {
+		printf("NOT enough memory! time_plot\n");
+		exit(5);
+	    }
+	if(N < 1 || flu_var_read(fp, t, N))
+	    r = 2;
+	else
+	    wc->t0 = t[N-1];
+	free(t);
+	fclose(fp);
+	for(i = 0; !r && i < 6; i++)
+	    if((v[i] = warm_dat_read(add, var[i], N, n_x + i, n_y + i)) == NULL)
+		r = 2;
+	if(!r)
+	    printf("The coarse solution is read from '%s*.dat'.\n", add);
+    }
+    for(i = 1; !r && i < 6; i++)
+	if(n_x[i] != n_x[0] || n_y[i] != n_y[0])
+	    {
+		printf("The coarse solution files are of unequal sizes!\n");
+		r = 2;
+	    }
+    if(!r)
+	{
+	    const double gamma = ctx->conf[6];
+	    const int n = n_x[0] * n_y[0];
+	    wc->n_x = n_x[0];
+	    wc->n_y = n_y[0];
+	    // The grid lengths are given by the span of the centers (stored in single precision in HDF5),
+	    // a single cell in a direction is centered at a half grid length.
+	    wc->h_x = wc->n_x > 1 ? (v[4][wc->n_x-1] - v[4][0]) / (wc->n_x-1) : 2.0 * v[4][0];
+	    wc->h_y = wc->n_y > 1 ? (v[5][n-wc->n_x] - v[5][0]) / (wc->n_y-1) : 2.0 * v[5][0];
+	    wc->x0  = v[4][0] - 0.5 * wc->h_x + x_s;
+	    wc->y0  = v[5][0] - 0.5 * wc->h_y + y_s;
+	    if(!(wc->h_x > 0.0 && wc->h_y > 0.0))
+		{
+		    printf("The coarse grid is not a uniform one of the 2-D Eulerian hydrocode!\n");
+		    r = 2;
+		}
+	    for(i = 0; !r && i < 4; i++)
+		if((wc->Q[i] = (double *)malloc(n * sizeof(double))) == NULL)
+		    {
+			printf("NOT enough memory! coarse solution\n");
+			exit(5);
+		    }
+	    for(i = 0; !r && i < n; i++)
+		{
+		    wc->Q[0][i] = v[0][i];
+		    wc->Q[1][i] = v[0][i] * v[1][i];
+		    wc->Q[2][i] = v[0][i] * v[2][i];
+		    wc->Q[3][i] = v[3][i]/(gamma-1.0) + 0.5*v[0][i]*(v[1][i]*v[1][i] + v[2][i]*v[2][i]);
+		}
+	}
+    for(i = 0; i < 6; i++)
+	free(v[i]);
+    return r;
+}
+
+/**
+ * @brief This function clips a polygon by the half plane s*(x_d - c) >= 0 of the coordinate d (0: x, 1: y).
+ * @return  Number of the vertices of the clipped polygon.
+ */
+static int warm_clip(const int n, const double * px, const double * py, const int d, const double c, const double s,
+		     double * qx, double * qy)
+{
+    int k, m = 0;
+    double a, b, w;
+    for(k = 0; k < n; k++)
+	{
+	    const int l = (k + 1) % n;
+	    a = s * ((d ? py[k] : px[k]) - c);
+	    b = s * ((d ? py[l] : px[l]) - c);
+	    if(a >= 0.0)
+		{
+		    qx[m] = px[k];
+		    qy[m++] = py[k];
+		}
+	    if((a >= 0.0) != (b >= 0.0))
+		{
+		    w = a / (a - b);
+		    qx[m] = px[k] + w * (px[l] - px[k]);
+		    qy[m++] = py[k] + w * (py[l] - py[k]);
+		}
+	}
+    return m;
+}
+
+//! Area of a polygon.
+static double warm_area(const int n, const double * px, const double * py)
+{
+    double s = 0.0;
+    for(int k = 0; k < n; k++)
+	s += px[k] * py[(k+1)%n] - px[(k+1)%n] * py[k];
+    return 0.5 * fabs(s);
+}
+
+/**
+ * @brief This function gives the vertices of the k-th fine cell.
+ * @param[in] mv: Structure of meshing variable data (NULL: structured grids of the cells [i*n_x + j]).
+ * @return  Number of the vertices (0: too many vertices).
+ */
+static int warm_cell(const struct run_ctx * ctx, const struct mesh_var * mv, const int k, double * px, double * py)
+{
+    if(mv == NULL)
+	{
+	    const int n_x = (int)ctx->conf[13], j = k % n_x, i = k / n_x;
+	    const double h_x = ctx->conf[10], h_y = ctx->conf[11];
+	    px[0] = j * h_x;     py[0] = i * h_y;
+	    px[1] = (j+1) * h_x; py[1] = i * h_y;
+	    px[2] = (j+1) * h_x; py[2] = (i+1) * h_y;
+	    px[3] = j * h_x;     py[3] = (i+1) * h_y;
+	    return 4;
+	}
+    const int * cp = mv->cell_pt[k];
+    if(cp[0] > WARM_MAX_PT/2)
+	return 0;
+    for(int l = 0; l < cp[0]; l++)
+	{
+	    px[l] = mv->X[cp[l+1]];
+	    py[l] = mv->Y[cp[l+1]];
+	}
+    return cp[0];
+}
+
+/**
+ * @brief This function starts the run from the solution of a coarse run given by the 'warm' row of the configuration file.
+ * @details The fluid variables RHO, U, V and P of the fine cells are replaced by the remapped ones of the coarse run,
+ *          the other variables (the materials) keep the initial data. The fine cells out of the coarse grid keep
+ *          the initial data too. The plotting times before the time of the coarse solution 't0' are removed,
+ *          the initial data are plotted at 't0'.
+ * @param[in,out] ctx:       Pointer to the run context, config[79] is set as 't0'.
+ * @param[in]     name:      Name of the test example.
+ * @param[in,out] FV0:       Initial fluid variables of the config[3] cells (in the file order of the mesh).
+ * @param[in]     mv:        Structure of meshing variable data (NULL: structured grids of config[13] x config[14] cells).
+ * @param[in,out] N_plot:    Pointer to the number of the plotting times.
+ * @param[in,out] time_plot: Array of the plotting times.
+ * @return  Whether the run starts from a coarse solution (0: No 'warm' row).
+ */
+int warm_start(struct run_ctx * ctx, const char * name, struct flu_var * FV0, const struct mesh_var * mv, int * N_plot, double time_plot[])
+{
+    char add[FILENAME_MAX+120], one_line[FILENAME_MAX+80], key[16], * s;
+    double x_s = 0.0, y_s = 0.0, tmp, err = 0.0;
+    int n, k, line_num = 0;
+    struct warm_coarse wc;
+    FILE * fp;
+    _Bool found = false;
+
+    example_io(ctx, name, add, 1);
+    strcat(add, "config.txt");
+    if((fp = fopen(add, "r")) == NULL)
+	return 0;
+    while(!found && fgets(one_line, sizeof(one_line), fp) != NULL)
+	{
+	    line_num++;
+	    for(s = one_line; isspace((unsigned char)*s); s++) ;
+	    if(strncmp(s, "warm", 4) != 0 || !isspace((unsigned char)s[4]))
+		continue;
+	    strcpy(add, "../../data_out/two-dim/");
+	    n = (int)strlen(add);
+	    if(sscanf(s + 4, " %s%n", add + n, &k) != 1)
+		{
+		    fprintf(stderr, "Invalid 'warm' row in line %d of configuration file!\n", line_num);
+		    exit(2);
+		}
+	    for(s += 4 + k; sscanf(s, " %15[^= \t\n]=%lf%n", key, &tmp, &k) == 2; s += k)
+		if(strcmp(key, "x") == 0)
+		    x_s = tmp;
+		else if(strcmp(key, "y") == 0)
+		    y_s = tmp;
+		else
+		    {
+			fprintf(stderr, "Invalid 'warm' row in line %d of configuration file!\n", line_num);
+			exit(2);
+		    }
+	    strcat(add, "/");
+	    found = true;
+	}
+    fclose(fp);
+    if(!found)
+	return 0;
+
+    const double tic = wall_time();
+    const double eps = ctx->conf[4];
+    if((k = warm_coarse_read(ctx, add, x_s, y_s, &wc)))
+	exit(k);
+    if(!(wc.t0 < ctx->conf[1] - eps))
+	{
+	    fprintf(stderr, "The time of the coarse solution %g is not before the total time %g!\n", wc.t0, ctx->conf[1]);
+	    exit(2);
+	}
+
+    const int num_cell = (int)ctx->conf[3];
+    const double gamma = ctx->conf[6];
+    double A_all = 0.0, A_cov = 0.0;
+#pragma omp parallel for private(n) reduction(+:A_all, A_cov) reduction(max:err)
+    for(k = 0; k < num_cell; k++)
+	{
+	    double px[WARM_MAX_PT], py[WARM_MAX_PT], qx[WARM_MAX_PT], qy[WARM_MAX_PT], rx[WARM_MAX_PT], ry[WARM_MAX_PT];
+	    double Q[4] = {0.0}, A = 0.0, a, x_min = INFINITY, x_max = -INFINITY, y_min = INFINITY, y_max = -INFINITY;
+	    int v, jc, ic, m, j0, j1, i0, i1;
+	    if((n = warm_cell(ctx, mv, k, px, py)) == 0)
+		{
+		    err = 1.0;
+		    continue;
+		}
+	    for(v = 0; v < n; v++)
+		{
+		    x_min = fmin(x_min, px[v]); x_max = fmax(x_max, px[v]);
+		    y_min = fmin(y_min, py[v]); y_max = fmax(y_max, py[v]);
+		}
+	    j0 = MAX((int)floor((x_min - wc.x0) / wc.h_x), 0);
+	    j1 = MIN((int)floor((x_max - wc.x0) / wc.h_x), wc.n_x - 1);
+	    i0 = MAX((int)floor((y_min - wc.y0) / wc.h_y), 0);
+	    i1 = MIN((int)floor((y_max - wc.y0) / wc.h_y), wc.n_y - 1);
+	    for(ic = i0; ic <= i1; ic++)
+		for(jc = j0; jc <= j1; jc++)
+		    {
+			// the fine cell clipped by the coarse cell [ic*n_x + jc]
+			m = warm_clip(n, px, py, 0, wc.x0 + jc*wc.h_x,      1.0, qx, qy);
+			m = warm_clip(m, qx, qy, 0, wc.x0 + (jc+1)*wc.h_x, -1.0, rx, ry);
+			m = warm_clip(m, rx, ry, 1, wc.y0 + ic*wc.h_y,      1.0, qx, qy);
+			m = warm_clip(m, qx, qy, 1, wc.y0 + (ic+1)*wc.h_y, -1.0, rx, ry);
+			if(m < 3 || (a = warm_area(m, rx, ry)) <= 0.0)
+			    continue;
+			A += a;
+			for(v = 0; v < 4; v++)
+			    Q[v] += a * wc.Q[v][ic*wc.n_x + jc];
+		    }
+	    a = warm_area(n, px, py);
+	    A_all += a;
+	    A_cov += A;
+	    if(A <= eps * a) // out of the coarse grid
+		continue;
+	    FV0->RHO[k] = Q[0] / A;
+	    FV0->U[k]   = Q[1] / Q[0];
+	    FV0->V[k]   = Q[2] / Q[0];
+	    FV0->P[k]   = (gamma-1.0) * (Q[3]/A - 0.5*(Q[1]*Q[1] + Q[2]*Q[2])/(Q[0]*A));
+	    if(!(FV0->RHO[k] > 0.0 && FV0->P[k] > 0.0))
+		err = fmax(err, 2.0);
+	}
+    for(k = 0; k < 4; k++)
+	free(wc.Q[k]);
+    if(err > 0.0)
+	{
+	    if(err < 2.0)
+		fprintf(stderr, "A fine cell has more than %d vertices for the warm start!\n", WARM_MAX_PT/2);
+	    else
+		fprintf(stderr, "Nonpositive density or pressure of the warm start!\n");
+	    exit(2);
+	}
+
+    // The plotting times go on from the time of the coarse solution.
+    time_plot[0] = wc.t0;
+    for(n = k = 1; k < *N_plot - 1; k++)
+	if(time_plot[k] > wc.t0 + eps)
+	    time_plot[n++] = time_plot[k];
+    time_plot[n++] = time_plot[*N_plot - 1];
+    *N_plot = n;
+    ctx->conf[79] = wc.t0;
+
+    warm_stat.on       = true;
+    strcpy(warm_stat.coarse, add);
+    warm_stat.n_coarse = (long)wc.n_x * wc.n_y;
+    warm_stat.t0       = wc.t0;
+    warm_stat.coverage = A_all > 0.0 ? A_cov / A_all : 0.0;
+    warm_stat.wall     = wall_time() - tic;
+    printf("Warm start at t = %g from the %d x %d coarse cells, %.2f%% of the fine grids covered (%g s).\n",
+	   wc.t0, wc.n_x, wc.n_y, 100.0 * warm_stat.coverage, warm_stat.wall);
+    return 1;
+}
+
+/**
+ * @brief This function writes the member 'warm_start' of the performance report, if the run starts from a coarse solution.
+ * @param[in] fp: Pointer to the performance report file.
+ */
+void warm_start_report(FILE * fp)
+{
+    if(!warm_stat.on)
+	return;
+    fprintf(fp, "  \"warm_start\": {\"coarse\": \"%s\", \"coarse_cells\": %ld, \"start_time\": %.10g, \"coverage\": %.10g, \"wall_time\": %.10g},\n",
+	    warm_stat.coarse, warm_stat.n_coarse, warm_stat.t0, warm_stat.coverage, warm_stat.wall);
+}
@@ -3,6 +3,9 @@
  * @brief This is a set of common functions which control the input/output data.
  */
 
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L // posix_fadvise()
+#endif
 #include <errno.h>
 #include <stdio.h>
 #include <string.h>
@@ -10,6 +13,12 @@
 #include <stdbool.h>
 #include <math.h>
 #include <ctype.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef HDF5PLOT
+#include "hdf5.h"
+#endif
 
 #include "../include/var_struc.h"
 #include "../include/tools.h"
@@ -28,20 +37,27 @@
 #include <unistd.h>
 #define ACCESS(path,mode) access((path),(mode))
 #endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 
 /** @brief This function produces folder path for data input or output.
+ *  @param[in] ctx:        Pointer to the run context.
  *  @param[in]  example:   Name of the test example/numerical results.
  *  @param[out] add_mkdir: Folder path for data input or output.
  *  @param[in]  i_or_o:    Conversion parameters for data input/output.
  *    @arg 0:              data output.
  *    @arg 1(non-0 value): data input.
  */
-void example_io(const char *example, char *add_mkdir, const int i_or_o)
+void example_io(const struct run_ctx * ctx, const char *example, char *add_mkdir, const int i_or_o)
 {
-	const int dim   = (int)config[0];
-	const int el    = (int)config[8];
-	const int order = (int)config[9];
+	const int dim   = (int)ctx->conf[0];
+	const int el    = (int)ctx->conf[8];
+	const int order = (int)ctx->conf[9];
 
 	static int output_const = 0;
 	char str_tmp[11], str_order[11];
@@ -115,6 +131,48 @@ void example_io(const char *example, char *add_mkdir, const int i_or_o)
 }
 
 
+/** @brief This function opens the sinks of the progress of the time steps of a run by its configuration.
+ *  @details The telemetry records of the process of rank 0 are written to 'telemetry.jsonl' of the output folder.
+ *           With config[85] > 0, the timeline of the phases of each process is traced into 'trace.json'
+ *           ('trace_r.json' of rank r > 0) of the output folder.
+ *           With config[87] > 0, the current fields are published live into the shared memory
+ *           '/hydrocode_<problem>_r<rank>' (live_publish.c).
+ *  @param[in] ctx:     Pointer to the run context.
+ *  @param[in] problem: Name of the numerical results.
+ *  @param[in] rank:    Rank of the process.
+ */
+void telemetry_open_io(const struct run_ctx * ctx, const char * problem, const int rank)
+{
+	char add_out[FILENAME_MAX+40];
+	const double interval = ctx->conf[66];
+	if (interval > 0.0 && rank == 0)
+	    {
+		example_io(ctx, problem, add_out, 0);
+		strcat(add_out, "telemetry.jsonl");
+		telemetry_open(add_out, interval, (int)ctx->conf[67]);
+	    }
+	else
+		telemetry_open(NULL, interval, (int)ctx->conf[67]);
+	if (ctx->conf[85] > 0.0)
+	    {
+		example_io(ctx, problem, add_out, 0);
+		if (rank == 0)
+			strcat(add_out, "trace.json");
+		else
+			sprintf(add_out + strlen(add_out), "trace_%d.json", rank);
+		phase_trace_open(add_out, (int)ctx->conf[85], (long)ctx->conf[86], rank);
+	    }
+	if (ctx->conf[87] > 0.0)
+	    {
+		sprintf(add_out, "/hydrocode_%.*s_r%d", FILENAME_MAX, problem, rank);
+		for (char * c = add_out + 1; *c; c++)
+			if (*c == '/' || *c == '\\')
+				*c = '_';
+		live_publish_open(add_out, ctx->conf[87], (int)ctx->conf[88]);
+	    }
+}
+
+
 /**
  * @brief      This function counts how many numbers are there in the initial data file. 
  * @param[in]  fp:  The pointer to the input file.
@@ -153,63 +211,6 @@ int flu_var_count(FILE * fp, const char * add)
 }
 
 
-/**
- * @brief      This function counts the line and column number of the numbers are there in the initial data file. 
- * @param[in]  fp:  The pointer to the input file.
- * @param[in]  add: The address of the input file.
- * @param[out] n_x: The colume number of the numbers in the initial data file.
- * @return \b line: The line number of the numbers in the initial data file.
- */
-int flu_var_count_line(FILE * fp, const char * add, int * n_x)
-{
-  int line = 0, column = 0;
-  /* We read characters one by one from the data file.
-   * "flg" helps us to count.
-   * -# 1: when read a number-using character (0, 1, 2, ..., e, E, minus sign and dot).
-   * -# 0: when read a non-number-using character. 
-   */
-  int flag = 0;
-  int ch;
-
-  do { // Count the data line number.
-      ch = getc(fp);
-      if(ch == '\n' || ch == EOF)
-	  {
-	      if(flag)
-		  ++column;
-	      flag = 0;
-	      if(column)
-		  {
-		      if(!line)
-			  *n_x = column;
-		      else if(column != *n_x)
-			  {
-			      printf("Error in input data file '%s', line=%d, column=%d, n_x=%d\n", add, line, column, *n_x);
-			      return 0;
-			  }
-		      ++line;
-		      column = 0;
-		  }
-	  }      
-      else if(ch == 45 || ch == 46 || ch == 69 || ch == 101 || isdigit(ch))
-	  flag = 1;
-      else if (!isspace(ch))
-	  {
-	      printf("Input contains illigal character(ASCII=%d, flag=%d) in the file '%s', line=%d!\n", ch, flag, add, line);
-	      return 0;
-	  }
-      else if(flag)
-	  {
-	      ++column;
-	      flag = 0;
-	  }
-  } while(ch != EOF);
-
-  rewind(fp);
-  return line;
-}
-
-
 /**
  * @brief This function reads the initial data file to generate the initial data.
  * @param[in]  fp: The pointer to the input file.
@@ -261,6 +262,719 @@ int flu_var_read(FILE * fp, double * U, const int num)
 }
 
 
+/*
+ * The initial data file is mapped into memory (read into a buffer on Windows),
+ * and it is split into chunks which are counted and parsed in parallel.
+ */
+#define CHUNK_MIN (1<<16) //!< The least number of bytes of a chunk of the text file.
+#define NUM_LEN 100       //!< The maximum length of a number in the text file.
+
+//! Legal characters of a number: digits, minus sign, dot and exponent sign.
+#define NUM_CHAR(ch) (isdigit(ch) || (ch) == '-' || (ch) == '.' || (ch) == 'E' || (ch) == 'e')
+
+//! The state of a chunk of the text file being counted and parsed.
+struct text_chunk {
+    const char * b, * e; //!< Beginning and end of the chunk.
+    int num;    //!< The number of the numbers in the chunk.
+    int line;   //!< The number of the non-empty lines in the chunk.
+    int column; //!< The column number of the first line in the chunk.
+    int err;    //!< Error in the chunk (0: None, 1: Illegal character, 2: Unequal columns, 3: Not a float).
+    int err_ch, err_line, err_column; //!< Character, line and column of the error.
+    _Bool last; //!< Whether it is the last chunk of the file.
+};
+
+//! Exactly representable powers of 10.
+static const double pow10_exact[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/**
+ * @brief This function converts a number in the text file to a double-precision float.
+ * @details The number with no more than 19 significant digits, a mantissa not greater than 2^53
+ *          and a decimal exponent in [-22, 22] is converted by one exact multiplication or division,
+ *          which gives the same correctly rounded value as 'strtod()' (Clinger's fast path).
+ *          The others are converted by 'strtod()'.
+ * @param[in]  b: Beginning of the number.
+ * @param[in]  e: End of the number.
+ * @param[out] U: The value of the number.
+ * @return  It returns 0 if successfully converted, and 1 if it is not a double-precision float.
+ */
+static int str_to_double(const char * b, const char * e, double * U)
+{
+    const char * p = b;
+    _Bool neg = false, digit = false;
+    unsigned long long M = 0; // mantissa
+    int n_d = 0, exp10 = 0, ex = 0;
+    _Bool ex_neg = false;
+    char number[NUM_LEN], * endptr;
+
+    if(p < e && *p == '-')
+	{
+	    neg = true;
+	    ++p;
+	}
+    for(; p < e && isdigit((unsigned char)*p); ++p, digit = true)
+	if(M || *p != '0')
+	    {
+		if(++n_d > 19)
+		    goto slow;
+		M = 10*M + (*p - '0');
+	    }
+    if(p < e && *p == '.')
+	for(++p; p < e && isdigit((unsigned char)*p); ++p, digit = true)
+	    {
+		if(M || *p != '0')
+		    {
+			if(++n_d > 19)
+			    goto slow;
+			M = 10*M + (*p - '0');
+		    }
+		--exp10;
+	    }
+    if(!digit)
+	goto slow;
+    if(p < e && (*p == 'e' || *p == 'E'))
+	{
+	    if(++p < e && *p == '-')
+		{
+		    ex_neg = true;
+		    ++p;
+		}
+	    if(p == e)
+		goto slow;
+	    for(; p < e && isdigit((unsigned char)*p); ++p)
+		if((ex = 10*ex + (*p - '0')) > 9999)
+		    goto slow;
+	    exp10 += ex_neg ? -ex : ex;
+	}
+    if(p != e || M > (1ULL<<53) || exp10 > 22 || exp10 < -22)
+	goto slow;
+    *U = exp10 < 0 ? (double)M / pow10_exact[-exp10] : (double)M * pow10_exact[exp10];
+    if(neg)
+	*U = -*U;
+    return 0;
+
+ slow:
+    if(e - b >= NUM_LEN)
+	return 1;
+    memcpy(number, b, e - b);
+    number[e - b] = '\0';
+    errno = 0;
+    *U = strtod(number, &endptr);
+    return errno == ERANGE || *endptr != '\0';
+}
+
+/**
+ * @brief This function formats a double-precision float as 'printf("%.10g")' does.
+ * @details The number is scaled into [1e9, 1e10) by one multiplication or division by an exact power of ten,
+ *          which is correctly rounded, and the scaled number close to a tie is rounded by the exact sign from fma(),
+ *          so the 10 significant digits are the same as those of 'printf()'.
+ *          The numbers whose decimal exponent is out of [-13, 31] are formatted by 'snprintf()'.
+ * @param[out] s: String of at least 24 characters.
+ * @param[in]  x: The number.
+ * @return  It returns the length of the string.
+ */
+int double_to_str(char * s, const double x)
+{
+    double a = fabs(x), y;
+    unsigned long long n;
+    char d[10];
+    int e, i, l = 0, k;
+
+    if(!(a > 0.0) || !isfinite(a))
+	return snprintf(s, 24, "%.10g", x);
+    memcpy(&n, &a, sizeof(double));
+    e = (int)((n >> 52) & 0x7ff) - 1023;      // binary exponent
+    e = e >= 0 ? (e * 78913) >> 18 : -((-e * 78913 + 262143) >> 18); // floor(e*log10(2)), estimate of the decimal one
+    for(k = 0; k < 2; ++k)
+	{
+	    if(9 - e > 22 || 9 - e < -22)
+		return snprintf(s, 24, "%.10g", x);
+	    y = 9 - e < 0 ? a / pow10_exact[e - 9] : a * pow10_exact[9 - e];
+	    if(y < 1e9)
+		--e;
+	    else if(y >= 1e10)
+		++e;
+	    else
+		break;
+	}
+    if(k == 2)
+	return snprintf(s, 24, "%.10g", x);
+    n = (unsigned long long)y;
+    y -= (double)n + 0.5;
+    if(fabs(y) < 1e-5)
+	{
+	    // The sign of the exact difference to the tie n + 1/2 is given by one rounding of fma().
+	    y = 9 - e < 0 ? -fma((double)n + 0.5, pow10_exact[e - 9], -a) : fma(a, pow10_exact[9 - e], -((double)n + 0.5));
+	    if(y == 0.0)
+		y = (double)(n & 1); // round half to even
+	}
+    if(y > 0.0 && ++n == 10000000000ULL)
+	{
+	    n = 1000000000ULL;
+	    ++e;
+	}
+    for(i = 9; i >= 0; --i, n /= 10)
+	d[i] = (char)('0' + n % 10);
+    for(k = 9; k > 0 && d[k] == '0'; --k)
+	;  // the last significant digit
+    if(x < 0.0)
+	s[l++] = '-';
+    if(e < -4 || e >= 10)
+	{
+	    s[l++] = d[0];
+	    if(k > 0)
+		{
+		    s[l++] = '.';
+		    for(i = 1; i <= k; ++i)
+			s[l++] = d[i];
+		}
+	    s[l++] = 'e';
+	    s[l++] = e < 0 ? '-' : '+';
+	    e = abs(e);
+	    s[l++] = (char)('0' + e / 10);
+	    s[l++] = (char)('0' + e % 10);
+	}
+    else if(e >= 0)
+	{
+	    for(i = 0; i <= e; ++i)
+		s[l++] = d[i];
+	    if(k > e)
+		{
+		    s[l++] = '.';
+		    for(i = e + 1; i <= k; ++i)
+			s[l++] = d[i];
+		}
+	}
+    else
+	{
+	    s[l++] = '0';
+	    s[l++] = '.';
+	    for(i = -1; i > e; --i)
+		s[l++] = '0';
+	    for(i = 0; i <= k; ++i)
+		s[l++] = d[i];
+	}
+    s[l] = '\0';
+    return l;
+}
+
+/**
+ * @brief This function counts the numbers and the non-empty lines in a chunk of the text file.
+ * @param[in,out] c:    Pointer to the chunk.
+ * @param[in]  by_line: Whether all the lines must have the same column number.
+ */
+static void text_chunk_count(struct text_chunk * c, const _Bool by_line)
+{
+    const char * p;
+    int ch, column = 0;
+    _Bool flag = false; // Whether the last character is a number-using character.
+
+    for(p = c->b; p <= c->e; ++p)
+	{
+	    // A chunk ends after a line break or a space, except the last one.
+	    ch = p < c->e ? (unsigned char)*p : (c->last ? '\n' : ' ');
+	    if(ch == '\n')
+		{
+		    if(flag)
+			++column;
+		    flag = false;
+		    if(column)
+			{
+			    if(!c->line)
+				c->column = column;
+			    else if(by_line && column != c->column && !c->err)
+				{
+				    c->err = 2;
+				    c->err_line = c->line;
+				    c->err_column = column;
+				}
+			    c->num += column;
+			    ++c->line;
+			    column = 0;
+			}
+		}
+	    else if(NUM_CHAR(ch))
+		flag = true;
+	    else if(!isspace(ch))
+		{
+		    if(!c->err)
+			{
+			    c->err = 1;
+			    c->err_ch = ch;
+			    c->err_line = c->line;
+			}
+		    flag = false;
+		}
+	    else if(flag)
+		{
+		    ++column;
+		    flag = false;
+		}
+	}
+    c->num += column;
+}
+
+/**
+ * @brief This function parses the numbers in a chunk of the text file.
+ * @param[in,out] c: Pointer to the chunk.
+ * @param[out]    U: The pointer to the data array of the numbers in the chunk.
+ */
+static void text_chunk_parse(struct text_chunk * c, double * U)
+{
+    const char * p = c->b, * q;
+    int j = 0;
+    while(j < c->num)
+	{
+	    while(!NUM_CHAR((unsigned char)*p))
+		++p;
+	    for(q = p; q < c->e && NUM_CHAR((unsigned char)*q); ++q)
+		;
+	    if(str_to_double(p, q, U+j))
+		{
+		    c->err = 3;
+		    c->err_column = j; // The index of the entry in the chunk.
+		    return;
+		}
+	    ++j;
+	    p = q;
+	}
+}
+
+/**
+ * @brief This function counts out and reads in the numbers of an initial data text file.
+ * @param[in]  add:     The address of the input file.
+ * @param[out] U:       Pointer to the data array of the numbers, which is allocated in this function.
+ * @param[out] line:    The line number of the numbers in the file.
+ * @param[out] n_x:     The column number of the numbers in the file.
+ * @param[in]  by_line: Whether all the lines must have the same column number.
+ *                      If not, the numbers are counted as one line.
+ * @return  It returns 0 if successfully read the file, 1 if the file cannot be opened,
+ *          2 if the file is illegal, and 5 if there is not enough memory.
+ */
+static int flu_var_load_text(const char * add, double ** U, int * line, int * n_x, const _Bool by_line)
+{
+    char * buf;
+    size_t size, pos;
+    struct text_chunk * c;
+    int n_c, i, num = 0, l = 0, r = 0;
+#ifdef _WIN32
+    FILE * fp;
+    if((fp = fopen(add, "rb")) == NULL)
+	return 1;
+    fseek(fp, 0, SEEK_END);
+    size = (size_t)ftell(fp);
+    rewind(fp);
+    if((buf = (char *)malloc(size + 1)) == NULL)
+	{
+	    fclose(fp);
+	    printf("NOT enough memory! %s\n", add);
+	    return 5;
+	}
+    size = fread(buf, 1, size, fp);
+    fclose(fp);
+#else
+    struct stat st;
+    int fd;
+    if((fd = open(add, O_RDONLY)) == -1)
+	return 1;
+    if(fstat(fd, &st) == -1 || st.st_size == 0)
+	{
+	    close(fd);
+	    printf("Error in counting fluid variables in initial data file! %s\n", add);
+	    return 2;
+	}
+    size = (size_t)st.st_size;
+    buf = (char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(buf == MAP_FAILED)
+	{
+	    printf("Cannot map initial data file '%s'!\n", add);
+	    return 1;
+	}
+#endif
+
+    // Split the file into the chunks, which begin after a line break (or a space).
+#ifdef _OPENMP
+    n_c = omp_get_max_threads();
+#else
+    n_c = 1;
+#endif
+    if(size / CHUNK_MIN + 1 < (size_t)n_c)
+	n_c = (int)(size / CHUNK_MIN) + 1;
+    if((c = (struct text_chunk *)calloc(n_c, sizeof(struct text_chunk))) == NULL)
+	{
+	    printf("NOT enough memory! %s\n", add);
+	    r = 5;
+	    goto return_buf;
+	}
+    c[0].b = buf;
+    for(i = 1; i < n_c; ++i)
+	{
+	    pos = size / n_c * i;
+	    if(buf + pos < c[i-1].b)
+		pos = c[i-1].b - buf;
+	    while(pos < size && (by_line ? buf[pos] != '\n' : !isspace((unsigned char)buf[pos])))
+		++pos;
+	    c[i].b = buf + (pos < size ? pos + 1 : size);
+	    c[i-1].e = c[i].b;
+	}
+    c[n_c-1].e    = buf + size;
+    c[n_c-1].last = true;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for(i = 0; i < n_c; ++i)
+	text_chunk_count(c+i, by_line);
+
+    for(i = 0; i < n_c; ++i)
+	{
+	    if(c[i].err == 1)
+		{
+		    printf("Input contains illigal character(ASCII=%d) in the file '%s', line=%d!\n", c[i].err_ch, add, l + c[i].err_line);
+		    r = 2;
+		    goto return_chunk;
+		}
+	    if(by_line && c[i].line && num && c[i].column != *n_x)
+		{
+		    c[i].err = 2;
+		    c[i].err_line = 0;
+		    c[i].err_column = c[i].column;
+		}
+	    if(c[i].err == 2)
+		{
+		    printf("Error in input data file '%s', line=%d, column=%d, n_x=%d\n", add, l + c[i].err_line, c[i].err_column, num ? *n_x : c[i].column);
+		    r = 2;
+		    goto return_chunk;
+		}
+	    if(!num && c[i].line)
+		*n_x = c[i].column;
+	    num += c[i].num;
+	    l   += c[i].line;
+	}
+    if(num < 1)
+	{
+	    printf("Error in counting fluid variables in initial data file! %s\n", add);
+	    r = 2;
+	    goto return_chunk;
+	}
+    if(!by_line)
+	{
+	    l    = 1;
+	    *n_x = num;
+	}
+
+    if((*U = (double *)malloc(num * sizeof(double))) == NULL)
+	{
+	    printf("NOT enough memory! %s\n", add);
+	    r = 5;
+	    goto return_chunk;
+	}
+    c[0].line = 0;
+    for(i = 1; i < n_c; ++i)
+	c[i].line = c[i-1].line + c[i-1].num; // The index of the first entry in the chunk.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for(i = 0; i < n_c; ++i)
+	text_chunk_parse(c+i, *U + c[i].line);
+    for(i = 0; i < n_c; ++i)
+	if(c[i].err == 3)
+	    {
+		printf("The %dth entry in the initial data file is not a double-precision floats.\n", c[i].line + c[i].err_column + 1);
+		free(*U);
+		*U = NULL;
+		r = 2;
+		goto return_chunk;
+	    }
+    *line = l;
+
+ return_chunk:
+    free(c);
+ return_buf:
+#ifdef _WIN32
+    free(buf);
+#else
+    munmap(buf, size);
+#endif
+    return r;
+}
+
+/**
+ * @brief This function reads in the numbers of an initial data binary file of raw little-endian doubles.
+ * @param[in]  add:     The address of the input file.
+ * @param[out] U:       Pointer to the data array of the numbers, which is allocated in this function.
+ * @param[in,out] line: The line number of the numbers in the file.
+ * @param[in,out] n_x:  The column number of the numbers in the file.
+ *                      If it is positive, the numbers are arranged into lines of n_x numbers.
+ *                      Otherwise, the numbers are counted as one line.
+ * @return  It returns 0 if successfully read the file, 1 if the file cannot be opened,
+ *          2 if the file is illegal, and 5 if there is not enough memory.
+ */
+static int flu_var_load_bin(const char * add, double ** U, int * line, int * n_x)
+{
+    FILE * fp;
+    long size;
+    int num, i, k;
+    const unsigned int one = 1;
+    unsigned char * b, t;
+
+    if((fp = fopen(add, "rb")) == NULL)
+	return 1;
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    rewind(fp);
+    num = (int)(size / (long)sizeof(double));
+    if(size < 1 || size % sizeof(double) || (*n_x > 0 && num % *n_x))
+	{
+	    printf("Error in counting fluid variables in initial data file! %s\n", add);
+	    printf(" size=%ld bytes, n_x=%d.\n", size, *n_x);
+	    fclose(fp);
+	    return 2;
+	}
+    if((*U = (double *)malloc(size)) == NULL)
+	{
+	    printf("NOT enough memory! %s\n", add);
+	    fclose(fp);
+	    return 5;
+	}
+    if(fread(*U, sizeof(double), num, fp) != (size_t)num)
+	{
+	    printf("Read error occurrs in initial data file '%s'!\n", add);
+	    free(*U);
+	    *U = NULL;
+	    fclose(fp);
+	    return 2;
+	}
+    fclose(fp);
+    if(*(const unsigned char *)&one == 0) // big-endian host
+	for(i = 0; i < num; ++i)
+	    {
+		b = (unsigned char *)(*U + i);
+		for(k = 0; k < (int)sizeof(double)/2; ++k)
+		    {
+			t = b[k];
+			b[k] = b[sizeof(double)-1-k];
+			b[sizeof(double)-1-k] = t;
+		    }
+	    }
+    if(*n_x > 0)
+	*line = num / *n_x;
+    else
+	{
+	    *line = 1;
+	    *n_x  = num;
+	}
+    return 0;
+}
+
+#ifdef HDF5PLOT
+/**
+ * @brief This function reads in the dataset of a fluid variable in the initial data HDF5 file.
+ * @param[in]  add:  The address of the input file.
+ * @param[in]  name: Name of the dataset of the fluid variable.
+ * @param[out] U:    Pointer to the data array of the numbers, which is allocated in this function.
+ * @param[out] line: The line number of the numbers (the first dimension of a 2-D dataset).
+ * @param[out] n_x:  The column number of the numbers (the last dimension of the dataset).
+ * @return  It returns 0 if successfully read the file, 1 if there is no such dataset,
+ *          2 if the dataset is illegal, and 5 if there is not enough memory.
+ */
+static int flu_var_load_hdf5(const char * add, const char * name, double ** U, int * line, int * n_x)
+{
+    hid_t file_id, dataset_id, dataspace_id;
+    hsize_t dims[2];
+    int rank, r = 0;
+    H5E_auto2_t err_func;
+    void * err_data;
+
+    if(ACCESS(add, 4) == -1)
+	return 1;
+    // Look for the dataset without printing the HDF5 error stack.
+    H5Eget_auto2(H5E_DEFAULT, &err_func, &err_data);
+    H5Eset_auto2(H5E_DEFAULT, NULL, NULL);
+    file_id = H5Fopen(add, H5F_ACC_RDONLY, H5P_DEFAULT);
+    if(file_id >= 0 && H5Lexists(file_id, name, H5P_DEFAULT) <= 0)
+	{
+	    H5Fclose(file_id);
+	    file_id = -1;
+	}
+    H5Eset_auto2(H5E_DEFAULT, err_func, err_data);
+    if(file_id < 0)
+	return 1;
+    dataset_id   = H5Dopen(file_id, name, H5P_DEFAULT);
+    dataspace_id = H5Dget_space(dataset_id);
+    rank = H5Sget_simple_extent_ndims(dataspace_id);
+    if(rank < 1 || rank > 2 || H5Sget_simple_extent_dims(dataspace_id, dims, NULL) < 0 ||
+       dims[0] < 1 || dims[rank-1] < 1)
+	{
+	    printf("The dataset '%s' in the initial data file '%s' is not 1-D or 2-D!\n", name, add);
+	    r = 2;
+	    goto return_id;
+	}
+    *line = rank == 2 ? (int)dims[0] : 1;
+    *n_x  = (int)dims[rank-1];
+    if((*U = (double *)malloc((size_t)*line * *n_x * sizeof(double))) == NULL)
+	{
+	    printf("NOT enough memory! %s\n", name);
+	    r = 5;
+	    goto return_id;
+	}
+    if(H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, *U) < 0)
+	{
+	    printf("Read error occurrs in the dataset '%s' of the initial data file '%s'!\n", name, add);
+	    free(*U);
+	    *U = NULL;
+	    r = 2;
+	}
+
+ return_id:
+    H5Sclose(dataspace_id);
+    H5Dclose(dataset_id);
+    H5Fclose(file_id);
+    return r;
+}
+#endif
+
+/**
+ * @brief This function starts reading the initial data files of a test example into the page cache in the background.
+ * @details For each name, the file 'name' itself (e.g. a mesh file 'name.msh') and the data files 'name.bin', 'name.txt'
+ *          and 'name.dat' of flu_var_load() which exist are advised to the kernel (POSIX_FADV_WILLNEED), so that they are
+ *          read by its I/O threads while the configuration is read, the earlier files are parsed and the grids are built.
+ *          Nothing is done on Windows.
+ * @param[in] add_in: Adress of the initial data folder of the test example.
+ * @param[in] name:   Names of the files.
+ * @param[in] n:      Number of the names.
+ */
+void file_prefetch(const char * add_in, const char * const name[], const int n)
+{
+#ifndef _WIN32
+    const char * ext[] = {"", ".bin", ".txt", ".dat"};
+    char add[FILENAME_MAX+40];
+    int i, e, fd;
+
+    for(i = 0; i < n; ++i)
+	for(e = 0; e < (int)(sizeof(ext)/sizeof(ext[0])); ++e)
+	    {
+		snprintf(add, sizeof(add), "%s%s%s", add_in, name[i], ext[e]);
+		if((fd = open(add, O_RDONLY)) == -1)
+		    continue;
+		posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+		close(fd);
+	    }
+#else
+    (void)add_in; (void)name; (void)n;
+#endif
+}
+
+/**
+ * @brief This function counts out and reads in the initial data of a fluid variable.
+ * @details The data is read from the first existing one of the following files in the initial data folder:
+ *          -# 'name.bin':    Raw little-endian doubles.
+ *          -# 'FLU_VAR.h5':  The 1-D or 2-D dataset '/name' in the HDF5 file (with HDF5PLOT defined).
+ *          -# 'name.txt' and 'name.dat': Text file of the numbers separated by spaces.
+ * @param[in]  add_in:  Adress of the initial data folder of the test example.
+ * @param[in]  name:    Name of the fluid variable.
+ * @param[out] U:       Pointer to the data array of the fluid variable, which is allocated in this function.
+ * @param[out] line:    The line number of the data.
+ * @param[in,out] n_x:  The column number of the data.
+ *                      For the binary file, it is the given column number if it is positive.
+ * @param[in]  by_line: Whether the data is arranged in lines with the same column number.
+ *                      If not, all the data are counted as one line of (n_x) numbers.
+ * @return  It returns 0 if successfully read the data, 1 if there is no data file,
+ *          2 if the data file is illegal, and 5 if there is not enough memory.
+ */
+int flu_var_load(const char * add_in, const char * name, double ** U, int * line, int * n_x, const _Bool by_line)
+{
+    char add[FILENAME_MAX+40];
+    int r, n = by_line ? *n_x : 0; // n: The column number which is kept if there is no data file.
+
+    *U = NULL;
+    strcpy(add, add_in);
+    strcat(add, name);
+    strcat(add, ".bin");
+    if((r = flu_var_load_bin(add, U, line, &n)) != 1)
+	goto return_r;
+#ifdef HDF5PLOT
+    strcpy(add, add_in);
+    strcat(add, "FLU_VAR.h5");
+    if((r = flu_var_load_hdf5(add, name, U, line, &n)) != 1)
+	{
+	    if(!r && !by_line)
+		{
+		    n    *= *line;
+		    *line = 1;
+		}
+	    goto return_r;
+	}
+#endif
+    strcpy(add, add_in);
+    strcat(add, name);
+    strcat(add, ".txt");
+    if((r = flu_var_load_text(add, U, line, &n, by_line)) != 1)
+	goto return_r;
+    strcpy(add, add_in);
+    strcat(add, name);
+    strcat(add, ".dat");
+    r = flu_var_load_text(add, U, line, &n, by_line);
+
+ return_r:
+    if(!r)
+	*n_x = n;
+    return r;
+}
+
+
+/**
+ * @brief This function reads in the initial mass fractions of the K = config[71] passively advected species.
+ * @details The mass fractions of the s-th species are read by flu_var_load() from 'Y_s' (s = 1, …, K) of the initial
+ *          data folder into the s-th row of one block [K][num_cell] 'FV->Y'. A species without the data file is zero.
+ * @param[in]     ctx:      Pointer to the run context.
+ * @param[in]     add_in:   Adress of the initial data folder of the test example.
+ * @param[in]     num_cell: Number of the grid cells.
+ * @param[in]     by_line:  Whether the data is arranged in lines with the same column number (config[13]).
+ * @param[in,out] FV:       Structure of initial fluid variable data, 'FV->Y' and 'FV->n_Y' are set.
+ * @return  Number of the species.
+ */
+int species_load(const struct run_ctx * ctx, const char * add_in, const int num_cell, const _Bool by_line, struct flu_var * FV)
+{
+    const int K = (int)ctx->conf[71];
+    char name[40];
+    double * v;
+    int s, e, line, n;
+
+    FV->Y   = NULL;
+    FV->n_Y = num_cell;
+    if(K <= 0)
+	return 0;
+    FV->Y = (double *)calloc((size_t)K * num_cell, sizeof(double));
+    if(FV->Y == NULL)
+	{
+	    printf("NOT enough memory! Y\n");
+	    exit(5);
+	}
+    for(s = 0; s < K; s++)
+	{
+	    sprintf(name, "Y_%d", s+1);
+	    n = by_line ? (int)ctx->conf[13] : 0;
+	    if((e = flu_var_load(add_in, name, &v, &line, &n, by_line)) == 1)
+		{
+		    printf("Cannot open initial data file: %s!\n\t The species is initialized by zero.\n", name);
+		    continue;
+		}
+	    else if(e)
+		exit(e);
+	    if(line * n != num_cell)
+		{
+		    printf("Input unequal! num_%s=%d, num_cell=%d.\n", name, line * n, num_cell);
+		    exit(2);
+		}
+	    memcpy(FV->Y + (size_t)s * num_cell, v, num_cell * sizeof(double));
+	    free(v);
+	}
+    return K;
+}
+
+
 /**
  * @brief Compare function of double for sort function 'qsort()'.
  */
@@ -279,13 +993,14 @@ static int compare_double(const void *a,const void *b)
 /**
  * @brief This function reads the time data file for plotting 'time_plot.dat' and 
  *        initialize tha array 'time_plot[]'.
+ * @param[in,out] ctx:    Pointer to the run context.
  * @param[in]  add_in:    Adress of the initial data folder of the test example.
  * @param[in]  N_max:     The maximum number of data dimension storing fluid variables in memory.
  * @param[out] N_plot:    Pointer to the number of time steps for plotting.
  * @param[out] time_plot: Pointer to the array of the plotting time recording.
  * @return  It returns the proper number of data dimension storing fluid variables in memory.
  */
-int time_plot_read(const char * add_in, const int N_max, int * N_plot, double * time_plot[])
+int time_plot_read(struct run_ctx * ctx, const char * add_in, const int N_max, int * N_plot, double * time_plot[])
 {
     _Bool r = true; // r: Whether to read data file successfully.
     FILE * fp;
@@ -319,7 +1034,7 @@ int time_plot_read(const char * add_in, const int N_max, int * N_plot, double *
 	    exit(5);
 	}
     (*time_plot)[0] = 0.0;
-    (*time_plot)[*N_plot - 1] = config[1];
+    (*time_plot)[*N_plot - 1] = ctx->conf[1];
     if(r)
 	{
 	    if(flu_var_read(fp, *time_plot + 1, *N_plot - 2))
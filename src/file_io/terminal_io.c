@@ -15,6 +15,7 @@
  * @brief This is a functions preprocesses ARGuments.
  * @details This function prints out all ARGuments, checks for the right ARGument Counter, loads argv[3], argv[4] and
  *          argv[argc_least+1,argc_least+2,…] as configuration, and puts the scheme name into the pointer 'scheme'.
+ * @param[in,out] ctx:    Pointer to the run context.
  * @param[in] argc_least: The least value of the ARGument Counter.
  * @param[in] argc:       ARGument Counter.
  * @param[in] argv:       ARGument Values.
@@ -23,7 +24,7 @@
  *          - argv[3]: Order of numerical scheme[_scheme name] (= 1[_Riemann_exact] or 2[_GRP]).
  *          - argv[argc_least+1,argc_least+2,…]: Configuration supplement config[n]=(double)C (= n=C).
  */
-void arg_preprocess(const int argc_least, const int argc, char *argv[], char * scheme)
+void arg_preprocess(struct run_ctx * ctx, const int argc_least, const int argc, char *argv[], char * scheme)
 {
     int k, j;
     printf("\n");
@@ -67,7 +68,7 @@ void arg_preprocess(const int argc_least, const int argc, char *argv[], char * s
 	    printf("No order or Wrog scheme!\n");
 	    exit(4);
 	}
-    config[9] = (double)order;
+    ctx->conf[9] = (double)order;
 
 #ifdef _WIN32
     printf("Configurating:\n");
@@ -87,7 +88,7 @@ void arg_preprocess(const int argc_least, const int argc, char *argv[], char * s
 		    conf_tmp = strtod(endptr, &endptr);
 		    if (errno != ERANGE && *endptr == '\0')
 			{
-			    config[j] = conf_tmp;
+			    ctx->conf[j] = conf_tmp;
 			    printf("%3d-th configuration: %g (ARGument)\n", j, conf_tmp);
 			}
 		    else
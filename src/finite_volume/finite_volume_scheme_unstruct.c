@@ -17,6 +17,120 @@
 #include "../include/flux_calc.h"
 
 
+#ifndef _OPENACC // The interfaces are solved one by one on the device.
+/**
+ * @brief This function solves the fluxes of a block of interfaces by a batched flux solver.
+ * @details The states on both sides of the interfaces are gathered into structures of arrays,
+ *          the fluxes are given by 'flux_batch' for the whole block, and then copied to the cells on both sides.
+ * @param[in] cv:    Structure of cell variable data.
+ * @param[in] mv:    Structure of meshing variable data.
+ * @param[in] fv:    Structure of the interfaces.
+ * @param[in] flux_batch: The batched flux solver.
+ * @param[in,out] ifv:   Work structure of the left state.
+ * @param[in,out] ifv_R: Work structure of the right state.
+ * @param[in] f0:    The first interface of the block.
+ * @param[in] i:     The current time step.
+ * @return    Error indicator (1: calculation error of the left/right states).
+ */
+static int flux_face_batch(const struct cell_var * cv, const struct mesh_var * mv, const struct face_var * fv,
+			   flux_batch_fn const flux_batch, struct i_f_var * ifv, struct i_f_var * ifv_R, const int f0, const int i)
+{
+	double var[15][FLUX_BATCH_SIZE]; // the left and right states, and the fluxes
+	int face[FLUX_BATCH_SIZE];       // the interfaces solved in the block
+	double lambda_max;
+	struct i_f_var_batch bv_L = {.RHO = var[0], .U = var[1], .P = var[2], .gamma = var[3], .V = var[4], .n_x = var[5], .n_y = var[6]};
+	struct i_f_var_batch bv_R = {.RHO = var[7], .U = var[8], .P = var[9], .V = var[10]};
+	double * const F[4] = {var[11], var[12], var[13], var[14]};
+	int f, b, nb = 0, err = 0;
+
+	for(f = f0; f < MIN(f0 + FLUX_BATCH_SIZE, fv->num_face); f++)
+		{
+			const int ivi = interface_var_init(cv, mv, ifv, ifv_R, fv->cell_L[f], fv->face_L[f], i, 0.0);
+			if(ivi == 0)
+				err = 1;
+			if(ivi != 1)
+				continue;
+			bv_L.RHO[nb] = ifv->RHO;   bv_L.U[nb] = ifv->U;   bv_L.V[nb] = ifv->V;   bv_L.P[nb] = ifv->P;
+			bv_R.RHO[nb] = ifv_R->RHO; bv_R.U[nb] = ifv_R->U; bv_R.V[nb] = ifv_R->V; bv_R.P[nb] = ifv_R->P;
+			bv_L.gamma[nb] = ifv->gamma;
+			bv_L.n_x[nb]   = ifv->n_x;
+			bv_L.n_y[nb]   = ifv->n_y;
+			face[nb++] = f;
+		}
+	if(nb)
+		flux_batch(nb, F, &lambda_max, &bv_L, &bv_R);
+	for(b = 0; b < nb; b++)
+		{
+			f = face[b];
+			ifv->F_rho = F[0][b];
+			ifv->F_u   = F[1][b];
+			ifv->F_v   = F[2][b];
+			ifv->F_e   = F[3][b];
+			flux_copy_ifv2cv(ifv, cv, fv->cell_L[f], fv->face_L[f]);
+			if (fv->cell_R[f] >= 0)
+				flux_opposite_ifv2cv(ifv, cv, fv->cell_R[f], fv->face_R[f]);
+		}
+	return err;
+}
+
+
+/**
+ * @brief This function solves the fluxes of the items it0 <= it < it1 of the flux loop, which are the blocks of
+ *        interfaces (with a batched flux solver), the interfaces (with the structure of the interfaces) or the cells.
+ * @param[in] cv:    Structure of cell variable data.
+ * @param[in] mv:    Structure of meshing variable data.
+ * @param[in] fv:    Structure of the interfaces (NULL: each interface of a cell is solved by the cell).
+ * @param[in] flux:  The flux solver of an interface.
+ * @param[in] flux_batch: The batched flux solver (NULL: an interface at a time).
+ * @param[in,out] ifv:   Work structure of the left state.
+ * @param[in,out] ifv_R: Work structure of the right state.
+ * @param[in] it0, it1: The first and the last but one items.
+ * @param[in] i:     The current time step.
+ * @param[in] tau:   The length of the time step.
+ * @return    Error indicator (1: calculation error of the left/right states).
+ */
+static int flux_items(const struct cell_var * cv, const struct mesh_var * mv, const struct face_var * fv,
+		      flux_solver_fn const flux, flux_batch_fn const flux_batch, struct i_f_var * ifv, struct i_f_var * ifv_R,
+		      const int it0, const int it1, const int i, const double tau)
+{
+	int ** cp = mv->cell_pt;
+	int it, j, ivi, flux_err, err = 0;
+	for(it = it0; it < it1; it++)
+		{
+			if (flux_batch)
+				err |= flux_face_batch(cv, mv, fv, flux_batch, ifv, ifv_R, it * FLUX_BATCH_SIZE, i);
+			else if (fv)
+				{
+					ivi = interface_var_init(cv, mv, ifv, ifv_R, fv->cell_L[it], fv->face_L[it], i, 0.0);
+					if(ivi == 0)
+						err = 1;
+					else if (ivi == 1 && (flux_err = flux(&run_ctx_global, ifv, ifv_R, tau)))
+						printf("Error %d of Riemann/GRP solver on [%d, %d, %d] (nt, cell, face)\n", flux_err, i, fv->cell_L[it], fv->face_L[it]);
+					if (ivi != -1)
+						{
+							flux_copy_ifv2cv(ifv, cv, fv->cell_L[it], fv->face_L[it]);
+							if (fv->cell_R[it] >= 0)
+								flux_opposite_ifv2cv(ifv, cv, fv->cell_R[it], fv->face_R[it]);
+						}
+				}
+			else
+				for(j = 0; j < cp[it][0]; j++)
+					{
+						ivi = interface_var_init(cv, mv, ifv, ifv_R, it, j, i, 0.0);
+						// ivi = interface_var_init(cv, mv, ifv, ifv_R, it, j, i, 1.0/sqrt(3));
+						if(ivi == 0)
+							err = 1;
+						else if (ivi == 1 && (flux_err = flux(&run_ctx_global, ifv, ifv_R, tau)))
+							printf("Error %d of Riemann/GRP solver on [%d, %d, %d] (nt, cell, face)\n", flux_err, i, it, j);
+						if (ivi != -1)
+							flux_copy_ifv2cv(ifv, cv, it, j);
+					}
+		}
+	return err;
+}
+#endif
+
+
 /**
  * @brief  This function use various finite volume schemes to solve (augmented) Euler equations for single-/two-component fluid
  *         motion on unstructured grids in Eulerian coordinate.
@@ -38,12 +152,12 @@ void finite_volume_scheme_unstruct(struct flu_var * FV, const struct mesh_var *
 	double const eps   =      config[4];  // the largest value could be seen as zero
 	double       tau   =      config[16]; // the length of the time step
 
-	clock_t start_clock;
+	double start_clock;
 	double cpu_time = 0.0;
+	_Bool const mem_report = (_Bool)config[64]; // memory report at the plotting times
+	char mem_title[64];
 
-	int ** cp = mv->cell_pt;
-
-	struct cell_var cv;
+	struct cell_var cv = {0};
 	cell_mem_init_free(&cv, mv, FV, 1); // Initialize memory
 
 	cons_qty_init(&cv, FV);
@@ -52,41 +166,131 @@ void finite_volume_scheme_unstruct(struct flu_var * FV, const struct mesh_var *
 
 	cell_rel(&cv, mv);
 
+	// Each interface between two inner cells is solved once for both of them.
+#ifdef _OPENACC
+	_Bool const face = true; // The interfaces of the list are solved one by one on the device.
+#else
+	_Bool const face = (_Bool)config[51];
+#endif
+	struct face_var fv;
+	if (face)
+		face_rel(&fv, &cv, mv, 1);
+
 	if (order > 1)
 		cell_centroid(&cv, mv);
+	face_geom_comp(&cv, mv); // The Eulerian grids do not move.
+	lsq_geom_comp(&cv, mv);
+	struct node_var nv = {0}; // The geometry of the moving grids is updated around the moved nodes.
+	if (el != 0)
+		node_rel(&nv, mv, 1);
 
 	printf("Unstructured grid has been constructed.\n");
+	if (mv->quad_nx > 0)
+		printf("The grids are logically rectangular (%d x %d cells), and the cells are related implicitly.\n", mv->quad_nx, mv->quad_ny);
+
+	flux_solver_fn const flux = flux_solver_select(&run_ctx_global, scheme, order);
+	if (flux == NULL)
+		{
+			printf("No Riemann solver!\n");
+			exit(4);
+		}
+#ifdef _OPENACC
+	// The device loops call the flux solver by its number.
+	int const flux_id = flux_solver_id_select(&run_ctx_global, scheme, order);
+	if (flux_id == FLUX_NONE)
+		{
+			printf("No Riemann solver on the device!\n");
+			exit(4);
+		}
+	flux_batch_fn const flux_batch = NULL;
+#else
+	// The interfaces are solved block by block if the scheme has a batched flux solver.
+	flux_batch_fn const flux_batch = face ? flux_batch_select(&run_ctx_global, scheme, order) : NULL;
+#endif
+
+	// The items of the flux loop: the blocks of interfaces, the interfaces or the cells.
+	int const n_item = flux_batch ? (fv.num_face + FLUX_BATCH_SIZE - 1) / FLUX_BATCH_SIZE : face ? fv.num_face : num_cell;
+	struct work_chunk wc;
+	if (work_chunk_init(&wc, n_item, (int)config[69]))
+		printf("The fluxes are solved in %d chunks of the measured costs.\n", wc.num);
 
-	struct i_f_var ifv, ifv_R;
-	double time_c = 0.0;
+	struct out_queue oq;
+	file_2D_unstruct_async_init(&oq, mv, problem, num_cell);
+#ifndef NOVTUPLOT
+	int const plot = 1 | 4; // Tecplot and VTU files
+#else
+	int const plot = 1;     // Tecplot files
+#endif
+
+	struct i_f_var ifv = {0}, ifv_R = {0}; // The derivatives stay zero in the first-order scheme.
+	double time_c = config[79], time_RK; // the current time starts at the time of a warm start
 	_Bool stop_t = false;
-	int i, ivi, RK = 0, N_count = 0;
+	struct steady_state ss; // the monitor of the residuals of the steady state
+	double res[SS_NUM];
+	_Bool steady = false;
+	steady_state_init(&ss, config[73]);
+	if (cv.tau_loc)
+		printf("The steady state is marched by the local time steps of the cells.\n");
+	const int n_RK = ssp_rk_stages(); // Low-storage SSP Runge-Kutta time discretization, each stage is a loop step.
+	int i, solve_err, RK = 0, N_count = 0;
+	const _Bool lim_ghost = order > 1 && !(int)config[31]; // whether the slope limiter runs
+	device_data_enter_unstruct(&cv, mv, FV, face ? &fv : NULL); // Without OpenACC, it does nothing.
 	for(i = 1; i <= N; ++i)
 		{
-			start_clock = clock();
-			if (time_c >= time_plot[N_count] && N_count < (*N_plot-1))
+			start_clock = wall_time();
+			if (RK == 0 && time_c >= time_plot[N_count] && N_count < (*N_plot-1))
 				{
-					file_write_2D_BLOCK_TEC(*FV, *mv, problem, time_plot[N_count]);
+					PHASE_TIC(PT_IO);
+					device_data_update_host_unstruct(mv, FV);
+					file_2D_unstruct_async_write(&oq, FV, time_plot[N_count], plot);
+					PHASE_TOC(PT_IO);
+					if (mem_report)
+						{
+							sprintf(mem_title, "Memory at t = %g", time_plot[N_count]);
+							mem_account_report(mem_title, false);
+						}
 					N_count++;
 				}
 
+			time_RK = RK ? time_c + ssp_rk_time(RK)*tau : time_c; // time of the Runge-Kutta stage
+
+			PHASE_TIC(PT_UPDATE);
 			fluid_var_update(FV, &cv);
+			PHASE_TOC(PT_UPDATE);
+			if (RK == 0 && live_publish_due()) // the fluid variables of the i-1 time steps
+				{
+					device_data_update_host_unstruct(mv, FV);
+					file_2D_unstruct_publish(FV, num_cell, i-1, time_c);
+				}
 
-			if (order > 1)
+			if (el != 0 && i > 1) // @todo ALE grid movement, which gives the displacements of the nodes in 'nv.dX/dY'
 				{
-					if (el != 0 && i > 1) // @todo ALE grid movement
-						cell_centroid(&cv, mv);
+					if (geom_move_unstruct(&nv, &cv, mv) < 0)
+						break;
+					if (nv.gcl > eps)
+						printf("The geometric conservation law is violated by %g on step %d.\n", nv.gcl, i);
+				}
+			// The reconstruction reads the values on the ghost cells, and the fluxes the slopes, so that the ghost cells
+			// are filled in two parts around the reconstruction, and at a time without it.
+			if (lim_ghost)
+				{
+					PHASE_TIC(PT_BOUND);
 					if (mv->bc != NULL)
-						mv->bc(&cv, mv, FV, time_c);
-					if (!(int)config[31])
-						slope_limiter_prim(&cv, mv, FV);
+						mv->bc(&cv, mv, FV, time_RK, GHOST_VAL);
+					PHASE_TOC(PT_BOUND);
+					PHASE_TIC(PT_SLOPE);
+					slope_limiter_prim(&cv, mv, FV);
+					PHASE_TOC(PT_SLOPE);
 				}
+			PHASE_TIC(PT_BOUND);
 			if (mv->bc != NULL)
-				mv->bc(&cv, mv, FV, time_c);
+				mv->bc(&cv, mv, FV, time_RK, lim_ghost ? GHOST_GRAD : GHOST_ALL);
+			PHASE_TOC(PT_BOUND);
 
-			if(isfinite(t_all) || !isfinite(config[16]) || config[16] <= 0.0 || !RK)
+			PHASE_TIC(PT_CFL);
+			if(RK == 0) // The stages of a Runge-Kutta time step share its length.
 			    {
-				tau = tau_calc(&cv, mv);
+				tau = halo_min_unstruct(tau_calc(&cv, mv)); // the same on all the parts of the grids
 				if(tau < eps)
 				    {
 					printf("\nThe length of the time step is so small on [%d, %g, %g] (t_n, time_c, tau)\n", i, time_c, tau);
@@ -103,87 +307,87 @@ void finite_volume_scheme_unstruct(struct flu_var * FV, const struct mesh_var *
 					goto return_NULL;
 				    }
 			    }
+			PHASE_TOC(PT_CFL);
 
-			for(int k = 0; k < num_cell; k++)
-				{
-					for(int j = 0; j < cp[k][0]; j++)
-						{
-							ivi = interface_var_init(&cv, mv, &ifv, &ifv_R, k, j, i, 0.0);
-							// ivi = interface_var_init(&cv, mv, &ifv, &ifv_R, k, j, i, 1.0/sqrt(3));
-							if(ivi == 0)
-								stop_t = true;
-							else if (ivi == 1)
-								{
-									if (order == 1)
-										{
-											if (strcmp(scheme,"Roe") == 0)
-												Roe_flux(&ifv, &ifv_R);
-											else if (strcmp(scheme,"HLL") == 0)
-												HLL_flux(&ifv, &ifv_R);
-											else if(strcmp(scheme,"Riemann_exact") == 0)
-												Riemann_exact_flux(&ifv, &ifv_R);
-											else
-												{
-													printf("No Riemann solver!\n");
-													exit(4);
-												}
-										}
-									else if (order == 2)
-										{
-											if(strcmp(scheme,"GRP_2D") == 0)
-												GRP_2D_flux(&ifv, &ifv_R, tau);
-											else
-												{
-													printf("No Riemann solver!\n");
-													exit(4);
-												}
-										}
-								}
-							if (ivi != -1)
-								flux_copy_ifv2cv(&ifv, &cv, k ,j);
-/*
-							ivi = interface_var_init(&cv, mv, &ifv, &ifv_R, k, j, i, 0.0);
-							//ivi = interface_var_init(&cv, mv, &ifv, &ifv_R, k, j, i, -1.0/sqrt(3));
-							if(ivi == 0)
-								stop_t = true;
-							else if (order == 2 && ivi == 1)
-								{
-									if(strcmp(scheme,"GRP") == 0)					
-										GRP_scheme(&ifv, &ifv_R, tau);
-									else if(strcmp(scheme,"GRP_2D") == 0)
-										GRP_2D_scheme(&ifv, &ifv_R, tau);
-									else if(strcmp(scheme,"Riemann_exact") == 0)
-										Riemann_exact_scheme(&ifv, &ifv_R);
-									else
-										{
-											printf("No Riemann solver!\n");
-											exit(2);
-										}
-								}
-							flux_add_ifv2cv(&ifv, &cv, k ,j);
-*/
-						}
-				}
+			PHASE_TIC(PT_SOLVE);
+			// Each (cell, interface) slot of the fluxes is written by one interface only, so the threads
+			// need no atomics, and the fluxes are gathered cell by cell in cons_qty_update_corr_ave_P().
+			solve_err = 0;
+#ifdef _OPENACC
+			{
+				int ivi, flux_err;
+#pragma acc parallel loop firstprivate(ifv, ifv_R) private(ivi, flux_err) reduction(|:solve_err) present(cv, fv) default(present)
+				for(int it = 0; it < fv.num_face; it++)
+					{
+						ivi = interface_var_init(&cv, mv, &ifv, &ifv_R, fv.cell_L[it], fv.face_L[it], i, 0.0);
+						if(ivi == 0)
+							solve_err = 1;
+						else if (ivi == 1 && (flux_err = flux_solver_call(flux_id, &run_ctx_global, &ifv, &ifv_R, tau)))
+							printf("Error %d of Riemann/GRP solver on [%d, %d, %d] (nt, cell, face)\n", flux_err, i, fv.cell_L[it], fv.face_L[it]);
+						if (ivi != -1)
+							{
+								flux_copy_ifv2cv(&ifv, &cv, fv.cell_L[it], fv.face_L[it]);
+								if (fv.cell_R[it] >= 0)
+									flux_opposite_ifv2cv(&ifv, &cv, fv.cell_R[it], fv.face_R[it]);
+							}
+					}
+			}
+#else
+			if (wc.num) // the cost-weighted chunks stolen by the threads
+			    {
+#pragma omp parallel
+#pragma omp single
+				for(int c = 0; c < wc.num; c++)
+#pragma omp task firstprivate(ifv, ifv_R)
+					{
+						const double t0 = wall_time();
+						if (flux_items(&cv, mv, face ? &fv : NULL, flux, flux_batch, &ifv, &ifv_R, wc.start[c], wc.start[c+1], i, tau))
+#pragma omp atomic write
+							solve_err = 1;
+						wc.cost[c] = wall_time() - t0;
+					}
+				work_chunk_balance(&wc); // the chunks of the next step
+			    }
+			else
+			    {
+#pragma omp parallel for firstprivate(ifv, ifv_R) reduction(|:solve_err) schedule(dynamic, flux_batch ? 1 : 64)
+				for(int it = 0; it < n_item; it++)
+					solve_err |= flux_items(&cv, mv, face ? &fv : NULL, flux, flux_batch, &ifv, &ifv_R, it, it+1, i, tau);
+			    }
+#endif
+			if (solve_err)
+				stop_t = true;
+			PHASE_TOC(PT_SOLVE);
 
+			PHASE_TIC(PT_UPDATE);
 			// cons_qty_update(&cv, mv, *FV, tau);
-			if (cons_qty_update_corr_ave_P(&cv, mv, FV, tau, RK) == 0)
+			if (cons_qty_update_corr_ave_P(&cv, mv, FV, tau, RK, res) == 0)
 			    stop_t = true;
+			PHASE_TOC(PT_UPDATE);
 
-			if((_Bool)config[53])
-			    RK = RK ? 0 : 1;
-			if(!(_Bool)config[53] || RK == 1)
+			stop_t = halo_max_unstruct(stop_t); // All the parts of the grids stop together.
+			// The residuals of the first stage are checked, and the steady state is reached on all the parts.
+			if (ss.tol > 0.0 && RK == 0 && !halo_max_unstruct(!steady_state_check(&ss, res, num_cell, tau)))
+			    {
+				printf("\nThe steady state is reached at step %d, the residuals are reduced by %g.\n", i, ss.rel);
+				steady = true;
+			    }
+			RK = (RK + 1) % n_RK;
+			if(RK == 0)
 			    time_c += tau;
 			if(isfinite(t_all))
-			    DispPro(time_c*100.0/t_all, i);
+			    telemetry_step(time_c*100.0/t_all, i, time_c, tau);
 			else
-			    DispPro(i*100.0/N, i);
+			    telemetry_step(i*100.0/N, i, time_c, tau);
 			if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
 			    break;
+			if(steady && RK == 0)
+			    break;
 
-			cpu_time += (clock() - start_clock) / (double)CLOCKS_PER_SEC;
+			cpu_time += wall_time() - start_clock;
 		}
 	printf("\nTime is up at time step %d.\n", i);
-	printf("\nThe cost of CPU time for the finite volume scheme on unstructured grids in Eulerian coordinate is %g seconds.\n", cpu_time);
+	printf("\nThe cost of wall-clock time for the finite volume scheme on unstructured grids in Eulerian coordinate is %g seconds.\n", cpu_time);
 
 return_NULL:
 	config[5] = (double)i;
@@ -196,5 +400,14 @@ return_NULL:
       time_plot[N_count] = i*tau;
 
 	fluid_var_update(FV, &cv);
+	device_data_exit_unstruct(&cv, mv, FV, face ? &fv : NULL);
+	if (face)
+		face_rel(&fv, &cv, mv, 0);
+	work_chunk_free(&wc);
+	if (el != 0)
+		node_rel(&nv, mv, 0);
 	cell_mem_init_free(&cv, mv, FV, 0);
+	PHASE_TIC(PT_IO);
+	file_2D_unstruct_async_free(&oq);
+	PHASE_TOC(PT_IO);
 }
@@ -18,6 +18,7 @@
 /**
  * @brief This function use Godunov scheme to solve 1-D Euler
  *        equations of motion on ALE coordinate.
+ * @param[in,out] ctx:    Pointer to the run context.
  * @param[in] m:          Number of the grids.
  * @param[in,out] CV:     Structure of cell variable data.
  * @param[in,out] X[]:    Array of the coordinate data.
@@ -26,7 +27,7 @@
  * @param[in,out] time_plot: Array of the plotting time recording.
  * @todo All of the functionality of the ALE code has not yet been implemented.
  */
-void Godunov_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, double * X[], double * cpu_time, int * N_plot, double time_plot[])
+void Godunov_solver_ALE_source_Undone(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, int * N_plot, double time_plot[])
 {
     /* 
      * j is a frequently used index for spatial variables.
@@ -37,13 +38,13 @@ void Godunov_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, doub
   clock_t tic, toc;
   double cpu_time_sum = 0.0;
 
-  double const t_all = config[1];      // the total time
-  double const eps   = config[4];      // the largest value could be seen as zero
-  int    const N     = (int)config[5]; // the maximum number of time steps
-  double const gamma = config[6];      // the constant of the perfect gas
-  double const CFL   = config[7];      // the CFL number
-  double const h     = config[10];     // the length of the initial spatial grids
-  double       tau   = config[16];     // the length of the time step
+  double const t_all = ctx->conf[1];      // the total time
+  double const eps   = ctx->conf[4];      // the largest value could be seen as zero
+  int    const N     = (int)ctx->conf[5]; // the maximum number of time steps
+  double const gamma = ctx->conf[6];      // the constant of the perfect gas
+  double const CFL   = ctx->conf[7];      // the CFL number
+  double const h     = ctx->conf[10];     // the length of the initial spatial grids
+  double       tau   = ctx->conf[16];     // the length of the time step
 
   _Bool find_bound = false;
 
@@ -97,7 +98,7 @@ void Godunov_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, doub
 
       h_S_max = INFINITY; // h/S_max = INFINITY
 
-      find_bound = bound_cond_slope_limiter(true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, false, time_c, X[nt]);
+      find_bound = bound_cond_slope_limiter(ctx, true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, false, time_c, X[nt]);
       if(!find_bound)
 	  goto return_NULL;
 
@@ -144,7 +145,7 @@ void Godunov_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, doub
 //========================Solve Riemann Problem========================
 	      linear_GRP_solver_Edir(dire, mid, &ifv_L, &ifv_R, eps, INFINITY);
 
-	      if(star_dire_check(mid, dire, 1))
+	      if(star_dire_check(ctx, mid, dire, 1))
 		  {
 		      printf(" on [%d, %d] (t_n, x).\n", k, j);
 		      stop_t = true;
@@ -158,7 +159,7 @@ void Godunov_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, doub
 
 //====================Time step and grid fixed======================
     // If no total time, use fixed tau and time step N.
-    if(isfinite(t_all) || !isfinite(config[16]) || config[16] <= 0.0)
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
 	{
 	    tau = CFL * h_S_max;
 	    if(tau < eps)
@@ -204,9 +205,9 @@ void Godunov_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, doub
 
     time_c += tau;
     if(isfinite(t_all))
-        DispPro(time_c*100.0/t_all, k);
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
     else
-        DispPro(k*100.0/N, k);
+        telemetry_step(k*100.0/N, k, time_c, tau);
     if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
 	break;
 
@@ -222,7 +223,7 @@ void Godunov_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, doub
 //---------------------END OF THE MAIN LOOP----------------------
 
 return_NULL:
-  config[5] = (double)k;
+  ctx->conf[5] = (double)k;
   *N_plot = nt+1;
   if(isfinite(time_c))
       time_plot[nt] = time_c;
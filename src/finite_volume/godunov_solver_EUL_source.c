@@ -8,40 +8,108 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdbool.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "../include/var_struc.h"
 #include "../include/riemann_solver.h"
 #include "../include/inter_process.h"
 #include "../include/tools.h"
+#include "../include/file_io.h"
 
 
+/**
+ * @brief The Riemann problem of the interface j with its CFL condition.
+ * @details B_L and B_R tell whether j is the left (j = 0) or the right (j = m) boundary interface,
+ *          whose states are given by the boundary conditions 'bfv_L' and 'bfv_R', so that the loop of
+ *          the interior interfaces (B_L = B_R = 0) has no branches of the boundaries.
+ *          \verbatim
+ *           j-1          j          j+1
+ *          j-1/2  j-1  j+1/2   j   j+3/2  j+1
+ *            o-----X-----o-----X-----o-----X--...
+ *          \endverbatim
+ */
+#define EUL_IFACE_RIEMANN(B_L, B_R)					\
+    do {								\
+	if(!(B_L)) /* Initialize the initial values. */			\
+	    {								\
+		ifv_L.RHO = RHO[nt][j-1];				\
+		ifv_L.U   =   U[nt][j-1];				\
+		ifv_L.P   =   P[nt][j-1];				\
+	    }								\
+	else								\
+	    {								\
+		ifv_L.RHO = bfv_L.RHO;					\
+		ifv_L.U   = bfv_L.U;					\
+		ifv_L.P   = bfv_L.P;					\
+	    }								\
+	if(!(B_R))							\
+	    {								\
+		ifv_R.RHO = RHO[nt][j];					\
+		ifv_R.U   =   U[nt][j];					\
+		ifv_R.P   =   P[nt][j];					\
+	    }								\
+	else								\
+	    {								\
+		ifv_R.RHO = bfv_R.RHO;					\
+		ifv_R.U   = bfv_R.U;					\
+		ifv_R.P   = bfv_R.P;					\
+	    }								\
+									\
+	c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);			\
+	c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);			\
+	h_S_max = fmin(h_S_max, h/(fabs(ifv_L.U)+fabs(c_L)));		\
+	h_S_max = fmin(h_S_max, h/(fabs(ifv_R.U)+fabs(c_R)));		\
+									\
+	/* ========================Solve Riemann Problem======================== */ \
+	p_star = warm ? P_S[j] : 0.0; /* the initial guess from the star pressure of the last time step */ \
+	linear_GRP_solver_Edir_warm(dire, mid, &ifv_L, &ifv_R, eps, INFINITY, &p_star, &n_it); \
+	P_S[j] = p_star;						\
+	n_it_sum += n_it;						\
+									\
+	if((if_err[j] = star_dire_check_code(ctx, mid, dire, 1)))	\
+	    data_err = 1;						\
+									\
+	F_rho[j] = mid[0]*mid[1];					\
+	F_u[j] = F_rho[j]*mid[1] + mid[2];				\
+	F_e[j] = (gamma/(gamma-1.0))*mid[2] + 0.5*F_rho[j]*mid[1];	\
+	F_e[j] = F_e[j]*mid[1];						\
+    } while (0)
+
 /**
  * @brief This function use Godunov scheme to solve 1-D Euler
  *        equations of motion on Eulerian coordinate.
+ * @param[in,out] ctx:    Pointer to the run context.
  * @param[in] m:          Number of the grids.
  * @param[in,out] CV:     Structure of cell variable data.
  * @param[out] cpu_time:  Array of the CPU time recording.
+ * @param[in]  problem:   Name of the numerical results for the test problem.
+ * @param[in]  N_T:       Number of levels storing fluid variables in memory.
  * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
  * @param[in,out] time_plot: Array of the plotting time recording.
  */
-void Godunov_solver_EUL_source(const int m, struct cell_var_stru CV, double * cpu_time, int * N_plot, double time_plot[])
+void Godunov_solver_EUL_source(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[])
 {
+#ifdef _OPENMP
+  printf("@@ Number of threads for OpenMP: %d\n", omp_get_max_threads());
+#endif
     /* 
      * j is a frequently used index for spatial variables.
      * k is a frequently used index for the time step.
      */
   int j, k = 0;
 
-  clock_t tic, toc;
+  double tic, toc;
   double cpu_time_sum = 0.0;
 
-  double const t_all = config[1];      // the total time
-  double const eps   = config[4];      // the largest value could be seen as zero
-  int    const N     = (int)config[5]; // the maximum number of time steps
-  double const gamma = config[6];      // the constant of the perfect gas
-  double const CFL   = config[7];      // the CFL number
-  double const h     = config[10];     // the length of the initial spatial grids
-  double       tau   = config[16];     // the length of the time step
+  double const t_all = ctx->conf[1];      // the total time
+  double const eps   = ctx->conf[4];      // the largest value could be seen as zero
+  int    const N     = (int)ctx->conf[5]; // the maximum number of time steps
+  double const gamma = ctx->conf[6];      // the constant of the perfect gas
+  double const CFL   = ctx->conf[7];      // the CFL number
+  double const h     = ctx->conf[10];     // the length of the initial spatial grids
+  double       tau   = ctx->conf[16];     // the length of the time step
 
   _Bool find_bound = false;
 
@@ -57,7 +125,17 @@ void Godunov_solver_EUL_source(const int m, struct cell_var_stru CV, double * cp
   double h_S_max; // h/S_max, S_max is the maximum wave speed
   double time_c = 0.0; // the current time
   _Bool stop_t = false;
-  int nt = 0; // the number of times storing plotting data
+  int data_err; // whether there is miscalculation in the parallel loops
+  int nt = 0, nt_plot = 0; // the number of times storing plotting data
+  int nt_w; // the level written by the time step, the next one after a plotting time
+  _Bool const stream = (_Bool)ctx->conf[34]; // streaming output of the plotting data
+  _Bool const warm   = (_Bool)ctx->conf[35]; // warm start of the exact Riemann solver
+  int n_it; // the number of Newton iterations of a Riemann solver
+  long n_it_sum = 0, n_solve = 0; // the total numbers of Newton iterations and Riemann solvers
+  int    const n_ckpt  = (int)ctx->conf[43];   // the number of time steps between the checkpoints
+  _Bool  const restart = (_Bool)ctx->conf[44]; // restart from the checkpoint
+  struct ckpt_var ckpt = {0}; // the checkpoint of the state of the time loop
+  double p_star; // the star pressure
 
   struct b_f_var bfv_L = {.SRHO = 0.0, .SP = 0.0, .SU = 0.0}, bfv_R = bfv_L; // Left/Right boundary condition
   struct i_f_var ifv_L = {.gamma = gamma}, ifv_R = ifv_L;
@@ -70,88 +148,89 @@ void Godunov_solver_EUL_source(const int m, struct cell_var_stru CV, double * cp
   double * F_rho = (double*)malloc((m+1) * sizeof(double));
   double * F_u   = (double*)malloc((m+1) * sizeof(double));
   double * F_e   = (double*)malloc((m+1) * sizeof(double));
-  if(F_rho == NULL || F_u == NULL || F_e == NULL)
+  int * if_err   = (int*)malloc((m+1) * sizeof(int)); // the miscalculation indicators at (x_{j-1/2}, t_{n}).
+  double * P_S   = (double*)calloc(m+1, sizeof(double)); // the star pressure at (x_{j-1/2}, t_{n-1}).
+  if(F_rho == NULL || F_u == NULL || F_e == NULL || if_err == NULL || P_S == NULL)
       {
 	  printf("NOT enough memory! Flux\n");
 	  goto return_NULL;
       }
   
+  if(n_ckpt > 0 || restart) // the state of the time loop
+      {
+	  if(checkpoint_init(ctx, &ckpt, problem))
+	      goto return_NULL;
+	  checkpoint_add(&ckpt, &k,            sizeof(k));
+	  checkpoint_add(&ckpt, &time_c,       sizeof(time_c));
+	  checkpoint_add(&ckpt, &tau,          sizeof(tau));
+	  checkpoint_add(&ckpt, &nt,           sizeof(nt));
+	  checkpoint_add(&ckpt, &nt_plot,      sizeof(nt_plot));
+	  checkpoint_add(&ckpt, &find_bound,   sizeof(find_bound));
+	  checkpoint_add(&ckpt, &cpu_time_sum, sizeof(cpu_time_sum));
+	  checkpoint_add(&ckpt, &n_it_sum,     sizeof(n_it_sum));
+	  checkpoint_add(&ckpt, &n_solve,      sizeof(n_solve));
+	  checkpoint_add(&ckpt, &bfv_L,        sizeof(bfv_L));
+	  checkpoint_add(&ckpt, &bfv_R,        sizeof(bfv_R));
+	  checkpoint_add(&ckpt, cpu_time, N_T * sizeof(double));
+	  checkpoint_add(&ckpt, P_S,      (m+1) * sizeof(double));
+	  checkpoint_add_1D(&ckpt, m, N_T, CV, NULL);
+	  if(restart && checkpoint_read(&ckpt))
+	      goto return_NULL;
+      }
+
 //-----------------------THE MAIN LOOP--------------------------------
-  for(k = 1; k <= N; ++k)
+  for(k = restart ? k+1 : 1; k <= N; ++k) // Go on from the time step after the checkpoint.
   {
-      tic = clock();
-      if (time_c >= time_plot[nt] && nt < (*N_plot-1))
+      tic = wall_time();
+      nt_w = nt;
+      if (time_c >= time_plot[nt_plot] - eps && nt_plot < (*N_plot-1))
 	  {
-	      for(j = 0; j < m; ++j)
+	      if(stream)
 		  {
-		      RHO[nt+1][j] = RHO[nt][j];
-		      U[nt+1][j]   =   U[nt][j];
-		      E[nt+1][j]   =   E[nt][j];  
-		      P[nt+1][j]   =   P[nt][j];
+		      PHASE_TIC(PT_IO);
+		      file_1D_write_stream(ctx, m, nt_plot, CV, nt, NULL, NULL, problem, time_plot[nt_plot]);
+		      PHASE_TOC(PT_IO);
 		  }
-	      nt++;
+	      nt_plot++;
+	      if (nt < (N_T-1)) // The next step writes the next level from this one, which is kept for the plot.
+		  nt_w = nt+1;
 	  }
 
       h_S_max = INFINITY; // h/S_max = INFINITY
 
-      find_bound = bound_cond_slope_limiter(false, m, nt, &CV, &bfv_L, &bfv_R, find_bound, false, time_c);
+      find_bound = bound_cond_slope_limiter(ctx, false, m, nt, &CV, &bfv_L, &bfv_R, find_bound, false, time_c);
       if(!find_bound)
 	  goto return_NULL;
 
-      for(j = 0; j <= m; ++j)
-	  { /*
-	     *  j-1          j          j+1
-	     * j-1/2  j-1  j+1/2   j   j+3/2  j+1
-	     *   o-----X-----o-----X-----o-----X--...
-	     */
-	      if(j) // Initialize the initial values.
-		  {
-		      ifv_L.RHO = RHO[nt][j-1];
-		      ifv_L.U   =   U[nt][j-1];
-		      ifv_L.P   =   P[nt][j-1];
-		  }
-	      else
-		  {
-		      ifv_L.RHO = bfv_L.RHO;
-		      ifv_L.U   = bfv_L.U;
-		      ifv_L.P   = bfv_L.P;
-		  }
-	      if(j < m)
-		  {
-		      ifv_R.RHO = RHO[nt][j];
-		      ifv_R.U   =   U[nt][j];
-		      ifv_R.P   =   P[nt][j];
-		  }
-	      else
-		  {
-		      ifv_R.RHO = bfv_R.RHO;
-		      ifv_R.U   = bfv_R.U;
-		      ifv_R.P   = bfv_R.P;
-		  }
-
-	      c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);
-	      c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);
-	      h_S_max = fmin(h_S_max, h/(fabs(ifv_L.U)+fabs(c_L)));
-	      h_S_max = fmin(h_S_max, h/(fabs(ifv_R.U)+fabs(c_R)));
-
-//========================Solve Riemann Problem========================
-	      linear_GRP_solver_Edir(dire, mid, &ifv_L, &ifv_R, eps, INFINITY);
-
-	      if(star_dire_check(mid, dire, 1))
+      PHASE_TIC(PT_SOLVE);
+      data_err = 0;
+#pragma omp parallel private(j, c_L, c_R, dire, mid, p_star, n_it) firstprivate(ifv_L, ifv_R) reduction(min:h_S_max) reduction(|:data_err) reduction(+:n_it_sum)
+      {
+#pragma omp for nowait
+	  for(j = 1; j < m; ++j)
+	      EUL_IFACE_RIEMANN(0, 0);
+#pragma omp single nowait
+	  { // the boundary interfaces peeled out of the loop
+	      j = 0;
+	      EUL_IFACE_RIEMANN(1, 0);
+	      j = m;
+	      EUL_IFACE_RIEMANN(0, 1);
+	  }
+      }
+      if(data_err) // Report the miscalculation in order of the interfaces.
+	  for(j = 0; j <= m; ++j)
+	      if(if_err[j])
 		  {
-		      printf(" on [%d, %d] (t_n, x).\n", k, j);
+		      printf("%s on [%d, %d] (t_n, x).\n", star_dire_check_msg(if_err[j]), k, j);
 		      stop_t = true;
 		  }
-
-	      F_rho[j] = mid[0]*mid[1];
-	      F_u[j] = F_rho[j]*mid[1] + mid[2];
-	      F_e[j] = (gamma/(gamma-1.0))*mid[2] + 0.5*F_rho[j]*mid[1];
-	      F_e[j] = F_e[j]*mid[1];
-	  }
+      n_solve += m+1;
+      PHASE_TOC(PT_SOLVE);
 
 //====================Time step and grid fixed======================
+    PHASE_TIC(PT_CFL);
     // If no total time, use fixed tau and time step N.
-    if(isfinite(t_all) || !isfinite(config[16]) || config[16] <= 0.0)
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
 	{
 	    tau = CFL * h_S_max;
 	    if(tau < eps)
@@ -166,10 +245,16 @@ void Godunov_solver_EUL_source(const int m, struct cell_var_stru CV, double * cp
 		    printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, tau) - CFL\n", k, time_c, tau); 
 		    goto return_NULL;
 		}
+	    else if(nt_plot < (*N_plot-1) && (time_c + tau) > (time_plot[nt_plot] - eps))
+		tau = time_plot[nt_plot] - time_c; // The step lands on the plotting time.
 	}
+    PHASE_TOC(PT_CFL);
     nu = tau / h;
 
 //======================THE CORE ITERATION=========================(On Eulerian Coordinate)
+    PHASE_TIC(PT_UPDATE);
+    data_err = 0;
+#pragma omp parallel for private(Mom, Ene) reduction(|:data_err)
     for(j = 0; j < m; ++j) // forward Euler
 	{ /*
 	   *  j-1          j          j+1
@@ -178,48 +263,63 @@ void Godunov_solver_EUL_source(const int m, struct cell_var_stru CV, double * cp
 	   */
 	    Mom = RHO[nt][j]*U[nt][j] - nu*(F_u[j+1]  -F_u[j]);
 	    Ene = RHO[nt][j]*E[nt][j] - nu*(F_e[j+1]  -F_e[j]);
-	    RHO[nt][j]  =  RHO[nt][j] - nu*(F_rho[j+1]-F_rho[j]);
+	    RHO[nt_w][j] = RHO[nt][j] - nu*(F_rho[j+1]-F_rho[j]);
 
-	    U[nt][j] = Mom / RHO[nt][j];
-	    E[nt][j] = Ene / RHO[nt][j];
-	    P[nt][j] = (Ene - 0.5*Mom*U[nt][j])*(gamma-1.0);
+	    U[nt_w][j] = Mom / RHO[nt_w][j];
+	    E[nt_w][j] = Ene / RHO[nt_w][j];
+	    P[nt_w][j] = (Ene - 0.5*Mom*U[nt_w][j])*(gamma-1.0);
+	    if(P[nt_w][j] < eps || RHO[nt_w][j] < eps)
+		data_err = 1;
+	}
+    nt = nt_w;
+    if(data_err) // Report the miscalculation in order of the cells.
+	for(j = 0; j < m; ++j)
 	    if(P[nt][j] < eps || RHO[nt][j] < eps)
 		{
 		    printf("<0.0 error on [%d, %d] (t_n, x) - Update\n", k, j);
 		    stop_t = true;
 		}
-	}
+    PHASE_TOC(PT_UPDATE);
 
 //============================Time update=======================
 
     time_c += tau;
     if(isfinite(t_all))
-        DispPro(time_c*100.0/t_all, k);
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
     else
-        DispPro(k*100.0/N, k);
+        telemetry_step(k*100.0/N, k, time_c, tau);
+    file_1D_publish(ctx, m, k, CV, nt, NULL, time_c);
     if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
 	break;
 
 //===========================Fixed variable location=======================
 
-    toc = clock();
-    cpu_time_sum += ((double)toc - (double)tic) / (double)CLOCKS_PER_SEC;
+    toc = wall_time();
+    cpu_time_sum += toc - tic;
     cpu_time[nt]  = cpu_time_sum;
+    if(n_ckpt > 0 && k % n_ckpt == 0)
+	{
+	    PHASE_TIC(PT_IO);
+	    checkpoint_write(&ckpt);
+	    PHASE_TOC(PT_IO);
+	}
   }
 
   printf("\nTime is up at time step %d.\n", k);
-  printf("The cost of CPU time for 1D-Godunov Eulerian scheme for this problem is %g seconds.\n", cpu_time_sum);
+  printf("The cost of wall-clock time for 1D-Godunov Eulerian scheme for this problem is %g seconds.\n", cpu_time_sum);
+  if(n_solve)
+      printf("The average number of Newton iterations per Riemann solver is %g.\n", (double)n_it_sum/(double)n_solve);
 //---------------------END OF THE MAIN LOOP----------------------
 
 return_NULL:
-  config[5] = (double)k;
-  *N_plot = nt+1;
+  ctx->conf[5] = (double)k;
+  *N_plot = nt_plot+1;
   if(isfinite(time_c))
-      time_plot[nt] = time_c;
+      time_plot[nt_plot] = time_c;
   else if(isfinite(t_all))
-      time_plot[nt] = t_all;
+      time_plot[nt_plot] = t_all;
   else if(isfinite(tau))
-      time_plot[nt] = k*tau;
+      time_plot[nt_plot] = k*tau;
 
   free(F_rho);
   free(F_u);
@@ -227,4 +327,9 @@ return_NULL:
   F_rho = NULL;
   F_u   = NULL;
   F_e   = NULL;
+  free(if_err);
+  if_err = NULL;
+  free(P_S);
+  P_S = NULL;
+  checkpoint_free(&ckpt);
 }
@@ -8,42 +8,117 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdbool.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "../include/var_struc.h"
 #include "../include/riemann_solver.h"
 #include "../include/inter_process.h"
 #include "../include/tools.h"
+#include "../include/file_io.h"
+#include "../include/finite_volume.h"
 
 
+/**
+ * @brief The Riemann problem of the interface j with its CFL condition.
+ * @details B_L and B_R tell whether j is the left (j = 0) or the right (j = m) boundary interface,
+ *          whose states are given by the boundary conditions 'bfv_L' and 'bfv_R', so that the loop of
+ *          the interior interfaces (B_L = B_R = 0) has no branches of the boundaries.
+ *          \verbatim
+ *           j-1          j          j+1
+ *          j-1/2  j-1  j+1/2   j   j+3/2  j+1
+ *            o-----X-----o-----X-----o-----X--...
+ *          \endverbatim
+ */
+#define LAG_IFACE_RIEMANN(B_L, B_R)					\
+    do {								\
+	if(!(B_L)) /* Initialize the initial values. */			\
+	    {								\
+		h_L       =   X[nt][j] - X[nt][j-1];			\
+		ifv_L.RHO = RHO[nt][j-1];				\
+		ifv_L.U   =   U[nt][j-1];				\
+		ifv_L.P   =   P[nt][j-1];				\
+	    }								\
+	else								\
+	    {								\
+		h_L       = bfv_L.H;					\
+		ifv_L.RHO = bfv_L.RHO;					\
+		ifv_L.U   = bfv_L.U;					\
+		ifv_L.P   = bfv_L.P;					\
+	    }								\
+	if(!(B_R))							\
+	    {								\
+		h_R       =   X[nt][j+1] - X[nt][j];			\
+		ifv_R.RHO = RHO[nt][j];					\
+		ifv_R.U   =   U[nt][j];					\
+		ifv_R.P   =   P[nt][j];					\
+	    }								\
+	else								\
+	    {								\
+		h_R       = bfv_R.H;					\
+		ifv_R.RHO = bfv_R.RHO;					\
+		ifv_R.U   = bfv_R.U;					\
+		ifv_R.P   = bfv_R.P;					\
+	    }								\
+									\
+	c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);			\
+	c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);			\
+	h_S_max = fmin(h_S_max, h_L/c_L);				\
+	h_S_max = fmin(h_S_max, h_R/c_R);				\
+	if ((B_L) && (bound == -2 || bound == -24)) /* reflective boundary conditions */ \
+	    h_S_max = fmin(h_S_max, h_L/(fabs(ifv_L.U)+c_L));		\
+	if ((B_R) && bound == -2)					\
+	    h_S_max = fmin(h_S_max, h_R/(fabs(ifv_R.U)+c_R));		\
+									\
+	/* ========================Solve Riemann Problem======================== */ \
+	p_star = warm ? P_F[j] : 0.0; /* the initial guess from the star pressure of the last time step */ \
+	Riemann_solver_exact_single_warm(&u_star, &p_star, gamma, ifv_L.U, ifv_R.U, ifv_L.P, ifv_R.P, c_L, c_R, CRW, eps, eps, 500, &n_it); \
+	n_it_sum += n_it;						\
+									\
+	if_err[j] = (p_star < eps) | (!isfinite(p_star)|| !isfinite(u_star)) << 1; \
+	data_err |= if_err[j];						\
+									\
+	U_F[j] = u_star;						\
+	P_F[j] = p_star;						\
+    } while (0)
+
 /**
  * @brief This function use Godunov scheme to solve 1-D Euler
  *        equations of motion on Lagrangian coordinate.
+ * @param[in,out] ctx:    Pointer to the run context.
  * @param[in] m:          Number of the grids.
  * @param[in,out] CV:     Structure of cell variable data.
  * @param[in,out] X[]:    Array of the coordinate data.
  * @param[out] cpu_time:  Array of the CPU time recording.
+ * @param[in]  problem:   Name of the numerical results for the test problem.
+ * @param[in]  N_T:       Number of levels storing fluid variables in memory.
  * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
  * @param[in,out] time_plot: Array of the plotting time recording.
  */
-void Godunov_solver_LAG_source(const int m, struct cell_var_stru CV, double * X[], double * cpu_time, int * N_plot, double time_plot[])
+void Godunov_solver_LAG_source(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[])
 {
+#ifdef _OPENMP
+  printf("@@ Number of threads for OpenMP: %d\n", omp_get_max_threads());
+#endif
     /* 
      * j is a frequently used index for spatial variables.
      * k is a frequently used index for the time step.
      */
   int j, k = 0;
 
-  clock_t tic, toc;
+  double tic, toc;
   double cpu_time_sum = 0.0;
 
-  double const t_all = config[1];       // the total time
-  double const eps   = config[4];       // the largest value could be seen as zero
-  int    const N     = (int)config[5];  // the maximum number of time steps
-  double const gamma = config[6];       // the constant of the perfect gas
-  double const CFL   = config[7];       // the CFL number
-  double const h     = config[10];      // the length of the initial spatial grids
-  double       tau   = config[16];      // the length of the time step
-  int    const bound = (int)config[17]; // the boundary condition in x-direction
+  double const t_all = ctx->conf[1];       // the total time
+  double const eps   = ctx->conf[4];       // the largest value could be seen as zero
+  int    const N     = (int)ctx->conf[5];  // the maximum number of time steps
+  double const gamma = ctx->conf[6];       // the constant of the perfect gas
+  double const CFL   = ctx->conf[7];       // the CFL number
+  double const h     = ctx->conf[10];      // the length of the initial spatial grids
+  double       tau   = ctx->conf[16];      // the length of the time step
+  double     tau_cfl = tau;                // the length of the time step before it lands on the plotting time
+  int    const bound = (int)ctx->conf[17]; // the boundary condition in x-direction
 
   _Bool find_bound = false;
 
@@ -56,7 +131,16 @@ void Godunov_solver_LAG_source(const int m, struct cell_var_stru CV, double * X[
   double time_c = 0.0; // the current time
   double C_m = 1.01; // a multiplicative coefficient allows the time step to increase.
   _Bool stop_t = false;
-  int nt = 0; // the number of times storing plotting data
+  int data_err; // whether there is miscalculation in the parallel loops
+  int nt = 0, nt_plot = 0; // the number of times storing plotting data
+  int nt_w; // the level written by the time step, the next one after a plotting time
+  _Bool const stream = (_Bool)ctx->conf[34]; // streaming output of the plotting data
+  _Bool const warm   = (_Bool)ctx->conf[35]; // warm start of the exact Riemann solver
+  int n_it; // the number of Newton iterations of a Riemann solver
+  long n_it_sum = 0, n_solve = 0; // the total numbers of Newton iterations and Riemann solvers
+  int    const n_ckpt  = (int)ctx->conf[43];   // the number of time steps between the checkpoints
+  _Bool  const restart = (_Bool)ctx->conf[44]; // restart from the checkpoint
+  struct ckpt_var ckpt = {0}; // the checkpoint of the state of the time loop
 
   struct b_f_var bfv_L = {.H = h}, bfv_R = bfv_L; // Left/Right boundary condition
   struct i_f_var ifv_L = {.gamma = gamma}, ifv_R = ifv_L;
@@ -68,106 +152,112 @@ void Godunov_solver_LAG_source(const int m, struct cell_var_stru CV, double * X[
   double * U_F  = (double*)malloc((m+1) * sizeof(double));
   double * P_F  = (double*)malloc((m+1) * sizeof(double));
   double * MASS = (double*)malloc(m * sizeof(double)); // Array of the mass data in computational cells.
-  if(U_F == NULL || P_F == NULL || MASS == NULL)
+  double * R_MASS = (double*)malloc(m * sizeof(double)); // Array of the reciprocals of MASS.
+  _Bool uniform; // whether the grids are of uniform mass
+  int * if_err  = (int*)malloc((m+1) * sizeof(int)); // the miscalculation indicators at (x_{j-1/2}, t_{n}).
+  if(U_F == NULL || P_F == NULL || MASS == NULL || R_MASS == NULL || if_err == NULL)
       {
 	  printf("NOT enough memory! Variables_F or MASS\n");
 	  goto return_NULL;
       }
   for(k = 0; k < m; ++k) // Initialize the values of mass in computational cells
       MASS[k] = h * RHO[0][k];
+  for(k = 0; k <= m; ++k) // No star pressure of the last time step at the beginning.
+      P_F[k] = 0.0;
   
+  if(n_ckpt > 0 || restart) // the state of the time loop
+      {
+	  if(checkpoint_init(ctx, &ckpt, problem))
+	      goto return_NULL;
+	  checkpoint_add(&ckpt, &k,            sizeof(k));
+	  checkpoint_add(&ckpt, &time_c,       sizeof(time_c));
+	  checkpoint_add(&ckpt, &tau,          sizeof(tau));
+	  checkpoint_add(&ckpt, &tau_cfl,      sizeof(tau_cfl));
+	  checkpoint_add(&ckpt, &nt,           sizeof(nt));
+	  checkpoint_add(&ckpt, &nt_plot,      sizeof(nt_plot));
+	  checkpoint_add(&ckpt, &find_bound,   sizeof(find_bound));
+	  checkpoint_add(&ckpt, &cpu_time_sum, sizeof(cpu_time_sum));
+	  checkpoint_add(&ckpt, &n_it_sum,     sizeof(n_it_sum));
+	  checkpoint_add(&ckpt, &n_solve,      sizeof(n_solve));
+	  checkpoint_add(&ckpt, &bfv_L,        sizeof(bfv_L));
+	  checkpoint_add(&ckpt, &bfv_R,        sizeof(bfv_R));
+	  checkpoint_add(&ckpt, cpu_time, N_T * sizeof(double));
+	  checkpoint_add(&ckpt, MASS,     m * sizeof(double));
+	  checkpoint_add(&ckpt, P_F,      (m+1) * sizeof(double));
+	  checkpoint_add_1D(&ckpt, m, N_T, CV, X);
+	  if(restart && checkpoint_read(&ckpt))
+	      goto return_NULL;
+      }
+  uniform = true;
+  for(j = 0; j < m; ++j) // the masses are fixed on Lagrangian coordinate
+      {
+	  R_MASS[j] = 1.0 / MASS[j];
+	  uniform = uniform && MASS[j] == MASS[0];
+      }
+  uniform = halo_max_1D(!uniform) == 0; // the same kernel for all the parts
+
 //-----------------------THE MAIN LOOP--------------------------------
-  for(k = 1; k <= N; ++k)
+  for(k = restart ? k+1 : 1; k <= N; ++k) // Go on from the time step after the checkpoint.
   {
-      tic = clock();
-      if (time_c >= time_plot[nt] && nt < (*N_plot-1))
+      tic = wall_time();
+      nt_w = nt;
+      if (time_c >= time_plot[nt_plot] - eps && nt_plot < (*N_plot-1))
 	  {
-	      for(j = 0; j < m; ++j)
+	      if(stream)
 		  {
-		      RHO[nt+1][j] = RHO[nt][j];
-		      U[nt+1][j]   =   U[nt][j];
-		      E[nt+1][j]   =   E[nt][j];  
-		      P[nt+1][j]   =   P[nt][j];
-		      X[nt+1][j]   =   X[nt][j];
+		      PHASE_TIC(PT_IO);
+		      file_1D_write_stream(ctx, m, nt_plot, CV, nt, X[nt], NULL, problem, time_plot[nt_plot]);
+		      PHASE_TOC(PT_IO);
 		  }
-	      X[nt+1][m] = X[nt][m];
-	      nt++;
+	      nt_plot++;
+	      if (nt < (N_T-1)) // The next step writes the next level from this one, which is kept for the plot.
+		  nt_w = nt+1;
 	  }
 
       h_S_max = INFINITY; // h/S_max = INFINITY
 
-      find_bound = bound_cond_slope_limiter(true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, false, time_c, X[nt]);
+      find_bound = bound_cond_slope_limiter(ctx, true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, false, time_c, X[nt]);
       if(!find_bound)
 	  goto return_NULL;
 
-      for(j = 0; j <= m; ++j)
-	  { /*
-	     *  j-1          j          j+1
-	     * j-1/2  j-1  j+1/2   j   j+3/2  j+1
-	     *   o-----X-----o-----X-----o-----X--...
-	     */
-	      if(j) // Initialize the initial values.
-		  {
-		      h_L       =   X[nt][j] - X[nt][j-1];
-		      ifv_L.RHO = RHO[nt][j-1];
-		      ifv_L.U   =   U[nt][j-1];
-		      ifv_L.P   =   P[nt][j-1];
-		  }
-	      else
-		  {
-		      h_L       = bfv_L.H;
-		      ifv_L.RHO = bfv_L.RHO;
-		      ifv_L.U   = bfv_L.U;
-		      ifv_L.P   = bfv_L.P;
-		  }
-	      if(j < m)
-		  {
-		      h_R       =   X[nt][j+1] - X[nt][j];
-		      ifv_R.RHO = RHO[nt][j];
-		      ifv_R.U   =   U[nt][j];
-		      ifv_R.P   =   P[nt][j];
-		  }
-	      else
-		  {
-		      h_R       = bfv_R.H;
-		      ifv_R.RHO = bfv_R.RHO;
-		      ifv_R.U   = bfv_R.U;
-		      ifv_R.P   = bfv_R.P;
-		  }
-
-	      c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);
-	      c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);
-	      h_S_max = fmin(h_S_max, h_L/c_L);
-	      h_S_max = fmin(h_S_max, h_R/c_R);
-	      if ((bound == -2 || bound == -24) && j == 0) // reflective boundary conditions
-		  h_S_max = fmin(h_S_max, h_L/(fabs(ifv_L.U)+c_L));
-	      if (bound == -2 && j == m)
-		  h_S_max = fmin(h_S_max, h_R/(fabs(ifv_R.U)+c_R));
-
-//========================Solve Riemann Problem========================
-
-	      Riemann_solver_exact_single(&u_star, &p_star, gamma, ifv_L.U, ifv_R.U, ifv_L.P, ifv_R.P, c_L, c_R, CRW, eps, eps, 500);
-
-	      if(p_star < eps)
-		  {
-		      printf("<0.0 error on [%d, %d] (t_n, x) - STAR\n", k, j);
-		      stop_t = true;
-		  }
-	      if(!isfinite(p_star)|| !isfinite(u_star))
-		  {
-		      printf("NAN or INFinite error on [%d, %d] (t_n, x) - STAR\n", k, j); 
-		      stop_t = true;
-		  }
-
-	      U_F[j] = u_star;
-	      P_F[j] = p_star;
+      PHASE_TIC(PT_SOLVE);
+      data_err = 0;
+#pragma omp parallel private(j, c_L, c_R, h_L, h_R, CRW, u_star, p_star, n_it) firstprivate(ifv_L, ifv_R) reduction(min:h_S_max) reduction(|:data_err) reduction(+:n_it_sum)
+      {
+#pragma omp for nowait
+	  for(j = 1; j < m; ++j)
+	      LAG_IFACE_RIEMANN(0, 0);
+#pragma omp single nowait
+	  { // the boundary interfaces peeled out of the loop
+	      j = 0;
+	      LAG_IFACE_RIEMANN(1, 0);
+	      j = m;
+	      LAG_IFACE_RIEMANN(0, 1);
 	  }
+      }
+      if(data_err) // Report the miscalculation in order of the interfaces.
+	  for(j = 0; j <= m; ++j)
+	      {
+		  if(if_err[j] & 1)
+		      {
+			  printf("<0.0 error on [%d, %d] (t_n, x) - STAR\n", k, j);
+			  stop_t = true;
+		      }
+		  if(if_err[j] & 2)
+		      {
+			  printf("NAN or INFinite error on [%d, %d] (t_n, x) - STAR\n", k, j); 
+			  stop_t = true;
+		      }
+	      }
+      n_solve += m+1;
+      PHASE_TOC(PT_SOLVE);
 
 //====================Time step and grid movement======================
+    PHASE_TIC(PT_CFL);
     // If no total time, use fixed tau and time step N.
-    if(isfinite(t_all) || !isfinite(config[16]) || config[16] <= 0.0)
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
 	{
-	    tau = fmin(CFL * h_S_max, C_m * tau);
+	    tau = tau_cfl = fmin(CFL * h_S_max, C_m * tau_cfl);
 	    if(tau < eps)
 		{
 		    printf("\nThe length of the time step is so small on [%d, %g, %g] (t_n, time_c, tau)\n", k, time_c, tau);
@@ -180,64 +270,94 @@ void Godunov_solver_LAG_source(const int m, struct cell_var_stru CV, double * X[
 		    printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, tau) - CFL\n", k, time_c, tau); 
 		    goto return_NULL;
 		}
+	    else if(nt_plot < (*N_plot-1) && (time_c + tau) > (time_plot[nt_plot] - eps))
+		tau = time_plot[nt_plot] - time_c; // The step lands on the plotting time.
 	}
-    
+    PHASE_TOC(PT_CFL);
+
+    PHASE_TIC(PT_FLUX);
+#pragma omp parallel for
     for(j = 0; j <= m; ++j)
-	X[nt][j] += tau * U_F[j]; // motion along the contact discontinuity
+	X[nt_w][j] = X[nt][j] + tau * U_F[j]; // motion along the contact discontinuity
+    PHASE_TOC(PT_FLUX);
 
 //======================THE CORE ITERATION=========================(On Lagrangian Coordinate)
-    for(j = 0; j < m; ++j) // forward Euler
-	{ /*
-	   *  j-1          j          j+1
-	   * j-1/2  j-1  j+1/2   j   j+3/2  j+1
-	   *   o-----X-----o-----X-----o-----X--...
-	   */
-	    RHO[nt][j] = 1.0 / (1.0/RHO[nt][j] + tau/MASS[j]*(U_F[j+1] - U_F[j]));
-	    U[nt][j]   = U[nt][j] - tau/MASS[j]*(P_F[j+1] - P_F[j]);
-	    E[nt][j]   = E[nt][j] - tau/MASS[j]*(P_F[j+1]*U_F[j+1] - P_F[j]*U_F[j]);
-	    P[nt][j]   = (E[nt][j] - 0.5 * U[nt][j]*U[nt][j]) * (gamma - 1.0) * RHO[nt][j];
+    PHASE_TIC(PT_UPDATE);
+    data_err = 0;
+    if(uniform)
+	{
+	    double const dt_m = tau * R_MASS[0];
+#pragma omp parallel for simd reduction(|:data_err)
+	    for(j = 0; j < m; ++j) // forward Euler, no slope
+		data_err |= LAG_update_cell(j, dt_m, gamma, eps, RHO[nt], U[nt], E[nt],
+					    RHO[nt_w], U[nt_w], P[nt_w], E[nt_w], X[nt_w], U_F, P_F,
+					    NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	}
+    else
+#pragma omp parallel for simd reduction(|:data_err)
+	for(j = 0; j < m; ++j) // forward Euler, no slope
+	    data_err |= LAG_update_cell(j, tau * R_MASS[j], gamma, eps, RHO[nt], U[nt], E[nt],
+					RHO[nt_w], U[nt_w], P[nt_w], E[nt_w], X[nt_w], U_F, P_F,
+					NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    nt = nt_w;
+    if(data_err) // Report the miscalculation in order of the cells.
+	for(j = 0; j < m; ++j)
 	    if(P[nt][j] < eps || RHO[nt][j] < eps)
 		{
 		    printf("<0.0 error on [%d, %d] (t_n, x) - Update\n", k, j);
 		    stop_t = true;
 		}
-	}
+    PHASE_TOC(PT_UPDATE);
 
 //============================Time update=======================
 
     time_c += tau;
     if(isfinite(t_all))
-        DispPro(time_c*100.0/t_all, k);
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
     else
-        DispPro(k*100.0/N, k);
+        telemetry_step(k*100.0/N, k, time_c, tau);
+    file_1D_publish(ctx, m, k, CV, nt, X[nt], time_c);
     if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
 	break;
 
 //===========================Fixed variable location=======================
 
-    toc = clock();
-    cpu_time_sum += ((double)toc - (double)tic) / (double)CLOCKS_PER_SEC;
+    toc = wall_time();
+    cpu_time_sum += toc - tic;
     cpu_time[nt]  = cpu_time_sum;
+    if(n_ckpt > 0 && k % n_ckpt == 0)
+	{
+	    PHASE_TIC(PT_IO);
+	    checkpoint_write(&ckpt);
+	    PHASE_TOC(PT_IO);
+	}
   }
 
   printf("\nTime is up at time step %d.\n", k);
-  printf("The cost of CPU time for 1D-Godunov Lagrangian scheme for this problem is %g seconds.\n", cpu_time_sum);
+  printf("The cost of wall-clock time for 1D-Godunov Lagrangian scheme for this problem is %g seconds.\n", cpu_time_sum);
+  if(n_solve)
+      printf("The average number of Newton iterations per Riemann solver is %g.\n", (double)n_it_sum/(double)n_solve);
 //---------------------END OF THE MAIN LOOP----------------------
 
 return_NULL:
-  config[5] = (double)k;
-  *N_plot = nt+1;
+  ctx->conf[5] = (double)k;
+  *N_plot = nt_plot+1;
   if(isfinite(time_c))
-      time_plot[nt] = time_c;
+      time_plot[nt_plot] = time_c;
   else if(isfinite(t_all))
-      time_plot[nt] = t_all;
+      time_plot[nt_plot] = t_all;
   else if(isfinite(tau))
-      time_plot[nt] = k*tau;
+      time_plot[nt_plot] = k*tau;
 
   free(U_F);
   free(P_F);
   U_F = NULL;
   P_F = NULL;
   free(MASS);
+  free(R_MASS);
   MASS = NULL;
+  R_MASS = NULL;
+  free(if_err);
+  if_err = NULL;
+  checkpoint_free(&ckpt);
 }
@@ -24,25 +24,18 @@
 
 
 /**
- * @brief M*N memory allocations to the variable 'v' in the structure cell_var_stru.
+ * @brief M*N memory allocations to the variable 'v' in the structure cell_var_stru, accounted to the subsystem 'tag'.
+ * @details The element type of 'v' is double or Real_Store.
+ *          The field is one aligned memory block with the row pointers CV->v[j].
  */
-#define INIT_MEM_2D(v, M, N)						\
+#define INIT_MEM_2D(v, M, N, tag)					\
     do {								\
-	CV->v = (double **)malloc((M) * sizeof(double *));			\
-	if(CV->v == NULL)							\
+	CV->v = field_alloc_2D((M), (N), sizeof(**CV->v), (tag), #v);	\
+	if(CV->v == NULL)						\
 	    {								\
 		printf("NOT enough memory! %s\n", #v);			\
 		goto return_NULL;					\
 	    }								\
-	for(j = 0; j < (M); ++j)					\
-	    {								\
-		CV->v[j] = (double *)malloc((N) * sizeof(double));		\
-		if(CV->v[j] == NULL)					\
-		    {							\
-			printf("NOT enough memory! %s[%d]\n", #v, j);	\
-			goto return_NULL;				\
-		    }							\
-	    }								\
     } while (0)
 
 /**
@@ -58,9 +51,198 @@
 	    }						\
     } while (0)
 
+/**
+ * @brief This function updates the cell (j, i) by the fluxes through its interfaces,
+ *        and then its slopes by the variables at its interfaces.
+ * @param[out] h_S:   h/S of the updated cell, S is its character speed.
+ * @param[out] d_rho: Change of the density of the updated cell.
+ * @param[out] d_e:   Change of the total energy (ρE) of the updated cell.
+ * @return Whether the density or the pressure of the updated cell is negative.
+ */
+ACC_ROUTINE_SEQ
+static inline _Bool GRP_2D_update_cell(struct cell_var_stru * CV, const int nt, const int j, const int i, const double nu, const double mu,
+				       const double gamma, const double eps, const double h_x, const double h_y, double * h_S,
+				       double * d_rho, double * d_e)
+{ /*
+   *  j-1          j          j+1
+   * j-1/2  j-1  j+1/2   j   j+3/2  j+1
+   *   o-----X-----o-----X-----o-----X--...
+   */
+    _Bool err = false;
+    double const mom_x = CV[nt].RHO[j][i]*CV[nt].U[j][i] - nu*(CV->F_u[j+1][i]  -CV->F_u[j][i])   - mu*(CV->G_u[j][i+1]  -CV->G_u[j][i]);
+    double const mom_y = CV[nt].RHO[j][i]*CV[nt].V[j][i] - nu*(CV->F_v[j+1][i]  -CV->F_v[j][i])   - mu*(CV->G_v[j][i+1]  -CV->G_v[j][i]);
+    double const ene   = CV[nt].RHO[j][i]*CV[nt].E[j][i] - nu*(CV->F_e[j+1][i]  -CV->F_e[j][i])   - mu*(CV->G_e[j][i+1]  -CV->G_e[j][i]);
+    *d_rho = - nu*(CV->F_rho[j+1][i]-CV->F_rho[j][i]) - mu*(CV->G_rho[j][i+1]-CV->G_rho[j][i]);
+    *d_e   = - nu*(CV->F_e[j+1][i]  -CV->F_e[j][i])   - mu*(CV->G_e[j][i+1]  -CV->G_e[j][i]);
+    CV[nt].RHO[j][i] += *d_rho;
+
+    CV[nt].U[j][i] = mom_x / CV[nt].RHO[j][i];
+    CV[nt].V[j][i] = mom_y / CV[nt].RHO[j][i];
+    CV[nt].E[j][i] = ene   / CV[nt].RHO[j][i];
+    CV[nt].P[j][i] = (ene - 0.5*mom_x*CV[nt].U[j][i] - 0.5*mom_y*CV[nt].V[j][i])*(gamma-1.0);
+    if(CV[nt].P[j][i] < eps || CV[nt].RHO[j][i] < eps)
+	err = true;
+    double const c = sqrt(gamma * CV[nt].P[j][i] / CV[nt].RHO[j][i]);
+    *h_S = fmin(h_x,h_y) / (fabs(c) + fabs(CV[nt].U[j][i]) + fabs(CV[nt].V[j][i]));
+
+    CV->s_rho[j][i] = ((double)CV->rhoIx[j+1][i] - CV->rhoIx[j][i])/h_x;
+    CV->s_u[j][i]   = ((double)  CV->uIx[j+1][i] -   CV->uIx[j][i])/h_x;
+    CV->s_v[j][i]   = ((double)  CV->vIx[j+1][i] -   CV->vIx[j][i])/h_x;
+    CV->s_p[j][i]   = ((double)  CV->pIx[j+1][i] -   CV->pIx[j][i])/h_x;
+    CV->t_rho[j][i] = ((double)CV->rhoIy[j][i+1] - CV->rhoIy[j][i])/h_y;
+    CV->t_u[j][i]   = ((double)  CV->uIy[j][i+1] -   CV->uIy[j][i])/h_y;
+    CV->t_v[j][i]   = ((double)  CV->vIy[j][i+1] -   CV->vIy[j][i])/h_y;
+    CV->t_p[j][i]   = ((double)  CV->pIy[j][i+1] -   CV->pIy[j][i])/h_y;
+    return err;
+}
+
+//! A tile of the columns in the task-pipelined time steps.
+struct step_tile {
+	struct flux_err_rec fe_x, fe_y; //!< the first miscalculations of the x- and y-fluxes of the tile.
+	double h_S_max; //!< h/S_max of the updated cells of the tile.
+	_Bool stop_t;   //!< whether an updated cell of the tile is negative.
+	double res[SS_NUM]; //!< residuals of the updated cells of the tile (steady_state_check()).
+	char slope, flux, edge; //!< the dependences of the tasks of the slopes, the fluxes and the edge (the first and the last tiles).
+};
+
+/**
+ * @brief This function runs the slopes, the fluxes and the updates of a time step of GRP_solver_2D_EUL_source()
+ *        as the OpenMP tasks of the tiles of the columns, which are pipelined by their dependences
+ *        instead of the barriers between the phases.
+ * @details The tasks of the tile t of the columns j0 <= j < j1 are:
+ *          - slope(t):  limits the x- and y-slopes of its columns;
+ *          - edge:      sets the slopes of the ghost cells at the left/right boundary after slope(0) and slope(T-1);
+ *          - flux(t):   calculates the fluxes at its x-interfaces (and the x-interface m of the last tile)
+ *                       after slope(t-1) and slope(t) (and edge for the first and the last tiles),
+ *                       and at the y-interfaces of its columns;
+ *          - update(t): updates its cells after flux(t) and flux(t+1), which read the cells of the tile.
+ *          So the fluxes of a tile are calculated while the slopes of the next tiles are limited,
+ *          and the results are those of the phases separated by the barriers, bit for bit.
+ *          The boundary conditions have been set by bound_cond_slope_limiter_x/y() without slopes.
+ * @param[in] T:  Number of the tiles.
+ * @param[in] b_t: Number of the columns of a tile.
+ * @param[in,out] tile: Array of the T tiles.
+ * @param[out] h_S_max: h/S_max of the updated cells.
+ * @param[out] stop_t: Whether an updated cell is negative.
+ * @param[out] res:    Residuals of the updated cells (steady_state_check()).
+ * @return miscalculation indicator of the fluxes of flux_generator_x/y().
+ */
+static int GRP_2D_step_tasks(const struct run_ctx * ctx, const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
+			     struct b_f_var * bfv_L, struct b_f_var * bfv_R, struct b_f_var * bfv_D, struct b_f_var * bfv_U,
+			     const _Bool find_bound_x, const _Bool find_bound_y, const int k, const int T, const int b_t,
+			     struct step_tile * tile, double * h_S_max, _Bool * stop_t, double res[SS_NUM])
+{
+    double const eps   = ctx->conf[4];  // the largest value could be seen as zero
+    double const gamma = ctx->conf[6];  // the constant of the perfect gas
+    double const h_x   = ctx->conf[10]; // the length of the initial x-spatial grids
+    double const h_y   = ctx->conf[11]; // the length of the initial y-spatial grids
+    double const nu = tau / h_x, mu = tau / h_y;
+    struct flux_err_rec fe_x = {0}, fe_y = {0};
+    int t, t_L, t_R, err_x, err_y; // the tiles on the left/right of the tile t
+
+    for(t = 0; t < T; ++t)
+	{
+	    tile[t] = (struct step_tile){.h_S_max = INFINITY};
+	}
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+    {
+	for(t = 0; t < T; ++t)
+	    {
+#ifdef _OPENMP
+#pragma omp task firstprivate(t) depend(out: tile[t].slope)
+#endif
+		{
+		    const int j0 = t*b_t, j1 = MIN(j0 + b_t, m);
+		    PHASE_SPAN_BEGIN(t_span);
+		    slope_limiter_x_tile(ctx, m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U, find_bound_x, j0, j1);
+		    slope_limiter_y_tile(ctx, n, nt, CV, bfv_D, bfv_U, find_bound_y, j0, j1);
+		    PHASE_SPAN_END(PT_SLOPE, t_span);
+		}
+	    }
+#ifdef _OPENMP
+#pragma omp task depend(in: tile[0].slope, tile[T-1].slope) depend(out: tile[0].edge, tile[T-1].edge)
+#endif
+	{
+	    slope_bound_x_edge(ctx, m, n, CV, bfv_L, bfv_R);
+	    slope_bound_y_edge(ctx, m, n, CV, bfv_L, bfv_R);
+	}
+	for(t = 0; t <= T; ++t)
+	    {
+		t_L = t ? t-1 : t;
+		t_R = t < T ? t : t-1;
+		if(t < T)
+		    {
+#ifdef _OPENMP
+#pragma omp task firstprivate(t) depend(in: tile[t_L].slope, tile[t].slope, tile[t].edge) depend(out: tile[t].flux)
+#endif
+			{
+			    const int j0 = t*b_t, j1 = MIN(j0 + b_t, m);
+			    PHASE_SPAN_BEGIN(t_x);
+			    flux_generator_x_tile(ctx, m, n, nt, tau, CV, bfv_L, bfv_R, true, j0, t == T-1 ? m+1 : j1, &tile[t].fe_x);
+			    PHASE_SPAN_END(TR_FLUX_X, t_x);
+			    PHASE_SPAN_BEGIN(t_y);
+			    flux_generator_y_tile(ctx, m, n, nt, tau, CV, bfv_D, bfv_U, true, j0, j1, &tile[t].fe_y);
+			    PHASE_SPAN_END(TR_FLUX_Y, t_y);
+			}
+		    }
+		if(t)
+		    {
+#ifdef _OPENMP
+#pragma omp task firstprivate(t) depend(in: tile[t_L].flux, tile[t_R].flux)
+#endif
+			{
+			    const int j0 = (t-1)*b_t, j1 = MIN(j0 + b_t, m);
+			    struct step_tile * tl = tile + t-1;
+			    double h_S, d_rho, d_e;
+			    int i, j;
+			    PHASE_SPAN_BEGIN(t_span);
+			    for(j = j0; j < j1; ++j)
+				for(i = 0; i < n; ++i)
+				    {
+					if(GRP_2D_update_cell(CV, nt, j, i, nu, mu, gamma, eps, h_x, h_y, &h_S, &d_rho, &d_e))
+					    {
+						printf("<0.0 error on [%d, %d, %d] (t_n, x, y) - Update\n", k, j, i);
+						tl->stop_t = true;
+					    }
+					tl->h_S_max = fmin(tl->h_S_max, h_S);
+					tl->res[SS_L1_RHO] += fabs(d_rho);
+					tl->res[SS_L1_E]   += fabs(d_e);
+					tl->res[SS_LI_RHO]  = fmax(tl->res[SS_LI_RHO], fabs(d_rho));
+					tl->res[SS_LI_E]    = fmax(tl->res[SS_LI_E],   fabs(d_e));
+				    }
+			    PHASE_SPAN_END(PT_UPDATE, t_span);
+			}
+		    }
+	    }
+    } // End of parallel region
+
+    *h_S_max = INFINITY;
+    res[SS_L1_RHO] = res[SS_L1_E] = res[SS_LI_RHO] = res[SS_LI_E] = 0.0;
+    for(t = 0; t < T; ++t)
+	{
+	    res[SS_L1_RHO] += tile[t].res[SS_L1_RHO];
+	    res[SS_L1_E]   += tile[t].res[SS_L1_E];
+	    res[SS_LI_RHO]  = fmax(res[SS_LI_RHO], tile[t].res[SS_LI_RHO]);
+	    res[SS_LI_E]    = fmax(res[SS_LI_E],   tile[t].res[SS_LI_E]);
+	    flux_err_merge(&fe_x, &tile[t].fe_x);
+	    flux_err_merge(&fe_y, &tile[t].fe_y);
+	    *h_S_max = fmin(*h_S_max, tile[t].h_S_max);
+	    *stop_t  = *stop_t || tile[t].stop_t;
+	}
+    err_x = flux_err_report(&fe_x, nt, 'x');
+    if(err_x == 1)
+	return err_x;
+    err_y = flux_err_report(&fe_y, nt, 'y');
+    return err_y ? err_y : err_x;
+}
+
 /**
  * @brief This function use GRP scheme to solve 2-D Euler
  *        equations of motion on Eulerian coordinate without dimension splitting.
+ * @param[in,out] ctx:    Pointer to the run context.
  * @param[in] m:          Number of the x-grids: n_x.
  * @param[in] n:          Number of the y-grids: n_y.
  * @param[in,out] CV:     Structure of cell variable data.
@@ -72,7 +254,7 @@
  * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
  * @param[in,out] time_plot: Array of the plotting time recording.
  */
-void GRP_solver_2D_EUL_source(const int m, const int n, struct cell_var_stru * CV, double ** X, double **Y, 
+void GRP_solver_2D_EUL_source(struct run_ctx * ctx, const int m, const int n, struct cell_var_stru * CV, double ** X, double **Y, 
 			      double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[])
 {
 #ifdef _OPENMP
@@ -88,78 +270,167 @@ void GRP_solver_2D_EUL_source(const int m, const int n, struct cell_var_stru * C
      * k is a frequently used index for the time step.
      */
   int i, j, k = 0;
+  int i_t, j_t; // the first cells of a tile
 
   double tic, toc;
   double cpu_time_sum = 0.0;
 
-  double const t_all     = config[1];      // the total time
-  double const eps       = config[4];      // the largest value could be seen as zero
-  int    const N         = (int)config[5]; // the maximum number of time steps
-  double const gamma     = config[6];      // the constant of the perfect gas
-  double const CFL       = config[7];      // the CFL number
-  double const h_x       = config[10];     // the length of the initial x-spatial grids
-  double const h_y       = config[11];     // the length of the initial y-spatial grids
-  double       tau       = config[16];     // the length of the time step
+  double const t_all     = ctx->conf[1];      // the total time
+  double const eps       = ctx->conf[4];      // the largest value could be seen as zero
+  int    const N         = (int)ctx->conf[5]; // the maximum number of time steps
+  double const gamma     = ctx->conf[6];      // the constant of the perfect gas
+  double const CFL       = ctx->conf[7];      // the CFL number
+  double const h_x       = ctx->conf[10];     // the length of the initial x-spatial grids
+  double const h_y       = ctx->conf[11];     // the length of the initial y-spatial grids
+  double       tau       = ctx->conf[16];     // the length of the time step
+#ifdef _OPENACC
+  int    const b_y = 1, b_x = 1; // one cell in a tile, the device threads run over the cells.
+#else
+  int    const b_y       = MAX((int)ctx->conf[49], 1); // the tile lengths along y and x
+  int    const b_x       = MAX((int)ctx->conf[50], 1);
+#endif
+#ifdef _OPENACC
+  int    const b_t = 0; // the phases separated by the barriers on the device
+#else
+  int    const b_t = halo_size_2D() == 1 ? MAX((int)ctx->conf[68], 0) : 0; // the columns of the tiles of the task-pipelined time steps
+#endif
+  int    const T_t = b_t ? (m + b_t - 1) / b_t : 0; // the number of the tiles of the task-pipelined time steps
+  struct step_tile * tile = NULL;
 
   _Bool find_bound_x = false, find_bound_y = false;
   int flux_err;
 
-  double mom_x, mom_y, ene;
   double c; // the speeds of sound
 
   double mu, nu;  // nu = tau/h_x, mu = tau/h_y.
-  double h_S_max, sigma; // h/S_max, S_max is the maximum character speed, sigma is the character speed
-  double time_c = 0.0; // the current time
+  double h_S_max, h_S, sigma; // h/S_max, S_max is the maximum character speed, h/S of a cell, sigma is the character speed
+  double time_c = ctx->conf[79]; // the current time (the start time of a warm start)
   _Bool stop_t = false;
   int nt = 0, nt_plot = 0; // the number of times storing plotting data
+  int n_out; // the index of the last plotting data
+  _Bool  const stream  = (_Bool)ctx->conf[34]; // streaming output of the plotting data
+  int    const n_ckpt  = (int)ctx->conf[43];   // the number of time steps between the checkpoints
+  _Bool  const restart = (_Bool)ctx->conf[44]; // restart from the checkpoint
+  _Bool  const mem_report = (_Bool)ctx->conf[64]; // memory report at the plotting times
+  char mem_title[64];
+  struct ckpt_var ckpt = {0}; // the checkpoint of the state of the time loop
+  struct steady_state ss; // the monitor of the residuals of the steady state
+  double res[SS_NUM], d_rho, d_e; // the residuals and the changes of the density and the energy of a cell
+  double r1_rho, r1_e, ri_rho, ri_e; // the L1 and L∞ residuals reduced in the update loop
+#ifndef _OPENACC
+  _Bool const repro = (int)ctx->conf[77] > 0; // the exact L1 residuals independent of the number of the threads
+  struct repro_sum s1_rho, s1_e;
+#endif
+  _Bool steady = false;
+  steady_state_init(&ss, ctx->conf[73]);
+  _Bool on_device = false; // whether the fields are entered into the device memory
   
   // Left/Right/Upper/Downside boundary condition
   struct b_f_var * bfv_L = NULL, * bfv_R = NULL, * bfv_U = NULL, * bfv_D = NULL;
   // the slopes of variable values.
-  INIT_MEM_2D(s_rho, m, n); INIT_MEM_2D(t_rho, m, n);
-  INIT_MEM_2D(s_u,   m, n); INIT_MEM_2D(t_u,   m, n);
-  INIT_MEM_2D(s_v,   m, n); INIT_MEM_2D(t_v,   m, n);
-  INIT_MEM_2D(s_p,   m, n); INIT_MEM_2D(t_p,   m, n);
+  INIT_MEM_2D(s_rho, m, n, MA_SLOPE); INIT_MEM_2D(t_rho, m, n, MA_SLOPE);
+  INIT_MEM_2D(s_u,   m, n, MA_SLOPE); INIT_MEM_2D(t_u,   m, n, MA_SLOPE);
+  INIT_MEM_2D(s_v,   m, n, MA_SLOPE); INIT_MEM_2D(t_v,   m, n, MA_SLOPE);
+  INIT_MEM_2D(s_p,   m, n, MA_SLOPE); INIT_MEM_2D(t_p,   m, n, MA_SLOPE);
   // the variable values at (x_{j-1/2}, t_{n+1}).
-  INIT_MEM_2D(rhoIx, m+1, n);
-  INIT_MEM_2D(uIx,   m+1, n);
-  INIT_MEM_2D(vIx,   m+1, n);
-  INIT_MEM_2D(pIx,   m+1, n);
-  INIT_MEM_2D(F_rho, m+1, n);
-  INIT_MEM_2D(F_u,   m+1, n);
-  INIT_MEM_2D(F_v,   m+1, n);
-  INIT_MEM_2D(F_e,   m+1, n); 
+  INIT_MEM_2D(rhoIx, m+1, n, MA_INTERFACE);
+  INIT_MEM_2D(uIx,   m+1, n, MA_INTERFACE);
+  INIT_MEM_2D(vIx,   m+1, n, MA_INTERFACE);
+  INIT_MEM_2D(pIx,   m+1, n, MA_INTERFACE);
+  INIT_MEM_2D(F_rho, m+1, n, MA_FLUX);
+  INIT_MEM_2D(F_u,   m+1, n, MA_FLUX);
+  INIT_MEM_2D(F_v,   m+1, n, MA_FLUX);
+  INIT_MEM_2D(F_e,   m+1, n, MA_FLUX); 
   // the variable values at (y_{j-1/2}, t_{n+1}).
-  INIT_MEM_2D(rhoIy, m, n+1);
-  INIT_MEM_2D(uIy,   m, n+1);
-  INIT_MEM_2D(vIy,   m, n+1);
-  INIT_MEM_2D(pIy,   m, n+1);
-  INIT_MEM_2D(G_rho, m, n+1);
-  INIT_MEM_2D(G_u,   m, n+1);
-  INIT_MEM_2D(G_v,   m, n+1);
-  INIT_MEM_2D(G_e,   m, n+1);
+  INIT_MEM_2D(rhoIy, m, n+1, MA_INTERFACE);
+  INIT_MEM_2D(uIy,   m, n+1, MA_INTERFACE);
+  INIT_MEM_2D(vIy,   m, n+1, MA_INTERFACE);
+  INIT_MEM_2D(pIy,   m, n+1, MA_INTERFACE);
+  INIT_MEM_2D(G_rho, m, n+1, MA_FLUX);
+  INIT_MEM_2D(G_u,   m, n+1, MA_FLUX);
+  INIT_MEM_2D(G_v,   m, n+1, MA_FLUX);
+  INIT_MEM_2D(G_e,   m, n+1, MA_FLUX);
   // boundary condition
   BC_INIT_MEM_1D(bfv_L, n); BC_INIT_MEM_1D(bfv_R, n);
   BC_INIT_MEM_1D(bfv_D, m); BC_INIT_MEM_1D(bfv_U, m);
+  if(T_t)
+      {
+	  tile = (struct step_tile *)malloc(T_t * sizeof(struct step_tile));
+	  if(tile == NULL)
+	      {
+		  printf("NOT enough memory! tile\n");
+		  goto return_NULL;
+	      }
+	  printf("The time steps are pipelined in %d tiles of %d columns.\n", T_t, b_t);
+      }
+
+  if(n_ckpt > 0 || restart) // the state of the time loop
+      {
+	  if(checkpoint_init(ctx, &ckpt, problem))
+	      goto return_NULL;
+	  checkpoint_add(&ckpt, &k,            sizeof(k));
+	  checkpoint_add(&ckpt, &time_c,       sizeof(time_c));
+	  checkpoint_add(&ckpt, &tau,          sizeof(tau));
+	  checkpoint_add(&ckpt, &nt,           sizeof(nt));
+	  checkpoint_add(&ckpt, &nt_plot,      sizeof(nt_plot));
+	  checkpoint_add(&ckpt, &find_bound_x, sizeof(find_bound_x));
+	  checkpoint_add(&ckpt, &find_bound_y, sizeof(find_bound_y));
+	  checkpoint_add(&ckpt, &cpu_time_sum, sizeof(cpu_time_sum));
+	  checkpoint_add(&ckpt, &ss,           sizeof(ss));
+	  checkpoint_add(&ckpt, cpu_time, N_T * sizeof(double));
+	  checkpoint_add(&ckpt, bfv_L, n * sizeof(struct b_f_var));
+	  checkpoint_add(&ckpt, bfv_R, n * sizeof(struct b_f_var));
+	  checkpoint_add(&ckpt, bfv_D, m * sizeof(struct b_f_var));
+	  checkpoint_add(&ckpt, bfv_U, m * sizeof(struct b_f_var));
+	  checkpoint_add_2D(&ckpt, m, n, N_T, CV);
+	  if(restart && checkpoint_read(&ckpt))
+	      goto return_NULL;
+      }
+  device_data_enter_2D(ctx, m, n, N_T, CV, bfv_L, bfv_R, bfv_D, bfv_U);
+  on_device = true;
+
+  /* The character speeds of the initial data (or of the checkpoint) decide the first time step,
+   * and those of the updated cells decide the next time steps in the core iteration.
+   */
+  h_S_max = INFINITY; // h/S_max = INFINITY
+#ifdef _OPENACC
+#pragma acc parallel loop collapse(2) private(c, sigma) reduction(min:h_S_max) default(present)
+#elif defined _OPENMP
+#pragma omp parallel for private(i, c, sigma) reduction(min:h_S_max)
+#endif
+  for(j = 0; j < m; ++j)
+      for(i = 0; i < n; ++i)
+	  {
+	      c = sqrt(gamma * CV[nt].P[j][i] / CV[nt].RHO[j][i]);
+	      sigma = fabs(c) + fabs(CV[nt].U[j][i]) + fabs(CV[nt].V[j][i]);
+	      h_S_max = fmin(h_S_max, fmin(h_x,h_y) / sigma);
+	  }
 
 //------------THE MAIN LOOP-------------
-  for(k = 1; k <= N; ++k)
+  for(k = restart ? k+1 : 1; k <= N; ++k) // Go on from the time step after the checkpoint.
   {
-#ifdef _OPENMP
-    tic = omp_get_wtime();
-#elif defined _OPENACC
-    tic = omp_get_wtime();
-#else
-    tic = (double)clock() / (double)CLOCKS_PER_SEC;
-#endif
+    tic = wall_time();
     if (time_c >= time_plot[nt_plot] && nt_plot < (*N_plot-1))
 	{
+	    device_data_update_host_2D(m, n, CV + nt);
+	    PHASE_TIC(PT_IO);
+	    if(stream)
+		file_2D_write_stream(ctx, m, n, nt_plot, CV + nt, X, Y, NULL, problem, time_plot[nt_plot]);
 #ifndef NOTECPLOT
-	    file_2D_write_POINT_TEC(m, n, 1, CV + nt, X, Y, cpu_time, problem, time_plot + nt_plot);
+	    file_2D_write_POINT_TEC(ctx, m, n, 1, CV + nt, X, Y, cpu_time, problem, time_plot + nt_plot);
 #endif
+	    PHASE_TOC(PT_IO);
+	    if(mem_report)
+		{
+		    sprintf(mem_title, "Memory at t = %g", time_plot[nt_plot]);
+		    mem_account_report(mem_title, false);
+		}
 	    nt_plot++;
 	    if (nt < (N_T-1))
 		{
+#ifdef _OPENACC
+#pragma acc parallel loop collapse(2) default(present)
+#endif
 		    for(j = 0; j < m; ++j)
 			for(i = 0; i < n; ++i)
 			    {
@@ -177,17 +448,11 @@ void GRP_solver_2D_EUL_source(const int m, const int n, struct cell_var_stru * C
      * and evaluate the character speed to decide the length
      * of the time step by (tau * speed_max)/h = CFL
      */
-    h_S_max = INFINITY; // h/S_max = INFINITY
-
-    for(j = 0; j < m; ++j)
-	for(i = 0; i < n; ++i)
-	    {
-		c = sqrt(gamma * CV->P[j][i] / CV->RHO[j][i]);
-		sigma = fabs(c) + fabs(CV->U[j][i]) + fabs(CV->V[j][i]);
-		h_S_max = fmin(h_S_max, fmin(h_x,h_y) / sigma);
-	    }
+    PHASE_TIC(PT_CFL);
+    // h_S_max of the current cells has been reduced in the update of the last time step.
+    h_S_max = halo_min_2D(h_S_max); // the CFL condition of all the blocks
     // If no total time, use fixed tau and time step N.
-    if(isfinite(t_all) || !isfinite(config[16]) || config[16] <= 0.0)
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
 	{
 	    tau = CFL * h_S_max;
 	    if(tau < eps)
@@ -205,127 +470,162 @@ void GRP_solver_2D_EUL_source(const int m, const int n, struct cell_var_stru * C
 	}
     nu = tau / h_x;
     mu = tau / h_y;
+    PHASE_TOC(PT_CFL);
 
-    find_bound_x = bound_cond_slope_limiter_x(m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U, find_bound_x, true, time_c);
+    find_bound_x = bound_cond_slope_limiter_x(ctx, m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U, find_bound_x, !b_t, time_c);
     if(!find_bound_x)
         goto return_NULL;
-    find_bound_y = bound_cond_slope_limiter_y(m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U, find_bound_y, true, time_c);
+    find_bound_y = bound_cond_slope_limiter_y(ctx, m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U, find_bound_y, !b_t, time_c);
     if(!find_bound_y)
         goto return_NULL;
 
-    flux_err = flux_generator_x(m, n, nt, tau, CV, bfv_L, bfv_R, true);
+    if(b_t) // the slopes, the fluxes and the updates of the tiles pipelined by the tasks
+	{
+	    PHASE_TIC(PT_SOLVE);
+	    flux_err = GRP_2D_step_tasks(ctx, m, n, nt, tau, CV, bfv_L, bfv_R, bfv_D, bfv_U,
+					 find_bound_x, find_bound_y, k, T_t, b_t, tile, &h_S_max, &stop_t, res);
+	    PHASE_TOC(PT_SOLVE);
+	    if(flux_err == 1)
+		goto return_NULL;
+	    else if(flux_err == 2)
+		stop_t = true;
+	}
+    else // the phases separated by the barriers
+    {
+    halo_slope_start_x(m, n, CV);
+    halo_slope_start_y(m, n, CV);
+
+    PHASE_TIC(PT_SOLVE);
+    flux_err = halo_max_2D(flux_generator_x(ctx, m, n, nt, tau, CV, bfv_L, bfv_R, true));
     if(flux_err == 1)
         goto return_NULL;
     else if(flux_err == 2)
 	stop_t = true;
-    flux_err = flux_generator_y(m, n, nt, tau, CV, bfv_D, bfv_U, true);
+    flux_err = halo_max_2D(flux_generator_y(ctx, m, n, nt, tau, CV, bfv_D, bfv_U, true));
     if(flux_err == 1)
         goto return_NULL;
     else if(flux_err == 2)
 	stop_t = true;
+    PHASE_TOC(PT_SOLVE);
 
 //===============THE CORE ITERATION=================
-#ifdef _OPENMP
-#pragma omp parallel for  private(mom_x, mom_y, ene) collapse(2)
-#elif defined _OPENACC
-#pragma acc parallel loop private(mom_x, mom_y, ene) collapse(2)
+    PHASE_TIC(PT_UPDATE);
+    /* The cells are updated tile by tile, and along y (the contiguous index i) in a tile.
+     * The character speeds of the updated cells are reduced to h_S_max for the next time step,
+     * and their changes to the residuals of the steady state.
+     */
+    h_S_max = INFINITY;
+    r1_rho = r1_e = ri_rho = ri_e = 0.0;
+#ifndef _OPENACC
+    repro_sum_init(&s1_rho);
+    repro_sum_init(&s1_e);
 #endif
-    for(i = 0; i < n; ++i)
-      for(j = 0; j < m; ++j)
-      { /*
-	 *  j-1          j          j+1
-	 * j-1/2  j-1  j+1/2   j   j+3/2  j+1
-	 *   o-----X-----o-----X-----o-----X--...
-	 */
-	  mom_x = CV[nt].RHO[j][i]*CV[nt].U[j][i] - nu*(CV->F_u[j+1][i]  -CV->F_u[j][i])   - mu*(CV->G_u[j][i+1]  -CV->G_u[j][i]);
-	  mom_y = CV[nt].RHO[j][i]*CV[nt].V[j][i] - nu*(CV->F_v[j+1][i]  -CV->F_v[j][i])   - mu*(CV->G_v[j][i+1]  -CV->G_v[j][i]);
-	  ene   = CV[nt].RHO[j][i]*CV[nt].E[j][i] - nu*(CV->F_e[j+1][i]  -CV->F_e[j][i])   - mu*(CV->G_e[j][i+1]  -CV->G_e[j][i]);
-	  CV[nt].RHO[j][i] +=                     - nu*(CV->F_rho[j+1][i]-CV->F_rho[j][i]) - mu*(CV->G_rho[j][i+1]-CV->G_rho[j][i]);
-
-	  CV[nt].U[j][i] = mom_x / CV[nt].RHO[j][i];
-	  CV[nt].V[j][i] = mom_y / CV[nt].RHO[j][i];
-	  CV[nt].E[j][i] = ene   / CV[nt].RHO[j][i];
-	  CV[nt].P[j][i] = (ene - 0.5*mom_x*CV[nt].U[j][i] - 0.5*mom_y*CV[nt].V[j][i])*(gamma-1.0);
-	  if(CV[nt].P[j][i] < eps || CV[nt].RHO[j][i] < eps)
-	      {
-		  printf("<0.0 error on [%d, %d, %d] (t_n, x, y) - Update\n", k, j, i);
-		  stop_t = true;
-	      }
-
-	  CV->s_rho[j][i] = (CV->rhoIx[j+1][i] - CV->rhoIx[j][i])/h_x;
-	  CV->s_u[j][i]   = (  CV->uIx[j+1][i] -   CV->uIx[j][i])/h_x;
-	  CV->s_v[j][i]   = (  CV->vIx[j+1][i] -   CV->vIx[j][i])/h_x;
-	  CV->s_p[j][i]   = (  CV->pIx[j+1][i] -   CV->pIx[j][i])/h_x;
-	  CV->t_rho[j][i] = (CV->rhoIy[j][i+1] - CV->rhoIy[j][i])/h_y;
-	  CV->t_u[j][i]   = (  CV->uIy[j][i+1] -   CV->uIy[j][i])/h_y;
-	  CV->t_v[j][i]   = (  CV->vIy[j][i+1] -   CV->vIy[j][i])/h_y;
-	  CV->t_p[j][i]   = (  CV->pIy[j][i+1] -   CV->pIy[j][i])/h_y;
-      } // End of parallel region
+#ifdef _OPENACC
+#pragma acc parallel loop private(i, j, h_S, d_rho, d_e) collapse(2) reduction(||:stop_t) reduction(min:h_S_max) \
+    reduction(+:r1_rho, r1_e) reduction(max:ri_rho, ri_e) default(present)
+#elif defined _OPENMP
+#pragma omp parallel for  private(i, j, h_S, d_rho, d_e) collapse(2) reduction(min:h_S_max) \
+    reduction(+:r1_rho, r1_e) reduction(max:ri_rho, ri_e) reduction(rsum:s1_rho, s1_e)
+#endif
+    for(j_t = 0; j_t < m; j_t += b_x)
+      for(i_t = 0; i_t < n; i_t += b_y)
+	for(j = j_t; j < MIN(j_t + b_x, m); ++j)
+	  for(i = i_t; i < MIN(i_t + b_y, n); ++i)
+	    {
+		if(GRP_2D_update_cell(CV, nt, j, i, nu, mu, gamma, eps, h_x, h_y, &h_S, &d_rho, &d_e))
+		    {
+			printf("<0.0 error on [%d, %d, %d] (t_n, x, y) - Update\n", k, j, i);
+			stop_t = true;
+		    }
+		h_S_max = fmin(h_S_max, h_S);
+#ifndef _OPENACC
+		if(repro)
+		    {
+			repro_sum_add(&s1_rho, fabs(d_rho));
+			repro_sum_add(&s1_e,   fabs(d_e));
+		    }
+		else
+#endif
+		    {
+			r1_rho += fabs(d_rho);
+			r1_e   += fabs(d_e);
+		    }
+		ri_rho  = fmax(ri_rho, fabs(d_rho));
+		ri_e    = fmax(ri_e,   fabs(d_e));
+	    } // End of parallel region
+#ifndef _OPENACC
+    if(repro)
+	{
+	    r1_rho = repro_sum_value(&s1_rho);
+	    r1_e   = repro_sum_value(&s1_e);
+	}
+#endif
+    res[SS_L1_RHO] = r1_rho;
+    res[SS_L1_E]   = r1_e;
+    res[SS_LI_RHO] = ri_rho;
+    res[SS_LI_E]   = ri_e;
+    PHASE_TOC(PT_UPDATE);
+    }
+    stop_t = halo_max_2D(stop_t);
+    // All the parts of the grids stop together as the steady state is reached on all of them.
+    if(ss.tol > 0.0 && !halo_max_2D(!steady_state_check(&ss, res, (long)m*n, tau)))
+	{
+	    printf("\nThe steady state is reached at time step %d, the residuals are reduced by %g.\n", k, ss.rel);
+	    steady = true;
+	}
 
 //==================================================
     
     time_c += tau;
     if(isfinite(t_all))
-        DispPro(time_c*100.0/t_all, k);
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
     else
-        DispPro(k*100.0/N, k);
-    if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
+        telemetry_step(k*100.0/N, k, time_c, tau);
+    file_2D_publish(m, n, k, CV + nt, time_c);
+    if(stop_t || steady || time_c > (t_all - eps) || !isfinite(time_c))
 	break;
 
     //===========================Fixed variable location=======================
 
-#ifdef _OPENMP
-    toc = omp_get_wtime();
-#elif defined _OPENACC
-    toc = omp_get_wtime();
-#else
-    toc = (double)clock() / (double)CLOCKS_PER_SEC;
-#endif
+    toc = wall_time();
     cpu_time_sum += toc - tic;
     cpu_time[nt]  = cpu_time_sum;
+    if(n_ckpt > 0 && k % n_ckpt == 0)
+	{
+	    PHASE_TIC(PT_IO);
+	    device_data_update_ckpt_2D(m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U);
+	    checkpoint_write(&ckpt);
+	    PHASE_TOC(PT_IO);
+	}
   }
 
   printf("\nTime is up at time step %d.\n", k);
-  printf("The cost of CPU time for genuinely 2D-GRP Eulerian scheme without dimension splitting for this problem is %g seconds.\n", cpu_time_sum);
+  printf("The cost of wall-clock time for genuinely 2D-GRP Eulerian scheme without dimension splitting for this problem is %g seconds.\n", cpu_time_sum);
   //------------END OF THE MAIN LOOP-------------
   
 return_NULL:
-  config[5] = (double)k;
-  *N_plot = nt+1;
+  ctx->conf[5] = (double)k;
+  // The streamed snapshots have been written, and the last one is in the only level.
+  n_out = stream ? nt_plot : nt;
+  *N_plot = n_out+1;
   if(isfinite(time_c))
-      time_plot[nt] = time_c;
+      time_plot[n_out] = time_c;
   else if(isfinite(t_all))
-      time_plot[nt] = t_all;
+      time_plot[n_out] = t_all;
   else if(isfinite(tau))
-      time_plot[nt] = k*tau;
+      time_plot[n_out] = k*tau;
+  if(on_device)
+      device_data_exit_2D(ctx, m, n, N_T, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U);
 
-  for(j = 0; j < m+1; ++j)
-  {
-    free(CV->F_rho[j]); free(CV->F_u[j]); free(CV->F_v[j]); free(CV->F_e[j]);
-    free(CV->rhoIx[j]); free(CV->uIx[j]); free(CV->vIx[j]); free(CV->pIx[j]);
-    CV->F_rho[j]= NULL; CV->F_u[j]= NULL; CV->F_v[j]= NULL; CV->F_e[j]= NULL;
-    CV->rhoIx[j]= NULL; CV->uIx[j]= NULL; CV->vIx[j]= NULL; CV->pIx[j]= NULL;
-  }
-  for(j = 0; j < m; ++j)
-  {
-    free(CV->G_rho[j]); free(CV->G_u[j]); free(CV->G_v[j]); free(CV->G_e[j]);
-    free(CV->rhoIy[j]); free(CV->uIy[j]); free(CV->vIy[j]); free(CV->pIy[j]);
-    free(CV->s_rho[j]); free(CV->s_u[j]); free(CV->s_v[j]); free(CV->s_p[j]);
-    free(CV->t_rho[j]); free(CV->t_u[j]); free(CV->t_v[j]); free(CV->t_p[j]);
-
-    CV->G_rho[j]= NULL; CV->G_u[j]= NULL; CV->G_v[j]= NULL; CV->G_e[j]= NULL; 
-    CV->rhoIy[j]= NULL; CV->uIy[j]= NULL; CV->vIy[j]= NULL; CV->pIy[j]= NULL; 
-    CV->s_rho[j]= NULL; CV->s_u[j]= NULL; CV->s_v[j]= NULL; CV->s_p[j]= NULL; 
-    CV->t_rho[j]= NULL; CV->t_u[j]= NULL; CV->t_v[j]= NULL; CV->t_p[j]= NULL; 
-  }
-    free(CV->F_rho); free(CV->F_u); free(CV->F_v); free(CV->F_e);
-    free(CV->rhoIx); free(CV->uIx); free(CV->vIx); free(CV->pIx);
-    free(CV->G_rho); free(CV->G_u); free(CV->G_v); free(CV->G_e);
-    free(CV->rhoIy); free(CV->uIy); free(CV->vIy); free(CV->pIy); 
-    free(CV->s_rho); free(CV->s_u); free(CV->s_v); free(CV->s_p);
-    free(CV->t_rho); free(CV->t_u); free(CV->t_v); free(CV->t_p);
+    field_free_2D(CV->F_rho, m+1); field_free_2D(CV->F_u, m+1); field_free_2D(CV->F_v, m+1); field_free_2D(CV->F_e, m+1);
+    field_free_2D(CV->rhoIx, m+1); field_free_2D(CV->uIx, m+1); field_free_2D(CV->vIx, m+1); field_free_2D(CV->pIx, m+1);
+    field_free_2D(CV->G_rho, m);   field_free_2D(CV->G_u, m);   field_free_2D(CV->G_v, m);   field_free_2D(CV->G_e, m);
+    field_free_2D(CV->rhoIy, m);   field_free_2D(CV->uIy, m);   field_free_2D(CV->vIy, m);   field_free_2D(CV->pIy, m);
+    field_free_2D(CV->s_rho, m);   field_free_2D(CV->s_u, m);   field_free_2D(CV->s_v, m);   field_free_2D(CV->s_p, m);
+    field_free_2D(CV->t_rho, m);   field_free_2D(CV->t_u, m);   field_free_2D(CV->t_v, m);   field_free_2D(CV->t_p, m);
     free(bfv_L); free(bfv_R);
     free(bfv_D); free(bfv_U);
+    free(tile);
     
     CV->F_rho= NULL; CV->F_u= NULL; CV->F_v= NULL; CV->F_e= NULL;
     CV->rhoIx= NULL; CV->uIx= NULL; CV->vIx= NULL; CV->pIx= NULL;
@@ -335,4 +635,28 @@ return_NULL:
     CV->t_rho= NULL; CV->t_u= NULL; CV->t_v= NULL; CV->t_p= NULL;
     bfv_L= NULL; bfv_R= NULL;
     bfv_D= NULL; bfv_U= NULL;
+    checkpoint_free(&ckpt);
+}
+
+/**
+ * @brief This function accounts the fields of GRP_solver_2D_EUL_source() and GRP_solver_2D_split_EUL_source()
+ *        without allocating them, which predicts their footprint in a dry run.
+ * @param[in] m: Number of the x-grids: n_x.
+ * @param[in] n: Number of the y-grids: n_y.
+ */
+void GRP_solver_2D_mem(const int m, const int n)
+{
+    const char * slope[8] = {"s_rho", "s_u", "s_v", "s_p", "t_rho", "t_u", "t_v", "t_p"};
+    const char * ifv_x[4] = {"rhoIx", "uIx", "vIx", "pIx"}, * ifv_y[4] = {"rhoIy", "uIy", "vIy", "pIy"};
+    const char * flu_x[4] = {"F_rho", "F_u", "F_v", "F_e"}, * flu_y[4] = {"G_rho", "G_u", "G_v", "G_e"};
+    int k;
+    for(k = 0; k < 8; ++k)
+	mem_account(MA_SLOPE, slope[k], field_bytes_2D(m, n, sizeof(Real_Store)));
+    for(k = 0; k < 4; ++k)
+	{
+	    mem_account(MA_INTERFACE, ifv_x[k], field_bytes_2D(m+1, n, sizeof(Real_Store)));
+	    mem_account(MA_INTERFACE, ifv_y[k], field_bytes_2D(m, n+1, sizeof(Real_Store)));
+	    mem_account(MA_FLUX,      flu_x[k], field_bytes_2D(m+1, n, sizeof(double)));
+	    mem_account(MA_FLUX,      flu_y[k], field_bytes_2D(m, n+1, sizeof(double)));
+	}
 }
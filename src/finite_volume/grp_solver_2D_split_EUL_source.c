@@ -24,25 +24,18 @@
 
 
 /**
- * @brief M*N memory allocations to the variable 'v' in the structure cell_var_stru.
+ * @brief M*N memory allocations to the variable 'v' in the structure cell_var_stru, accounted to the subsystem 'tag'.
+ * @details The element type of 'v' is double or Real_Store.
+ *          The field is one aligned memory block with the row pointers CV->v[j].
  */
-#define INIT_MEM_2D(v, M, N)						\
+#define INIT_MEM_2D(v, M, N, tag)					\
     do {								\
-	CV->v = (double **)malloc((M) * sizeof(double *));			\
-	if(CV->v == NULL)							\
+	CV->v = field_alloc_2D((M), (N), sizeof(**CV->v), (tag), #v);	\
+	if(CV->v == NULL)						\
 	    {								\
 		printf("NOT enough memory! %s\n", #v);			\
 		goto return_NULL;					\
 	    }								\
-	for(j = 0; j < (M); ++j)					\
-	    {								\
-		CV->v[j] = (double *)malloc((N) * sizeof(double));		\
-		if(CV->v[j] == NULL)					\
-		    {							\
-			printf("NOT enough memory! %s[%d]\n", #v, j);	\
-			goto return_NULL;				\
-		    }							\
-	    }								\
     } while (0)
 
 /**
@@ -61,6 +54,7 @@
 /**
  * @brief This function use GRP scheme to solve 2-D Euler
  *        equations of motion on Eulerian coordinate with dimension splitting.
+ * @param[in,out] ctx:    Pointer to the run context.
  * @param[in] m:          Number of the x-grids: n_x.
  * @param[in] n:          Number of the y-grids: n_y.
  * @param[in,out] CV:     Structure of cell variable data.
@@ -72,7 +66,7 @@
  * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
  * @param[in,out] time_plot: Array of the plotting time recording.
  */
-void GRP_solver_2D_split_EUL_source(const int m, const int n, struct cell_var_stru * CV, double ** X, double **Y, 
+void GRP_solver_2D_split_EUL_source(struct run_ctx * ctx, const int m, const int n, struct cell_var_stru * CV, double ** X, double **Y, 
                                     double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[])
 {
 #ifdef _OPENMP
@@ -92,14 +86,14 @@ void GRP_solver_2D_split_EUL_source(const int m, const int n, struct cell_var_st
   double tic, toc;
   double cpu_time_sum = 0.0;
 
-  double const t_all     = config[1];      // the total time
-  double const eps       = config[4];      // the largest value could be seen as zero
-  int    const N         = (int)config[5]; // the maximum number of time steps
-  double const gamma     = config[6];      // the constant of the perfect gas
-  double const CFL       = config[7];      // the CFL number
-  double const h_x       = config[10];     // the length of the initial x-spatial grids
-  double const h_y       = config[11];     // the length of the initial y-spatial grids
-  double       tau       = config[16];     // the length of the time step
+  double const t_all     = ctx->conf[1];      // the total time
+  double const eps       = ctx->conf[4];      // the largest value could be seen as zero
+  int    const N         = (int)ctx->conf[5]; // the maximum number of time steps
+  double const gamma     = ctx->conf[6];      // the constant of the perfect gas
+  double const CFL       = ctx->conf[7];      // the CFL number
+  double const h_x       = ctx->conf[10];     // the length of the initial x-spatial grids
+  double const h_y       = ctx->conf[11];     // the length of the initial y-spatial grids
+  double       tau       = ctx->conf[16];     // the length of the time step
 
   _Bool find_bound_x = false, find_bound_y = false;
   int flux_err;
@@ -110,58 +104,118 @@ void GRP_solver_2D_split_EUL_source(const int m, const int n, struct cell_var_st
   double half_tau, half_nu, mu;  // nu = tau/h_x, mu = tau/h_y.
 
   double h_S_max, sigma; // h/S_max, S_max is the maximum character speed, sigma is the character speed
-  double time_c = 0.0; // the current time
+  double time_c = ctx->conf[79]; // the current time (the start time of a warm start)
   _Bool stop_t = false;
   int nt = 0, nt_plot = 0; // the number of times storing plotting data
+  int n_out; // the index of the last plotting data
   int DS = 1; // dimension splitting indicator
+  _Bool  const stream  = (_Bool)ctx->conf[34]; // streaming output of the plotting data
+  int    const n_ckpt  = (int)ctx->conf[43];   // the number of time steps between the checkpoints
+  _Bool  const restart = (_Bool)ctx->conf[44]; // restart from the checkpoint
+  _Bool  const mem_report = (_Bool)ctx->conf[64]; // memory report at the plotting times
+  char mem_title[64];
+  struct ckpt_var ckpt = {0}; // the checkpoint of the state of the time loop
+  _Bool on_device = false; // whether the fields are entered into the device memory
   
   // Left/Right/Upper/Downside boundary condition
   struct b_f_var * bfv_L = NULL, * bfv_R = NULL, * bfv_U = NULL, * bfv_D = NULL;
   // the slopes of variable values.
-  INIT_MEM_2D(s_rho, m, n); INIT_MEM_2D(t_rho, m, n);
-  INIT_MEM_2D(s_u,   m, n); INIT_MEM_2D(t_u,   m, n);
-  INIT_MEM_2D(s_v,   m, n); INIT_MEM_2D(t_v,   m, n);
-  INIT_MEM_2D(s_p,   m, n); INIT_MEM_2D(t_p,   m, n);
+  INIT_MEM_2D(s_rho, m, n, MA_SLOPE); INIT_MEM_2D(t_rho, m, n, MA_SLOPE);
+  INIT_MEM_2D(s_u,   m, n, MA_SLOPE); INIT_MEM_2D(t_u,   m, n, MA_SLOPE);
+  INIT_MEM_2D(s_v,   m, n, MA_SLOPE); INIT_MEM_2D(t_v,   m, n, MA_SLOPE);
+  INIT_MEM_2D(s_p,   m, n, MA_SLOPE); INIT_MEM_2D(t_p,   m, n, MA_SLOPE);
   // the variable values at (x_{j-1/2}, t_{n+1}).
-  INIT_MEM_2D(rhoIx, m+1, n);
-  INIT_MEM_2D(uIx,   m+1, n);
-  INIT_MEM_2D(vIx,   m+1, n);
-  INIT_MEM_2D(pIx,   m+1, n);
-  INIT_MEM_2D(F_rho, m+1, n);
-  INIT_MEM_2D(F_u,   m+1, n);
-  INIT_MEM_2D(F_v,   m+1, n);
-  INIT_MEM_2D(F_e,   m+1, n); 
+  INIT_MEM_2D(rhoIx, m+1, n, MA_INTERFACE);
+  INIT_MEM_2D(uIx,   m+1, n, MA_INTERFACE);
+  INIT_MEM_2D(vIx,   m+1, n, MA_INTERFACE);
+  INIT_MEM_2D(pIx,   m+1, n, MA_INTERFACE);
+  INIT_MEM_2D(F_rho, m+1, n, MA_FLUX);
+  INIT_MEM_2D(F_u,   m+1, n, MA_FLUX);
+  INIT_MEM_2D(F_v,   m+1, n, MA_FLUX);
+  INIT_MEM_2D(F_e,   m+1, n, MA_FLUX); 
   // the variable values at (y_{j-1/2}, t_{n+1}).
-  INIT_MEM_2D(rhoIy, m, n+1);
-  INIT_MEM_2D(uIy,   m, n+1);
-  INIT_MEM_2D(vIy,   m, n+1);
-  INIT_MEM_2D(pIy,   m, n+1);
-  INIT_MEM_2D(G_rho, m, n+1);
-  INIT_MEM_2D(G_u,   m, n+1);
-  INIT_MEM_2D(G_v,   m, n+1);
-  INIT_MEM_2D(G_e,   m, n+1);
+  INIT_MEM_2D(rhoIy, m, n+1, MA_INTERFACE);
+  INIT_MEM_2D(uIy,   m, n+1, MA_INTERFACE);
+  INIT_MEM_2D(vIy,   m, n+1, MA_INTERFACE);
+  INIT_MEM_2D(pIy,   m, n+1, MA_INTERFACE);
+  INIT_MEM_2D(G_rho, m, n+1, MA_FLUX);
+  INIT_MEM_2D(G_u,   m, n+1, MA_FLUX);
+  INIT_MEM_2D(G_v,   m, n+1, MA_FLUX);
+  INIT_MEM_2D(G_e,   m, n+1, MA_FLUX);
   // boundary condition
   BC_INIT_MEM_1D(bfv_L, n); BC_INIT_MEM_1D(bfv_R, n);
   BC_INIT_MEM_1D(bfv_D, m); BC_INIT_MEM_1D(bfv_U, m);
 
+  if(n_ckpt > 0 || restart) // the state of the time loop
+      {
+	  if(checkpoint_init(ctx, &ckpt, problem))
+	      goto return_NULL;
+	  checkpoint_add(&ckpt, &k,            sizeof(k));
+	  checkpoint_add(&ckpt, &DS,           sizeof(DS));
+	  checkpoint_add(&ckpt, &time_c,       sizeof(time_c));
+	  checkpoint_add(&ckpt, &tau,          sizeof(tau));
+	  checkpoint_add(&ckpt, &half_tau,     sizeof(half_tau));
+	  checkpoint_add(&ckpt, &half_nu,      sizeof(half_nu));
+	  checkpoint_add(&ckpt, &mu,           sizeof(mu));
+	  checkpoint_add(&ckpt, &nt,           sizeof(nt));
+	  checkpoint_add(&ckpt, &nt_plot,      sizeof(nt_plot));
+	  checkpoint_add(&ckpt, &find_bound_x, sizeof(find_bound_x));
+	  checkpoint_add(&ckpt, &find_bound_y, sizeof(find_bound_y));
+	  checkpoint_add(&ckpt, &cpu_time_sum, sizeof(cpu_time_sum));
+	  checkpoint_add(&ckpt, cpu_time, N_T * sizeof(double));
+	  checkpoint_add(&ckpt, bfv_L, n * sizeof(struct b_f_var));
+	  checkpoint_add(&ckpt, bfv_R, n * sizeof(struct b_f_var));
+	  checkpoint_add(&ckpt, bfv_D, m * sizeof(struct b_f_var));
+	  checkpoint_add(&ckpt, bfv_U, m * sizeof(struct b_f_var));
+	  checkpoint_add_2D(&ckpt, m, n, N_T, CV);
+	  if(restart && checkpoint_read(&ckpt))
+	      goto return_NULL;
+      }
+  device_data_enter_2D(ctx, m, n, N_T, CV, bfv_L, bfv_R, bfv_D, bfv_U);
+  on_device = true;
+
+  /* The character speeds of the initial data (or of the checkpoint) decide the first time step,
+   * and those of the cells updated by the x-sweep with DS = 0 decide the next time steps.
+   */
+  h_S_max = INFINITY; // h/S_max = INFINITY
+#ifdef _OPENACC
+#pragma acc parallel loop collapse(2) private(c, sigma) reduction(min:h_S_max) default(present)
+#elif defined _OPENMP
+#pragma omp parallel for private(i, c, sigma) reduction(min:h_S_max)
+#endif
+  for(j = 0; j < m; ++j)
+      for(i = 0; i < n; ++i)
+	  {
+	      c = sqrt(gamma * CV[nt].P[j][i] / CV[nt].RHO[j][i]);
+	      sigma = fabs(c) + fabs(CV[nt].U[j][i]) + fabs(CV[nt].V[j][i]);
+	      h_S_max = fmin(h_S_max, fmin(h_x,h_y) / sigma);
+	  }
+
 //------------THE MAIN LOOP-------------
-  for(k = 1; k <= N; DS ? k : ++k)
+  for(k = restart ? (DS ? k : k+1) : 1; k <= N; DS ? k : ++k) // Go on from the time step after the checkpoint.
   {
-#ifdef _OPENMP
-    tic = omp_get_wtime();
-#elif defined _OPENACC
-    tic = omp_get_wtime();
-#else
-    tic = (double)clock() / (double)CLOCKS_PER_SEC;
-#endif
+    tic = wall_time();
     if (time_c >= time_plot[nt_plot] && nt_plot < (*N_plot-1))
 	{
+	    device_data_update_host_2D(m, n, CV + nt);
+	    PHASE_TIC(PT_IO);
+	    if(stream)
+		file_2D_write_stream(ctx, m, n, nt_plot, CV + nt, X, Y, NULL, problem, time_plot[nt_plot]);
 #ifndef NOTECPLOT
-	    file_2D_write_POINT_TEC(m, n, 1, CV + nt, X, Y, cpu_time, problem, time_plot + nt_plot);
+	    file_2D_write_POINT_TEC(ctx, m, n, 1, CV + nt, X, Y, cpu_time, problem, time_plot + nt_plot);
 #endif
+	    PHASE_TOC(PT_IO);
+	    if(mem_report)
+		{
+		    sprintf(mem_title, "Memory at t = %g", time_plot[nt_plot]);
+		    mem_account_report(mem_title, false);
+		}
 	    nt_plot++;
 	    if (nt < (N_T-1))
 		{
+#ifdef _OPENACC
+#pragma acc parallel loop collapse(2) default(present)
+#endif
 		    for(j = 0; j < m; ++j)
 			for(i = 0; i < n; ++i)
 			    {
@@ -180,17 +234,11 @@ void GRP_solver_2D_split_EUL_source(const int m, const int n, struct cell_var_st
      * of the time step by (tau * speed_max)/h = CFL
      */
     if(DS) {
-    h_S_max = INFINITY; // h/S_max = INFINITY
-
-    for(j = 0; j < m; ++j)
-	for(i = 0; i < n; ++i)
-	    {
-		c = sqrt(gamma * CV->P[j][i] / CV->RHO[j][i]);
-		sigma = fabs(c) + fabs(CV->U[j][i]) + fabs(CV->V[j][i]);
-		h_S_max = fmin(h_S_max, fmin(h_x,h_y) / sigma);
-	    }
+    PHASE_TIC(PT_CFL);
+    // h_S_max of the current cells has been reduced in the last x-update.
+    h_S_max = halo_min_2D(h_S_max); // the CFL condition of all the blocks
     // If no total time, use fixed tau and time step N.
-    if(isfinite(t_all) || !isfinite(config[16]) || config[16] <= 0.0)
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
 	{
 	    tau = CFL * h_S_max;
 	    if(tau < eps)
@@ -209,25 +257,35 @@ void GRP_solver_2D_split_EUL_source(const int m, const int n, struct cell_var_st
     half_tau = tau * 0.5;
     half_nu = half_tau / h_x;
     mu = tau / h_y;
+    PHASE_TOC(PT_CFL);
     }
 
-    find_bound_x = bound_cond_slope_limiter_x(m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U, find_bound_x, true, time_c);
+    find_bound_x = bound_cond_slope_limiter_x(ctx, m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U, find_bound_x, true, time_c);
     if(!find_bound_x)
         goto return_NULL;
-    flux_err = flux_generator_x(m, n, nt, half_tau, CV, bfv_L, bfv_R, false);
+    halo_slope_start_x(m, n, CV);
+    PHASE_TIC(PT_SOLVE);
+    flux_err = halo_max_2D(flux_generator_x(ctx, m, n, nt, half_tau, CV, bfv_L, bfv_R, false));
+    PHASE_TOC(PT_SOLVE);
     if(flux_err == 1)
         goto return_NULL;
     else if(flux_err == 2)
 	stop_t = true;
 
 //===============THE CORE ITERATION=================
-#ifdef _OPENMP
-#pragma omp parallel for  private(mom_x, mom_y, ene) collapse(2)
-#elif defined _OPENACC
-#pragma acc parallel loop private(mom_x, mom_y, ene) collapse(2)
+    PHASE_TIC(PT_UPDATE);
+    /* The cells are updated along y (the contiguous index i) in both sweeps.
+     * The last sweep before the next time step is this one with DS = 0,
+     * and it reduces the character speeds of the updated cells to h_S_max.
+     */
+    h_S_max = INFINITY;
+#ifdef _OPENACC
+#pragma acc parallel loop private(mom_x, mom_y, ene, c, sigma) collapse(2) reduction(||:stop_t) reduction(min:h_S_max) default(present)
+#elif defined _OPENMP
+#pragma omp parallel for  private(mom_x, mom_y, ene, c, sigma) collapse(2) reduction(min:h_S_max)
 #endif
-    for(i = 0; i < n; ++i)
-      for(j = 0; j < m; ++j)
+    for(j = 0; j < m; ++j)
+      for(i = 0; i < n; ++i)
       { /*
 	 *  j-1          j          j+1
 	 * j-1/2  j-1  j+1/2   j   j+3/2  j+1
@@ -247,32 +305,44 @@ void GRP_solver_2D_split_EUL_source(const int m, const int n, struct cell_var_st
 		  printf("<0.0 error on [%d, %d, %d] (t_n, x, y) - Update\n", k, j, i);
 		  stop_t = true;
 	      }
+	  if(!DS)
+	      {
+		  c = sqrt(gamma * CV[nt].P[j][i] / CV[nt].RHO[j][i]);
+		  sigma = fabs(c) + fabs(CV[nt].U[j][i]) + fabs(CV[nt].V[j][i]);
+		  h_S_max = fmin(h_S_max, fmin(h_x,h_y) / sigma);
+	      }
 	  
-	  CV->s_rho[j][i] = (CV->rhoIx[j+1][i] - CV->rhoIx[j][i])/h_x;
-	  CV->s_u[j][i]   = (  CV->uIx[j+1][i] -   CV->uIx[j][i])/h_x;
-	  CV->s_v[j][i]   = (  CV->vIx[j+1][i] -   CV->vIx[j][i])/h_x;
-	  CV->s_p[j][i]   = (  CV->pIx[j+1][i] -   CV->pIx[j][i])/h_x;
+	  CV->s_rho[j][i] = ((double)CV->rhoIx[j+1][i] - CV->rhoIx[j][i])/h_x;
+	  CV->s_u[j][i]   = ((double)  CV->uIx[j+1][i] -   CV->uIx[j][i])/h_x;
+	  CV->s_v[j][i]   = ((double)  CV->vIx[j+1][i] -   CV->vIx[j][i])/h_x;
+	  CV->s_p[j][i]   = ((double)  CV->pIx[j+1][i] -   CV->pIx[j][i])/h_x;
       } // End of parallel region
+    PHASE_TOC(PT_UPDATE);
+    stop_t = halo_max_2D(stop_t);
 
     if(stop_t)
 	break;
 //==================================================
 
     if(DS) {
-    find_bound_y = bound_cond_slope_limiter_y(m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U, find_bound_y, true, time_c);
+    find_bound_y = bound_cond_slope_limiter_y(ctx, m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U, find_bound_y, true, time_c);
     if(!find_bound_y)
         goto return_NULL;
-    flux_err = flux_generator_y(m, n, nt, tau, CV, bfv_D, bfv_U, false);
+    halo_slope_start_y(m, n, CV);
+    PHASE_TIC(PT_SOLVE);
+    flux_err = halo_max_2D(flux_generator_y(ctx, m, n, nt, tau, CV, bfv_D, bfv_U, false));
+    PHASE_TOC(PT_SOLVE);
     if(flux_err == 1)
         goto return_NULL;
     else if(flux_err == 2)
 	stop_t = true;
 
 //===============THE CORE ITERATION=================
-#ifdef _OPENMP
+    PHASE_TIC(PT_UPDATE);
+#ifdef _OPENACC
+#pragma acc parallel loop private(mom_x, mom_y, ene) collapse(2) reduction(||:stop_t) default(present)
+#elif defined _OPENMP
 #pragma omp parallel for  private(mom_x, mom_y, ene) collapse(2)
-#elif defined _OPENACC
-#pragma acc parallel loop private(mom_x, mom_y, ene) collapse(2)
 #endif
     for(j = 0; j < m; ++j)
       for(i = 0; i < n; ++i)
@@ -296,18 +366,21 @@ void GRP_solver_2D_split_EUL_source(const int m, const int n, struct cell_var_st
 		  stop_t = true;
 	      }
 	  
-	  CV->t_rho[j][i] = (CV->rhoIy[j][i+1] - CV->rhoIy[j][i])/h_y;
-	  CV->t_u[j][i]   = (  CV->uIy[j][i+1] -   CV->uIy[j][i])/h_y;
-	  CV->t_v[j][i]   = (  CV->vIy[j][i+1] -   CV->vIy[j][i])/h_y;
-	  CV->t_p[j][i]   = (  CV->pIy[j][i+1] -   CV->pIy[j][i])/h_y;
+	  CV->t_rho[j][i] = ((double)CV->rhoIy[j][i+1] - CV->rhoIy[j][i])/h_y;
+	  CV->t_u[j][i]   = ((double)  CV->uIy[j][i+1] -   CV->uIy[j][i])/h_y;
+	  CV->t_v[j][i]   = ((double)  CV->vIy[j][i+1] -   CV->vIy[j][i])/h_y;
+	  CV->t_p[j][i]   = ((double)  CV->pIy[j][i+1] -   CV->pIy[j][i])/h_y;
       } // End of parallel region
+    PHASE_TOC(PT_UPDATE);
+    stop_t = halo_max_2D(stop_t);
 //==================================================
     
     time_c += tau;
     if(isfinite(t_all))
-        DispPro(time_c*100.0/t_all, k);
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
     else
-        DispPro(k*100.0/N, k);
+        telemetry_step(k*100.0/N, k, time_c, tau);
+    file_2D_publish(m, n, k, CV + nt, time_c);
     }
     if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
 	break;
@@ -315,56 +388,42 @@ void GRP_solver_2D_split_EUL_source(const int m, const int n, struct cell_var_st
     DS = DS ? 0 : 1;
     //===========================Fixed variable location=======================
     
-#ifdef _OPENMP
-    toc = omp_get_wtime();
-#elif defined _OPENACC
-    toc = omp_get_wtime();
-#else
-    toc = (double)clock() / (double)CLOCKS_PER_SEC;
-#endif
+    toc = wall_time();
     cpu_time_sum += toc - tic;
     cpu_time[nt]  = cpu_time_sum;
+    if(n_ckpt > 0 && k % n_ckpt == 0)
+	{
+	    PHASE_TIC(PT_IO);
+	    device_data_update_ckpt_2D(m, n, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U);
+	    checkpoint_write(&ckpt);
+	    PHASE_TOC(PT_IO);
+	}
   }
 
   printf("\nTime is up at time step %d.\n", k);
-  printf("The cost of CPU time for 2D-GRP Eulerian scheme with dimension splitting for this problem is %g seconds.\n", cpu_time_sum);
+  printf("The cost of wall-clock time for 2D-GRP Eulerian scheme with dimension splitting for this problem is %g seconds.\n", cpu_time_sum);
   //------------END OF THE MAIN LOOP-------------
   
 return_NULL:
-  config[5] = (double)k;
-  *N_plot = nt+1;
+  ctx->conf[5] = (double)k;
+  // The streamed snapshots have been written, and the last one is in the only level.
+  n_out = stream ? nt_plot : nt;
+  *N_plot = n_out+1;
   if(isfinite(time_c))
-      time_plot[nt] = time_c;
+      time_plot[n_out] = time_c;
   else if(isfinite(t_all))
-      time_plot[nt] = t_all;
+      time_plot[n_out] = t_all;
   else if(isfinite(tau))
-      time_plot[nt] = k*tau;
+      time_plot[n_out] = k*tau;
+  if(on_device)
+      device_data_exit_2D(ctx, m, n, N_T, nt, CV, bfv_L, bfv_R, bfv_D, bfv_U);
 
-  for(j = 0; j < m+1; ++j)
-  {
-    free(CV->F_rho[j]); free(CV->F_u[j]); free(CV->F_v[j]); free(CV->F_e[j]);
-    free(CV->rhoIx[j]); free(CV->uIx[j]); free(CV->vIx[j]); free(CV->pIx[j]);
-    CV->F_rho[j]= NULL; CV->F_u[j]= NULL; CV->F_v[j]= NULL; CV->F_e[j]= NULL;
-    CV->rhoIx[j]= NULL; CV->uIx[j]= NULL; CV->vIx[j]= NULL; CV->pIx[j]= NULL;
-  }
-  for(j = 0; j < m; ++j)
-  {
-    free(CV->G_rho[j]); free(CV->G_u[j]); free(CV->G_v[j]); free(CV->G_e[j]);
-    free(CV->rhoIy[j]); free(CV->uIy[j]); free(CV->vIy[j]); free(CV->pIy[j]);
-    free(CV->s_rho[j]); free(CV->s_u[j]); free(CV->s_v[j]); free(CV->s_p[j]);
-    free(CV->t_rho[j]); free(CV->t_u[j]); free(CV->t_v[j]); free(CV->t_p[j]);
-
-    CV->G_rho[j]= NULL; CV->G_u[j]= NULL; CV->G_v[j]= NULL; CV->G_e[j]= NULL; 
-    CV->rhoIy[j]= NULL; CV->uIy[j]= NULL; CV->vIy[j]= NULL; CV->pIy[j]= NULL; 
-    CV->s_rho[j]= NULL; CV->s_u[j]= NULL; CV->s_v[j]= NULL; CV->s_p[j]= NULL; 
-    CV->t_rho[j]= NULL; CV->t_u[j]= NULL; CV->t_v[j]= NULL; CV->t_p[j]= NULL; 
-  }
-    free(CV->F_rho); free(CV->F_u); free(CV->F_v); free(CV->F_e);
-    free(CV->rhoIx); free(CV->uIx); free(CV->vIx); free(CV->pIx);
-    free(CV->G_rho); free(CV->G_u); free(CV->G_v); free(CV->G_e);
-    free(CV->rhoIy); free(CV->uIy); free(CV->vIy); free(CV->pIy); 
-    free(CV->s_rho); free(CV->s_u); free(CV->s_v); free(CV->s_p);
-    free(CV->t_rho); free(CV->t_u); free(CV->t_v); free(CV->t_p);
+    field_free_2D(CV->F_rho, m+1); field_free_2D(CV->F_u, m+1); field_free_2D(CV->F_v, m+1); field_free_2D(CV->F_e, m+1);
+    field_free_2D(CV->rhoIx, m+1); field_free_2D(CV->uIx, m+1); field_free_2D(CV->vIx, m+1); field_free_2D(CV->pIx, m+1);
+    field_free_2D(CV->G_rho, m);   field_free_2D(CV->G_u, m);   field_free_2D(CV->G_v, m);   field_free_2D(CV->G_e, m);
+    field_free_2D(CV->rhoIy, m);   field_free_2D(CV->uIy, m);   field_free_2D(CV->vIy, m);   field_free_2D(CV->pIy, m);
+    field_free_2D(CV->s_rho, m);   field_free_2D(CV->s_u, m);   field_free_2D(CV->s_v, m);   field_free_2D(CV->s_p, m);
+    field_free_2D(CV->t_rho, m);   field_free_2D(CV->t_u, m);   field_free_2D(CV->t_v, m);   field_free_2D(CV->t_p, m);
     free(bfv_L); free(bfv_R);
     free(bfv_D); free(bfv_U);
     
@@ -376,4 +435,5 @@ return_NULL:
     CV->t_rho= NULL; CV->t_u= NULL; CV->t_v= NULL; CV->t_p= NULL;
     bfv_L= NULL; bfv_R= NULL;
     bfv_D= NULL; bfv_U= NULL;
+    checkpoint_free(&ckpt);
 }
@@ -8,61 +8,119 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdbool.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "../include/var_struc.h"
 #include "../include/riemann_solver.h"
 #include "../include/inter_process.h"
 #include "../include/tools.h"
+#include "../include/file_io.h"
+
+
+/**
+ * @brief This function gives the target grid points of the rezoning, which smooth the spacing of the grids.
+ * @details The target grid points X_s solve the implicit smoothing
+ *          \f[ X_{s,j} - \ell^2 (X_{s,j-1} - 2X_{s,j} + X_{s,j+1}) = X_j, \quad X_{s,0} = X_0, \ X_{s,m} = X_m, \f]
+ *          by the Thomas algorithm, so that a compressed (or stretched) block of the grids is spread over about ℓ cells
+ *          around it in one time step, while the grids of uniform spacing are kept.
+ * @param[in]  m:  Number of the grids.
+ * @param[in]  X:  Grid point coordinates.
+ * @param[in]  l2: Square of the width ℓ (in cells) of the smoothing.
+ * @param[out] X_s: Target grid point coordinates.
+ * @param[out] c:   Scratch array of the m+1 coefficients of the elimination.
+ */
+static void ALE_grid_target(const int m, const double * X, const double l2, double * X_s, double * c)
+{
+  int j;
+  double r;
+  X_s[0] = X[0];
+  X_s[m] = X[m];
+  c[0] = 0.0;
+  for(j = 1; j < m; ++j) // forward elimination, with X_s[m] moved to the right hand side
+      {
+	  r = 1.0 / (1.0 + 2.0*l2 - l2*c[j-1]);
+	  c[j]   = l2 * r;
+	  X_s[j] = (X[j] + l2*X_s[j-1] + (j == m-1 ? l2*X_s[m] : 0.0)) * r;
+      }
+  for(j = m-2; j > 0; --j) // back substitution
+      X_s[j] += c[j] * X_s[j+1];
+}
 
 
 /**
  * @brief This function use GRP scheme to solve 1-D Euler
  *        equations of motion on ALE coordinate.
+ * @details The grid points move with the velocity of the fluid at the interfaces, which keeps the contact discontinuities
+ *          on the grids as the Lagrangian scheme, and relax toward the target spacing (rezoning) at the rate
+ *          config[91] per time step, which keeps the spacing of the grids from collapsing under compression,
+ *          so that the time step stays near the limit of the Eulerian CFL condition.
+ *          The velocity of the grid point j at t_{n} is
+ *          \f[ w_j = u_j + \frac{\omega (x_{s,j} - x_j)}{\tau_{n-1}}, \f]
+ *          where u_j is the velocity of the fluid at the interface at t_{n}, x_{s,j} is the target grid point of
+ *          ALE_grid_target() with the width config[92], and the boundary grid points are fixed. The displacement
+ *          of the relaxation is limited to a twentieth of the CFL number of the neighbouring cells, so that it
+ *          hardly shortens the time step and does not drive the grids across the strong shocks.
+ *          The GRP solver along the moving interfaces (linear_GRP_solver_Edir_moving()) gives the numerical fluxes
+ *          relative to the grids, and the conservative variables of the moving cells are updated by them.
+ * @param[in,out] ctx:    Pointer to the run context.
  * @param[in] m:          Number of the grids.
  * @param[in,out] CV:     Structure of cell variable data.
  * @param[in,out] X[]:    Array of the coordinate data.
  * @param[out] cpu_time:  Array of the CPU time recording.
+ * @param[in]  problem:   Name of the numerical results for the test problem.
+ * @param[in]  N_T:       Number of levels storing fluid variables in memory.
  * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
  * @param[in,out] time_plot: Array of the plotting time recording.
- * @todo All of the functionality of the ALE code has not yet been implemented.
  */
-void GRP_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, double * X[], double * cpu_time, int * N_plot, double time_plot[])
+void GRP_solver_ALE_source(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[])
 {
-    /* 
+    /*
      * j is a frequently used index for spatial variables.
      * k is a frequently used index for the time step.
      */
   int j, k = 0;
 
-  clock_t tic, toc;
+  double tic, toc;
   double cpu_time_sum = 0.0;
 
-  double const t_all = config[1];      // the total time
-  double const eps   = config[4];      // the largest value could be seen as zero
-  int    const N     = (int)config[5]; // the maximum number of time steps
-  double const gamma = config[6];      // the constant of the perfect gas
-  double const CFL   = config[7];      // the CFL number
-  double const h     = config[10];     // the length of the initial spatial grids
-  double       tau   = config[16];     // the length of the time step
+  double const t_all = ctx->conf[1];      // the total time
+  double const eps   = ctx->conf[4];      // the largest value could be seen as zero
+  int    const N     = (int)ctx->conf[5]; // the maximum number of time steps
+  double const gamma = ctx->conf[6];      // the constant of the perfect gas
+  double const CFL   = ctx->conf[7];      // the CFL number
+  double const h     = ctx->conf[10];     // the length of the initial spatial grids
+  double       tau   = ctx->conf[16];     // the length of the time step
+  double const omega = ctx->conf[91];     // the rate of the relaxation of the grids toward the target spacing
+  double const l2    = ctx->conf[92]*ctx->conf[92]; // the square of the width of the smoothing of the target spacing
 
   _Bool find_bound = false;
 
-  double Mom, Ene;
+  double Mom, Ene, Mas;
   double c_L, c_R; // the speeds of sound
   double h_L, h_R; // length of spatial grids
   /*
-   * dire: the temporal derivative of fluid variables.
-   *       \frac{\partial [rho, u, p]}{\partial t}
+   * dire: the temporal derivative of fluid variables along the moving interface.
+   *       \frac{\partial [rho, u, p]}{\partial t} + w \frac{\partial [rho, u, p]}{\partial x}
    * mid:  the Riemann solutions.
    *       [rho_star, u_star, p_star]
    */
   double dire[3], mid[3];
 
-  double nu;  // nu = tau/h
-  double h_S_max; // h/S_max, S_max is the maximum wave speed
+  double h_S_max; // h/S_max, S_max is the maximum wave speed relative to the grids
   double time_c = 0.0; // the current time
+  double tau_p = 0.0; // the length of the last time step
+  double tau_sum = 0.0, h_min = INFINITY; // the sum of the time steps and the minimum length of the grids
   _Bool stop_t = false;
-  int nt = 0; // the number of times storing plotting data
+  int data_err; // whether there is miscalculation in the parallel loops
+  int j_err, err; // the first interface of the miscalculation and its indicator
+  int nt = 0, nt_plot = 0; // the number of times storing plotting data
+  int nt_w; // the level written by the time step, the next one after a plotting time
+  _Bool const stream = (_Bool)ctx->conf[34]; // streaming output of the plotting data
+  int    const n_ckpt  = (int)ctx->conf[43];   // the number of time steps between the checkpoints
+  _Bool  const restart = (_Bool)ctx->conf[44]; // restart from the checkpoint
+  struct ckpt_var ckpt = {0}; // the checkpoint of the state of the time loop
 
   struct b_f_var bfv_L = {.H = h, .SRHO = 0.0, .SP = 0.0, .SU = 0.0}, bfv_R = bfv_L; // Left/Right boundary condition
   struct i_f_var ifv_L = {.gamma = gamma}, ifv_R = ifv_L;
@@ -86,10 +144,15 @@ void GRP_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, double *
   double * U_t   = (double*)malloc((m+1) * sizeof(double));
   double * P_t   = (double*)malloc((m+1) * sizeof(double));
   double * RHO_t = (double*)malloc((m+1) * sizeof(double));
-  // the numerical flux at (x_{j-1/2}, t_{n}).
+  // the numerical flux relative to the grids at (x_{j-1/2}, t_{n+1/2}).
   double * F_rho = (double*)malloc((m+1) * sizeof(double));
   double * F_u   = (double*)malloc((m+1) * sizeof(double));
   double * F_e   = (double*)malloc((m+1) * sizeof(double));
+  double * W     = (double*)malloc((m+1) * sizeof(double)); // the velocities of the grid points at t_{n}.
+  double * X_s   = (double*)malloc((m+1) * sizeof(double)); // the target grid points of the rezoning.
+  int * if_err   = (int*)malloc((m+1) * sizeof(int)); // the miscalculation indicators at (x_{j-1/2}, t_{n}).
+  const double * const mid_a[3]  = {RHO_next, U_next, P_next}; // the arrays of mid[] and dire[] at the interfaces
+  const double * const dire_a[3] = {RHO_t,    U_t,    P_t};
   if(s_rho == NULL || s_u == NULL || s_p == NULL)
       {
 	  printf("NOT enough memory! Slope\n");
@@ -105,34 +168,93 @@ void GRP_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, double *
 	  printf("NOT enough memory! Temproal derivative\n");
 	  goto return_NULL;
       }
-  if(F_rho == NULL || F_u == NULL || F_e == NULL)
+  if(F_rho == NULL || F_u == NULL || F_e == NULL || W == NULL || X_s == NULL || if_err == NULL)
       {
 	  printf("NOT enough memory! Flux\n");
 	  goto return_NULL;
       }
-  
+  // the velocities of the fluid at the interfaces at t_{0}
+  U_next[0] = U[0][0];
+  U_next[m] = U[0][m-1];
+  for(j = 1; j < m; ++j)
+      U_next[j] = 0.5*(U[0][j-1] + U[0][j]);
+
+  if(n_ckpt > 0 || restart) // the state of the time loop
+      {
+	  if(checkpoint_init(ctx, &ckpt, problem))
+	      goto return_NULL;
+	  checkpoint_add(&ckpt, &k,            sizeof(k));
+	  checkpoint_add(&ckpt, &time_c,       sizeof(time_c));
+	  checkpoint_add(&ckpt, &tau,          sizeof(tau));
+	  checkpoint_add(&ckpt, &tau_p,        sizeof(tau_p));
+	  checkpoint_add(&ckpt, &tau_sum,      sizeof(tau_sum));
+	  checkpoint_add(&ckpt, &h_min,        sizeof(h_min));
+	  checkpoint_add(&ckpt, &nt,           sizeof(nt));
+	  checkpoint_add(&ckpt, &nt_plot,      sizeof(nt_plot));
+	  checkpoint_add(&ckpt, &find_bound,   sizeof(find_bound));
+	  checkpoint_add(&ckpt, &cpu_time_sum, sizeof(cpu_time_sum));
+	  checkpoint_add(&ckpt, &bfv_L,        sizeof(bfv_L));
+	  checkpoint_add(&ckpt, &bfv_R,        sizeof(bfv_R));
+	  checkpoint_add(&ckpt, cpu_time, N_T * sizeof(double));
+	  checkpoint_add(&ckpt, s_rho,    m * sizeof(double));
+	  checkpoint_add(&ckpt, s_u,      m * sizeof(double));
+	  checkpoint_add(&ckpt, s_p,      m * sizeof(double));
+	  checkpoint_add(&ckpt, U_next,   (m+1) * sizeof(double));
+	  checkpoint_add_1D(&ckpt, m, N_T, CV, X);
+	  if(restart && checkpoint_read(&ckpt))
+	      goto return_NULL;
+      }
+
 //-----------------------THE MAIN LOOP--------------------------------
-  for(k = 1; k <= N; ++k)
+  for(k = restart ? k+1 : 1; k <= N; ++k) // Go on from the time step after the checkpoint.
   {
-      tic = clock();
-      if (time_c >= time_plot[nt] && nt < (*N_plot-1))
+      tic = wall_time();
+      nt_w = nt;
+      if (time_c >= time_plot[nt_plot] - eps && nt_plot < (*N_plot-1))
 	  {
-	      for(j = 0; j < m; ++j)
+	      if(stream)
 		  {
-		      RHO[nt+1][j] = RHO[nt][j];
-		      U[nt+1][j]   =   U[nt][j];
-		      E[nt+1][j]   =   E[nt][j];  
-		      P[nt+1][j]   =   P[nt][j];
+		      PHASE_TIC(PT_IO);
+		      file_1D_write_stream(ctx, m, nt_plot, CV, nt, X[nt], NULL, problem, time_plot[nt_plot]);
+		      PHASE_TOC(PT_IO);
 		  }
-	      nt++;
+	      nt_plot++;
+	      if (nt < (N_T-1)) // The next step writes the next level from this one, which is kept for the plot.
+		  nt_w = nt+1;
 	  }
 
       h_S_max = INFINITY; // h/S_max = INFINITY
 
-      find_bound = bound_cond_slope_limiter(true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, true, time_c, X[nt]);
+      find_bound = bound_cond_slope_limiter(ctx, true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, true, time_c, X[nt]);
       if(!find_bound)
 	  goto return_NULL;
 
+//=====================Velocities of the grids=====================
+      PHASE_TIC(PT_FLUX);
+      W[0] = 0.0;
+      W[m] = 0.0;
+      if(tau_p > 0.0 && omega > 0.0)
+	  ALE_grid_target(m, X[nt], l2, X_s, F_rho);
+#pragma omp parallel for private(h_L, h_R)
+      for(j = 1; j < m; ++j) // motion with the fluid, relaxed toward the target spacing
+	  {
+	      W[j] = U_next[j];
+	      if(tau_p > 0.0 && omega > 0.0)
+		  { // The displacement of the relaxation is at most a twentieth of the CFL number of the cells.
+		      h_R = 0.05 * CFL * fmin(X[nt][j] - X[nt][j-1], X[nt][j+1] - X[nt][j]);
+		      h_L = fmax(-h_R, fmin(omega * (X_s[j] - X[nt][j]), h_R));
+		      W[j] += h_L / tau_p;
+		  }
+	  }
+#pragma omp parallel for reduction(min:h_S_max)
+      for(j = 0; j < m; ++j) // the cells are not inverted in a time step
+	  if(W[j] > W[j+1])
+	      h_S_max = fmin(h_S_max, (X[nt][j+1] - X[nt][j])/(W[j] - W[j+1]));
+      PHASE_TOC(PT_FLUX);
+
+      PHASE_TIC(PT_SOLVE);
+      j_err = m+1;
+#pragma omp parallel for private(c_L, c_R, h_L, h_R, dire, mid) firstprivate(ifv_L, ifv_R) reduction(min:h_S_max) reduction(min:j_err)
       for(j = 0; j <= m; ++j)
 	  { /*
 	     *  j-1          j          j+1
@@ -170,8 +292,8 @@ void GRP_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, double *
 
 	      c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);
 	      c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);
-	      h_S_max = fmin(h_S_max, h_L/(fabs(ifv_L.U)+fabs(c_L)));
-	      h_S_max = fmin(h_S_max, h_R/(fabs(ifv_R.U)+fabs(c_R)));
+	      h_S_max = fmin(h_S_max, h_L/(fabs(ifv_L.U-W[j])+fabs(c_L)));
+	      h_S_max = fmin(h_S_max, h_R/(fabs(ifv_R.U-W[j])+fabs(c_R)));
 
 	      if(j) //calculate the material derivatives
 		  {
@@ -197,20 +319,15 @@ void GRP_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, double *
 		      ifv_R.d_u   = bfv_R.SU;
 		      ifv_R.d_p   = bfv_R.SP;
 		  }
-	      if(ifvar_check(&ifv_L, &ifv_R, 1))
+	      if((if_err[j] = ifvar_check_code(ctx, &ifv_L, &ifv_R, 1)))
 		  {
-		      printf(" on [%d, %d] (t_n, x).\n", k, j);
-		      goto return_NULL;
+		      j_err = j;
+		      continue;
 		  }
 
 //========================Solve GRP========================
-	      linear_GRP_solver_Edir(dire, mid, &ifv_L, &ifv_R, eps, eps);
-
-	      if(star_dire_check(mid, dire, 1))
-		  {
-		      printf(" on [%d, %d] (t_n, x).\n", k, j);
-		      stop_t = true;
-		  }
+	      ifv_L.lambda_u = W[j]; // the moving frame of the interface
+	      linear_GRP_solver_Edir_moving(dire, mid, &ifv_L, &ifv_R, eps, eps);
 
 	      RHO_next[j] = mid[0];
 	      U_next[j]   = mid[1];
@@ -219,10 +336,22 @@ void GRP_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, double *
 	      U_t[j]   = dire[1];
 	      P_t[j]   = dire[2];
 	  }
+      if(j_err <= m) // Report the first miscalculation of the interfaces.
+	  {
+	      printf("%s on [%d, %d] (t_n, x).\n", ifvar_check_msg(if_err[j_err], 1), k, j_err);
+	      goto return_NULL;
+	  }
+      else if((j = star_dire_check_batch(ctx, m+1, mid_a, dire_a, 1, &err)) >= 0)
+	  {
+	      printf("%s on [%d, %d] (t_n, x).\n", star_dire_check_msg(err), k, j);
+	      stop_t = true;
+	  }
+      PHASE_TOC(PT_SOLVE);
 
-//====================Time step and grid fixed======================
+//====================Time step and grid movement======================
+    PHASE_TIC(PT_CFL);
     // If no total time, use fixed tau and time step N.
-    if(isfinite(t_all) || !isfinite(config[16]) || config[16] <= 0.0)
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
 	{
 	    tau = CFL * h_S_max;
 	    if(tau < eps)
@@ -234,86 +363,128 @@ void GRP_solver_ALE_source_Undone(const int m, struct cell_var_stru CV, double *
 		tau = t_all - time_c;
 	    else if(!isfinite(tau))
 		{
-		    printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, tau) - CFL\n", k, time_c, tau); 
+		    printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, tau) - CFL\n", k, time_c, tau);
 		    goto return_NULL;
 		}
+	    else if(nt_plot < (*N_plot-1) && (time_c + tau) > (time_plot[nt_plot] - eps))
+		tau = time_plot[nt_plot] - time_c; // The step lands on the plotting time.
 	}
-    nu = tau / h;
-    
+    PHASE_TOC(PT_CFL);
+
+    PHASE_TIC(PT_FLUX);
+#pragma omp parallel for
     for(j = 0; j <= m; ++j)
 	{
 	    RHO_next[j] += 0.5 * tau * RHO_t[j];
 	    U_next[j]   += 0.5 * tau * U_t[j];
 	    P_next[j]   += 0.5 * tau * P_t[j];
 
-	    F_rho[j] = RHO_next[j]*U_next[j];
+	    F_rho[j] = RHO_next[j]*(U_next[j] - W[j]);
 	    F_u[j] = F_rho[j]*U_next[j] + P_next[j];
-	    F_e[j] = (gamma/(gamma-1.0))*P_next[j] + 0.5*F_rho[j]*U_next[j];
-	    F_e[j] = F_e[j]*U_next[j];
+	    F_e[j] = F_rho[j]*(P_next[j]/(gamma-1.0)/RHO_next[j] + 0.5*U_next[j]*U_next[j]) + P_next[j]*U_next[j];
 
 	    RHO_next[j] += 0.5 * tau * RHO_t[j];
 	    U_next[j]   += 0.5 * tau * U_t[j];
 	    P_next[j]   += 0.5 * tau * P_t[j];
-
-	    X[nt][j] = X[nt][j];
 	}
+    PHASE_TOC(PT_FLUX);
 
-//======================THE CORE ITERATION=========================(On Eulerian Coordinate)
+//======================THE CORE ITERATION=========================(On ALE Coordinate)
+    PHASE_TIC(PT_UPDATE);
+    data_err = 0;
+#pragma omp parallel for private(Mom, Ene, Mas, h_L, h_R) reduction(|:data_err) reduction(min:h_min)
     for(j = 0; j < m; ++j) // forward Euler
 	{ /*
 	   *  j-1          j          j+1
 	   * j-1/2  j-1  j+1/2   j   j+3/2  j+1
 	   *   o-----X-----o-----X-----o-----X--...
 	   */
-	    Mom = RHO[nt][j]*U[nt][j] - nu*(F_u[j+1]  -F_u[j]);
-	    Ene = RHO[nt][j]*E[nt][j] - nu*(F_e[j+1]  -F_e[j]);
-	    RHO[nt][j]  =  RHO[nt][j] - nu*(F_rho[j+1]-F_rho[j]);
+	    h_L = X[nt][j+1] - X[nt][j]; // the lengths of the cell at t_{n} and t_{n+1}
+	    h_R = h_L + tau*(W[j+1] - W[j]);
+	    h_min = fmin(h_min, h_R);
+	    Mas = RHO[nt][j]*h_L            - tau*(F_rho[j+1]-F_rho[j]);
+	    Mom = RHO[nt][j]*U[nt][j]*h_L   - tau*(F_u[j+1]  -F_u[j]);
+	    Ene = RHO[nt][j]*E[nt][j]*h_L   - tau*(F_e[j+1]  -F_e[j]);
+
+	    RHO[nt_w][j] = Mas / h_R;
+	    U[nt_w][j]   = Mom / Mas;
+	    E[nt_w][j]   = Ene / Mas;
+	    P[nt_w][j]   = (E[nt_w][j] - 0.5*U[nt_w][j]*U[nt_w][j])*(gamma-1.0)*RHO[nt_w][j];
+	    if(P[nt_w][j] < eps || RHO[nt_w][j] < eps)
+		data_err = 1;
 
-	    U[nt][j] = Mom / RHO[nt][j];
-	    E[nt][j] = Ene / RHO[nt][j];
-	    P[nt][j] = (Ene - 0.5*Mom*U[nt][j])*(gamma-1.0);
+//============================compute the slopes============================
+	    s_u[j]   = (  U_next[j+1] -   U_next[j])/h_R;
+	    s_p[j]   = (  P_next[j+1] -   P_next[j])/h_R;
+	    s_rho[j] = (RHO_next[j+1] - RHO_next[j])/h_R;
+	}
+    for(j = 0; j <= m; ++j) // motion of the grids, the boundaries are fixed (W = 0)
+	X[nt_w][j] = X[nt][j] + tau * W[j];
+    nt = nt_w;
+    if(data_err) // Report the miscalculation in order of the cells.
+	for(j = 0; j < m; ++j)
 	    if(P[nt][j] < eps || RHO[nt][j] < eps)
 		{
 		    printf("<0.0 error on [%d, %d] (t_n, x) - Update\n", k, j);
 		    stop_t = true;
 		}
-	    
-//============================compute the slopes============================
-	    s_u[j]   = (  U_next[j+1] -   U_next[j])/(X[nt][j+1]-X[nt][j]);
-	    s_p[j]   = (  P_next[j+1] -   P_next[j])/(X[nt][j+1]-X[nt][j]);
-	    s_rho[j] = (RHO_next[j+1] - RHO_next[j])/(X[nt][j+1]-X[nt][j]);
-	}
+    PHASE_TOC(PT_UPDATE);
 
 //============================Time update=======================
 
-    time_c += tau;
+    if(telemetry_due()) // the totals of mass, momentum and energy of the record
+	{
+	    double q[3] = {0.0, 0.0, 0.0};
+	    for(j = 0; j < m; ++j)
+		{
+		    h_L = X[nt][j+1] - X[nt][j];
+		    q[0] += RHO[nt][j]*h_L;
+		    q[1] += RHO[nt][j]*U[nt][j]*h_L;
+		    q[2] += RHO[nt][j]*E[nt][j]*h_L;
+		}
+	    telemetry_conserve(3, q);
+	}
+
+    time_c  += tau;
+    tau_p    = tau;
+    tau_sum += tau;
     if(isfinite(t_all))
-        DispPro(time_c*100.0/t_all, k);
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
     else
-        DispPro(k*100.0/N, k);
+        telemetry_step(k*100.0/N, k, time_c, tau);
+    file_1D_publish(ctx, m, k, CV, nt, X[nt], time_c);
     if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
 	break;
 
 //===========================Fixed variable location=======================
 
-    toc = clock();
-    cpu_time_sum += ((double)toc - (double)tic) / (double)CLOCKS_PER_SEC;
+    toc = wall_time();
+    cpu_time_sum += toc - tic;
     cpu_time[nt]  = cpu_time_sum;
+    if(n_ckpt > 0 && k % n_ckpt == 0)
+	{
+	    PHASE_TIC(PT_IO);
+	    checkpoint_write(&ckpt);
+	    PHASE_TOC(PT_IO);
+	}
   }
 
   printf("\nTime is up at time step %d.\n", k);
-  printf("The cost of CPU time for 1D-GRP Eulerian scheme for this problem is %g seconds.\n", cpu_time_sum);
+  printf("The cost of wall-clock time for 1D-GRP ALE scheme for this problem is %g seconds.\n", cpu_time_sum);
+  if(k > 0)
+      printf("The mean length of the time steps is %g, the minimum length of the grids is %g (relaxation rate %g).\n",
+	     tau_sum/k, h_min, omega);
 //---------------------END OF THE MAIN LOOP----------------------
 
 return_NULL:
-  config[5] = (double)k;
-  *N_plot = nt+1;
+  ctx->conf[5] = (double)k;
+  *N_plot = nt_plot+1;
   if(isfinite(time_c))
-      time_plot[nt] = time_c;
+      time_plot[nt_plot] = time_c;
   else if(isfinite(t_all))
-      time_plot[nt] = t_all;
+      time_plot[nt_plot] = t_all;
   else if(isfinite(tau))
-      time_plot[nt] = k*tau;
+      time_plot[nt_plot] = k*tau;
 
   free(s_u);
   free(s_p);
@@ -339,4 +510,11 @@ return_NULL:
   F_rho = NULL;
   F_u   = NULL;
   F_e   = NULL;
+  free(W);
+  free(X_s);
+  free(if_err);
+  W      = NULL;
+  X_s    = NULL;
+  if_err = NULL;
+  checkpoint_free(&ckpt);
 }
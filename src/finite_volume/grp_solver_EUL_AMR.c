@@ -0,0 +1,722 @@
+/**
+ * @file  grp_solver_EUL_AMR.c
+ * @brief This is an Eulerian GRP scheme with adaptive mesh refinement to solve 1-D Euler equations.
+ * @details The m cells of the initial data make the finest grid. The leaf cells of the adaptive mesh
+ *          are binary tree cells of the levels l = 0, 1, …, L with the lengths h*2^(L-l), where 'config[38]'
+ *          is L. Cells are refined where the density or pressure jumps or varies by more than the relative
+ *          threshold 'config[39]' over a cell, and sibling cells are merged where both vary by less than
+ *          a quarter of it. The levels of adjacent cells differ by at most one. The refinement interpolates
+ *          linearly and the merging averages the conservative variables, so both are conservative.
+ *          The numerical results are projected onto the finest grid for output.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <time.h>
+#include <stdbool.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "../include/var_struc.h"
+#include "../include/riemann_solver.h"
+#include "../include/inter_process.h"
+#include "../include/tools.h"
+#include "../include/file_io.h"
+
+
+//! Leaf cells of the 1-D adaptive mesh, from left to right.
+struct amr_mesh {
+    int n;                          //!< number of the leaf cells.
+    int * lev, * pos;               //!< level and index of the first covered cell of the finest grid.
+    double * RHO, * U, * P, * E;    //!< density, velocity, pressure and specific total energy.
+    double * d_rho, * d_u, * d_p;   //!< spatial derivatives (slopes).
+    double * X;                     //!< coordinates of the cell interfaces.
+};
+
+/**
+ * @brief This function allocates the arrays of an adaptive mesh for at most m leaf cells.
+ * @param[out] M: Pointer to the adaptive mesh.
+ * @param[in]  m: Number of the cells of the finest grid.
+ * @return Whether the allocation is successful.
+ */
+static _Bool amr_mesh_alloc(struct amr_mesh * M, const int m)
+{
+    M->n     = 0;
+    M->lev   = (int *)malloc(m * sizeof(int));
+    M->pos   = (int *)malloc(m * sizeof(int));
+    M->RHO   = (double *)malloc(m * sizeof(double));
+    M->U     = (double *)malloc(m * sizeof(double));
+    M->P     = (double *)malloc(m * sizeof(double));
+    M->E     = (double *)malloc(m * sizeof(double));
+    M->d_rho = (double *)calloc(m, sizeof(double));
+    M->d_u   = (double *)calloc(m, sizeof(double));
+    M->d_p   = (double *)calloc(m, sizeof(double));
+    M->X     = (double *)malloc((m+1) * sizeof(double));
+    return M->lev && M->pos && M->RHO && M->U && M->P && M->E && M->d_rho && M->d_u && M->d_p && M->X;
+}
+
+/**
+ * @brief This function frees the arrays of an adaptive mesh.
+ * @param[in,out] M: Pointer to the adaptive mesh.
+ */
+static void amr_mesh_free(struct amr_mesh * M)
+{
+    free(M->lev);
+    free(M->pos);
+    free(M->RHO);
+    free(M->U);
+    free(M->P);
+    free(M->E);
+    free(M->d_rho);
+    free(M->d_u);
+    free(M->d_p);
+    free(M->X);
+    M->lev   = NULL;
+    M->pos   = NULL;
+    M->RHO   = NULL;
+    M->U     = NULL;
+    M->P     = NULL;
+    M->E     = NULL;
+    M->d_rho = NULL;
+    M->d_u   = NULL;
+    M->d_p   = NULL;
+    M->X     = NULL;
+}
+
+/**
+ * @brief This function builds the leaf cells of the levels not lower than the target levels.
+ * @param[in]  L:   The finest level.
+ * @param[in]  m:   Number of the cells of the finest grid.
+ * @param[in]  tgt: Target levels of the cells of the finest grid.
+ * @param[out] M:   Pointer to the adaptive mesh (only the levels and positions are set).
+ */
+static void amr_mesh_build(const int L, const int m, const int * tgt, struct amr_mesh * M)
+{
+    int f = 0, l, w, i;
+    M->n = 0;
+    while(f < m)
+	{
+	    for(l = tgt[f]; l < L; ++l) // a cell must be aligned and cover no finer target
+		{
+		    w = 1 << (L-l);
+		    if(f % w || f + w > m)
+			continue;
+		    for(i = f; i < f+w && tgt[i] <= l; ++i)
+			;
+		    if(i == f+w)
+			break;
+		}
+	    M->lev[M->n] = l;
+	    M->pos[M->n] = f;
+	    M->n++;
+	    f += 1 << (L-l);
+	}
+}
+
+/**
+ * @brief This function gives the conservative variables of a leaf cell at an offset from its center.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in]  M: Pointer to the adaptive mesh.
+ * @param[in]  i: Index of the leaf cell.
+ * @param[in]  d: Offset from the center of the cell.
+ * @param[out] W: Density, momentum and total energy per unit volume.
+ */
+static inline void amr_cons_var(const struct run_ctx * ctx, const struct amr_mesh * M, const int i, const double d, double W[3])
+{
+    double const gamma = ctx->conf[6]; // the constant of the perfect gas
+    double const rho = M->RHO[i] + d*M->d_rho[i];
+    double const u   =   M->U[i] + d*M->d_u[i];
+    double const p   =   M->P[i] + d*M->d_p[i];
+    W[0] = rho;
+    W[1] = rho*u;
+    W[2] = p/(gamma-1.0) + 0.5*rho*u*u;
+}
+
+/**
+ * @brief This function adapts the mesh to the relative variations of density and pressure.
+ * @param[in] ctx:  Pointer to the run context.
+ * @param[in]  L:   The finest level.
+ * @param[in]  m:   Number of the cells of the finest grid.
+ * @param[in]  h:   Length of the cells of the finest grid.
+ * @param[in,out] A: Pointer to the adaptive mesh, whose slopes have been limited.
+ * @param[out] B:   Pointer to the adaptive mesh for work.
+ * @param[out] tgt: Work array of the target levels of the cells of the finest grid.
+ * @param[out] flag: Work array of the refinement indicators of the leaf cells.
+ * @return Whether the mesh is changed.
+ */
+static _Bool amr_regrid(const struct run_ctx * ctx, const int L, const int m, const double h, struct amr_mesh * A, struct amr_mesh * B, int * tgt, int * flag)
+{
+    double const eps    = ctx->conf[4];  // the largest value could be seen as zero
+    double const gamma  = ctx->conf[6];  // the constant of the perfect gas
+    double const thr    = ctx->conf[39]; // the relative threshold of the refinement
+    int i, a, f, l, w;
+    double ind, dx, w_a, W[3], S[3], slope[3];
+    _Bool changed, prolong;
+    struct amr_mesh T;
+
+    for(i = 0; i < A->n; ++i) // relative variations of density and pressure in leaf cells
+	{
+	    dx  = A->X[i+1] - A->X[i];
+	    ind = fmax(fabs(A->d_rho[i])*dx/A->RHO[i], fabs(A->d_p[i])*dx/A->P[i]);
+	    if(i)
+		ind = fmax(ind, fmax(fabs(A->RHO[i]-A->RHO[i-1])/A->RHO[i], fabs(A->P[i]-A->P[i-1])/A->P[i]));
+	    if(i < A->n-1)
+		ind = fmax(ind, fmax(fabs(A->RHO[i+1]-A->RHO[i])/A->RHO[i], fabs(A->P[i+1]-A->P[i])/A->P[i]));
+	    flag[i] = ind > thr ? 1 : (ind < 0.25*thr ? -1 : 0);
+	}
+    for(i = 0; i < A->n; ++i) // target levels with a buffer cell around the refined cells
+	{
+	    l = A->lev[i];
+	    if(flag[i] > 0 || (i && flag[i-1] > 0) || (i < A->n-1 && flag[i+1] > 0))
+		l = l < L ? l+1 : L;
+	    else if(flag[i] < 0)
+		l = l > 0 ? l-1 : 0;
+	    for(f = A->pos[i]; f < A->pos[i] + (1 << (L-A->lev[i])); ++f)
+		tgt[f] = l;
+	}
+    do // The levels of adjacent cells differ by at most one.
+	{
+	    amr_mesh_build(L, m, tgt, B);
+	    changed = false;
+	    for(i = 0; i < B->n-1; ++i)
+		if(abs(B->lev[i+1] - B->lev[i]) > 1)
+		    {
+			a = B->lev[i] < B->lev[i+1] ? i : i+1;
+			l = B->lev[i] < B->lev[i+1] ? B->lev[i+1]-1 : B->lev[i]-1;
+			for(f = B->pos[a]; f < B->pos[a] + (1 << (L-B->lev[a])); ++f)
+			    tgt[f] = l > tgt[f] ? l : tgt[f];
+			changed = true;
+		    }
+	}
+    while(changed);
+
+    if(B->n == A->n)
+	{
+	    for(i = 0; i < A->n && B->lev[i] == A->lev[i]; ++i)
+		;
+	    if(i == A->n)
+		return false;
+	}
+
+//=================Conservative transfer to the new mesh=====================
+    for(i = 0, a = 0; i < B->n; ++i)
+	{
+	    while(A->pos[a] + (1 << (L-A->lev[a])) <= B->pos[i])
+		a++;
+	    w   = 1 << (L-B->lev[i]);
+	    B->X[i] = h * B->pos[i];
+	    if(A->lev[a] == B->lev[i]) // the same cell
+		{
+		    B->RHO[i]   =   A->RHO[a];
+		    B->U[i]     =     A->U[a];
+		    B->P[i]     =     A->P[a];
+		    B->E[i]     =     A->E[a];
+		    B->d_rho[i] = A->d_rho[a];
+		    B->d_u[i]   =   A->d_u[a];
+		    B->d_p[i]   =   A->d_p[a];
+		    continue;
+		}
+	    else if(A->lev[a] < B->lev[i]) // a child cell
+		{
+		    dx = h * (B->pos[i] + 0.5*w) - 0.5*(A->X[a] + A->X[a+1]);
+		    // The linear interpolation is kept if it is positive at both cell boundaries of the parent.
+		    w_a = 0.5*(A->X[a+1] - A->X[a]);
+		    amr_cons_var(ctx, A, a, -w_a, W);
+		    amr_cons_var(ctx, A, a,  w_a, S);
+		    prolong = W[0] > eps && S[0] > eps && W[2] - 0.5*W[1]*W[1]/W[0] > eps && S[2] - 0.5*S[1]*S[1]/S[0] > eps;
+		    if(prolong)
+			{
+			    amr_cons_var(ctx, A, a, 0.0, W);
+			    amr_cons_var(ctx, A, a, 0.5*w_a, S);
+			    slope[0] = (S[0] - W[0]) / (0.5*w_a);
+			    slope[1] = (S[1] - W[1]) / (0.5*w_a);
+			    slope[2] = (S[2] - W[2]) / (0.5*w_a);
+			    W[0] += dx*slope[0];
+			    W[1] += dx*slope[1];
+			    W[2] += dx*slope[2];
+			}
+		    else
+			amr_cons_var(ctx, A, a, 0.0, W);
+		    B->d_rho[i] = A->d_rho[a];
+		    B->d_u[i]   =   A->d_u[a];
+		    B->d_p[i]   =   A->d_p[a];
+		}
+	    else // a parent cell of the old cells
+		{
+		    W[0] = W[1] = W[2] = 0.0;
+		    B->d_rho[i] = B->d_u[i] = B->d_p[i] = 0.0;
+		    for(; a < A->n && A->pos[a] < B->pos[i] + w; ++a)
+			{
+			    w_a = (double)(1 << (L-A->lev[a])) / (double)w;
+			    amr_cons_var(ctx, A, a, 0.0, S);
+			    W[0] += w_a*S[0];
+			    W[1] += w_a*S[1];
+			    W[2] += w_a*S[2];
+			    B->d_rho[i] += w_a*A->d_rho[a];
+			    B->d_u[i]   += w_a*A->d_u[a];
+			    B->d_p[i]   += w_a*A->d_p[a];
+			}
+		    a--;
+		}
+	    B->RHO[i] = W[0];
+	    B->U[i]   = W[1]/W[0];
+	    B->E[i]   = W[2]/W[0];
+	    B->P[i]   = (W[2] - 0.5*W[1]*B->U[i])*(gamma-1.0);
+	}
+    B->X[B->n] = h * m;
+
+    T  = *A;
+    *A = *B;
+    *B = T;
+    return true;
+}
+
+/**
+ * @brief This function projects the leaf cells linearly onto the finest grid.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in]  L:  The finest level.
+ * @param[in]  A:  Pointer to the adaptive mesh.
+ * @param[in]  h:  Length of the cells of the finest grid.
+ * @param[out] RHO, U, P, E: Arrays of the fluid variables on the finest grid.
+ */
+static void amr_project(const struct run_ctx * ctx, const int L, const struct amr_mesh * A, const double h, double * RHO, double * U, double * P, double * E)
+{
+    double const eps   = ctx->conf[4]; // the largest value could be seen as zero
+    double const gamma = ctx->conf[6]; // the constant of the perfect gas
+    double d;
+    int i, f;
+    for(i = 0; i < A->n; ++i)
+	for(f = A->pos[i]; f < A->pos[i] + (1 << (L-A->lev[i])); ++f)
+	    {
+		d = h*(f + 0.5) - 0.5*(A->X[i] + A->X[i+1]);
+		RHO[f] = A->RHO[i] + d*A->d_rho[i];
+		U[f]   =   A->U[i] + d*A->d_u[i];
+		P[f]   =   A->P[i] + d*A->d_p[i];
+		if(RHO[f] < eps || P[f] < eps)
+		    {
+			RHO[f] = A->RHO[i];
+			U[f]   =   A->U[i];
+			P[f]   =   A->P[i];
+		    }
+		E[f] = 0.5*U[f]*U[f] + P[f]/(gamma - 1.0)/RHO[f];
+	    }
+}
+
+/**
+ * @brief This function use GRP scheme with adaptive mesh refinement to solve 1-D Euler
+ *        equations of motion on Eulerian coordinate.
+ * @param[in,out] ctx:    Pointer to the run context.
+ * @param[in] m:          Number of the grids.
+ * @param[in,out] CV:     Structure of cell variable data.
+ * @param[out] cpu_time:  Array of the CPU time recording.
+ * @param[in]  problem:   Name of the numerical results for the test problem.
+ * @param[in]  N_T:       Number of levels storing fluid variables in memory.
+ * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
+ * @param[in,out] time_plot: Array of the plotting time recording.
+ */
+void GRP_solver_EUL_AMR(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[])
+{
+#ifdef _OPENMP
+  printf("@@ Number of threads for OpenMP: %d\n", omp_get_max_threads());
+#endif
+    /*
+     * j is a frequently used index for spatial variables.
+     * k is a frequently used index for the time step.
+     */
+  int j, k = 0;
+
+  double tic, toc;
+  double cpu_time_sum = 0.0;
+
+  double const t_all = ctx->conf[1];      // the total time
+  double const eps   = ctx->conf[4];      // the largest value could be seen as zero
+  int    const N     = (int)ctx->conf[5]; // the maximum number of time steps
+  double const gamma = ctx->conf[6];      // the constant of the perfect gas
+  double const CFL   = ctx->conf[7];      // the CFL number
+  double const h     = ctx->conf[10];     // the length of the initial spatial grids
+  double       tau   = ctx->conf[16];     // the length of the time step
+  int          L     = (int)ctx->conf[38];// the finest level of the adaptive mesh
+
+  _Bool find_bound = false;
+
+  double Mom, Ene;
+  double c_L, c_R; // the speeds of sound
+  double h_L, h_R; // length of spatial grids
+  /*
+   * dire: the temporal derivative of fluid variables.
+   *       \frac{\partial [rho, u, p]}{\partial t}
+   * mid:  the Riemann solutions.
+   *       [rho_star, u_star, p_star]
+   */
+  double dire[3], mid[3];
+
+  double nu;  // nu = tau/h
+  double h_S_max; // h/S_max, S_max is the maximum wave speed
+  double time_c = 0.0; // the current time
+  _Bool stop_t = false;
+  int data_err; // whether there is miscalculation in the parallel loops
+  int nt = 0, nt_plot = 0; // the number of times storing plotting data
+  _Bool const stream = (_Bool)ctx->conf[34]; // streaming output of the plotting data
+  double n_cell = 0.0; // the number of the leaf cells summed over the time steps
+
+  struct b_f_var bfv_L = {.SRHO = 0.0, .SP = 0.0, .SU = 0.0}, bfv_R = bfv_L; // Left/Right boundary condition
+  struct i_f_var ifv_L = {.gamma = gamma}, ifv_R = ifv_L;
+
+  double ** RHO  = CV.RHO;
+  double ** U    = CV.U;
+  double ** P    = CV.P;
+  double ** E    = CV.E;
+  // the leaf cells of the adaptive mesh and a mesh for work
+  struct amr_mesh A, B;
+  _Bool const alloc = amr_mesh_alloc(&A, m) & amr_mesh_alloc(&B, m);
+  // the leaf cells as the structure of cell variable data for the boundary conditions and slope limiter
+  struct cell_var_stru LV = {NULL};
+  LV.RHO = &A.RHO;
+  LV.U   = &A.U;
+  LV.P   = &A.P;
+  LV.E   = &A.E;
+  // the variable values at (x_{j-1/2}, t_{n+1}).
+  double * U_next   = (double*)malloc((m+1) * sizeof(double));
+  double * P_next   = (double*)malloc((m+1) * sizeof(double));
+  double * RHO_next = (double*)malloc((m+1) * sizeof(double));
+  // the temporal derivatives at (x_{j-1/2}, t_{n}).
+  double * U_t   = (double*)malloc((m+1) * sizeof(double));
+  double * P_t   = (double*)malloc((m+1) * sizeof(double));
+  double * RHO_t = (double*)malloc((m+1) * sizeof(double));
+  // the numerical flux at (x_{j-1/2}, t_{n}).
+  double * F_rho = (double*)malloc((m+1) * sizeof(double));
+  double * F_u   = (double*)malloc((m+1) * sizeof(double));
+  double * F_e   = (double*)malloc((m+1) * sizeof(double));
+  int * if_err   = (int*)malloc((m+1) * sizeof(int)); // the miscalculation indicators at (x_{j-1/2}, t_{n}).
+  int * tgt      = (int*)malloc(m * sizeof(int));     // the target levels of the cells of the finest grid
+  int * flag     = (int*)malloc(m * sizeof(int));     // the refinement indicators of the leaf cells
+  if(!alloc)
+      {
+	  printf("NOT enough memory! Adaptive mesh\n");
+	  goto return_NULL;
+      }
+  if(U_next == NULL || P_next == NULL || RHO_next == NULL)
+      {
+	  printf("NOT enough memory! Variables_next\n");
+	  goto return_NULL;
+      }
+  if(U_t == NULL || P_t == NULL || RHO_t == NULL)
+      {
+	  printf("NOT enough memory! Temproal derivative\n");
+	  goto return_NULL;
+      }
+  if(F_rho == NULL || F_u == NULL || F_e == NULL || if_err == NULL)
+      {
+	  printf("NOT enough memory! Flux\n");
+	  goto return_NULL;
+      }
+  if(tgt == NULL || flag == NULL)
+      {
+	  printf("NOT enough memory! Refinement levels\n");
+	  goto return_NULL;
+      }
+  while(m % (1 << L))
+      L--;
+  if(L < (int)ctx->conf[38])
+      printf("The finest level of the adaptive mesh is reduced to %d so that it divides %d cells.\n", L, m);
+
+  // The initial data on the finest grid is coarsened level by level.
+  for(j = 0; j < m; ++j)
+      {
+	  A.lev[j] = L;
+	  A.pos[j] = j;
+	  A.RHO[j] = RHO[0][j];
+	  A.U[j]   =   U[0][j];
+	  A.P[j]   =   P[0][j];
+	  A.E[j]   =   E[0][j];
+	  A.X[j]   = h * j;
+      }
+  A.X[m] = h * m;
+  A.n = m;
+  for(k = 0; k < L; ++k)
+      {
+	  LV.d_rho = A.d_rho;
+	  LV.d_u   = A.d_u;
+	  LV.d_p   = A.d_p;
+	  find_bound = bound_cond_slope_limiter(ctx, true, A.n, 0, &LV, &bfv_L, &bfv_R, find_bound, true, time_c, A.X);
+	  if(!find_bound)
+	      goto return_NULL;
+	  amr_regrid(ctx, L, m, h, &A, &B, tgt, flag);
+      }
+  printf("The adaptive mesh is initialized with %d cells on %d levels.\n", A.n, L+1);
+
+//-----------------------THE MAIN LOOP--------------------------------
+  for(k = 1; k <= N; ++k)
+  {
+      tic = wall_time();
+
+      LV.d_rho = A.d_rho;
+      LV.d_u   = A.d_u;
+      LV.d_p   = A.d_p;
+      find_bound = bound_cond_slope_limiter(ctx, true, A.n, 0, &LV, &bfv_L, &bfv_R, find_bound, true, time_c, A.X);
+      if(!find_bound)
+	  goto return_NULL;
+
+      if (time_c >= time_plot[nt_plot] - eps && nt_plot < (*N_plot-1))
+	  {
+	      PHASE_TIC(PT_IO);
+	      amr_project(ctx, L, &A, h, RHO[nt], U[nt], P[nt], E[nt]);
+	      if(stream)
+		  file_1D_write_stream(ctx, m, nt_plot, CV, nt, NULL, NULL, problem, time_plot[nt_plot]);
+	      PHASE_TOC(PT_IO);
+	      nt_plot++;
+	      if (nt < (N_T-1))
+		  nt++;
+	  }
+
+      PHASE_TIC(PT_SLOPE);
+      if(amr_regrid(ctx, L, m, h, &A, &B, tgt, flag)) // the slopes on the new mesh
+	  {
+	      LV.d_rho = A.d_rho;
+	      LV.d_u   = A.d_u;
+	      LV.d_p   = A.d_p;
+	      find_bound = bound_cond_slope_limiter(ctx, true, A.n, 0, &LV, &bfv_L, &bfv_R, find_bound, true, time_c, A.X);
+	      if(!find_bound)
+		  goto return_NULL;
+	  }
+      n_cell += A.n;
+      PHASE_TOC(PT_SLOPE);
+
+      h_S_max = INFINITY; // h/S_max = INFINITY
+
+      PHASE_TIC(PT_SOLVE);
+      data_err = 0;
+#pragma omp parallel for private(c_L, c_R, h_L, h_R, dire, mid) firstprivate(ifv_L, ifv_R) reduction(min:h_S_max) reduction(|:data_err)
+      for(j = 0; j <= A.n; ++j)
+	  { /*
+	     *  j-1          j          j+1
+	     * j-1/2  j-1  j+1/2   j   j+3/2  j+1
+	     *   o-----X-----o-----X-----o-----X--...
+	     */
+	      if(j) // Initialize the initial values.
+		  {
+		      h_L       = A.X[j] - A.X[j-1];
+		      ifv_L.RHO = A.RHO[j-1] + 0.5*h_L*A.d_rho[j-1];
+		      ifv_L.U   =   A.U[j-1] + 0.5*h_L*A.d_u[j-1];
+		      ifv_L.P   =   A.P[j-1] + 0.5*h_L*A.d_p[j-1];
+		      ifv_L.d_rho = A.d_rho[j-1];
+		      ifv_L.d_u   =   A.d_u[j-1];
+		      ifv_L.d_p   =   A.d_p[j-1];
+		  }
+	      else
+		  {
+		      h_L       = bfv_L.H;
+		      ifv_L.RHO = bfv_L.RHO + 0.5*h_L*bfv_L.SRHO;
+		      ifv_L.U   = bfv_L.U   + 0.5*h_L*bfv_L.SU;
+		      ifv_L.P   = bfv_L.P   + 0.5*h_L*bfv_L.SP;
+		      ifv_L.d_rho = bfv_L.SRHO;
+		      ifv_L.d_u   = bfv_L.SU;
+		      ifv_L.d_p   = bfv_L.SP;
+		  }
+	      if(j < A.n)
+		  {
+		      h_R       = A.X[j+1] - A.X[j];
+		      ifv_R.RHO = A.RHO[j] - 0.5*h_R*A.d_rho[j];
+		      ifv_R.U   =   A.U[j] - 0.5*h_R*A.d_u[j];
+		      ifv_R.P   =   A.P[j] - 0.5*h_R*A.d_p[j];
+		      ifv_R.d_rho = A.d_rho[j];
+		      ifv_R.d_u   =   A.d_u[j];
+		      ifv_R.d_p   =   A.d_p[j];
+		  }
+	      else
+		  {
+		      h_R       = bfv_R.H;
+		      ifv_R.RHO = bfv_R.RHO + 0.5*h_R*bfv_R.SRHO;
+		      ifv_R.U   = bfv_R.U   + 0.5*h_R*bfv_R.SU;
+		      ifv_R.P   = bfv_R.P   + 0.5*h_R*bfv_R.SP;
+		      ifv_R.d_rho = bfv_R.SRHO;
+		      ifv_R.d_u   = bfv_R.SU;
+		      ifv_R.d_p   = bfv_R.SP;
+		  }
+
+	      c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);
+	      c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);
+	      h_S_max = fmin(h_S_max, h_L/(fabs(ifv_L.U)+fabs(c_L)));
+	      h_S_max = fmin(h_S_max, h_R/(fabs(ifv_R.U)+fabs(c_R)));
+
+	      if((if_err[j] = ifvar_check_code(ctx, &ifv_L, &ifv_R, 1)))
+		  {
+		      data_err = 1;
+		      continue;
+		  }
+
+//========================Solve GRP========================
+	      linear_GRP_solver_Edir(dire, mid, &ifv_L, &ifv_R, eps, eps);
+
+	      RHO_next[j] = mid[0];
+	      U_next[j]   = mid[1];
+	      P_next[j]   = mid[2];
+	      RHO_t[j]    = dire[0];
+	      U_t[j]      = dire[1];
+	      P_t[j]      = dire[2];
+	      if((if_err[j] = -star_dire_check_code(ctx, mid, dire, 1)))
+		  data_err = 1;
+	  }
+      if(data_err) // Report the miscalculation in order of the interfaces.
+	  for(j = 0; j <= A.n; ++j)
+	      {
+		  if(if_err[j] > 0)
+		      {
+			  printf("%s on [%d, %d] (t_n, x).\n", ifvar_check_msg(if_err[j], 1), k, j);
+			  goto return_NULL;
+		      }
+		  else if(if_err[j] < 0)
+		      {
+			  printf("%s on [%d, %d] (t_n, x).\n", star_dire_check_msg(-if_err[j]), k, j);
+			  stop_t = true;
+		      }
+	      }
+      PHASE_TOC(PT_SOLVE);
+
+//====================Time step and grid fixed======================
+    PHASE_TIC(PT_CFL);
+    // If no total time, use fixed tau and time step N.
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
+	{
+	    tau = CFL * h_S_max;
+	    if(tau < eps)
+		{
+		    printf("\nThe length of the time step is so small on [%d, %g, %g] (t_n, time_c, tau)\n", k, time_c, tau);
+		    stop_t = true;
+		}
+	    else if((time_c + tau) > (t_all - eps))
+		tau = t_all - time_c;
+	    else if(!isfinite(tau))
+		{
+		    printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, tau) - CFL\n", k, time_c, tau);
+		    goto return_NULL;
+		}
+	    else if(nt_plot < (*N_plot-1) && (time_c + tau) > (time_plot[nt_plot] - eps))
+		tau = time_plot[nt_plot] - time_c; // The step lands on the plotting time.
+	}
+    PHASE_TOC(PT_CFL);
+
+    PHASE_TIC(PT_FLUX);
+#pragma omp parallel for
+    for(j = 0; j <= A.n; ++j)
+	{
+	    RHO_next[j] += 0.5 * tau * RHO_t[j];
+	    U_next[j]   += 0.5 * tau * U_t[j];
+	    P_next[j]   += 0.5 * tau * P_t[j];
+
+	    F_rho[j] = RHO_next[j]*U_next[j];
+	    F_u[j] = F_rho[j]*U_next[j] + P_next[j];
+	    F_e[j] = (gamma/(gamma-1.0))*P_next[j] + 0.5*F_rho[j]*U_next[j];
+	    F_e[j] = F_e[j]*U_next[j];
+
+	    RHO_next[j] += 0.5 * tau * RHO_t[j];
+	    U_next[j]   += 0.5 * tau * U_t[j];
+	    P_next[j]   += 0.5 * tau * P_t[j];
+	}
+    PHASE_TOC(PT_FLUX);
+
+//======================THE CORE ITERATION=========================(On Eulerian Coordinate)
+    PHASE_TIC(PT_UPDATE);
+    data_err = 0;
+#pragma omp parallel for private(Mom, Ene, nu) reduction(|:data_err)
+    for(j = 0; j < A.n; ++j) // forward Euler
+	{ /*
+	   *  j-1          j          j+1
+	   * j-1/2  j-1  j+1/2   j   j+3/2  j+1
+	   *   o-----X-----o-----X-----o-----X--...
+	   */
+	    nu  = tau / (A.X[j+1] - A.X[j]);
+	    Mom = A.RHO[j]*A.U[j] - nu*(F_u[j+1]  -F_u[j]);
+	    Ene = A.RHO[j]*A.E[j] - nu*(F_e[j+1]  -F_e[j]);
+	    A.RHO[j]  =  A.RHO[j] - nu*(F_rho[j+1]-F_rho[j]);
+
+	    A.U[j] = Mom / A.RHO[j];
+	    A.E[j] = Ene / A.RHO[j];
+	    A.P[j] = (Ene - 0.5*Mom*A.U[j])*(gamma-1.0);
+
+	    if(A.P[j] < eps || A.RHO[j] < eps)
+		data_err = 1;
+
+//============================compute the slopes============================
+	    A.d_u[j]   = (  U_next[j+1] -   U_next[j])/(A.X[j+1] - A.X[j]);
+	    A.d_p[j]   = (  P_next[j+1] -   P_next[j])/(A.X[j+1] - A.X[j]);
+	    A.d_rho[j] = (RHO_next[j+1] - RHO_next[j])/(A.X[j+1] - A.X[j]);
+	}
+    if(data_err) // Report the miscalculation in order of the cells.
+	for(j = 0; j < A.n; ++j)
+	    if(A.P[j] < eps || A.RHO[j] < eps)
+		{
+		    printf("<0.0 error on [%d, %d] (t_n, x) - Update\n", k, j);
+		    stop_t = true;
+		}
+    PHASE_TOC(PT_UPDATE);
+
+//============================Time update=======================
+
+    time_c += tau;
+    if(isfinite(t_all))
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
+    else
+        telemetry_step(k*100.0/N, k, time_c, tau);
+    file_1D_publish(ctx, A.n, k, LV, 0, A.X, time_c); // the leaf cells
+    if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
+	break;
+
+//===========================Fixed variable location=======================
+
+    toc = wall_time();
+    cpu_time_sum += toc - tic;
+    cpu_time[nt]  = cpu_time_sum;
+  }
+
+  // the final data on the finest grid
+  LV.d_rho = A.d_rho;
+  LV.d_u   = A.d_u;
+  LV.d_p   = A.d_p;
+  bound_cond_slope_limiter(ctx, true, A.n, 0, &LV, &bfv_L, &bfv_R, find_bound, true, time_c, A.X);
+  amr_project(ctx, L, &A, h, RHO[nt], U[nt], P[nt], E[nt]);
+
+  printf("\nTime is up at time step %d.\n", k);
+  printf("The cost of wall-clock time for 1D-GRP Eulerian AMR scheme for this problem is %g seconds.\n", cpu_time_sum);
+  printf("The adaptive mesh has %g%% of the cells of the finest grid on average, %d cells at last.\n", 100.0*n_cell/((k < N ? k : N)*(double)m), A.n);
+//---------------------END OF THE MAIN LOOP----------------------
+
+return_NULL:
+  ctx->conf[5] = (double)k;
+  *N_plot = nt_plot+1;
+  if(isfinite(time_c))
+      time_plot[nt_plot] = time_c;
+  else if(isfinite(t_all))
+      time_plot[nt_plot] = t_all;
+  else if(isfinite(tau))
+      time_plot[nt_plot] = k*tau;
+
+  amr_mesh_free(&A);
+  amr_mesh_free(&B);
+  free(U_next);
+  free(P_next);
+  free(RHO_next);
+  U_next   = NULL;
+  P_next   = NULL;
+  RHO_next = NULL;
+  free(U_t);
+  free(P_t);
+  free(RHO_t);
+  U_t   = NULL;
+  P_t   = NULL;
+  RHO_t = NULL;
+  free(F_rho);
+  free(F_u);
+  free(F_e);
+  F_rho = NULL;
+  F_u   = NULL;
+  F_e   = NULL;
+  free(if_err);
+  free(tgt);
+  free(flag);
+  if_err = NULL;
+  tgt    = NULL;
+  flag   = NULL;
+}
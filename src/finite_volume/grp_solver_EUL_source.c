@@ -8,61 +8,169 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdbool.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "../include/var_struc.h"
 #include "../include/riemann_solver.h"
 #include "../include/inter_process.h"
 #include "../include/tools.h"
+#include "../include/file_io.h"
 
 
+/**
+ * @brief The states on both sides of the interface j of the batch of the interfaces from jb, with its CFL condition.
+ * @details B_L and B_R tell whether j is the left (j = 0) or the right (j = m) boundary interface,
+ *          whose states are given by the boundary conditions 'bfv_L' and 'bfv_R'. It is the body of IFACE_PEEL_LOOP().
+ *          \verbatim
+ *           j-1          j          j+1
+ *          j-1/2  j-1  j+1/2   j   j+3/2  j+1
+ *            o-----X-----o-----X-----o-----X--...
+ *          \endverbatim
+ */
+#define EUL_IFACE_STATE(B_L, B_R)					\
+    do {								\
+	if(!(B_L)) /* Initialize the initial values. */			\
+	    {								\
+		ifv_L.RHO = RHO[nt][j-1] + 0.5*h*s_rho[j-1];		\
+		ifv_L.U   =   U[nt][j-1] + 0.5*h*s_u[j-1];		\
+		ifv_L.P   =   P[nt][j-1] + 0.5*h*s_p[j-1];		\
+	    }								\
+	else								\
+	    {								\
+		ifv_L.RHO = bfv_L.RHO + 0.5*h*bfv_L.SRHO;		\
+		ifv_L.U   = bfv_L.U   + 0.5*h*bfv_L.SU;			\
+		ifv_L.P   = bfv_L.P   + 0.5*h*bfv_L.SP;			\
+	    }								\
+	if(!(B_R))							\
+	    {								\
+		ifv_R.RHO = RHO[nt][j] - 0.5*h*s_rho[j];		\
+		ifv_R.U   =   U[nt][j] - 0.5*h*s_u[j];			\
+		ifv_R.P   =   P[nt][j] - 0.5*h*s_p[j];			\
+	    }								\
+	else								\
+	    {								\
+		ifv_R.RHO = bfv_R.RHO + 0.5*h*bfv_R.SRHO;		\
+		ifv_R.U   = bfv_R.U   + 0.5*h*bfv_R.SU;			\
+		ifv_R.P   = bfv_R.P   + 0.5*h*bfv_R.SP;			\
+	    }								\
+									\
+	c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);			\
+	c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);			\
+	h_S_max = fmin(h_S_max, h/(fabs(ifv_L.U)+fabs(c_L)));		\
+	h_S_max = fmin(h_S_max, h/(fabs(ifv_R.U)+fabs(c_R)));		\
+									\
+	if(!(B_L)) /* calculate the material derivatives */		\
+	    {								\
+		ifv_L.d_u   =   s_u[j-1];				\
+		ifv_L.d_p   =   s_p[j-1];				\
+		ifv_L.d_rho = s_rho[j-1];				\
+	    }								\
+	else								\
+	    {								\
+		ifv_L.d_rho = bfv_L.SRHO;				\
+		ifv_L.d_u   = bfv_L.SU;					\
+		ifv_L.d_p   = bfv_L.SP;					\
+	    }								\
+	if(!(B_R))							\
+	    {								\
+		ifv_R.d_u   =   s_u[j];					\
+		ifv_R.d_p   =   s_p[j];					\
+		ifv_R.d_rho = s_rho[j];					\
+	    }								\
+	else								\
+	    {								\
+		ifv_R.d_rho = bfv_R.SRHO;				\
+		ifv_R.d_u   = bfv_R.SU;					\
+		ifv_R.d_p   = bfv_R.SP;					\
+	    }								\
+	l = j - jb; /* the lane of the interface, all of which are checked in a batch */ \
+	qs[l] = quiet && ifvar_quiescent(&ifv_L, &ifv_R, eps);		\
+	if(!single)							\
+	    gam[l] = ifv_L.gamma;					\
+	RHO_L[l]   = ifv_L.RHO;						\
+	U_L[l]     = ifv_L.U;						\
+	P_L[l]     = ifv_L.P;						\
+	d_rho_L[l] = ifv_L.d_rho;					\
+	d_u_L[l]   = ifv_L.d_u;						\
+	d_p_L[l]   = ifv_L.d_p;						\
+	RHO_R[l]   = ifv_R.RHO;						\
+	U_R[l]     = ifv_R.U;						\
+	P_R[l]     = ifv_R.P;						\
+	d_rho_R[l] = ifv_R.d_rho;					\
+	d_u_R[l]   = ifv_R.d_u;						\
+	d_p_R[l]   = ifv_R.d_p;						\
+    } while (0)
+
 /**
  * @brief This function use GRP scheme to solve 1-D Euler
  *        equations of motion on Eulerian coordinate.
+ * @param[in,out] ctx:    Pointer to the run context.
  * @param[in] m:          Number of the grids.
  * @param[in,out] CV:     Structure of cell variable data.
  * @param[out] cpu_time:  Array of the CPU time recording.
+ * @param[in]  problem:   Name of the numerical results for the test problem.
+ * @param[in]  N_T:       Number of levels storing fluid variables in memory.
  * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
  * @param[in,out] time_plot: Array of the plotting time recording.
  */
-void GRP_solver_EUL_source(const int m, struct cell_var_stru CV, double * cpu_time, int * N_plot, double time_plot[])
+void GRP_solver_EUL_source(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[])
 {
+#ifdef _OPENMP
+  printf("@@ Number of threads for OpenMP: %d\n", omp_get_max_threads());
+#endif
     /* 
      * j is a frequently used index for spatial variables.
      * k is a frequently used index for the time step.
      */
-  int j, k = 0;
+  int j, jb, k = 0;
 
-  clock_t tic, toc;
+  double tic, toc;
   double cpu_time_sum = 0.0;
 
-  double const t_all = config[1];      // the total time
-  double const eps   = config[4];      // the largest value could be seen as zero
-  int    const N     = (int)config[5]; // the maximum number of time steps
-  double const gamma = config[6];      // the constant of the perfect gas
-  double const CFL   = config[7];      // the CFL number
-  double const h     = config[10];     // the length of the initial spatial grids
-  double       tau   = config[16];     // the length of the time step
+  double const t_all = ctx->conf[1];      // the total time
+  double const eps   = ctx->conf[4];      // the largest value could be seen as zero
+  int    const N     = (int)ctx->conf[5]; // the maximum number of time steps
+  double const gamma = ctx->conf[6];      // the constant of the perfect gas
+  double const CFL   = ctx->conf[7];      // the CFL number
+  double const h     = ctx->conf[10];     // the length of the initial spatial grids
+  double       tau   = ctx->conf[16];     // the length of the time step
 
   _Bool find_bound = false;
 
   double Mom, Ene;
   double c_L, c_R; // the speeds of sound
   /*
-   * dire: the temporal derivative of fluid variables.
+   * dire: the arrays of the temporal derivative of fluid variables at the interfaces.
    *       \frac{\partial [rho, u, p]}{\partial t}
-   * mid:  the Riemann solutions.
+   * mid:  the arrays of the Riemann solutions at the interfaces.
    *       [rho_star, u_star, p_star]
    */
-  double dire[3], mid[3];
+  const double * dire[3], * mid[3];
 
   double nu;  // nu = tau/h
   double h_S_max; // h/S_max, S_max is the maximum wave speed
   double time_c = 0.0; // the current time
   _Bool stop_t = false;
-  int nt = 0; // the number of times storing plotting data
+  int data_err; // whether there is miscalculation in the parallel loops
+  int j_err, err; // the first interface of the miscalculation and its indicator
+  int const n_check = (int)ctx->conf[72]; // the number of time steps between the batch checks of the interfaces
+  _Bool check; // whether the interfaces are checked at this time step
+  int nt = 0, nt_plot = 0; // the number of times storing plotting data
+  int nt_w; // the level written by the time step, the next one after a plotting time
+  _Bool const stream = (_Bool)ctx->conf[34]; // streaming output of the plotting data
+  _Bool const quiet  = (_Bool)ctx->conf[36]; // skip the GRP solver at the interfaces in quiescent regions
+  long n_solve = 0, n_face = 0; // the numbers of the GRP solvers called and of the interfaces
+  int    const n_ckpt  = (int)ctx->conf[43];   // the number of time steps between the checkpoints
+  _Bool  const restart = (_Bool)ctx->conf[44]; // restart from the checkpoint
+  struct ckpt_var ckpt = {0}; // the checkpoint of the state of the time loop
 
   struct b_f_var bfv_L = {.SRHO = 0.0, .SP = 0.0, .SU = 0.0}, bfv_R = bfv_L; // Left/Right boundary condition
   struct i_f_var ifv_L = {.gamma = gamma}, ifv_R = ifv_L;
+  _Bool const single = (int)ctx->conf[2] <= 1; // single-fluid flow with the constant gamma
+  struct gamma_const gc; // the constants of the perfect gas
+  gamma_const_set(&gc, gamma);
 
   double ** RHO  = CV.RHO;
   double ** U    = CV.U;
@@ -87,6 +195,9 @@ void GRP_solver_EUL_source(const int m, struct cell_var_stru CV, double * cpu_ti
   double * F_rho = (double*)malloc((m+1) * sizeof(double));
   double * F_u   = (double*)malloc((m+1) * sizeof(double));
   double * F_e   = (double*)malloc((m+1) * sizeof(double));
+  int * if_err   = (int*)malloc((m+1) * sizeof(int)); // the miscalculation indicators at (x_{j-1/2}, t_{n}).
+  mid[0]  = RHO_next; mid[1]  = U_next; mid[2]  = P_next;
+  dire[0] = RHO_t;    dire[1] = U_t;    dire[2] = P_t;
   if(s_rho == NULL || s_u == NULL || s_p == NULL)
       {
 	  printf("NOT enough memory! Slope\n");
@@ -102,120 +213,157 @@ void GRP_solver_EUL_source(const int m, struct cell_var_stru CV, double * cpu_ti
 	  printf("NOT enough memory! Temproal derivative\n");
 	  goto return_NULL;
       }
-  if(F_rho == NULL || F_u == NULL || F_e == NULL)
+  if(F_rho == NULL || F_u == NULL || F_e == NULL || if_err == NULL)
       {
 	  printf("NOT enough memory! Flux\n");
 	  goto return_NULL;
       }
   
+  if(n_ckpt > 0 || restart) // the state of the time loop
+      {
+	  if(checkpoint_init(ctx, &ckpt, problem))
+	      goto return_NULL;
+	  checkpoint_add(&ckpt, &k,            sizeof(k));
+	  checkpoint_add(&ckpt, &time_c,       sizeof(time_c));
+	  checkpoint_add(&ckpt, &tau,          sizeof(tau));
+	  checkpoint_add(&ckpt, &nt,           sizeof(nt));
+	  checkpoint_add(&ckpt, &nt_plot,      sizeof(nt_plot));
+	  checkpoint_add(&ckpt, &find_bound,   sizeof(find_bound));
+	  checkpoint_add(&ckpt, &cpu_time_sum, sizeof(cpu_time_sum));
+	  checkpoint_add(&ckpt, &n_solve,      sizeof(n_solve));
+	  checkpoint_add(&ckpt, &n_face,       sizeof(n_face));
+	  checkpoint_add(&ckpt, &bfv_L,        sizeof(bfv_L));
+	  checkpoint_add(&ckpt, &bfv_R,        sizeof(bfv_R));
+	  checkpoint_add(&ckpt, cpu_time, N_T * sizeof(double));
+	  checkpoint_add(&ckpt, s_rho,    m * sizeof(double));
+	  checkpoint_add(&ckpt, s_u,      m * sizeof(double));
+	  checkpoint_add(&ckpt, s_p,      m * sizeof(double));
+	  checkpoint_add_1D(&ckpt, m, N_T, CV, NULL);
+	  if(restart && checkpoint_read(&ckpt))
+	      goto return_NULL;
+      }
+
 //-----------------------THE MAIN LOOP--------------------------------
-  for(k = 1; k <= N; ++k)
+  for(k = restart ? k+1 : 1; k <= N; ++k) // Go on from the time step after the checkpoint.
   {
-      tic = clock();
-      if (time_c >= time_plot[nt] && nt < (*N_plot-1))
+      tic = wall_time();
+      nt_w = nt;
+      if (time_c >= time_plot[nt_plot] - eps && nt_plot < (*N_plot-1))
 	  {
-	      for(j = 0; j < m; ++j)
+	      if(stream)
 		  {
-		      RHO[nt+1][j] = RHO[nt][j];
-		      U[nt+1][j]   =   U[nt][j];
-		      E[nt+1][j]   =   E[nt][j];  
-		      P[nt+1][j]   =   P[nt][j];
+		      PHASE_TIC(PT_IO);
+		      file_1D_write_stream(ctx, m, nt_plot, CV, nt, NULL, NULL, problem, time_plot[nt_plot]);
+		      PHASE_TOC(PT_IO);
 		  }
-	      nt++;
+	      nt_plot++;
+	      if (nt < (N_T-1)) // The next step writes the next level from this one, which is kept for the plot.
+		  nt_w = nt+1;
 	  }
 
       h_S_max = INFINITY; // h/S_max = INFINITY
 
-      find_bound = bound_cond_slope_limiter(false, m, nt, &CV, &bfv_L, &bfv_R, find_bound, true, time_c);
+      find_bound = bound_cond_slope_limiter(ctx, false, m, nt, &CV, &bfv_L, &bfv_R, find_bound, true, time_c);
       if(!find_bound)
 	  goto return_NULL;
 
-      for(j = 0; j <= m; ++j)
-	  { /*
-	     *  j-1          j          j+1
-	     * j-1/2  j-1  j+1/2   j   j+3/2  j+1
-	     *   o-----X-----o-----X-----o-----X--...
-	     */
-	      if(j) // Initialize the initial values.
-		  {
-		      ifv_L.RHO = RHO[nt][j-1] + 0.5*h*s_rho[j-1];
-		      ifv_L.U   =   U[nt][j-1] + 0.5*h*s_u[j-1];
-		      ifv_L.P   =   P[nt][j-1] + 0.5*h*s_p[j-1];
-		  }
-	      else
-		  {
-		      ifv_L.RHO = bfv_L.RHO + 0.5*h*bfv_L.SRHO;
-		      ifv_L.U   = bfv_L.U   + 0.5*h*bfv_L.SU;
-		      ifv_L.P   = bfv_L.P   + 0.5*h*bfv_L.SP;
-		  }
-	      if(j < m)
-		  {
-		      ifv_R.RHO = RHO[nt][j] - 0.5*h*s_rho[j];
-		      ifv_R.U   =   U[nt][j] - 0.5*h*s_u[j];
-		      ifv_R.P   =   P[nt][j] - 0.5*h*s_p[j];
-		  }
-	      else
-		  {
-		      ifv_R.RHO = bfv_R.RHO + 0.5*h*bfv_R.SRHO;
-		      ifv_R.U   = bfv_R.U   + 0.5*h*bfv_R.SU;
-		      ifv_R.P   = bfv_R.P   + 0.5*h*bfv_R.SP;
-		  }
-
-	      c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);
-	      c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);
-	      h_S_max = fmin(h_S_max, h/(fabs(ifv_L.U)+fabs(c_L)));
-	      h_S_max = fmin(h_S_max, h/(fabs(ifv_R.U)+fabs(c_R)));
-
-	      if(j) //calculate the material derivatives
-		  {
-		      ifv_L.d_u   =   s_u[j-1];
-		      ifv_L.d_p   =   s_p[j-1];
-		      ifv_L.d_rho = s_rho[j-1];
-		  }
-	      else
-		  {
-		      ifv_L.d_rho = bfv_L.SRHO;
-		      ifv_L.d_u   = bfv_L.SU;
-		      ifv_L.d_p   = bfv_L.SP;
-		  }
-	      if(j < m)
-		  {
-		      ifv_R.d_u   =   s_u[j];
-		      ifv_R.d_p   =   s_p[j];
-		      ifv_R.d_rho = s_rho[j];
-		  }
-	      else
-		  {
-		      ifv_R.d_rho = bfv_R.SRHO;
-		      ifv_R.d_u   = bfv_R.SU;
-		      ifv_R.d_p   = bfv_R.SP;
-		  }
-	      if(ifvar_check(&ifv_L, &ifv_R, 1))
-		  {
-		      printf(" on [%d, %d] (t_n, x).\n", k, j);
-		      goto return_NULL;
-		  }
+      PHASE_TIC(PT_SOLVE);
+      check = n_check > 0 && k % n_check == 0;
+      j_err = m+1;
+#pragma omp parallel for private(j, c_L, c_R, err) firstprivate(ifv_L, ifv_R) reduction(min:h_S_max) reduction(min:j_err) reduction(+:n_solve)
+      for(jb = 0; jb <= m; jb += GRP_BATCH_SIZE)
+	{
+	  const int nb = m+1-jb < GRP_BATCH_SIZE ? m+1-jb : GRP_BATCH_SIZE;
+	  int l, na = 0; // na is the number of the active interfaces in this block
+	  int idx[GRP_BATCH_SIZE]; // the serial numbers of the active interfaces
+	  _Bool qs[GRP_BATCH_SIZE]; // whether the interfaces of this block are in quiescent regions
+	  // the states on both sides of the active interfaces in this block
+	  double RHO_L[GRP_BATCH_SIZE], U_L[GRP_BATCH_SIZE], P_L[GRP_BATCH_SIZE], d_rho_L[GRP_BATCH_SIZE], d_u_L[GRP_BATCH_SIZE], d_p_L[GRP_BATCH_SIZE];
+	  double RHO_R[GRP_BATCH_SIZE], U_R[GRP_BATCH_SIZE], P_R[GRP_BATCH_SIZE], d_rho_R[GRP_BATCH_SIZE], d_u_R[GRP_BATCH_SIZE], d_p_R[GRP_BATCH_SIZE];
+	  double gam[GRP_BATCH_SIZE];
+	  struct i_f_var_batch bv_L = {RHO_L, U_L, P_L, d_rho_L, d_u_L, d_p_L, gam};
+	  struct i_f_var_batch bv_R = {RHO_R, U_R, P_R, d_rho_R, d_u_R, d_p_R, gam};
+	  // the GRP solutions at the active interfaces in this block
+	  double D_a[3][GRP_BATCH_SIZE], U_a[3][GRP_BATCH_SIZE];
+	  double * const D_b[3] = {D_a[0], D_a[1], D_a[2]};
+	  double * const U_b[3] = {U_a[0], U_a[1], U_a[2]};
+	  IFACE_PEEL_LOOP(j, jb, jb+nb, m, EUL_IFACE_STATE);
+	  if(check && (l = ifvar_check_batch(ctx, nb, &bv_L, &bv_R, &err)) >= 0)
+	      {
+		  if_err[jb+l] = err;
+		  j_err = jb+l;
+		  continue;
+	      }
+	  for(l = 0; l < nb; ++l) // Pack the active interfaces in front of the batch.
+	      {
+		  j = jb + l;
+		  if(qs[l]) // the uniform state without any wave
+		      {
+			  RHO_next[j] = 0.5*(RHO_L[l] + RHO_R[l]);
+			  U_next[j]   = 0.5*(U_L[l]   + U_R[l]);
+			  P_next[j]   = 0.5*(P_L[l]   + P_R[l]);
+			  RHO_t[j]    = 0.0;
+			  U_t[j]      = 0.0;
+			  P_t[j]      = 0.0;
+			  continue;
+		      }
+		  if(na < l)
+		      {
+			  if(!single)
+			      gam[na] = gam[l];
+			  RHO_L[na]   = RHO_L[l];
+			  U_L[na]     = U_L[l];
+			  P_L[na]     = P_L[l];
+			  d_rho_L[na] = d_rho_L[l];
+			  d_u_L[na]   = d_u_L[l];
+			  d_p_L[na]   = d_p_L[l];
+			  RHO_R[na]   = RHO_R[l];
+			  U_R[na]     = U_R[l];
+			  P_R[na]     = P_R[l];
+			  d_rho_R[na] = d_rho_R[l];
+			  d_u_R[na]   = d_u_R[l];
+			  d_p_R[na]   = d_p_R[l];
+		      }
+		  idx[na++] = j;
+	      }
+	  if(!na)
+	      continue;
+	  n_solve += na;
 
 //========================Solve GRP========================
-	      linear_GRP_solver_Edir(dire, mid, &ifv_L, &ifv_R, eps, eps);
-
-	      if(star_dire_check(mid, dire, 1))
-		  {
-		      printf(" on [%d, %d] (t_n, x).\n", k, j);
-		      stop_t = true;
-		  }
-
-	      RHO_next[j] = mid[0];
-	      U_next[j]   = mid[1];
-	      P_next[j]   = mid[2];
-	      RHO_t[j] = dire[0];
-	      U_t[j]   = dire[1];
-	      P_t[j]   = dire[2];
+	  if(single)
+	      linear_GRP_solver_Edir_batch_gc(na, D_b, U_b, &bv_L, &bv_R, &gc, eps, eps);
+	  else
+	      linear_GRP_solver_Edir_batch(na, D_b, U_b, &bv_L, &bv_R, eps, eps);
+
+	  for(l = 0; l < na; ++l)
+	      {
+		  j = idx[l];
+		  RHO_next[j] = U_a[0][l];
+		  U_next[j]   = U_a[1][l];
+		  P_next[j]   = U_a[2][l];
+		  RHO_t[j]    = D_a[0][l];
+		  U_t[j]      = D_a[1][l];
+		  P_t[j]      = D_a[2][l];
+	      }
+	}
+      if(j_err <= m) // Report the first miscalculation of the interfaces.
+	  {
+	      printf("%s on [%d, %d] (t_n, x).\n", ifvar_check_msg(if_err[j_err], 1), k, j_err);
+	      goto return_NULL;
 	  }
+      else if(check && (j = star_dire_check_batch(ctx, m+1, mid, dire, 1, &err)) >= 0)
+	  {
+	      printf("%s on [%d, %d] (t_n, x).\n", star_dire_check_msg(err), k, j);
+	      stop_t = true;
+	  }
+      n_face += m+1;
+      PHASE_TOC(PT_SOLVE);
 
 //====================Time step and grid fixed======================
+    PHASE_TIC(PT_CFL);
     // If no total time, use fixed tau and time step N.
-    if(isfinite(t_all) || !isfinite(config[16]) || config[16] <= 0.0)
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
 	{
 	    tau = CFL * h_S_max;
 	    if(tau < eps)
@@ -230,9 +378,15 @@ void GRP_solver_EUL_source(const int m, struct cell_var_stru CV, double * cpu_ti
 		    printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, tau) - CFL\n", k, time_c, tau); 
 		    goto return_NULL;
 		}
+	    else if(nt_plot < (*N_plot-1) && (time_c + tau) > (time_plot[nt_plot] - eps))
+		tau = time_plot[nt_plot] - time_c; // The step lands on the plotting time.
 	}
     nu = tau / h;
     
+    PHASE_TOC(PT_CFL);
+
+    PHASE_TIC(PT_FLUX);
+#pragma omp parallel for
     for(j = 0; j <= m; ++j)
 	{
 	    RHO_next[j] += 0.5 * tau * RHO_t[j];
@@ -248,8 +402,12 @@ void GRP_solver_EUL_source(const int m, struct cell_var_stru CV, double * cpu_ti
 	    U_next[j]   += 0.5 * tau * U_t[j];
 	    P_next[j]   += 0.5 * tau * P_t[j];
 	}
+    PHASE_TOC(PT_FLUX);
 
 //======================THE CORE ITERATION=========================(On Eulerian Coordinate)
+    PHASE_TIC(PT_UPDATE);
+    data_err = 0;
+#pragma omp parallel for private(Mom, Ene) reduction(|:data_err)
     for(j = 0; j < m; ++j) // forward Euler
 	{ /*
 	   *  j-1          j          j+1
@@ -258,54 +416,81 @@ void GRP_solver_EUL_source(const int m, struct cell_var_stru CV, double * cpu_ti
 	   */
 	    Mom = RHO[nt][j]*U[nt][j] - nu*(F_u[j+1]  -F_u[j]);
 	    Ene = RHO[nt][j]*E[nt][j] - nu*(F_e[j+1]  -F_e[j]);
-	    RHO[nt][j]  =  RHO[nt][j] - nu*(F_rho[j+1]-F_rho[j]);
+	    RHO[nt_w][j] = RHO[nt][j] - nu*(F_rho[j+1]-F_rho[j]);
 
-	    U[nt][j] = Mom / RHO[nt][j];
-	    E[nt][j] = Ene / RHO[nt][j];
-	    P[nt][j] = (Ene - 0.5*Mom*U[nt][j])*(gamma-1.0);
+	    U[nt_w][j] = Mom / RHO[nt_w][j];
+	    E[nt_w][j] = Ene / RHO[nt_w][j];
+	    P[nt_w][j] = (Ene - 0.5*Mom*U[nt_w][j])*(gamma-1.0);
 
-	    if(P[nt][j] < eps || RHO[nt][j] < eps)
-		{
-		    printf("<0.0 error on [%d, %d] (t_n, x) - Update\n", k, j);
-		    stop_t = true;
-		}
+	    if(P[nt_w][j] < eps || RHO[nt_w][j] < eps)
+		data_err = 1;
 	    
 //============================compute the slopes============================
 	    s_u[j]   = (  U_next[j+1] -   U_next[j])/h;
 	    s_p[j]   = (  P_next[j+1] -   P_next[j])/h;
 	    s_rho[j] = (RHO_next[j+1] - RHO_next[j])/h;
 	}
+    nt = nt_w;
+    if(data_err) // Report the miscalculation in order of the cells.
+	for(j = 0; j < m; ++j)
+	    if(P[nt][j] < eps || RHO[nt][j] < eps)
+		{
+		    printf("<0.0 error on [%d, %d] (t_n, x) - Update\n", k, j);
+		    stop_t = true;
+		}
+    PHASE_TOC(PT_UPDATE);
 
 //============================Time update=======================
 
+    if(telemetry_due()) // the totals of mass, momentum and energy of the record
+	{
+	    double q[3] = {0.0, 0.0, 0.0};
+	    for(j = 0; j < m; ++j)
+		{
+		    q[0] += RHO[nt][j]*h;
+		    q[1] += RHO[nt][j]*U[nt][j]*h;
+		    q[2] += RHO[nt][j]*E[nt][j]*h;
+		}
+	    telemetry_conserve(3, q);
+	}
+
     time_c += tau;
     if(isfinite(t_all))
-        DispPro(time_c*100.0/t_all, k);
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
     else
-        DispPro(k*100.0/N, k);
+        telemetry_step(k*100.0/N, k, time_c, tau);
+    file_1D_publish(ctx, m, k, CV, nt, NULL, time_c);
     if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
 	break;
 
 //===========================Fixed variable location=======================
 
-    toc = clock();
-    cpu_time_sum += ((double)toc - (double)tic) / (double)CLOCKS_PER_SEC;
+    toc = wall_time();
+    cpu_time_sum += toc - tic;
     cpu_time[nt]  = cpu_time_sum;
+    if(n_ckpt > 0 && k % n_ckpt == 0)
+	{
+	    PHASE_TIC(PT_IO);
+	    checkpoint_write(&ckpt);
+	    PHASE_TOC(PT_IO);
+	}
   }
 
   printf("\nTime is up at time step %d.\n", k);
-  printf("The cost of CPU time for 1D-GRP Eulerian scheme for this problem is %g seconds.\n", cpu_time_sum);
+  printf("The cost of wall-clock time for 1D-GRP Eulerian scheme for this problem is %g seconds.\n", cpu_time_sum);
+  if(quiet && n_face)
+      printf("The GRP is solved at %g%% of the interfaces, the others are in quiescent regions.\n", 100.0*n_solve/n_face);
 //---------------------END OF THE MAIN LOOP----------------------
 
 return_NULL:
-  config[5] = (double)k;
-  *N_plot = nt+1;
+  ctx->conf[5] = (double)k;
+  *N_plot = nt_plot+1;
   if(isfinite(time_c))
-      time_plot[nt] = time_c;
+      time_plot[nt_plot] = time_c;
   else if(isfinite(t_all))
-      time_plot[nt] = t_all;
+      time_plot[nt_plot] = t_all;
   else if(isfinite(tau))
-      time_plot[nt] = k*tau;
+      time_plot[nt_plot] = k*tau;
 
   free(s_u);
   free(s_p);
@@ -331,4 +516,7 @@ return_NULL:
   F_rho = NULL;
   F_u   = NULL;
   F_e   = NULL;
+  free(if_err);
+  if_err = NULL;
+  checkpoint_free(&ckpt);
 }
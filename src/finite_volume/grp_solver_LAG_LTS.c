@@ -0,0 +1,414 @@
+/**
+ * @file  grp_solver_LAG_LTS.c
+ * @brief This is a Lagrangian GRP scheme to solve 1-D Euler equations with local (multi-rate) time stepping.
+ * @details The cells are binned into the time levels l = 0, 1, …, L with the time steps Δt/2^l, where
+ *          the finest level L has the global CFL time step and 'config[37]' bounds L. The levels of
+ *          adjacent cells differ by at most one. The GRP at an interface is solved at the beginning of
+ *          the time step of its coarser neighbouring cell, when both neighbours are synchronized, and the
+ *          temporal derivatives of the GRP give the interfacial values at the intermediate sub-steps of
+ *          its finer neighbouring cell. The fluxes over each sub-step are added to both neighbouring cells
+ *          and a cell is updated at the end of its own time step, so the scheme stays conservative at
+ *          the level boundaries.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdbool.h>
+
+#include "../include/var_struc.h"
+#include "../include/inter_process.h"
+#include "../include/tools.h"
+#include "../include/file_io.h"
+#include "../include/finite_volume.h"
+
+
+#define LTS_BUFFER 2 //!< Number of the neighbouring cells on each side whose local time steps bound the level of a cell.
+
+/**
+ * @brief This function use GRP scheme with local time stepping to solve 1-D Euler
+ *        equations of motion on Lagrangian coordinate.
+ * @param[in,out] ctx:    Pointer to the run context.
+ * @param[in] m:          Number of the grids.
+ * @param[in,out] CV:     Structure of cell variable data.
+ * @param[in,out] X[]:    Array of the coordinate data.
+ * @param[out] cpu_time:  Array of the CPU time recording.
+ * @param[in]  problem:   Name of the numerical results for the test problem.
+ * @param[in]  N_T:       Number of levels storing fluid variables in memory.
+ * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
+ * @param[in,out] time_plot: Array of the plotting time recording.
+ */
+void GRP_solver_LAG_LTS(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[])
+{
+    /*
+     * j is a frequently used index for spatial variables.
+     * k is a frequently used index for the time step.
+     */
+  int j, k = 0;
+
+  double tic, toc;
+  double cpu_time_sum = 0.0;
+
+  double const t_all = ctx->conf[1];       // the total time
+  double const eps   = ctx->conf[4];       // the largest value could be seen as zero
+  int    const N     = (int)ctx->conf[5];  // the maximum number of time steps
+  double const gamma = ctx->conf[6];       // the constant of the perfect gas
+  double const CFL   = ctx->conf[7];       // the CFL number
+  double const h     = ctx->conf[10];      // the length of the initial spatial grids
+  double       tau   = ctx->conf[16];      // the length of the time step
+  int    const bound = (int)ctx->conf[17]; // the boundary condition in x-direction
+  int    const L_max = (int)ctx->conf[37]; // the largest number of the time levels coarser than the finest one
+
+  _Bool find_bound = false;
+
+  double c, tau_min, tau_max, tau_b; // the speed of sound, the extreme local time steps and that of a cell's neighbourhood
+  double tau_f = tau; // the time step of the finest level
+  double tau_cfl = tau; // the time step of the finest level before the time step lands on the plotting time
+  double h_S_max; // h/S_max in GRP_LAG_interface(ctx, ), not used here
+  double t_s, tau_e, dt_0; // the time of the sub-step, the length of the flux step and its time from the GRP
+  double U_F, P_F; // the numerical flux at the middle of the flux step
+  double U_e, P_e, RHO_e_L, RHO_e_R; // the interfacial values at the end of a cell step
+  int L, n_sub, s; // the number of levels, the number of sub-steps and the sub-step
+  int l_L, l_R; // the time levels of the cells on both sides of an interface
+  int i;
+  int retval;
+  double time_c = 0.0; // the current time
+  double C_m = 1.01; // a multiplicative coefficient allows the time step to increase.
+  _Bool stop_t = false;
+  int nt = 0, nt_plot = 0; // the number of times storing plotting data
+  _Bool const stream = (_Bool)ctx->conf[34]; // streaming output of the plotting data
+  double n_update = 0.0, n_update_global = 0.0; // the numbers of the cell updates with local/global time steps
+
+  struct b_f_var bfv_L = {.H = h, .SRHO = 0.0, .SP = 0.0, .SU = 0.0}, bfv_R = bfv_L; // Left/Right boundary condition
+
+  double ** RHO  = CV.RHO;
+  double ** U    = CV.U;
+  double ** P    = CV.P;
+  double ** E    = CV.E;
+  // the slopes of variable values
+  double * s_rho = (double*)calloc(m, sizeof(double));
+  double * s_u   = (double*)calloc(m, sizeof(double));
+  double * s_p   = (double*)calloc(m, sizeof(double));
+  CV.d_rho = s_rho;
+  CV.d_u   = s_u;
+  CV.d_p   = s_p;
+  // the Riemann solutions at (x_{j-1/2}, t_0[j]), t_0[j] is the time when the GRP is solved.
+  double * U_0     = (double*)malloc((m+1) * sizeof(double));
+  double * P_0     = (double*)malloc((m+1) * sizeof(double));
+  double * RHO_0_L = (double*)malloc((m+1) * sizeof(double));
+  double * RHO_0_R = (double*)malloc((m+1) * sizeof(double));
+  double * t_0     = (double*)malloc((m+1) * sizeof(double));
+  // the temporal derivatives at (x_{j-1/2}, t_0[j]).
+  double * U_t     = (double*)malloc((m+1) * sizeof(double));
+  double * P_t     = (double*)malloc((m+1) * sizeof(double));
+  double * RHO_t_L = (double*)malloc((m+1) * sizeof(double));
+  double * RHO_t_R = (double*)malloc((m+1) * sizeof(double));
+  // the time integrals of the numerical fluxes over the flux steps at x_{j-1/2}.
+  double * F_v = (double*)malloc((m+1) * sizeof(double));
+  double * F_u = (double*)malloc((m+1) * sizeof(double));
+  double * F_e = (double*)malloc((m+1) * sizeof(double));
+  // the flux differences accumulated in cells since the beginning of their time steps.
+  double * A_v = (double*)calloc(m, sizeof(double));
+  double * A_u = (double*)calloc(m, sizeof(double));
+  double * A_e = (double*)calloc(m, sizeof(double));
+  double * MASS  = (double*)malloc(m * sizeof(double)); // Array of the mass data in computational cells.
+  double * R_MASS = (double*)malloc(m * sizeof(double)); // Array of the reciprocals of MASS.
+  _Bool uniform = true; // whether the grids are of uniform mass
+  double * tau_c = (double*)malloc(m * sizeof(double)); // Array of the local time steps in computational cells.
+  int * lev   = (int*)malloc(m * sizeof(int));     // the time levels of cells
+  int * lev_s = (int*)malloc((m+1) * sizeof(int)); // the time levels of interfaces solving the GRP (coarser side)
+  int * lev_e = (int*)malloc((m+1) * sizeof(int)); // the time levels of interfaces evaluating the flux (finer side)
+  if(s_rho == NULL || s_u == NULL || s_p == NULL)
+      {
+	  printf("NOT enough memory! Slope\n");
+	  goto return_NULL;
+      }
+  if(U_0 == NULL || P_0 == NULL || RHO_0_L == NULL || RHO_0_R == NULL || t_0 == NULL)
+      {
+	  printf("NOT enough memory! Variables_0\n");
+	  goto return_NULL;
+      }
+  if(U_t == NULL || P_t == NULL || RHO_t_L == NULL || RHO_t_R == NULL)
+      {
+	  printf("NOT enough memory! Temproal derivative\n");
+	  goto return_NULL;
+      }
+  if(F_v == NULL || F_u == NULL || F_e == NULL || A_v == NULL || A_u == NULL || A_e == NULL)
+      {
+	  printf("NOT enough memory! Flux\n");
+	  goto return_NULL;
+      }
+  if(MASS == NULL || R_MASS == NULL || tau_c == NULL || lev == NULL || lev_s == NULL || lev_e == NULL)
+      {
+	  printf("NOT enough memory! MASS or time levels\n");
+	  goto return_NULL;
+      }
+  for(k = 0; k < m; ++k) // Initialize the values of mass in computational cells
+      MASS[k] = h * RHO[0][k];
+  for(j = 0; j < m; ++j) // the masses are fixed on Lagrangian coordinate
+      {
+	  R_MASS[j] = 1.0 / MASS[j];
+	  uniform = uniform && MASS[j] == MASS[0];
+      }
+
+//-----------------------THE MAIN LOOP--------------------------------
+  for(k = 1; k <= N; ++k)
+  {
+      tic = wall_time();
+      if (time_c >= time_plot[nt_plot] - eps && nt_plot < (*N_plot-1))
+	  {
+	      if(stream)
+		  {
+		      PHASE_TIC(PT_IO);
+		      file_1D_write_stream(ctx, m, nt_plot, CV, nt, X[nt], NULL, problem, time_plot[nt_plot]);
+		      PHASE_TOC(PT_IO);
+		  }
+	      nt_plot++;
+	      if (nt < (N_T-1)) // The cells of the sub-steps are updated in place, so the level is copied as a whole.
+		  {
+		      memcpy(RHO[nt+1], RHO[nt], m * sizeof(double));
+		      memcpy(  U[nt+1],   U[nt], m * sizeof(double));
+		      memcpy(  E[nt+1],   E[nt], m * sizeof(double));
+		      memcpy(  P[nt+1],   P[nt], m * sizeof(double));
+		      memcpy(  X[nt+1],   X[nt], (m+1) * sizeof(double));
+		      nt++;
+		  }
+	  }
+
+//====================Time step and time levels======================
+    PHASE_TIC(PT_CFL);
+    tau_min = INFINITY;
+    tau_max = 0.0;
+    for(j = 0; j < m; ++j)
+	{
+	    c = sqrt(gamma * P[nt][j] / RHO[nt][j]);
+	    tau_c[j] = (X[nt][j+1] - X[nt][j]) / c;
+	    if ((bound == -2 || bound == -24) && j == 0) // reflective boundary conditions
+		tau_c[j] = fmin(tau_c[j], (X[nt][j+1] - X[nt][j]) / (fabs(U[nt][j])+c));
+	    if (bound == -2 && j == m-1)
+		tau_c[j] = fmin(tau_c[j], (X[nt][j+1] - X[nt][j]) / (fabs(U[nt][j])+c));
+	    tau_c[j] *= CFL;
+	    tau_min = fmin(tau_min, tau_c[j]);
+	    tau_max = fmax(tau_max, tau_c[j]);
+	}
+    // If no total time, use fixed tau and time step N.
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
+	{
+	    tau_f = tau_cfl = fmin(tau_min, C_m * tau_cfl);
+	    for(L = 0; L < L_max && tau_f * (double)(2 << L) <= tau_max; ++L)
+		;
+	    tau = tau_f * (double)(1 << L);
+	    if(tau_f < eps)
+		{
+		    printf("\nThe length of the time step is so small on [%d, %g, %g] (t_n, time_c, tau)\n", k, time_c, tau_f);
+		    stop_t = true;
+		}
+	    else if((time_c + tau) > (t_all - eps))
+		tau = t_all - time_c;
+	    else if(!isfinite(tau))
+		{
+		    printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, tau) - CFL\n", k, time_c, tau);
+		    goto return_NULL;
+		}
+	    else if(nt_plot < (*N_plot-1) && (time_c + tau) > (time_plot[nt_plot] - eps))
+		tau = time_plot[nt_plot] - time_c; // The step lands on the plotting time.
+	}
+    else
+	L = 0;
+    n_sub = 1 << L;
+    // the coarsest level whose time step is not larger than the local time steps of the cell and its neighbours
+    for(j = 0; j < m; ++j)
+	{
+	    tau_b = tau_c[j];
+	    for(i = j > LTS_BUFFER ? j-LTS_BUFFER : 0; i <= j+LTS_BUFFER && i < m; ++i)
+		tau_b = fmin(tau_b, tau_c[i]);
+	    for(lev[j] = 0; lev[j] < L && tau / (double)(1 << lev[j]) > tau_b; ++lev[j])
+		;
+	}
+    // The levels of adjacent cells differ by at most one.
+    for(j = 1; j < m; ++j)
+	lev[j] = lev[j] > lev[j-1]-1 ? lev[j] : lev[j-1]-1;
+    for(j = m-2; j >= 0; --j)
+	lev[j] = lev[j] > lev[j+1]-1 ? lev[j] : lev[j+1]-1;
+    for(j = 0; j <= m; ++j)
+	{
+	    l_L = j     ? lev[j-1] : (bound == -7 ? lev[m-1] : lev[0]);
+	    l_R = j < m ? lev[j]   : (bound == -7 ? lev[0]   : lev[m-1]);
+	    lev_s[j] = l_L < l_R ? l_L : l_R;
+	    lev_e[j] = l_L > l_R ? l_L : l_R;
+	}
+    tau_f = tau / (double)n_sub;
+    n_update_global += (double)m * (double)n_sub;
+    PHASE_TOC(PT_CFL);
+
+//======================THE SUB-STEPS=========================(On Lagrangian Coordinate)
+    for(s = 0; s < n_sub; ++s)
+	{
+	    t_s = time_c + s*tau_f;
+
+	    find_bound = bound_cond_slope_limiter(ctx, true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, true, t_s, X[nt]);
+	    if(!find_bound)
+		goto return_NULL;
+
+	    // GRP at the interfaces whose time steps begin
+	    PHASE_TIC(PT_SOLVE);
+	    for(j = 0; j <= m; ++j)
+		if(s % (n_sub >> lev_s[j]) == 0)
+		    {
+			retval = GRP_LAG_interface(ctx, j, m, k, RHO[nt], U[nt], P[nt], s_rho, s_u, s_p, X[nt], &bfv_L, &bfv_R, &h_S_max,
+						   RHO_0_L, RHO_0_R, U_0, P_0, RHO_t_L, RHO_t_R, U_t, P_t);
+			if(retval > 1)
+			    goto return_NULL;
+			else if(retval)
+			    stop_t = true;
+			t_0[j] = t_s;
+		    }
+	    PHASE_TOC(PT_SOLVE);
+
+	    // fluxes and grid motion over the flux steps beginning at this sub-step
+	    PHASE_TIC(PT_FLUX);
+	    for(j = 0; j <= m; ++j)
+		if(s % (n_sub >> lev_e[j]) == 0)
+		    {
+			tau_e = tau_f * (double)(n_sub >> lev_e[j]);
+			dt_0  = t_s - t_0[j] + 0.5*tau_e;
+			U_F = U_0[j] + dt_0 * U_t[j];
+			P_F = P_0[j] + dt_0 * P_t[j];
+			F_v[j] = tau_e * U_F;
+			F_u[j] = tau_e * P_F;
+			F_e[j] = tau_e * P_F*U_F;
+			X[nt][j] += tau_e * U_F; // motion along the contact discontinuity
+		    }
+		else
+		    {
+			F_v[j] = 0.0;
+			F_u[j] = 0.0;
+			F_e[j] = 0.0;
+		    }
+	    // The same fluxes are added to both neighbouring cells.
+	    for(j = 0; j < m; ++j)
+		{
+		    A_v[j] += F_v[j+1] - F_v[j];
+		    A_u[j] += F_u[j+1] - F_u[j];
+		    A_e[j] += F_e[j+1] - F_e[j];
+		}
+	    PHASE_TOC(PT_FLUX);
+
+	    // update of the cells whose time steps end
+	    PHASE_TIC(PT_UPDATE);
+	    for(j = 0; j < m; ++j)
+		if((s+1) % (n_sub >> lev[j]) == 0)
+		    {
+			// The fluxes added over the time step of the cell are multiplied by their time steps.
+			if(LAG_update_state(j, R_MASS[uniform ? 0 : j], gamma, eps, RHO[nt], U[nt], E[nt],
+					    RHO[nt], U[nt], P[nt], E[nt], A_v[j], A_u[j], A_e[j]))
+			    {
+				printf("<0.0 error on [%d, %d] (t_n, x) - Update\n", k, j);
+				stop_t = true;
+			    }
+			A_v[j] = 0.0;
+			A_u[j] = 0.0;
+			A_e[j] = 0.0;
+			n_update += 1.0;
+
+//============================compute the slopes============================
+			dt_0    = t_s + tau_f - t_0[j+1];
+			U_e     =     U_0[j+1] + dt_0 *     U_t[j+1];
+			P_e     =     P_0[j+1] + dt_0 *     P_t[j+1];
+			RHO_e_L = RHO_0_L[j+1] + dt_0 * RHO_t_L[j+1];
+			dt_0    = t_s + tau_f - t_0[j];
+			U_e     -=     U_0[j] + dt_0 *     U_t[j];
+			P_e     -=     P_0[j] + dt_0 *     P_t[j];
+			RHO_e_R  = RHO_0_R[j] + dt_0 * RHO_t_R[j];
+			s_u[j]   =                 U_e/(X[nt][j+1]-X[nt][j]);
+			s_p[j]   =                 P_e/(X[nt][j+1]-X[nt][j]);
+			s_rho[j] = (RHO_e_L - RHO_e_R)/(X[nt][j+1]-X[nt][j]);
+		    }
+	    PHASE_TOC(PT_UPDATE);
+	}
+
+//============================Time update=======================
+
+    time_c += tau;
+    if(isfinite(t_all))
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
+    else
+        telemetry_step(k*100.0/N, k, time_c, tau);
+    file_1D_publish(ctx, m, k, CV, nt, X[nt], time_c);
+    if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
+	break;
+
+//===========================Fixed variable location=======================
+
+    toc = wall_time();
+    cpu_time_sum += toc - tic;
+    cpu_time[nt]  = cpu_time_sum;
+  }
+
+  printf("\nTime is up at time step %d.\n", k);
+  printf("The cost of wall-clock time for 1D-GRP Lagrangian scheme for this problem is %g seconds.\n", cpu_time_sum);
+  if(n_update_global > 0.0)
+      printf("The local time steps need %g%% of the cell updates with the global time step.\n", 100.0*n_update/n_update_global);
+//---------------------END OF THE MAIN LOOP----------------------
+
+return_NULL:
+  ctx->conf[5] = (double)k;
+  *N_plot = nt_plot+1;
+  if(isfinite(time_c))
+      time_plot[nt_plot] = time_c;
+  else if(isfinite(t_all))
+      time_plot[nt_plot] = t_all;
+  else if(isfinite(tau))
+      time_plot[nt_plot] = k*tau;
+
+  free(s_u);
+  free(s_p);
+  free(s_rho);
+  s_u   = NULL;
+  s_p   = NULL;
+  s_rho = NULL;
+  free(U_0);
+  free(P_0);
+  free(RHO_0_L);
+  free(RHO_0_R);
+  free(t_0);
+  U_0     = NULL;
+  P_0     = NULL;
+  RHO_0_L = NULL;
+  RHO_0_R = NULL;
+  t_0     = NULL;
+  free(U_t);
+  free(P_t);
+  free(RHO_t_L);
+  free(RHO_t_R);
+  U_t     = NULL;
+  P_t     = NULL;
+  RHO_t_L = NULL;
+  RHO_t_R = NULL;
+  free(F_v);
+  free(F_u);
+  free(F_e);
+  free(A_v);
+  free(A_u);
+  free(A_e);
+  F_v = NULL;
+  F_u = NULL;
+  F_e = NULL;
+  A_v = NULL;
+  A_u = NULL;
+  A_e = NULL;
+  free(MASS);
+  free(R_MASS);
+  free(tau_c);
+  MASS   = NULL;
+  R_MASS = NULL;
+  tau_c  = NULL;
+  free(lev);
+  free(lev_s);
+  free(lev_e);
+  lev   = NULL;
+  lev_s = NULL;
+  lev_e = NULL;
+}
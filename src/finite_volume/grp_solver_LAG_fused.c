@@ -0,0 +1,533 @@
+/**
+ * @file  grp_solver_LAG_fused.c
+ * @brief This is a Lagrangian GRP scheme to solve 1-D Euler equations with a fused, cache-blocked sweep.
+ * @details Each time step of GRP_solver_LAG_source() makes three full passes over the cell interfaces.
+ *          Here the flux, grid motion and cell update of the time step n, and the slope limiter and GRP
+ *          solve of the time step n+1, are done in one sweep over tiles of 'config[80]' interfaces,
+ *          lagging by one interface/cell behind each other. The boundary cells and interfaces depend on
+ *          the boundary conditions, so they are fixed up after the sweep. As the arithmetic of each
+ *          value is unchanged, the results are bitwise identical to those of GRP_solver_LAG_source().
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <time.h>
+#include <stdbool.h>
+
+#include "../include/var_struc.h"
+#include "../include/riemann_solver.h"
+#include "../include/inter_process.h"
+#include "../include/tools.h"
+#include "../include/file_io.h"
+#include "../include/finite_volume.h"
+
+
+/**
+ * @brief This function solves the GRP at the cell interface x_{j-1/2}.
+ * @details The GRP is solved by the batched solver on one lane, with the quiescent interfaces (config[36]) and the constants
+ *          of the perfect gas of GRP_solver_LAG_source(), so that the solutions are the same as those of its batches.
+ * @param[in] ctx:   Pointer to the run context.
+ * @param[in] j:     Index of the cell interface.
+ * @param[in] m:     Number of the grids.
+ * @param[in] k:     Index of the time step (only for error messages).
+ * @param[in] RHO, U, P: Arrays of the fluid variables in cells at the current plot level.
+ * @param[in] s_rho, s_u, s_p: Arrays of the slopes of fluid variables.
+ * @param[in] X:     Array of the coordinate data.
+ * @param[in] bfv_L, bfv_R: Fluid variables at left/right boundary.
+ * @param[in,out] h_S_max: h/S_max, S_max is the maximum wave speed.
+ * @param[out] RHO_next_L, RHO_next_R, U_next, P_next: Riemann solutions at (x_{j-1/2}, t_{n}).
+ * @param[out] RHO_t_L, RHO_t_R, U_t, P_t:             Temporal derivatives at (x_{j-1/2}, t_{n}).
+ * @return    miscalculation indicator.
+ *   @retval  0: Successful calculation.
+ *   @retval  1: Error in the GRP solutions, the computation should stop after this time step.
+ *   @retval  2: Error in the reconstructed states, the computation should stop at once.
+ */
+int GRP_LAG_interface(const struct run_ctx * ctx, const int j, const int m, const int k, double * RHO, double * U, double * P,
+		      const double * s_rho, const double * s_u, const double * s_p, const double * X,
+		      const struct b_f_var * bfv_L, const struct b_f_var * bfv_R, double * h_S_max,
+		      double * RHO_next_L, double * RHO_next_R, double * U_next, double * P_next,
+		      double * RHO_t_L, double * RHO_t_R, double * U_t, double * P_t)
+{
+  double const eps   = ctx->conf[4];       // the largest value could be seen as zero
+  double const gamma = ctx->conf[6];       // the constant of the perfect gas
+  int    const bound = (int)ctx->conf[17]; // the boundary condition in x-direction
+
+  _Bool  const quiet = (_Bool)ctx->conf[36]; // skip the GRP solver at the interfaces in quiescent regions
+
+  double c_L, c_R; // the speeds of sound
+  double h_L, h_R; // length of spatial grids
+  double dire[4], mid[4];
+  struct i_f_var ifv_L = {.gamma = gamma}, ifv_R = ifv_L;
+  struct gamma_const gc; // the constants of the perfect gas
+  // the interface as a batch of one lane of the batched solver of GRP_solver_LAG_source()
+  struct i_f_var_batch bv_L = {&ifv_L.RHO, &ifv_L.U, &ifv_L.P, &ifv_L.t_rho, &ifv_L.t_u, &ifv_L.t_p, &ifv_L.gamma};
+  struct i_f_var_batch bv_R = {&ifv_R.RHO, &ifv_R.U, &ifv_R.P, &ifv_R.t_rho, &ifv_R.t_u, &ifv_R.t_p, &ifv_R.gamma};
+  double * const D_b[4] = {dire, dire+1, dire+2, dire+3}, * const U_b[4] = {mid, mid+1, mid+2, mid+3};
+
+  if(j) // Initialize the initial values.
+      {
+	  h_L       =   X[j] - X[j-1];
+	  ifv_L.RHO = RHO[j-1] + 0.5*h_L*s_rho[j-1];
+	  ifv_L.U   =   U[j-1] + 0.5*h_L*s_u[j-1];
+	  ifv_L.P   =   P[j-1] + 0.5*h_L*s_p[j-1];
+      }
+  else
+      {
+	  h_L       = bfv_L->H;
+	  ifv_L.RHO = bfv_L->RHO + 0.5*h_L*bfv_L->SRHO;
+	  ifv_L.U   = bfv_L->U   + 0.5*h_L*bfv_L->SU;
+	  ifv_L.P   = bfv_L->P   + 0.5*h_L*bfv_L->SP;
+      }
+  if(j < m)
+      {
+	  h_R       =   X[j+1] - X[j];
+	  ifv_R.RHO = RHO[j] - 0.5*h_R*s_rho[j];
+	  ifv_R.U   =   U[j] - 0.5*h_R*s_u[j];
+	  ifv_R.P   =   P[j] - 0.5*h_R*s_p[j];
+      }
+  else
+      {
+	  h_R       = bfv_R->H;
+	  ifv_R.RHO = bfv_R->RHO + 0.5*h_R*bfv_R->SRHO;
+	  ifv_R.U   = bfv_R->U   + 0.5*h_R*bfv_R->SU;
+	  ifv_R.P   = bfv_R->P   + 0.5*h_R*bfv_R->SP;
+      }
+
+  c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);
+  c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);
+  *h_S_max = fmin(*h_S_max, h_L/c_L);
+  *h_S_max = fmin(*h_S_max, h_R/c_R);
+  if ((bound == -2 || bound == -24) && j == 0) // reflective boundary conditions
+      *h_S_max = fmin(*h_S_max, h_L/(fabs(ifv_L.U)+c_L));
+  if (bound == -2 && j == m)
+      *h_S_max = fmin(*h_S_max, h_R/(fabs(ifv_R.U)+c_R));
+
+  if(j) //calculate the material derivatives
+      {
+	  ifv_L.d_u   =   s_u[j-1];
+	  ifv_L.d_p   =   s_p[j-1];
+	  ifv_L.d_rho = s_rho[j-1];
+      }
+  else
+      {
+	  ifv_L.d_rho = bfv_L->SRHO;
+	  ifv_L.d_u   = bfv_L->SU;
+	  ifv_L.d_p   = bfv_L->SP;
+      }
+  ifv_L.t_u   =   ifv_L.d_u/ifv_L.RHO;
+  ifv_L.t_p   =   ifv_L.d_p/ifv_L.RHO;
+  ifv_L.t_rho = ifv_L.d_rho/ifv_L.RHO;
+  if(j < m)
+      {
+	  ifv_R.d_u   =   s_u[j];
+	  ifv_R.d_p   =   s_p[j];
+	  ifv_R.d_rho = s_rho[j];
+      }
+  else
+      {
+	  ifv_R.d_rho = bfv_R->SRHO;
+	  ifv_R.d_u   = bfv_R->SU;
+	  ifv_R.d_p   = bfv_R->SP;
+      }
+  ifv_R.t_u   =   ifv_R.d_u/ifv_R.RHO;
+  ifv_R.t_p   =   ifv_R.d_p/ifv_R.RHO;
+  ifv_R.t_rho = ifv_R.d_rho/ifv_R.RHO;
+  if(ifvar_check(ctx, &ifv_L, &ifv_R, 1))
+      {
+	  printf(" on [%d, %d] (t_n, x).\n", k, j);
+	  return 2;
+      }
+
+//========================Solve GRP========================
+  if(quiet && ifvar_quiescent(&ifv_L, &ifv_R, eps)) // the uniform state without any wave
+      {
+	  mid[0] = ifv_L.RHO;
+	  mid[3] = ifv_R.RHO;
+	  mid[1] = 0.5*(ifv_L.U + ifv_R.U);
+	  mid[2] = 0.5*(ifv_L.P + ifv_R.P);
+	  dire[0] = dire[1] = dire[2] = dire[3] = 0.0;
+      }
+  else if((int)ctx->conf[2] <= 1) // single-fluid flow with the constant gamma
+      {
+	  gamma_const_set(&gc, gamma);
+	  linear_GRP_solver_LAG_batch_gc(1, D_b, U_b, &bv_L, &bv_R, &gc, eps, eps);
+      }
+  else
+      linear_GRP_solver_LAG_batch(1, D_b, U_b, &bv_L, &bv_R, eps, eps);
+
+  RHO_next_L[j] = mid[0];
+  RHO_next_R[j] = mid[3];
+  U_next[j]     = mid[1];
+  P_next[j]     = mid[2];
+  RHO_t_L[j] = dire[0];
+  RHO_t_R[j] = dire[3];
+  U_t[j]     = dire[1];
+  P_t[j]     = dire[2];
+
+  if(star_dire_check(ctx, mid, dire, 1))
+      {
+	  printf(" on [%d, %d] (t_n, x).\n", k, j);
+	  return 1;
+      }
+  return 0;
+}
+
+/**
+ * @brief This function applies the minmod limiter of minmod_limiter_X() to the slope in the cell j.
+ * @param[in] ctx: Pointer to the run context.
+ * @param[in] j:  Index of the cell.
+ * @param[in] m:  Number of the grids.
+ * @param[in,out] s[]: Spatial derivatives of the fluid variable.
+ * @param[in] V[]: Array to store fluid variable values.
+ * @param[in] VL:  Fluid variable value at left boundary.
+ * @param[in] VR:  Fluid variable value at right boundary.
+ * @param[in] HL:  Spatial grid length at left boundary.
+ * @param[in] HR:  Spatial grid length at right boundary.
+ * @param[in] X:   Array of moving spatial grid point coordinates.
+ */
+static inline void minmod_limiter_cell(const struct run_ctx * ctx, const int j, const int m, double s[], const double V[],
+				       const double VL, const double VR, const double HL, const double HR, const double * X)
+{
+    double const alpha = ctx->conf[41]; // the paramater in slope limiters.
+    double s_L, s_R, h;
+    if(j)
+	{
+	    h = 0.5 * (X[j+1] - X[j-1]);
+	    s_L = (V[j] - V[j-1]) / h;
+	}
+    else
+	{
+	    h = 0.5 * (X[j+1] - X[j] + HL);
+	    s_L = (V[j] - VL) / h;
+	}
+    if(j < m-1)
+	{
+	    h = 0.5 * (X[j+2] - X[j]);
+	    s_R = (V[j+1] - V[j]) / h;
+	}
+    else
+	{
+	    h = 0.5 * (X[j+1] - X[j] + HR);
+	    s_R = (VR - V[j]) / h;
+	}
+    s[j] = minmod3(alpha*s_L, alpha*s_R, s[j]);
+}
+
+/**
+ * @brief This function use fused GRP scheme to solve 1-D Euler
+ *        equations of motion on Lagrangian coordinate.
+ * @param[in,out] ctx:    Pointer to the run context.
+ * @param[in] m:          Number of the grids.
+ * @param[in,out] CV:     Structure of cell variable data.
+ * @param[in,out] X[]:    Array of the coordinate data.
+ * @param[out] cpu_time:  Array of the CPU time recording.
+ * @param[in]  problem:   Name of the numerical results for the test problem.
+ * @param[in]  N_T:       Number of levels storing fluid variables in memory.
+ * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
+ * @param[in,out] time_plot: Array of the plotting time recording.
+ */
+void GRP_solver_LAG_fused(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[])
+{
+    /*
+     * j is a frequently used index for spatial variables.
+     * k is a frequently used index for the time step.
+     */
+  int j, k = 0;
+
+  double tic, toc;
+  double cpu_time_sum = 0.0;
+
+  double const t_all = ctx->conf[1];       // the total time
+  double const eps   = ctx->conf[4];       // the largest value could be seen as zero
+  int    const N     = (int)ctx->conf[5];  // the maximum number of time steps
+  double const gamma = ctx->conf[6];       // the constant of the perfect gas
+  double const CFL   = ctx->conf[7];       // the CFL number
+  double const h     = ctx->conf[10];      // the length of the initial spatial grids
+  double       tau   = ctx->conf[16];      // the length of the time step
+  double     tau_cfl = tau;                // the length of the time step before it lands on the plotting time
+  int    const bound = (int)ctx->conf[17]; // the boundary condition in x-direction
+  int    const tile  = (int)ctx->conf[80]; // the number of interfaces in a tile of the fused sweep
+
+  _Bool find_bound = false;
+
+  double h_S_max; // h/S_max, S_max is the maximum wave speed
+  double h_S_next = INFINITY; // h/S_max of the next time step
+  double time_c = 0.0; // the current time
+  double C_m = 1.01; // a multiplicative coefficient allows the time step to increase.
+  _Bool stop_t = false;
+  int grp_next = 0; // the miscalculation indicator of the GRP solved for the next time step (see GRP_LAG_interface(ctx, ))
+  int nt = 0, nt_plot = 0; // the number of times storing plotting data
+  int nt_w; // the level written by the time step, the next one after a plotting time
+  _Bool const stream = (_Bool)ctx->conf[34]; // streaming output of the plotting data
+  int j0, j1, i; // the range of the tile and the lagged index
+  int retval;
+
+  struct b_f_var bfv_L = {.H = h, .SRHO = 0.0, .SP = 0.0, .SU = 0.0}, bfv_R = bfv_L; // Left/Right boundary condition
+
+  double ** RHO  = CV.RHO;
+  double ** U    = CV.U;
+  double ** P    = CV.P;
+  double ** E    = CV.E;
+  // the slopes of variable values
+  double * s_rho = (double*)calloc(m, sizeof(double));
+  double * s_u   = (double*)calloc(m, sizeof(double));
+  double * s_p   = (double*)calloc(m, sizeof(double));
+  CV.d_rho = s_rho;
+  CV.d_u   = s_u;
+  CV.d_p   = s_p;
+  // the variable values at (x_{j-1/2}, t_{n+1}).
+  double * U_next     = (double*)malloc((m+1) * sizeof(double));
+  double * P_next     = (double*)malloc((m+1) * sizeof(double));
+  double * RHO_next_L = (double*)malloc((m+1) * sizeof(double));
+  double * RHO_next_R = (double*)malloc((m+1) * sizeof(double));
+  // the temporal derivatives at (x_{j-1/2}, t_{n}).
+  double * U_t     = (double*)malloc((m+1) * sizeof(double));
+  double * P_t     = (double*)malloc((m+1) * sizeof(double));
+  double * RHO_t_L = (double*)malloc((m+1) * sizeof(double));
+  double * RHO_t_R = (double*)malloc((m+1) * sizeof(double));
+  // the numerical flux at (x_{j-1/2}, t_{n+1/2}).
+  double * U_F  = (double*)malloc((m+1) * sizeof(double));
+  double * P_F  = (double*)malloc((m+1) * sizeof(double));
+  double * MASS = (double*)malloc(m * sizeof(double)); // Array of the mass data in computational cells.
+  double * R_MASS = (double*)malloc(m * sizeof(double)); // Array of the reciprocals of MASS.
+  _Bool uniform = true; // whether the grids are of uniform mass
+  if(s_rho == NULL || s_u == NULL || s_p == NULL)
+      {
+	  printf("NOT enough memory! Slope\n");
+	  goto return_NULL;
+      }
+  if(U_next == NULL || P_next == NULL || RHO_next_L == NULL || RHO_next_R == NULL)
+      {
+	  printf("NOT enough memory! Variables_next\n");
+	  goto return_NULL;
+      }
+  if(U_t == NULL || P_t == NULL || RHO_t_L == NULL || RHO_t_R == NULL)
+      {
+	  printf("NOT enough memory! Temproal derivative\n");
+	  goto return_NULL;
+      }
+  if(U_F == NULL || P_F == NULL || MASS == NULL || R_MASS == NULL)
+      {
+	  printf("NOT enough memory! Variables_F or MASS\n");
+	  goto return_NULL;
+      }
+  for(k = 0; k < m; ++k) // Initialize the values of mass in computational cells
+      MASS[k] = h * RHO[0][k];
+  for(j = 0; j < m; ++j) // the masses are fixed on Lagrangian coordinate
+      {
+	  R_MASS[j] = 1.0 / MASS[j];
+	  uniform = uniform && MASS[j] == MASS[0];
+      }
+
+//-----------------------THE MAIN LOOP--------------------------------
+  for(k = 1; k <= N; ++k)
+  {
+      tic = wall_time();
+      nt_w = nt;
+      if (time_c >= time_plot[nt_plot] - eps && nt_plot < (*N_plot-1))
+	  {
+	      if(stream)
+		  {
+		      PHASE_TIC(PT_IO);
+		      file_1D_write_stream(ctx, m, nt_plot, CV, nt, X[nt], NULL, problem, time_plot[nt_plot]);
+		      PHASE_TOC(PT_IO);
+		  }
+	      nt_plot++;
+	      if (nt < (N_T-1)) // The next step writes the next level from this one, which is kept for the plot.
+		  nt_w = nt+1;
+	  }
+
+      if(k == 1) // The GRP of the first time step is solved in a separate pass.
+	  {
+	      h_S_max = INFINITY; // h/S_max = INFINITY
+
+	      find_bound = bound_cond_slope_limiter(ctx, true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, true, time_c, X[nt]);
+	      if(!find_bound)
+		  goto return_NULL;
+
+	      PHASE_TIC(PT_SOLVE);
+	      for(j = 0; j <= m; ++j)
+		  {
+		      retval = GRP_LAG_interface(ctx, j, m, k, RHO[nt], U[nt], P[nt], s_rho, s_u, s_p, X[nt], &bfv_L, &bfv_R, &h_S_max,
+						 RHO_next_L, RHO_next_R, U_next, P_next, RHO_t_L, RHO_t_R, U_t, P_t);
+		      if(retval > 1)
+			  goto return_NULL;
+		      else if(retval)
+			  stop_t = true;
+		  }
+	      PHASE_TOC(PT_SOLVE);
+	  }
+      else // The GRP of this time step has been solved in the sweep of the last time step.
+	  {
+	      h_S_max  = h_S_next;
+	      h_S_next = INFINITY;
+	      if(grp_next > 1)
+		  goto return_NULL;
+	      else if(grp_next)
+		  stop_t = true;
+	      grp_next = 0;
+	  }
+
+//====================Time step and grid movement======================
+    PHASE_TIC(PT_CFL);
+    // If no total time, use fixed tau and time step N.
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
+	{
+	    tau = tau_cfl = fmin(CFL * h_S_max, C_m * tau_cfl);
+	    if(tau < eps)
+		{
+		    printf("\nThe length of the time step is so small on [%d, %g, %g] (t_n, time_c, tau)\n", k, time_c, tau);
+		    stop_t = true;
+		}
+	    else if((time_c + tau) > (t_all - eps))
+		tau = t_all - time_c;
+	    else if(!isfinite(tau))
+		{
+		    printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, tau) - CFL\n", k, time_c, tau);
+		    goto return_NULL;
+		}
+	    else if(nt_plot < (*N_plot-1) && (time_c + tau) > (time_plot[nt_plot] - eps))
+		tau = time_plot[nt_plot] - time_c; // The step lands on the plotting time.
+	}
+    PHASE_TOC(PT_CFL);
+
+//======================THE FUSED SWEEP=========================(On Lagrangian Coordinate)
+    PHASE_TIC(PT_UPDATE); // The sweep also contains the flux, the slopes and the GRP of the next time step.
+    for(j0 = 0; j0 <= m; j0 += tile)
+	{
+	    j1 = j0 + tile < m+1 ? j0 + tile : m+1;
+	    // flux and grid motion at interfaces [j0, j1)
+	    for(j = j0; j < j1; ++j)
+		{
+		    U_F[j] = U_next[j] + 0.5 * tau * U_t[j];
+		    P_F[j] = P_next[j] + 0.5 * tau * P_t[j];
+
+		    RHO_next_L[j] += tau * RHO_t_L[j];
+		    RHO_next_R[j] += tau * RHO_t_R[j];
+		    U_next[j]     += tau * U_t[j];
+		    P_next[j]     += tau * P_t[j];
+
+		    X[nt_w][j] = X[nt][j] + tau * U_F[j]; // motion along the contact discontinuity
+		}
+	    // forward Euler in cells [j0-1, j1-1)
+	    for(j = j0 > 0 ? j0-1 : 0; j < j1-1; ++j)
+		if(LAG_update_cell(j, tau * R_MASS[uniform ? 0 : j], gamma, eps, RHO[nt], U[nt], E[nt],
+				   RHO[nt_w], U[nt_w], P[nt_w], E[nt_w], X[nt_w], U_F, P_F,
+				   U_next, P_next, RHO_next_L, RHO_next_R, s_rho, s_u, s_p))
+		    {
+			printf("<0.0 error on [%d, %d] (t_n, x) - Update\n", k, j);
+			stop_t = true;
+		    }
+	    // slope limiter of the next time step in interior cells [j0-2, j1-2)
+	    for(i = j0 > 3 ? j0-2 : 1; i < j1-2 && i < m-1; ++i)
+		{
+		    minmod_limiter_cell(ctx, i, m, s_u,   U[nt_w],   0.0, 0.0, 0.0, 0.0, X[nt_w]);
+		    minmod_limiter_cell(ctx, i, m, s_p,   P[nt_w],   0.0, 0.0, 0.0, 0.0, X[nt_w]);
+		    minmod_limiter_cell(ctx, i, m, s_rho, RHO[nt_w], 0.0, 0.0, 0.0, 0.0, X[nt_w]);
+		}
+	    // GRP of the next time step at interior interfaces [j0-2, j1-2)
+	    for(i = j0 > 4 ? j0-2 : 2; i < j1-2 && i < m-1; ++i)
+		if(grp_next < 2)
+		    grp_next |= GRP_LAG_interface(ctx, i, m, k+1, RHO[nt_w], U[nt_w], P[nt_w], s_rho, s_u, s_p, X[nt_w], &bfv_L, &bfv_R, &h_S_next,
+						  RHO_next_L, RHO_next_R, U_next, P_next, RHO_t_L, RHO_t_R, U_t, P_t);
+	}
+    nt = nt_w;
+    PHASE_TOC(PT_UPDATE);
+
+//==================Boundary cells and interfaces of the next time step===================
+    find_bound = bound_cond_slope_limiter(ctx, true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, false, time_c + tau, X[nt]);
+    if(!find_bound)
+	goto return_NULL;
+    PHASE_TIC(PT_SLOPE);
+    minmod_limiter_cell(ctx, 0,   m, s_u,   U[nt],   bfv_L.U,   bfv_R.U,   bfv_L.H, bfv_R.H, X[nt]);
+    minmod_limiter_cell(ctx, 0,   m, s_p,   P[nt],   bfv_L.P,   bfv_R.P,   bfv_L.H, bfv_R.H, X[nt]);
+    minmod_limiter_cell(ctx, 0,   m, s_rho, RHO[nt], bfv_L.RHO, bfv_R.RHO, bfv_L.H, bfv_R.H, X[nt]);
+    minmod_limiter_cell(ctx, m-1, m, s_u,   U[nt],   bfv_L.U,   bfv_R.U,   bfv_L.H, bfv_R.H, X[nt]);
+    minmod_limiter_cell(ctx, m-1, m, s_p,   P[nt],   bfv_L.P,   bfv_R.P,   bfv_L.H, bfv_R.H, X[nt]);
+    minmod_limiter_cell(ctx, m-1, m, s_rho, RHO[nt], bfv_L.RHO, bfv_R.RHO, bfv_L.H, bfv_R.H, X[nt]);
+    switch(bound)
+	{
+	case -2: // reflective boundary conditions
+	    bfv_L.SU   =   s_u[0];   bfv_R.SU = s_u[m-1];
+	    break;
+	case -7: // periodic boundary conditions
+	    bfv_L.SU   =   s_u[m-1]; bfv_R.SU   =   s_u[0];
+	    bfv_L.SP   =   s_p[m-1]; bfv_R.SP   =   s_p[0];
+	    bfv_L.SRHO = s_rho[m-1]; bfv_R.SRHO = s_rho[0];
+	    break;
+	case -24: // reflective + free boundary conditions
+	    bfv_L.SU   =   s_u[0];
+	    break;
+	}
+    PHASE_TOC(PT_SLOPE);
+    PHASE_TIC(PT_SOLVE);
+    for(j = 0; j <= m; j = (j == 1 ? m-1 : j+1))
+	if(grp_next < 2)
+	    grp_next |= GRP_LAG_interface(ctx, j, m, k+1, RHO[nt], U[nt], P[nt], s_rho, s_u, s_p, X[nt], &bfv_L, &bfv_R, &h_S_next,
+					  RHO_next_L, RHO_next_R, U_next, P_next, RHO_t_L, RHO_t_R, U_t, P_t);
+    PHASE_TOC(PT_SOLVE);
+
+//============================Time update=======================
+
+    time_c += tau;
+    if(isfinite(t_all))
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
+    else
+        telemetry_step(k*100.0/N, k, time_c, tau);
+    file_1D_publish(ctx, m, k, CV, nt, X[nt], time_c);
+    if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
+	break;
+
+//===========================Fixed variable location=======================
+
+    toc = wall_time();
+    cpu_time_sum += toc - tic;
+    cpu_time[nt]  = cpu_time_sum;
+  }
+
+  printf("\nTime is up at time step %d.\n", k);
+  printf("The cost of wall-clock time for 1D-GRP Lagrangian scheme for this problem is %g seconds.\n", cpu_time_sum);
+//---------------------END OF THE MAIN LOOP----------------------
+
+return_NULL:
+  ctx->conf[5] = (double)k;
+  *N_plot = nt_plot+1;
+  if(isfinite(time_c))
+      time_plot[nt_plot] = time_c;
+  else if(isfinite(t_all))
+      time_plot[nt_plot] = t_all;
+  else if(isfinite(tau))
+      time_plot[nt_plot] = k*tau;
+
+  free(s_u);
+  free(s_p);
+  free(s_rho);
+  s_u   = NULL;
+  s_p   = NULL;
+  s_rho = NULL;
+  free(U_next);
+  free(P_next);
+  free(RHO_next_L);
+  free(RHO_next_R);
+  U_next     = NULL;
+  P_next     = NULL;
+  RHO_next_L = NULL;
+  RHO_next_R = NULL;
+  free(U_t);
+  free(P_t);
+  free(RHO_t_L);
+  free(RHO_t_R);
+  U_t     = NULL;
+  P_t     = NULL;
+  RHO_t_L = NULL;
+  RHO_t_R = NULL;
+  free(U_F);
+  free(P_F);
+  U_F = NULL;
+  P_F = NULL;
+  free(MASS);
+  free(R_MASS);
+  MASS = NULL;
+  R_MASS = NULL;
+}
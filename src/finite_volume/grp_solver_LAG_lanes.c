@@ -0,0 +1,358 @@
+/**
+ * @file  grp_solver_LAG_lanes.c
+ * @brief This is a Lagrangian GRP scheme to solve the 1-D Euler equations of a group of independent problems together.
+ * @details The members of an ensemble with the same number of grids run in the lanes of the batched GRP solver,
+ *          the interfaces j of all the active members are interleaved in a batch, so that the branching of the
+ *          GRP solver is masked lane by lane. Each member keeps its own run context, boundary conditions,
+ *          time step and time, and its lanes retire as it finishes.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "../include/var_struc.h"
+#include "../include/riemann_solver.h"
+#include "../include/inter_process.h"
+#include "../include/tools.h"
+#include "../include/finite_volume.h"
+
+
+//! The number of the scratch arrays of a member at the cells or the interfaces.
+#define LANE_NV 15
+
+//! The state of the time loop of a member (a lane) of the group.
+struct lane_var {
+	double * s_rho, * s_u, * s_p;                           //!< slopes of the cells.
+	double * U_next, * P_next, * RHO_next_L, * RHO_next_R;  //!< GRP solutions at the interfaces.
+	double * U_t, * P_t, * RHO_t_L, * RHO_t_R;              //!< temporal derivatives at the interfaces.
+	double * U_F, * P_F;                                    //!< numerical fluxes at the interfaces.
+	double * R_MASS;                                        //!< reciprocals of the masses of the cells.
+	_Bool uniform;               //!< whether the grids are of uniform mass.
+	struct b_f_var bfv_L, bfv_R; //!< fluid variables at the left/right boundary.
+	_Bool find_bound;            //!< whether the boundary conditions have been found.
+	double tau;                  //!< length of the time step.
+	double h_S_max;              //!< h/S_max, S_max is the maximum wave speed.
+	int k;                       //!< number of the time steps done.
+	int err;                     //!< miscalculation of the interfaces (> 1: stop without the update, 1: stop after it).
+};
+
+/**
+ * @brief This function gives the batch of the interfacial variables from the lane l on.
+ */
+static struct i_f_var_batch lane_shift(const struct i_f_var_batch * b, const int l)
+{
+    struct i_f_var_batch s = {b->RHO+l, b->U+l, b->P+l, b->s_rho+l, b->s_u+l, b->s_p+l, b->gamma+l};
+    return s;
+}
+
+/**
+ * @brief This function use GRP scheme to solve the 1-D Euler equations of motion on Lagrangian coordinate
+ *        for a group of independent problems (the members of an ensemble) in the lanes of a batch.
+ * @details Only the current level of the fluid variables of each member is kept in memory and nothing is plotted.
+ *          The time step of each member is given by its own CFL condition, or the minimum of them if config[76]
+ *          of the first member is true. A member stops at its total time, at its maximum number of time steps
+ *          or at a miscalculation, the others go on. The interfacial states are checked as config[72] of the first member.
+ * @param[in,out] ctx:    Array of the pointers to the run contexts of the members (config[5]: number of the time steps done).
+ * @param[in]     W:      Number of the members (<= GRP_BATCH_SIZE).
+ * @param[in]     m:      Number of the grids of every member.
+ * @param[in,out] CV:     Array of the structures of cell variable data of the members.
+ * @param[in,out] X:      Array of the arrays of the coordinate data of the members.
+ * @param[out]    time_c: Array of the times reached by the members.
+ * @return    Whether there is enough memory (0: Success, 5: Memory error).
+ */
+int GRP_solver_LAG_lanes(struct run_ctx * const ctx[], const int W, const int m, struct cell_var_stru CV[], double * X[], double time_c[])
+{
+  int j, jb, l, a, w, err, na, nb;
+  double const eps    = ctx[0]->conf[4];            // the largest value could be seen as zero
+  int    const n_check = (int)ctx[0]->conf[72];     // the number of time steps between the batch checks of the interfaces
+  _Bool  const shared = (_Bool)ctx[0]->conf[76];    // the minimum time step shared by the members
+  double const C_m    = 1.01; // a multiplicative coefficient allows the time step to increase.
+  double c_L, c_R, h_L, h_R, tau_s, gamma;
+  _Bool check, single = true; // single: the same gamma of all the members
+  int act[GRP_BATCH_SIZE], n_act = 0; // the active members
+
+  // the states on both sides of the interfaces in a batch
+  double RHO_L[GRP_BATCH_SIZE], U_L[GRP_BATCH_SIZE], P_L[GRP_BATCH_SIZE], t_rho_L[GRP_BATCH_SIZE], t_u_L[GRP_BATCH_SIZE], t_p_L[GRP_BATCH_SIZE];
+  double RHO_R[GRP_BATCH_SIZE], U_R[GRP_BATCH_SIZE], P_R[GRP_BATCH_SIZE], t_rho_R[GRP_BATCH_SIZE], t_u_R[GRP_BATCH_SIZE], t_p_R[GRP_BATCH_SIZE];
+  double gam[GRP_BATCH_SIZE];
+  struct i_f_var_batch bv_L = {RHO_L, U_L, P_L, t_rho_L, t_u_L, t_p_L, gam}, bv_s;
+  struct i_f_var_batch bv_R = {RHO_R, U_R, P_R, t_rho_R, t_u_R, t_p_R, gam}, bv_t;
+  // the GRP solutions at the interfaces in a batch
+  double D_a[4][GRP_BATCH_SIZE], U_a[4][GRP_BATCH_SIZE];
+  double * const D_b[4] = {D_a[0], D_a[1], D_a[2], D_a[3]};
+  double * const U_b[4] = {U_a[0], U_a[1], U_a[2], U_a[3]};
+  struct gamma_const gc;
+
+  struct lane_var * LV = (struct lane_var *)calloc(W, sizeof(struct lane_var));
+  double * block = (double *)malloc((size_t)W * LANE_NV * (m+1) * sizeof(double));
+  if(LV == NULL || block == NULL)
+      {
+	  printf("NOT enough memory! Lanes of the ensemble\n");
+	  free(LV);
+	  free(block);
+	  return 5;
+      }
+  for(w = 0; w < W; ++w)
+      {
+	  struct lane_var * L = LV + w;
+	  double * b = block + (size_t)w * LANE_NV * (m+1);
+	  L->s_rho      = b;
+	  L->s_u        = b +  1*(m+1);
+	  L->s_p        = b +  2*(m+1);
+	  L->U_next     = b +  3*(m+1);
+	  L->P_next     = b +  4*(m+1);
+	  L->RHO_next_L = b +  5*(m+1);
+	  L->RHO_next_R = b +  6*(m+1);
+	  L->U_t        = b +  7*(m+1);
+	  L->P_t        = b +  8*(m+1);
+	  L->RHO_t_L    = b +  9*(m+1);
+	  L->RHO_t_R    = b + 10*(m+1);
+	  L->U_F        = b + 11*(m+1);
+	  L->P_F        = b + 12*(m+1);
+	  L->R_MASS     = b + 13*(m+1);
+	  L->uniform = true;
+	  for(j = 0; j < m; ++j)
+	      {
+		  L->s_rho[j] = L->s_u[j] = L->s_p[j] = 0.0;
+		  L->R_MASS[j] = 1.0 / (ctx[w]->conf[10] * CV[w].RHO[0][j]);
+		  L->uniform = L->uniform && L->R_MASS[j] == L->R_MASS[0];
+	      }
+	  CV[w].d_rho = L->s_rho;
+	  CV[w].d_u   = L->s_u;
+	  CV[w].d_p   = L->s_p;
+	  L->bfv_L = (struct b_f_var){.H = ctx[w]->conf[10]};
+	  L->bfv_R = L->bfv_L;
+	  L->tau   = ctx[w]->conf[16];
+	  time_c[w] = 0.0;
+	  single = single && ctx[w]->conf[6] == ctx[0]->conf[6];
+	  if((int)ctx[w]->conf[5] > 0)
+	      act[n_act++] = w;
+      }
+  gamma_const_set(&gc, ctx[0]->conf[6]);
+
+//-----------------------THE MAIN LOOP--------------------------------
+  while(n_act > 0)
+  {
+      for(a = 0; a < n_act; ++a)
+	  {
+	      struct lane_var * L = LV + (w = act[a]);
+	      L->h_S_max = INFINITY; // h/S_max = INFINITY
+	      L->err     = 0;
+	      L->find_bound = bound_cond_slope_limiter(ctx[w], true, m, 0, CV+w, &L->bfv_L, &L->bfv_R, L->find_bound, true, time_c[w], X[w]);
+	      if(!L->find_bound)
+		  L->err = 2;
+	  }
+      check = n_check > 0 && (LV[act[0]].k+1) % n_check == 0;
+
+      nb = GRP_BATCH_SIZE / n_act; // the interfaces of a member in a batch
+      for(jb = 0; jb <= m; jb += nb)
+	  {
+	      int const nj = m+1-jb < nb ? m+1-jb : nb;
+	      for(j = jb; j < jb+nj; ++j) // Gather the interfaces j of the active members.
+		  for(a = 0; a < n_act; ++a)
+		      { /*
+			 *  j-1          j          j+1
+			 * j-1/2  j-1  j+1/2   j   j+3/2  j+1
+			 *   o-----X-----o-----X-----o-----X--...
+			 */
+			  struct lane_var * L = LV + (w = act[a]);
+			  const double * RHO = CV[w].RHO[0], * U = CV[w].U[0], * P = CV[w].P[0];
+			  int const bound = (int)ctx[w]->conf[17];
+			  l = (j-jb)*n_act + a; // the lane of the interface j of the member
+			  gam[l] = gamma = ctx[w]->conf[6];
+			  if(j)
+			      {
+				  h_L        =   X[w][j] - X[w][j-1];
+				  RHO_L[l]   = RHO[j-1] + 0.5*h_L*L->s_rho[j-1];
+				  U_L[l]     =   U[j-1] + 0.5*h_L*L->s_u[j-1];
+				  P_L[l]     =   P[j-1] + 0.5*h_L*L->s_p[j-1];
+				  t_rho_L[l] = L->s_rho[j-1];
+				  t_u_L[l]   =   L->s_u[j-1];
+				  t_p_L[l]   =   L->s_p[j-1];
+			      }
+			  else
+			      {
+				  h_L        = L->bfv_L.H;
+				  RHO_L[l]   = L->bfv_L.RHO + 0.5*h_L*L->bfv_L.SRHO;
+				  U_L[l]     = L->bfv_L.U   + 0.5*h_L*L->bfv_L.SU;
+				  P_L[l]     = L->bfv_L.P   + 0.5*h_L*L->bfv_L.SP;
+				  t_rho_L[l] = L->bfv_L.SRHO;
+				  t_u_L[l]   = L->bfv_L.SU;
+				  t_p_L[l]   = L->bfv_L.SP;
+			      }
+			  if(j < m)
+			      {
+				  h_R        =   X[w][j+1] - X[w][j];
+				  RHO_R[l]   = RHO[j] - 0.5*h_R*L->s_rho[j];
+				  U_R[l]     =   U[j] - 0.5*h_R*L->s_u[j];
+				  P_R[l]     =   P[j] - 0.5*h_R*L->s_p[j];
+				  t_rho_R[l] = L->s_rho[j];
+				  t_u_R[l]   =   L->s_u[j];
+				  t_p_R[l]   =   L->s_p[j];
+			      }
+			  else
+			      {
+				  h_R        = L->bfv_R.H;
+				  RHO_R[l]   = L->bfv_R.RHO + 0.5*h_R*L->bfv_R.SRHO;
+				  U_R[l]     = L->bfv_R.U   + 0.5*h_R*L->bfv_R.SU;
+				  P_R[l]     = L->bfv_R.P   + 0.5*h_R*L->bfv_R.SP;
+				  t_rho_R[l] = L->bfv_R.SRHO;
+				  t_u_R[l]   = L->bfv_R.SU;
+				  t_p_R[l]   = L->bfv_R.SP;
+			      }
+			  // the material derivatives
+			  t_rho_L[l] /= RHO_L[l]; t_u_L[l] /= RHO_L[l]; t_p_L[l] /= RHO_L[l];
+			  t_rho_R[l] /= RHO_R[l]; t_u_R[l] /= RHO_R[l]; t_p_R[l] /= RHO_R[l];
+
+			  c_L = sqrt(gamma * P_L[l] / RHO_L[l]);
+			  c_R = sqrt(gamma * P_R[l] / RHO_R[l]);
+			  L->h_S_max = fmin(L->h_S_max, h_L/c_L);
+			  L->h_S_max = fmin(L->h_S_max, h_R/c_R);
+			  if ((bound == -2 || bound == -24) && j == 0) // reflective boundary conditions
+			      L->h_S_max = fmin(L->h_S_max, h_L/(fabs(U_L[l])+c_L));
+			  if (bound == -2 && j == m)
+			      L->h_S_max = fmin(L->h_S_max, h_R/(fabs(U_R[l])+c_R));
+		      }
+	      na = nj * n_act;
+	      for(l = 0; check && l < na; ++l) // the lanes of the miscalculated members
+		  {
+		      bv_s = lane_shift(&bv_L, l);
+		      bv_t = lane_shift(&bv_R, l);
+		      if((a = ifvar_check_batch(ctx[0], na-l, &bv_s, &bv_t, &err)) < 0)
+			  break;
+		      l += a;
+		      w = act[l % n_act];
+		      if(LV[w].err < 2)
+			  printf("%s on [%d, %d] (t_n, x) of member %d.\n", ifvar_check_msg(err, 1), LV[w].k+1, jb + l/n_act, w);
+		      LV[w].err = 2;
+		  }
+
+//========================Solve GRP========================
+	      if(single)
+		  linear_GRP_solver_LAG_batch_gc(na, D_b, U_b, &bv_L, &bv_R, &gc, eps, eps);
+	      else
+		  linear_GRP_solver_LAG_batch(na, D_b, U_b, &bv_L, &bv_R, eps, eps);
+
+	      for(j = jb; j < jb+nj; ++j) // Scatter the GRP solutions to the members.
+		  for(a = 0; a < n_act; ++a)
+		      {
+			  struct lane_var * L = LV + act[a];
+			  l = (j-jb)*n_act + a;
+			  L->RHO_next_L[j] = U_a[0][l];
+			  L->U_next[j]     = U_a[1][l];
+			  L->P_next[j]     = U_a[2][l];
+			  L->RHO_next_R[j] = U_a[3][l];
+			  L->RHO_t_L[j]    = D_a[0][l];
+			  L->U_t[j]        = D_a[1][l];
+			  L->P_t[j]        = D_a[2][l];
+			  L->RHO_t_R[j]    = D_a[3][l];
+		      }
+	  }
+
+//====================Time step of each member======================
+      tau_s = INFINITY;
+      for(a = 0; a < n_act; ++a)
+	  {
+	      struct lane_var * L = LV + (w = act[a]);
+	      const double * mid[4]  = {L->RHO_next_L, L->U_next, L->P_next, L->RHO_next_R};
+	      const double * dire[4] = {L->RHO_t_L,    L->U_t,    L->P_t,    L->RHO_t_R};
+	      if(!L->err && check && (j = star_dire_check_batch(ctx[w], m+1, mid, dire, 1, &err)) >= 0)
+		  {
+		      printf("%s on [%d, %d] (t_n, x) of member %d.\n", star_dire_check_msg(err), L->k+1, j, w);
+		      L->err = 1;
+		  }
+	      // If no total time, use fixed tau and time step N.
+	      if(isfinite(ctx[w]->conf[1]) || !isfinite(ctx[w]->conf[16]) || ctx[w]->conf[16] <= 0.0)
+		  L->tau = fmin(ctx[w]->conf[7] * L->h_S_max, C_m * L->tau);
+	      if(!L->err)
+		  tau_s = fmin(tau_s, L->tau);
+	  }
+      for(a = 0; a < n_act; ++a)
+	  {
+	      struct lane_var * L = LV + (w = act[a]);
+	      double const t_all = ctx[w]->conf[1];
+	      if(shared && isfinite(tau_s))
+		  L->tau = tau_s;
+	      if(L->err > 1)
+		  continue;
+	      if(L->tau < eps)
+		  {
+		      printf("\nThe length of the time step is so small on [%d, %g, %g] (t_n, time_c, tau) of member %d\n", L->k+1, time_c[w], L->tau, w);
+		      L->err = 1;
+		  }
+	      else if((time_c[w] + L->tau) > (t_all - eps))
+		  L->tau = t_all - time_c[w];
+	      else if(!isfinite(L->tau))
+		  {
+		      printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, tau) of member %d - CFL\n", L->k+1, time_c[w], L->tau, w);
+		      L->err = 2;
+		  }
+	  }
+
+//======================THE CORE ITERATION=========================(On Lagrangian Coordinate)
+      for(a = 0; a < n_act; ++a)
+	  {
+	      struct lane_var * L = LV + (w = act[a]);
+	      double * RHO = CV[w].RHO[0], * U = CV[w].U[0], * P = CV[w].P[0], * E = CV[w].E[0];
+	      double const tau = L->tau, gamma = ctx[w]->conf[6];
+	      if(L->err > 1)
+		  continue;
+	      for(j = 0; j <= m; ++j)
+		  {
+		      L->U_F[j] = L->U_next[j] + 0.5 * tau * L->U_t[j];
+		      L->P_F[j] = L->P_next[j] + 0.5 * tau * L->P_t[j];
+
+		      L->RHO_next_L[j] += tau * L->RHO_t_L[j];
+		      L->RHO_next_R[j] += tau * L->RHO_t_R[j];
+		      L->U_next[j]     += tau * L->U_t[j];
+		      L->P_next[j]     += tau * L->P_t[j];
+
+		      X[w][j] += tau * L->U_F[j]; // motion along the contact discontinuity
+		  }
+	      err = 0;
+	      if(L->uniform)
+		  {
+		      double const dt_m = tau * L->R_MASS[0];
+#pragma omp simd reduction(|:err)
+		      for(j = 0; j < m; ++j) // forward Euler
+			  err |= LAG_update_cell(j, dt_m, gamma, eps, RHO, U, E, RHO, U, P, E, X[w], L->U_F, L->P_F,
+						 L->U_next, L->P_next, L->RHO_next_L, L->RHO_next_R, L->s_rho, L->s_u, L->s_p);
+		  }
+	      else
+#pragma omp simd reduction(|:err)
+		  for(j = 0; j < m; ++j) // forward Euler
+		      err |= LAG_update_cell(j, tau * L->R_MASS[j], gamma, eps, RHO, U, E, RHO, U, P, E, X[w], L->U_F, L->P_F,
+					     L->U_next, L->P_next, L->RHO_next_L, L->RHO_next_R, L->s_rho, L->s_u, L->s_p);
+	      if(err) // Report the miscalculation in order of the cells.
+		  for(j = 0; j < m; ++j)
+		      if(P[j] < eps || RHO[j] < eps)
+			  {
+			      printf("<0.0 error on [%d, %d] (t_n, x) of member %d - Update\n", L->k+1, j, w);
+			      L->err = 1;
+			  }
+	      time_c[w] += tau;
+	      L->k++;
+	  }
+
+//======================Retire the members finished=========================
+      for(a = l = 0; a < n_act; ++a)
+	  {
+	      struct lane_var * L = LV + (w = act[a]);
+	      if(!L->err && time_c[w] <= ctx[w]->conf[1] - eps && isfinite(time_c[w]) && L->k < (int)ctx[w]->conf[5])
+		  act[l++] = w;
+	  }
+      n_act = l;
+  }
+//---------------------END OF THE MAIN LOOP----------------------
+
+  for(w = 0; w < W; ++w)
+      {
+	  ctx[w]->conf[5] = (double)LV[w].k;
+	  CV[w].d_rho = CV[w].d_u = CV[w].d_p = NULL;
+      }
+  free(LV);
+  free(block);
+  return 0;
+}
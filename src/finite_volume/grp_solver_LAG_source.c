@@ -8,42 +8,158 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdbool.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "../include/var_struc.h"
 #include "../include/riemann_solver.h"
 #include "../include/inter_process.h"
 #include "../include/tools.h"
+#include "../include/file_io.h"
+#include "../include/finite_volume.h"
+#include "../include_cii/mem.h"
+#include "../include_cii/arena.h"
 
 
+/**
+ * @brief The states on both sides of the interface j of the batch of the interfaces from jb, with its CFL condition.
+ * @details B_L and B_R tell whether j is the left (j = 0) or the right (j = m) boundary interface,
+ *          whose states are given by the boundary conditions 'bfv_L' and 'bfv_R'. It is the body of IFACE_PEEL_LOOP().
+ *          \verbatim
+ *           j-1          j          j+1
+ *          j-1/2  j-1  j+1/2   j   j+3/2  j+1
+ *            o-----X-----o-----X-----o-----X--...
+ *          \endverbatim
+ */
+#define LAG_IFACE_STATE(B_L, B_R)					\
+    do {								\
+	if(!(B_L)) /* Initialize the initial values. */			\
+	    {								\
+		h_L       =   X[nt][j] - X[nt][j-1];			\
+		ifv_L.RHO = RHO[nt][j-1] + 0.5*h_L*s_rho[j-1];		\
+		ifv_L.U   =   U[nt][j-1] + 0.5*h_L*s_u[j-1];		\
+		ifv_L.P   =   P[nt][j-1] + 0.5*h_L*s_p[j-1];		\
+	    }								\
+	else								\
+	    {								\
+		h_L       = bfv_L.H;					\
+		ifv_L.RHO = bfv_L.RHO + 0.5*h_L*bfv_L.SRHO;		\
+		ifv_L.U   = bfv_L.U   + 0.5*h_L*bfv_L.SU;		\
+		ifv_L.P   = bfv_L.P   + 0.5*h_L*bfv_L.SP;		\
+	    }								\
+	if(!(B_R))							\
+	    {								\
+		h_R       =   X[nt][j+1] - X[nt][j];			\
+		ifv_R.RHO = RHO[nt][j] - 0.5*h_R*s_rho[j];		\
+		ifv_R.U   =   U[nt][j] - 0.5*h_R*s_u[j];		\
+		ifv_R.P   =   P[nt][j] - 0.5*h_R*s_p[j];		\
+	    }								\
+	else								\
+	    {								\
+		h_R       = bfv_R.H;					\
+		ifv_R.RHO = bfv_R.RHO + sgn_R*0.5*h_R*bfv_R.SRHO;	\
+		ifv_R.U   = bfv_R.U   + sgn_R*0.5*h_R*bfv_R.SU;		\
+		ifv_R.P   = bfv_R.P   + sgn_R*0.5*h_R*bfv_R.SP;		\
+	    }								\
+									\
+	c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);			\
+	c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);			\
+	h_S_max = fmin(h_S_max, h_L/c_L);				\
+	h_S_max = fmin(h_S_max, h_R/c_R);				\
+	if ((B_L) && wall_L) /* reflective boundary conditions */	\
+	    h_S_max = fmin(h_S_max, h_L/(fabs(ifv_L.U)+c_L));		\
+	if ((B_R) && wall_R)						\
+	    h_S_max = fmin(h_S_max, h_R/(fabs(ifv_R.U)+c_R));		\
+									\
+	if(!(B_L)) /* calculate the material derivatives */		\
+	    {								\
+		ifv_L.d_u   =   s_u[j-1];				\
+		ifv_L.d_p   =   s_p[j-1];				\
+		ifv_L.d_rho = s_rho[j-1];				\
+	    }								\
+	else								\
+	    {								\
+		ifv_L.d_rho = bfv_L.SRHO;				\
+		ifv_L.d_u   = bfv_L.SU;					\
+		ifv_L.d_p   = bfv_L.SP;					\
+	    }								\
+	ifv_L.t_u   =   ifv_L.d_u/ifv_L.RHO;				\
+	ifv_L.t_p   =   ifv_L.d_p/ifv_L.RHO;				\
+	ifv_L.t_rho = ifv_L.d_rho/ifv_L.RHO;				\
+	if(!(B_R))							\
+	    {								\
+		ifv_R.d_u   =   s_u[j];					\
+		ifv_R.d_p   =   s_p[j];					\
+		ifv_R.d_rho = s_rho[j];					\
+	    }								\
+	else								\
+	    {								\
+		ifv_R.d_rho = bfv_R.SRHO;				\
+		ifv_R.d_u   = bfv_R.SU;					\
+		ifv_R.d_p   = bfv_R.SP;					\
+	    }								\
+	ifv_R.t_u   =   ifv_R.d_u/ifv_R.RHO;				\
+	ifv_R.t_p   =   ifv_R.d_p/ifv_R.RHO;				\
+	ifv_R.t_rho = ifv_R.d_rho/ifv_R.RHO;				\
+	l = j - jb; /* the lane of the interface, all of which are checked in a batch */ \
+	qs[l] = quiet && ifvar_quiescent(&ifv_L, &ifv_R, eps);		\
+	if(!single)							\
+	    gam[l] = ifv_L.gamma;					\
+	RHO_L[l]   = ifv_L.RHO;						\
+	U_L[l]     = ifv_L.U;						\
+	P_L[l]     = ifv_L.P;						\
+	t_rho_L[l] = ifv_L.t_rho;					\
+	t_u_L[l]   = ifv_L.t_u;						\
+	t_p_L[l]   = ifv_L.t_p;						\
+	RHO_R[l]   = ifv_R.RHO;						\
+	U_R[l]     = ifv_R.U;						\
+	P_R[l]     = ifv_R.P;						\
+	t_rho_R[l] = ifv_R.t_rho;					\
+	t_u_R[l]   = ifv_R.t_u;						\
+	t_p_R[l]   = ifv_R.t_p;						\
+    } while (0)
+
 /**
  * @brief This function use GRP scheme to solve 1-D Euler
  *        equations of motion on Lagrangian coordinate.
+ * @details With MPI_1D, the cells are a part of the grids decomposed by halo_part_init_1D(),
+ *          whose ghost cells inside the grids are the edge cells of the neighbouring parts.
+ *          The masses of the cells are fixed, so the update kernel is chosen at the start of the run:
+ *          one reciprocal mass for the uniform-mass grids, or the array of the reciprocal masses otherwise.
+ * @param[in,out] ctx:    Pointer to the run context.
  * @param[in] m:          Number of the grids.
  * @param[in,out] CV:     Structure of cell variable data.
  * @param[in,out] X[]:    Array of the coordinate data.
  * @param[out] cpu_time:  Array of the CPU time recording.
+ * @param[in]  problem:   Name of the numerical results for the test problem.
+ * @param[in]  N_T:       Number of levels storing fluid variables in memory.
  * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
  * @param[in,out] time_plot: Array of the plotting time recording.
  */
-void GRP_solver_LAG_source(const int m, struct cell_var_stru CV, double * X[], double * cpu_time, int * N_plot, double time_plot[])
+void GRP_solver_LAG_source(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[])
 {
+#ifdef _OPENMP
+  printf("@@ Number of threads for OpenMP: %d\n", omp_get_max_threads());
+#endif
     /* 
      * j is a frequently used index for spatial variables.
      * k is a frequently used index for the time step.
      */
-  int j, k = 0;
+  int j, jb, k = 0;
 
-  clock_t tic, toc;
+  double tic, toc;
   double cpu_time_sum = 0.0;
 
-  double const t_all = config[1];       // the total time
-  double const eps   = config[4];       // the largest value could be seen as zero
-  int    const N     = (int)config[5];  // the maximum number of time steps
-  double const gamma = config[6];       // the constant of the perfect gas
-  double const CFL   = config[7];       // the CFL number
-  double const h     = config[10];      // the length of the initial spatial grids
-  double       tau   = config[16];      // the length of the time step
-  int    const bound = (int)config[17]; // the boundary condition in x-direction
+  double const t_all = ctx->conf[1];       // the total time
+  double const eps   = ctx->conf[4];       // the largest value could be seen as zero
+  int    const N     = (int)ctx->conf[5];  // the maximum number of time steps
+  double const gamma = ctx->conf[6];       // the constant of the perfect gas
+  double const CFL   = ctx->conf[7];       // the CFL number
+  double const h     = ctx->conf[10];      // the length of the initial spatial grids
+  double       tau   = ctx->conf[16];      // the length of the time step
+  double     tau_cfl = tau;                // the length of the time step before it lands on the plotting time
+  int    const bound = (int)ctx->conf[17]; // the boundary condition in x-direction
 
   _Bool find_bound = false;
 
@@ -51,198 +167,242 @@ void GRP_solver_LAG_source(const int m, struct cell_var_stru CV, double * X[], d
   double h_L, h_R; // length of spatial grids
 
   /*
-   * dire: the temporal derivative of fluid variables.
+   * dire: the arrays of the temporal derivative of fluid variables at the interfaces.
    *       \frac{\partial [ifv_L.RHO, u, p, ifv_R.RHO]}{\partial t}
-   * mid:  the Riemann solutions.
+   * mid:  the arrays of the Riemann solutions at the interfaces.
    *       [rho_star_L, u_star, p_star, rho_star_R]
    */
-  double dire[4], mid[4];
+  const double * dire[4], * mid[4];
 
   double h_S_max; // h/S_max, S_max is the maximum wave speed
   double time_c = 0.0; // the current time
   double C_m = 1.01; // a multiplicative coefficient allows the time step to increase.
   _Bool stop_t = false;
-  int nt = 0; // the number of times storing plotting data
+  int data_err; // whether there is miscalculation in the parallel loops
+  int j_err, err; // the first interface of the miscalculation and its indicator
+  int const n_check = (int)ctx->conf[72]; // the number of time steps between the batch checks of the interfaces
+  _Bool check; // whether the interfaces are checked at this time step
+  int nt = 0, nt_plot = 0; // the number of times storing plotting data
+  int nt_w; // the level written by the time step, the next one after a plotting time
+  _Bool const stream = (_Bool)ctx->conf[34]; // streaming output of the plotting data
+  _Bool const quiet  = (_Bool)ctx->conf[36]; // skip the GRP solver at the interfaces in quiescent regions
+  long n_solve = 0, n_face = 0; // the numbers of the GRP solvers called and of the interfaces
+  int    const n_ckpt  = (int)ctx->conf[43];   // the number of time steps between the checkpoints
+  _Bool  const restart = (_Bool)ctx->conf[44]; // restart from the checkpoint
+  struct ckpt_var ckpt = {0}; // the checkpoint of the state of the time loop
 
   struct b_f_var bfv_L = {.H = h, .SRHO = 0.0, .SP = 0.0, .SU = 0.0}, bfv_R = bfv_L; // Left/Right boundary condition
   struct i_f_var ifv_L = {.gamma = gamma}, ifv_R = ifv_L;
+  _Bool const single = (int)ctx->conf[2] <= 1; // single-fluid flow with the constant gamma
+  struct gamma_const gc; // the constants of the perfect gas
+  gamma_const_set(&gc, gamma);
+  int part[2] = {0, m}; // the part of the grids of this process {j0, m}
+  halo_part_1D(halo_rank_1D(), part);
+  // The ghost cell of a neighbouring part on the right is reconstructed as the interior cells.
+  double const sgn_R = halo_inner_1D(1) ? -1.0 : 1.0;
+  _Bool  const wall_L = (bound == -2 || bound == -24) && !halo_inner_1D(0); // reflective boundary on the left
+  _Bool  const wall_R =  bound == -2                  && !halo_inner_1D(1); // reflective boundary on the right
 
   double ** RHO  = CV.RHO;
   double ** U    = CV.U;
   double ** P    = CV.P;
   double ** E    = CV.E;
+  // the scratch arrays carved from the workspace of the thread, which is kept for the next runs
+  Arena_T ws = Arena_workspace();
+  ARENA_RESERVE(ws, 16*(m+1) * (long)sizeof(double) + 15*ARENA_ALIGN);
   // the slopes of variable values
-  double * s_rho = (double*)calloc(m, sizeof(double));
-  double * s_u   = (double*)calloc(m, sizeof(double));
-  double * s_p   = (double*)calloc(m, sizeof(double));
+  double * s_rho = (double*)ARENA_CALLOC(ws, m, sizeof(double));
+  double * s_u   = (double*)ARENA_CALLOC(ws, m, sizeof(double));
+  double * s_p   = (double*)ARENA_CALLOC(ws, m, sizeof(double));
   CV.d_rho = s_rho;
   CV.d_u   = s_u;
   CV.d_p   = s_p;
   // the variable values at (x_{j-1/2}, t_{n+1}).
-  double * U_next     = (double*)malloc((m+1) * sizeof(double));
-  double * P_next     = (double*)malloc((m+1) * sizeof(double));
-  double * RHO_next_L = (double*)malloc((m+1) * sizeof(double));
-  double * RHO_next_R = (double*)malloc((m+1) * sizeof(double));
+  double * U_next     = (double*)ARENA_ALLOC(ws, (m+1) * sizeof(double));
+  double * P_next     = (double*)ARENA_ALLOC(ws, (m+1) * sizeof(double));
+  double * RHO_next_L = (double*)ARENA_ALLOC(ws, (m+1) * sizeof(double));
+  double * RHO_next_R = (double*)ARENA_ALLOC(ws, (m+1) * sizeof(double));
   // the temporal derivatives at (x_{j-1/2}, t_{n}).
-  double * U_t     = (double*)malloc((m+1) * sizeof(double));
-  double * P_t     = (double*)malloc((m+1) * sizeof(double));
-  double * RHO_t_L = (double*)malloc((m+1) * sizeof(double));
-  double * RHO_t_R = (double*)malloc((m+1) * sizeof(double));
+  double * U_t     = (double*)ARENA_ALLOC(ws, (m+1) * sizeof(double));
+  double * P_t     = (double*)ARENA_ALLOC(ws, (m+1) * sizeof(double));
+  double * RHO_t_L = (double*)ARENA_ALLOC(ws, (m+1) * sizeof(double));
+  double * RHO_t_R = (double*)ARENA_ALLOC(ws, (m+1) * sizeof(double));
   // the numerical flux at (x_{j-1/2}, t_{n+1/2}).
-  double * U_F  = (double*)malloc((m+1) * sizeof(double));
-  double * P_F  = (double*)malloc((m+1) * sizeof(double));
-  double * MASS = (double*)malloc(m * sizeof(double)); // Array of the mass data in computational cells.
-  if(s_rho == NULL || s_u == NULL || s_p == NULL)
-      {
-	  printf("NOT enough memory! Slope\n");
-	  goto return_NULL;
-      }
-  if(U_next == NULL || P_next == NULL || RHO_next_L == NULL || RHO_next_R == NULL)
-      {
-	  printf("NOT enough memory! Variables_next\n");
-	  goto return_NULL;
-      }
-  if(U_t == NULL || P_t == NULL || RHO_t_L == NULL || RHO_t_R == NULL)
+  double * U_F  = (double*)ARENA_ALLOC(ws, (m+1) * sizeof(double));
+  double * P_F  = (double*)ARENA_ALLOC(ws, (m+1) * sizeof(double));
+  double * MASS = (double*)ARENA_ALLOC(ws, m * sizeof(double)); // Array of the mass data in computational cells.
+  double * R_MASS = (double*)ARENA_ALLOC(ws, m * sizeof(double)); // Array of the reciprocals of MASS.
+  _Bool uniform; // whether the grids are of uniform mass
+  int * if_err  = (int*)ARENA_ALLOC(ws, (m+1) * sizeof(int)); // the miscalculation indicators at (x_{j-1/2}, t_{n}).
+  mid[0]  = RHO_next_L; mid[1]  = U_next; mid[2]  = P_next; mid[3]  = RHO_next_R;
+  dire[0] = RHO_t_L;    dire[1] = U_t;    dire[2] = P_t;    dire[3] = RHO_t_R;
+  for(k = 0; k < m; ++k) // Initialize the values of mass in computational cells
+      MASS[k] = h * RHO[0][k];
+
+  if(n_ckpt > 0 || restart) // the state of the time loop
       {
-	  printf("NOT enough memory! Temproal derivative\n");
-	  goto return_NULL;
+	  if(checkpoint_init(ctx, &ckpt, problem))
+	      goto return_NULL;
+	  checkpoint_add(&ckpt, &k,            sizeof(k));
+	  checkpoint_add(&ckpt, &time_c,       sizeof(time_c));
+	  checkpoint_add(&ckpt, &tau,          sizeof(tau));
+	  checkpoint_add(&ckpt, &tau_cfl,      sizeof(tau_cfl));
+	  checkpoint_add(&ckpt, &nt,           sizeof(nt));
+	  checkpoint_add(&ckpt, &nt_plot,      sizeof(nt_plot));
+	  checkpoint_add(&ckpt, &find_bound,   sizeof(find_bound));
+	  checkpoint_add(&ckpt, &cpu_time_sum, sizeof(cpu_time_sum));
+	  checkpoint_add(&ckpt, &n_solve,      sizeof(n_solve));
+	  checkpoint_add(&ckpt, &n_face,       sizeof(n_face));
+	  checkpoint_add(&ckpt, &bfv_L,        sizeof(bfv_L));
+	  checkpoint_add(&ckpt, &bfv_R,        sizeof(bfv_R));
+	  checkpoint_add(&ckpt, cpu_time, N_T * sizeof(double));
+	  checkpoint_add(&ckpt, MASS,     m * sizeof(double));
+	  checkpoint_add(&ckpt, s_rho,    m * sizeof(double));
+	  checkpoint_add(&ckpt, s_u,      m * sizeof(double));
+	  checkpoint_add(&ckpt, s_p,      m * sizeof(double));
+	  checkpoint_add_1D(&ckpt, m, N_T, CV, X);
+	  if(restart && checkpoint_read(&ckpt))
+	      goto return_NULL;
       }
-  if(U_F == NULL || P_F == NULL || MASS == NULL)
+  uniform = true;
+  for(j = 0; j < m; ++j) // the masses are fixed on Lagrangian coordinate
       {
-	  printf("NOT enough memory! Variables_F or MASS\n");
-	  goto return_NULL;
+	  R_MASS[j] = 1.0 / MASS[j];
+	  uniform = uniform && MASS[j] == MASS[0];
       }
-  for(k = 0; k < m; ++k) // Initialize the values of mass in computational cells
-      MASS[k] = h * RHO[0][k];
+  uniform = halo_max_1D(!uniform) == 0; // the same kernel for all the parts
 
 //-----------------------THE MAIN LOOP--------------------------------
-  for(k = 1; k <= N; ++k)
+  for(k = restart ? k+1 : 1; k <= N; ++k) // Go on from the time step after the checkpoint.
   {
-      tic = clock();
-      if (time_c >= time_plot[nt] && nt < (*N_plot-1))
+      tic = wall_time();
+      nt_w = nt;
+      if (time_c >= time_plot[nt_plot] - eps && nt_plot < (*N_plot-1))
 	  {
-	      for(j = 0; j < m; ++j)
+	      if(stream)
 		  {
-		      RHO[nt+1][j] = RHO[nt][j];
-		      U[nt+1][j]   =   U[nt][j];
-		      E[nt+1][j]   =   E[nt][j];  
-		      P[nt+1][j]   =   P[nt][j];
-		      X[nt+1][j]   =   X[nt][j];
+		      PHASE_TIC(PT_IO);
+		      file_1D_write_stream(ctx, m, nt_plot, CV, nt, X[nt], NULL, problem, time_plot[nt_plot]);
+		      PHASE_TOC(PT_IO);
 		  }
-	      X[nt+1][m] = X[nt][m];
-	      nt++;
+	      nt_plot++;
+	      if (nt < (N_T-1)) // The next step writes the next level from this one, which is kept for the plot.
+		  nt_w = nt+1;
 	  }
 
       h_S_max = INFINITY; // h/S_max = INFINITY
 
-      find_bound = bound_cond_slope_limiter(true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, true, time_c, X[nt]);
+      find_bound = bound_cond_slope_limiter(ctx, true, m, nt, &CV, &bfv_L, &bfv_R, find_bound, true, time_c, X[nt]);
       if(!find_bound)
 	  goto return_NULL;
 
-      for(j = 0; j <= m; ++j)
-	  { /*
-	     *  j-1          j          j+1
-	     * j-1/2  j-1  j+1/2   j   j+3/2  j+1
-	     *   o-----X-----o-----X-----o-----X--...
-	     */
-	      if(j) // Initialize the initial values.
-		  {
-		      h_L       =   X[nt][j] - X[nt][j-1];
-		      ifv_L.RHO = RHO[nt][j-1] + 0.5*h_L*s_rho[j-1];
-		      ifv_L.U   =   U[nt][j-1] + 0.5*h_L*s_u[j-1];
-		      ifv_L.P   =   P[nt][j-1] + 0.5*h_L*s_p[j-1];
-		  }
-	      else
-		  {
-		      h_L       = bfv_L.H;
-		      ifv_L.RHO = bfv_L.RHO + 0.5*h_L*bfv_L.SRHO;
-		      ifv_L.U   = bfv_L.U   + 0.5*h_L*bfv_L.SU;
-		      ifv_L.P   = bfv_L.P   + 0.5*h_L*bfv_L.SP;
-		  }
-	      if(j < m)
-		  {
-		      h_R       =   X[nt][j+1] - X[nt][j];
-		      ifv_R.RHO = RHO[nt][j] - 0.5*h_R*s_rho[j];
-		      ifv_R.U   =   U[nt][j] - 0.5*h_R*s_u[j];
-		      ifv_R.P   =   P[nt][j] - 0.5*h_R*s_p[j];
-		  }
-	      else
-		  {
-		      h_R       = bfv_R.H;
-		      ifv_R.RHO = bfv_R.RHO + 0.5*h_R*bfv_R.SRHO;
-		      ifv_R.U   = bfv_R.U   + 0.5*h_R*bfv_R.SU;
-		      ifv_R.P   = bfv_R.P   + 0.5*h_R*bfv_R.SP;
-		  }
-
-	      c_L = sqrt(gamma * ifv_L.P / ifv_L.RHO);
-	      c_R = sqrt(gamma * ifv_R.P / ifv_R.RHO);
-	      h_S_max = fmin(h_S_max, h_L/c_L);
-	      h_S_max = fmin(h_S_max, h_R/c_R);
-	      if ((bound == -2 || bound == -24) && j == 0) // reflective boundary conditions
-		  h_S_max = fmin(h_S_max, h_L/(fabs(ifv_L.U)+c_L));
-	      if (bound == -2 && j == m)
-		  h_S_max = fmin(h_S_max, h_R/(fabs(ifv_R.U)+c_R));
-
-	      if(j) //calculate the material derivatives
-		  {
-		      ifv_L.d_u   =   s_u[j-1];
-		      ifv_L.d_p   =   s_p[j-1];
-		      ifv_L.d_rho = s_rho[j-1];
-		  }
-	      else
-		  {
-		      ifv_L.d_rho = bfv_L.SRHO;
-		      ifv_L.d_u   = bfv_L.SU;
-		      ifv_L.d_p   = bfv_L.SP;
-		  }
-	      ifv_L.t_u   =   ifv_L.d_u/ifv_L.RHO;
-	      ifv_L.t_p   =   ifv_L.d_p/ifv_L.RHO;
-	      ifv_L.t_rho = ifv_L.d_rho/ifv_L.RHO;
-	      if(j < m)
-		  {
-		      ifv_R.d_u   =   s_u[j];
-		      ifv_R.d_p   =   s_p[j];
-		      ifv_R.d_rho = s_rho[j];
-		  }
-	      else
-		  {
-		      ifv_R.d_rho = bfv_R.SRHO;
-		      ifv_R.d_u   = bfv_R.SU;
-		      ifv_R.d_p   = bfv_R.SP;
-		  }
-	      ifv_R.t_u   =   ifv_R.d_u/ifv_R.RHO;
-	      ifv_R.t_p   =   ifv_R.d_p/ifv_R.RHO;
-	      ifv_R.t_rho = ifv_R.d_rho/ifv_R.RHO;
-	      if(ifvar_check(&ifv_L, &ifv_R, 1))
-		  {
-		      printf(" on [%d, %d] (t_n, x).\n", k, j);
-		      goto return_NULL;
-		  }
+      PHASE_TIC(PT_SOLVE);
+      check = n_check > 0 && k % n_check == 0;
+      j_err = m+1;
+#pragma omp parallel for private(j, c_L, c_R, h_L, h_R, err) firstprivate(ifv_L, ifv_R) reduction(min:h_S_max) reduction(min:j_err) reduction(+:n_solve)
+      for(jb = 0; jb <= m; jb += GRP_BATCH_SIZE)
+	{
+	  const int nb = m+1-jb < GRP_BATCH_SIZE ? m+1-jb : GRP_BATCH_SIZE;
+	  int l, na = 0; // na is the number of the active interfaces in this block
+	  int idx[GRP_BATCH_SIZE]; // the serial numbers of the active interfaces
+	  _Bool qs[GRP_BATCH_SIZE]; // whether the interfaces of this block are in quiescent regions
+	  // the states on both sides of the active interfaces in this block
+	  double RHO_L[GRP_BATCH_SIZE], U_L[GRP_BATCH_SIZE], P_L[GRP_BATCH_SIZE], t_rho_L[GRP_BATCH_SIZE], t_u_L[GRP_BATCH_SIZE], t_p_L[GRP_BATCH_SIZE];
+	  double RHO_R[GRP_BATCH_SIZE], U_R[GRP_BATCH_SIZE], P_R[GRP_BATCH_SIZE], t_rho_R[GRP_BATCH_SIZE], t_u_R[GRP_BATCH_SIZE], t_p_R[GRP_BATCH_SIZE];
+	  double gam[GRP_BATCH_SIZE];
+	  struct i_f_var_batch bv_L = {RHO_L, U_L, P_L, t_rho_L, t_u_L, t_p_L, gam};
+	  struct i_f_var_batch bv_R = {RHO_R, U_R, P_R, t_rho_R, t_u_R, t_p_R, gam};
+	  // the GRP solutions at the active interfaces in this block
+	  double D_a[4][GRP_BATCH_SIZE], U_a[4][GRP_BATCH_SIZE];
+	  double * const D_b[4] = {D_a[0], D_a[1], D_a[2], D_a[3]};
+	  double * const U_b[4] = {U_a[0], U_a[1], U_a[2], U_a[3]};
+	  IFACE_PEEL_LOOP(j, jb, jb+nb, m, LAG_IFACE_STATE);
+	  if(check && (l = ifvar_check_batch(ctx, nb, &bv_L, &bv_R, &err)) >= 0)
+	      {
+		  if_err[jb+l] = err;
+		  j_err = jb+l;
+		  continue;
+	      }
+	  for(l = 0; l < nb; ++l) // Pack the active interfaces in front of the batch.
+	      {
+		  j = jb + l;
+		  if(qs[l]) // the uniform state without any wave
+		      {
+			  RHO_next_L[j] = RHO_L[l];
+			  RHO_next_R[j] = RHO_R[l];
+			  U_next[j]     = 0.5*(U_L[l] + U_R[l]);
+			  P_next[j]     = 0.5*(P_L[l] + P_R[l]);
+			  RHO_t_L[j]    = 0.0;
+			  RHO_t_R[j]    = 0.0;
+			  U_t[j]        = 0.0;
+			  P_t[j]        = 0.0;
+			  continue;
+		      }
+		  if(na < l)
+		      {
+			  if(!single)
+			      gam[na] = gam[l];
+			  RHO_L[na]   = RHO_L[l];
+			  U_L[na]     = U_L[l];
+			  P_L[na]     = P_L[l];
+			  t_rho_L[na] = t_rho_L[l];
+			  t_u_L[na]   = t_u_L[l];
+			  t_p_L[na]   = t_p_L[l];
+			  RHO_R[na]   = RHO_R[l];
+			  U_R[na]     = U_R[l];
+			  P_R[na]     = P_R[l];
+			  t_rho_R[na] = t_rho_R[l];
+			  t_u_R[na]   = t_u_R[l];
+			  t_p_R[na]   = t_p_R[l];
+		      }
+		  idx[na++] = j;
+	      }
+	  if(!na)
+	      continue;
+	  n_solve += na;
 
 //========================Solve GRP========================
-	      linear_GRP_solver_LAG(dire, mid, &ifv_L, &ifv_R, eps, eps);
-
-	      if(star_dire_check(mid, dire, 1))
-		  {
-		      printf(" on [%d, %d] (t_n, x).\n", k, j);
-		      stop_t = true;
-		  }
-
-	      RHO_next_L[j] = mid[0];
-	      RHO_next_R[j] = mid[3];
-	      U_next[j]     = mid[1];
-	      P_next[j]     = mid[2];
-	      RHO_t_L[j] = dire[0];
-	      RHO_t_R[j] = dire[3];
-	      U_t[j]     = dire[1];
-	      P_t[j]     = dire[2];
+	  if(single)
+	      linear_GRP_solver_LAG_batch_gc(na, D_b, U_b, &bv_L, &bv_R, &gc, eps, eps);
+	  else
+	      linear_GRP_solver_LAG_batch(na, D_b, U_b, &bv_L, &bv_R, eps, eps);
+
+	  for(l = 0; l < na; ++l)
+	      {
+		  j = idx[l];
+		  RHO_next_L[j] = U_a[0][l];
+		  U_next[j]     = U_a[1][l];
+		  P_next[j]     = U_a[2][l];
+		  RHO_next_R[j] = U_a[3][l];
+		  RHO_t_L[j]    = D_a[0][l];
+		  U_t[j]        = D_a[1][l];
+		  P_t[j]        = D_a[2][l];
+		  RHO_t_R[j]    = D_a[3][l];
+	      }
+	}
+      data_err = 0;
+      if(j_err <= m) // Report the first miscalculation of the interfaces.
+	  {
+	      printf("%s on [%d, %d] (t_n, x).\n", ifvar_check_msg(if_err[j_err], 1), k, part[0]+j_err);
+	      data_err = 2;
+	  }
+      else if(check && (j = star_dire_check_batch(ctx, m+1, mid, dire, 1, &err)) >= 0)
+	  {
+	      printf("%s on [%d, %d] (t_n, x).\n", star_dire_check_msg(err), k, part[0]+j);
+	      stop_t = true;
 	  }
+      if(halo_max_1D(data_err) > 1) // All processes stop at a miscalculation of the states.
+	  goto return_NULL;
+      n_face += m+1;
+      PHASE_TOC(PT_SOLVE);
+      h_S_max = halo_min_1D(h_S_max); // the CFL condition of all the parts
 
 //====================Time step and grid movement======================
+    PHASE_TIC(PT_CFL);
     // If no total time, use fixed tau and time step N.
-    if(isfinite(t_all) || !isfinite(config[16]) || config[16] <= 0.0)
+    if(isfinite(t_all) || !isfinite(ctx->conf[16]) || ctx->conf[16] <= 0.0)
 	{
-	    tau = fmin(CFL * h_S_max, C_m * tau);
+	    tau = tau_cfl = fmin(CFL * h_S_max, C_m * tau_cfl);
 	    if(tau < eps)
 		{
 		    printf("\nThe length of the time step is so small on [%d, %g, %g] (t_n, time_c, tau)\n", k, time_c, tau);
@@ -255,8 +415,13 @@ void GRP_solver_LAG_source(const int m, struct cell_var_stru CV, double * X[], d
 		    printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, tau) - CFL\n", k, time_c, tau); 
 		    goto return_NULL;
 		}
+	    else if(nt_plot < (*N_plot-1) && (time_c + tau) > (time_plot[nt_plot] - eps))
+		tau = time_plot[nt_plot] - time_c; // The step lands on the plotting time.
 	}
-    
+    PHASE_TOC(PT_CFL);
+
+    PHASE_TIC(PT_FLUX);
+#pragma omp parallel for
     for(j = 0; j <= m; ++j)
 	{
 	    U_F[j] = U_next[j] + 0.5 * tau * U_t[j];
@@ -267,89 +432,115 @@ void GRP_solver_LAG_source(const int m, struct cell_var_stru CV, double * X[], d
 	    U_next[j]     += tau * U_t[j];
 	    P_next[j]     += tau * P_t[j];
 
-	    X[nt][j] += tau * U_F[j]; // motion along the contact discontinuity
+	    X[nt_w][j] = X[nt][j] + tau * U_F[j]; // motion along the contact discontinuity
 	}
+    PHASE_TOC(PT_FLUX);
 
 //======================THE CORE ITERATION=========================(On Lagrangian Coordinate)
-    for(j = 0; j < m; ++j) // forward Euler
-	{ /*
-	   *  j-1          j          j+1
-	   * j-1/2  j-1  j+1/2   j   j+3/2  j+1
-	   *   o-----X-----o-----X-----o-----X--...
-	   */
-	    RHO[nt][j] = 1.0 / (1.0/RHO[nt][j] + tau/MASS[j]*(U_F[j+1] - U_F[j]));
-	    U[nt][j]   = U[nt][j] - tau/MASS[j]*(P_F[j+1] - P_F[j]);
-	    E[nt][j]   = E[nt][j] - tau/MASS[j]*(P_F[j+1]*U_F[j+1] - P_F[j]*U_F[j]);
-	    P[nt][j]   = (E[nt][j] - 0.5 * U[nt][j]*U[nt][j]) * (gamma - 1.0) * RHO[nt][j];
+    PHASE_TIC(PT_UPDATE);
+    data_err = 0;
+    if(uniform)
+	{
+	    double const dt_m = tau * R_MASS[0];
+#pragma omp parallel for simd reduction(|:data_err)
+	    for(j = 0; j < m; ++j) // forward Euler
+		data_err |= LAG_update_cell(j, dt_m, gamma, eps, RHO[nt], U[nt], E[nt],
+					    RHO[nt_w], U[nt_w], P[nt_w], E[nt_w], X[nt_w], U_F, P_F,
+					    U_next, P_next, RHO_next_L, RHO_next_R, s_rho, s_u, s_p);
+	}
+    else
+#pragma omp parallel for simd reduction(|:data_err)
+	for(j = 0; j < m; ++j) // forward Euler
+	    data_err |= LAG_update_cell(j, tau * R_MASS[j], gamma, eps, RHO[nt], U[nt], E[nt],
+					RHO[nt_w], U[nt_w], P[nt_w], E[nt_w], X[nt_w], U_F, P_F,
+					U_next, P_next, RHO_next_L, RHO_next_R, s_rho, s_u, s_p);
+    nt = nt_w;
+    if(data_err) // Report the miscalculation in order of the cells.
+	for(j = 0; j < m; ++j)
 	    if(P[nt][j] < eps || RHO[nt][j] < eps)
 		{
-		    printf("<0.0 error on [%d, %d] (t_n, x) - Update\n", k, j);
+		    printf("<0.0 error on [%d, %d] (t_n, x) - Update\n", k, part[0]+j);
 		    stop_t = true;
 		}
-	    
-//============================compute the slopes============================
-	    s_u[j]   = (    U_next[j+1] -     U_next[j])/(X[nt][j+1]-X[nt][j]);
-	    s_p[j]   = (    P_next[j+1] -     P_next[j])/(X[nt][j+1]-X[nt][j]);
-	    s_rho[j] = (RHO_next_L[j+1] - RHO_next_R[j])/(X[nt][j+1]-X[nt][j]);
-	}
+    PHASE_TOC(PT_UPDATE);
 
 //============================Time update=======================
 
+    if(halo_max_1D(telemetry_due())) // the totals of mass, momentum and energy of the record
+	{
+	    double q[3] = {0.0, 0.0, 0.0};
+	    if((int)ctx->conf[77] > 0) // the exact totals independent of the number of the processes
+		{
+		    struct repro_sum s_q[3];
+		    for(j = 0; j < 3; ++j)
+			repro_sum_init(s_q+j);
+		    for(j = 0; j < m; ++j)
+			{
+			    repro_sum_add(s_q,   MASS[j]);
+			    repro_sum_add(s_q+1, MASS[j]*U[nt][j]);
+			    repro_sum_add(s_q+2, MASS[j]*E[nt][j]);
+			}
+		    halo_repro_sum_1D(s_q, 3);
+		    for(j = 0; j < 3; ++j)
+			q[j] = repro_sum_value(s_q+j);
+		}
+	    else
+		{
+		    for(j = 0; j < m; ++j)
+			{
+			    q[0] += MASS[j];
+			    q[1] += MASS[j]*U[nt][j];
+			    q[2] += MASS[j]*E[nt][j];
+			}
+		    halo_sum_1D(q, 3);
+		}
+	    telemetry_conserve(3, q);
+	}
+
+    stop_t = halo_max_1D(stop_t);
     time_c += tau;
     if(isfinite(t_all))
-        DispPro(time_c*100.0/t_all, k);
+        telemetry_step(time_c*100.0/t_all, k, time_c, tau);
     else
-        DispPro(k*100.0/N, k);
+        telemetry_step(k*100.0/N, k, time_c, tau);
+    file_1D_publish(ctx, m, k, CV, nt, X[nt], time_c);
     if(stop_t || time_c > (t_all - eps) || !isfinite(time_c))
 	break;
 
 //===========================Fixed variable location=======================
 
-    toc = clock();
-    cpu_time_sum += ((double)toc - (double)tic) / (double)CLOCKS_PER_SEC;
+    toc = wall_time();
+    cpu_time_sum += toc - tic;
     cpu_time[nt]  = cpu_time_sum;
+    if(n_ckpt > 0 && k % n_ckpt == 0)
+	{
+	    PHASE_TIC(PT_IO);
+	    checkpoint_write(&ckpt);
+	    PHASE_TOC(PT_IO);
+	}
   }
 
   printf("\nTime is up at time step %d.\n", k);
-  printf("The cost of CPU time for 1D-GRP Lagrangian scheme for this problem is %g seconds.\n", cpu_time_sum);
+  printf("The cost of wall-clock time for 1D-GRP Lagrangian scheme for this problem is %g seconds.\n", cpu_time_sum);
+  if(quiet && n_face)
+      printf("The GRP is solved at %g%% of the interfaces, the others are in quiescent regions.\n", 100.0*n_solve/n_face);
 //---------------------END OF THE MAIN LOOP----------------------
 
 return_NULL:
-  config[5] = (double)k;
-  *N_plot = nt+1;
+  ctx->conf[5] = (double)k;
+  *N_plot = nt_plot+1;
   if(isfinite(time_c))
-      time_plot[nt] = time_c;
+      time_plot[nt_plot] = time_c;
   else if(isfinite(t_all))
-      time_plot[nt] = t_all;
+      time_plot[nt_plot] = t_all;
   else if(isfinite(tau))
-      time_plot[nt] = k*tau;
-
-  free(s_u);
-  free(s_p);
-  free(s_rho);
-  s_u   = NULL;
-  s_p   = NULL;
-  s_rho = NULL;
-  free(U_next);
-  free(P_next);
-  free(RHO_next_L);
-  free(RHO_next_R);
-  U_next     = NULL;
-  P_next     = NULL;
-  RHO_next_L = NULL;
-  RHO_next_R = NULL;
-  free(U_t);
-  free(P_t);
-  free(RHO_t_L);
-  free(RHO_t_R);
-  U_t     = NULL;
-  P_t     = NULL;
-  RHO_t_L = NULL;
-  RHO_t_R = NULL;
-  free(U_F);
-  free(P_F);
-  U_F = NULL;
-  P_F = NULL;
-  free(MASS);
-  MASS = NULL;
+      time_plot[nt_plot] = k*tau;
+
+  Arena_free(ws); // the scratch arrays are released together
+  s_u = s_p = s_rho = NULL;
+  U_next = P_next = RHO_next_L = RHO_next_R = NULL;
+  U_t = P_t = RHO_t_L = RHO_t_R = NULL;
+  U_F = P_F = MASS = R_MASS = NULL;
+  if_err = NULL;
+  checkpoint_free(&ckpt);
 }
@@ -11,6 +11,7 @@
 #include <stdbool.h>
 
 #include "../include_cii/mem.h"
+#include "../include_cii/arena.h"
 #include "../include/var_struc.h"
 #include "../include/tools.h"
 #include "../include/file_io.h"
@@ -18,6 +19,53 @@
 #include "../include/riemann_solver.h"
 #include "../include/inter_process.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+/**
+ * @brief This function moves a cell boundary of the cylindrical grid in a time step.
+ * @param[in]  Rb:    Radius of the boundary at t_n.
+ * @param[in]  Lb:    Length of the boundary at t_n.
+ * @param[in]  u:     Velocity of the boundary at t_{n+1/2}.
+ * @param[in]  dt:    The length of the time step.
+ * @param[in]  tan_h: tan(0.5*dtheta).
+ * @param[out] Rb_n:  Radius of the boundary at t_{n+1}.
+ * @param[out] Lb_n:  Length of the boundary at t_{n+1}.
+ * @param[out] Rb_h:  Length-weighted radius of the boundary in the time step.
+ * @param[out] Lb_h:  Length of the boundary at t_{n+1/2}.
+ */
+static inline void radial_bound_move(const double Rb, const double Lb, const double u, const double dt, const double tan_h,
+				     double * Rb_n, double * Lb_n, double * Rb_h, double * Lb_h)
+{
+    *Rb_n = Rb + u*dt;
+    *Lb_n = 2.0 * *Rb_n * tan_h;
+    *Lb_h = 0.5 * (Lb + *Lb_n);
+    *Rb_h = (Rb*(2.*Lb+*Lb_n)+*Rb_n*(Lb+2.* *Lb_n))/(3.*(Lb+*Lb_n));
+}
+
+//! The centroidal radius of the trapezoid cell between the boundaries (Rb_L, Lb_L) and (Rb_R, Lb_R).
+static inline double radial_centroid(const double Rb_L, const double Lb_L, const double Rb_R, const double Lb_R)
+{
+    return Rb_R-(2.*Lb_L+Lb_R)/(3.*(Lb_L+Lb_R))*(Rb_R-Rb_L);
+}
+
+
+//! This function appends the in-situ diagnostics of the solution in the time level 'nt' of CV.
+static inline void radial_diag_write(FILE ** diag, const struct cell_var_stru CV, const int nt, const double * mass,
+				     const struct radial_mesh_var * rmv, const char * problem, const int k, const double time_c)
+{
+    struct flu_var FV = {NULL};
+    FV.RHO   = CV.RHO[nt];
+    FV.U     = CV.U[nt];
+    FV.P     = CV.P[nt];
+#ifdef MULTIFLUID_BASICS
+    FV.gamma = CV.gamma[0];
+#endif
+    file_radial_write_diag(diag, FV, CV.E[nt], mass, rmv, problem, k, time_c);
+}
+
 
 /**
  * @brief This function use GRP scheme to solve radially(cylindrically) symmetric compressible flows of motion on Lagrangian coordinate.
@@ -40,9 +88,9 @@
 void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_var * rmv, double * R[], const int M,
 				  double * cpu_time, const char * problem, int N_T, int * N_plot , double time_plot[])
 {
-    int i, k=0;
+    int i, ib, k=0;
 
-    clock_t tic, toc;
+    double tic, toc, tic_r;
     double cpu_time_sum = 0.0;
 
     //parameters
@@ -54,19 +102,24 @@ void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_va
     int    const Ncell   = (int)config[3];  // Number of computing cells in r direction
     int    const Md      = Ncell+2;         // max vector dimension
     double       dt      = config[16];      // the length of the time step
+    int    const n_diag  = (int)config[56]; // the number of time steps between the in-situ diagnostics
+    double const rezone  = config[90];      // fraction of the mean cell width below which the cells are rezoned
 
-    double U_T,V_T;
-    double Rb_NStep,Lb_NStep;
+    double const tan_h   = tan(0.5*dtheta);
     //double Rb_side[Md],Lb_side[Md],Rbh_side[Md],Lbh_side[Md],Sh[Md];
 
-    double wave_speed[2], dire[4], mid[4];
-
     double Smax_dr;
     double time_c = 0.0;
     _Bool stop_t = false;
+    int data_err;
     int nt = 0, nt_plot = 0;
+    FILE * diag = NULL; // time series file of the in-situ diagnostics
+    int n_rez_step = 0, n_rez_move = 0, n_move; // the time steps with rezoning and the cell boundaries moved
+    double rez_time = 0.0; // wall-clock time of the rezoning
 
-    struct i_f_var ifv_L = {0}, ifv_R = {0};
+    // the scratch arrays carved from the workspace of the thread, which is kept for the next runs
+    Arena_T ws = Arena_workspace();
+    ARENA_RESERVE(ws, 18*Md * (long)sizeof(double) + 18*ARENA_ALIGN);
 
     // initial value
     double *DD = CV.RHO[0]; // D:Density;U,V:Velocity;P:Pressure
@@ -78,7 +131,7 @@ void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_va
     GammaGamma[0] = GammaGamma[1];
     GammaGamma[Ncell+1] = GammaGamma[Ncell];
 #else
-    double *GammaGamma = (double*)ALLOC(Md*sizeof(double)); // Ratio of special heats
+    double *GammaGamma = (double*)ARENA_ALLOC(ws, Md*sizeof(double)); // Ratio of special heats
     for(i = 0; i < Md; i++) //center cell is cell 0
 	GammaGamma[i] = config[6];
 #endif
@@ -88,21 +141,21 @@ void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_va
     EE[0] = PP[0]/(GammaGamma[0] - 1.0)/DD[0];
 
     // the slopes of variable values
-    double *TmV = (double*)CALLOC(Md, sizeof(double));
-    double *DmU = (double*)CALLOC(Md, sizeof(double));
-    double *DmD = (double*)CALLOC(Md, sizeof(double));
-    double *DmP = (double*)CALLOC(Md, sizeof(double));
+    double *TmV = (double*)ARENA_CALLOC(ws, Md, sizeof(double));
+    double *DmU = (double*)ARENA_CALLOC(ws, Md, sizeof(double));
+    double *DmD = (double*)ARENA_CALLOC(ws, Md, sizeof(double));
+    double *DmP = (double*)ARENA_CALLOC(ws, Md, sizeof(double));
 
     //GRP variables
-    double *VLmin = (double*)ALLOC(Md*sizeof(double));
-    double *Umin  = (double*)ALLOC(Md*sizeof(double));
-    double *Pmin  = (double*)ALLOC(Md*sizeof(double));
-    double *DLmin = (double*)ALLOC(Md*sizeof(double));
-    double *DRmin = (double*)ALLOC(Md*sizeof(double));
-    double *U_t   = (double*)ALLOC(Md*sizeof(double));
-    double *P_t   = (double*)ALLOC(Md*sizeof(double));
-    double *DL_t  = (double*)ALLOC(Md*sizeof(double));
-    double *DR_t  = (double*)ALLOC(Md*sizeof(double));
+    double *Umin  = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
+    double *Pmin  = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
+    double *DLmin = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
+    double *DRmin = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
+    double *U_t   = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
+    double *P_t   = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
+    double *DL_t  = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
+    double *DR_t  = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
+    int    *if_err = (int*)ARENA_ALLOC(ws, Md*sizeof(int)); // the miscalculation indicators at the interfaces
 
     double *Rb   = rmv->Rb;  //radius and length of outer cell boundary
     double *Lb   = rmv->Lb;
@@ -112,20 +165,20 @@ void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_va
     double *Ddr  = rmv->Ddr;
     double *dRc  = rmv->dRc; //(derivative)centers distance
     double *vol  = rmv->vol;
-    double *Rbh  = (double*)ALLOC(Md*sizeof(double)); //h: half time step
-    double *Lbh  = (double*)ALLOC(Md*sizeof(double));
 
     //flux, conservative variable and wave speed
-    double *F_e  = (double*)ALLOC(Md*sizeof(double));
-    double *F_u  = (double*)ALLOC(Md*sizeof(double));
-    double *F_u2 = (double*)ALLOC(Md*sizeof(double));
-    double *mass = (double*)ALLOC(Md*sizeof(double));
+    double *U_F  = (double*)ARENA_ALLOC(ws, Md*sizeof(double)); // velocity and pressure on the boundaries at t_{n+1/2}
+    double *F_u  = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
+    double *F_u2 = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
+    double *mass = (double*)ARENA_ALLOC(ws, Md*sizeof(double));
     for(i = 0; i <= Ncell; i++) //center cell is cell 0
 	mass[i] = DD[i] * vol[i];
+    if (n_diag > 0)
+	radial_diag_write(&diag, CV, nt, mass, rmv, problem, 0, time_c);
 
     for(k = 1; k <= N; k++)
 	{
-	    tic = clock();
+	    tic = wall_time();
 
 	    if (time_c >= time_plot[nt_plot] && nt_plot < (*N_plot-1))
 		{
@@ -137,7 +190,9 @@ void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_va
 #ifdef MULTIFLUID_BASICS
 		    FV.gamma = CV.gamma[0];
 #endif
+		    PHASE_TIC(PT_IO);
 		    file_radial_write_TEC(FV, RR, problem, time_plot[nt_plot]);
+		    PHASE_TOC(PT_IO);
 #endif
 		    nt_plot++;
 		    if (nt < (N_T-1))
@@ -160,9 +215,11 @@ void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_va
 
 	    Smax_dr = 0.0; // S_max/dr = 0.0
 
+	    PHASE_TIC(PT_SLOPE);
 	    VIP_limiter_radial   (Ncell, (_Bool)(k-1), DmU, TmV, UU, rmv);
 	    minmod_limiter_radial(Ncell, (_Bool)(k-1), DmD,      DD, rmv);
 	    minmod_limiter_radial(Ncell, (_Bool)(k-1), DmP,      PP, rmv);
+	    PHASE_TOC(PT_SLOPE);
 
 	    UU[Ncell+1]  = UU[Ncell];
 	    DD[Ncell+1]  = DD[Ncell];
@@ -177,49 +234,89 @@ void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_va
 	    DmD[Ncell+1] = 0.0;
 	    DmP[Ncell+1] = 0.0;
 
-	    for(i = 0; i <= Ncell; i++)
+	    PHASE_TIC(PT_SOLVE);
+	    data_err = 0;
+#pragma omp parallel for private(i) reduction(max:Smax_dr) reduction(|:data_err)
+	    for(ib = 0; ib <= Ncell; ib += GRP_BATCH_SIZE)
 		{
-		    ifv_L.gamma = GammaGamma[i];
-		    ifv_R.gamma = GammaGamma[i+1];
-		    ifv_L.d_rho = DmD[i];
-		    ifv_R.d_rho = DmD[i+1];
-		    ifv_L.d_p   = DmP[i];
-		    ifv_R.d_p   = DmP[i+1];
-		    ifv_L.d_u   = DmU[i];
-		    ifv_R.d_u   = DmU[i+1];
-		    ifv_L.RHO   = DD[i]   + DdrL[i]  *ifv_L.d_rho;
-		    ifv_R.RHO   = DD[i+1] - DdrR[i+1]*ifv_R.d_rho;
-		    ifv_L.P     = PP[i]   + DdrL[i]  *ifv_L.d_p;
-		    ifv_R.P     = PP[i+1] - DdrR[i+1]*ifv_R.d_p;
-		    ifv_L.U     = UU[i]   + DdrL[i]  *ifv_L.d_u;
-		    ifv_R.U     = UU[i+1] - DdrR[i+1]*ifv_R.d_u;
-		    if(ifvar_check(&ifv_L, &ifv_R, 1))
+		    const int nb = Ncell+1-ib < GRP_BATCH_SIZE ? Ncell+1-ib : GRP_BATCH_SIZE;
+		    int l, b_err = 0;
+		    struct i_f_var ifv_L = {0}, ifv_R = {0};
+		    double mid[4], dire[4];
+		    // the states on both sides of the interfaces in this block
+		    double RHO_L[GRP_BATCH_SIZE], U_L[GRP_BATCH_SIZE], P_L[GRP_BATCH_SIZE], d_rho_L[GRP_BATCH_SIZE], d_u_L[GRP_BATCH_SIZE], d_p_L[GRP_BATCH_SIZE];
+		    double RHO_R[GRP_BATCH_SIZE], U_R[GRP_BATCH_SIZE], P_R[GRP_BATCH_SIZE], d_rho_R[GRP_BATCH_SIZE], d_u_R[GRP_BATCH_SIZE], d_p_R[GRP_BATCH_SIZE];
+		    struct i_f_var_batch bv_L = {RHO_L, U_L, P_L, d_rho_L, d_u_L, d_p_L, GammaGamma+ib};
+		    struct i_f_var_batch bv_R = {RHO_R, U_R, P_R, d_rho_R, d_u_R, d_p_R, GammaGamma+ib+1};
+		    // the GRP solutions at the interfaces in this block
+		    double ws_a[2][GRP_BATCH_SIZE], D_a[4][GRP_BATCH_SIZE], U_a[4][GRP_BATCH_SIZE];
+		    double * const ws_b[2] = {ws_a[0], ws_a[1]};
+		    double * const D_b[4]  = {D_a[0], D_a[1], D_a[2], D_a[3]};
+		    double * const U_b[4]  = {U_a[0], U_a[1], U_a[2], U_a[3]};
+		    for(l = 0; l < nb; l++)
 			{
-			    printf(" on [%d, %d] (t_n, x).\n", k, i);
-			    goto return_NULL;
+			    i = ib + l;
+			    ifv_L.gamma = GammaGamma[i];
+			    ifv_R.gamma = GammaGamma[i+1];
+			    ifv_L.d_rho = d_rho_L[l] = DmD[i];
+			    ifv_R.d_rho = d_rho_R[l] = DmD[i+1];
+			    ifv_L.d_p   = d_p_L[l]   = DmP[i];
+			    ifv_R.d_p   = d_p_R[l]   = DmP[i+1];
+			    ifv_L.d_u   = d_u_L[l]   = DmU[i];
+			    ifv_R.d_u   = d_u_R[l]   = DmU[i+1];
+			    ifv_L.RHO   = RHO_L[l]   = DD[i]   + DdrL[i]  *ifv_L.d_rho;
+			    ifv_R.RHO   = RHO_R[l]   = DD[i+1] - DdrR[i+1]*ifv_R.d_rho;
+			    ifv_L.P     = P_L[l]     = PP[i]   + DdrL[i]  *ifv_L.d_p;
+			    ifv_R.P     = P_R[l]     = PP[i+1] - DdrR[i+1]*ifv_R.d_p;
+			    ifv_L.U     = U_L[l]     = UU[i]   + DdrL[i]  *ifv_L.d_u;
+			    ifv_R.U     = U_R[l]     = UU[i+1] - DdrR[i+1]*ifv_R.d_u;
+			    if((if_err[i] = ifvar_check_code(&run_ctx_global, &ifv_L, &ifv_R, 1)))
+				b_err = 1;
+			}
+		    if(b_err) // The block is not solved and the step is given up.
+			{
+			    data_err = 1;
+			    continue;
 			}
 
-		    GRPsolverRLag(wave_speed, dire, mid, &ifv_L, &ifv_R, Rb[i+1], M, eps, eps);
+		    GRPsolverRLag_batch(nb, ws_b, D_b, U_b, &bv_L, &bv_R, Rb+ib+1, M, eps, eps);
 
-		    if(star_dire_check(mid, dire, 1))
+		    for(l = 0; l < nb; l++)
 			{
-			    printf(" on [%d, %d] (t_n, x).\n", k, i);
-			    stop_t = true;
+			    i = ib + l;
+			    Umin[i+1]  = mid[1]  = U_a[1][l];
+			    Pmin[i+1]  = mid[2]  = U_a[2][l];
+			    DLmin[i+1] = mid[0]  = U_a[0][l];
+			    DRmin[i+1] = mid[3]  = U_a[3][l];
+			    U_t[i+1]   = dire[1] = D_a[1][l];
+			    P_t[i+1]   = dire[2] = D_a[2][l];
+			    DL_t[i+1]  = dire[0] = D_a[0][l];
+			    DR_t[i+1]  = dire[3] = D_a[3][l];
+			    if((if_err[i] = -star_dire_check_code(&run_ctx_global, mid, dire, 1)))
+				data_err = 1;
+
+			    Smax_dr = Smax_dr > fabs(ws_a[0][l])/Ddr[i]   ? Smax_dr : fabs(ws_a[0][l])/Ddr[i];
+			    Smax_dr = Smax_dr > fabs(ws_a[1][l])/Ddr[i+1] ? Smax_dr : fabs(ws_a[1][l])/Ddr[i+1];
 			}
-
-		    Smax_dr = Smax_dr > fabs(wave_speed[0])/Ddr[i]   ? Smax_dr : fabs(wave_speed[0])/Ddr[i];
-		    Smax_dr = Smax_dr > fabs(wave_speed[1])/Ddr[i+1] ? Smax_dr : fabs(wave_speed[1])/Ddr[i+1];
-
-		    Umin[i+1]  = mid[1];
-		    Pmin[i+1]  = mid[2];
-		    DLmin[i+1] = mid[0];
-		    DRmin[i+1] = mid[3];
-		    U_t[i+1]   = dire[1];
-		    P_t[i+1]   = dire[2];
-		    DL_t[i+1]  = dire[0];
-		    DR_t[i+1]  = dire[3];
 		}
-
+	    if(data_err) // Report the miscalculation in order of the interfaces.
+		for(i = 0; i <= Ncell; i++)
+		    {
+			if(if_err[i] > 0)
+			    {
+				printf("%s on [%d, %d] (t_n, x).\n", ifvar_check_msg(if_err[i], 1), k, i);
+				PHASE_TOC(PT_SOLVE);
+				goto return_NULL;
+			    }
+			else if(if_err[i] < 0)
+			    {
+				printf("%s on [%d, %d] (t_n, x).\n", star_dire_check_msg(-if_err[i]), k, i);
+				stop_t = true;
+			    }
+		    }
+	    PHASE_TOC(PT_SOLVE);
+
+	    PHASE_TIC(PT_CFL);
 	    if(isfinite(Timeout) || !isfinite(config[16]) || config[16] <= 0.0) //compute for time step
 		{
 		    dt = CFL/Smax_dr;
@@ -233,106 +330,222 @@ void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_va
 		    else if(!isfinite(dt))
 			{
 			    printf("NAN or INFinite error on [%d, %g, %g] (t_n, time_c, dt) - CFL\n", k, time_c, dt); 
+			    PHASE_TOC(PT_CFL);
 			    goto return_NULL;
 			}
 		}
-
-	    for(i = 1; i <= Ncell; i++)
+	    PHASE_TOC(PT_CFL);
+
+	    PHASE_TIC(PT_FLUX);
+	    /* The tangential states keep the density slope of the outermost interface and the pressure
+	     * slope of the previous cell, which the serial loop used to carry over from one cell to the next.
+	     */
+#pragma omp parallel for private(i)
+	    for(ib = 1; ib <= Ncell; ib += GRP_BATCH_SIZE)
 		{
-		    ifv_L.gamma = GammaGamma[i];
-		    ifv_L.RHO   = DD[i]+(0.5*(Rb[i]+Rb[i+1])-RR[i])*ifv_L.d_rho;
-		    ifv_L.P     = PP[i]+(0.5*(Rb[i]+Rb[i+1])-RR[i])*ifv_L.d_p;
-		    U_T         = UU[i]+(0.5*(Rb[i]+Rb[i+1])-RR[i])*DmU[i];
-		    V_T         = 0.5*(Rb[i]+Rb[i+1])*tan(0.5*dtheta)*TmV[i];
-		    ifv_L.U     = -U_T*sin(0.5*dtheta)+V_T*cos(0.5*dtheta);
-		    ifv_R       =  ifv_L;
-		    ifv_R.U     = -ifv_L.U;
-		    ifv_L.d_p   = DmP[i]*cos(0.5*dtheta);
-		    ifv_L.d_u   = DmU[i]+TmV[i];
-
-		    AcousticRLagTangent(dire, mid, &ifv_L, &ifv_R, 0.5*(Rb[i]+Rb[i+1])/cos(0.5*dtheta), M, eps);
-		    F_u2[i]  = mid[2]+dt*dire[2];
-		    VLmin[i] = (ifv_L.U*cos(0.5*dtheta)+ifv_L.V*sin(0.5*dtheta)+dt*dire[1])*sin(0.5*dtheta);
+		    const int nb = Ncell+1-ib < GRP_BATCH_SIZE ? Ncell+1-ib : GRP_BATCH_SIZE;
+		    int l;
+		    double U_T, V_T, r_c, d_p_c;
+		    double RHO_L[GRP_BATCH_SIZE], U_L[GRP_BATCH_SIZE], P_L[GRP_BATCH_SIZE], d_u_L[GRP_BATCH_SIZE], d_p_L[GRP_BATCH_SIZE];
+		    double U_R[GRP_BATCH_SIZE], r_T[GRP_BATCH_SIZE];
+		    struct i_f_var_batch bv_L = {RHO_L, U_L, P_L, NULL, d_u_L, d_p_L, GammaGamma+ib};
+		    struct i_f_var_batch bv_R = {RHO_L, U_R, P_L, NULL, NULL,  NULL,  GammaGamma+ib};
+		    double D_a[2][GRP_BATCH_SIZE], U_a[2][GRP_BATCH_SIZE];
+		    double * const D_b[2] = {D_a[0], D_a[1]};
+		    double * const U_b[2] = {U_a[0], U_a[1]};
+		    for(l = 0; l < nb; l++)
+			{
+			    i = ib + l;
+			    r_c      = 0.5*(Rb[i]+Rb[i+1]);
+			    d_p_c    = i == 1 ? DmP[Ncell] : DmP[i-1]*cos(0.5*dtheta);
+			    RHO_L[l] = DD[i]+(r_c-RR[i])*DmD[Ncell];
+			    P_L[l]   = PP[i]+(r_c-RR[i])*d_p_c;
+			    U_T      = UU[i]+(r_c-RR[i])*DmU[i];
+			    V_T      = r_c*tan(0.5*dtheta)*TmV[i];
+			    U_L[l]   = -U_T*sin(0.5*dtheta)+V_T*cos(0.5*dtheta);
+			    U_R[l]   = -U_L[l];
+			    d_p_L[l] = DmP[i]*cos(0.5*dtheta);
+			    d_u_L[l] = DmU[i]+TmV[i];
+			    r_T[l]   = r_c/cos(0.5*dtheta);
+			}
+
+		    AcousticRLagTangent_batch(nb, D_b, U_b, &bv_L, &bv_R, r_T, M, eps);
+
+		    for(l = 0; l < nb; l++)
+			F_u2[ib+l] = U_a[1][l]+dt*D_a[1][l];
 		}
 
+#pragma omp parallel for
 	    for(i = 0; i <= Ncell; i++)
 		{
 		    Umin[i+1] += 0.5 * dt * U_t[i+1];
 		    Pmin[i+1] += 0.5 * dt * P_t[i+1];
 
 		    F_u[i+1] = Pmin[i+1];
-		    F_e[i+1] = Pmin[i+1] * Umin[i+1];
-
-		    Rb_NStep = Rb[i+1] + Umin[i+1]*dt;
-		    Lb_NStep = 2.0 * Rb_NStep * tan(0.5*dtheta);
-		    Lbh[i+1] = 0.5 * (Lb[i+1] + Lb_NStep);
-		    Rbh[i+1] = (Rb[i+1]*(2.*Lb[i+1]+Lb_NStep)+Rb_NStep*(Lb[i+1]+2.*Lb_NStep))/(3.*(Lb[i+1]+Lb_NStep));
-		    Rb[i+1]  = Rb_NStep;
-		    Lb[i+1]  = Lb_NStep;
-		    RR[i]    = Rb[i+1]-(2.*Lb[i]+Lb[i+1])/(3.*(Lb[i]+Lb[i+1]))*(Rb[i+1]-Rb[i]);
-		    /*
-		      Rb_side[i] =0.25*(Lb[i]+Lb[i+1])  /sin(0.5*dtheta);
-		      Lb_side[i] =0.5 *(Lb[i+1]-Lb[i])  /sin(0.5*dtheta);
-		      Rbh_side[i]=0.25*(Lbh[i]+Lbh[i+1])/sin(0.5*dtheta);
-		      Lbh_side[i]=0.5 *(Lbh[i+1]-Lbh[i])/sin(0.5*dtheta);
-		      Sh[i]=Rbh[i+1]*Lbh[i+1]-Rbh[i]*Lbh[i]-sin(dtheta)*Rbh_side[i]*Lbh_side[i];
-		    */
+		    U_F[i+1] = Umin[i+1];
 
 		    Umin[i+1]  += dt *  U_t[i+1] * 0.5;
 		    Pmin[i+1]  += dt *  P_t[i+1] * 0.5;
 		    DLmin[i+1] += dt * DL_t[i+1];
 		    DRmin[i+1] += dt * DR_t[i+1];
 		}
-
-	    radial_mesh_update(rmv);
-
-	    DD[0] = mass[0]/vol[0];
-	    UU[0] = 0.0;
-	    EE[0] = EE[0] - dt/mass[0]*(F_e[1]*Rbh[1]*Lbh[1]);
-	    for(i = 1; i <= Ncell; i++) //m=2
-		{
-		    DD[i] = mass[i]/vol[i];
-		    UU[i] = UU[i] - dt/mass[i]*((F_u[i+1]-F_u2[i])*Rbh[i+1]*Lbh[i+1]-(F_u[i]-F_u2[i])*Rbh[i]*Lbh[i]);
-		    EE[i] = EE[i] - dt/mass[i]*( F_e[i+1]         *Rbh[i+1]*Lbh[i+1]- F_e[i]         *Rbh[i]*Lbh[i]);
-		}
-	    for(i = 0; i <= Ncell; i++) //m=2
-		{
-		    PP[i] = (EE[i] - 0.5*UU[i]*UU[i]) * (GammaGamma[i]-1.0) * DD[i];
+	    PHASE_TOC(PT_FLUX);
+
+	    /* The mesh moves in the same pass as the cells are updated. Each thread updates a range
+	     * of cells and moves their right boundaries in place, so the old left boundary of its
+	     * first cell is read before any thread moves it. The boundaries at t_{n+1/2} are not stored.
+	     */
+	    PHASE_TIC(PT_UPDATE);
+	    data_err = 0;
+#pragma omp parallel private(i) reduction(|:data_err)
+	    {
+#ifdef _OPENMP
+		const int id = omp_get_thread_num(), n_th = omp_get_num_threads();
+#else
+		const int id = 0, n_th = 1;
+#endif
+		const int i0 = (Ncell+1)*id/n_th, i1 = (Ncell+1)*(id+1)/n_th; // cells [i0, i1) of this thread
+		double Rb_Ln, Lb_Ln, Rb_Lh = 0.0, Lb_Lh = 0.0, RR_L; // left boundary at t_{n+1}, t_{n+1/2}; centroid of the left cell
+		double Rb_Rn, Lb_Rn, Rb_Rh, Lb_Rh;                   // right boundary at t_{n+1}, t_{n+1/2}
+		double Rb_Ll, Lb_Ll, tmp;
+		/*
+		  double Rb_side, Lb_side, Rbh_side, Lbh_side, Sh;
+		*/
+		if(i0 == 0 || i0 >= i1) // the center does not move
+		    {
+			Rb_Ln = Rb[0];
+			Lb_Ln = Lb[0];
+			RR_L  = 0.0; // dRc[0] is the distance from the center
+		    }
+		else
+		    {
+			radial_bound_move(Rb[i0], Lb[i0], U_F[i0], dt, tan_h, &Rb_Ln, &Lb_Ln, &Rb_Lh, &Lb_Lh);
+			if(i0 > 1)
+			    radial_bound_move(Rb[i0-1], Lb[i0-1], U_F[i0-1], dt, tan_h, &Rb_Ll, &Lb_Ll, &tmp, &tmp);
+			else
+			    {
+				Rb_Ll = Rb[0];
+				Lb_Ll = Lb[0];
+			    }
+			RR_L = radial_centroid(Rb_Ll, Lb_Ll, Rb_Ln, Lb_Ln);
+		    }
+#pragma omp barrier
+		for(i = i0; i < i1; i++) //m=2
+		    {
+			radial_bound_move(Rb[i+1], Lb[i+1], U_F[i+1], dt, tan_h, &Rb_Rn, &Lb_Rn, &Rb_Rh, &Lb_Rh);
+			Rb[i+1] = Rb_Rn;
+			Lb[i+1] = Lb_Rn;
+			/*
+			  Rb_side =0.25*(Lb_Ln+Lb_Rn)/sin(0.5*dtheta);
+			  Lb_side =0.5 *(Lb_Rn-Lb_Ln)/sin(0.5*dtheta);
+			  Rbh_side=0.25*(Lb_Lh+Lb_Rh)/sin(0.5*dtheta);
+			  Lbh_side=0.5 *(Lb_Rh-Lb_Lh)/sin(0.5*dtheta);
+			  Sh=Rb_Rh*Lb_Rh-Rb_Lh*Lb_Lh-sin(dtheta)*Rbh_side*Lbh_side;
+			*/
+
+			RR[i]   = radial_centroid(Rb_Ln, Lb_Ln, Rb_Rn, Lb_Rn);
+			dRc[i]  = RR[i]-RR_L;
+			DdrL[i] = Rb_Rn-RR[i]; // Right side length of cell i
+			DdrR[i] = RR[i]-Rb_Ln; // Left  side length of cell i
+			Ddr[i]  = DdrL[i]+DdrR[i];
+			if(Ddr[i] < 0.0)
+			    data_err |= 2;
+			vol[i]  = RR[i]*0.5*(Lb_Ln+Lb_Rn)*Ddr[i];
+
+			DD[i] = mass[i]/vol[i];
+			if(i == 0)
+			    {
+				UU[0] = 0.0;
+				EE[0] = EE[0] - dt/mass[0]*(F_u[1]*U_F[1]*Rb_Rh*Lb_Rh);
+			    }
+			else
+			    {
+				UU[i] = UU[i] - dt/mass[i]*((F_u[i+1]-F_u2[i])*Rb_Rh*Lb_Rh-(F_u[i]-F_u2[i])*Rb_Lh*Lb_Lh);
+				EE[i] = EE[i] - dt/mass[i]*( F_u[i+1]*U_F[i+1]*Rb_Rh*Lb_Rh- F_u[i]*U_F[i]*Rb_Lh*Lb_Lh);
+				DmU[i]=(Umin[i+1] -Umin[i]) /Ddr[i];
+				DmP[i]=(Pmin[i+1] -Pmin[i]) /Ddr[i];
+				DmD[i]=(DLmin[i+1]-DRmin[i])/Ddr[i];
+			    }
+			PP[i] = (EE[i] - 0.5*UU[i]*UU[i]) * (GammaGamma[i]-1.0) * DD[i];
+			if (PP[i] < eps)
+			    data_err |= 1;
+
+			Rb_Ln = Rb_Rn;
+			Lb_Ln = Lb_Rn;
+			Rb_Lh = Rb_Rh;
+			Lb_Lh = Lb_Rh;
+			RR_L  = RR[i];
+		    }
+	    }
+	    if(data_err & 2)
+		for(i = 0; i <= Ncell; i++)
+		    if(Ddr[i] < 0.0)
+			{
+			    fprintf(stderr, "ERROR! deltar_r < 0 in cell %d.\n", i);
+			    exit(3);
+			}
+	    if(data_err & 1)
+		for(i = 0; i <= Ncell; i++)
 		    if (PP[i] < eps)
 			{
 			    printf("p<0.0 error on [%d, %d] (t_n, x) - Update\n", k, i);
 			    stop_t = true;
 			}
-		}
+	    dRc[Ncell+1]  = RR[Ncell+1]-RR[Ncell]; // boundary condition
+	    DdrR[Ncell+1] = RR[Ncell+1]-Rb[Ncell+1];
+	    Ddr[Ncell+1]  = Ddr[Ncell];
 
-	    for(i = 1; i <= Ncell; i++)
-		{
-		    DmU[i]=(Umin[i+1] -Umin[i]) /Ddr[i];
-		    DmP[i]=(Pmin[i+1] -Pmin[i]) /Ddr[i];
-		    DmD[i]=(DLmin[i+1]-DRmin[i])/Ddr[i];
-		}
 	    DmU[0]      =(Umin[1]-UU[0]) /dRc[0];
 	    DmP[0]      =(Pmin[1]-PP[0]) /dRc[0];
 	    DmD[0]      =(DLmin[1]-DD[0])/dRc[0];
 	    DmU[Ncell+1]=(Umin[Ncell+1] -UU[Ncell])/dRc[Ncell];
 	    DmP[Ncell+1]=(Pmin[Ncell+1] -PP[Ncell])/dRc[Ncell];
 	    DmD[Ncell+1]=(DLmin[Ncell+1]-DD[Ncell])/dRc[Ncell];
+	    PHASE_TOC(PT_UPDATE);
+
+	    if(rezone > 0.0 && !stop_t)
+		{
+		    tic_r = wall_time();
+		    n_move = radial_mesh_rezone(rmv, rezone, mass, DD, UU, PP, EE, GammaGamma, DmD, DmU, DmP);
+		    rez_time += wall_time() - tic_r;
+		    if(n_move)
+			{
+			    n_rez_step++;
+			    n_rez_move += n_move;
+			}
+		}
 
 	    time_c=time_c+dt;
 	    if(isfinite(Timeout))
-		DispPro(time_c*100.0/Timeout, k);
+		telemetry_step(time_c*100.0/Timeout, k, time_c, dt);
 	    else
-		DispPro(k*100.0/N, k);
+		telemetry_step(k*100.0/N, k, time_c, dt);
+	    if(live_publish_due())
+		{ // the cells 1, …, Ncell with their centroidal radii
+		    static const char * const name[] = {"RHO", "U", "P", "E", "R"};
+		    double * D1 = DD + 1, * U1 = UU + 1, * P1 = PP + 1, * E1 = EE + 1, * R1 = RR + 1;
+		    double * const * const v[] = {&D1, &U1, &P1, &E1, &R1};
+		    live_publish_frame(k, time_c, 5, name, v, 1, Ncell);
+		}
+	    if(n_diag > 0 && (k % n_diag == 0 || stop_t || time_c > (Timeout - eps) || k == N))
+		{
+		    PHASE_TIC(PT_IO);
+		    radial_diag_write(&diag, CV, nt, mass, rmv, problem, k, time_c);
+		    PHASE_TOC(PT_IO);
+		}
 	    if(stop_t || time_c > (Timeout - eps) || !isfinite(time_c))
 		break;
 
-	    toc = clock();
-	    cpu_time_sum += ((double)toc - (double)tic) / (double)CLOCKS_PER_SEC;
+	    toc = wall_time();
+	    cpu_time_sum += toc - tic;
 	    cpu_time[nt]  = cpu_time_sum;
 	}
 
     printf("\nTime is up at time step %d.\n", k);
-    printf("The cost of CPU time for 1D-GRP Eulerian scheme for this problem is %g seconds.\n", cpu_time_sum);
+    printf("The cost of wall-clock time for 1D-GRP Eulerian scheme for this problem is %g seconds.\n", cpu_time_sum);
+    if(rezone > 0.0)
+	printf("Radial rezoning: %d of %d time steps (%g%%), %d cell boundaries moved, %g seconds.\n",
+	       n_rez_step, k, k ? 100.0*n_rez_step/k : 0.0, n_rez_move, rez_time);
 
  return_NULL:
     config[5] = (double)k;
@@ -344,25 +557,12 @@ void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_va
     else if(isfinite(dt))
 	time_plot[nt] = k*dt;
 
+    if (diag)
+	fclose(diag);
     DD = NULL;
     UU = NULL;
     PP = NULL;
     EE = NULL;
     GammaGamma = NULL;
-    FREE(DmD);
-    FREE(DmU);
-    FREE(TmV);
-    FREE(DmP);
-    FREE(Umin);
-    FREE(VLmin);
-    FREE(Pmin);
-    FREE(DLmin);
-    FREE(DRmin);
-    FREE(U_t);
-    FREE(P_t);
-    FREE(DL_t);
-    FREE(DR_t);
-    free(F_u);
-    free(F_e);
-    FREE(mass);
+    Arena_free(ws); // the scratch arrays are released together
 }
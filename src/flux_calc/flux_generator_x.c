@@ -5,16 +5,149 @@
  */
 #include <stdio.h>
 #include <math.h>
+#include <limits.h>
 
 #include "../include/var_struc.h"
 #include "../include/inter_process.h"
+#include "../include/riemann_solver.h"
 #include "../include/flux_calc.h"
+#include "../include/tools.h"
 
 
+/**
+ * @brief This function calculates the fluxes at the x-interface (j, i) between the cells (j-1, i) and (j, i) by 2-D GRP solver.
+ * @details It is the body of the sweeps of flux_generator_x() and flux_generator_x_tile().
+ * @param[in] ifv_L, ifv_R: Variables on both sides of the interface, the normal direction and gamma of which have been set.
+ * @param[out] flux_err: Miscalculation indicator of the GRP solver (0: successful calculation).
+ * @return    Miscalculation indicator of the left/right states by ifvar_check_code().
+ */
+ACC_ROUTINE_SEQ
+static int flux_x_face(const struct run_ctx * ctx, const int m, const int nt, const double tau, struct cell_var_stru * CV,
+		       const struct b_f_var * bfv_L, const struct b_f_var * bfv_R, const _Bool Transversal, const _Bool single,
+		       const struct gamma_const * gc, const struct gamma_const * gt,
+		       struct i_f_var * ifv_L, struct i_f_var * ifv_R, const int j, const int i, int * flux_err)
+{
+  double const h_x = ctx->conf[10]; // the length of the initial x spatial grids
+  int data_err;
+
+  if(j)
+  {
+      ifv_L->d_rho = CV->s_rho[j-1][i];
+      ifv_L->d_u   =   CV->s_u[j-1][i];
+      ifv_L->d_v   =   CV->s_v[j-1][i];
+      ifv_L->d_p   =   CV->s_p[j-1][i];
+      ifv_L->RHO  = CV[nt].RHO[j-1][i] + 0.5*h_x*CV->s_rho[j-1][i];
+      ifv_L->U    =   CV[nt].U[j-1][i] + 0.5*h_x*  CV->s_u[j-1][i];
+      ifv_L->V    =   CV[nt].V[j-1][i] + 0.5*h_x*  CV->s_v[j-1][i];
+      ifv_L->P    =   CV[nt].P[j-1][i] + 0.5*h_x*  CV->s_p[j-1][i];
+  }
+  else
+  {
+      ifv_L->d_rho = bfv_L[i].SRHO;
+      ifv_L->d_u   = bfv_L[i].SU;
+      ifv_L->d_v   = bfv_L[i].SV;
+      ifv_L->d_p   = bfv_L[i].SP;
+      ifv_L->RHO   = bfv_L[i].RHO + 0.5*h_x*bfv_L[i].SRHO;
+      ifv_L->U     = bfv_L[i].U   + 0.5*h_x*bfv_L[i].SU;
+      ifv_L->V     = bfv_L[i].V   + 0.5*h_x*bfv_L[i].SV;
+      ifv_L->P     = bfv_L[i].P   + 0.5*h_x*bfv_L[i].SP;
+  }
+  if(j < m)
+  {
+      ifv_R->d_rho = CV->s_rho[j][i];
+      ifv_R->d_u   =   CV->s_u[j][i];
+      ifv_R->d_v   =   CV->s_v[j][i];
+      ifv_R->d_p   =   CV->s_p[j][i];
+      ifv_R->RHO  = CV[nt].RHO[j][i] - 0.5*h_x*CV->s_rho[j][i];
+      ifv_R->U    =   CV[nt].U[j][i] - 0.5*h_x*  CV->s_u[j][i];
+      ifv_R->V    =   CV[nt].V[j][i] - 0.5*h_x*  CV->s_v[j][i];
+      ifv_R->P    =   CV[nt].P[j][i] - 0.5*h_x*  CV->s_p[j][i];
+  }
+  else
+  {
+      ifv_R->d_rho = bfv_R[i].SRHO;
+      ifv_R->d_u   = bfv_R[i].SU;
+      ifv_R->d_v   = bfv_R[i].SV;
+      ifv_R->d_p   = bfv_R[i].SP;
+      ifv_R->RHO   = bfv_R[i].RHO - 0.5*h_x*bfv_R[i].SRHO;
+      ifv_R->U     = bfv_R[i].U   - 0.5*h_x*bfv_R[i].SU;
+      ifv_R->V     = bfv_R[i].V   - 0.5*h_x*bfv_R[i].SV;
+      ifv_R->P     = bfv_R[i].P   - 0.5*h_x*bfv_R[i].SP;
+  }
+
+//===========================
+  if (Transversal)
+      {
+	  if(j)
+	      {
+		  ifv_L->t_rho = CV->t_rho[j-1][i];
+		  ifv_L->t_u   =   CV->t_u[j-1][i];
+		  ifv_L->t_v   =   CV->t_v[j-1][i];
+		  ifv_L->t_p   =   CV->t_p[j-1][i];
+	      }
+	  else
+	      {
+		  ifv_L->t_rho = bfv_L[i].TRHO;
+		  ifv_L->t_u   = bfv_L[i].TU;
+		  ifv_L->t_v   = bfv_L[i].TV;
+		  ifv_L->t_p   = bfv_L[i].TP;
+	      }
+	  if(j < m)
+	      {
+		  ifv_R->t_rho = CV->t_rho[j][i];
+		  ifv_R->t_u   =   CV->t_u[j][i];
+		  ifv_R->t_v   =   CV->t_v[j][i];
+		  ifv_R->t_p   =   CV->t_p[j][i];
+	      }
+	  else
+	      {
+		  ifv_R->t_rho = bfv_R[i].TRHO;
+		  ifv_R->t_u   = bfv_R[i].TU;
+		  ifv_R->t_v   = bfv_R[i].TV;
+		  ifv_R->t_p   = bfv_R[i].TP;
+	      }
+      }
+  else
+      {
+	  ifv_L->t_rho = 0.0;
+	  ifv_L->t_u   = 0.0;
+	  ifv_L->t_v   = 0.0;
+	  ifv_L->t_p   = 0.0;
+	  ifv_R->t_rho = 0.0;
+	  ifv_R->t_u   = 0.0;
+	  ifv_R->t_v   = 0.0;
+	  ifv_R->t_p   = 0.0;
+      }
+  data_err = ifvar_check_code(ctx, ifv_L, ifv_R, 2);
+
+//===========================
+
+  if (single)
+      *flux_err = GRP_2D_flux_gc(ctx, gc, ifv_L, ifv_R, tau);
+  else
+      *flux_err = GRP_2D_flux_gt(ctx, gt, ifv_L, ifv_R, tau);
+
+  CV->F_rho[j][i] = ifv_L->F_rho;
+  CV->F_u[j][i]   = ifv_L->F_u;
+  CV->F_v[j][i]   = ifv_L->F_v;
+  CV->F_e[j][i]   = ifv_L->F_e;
+
+  CV->rhoIx[j][i] = ifv_L->RHO_int;
+  CV->uIx[j][i]   = ifv_L->U_int;
+  CV->vIx[j][i]   = ifv_L->V_int;
+  CV->pIx[j][i]   = ifv_L->P_int;
+  return data_err;
+}
+
 /**
  * @brief This function calculate Eulerian fluxes of 2-D Euler equations in x-direction by 2-D GRP solver.
  * @details Passes variable values on both sides of the interface to the structure variables b_f_var bfv_L and bfv_R,
  *          and use function GRP_2D_scheme() to calculate fluxes.
+ *          The miscalculations are recorded by each thread without any message,
+ *          and the first one in order of the interfaces is reported after the sweep by flux_err_report().
+ *          With MPI_2D, the interfaces on the edges of the block are swept after the exchange of the halo slopes,
+ *          which overlaps the sweep of the interior interfaces.
+ * @param[in] ctx:    Pointer to the run context.
  * @param[in] m:      Number of the x-grids: n_x.
  * @param[in] n:      Number of the y-grids: n_y.
  * @param[in] nt:     Current plot time step for computing updates of conservative variables.
@@ -28,138 +161,123 @@
  *   @retval  1: Calculation error of left/right states.
  *   @retval  2: Calculation error of interfacial fluxes.
  */
-int flux_generator_x(const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
+int flux_generator_x(const struct run_ctx * ctx, const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
 		      struct b_f_var * bfv_L, struct b_f_var * bfv_R, const _Bool Transversal)
 {
-  double const h_x = config[10]; // the length of the initial x spatial grids
-  struct i_f_var ifv_L = {.n_x = 1.0, .n_y = 0.0, .gamma = config[6]};
+  struct i_f_var ifv_L = {.n_x = 1.0, .n_y = 0.0, .gamma = ctx->conf[6]};
   struct i_f_var ifv_R = ifv_L;
-  int i, j, data_err, data_err_retval = 0;
+  int i, j, data_err, flux_err;
+  struct flux_err_rec fe = {0}; // the first miscalculation of the sweep
+  int i_t, j_t; // the first cells of a tile
+#ifdef _OPENACC
+  int const b_y = 1, b_x = 1; // one interface in a tile, the device threads run over the interfaces.
+  long e_key = LONG_MAX; // the smallest key of the miscalculations
+  int  e_num = 0, e_kind = 0;
+#else
+  int const b_y = MAX((int)ctx->conf[49], 1); // the tile lengths along y and x
+  int const b_x = MAX((int)ctx->conf[50], 1);
+#endif
+  _Bool const single = (int)ctx->conf[2] <= 1; // single-fluid flow with the constant gamma
+  struct gamma_const gc, gt[2]; // the constants of the perfect gas, and of the two components
+  gamma_const_set(&gc, ctx->conf[6]);
+  gt[0] = gc;
+  gamma_const_set(gt+1, ctx->conf[106]);
 
 //===========================
-#pragma omp parallel for firstprivate(ifv_L, ifv_R) collapse(2) schedule(dynamic, 8)
-  for(i = 0; i < n; ++i)
-    for(j = 0; j <= m; ++j)
+  // The interfaces are swept tile by tile, and along y (the contiguous index i) in a tile.
+#ifdef MPI_2D
+  int pass; // 0: the interfaces inside the block, 1: the interfaces on its edges after the exchange of the halo slopes.
+  for(pass = 0; pass < 2; ++pass)
+  {
+  if(pass)
+      halo_slope_finish_x(n, bfv_L, bfv_R);
+#endif
+#ifdef _OPENACC
+#pragma acc parallel loop collapse(2) firstprivate(ifv_L, ifv_R, gc, gt) private(i, j, data_err, flux_err) \
+  reduction(min:e_key) reduction(+:e_num) reduction(|:e_kind) default(present)
+#else
+#pragma omp parallel firstprivate(ifv_L, ifv_R) private(i, j, data_err, flux_err)
+  {
+  struct flux_err_rec fe_t = {0}; // the first miscalculation of the thread
+  PHASE_SPAN_BEGIN(t_span);
+#pragma omp for collapse(2) schedule(dynamic) nowait
+#endif
+  for(i_t = 0; i_t < n; i_t += b_y)
+    for(j_t = 0; j_t <= m; j_t += b_x)
+      for(j = j_t; j < MIN(j_t + b_x, m+1); ++j)
+	for(i = i_t; i < MIN(i_t + b_y, n); ++i)
     {
-      if(j)
-      {
-          ifv_L.d_rho = CV->s_rho[j-1][i];
-          ifv_L.d_u   =   CV->s_u[j-1][i];
-          ifv_L.d_v   =   CV->s_v[j-1][i];
-          ifv_L.d_p   =   CV->s_p[j-1][i];
-          ifv_L.RHO  = CV[nt].RHO[j-1][i] + 0.5*h_x*CV->s_rho[j-1][i];
-          ifv_L.U    =   CV[nt].U[j-1][i] + 0.5*h_x*  CV->s_u[j-1][i];
-          ifv_L.V    =   CV[nt].V[j-1][i] + 0.5*h_x*  CV->s_v[j-1][i];
-          ifv_L.P    =   CV[nt].P[j-1][i] + 0.5*h_x*  CV->s_p[j-1][i];
-      }
-      else
-      {
-          ifv_L.d_rho = bfv_L[i].SRHO;
-          ifv_L.d_u   = bfv_L[i].SU;
-          ifv_L.d_v   = bfv_L[i].SV;
-          ifv_L.d_p   = bfv_L[i].SP;
-          ifv_L.RHO   = bfv_L[i].RHO + 0.5*h_x*bfv_L[i].SRHO;
-          ifv_L.U     = bfv_L[i].U   + 0.5*h_x*bfv_L[i].SU;
-          ifv_L.V     = bfv_L[i].V   + 0.5*h_x*bfv_L[i].SV;
-          ifv_L.P     = bfv_L[i].P   + 0.5*h_x*bfv_L[i].SP;
-      }
-      if(j < m)
-      {
-          ifv_R.d_rho = CV->s_rho[j][i];
-          ifv_R.d_u   =   CV->s_u[j][i];
-          ifv_R.d_v   =   CV->s_v[j][i];
-          ifv_R.d_p   =   CV->s_p[j][i];
-          ifv_R.RHO  = CV[nt].RHO[j][i] - 0.5*h_x*CV->s_rho[j][i];
-          ifv_R.U    =   CV[nt].U[j][i] - 0.5*h_x*  CV->s_u[j][i];
-          ifv_R.V    =   CV[nt].V[j][i] - 0.5*h_x*  CV->s_v[j][i];
-          ifv_R.P    =   CV[nt].P[j][i] - 0.5*h_x*  CV->s_p[j][i];
-      }
-      else
-      {
-          ifv_R.d_rho = bfv_R[i].SRHO;
-          ifv_R.d_u   = bfv_R[i].SU;
-          ifv_R.d_v   = bfv_R[i].SV;
-          ifv_R.d_p   = bfv_R[i].SP;
-          ifv_R.RHO   = bfv_R[i].RHO - 0.5*h_x*bfv_R[i].SRHO;
-          ifv_R.U     = bfv_R[i].U   - 0.5*h_x*bfv_R[i].SU;
-          ifv_R.V     = bfv_R[i].V   - 0.5*h_x*bfv_R[i].SV;
-          ifv_R.P     = bfv_R[i].P   - 0.5*h_x*bfv_R[i].SP;
-      }
-
-//===========================
-      if (Transversal)
-	  {
-	      if(j)
-		  {
-		      ifv_L.t_rho = CV->t_rho[j-1][i];
-		      ifv_L.t_u   =   CV->t_u[j-1][i];
-		      ifv_L.t_v   =   CV->t_v[j-1][i];
-		      ifv_L.t_p   =   CV->t_p[j-1][i];
-		  }
-	      else
-		  {
-		      ifv_L.t_rho = bfv_L[i].TRHO;
-		      ifv_L.t_u   = bfv_L[i].TU;
-		      ifv_L.t_v   = bfv_L[i].TV;
-		      ifv_L.t_p   = bfv_L[i].TP;
-		  }
-	      if(j < m)
-		  {
-		      ifv_R.t_rho = CV->t_rho[j][i];
-		      ifv_R.t_u   =   CV->t_u[j][i];
-		      ifv_R.t_v   =   CV->t_v[j][i];
-		      ifv_R.t_p   =   CV->t_p[j][i];
-		  }
-	      else
-		  {
-		      ifv_R.t_rho = bfv_R[i].TRHO;
-		      ifv_R.t_u   = bfv_R[i].TU;
-		      ifv_R.t_v   = bfv_R[i].TV;
-		      ifv_R.t_p   = bfv_R[i].TP;
-		  }
-	  }
-      else
+#ifdef MPI_2D
+      if((j == 0 || j == m) != pass)
+	  continue;
+#endif
+      if((data_err = flux_x_face(ctx, m, nt, tau, CV, bfv_L, bfv_R, Transversal, single, &gc, gt, &ifv_L, &ifv_R, j, i, &flux_err)))
 	  {
-	      ifv_L.t_rho = 0.0;
-	      ifv_L.t_u   = 0.0;
-	      ifv_L.t_v   = 0.0;
-	      ifv_L.t_p   = 0.0;
-	      ifv_R.t_rho = 0.0;
-	      ifv_R.t_u   = 0.0;
-	      ifv_R.t_v   = 0.0;
-	      ifv_R.t_p   = 0.0;
-	  }
-      if(ifvar_check(&ifv_L, &ifv_R, 2))
-	  {
-	      printf(" on [%d, %d, %d] (nt, x, y).\n", nt, j, i);
-	      data_err_retval = 1;
+#ifdef _OPENACC
+	      e_key = MIN(e_key, FLUX_ERR_KEY(data_err, j, i, n));
+	      e_num++;
+	      e_kind |= 1;
+#else
+	      flux_err_add(&fe_t, data_err, j, i);
+#endif
 	  }
 
 //===========================
 
-      data_err = GRP_2D_flux(&ifv_L, &ifv_R, tau);
-      switch (data_err)
+      if(flux_err)
 	  {
-	  case 1:
-	      printf("<0.0 error on [%d, %d, %d] (nt, x, y) - STAR_x\n", nt, j, i);
-	      data_err_retval = 2;
-	  case 2:
-	      printf("NAN or INFinite error on [%d, %d, %d] (nt, x, y) - STA_x\n", nt, j, i); 
-	      data_err_retval = 2;
-	  case 3:
-	      printf("NAN or INFinite error on [%d, %d, %d] (nt, x, y) - DIRE_x\n", nt, j, i); 
-	      data_err_retval = 2;
+#ifdef _OPENACC
+	      e_key = MIN(e_key, FLUX_ERR_KEY(3 + flux_err, j, i, n));
+	      e_num++;
+	      e_kind |= 2;
+#else
+	      flux_err_add(&fe_t, 3 + flux_err, j, i);
+#endif
 	  }
+    }
+#ifdef _OPENACC
+  flux_err_key_set(&fe, e_key, e_num, e_kind, n);
+#else
+  PHASE_SPAN_END(TR_FLUX_X, t_span);
+#pragma omp critical
+  flux_err_merge(&fe, &fe_t);
+  } // End of parallel region
+#endif
+#ifdef MPI_2D
+  } // End of the passes
+#endif
+  return flux_err_report(&fe, nt, 'x');
+}
 
-      CV->F_rho[j][i] = ifv_L.F_rho;
-      CV->F_u[j][i]   = ifv_L.F_u;
-      CV->F_v[j][i]   = ifv_L.F_v;
-      CV->F_e[j][i]   = ifv_L.F_e;
+/**
+ * @brief This function calculate Eulerian fluxes of 2-D Euler equations at the x-interfaces j0 <= j < j1 of a tile of columns
+ *        by 2-D GRP solver in one thread.
+ * @details It is a task of the pipelined time steps of GRP_solver_2D_EUL_source(), in which the fluxes of the tile
+ *          are calculated as soon as the slopes of the cells j0-1 <= j < j1 have been limited.
+ *          The miscalculations are recorded without any message in 'fe', which is merged and reported by the caller.
+ * @param[in] j0, j1: The first and the last but one x-interfaces of the tile.
+ * @param[in,out] fe: The first miscalculation of the tile.
+ * @sa flux_generator_x() for the other parameters.
+ */
+void flux_generator_x_tile(const struct run_ctx * ctx, const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
+			   struct b_f_var * bfv_L, struct b_f_var * bfv_R, const _Bool Transversal,
+			   const int j0, const int j1, struct flux_err_rec * fe)
+{
+  struct i_f_var ifv_L = {.n_x = 1.0, .n_y = 0.0, .gamma = ctx->conf[6]};
+  struct i_f_var ifv_R = ifv_L;
+  int i, j, data_err, flux_err;
+  _Bool const single = (int)ctx->conf[2] <= 1; // single-fluid flow with the constant gamma
+  struct gamma_const gc, gt[2]; // the constants of the perfect gas, and of the two components
+  gamma_const_set(&gc, ctx->conf[6]);
+  gt[0] = gc;
+  gamma_const_set(gt+1, ctx->conf[106]);
 
-      CV->rhoIx[j][i] = ifv_L.RHO_int;
-      CV->uIx[j][i]   = ifv_L.U_int;
-      CV->vIx[j][i]   = ifv_L.V_int;
-      CV->pIx[j][i]   = ifv_L.P_int;
-    } // End of parallel region
-  return data_err_retval;
+  for(j = j0; j < j1; ++j)
+      for(i = 0; i < n; ++i)
+	  {
+	      if((data_err = flux_x_face(ctx, m, nt, tau, CV, bfv_L, bfv_R, Transversal, single, &gc, gt, &ifv_L, &ifv_R, j, i, &flux_err)))
+		  flux_err_add(fe, data_err, j, i);
+	      if(flux_err)
+		  flux_err_add(fe, 3 + flux_err, j, i);
+	  }
 }
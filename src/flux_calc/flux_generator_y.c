@@ -5,16 +5,149 @@
  */
 #include <stdio.h>
 #include <math.h>
+#include <limits.h>
 
 #include "../include/var_struc.h"
 #include "../include/inter_process.h"
+#include "../include/riemann_solver.h"
 #include "../include/flux_calc.h"
+#include "../include/tools.h"
 
 
+/**
+ * @brief This function calculates the fluxes at the y-interface (j, i) between the cells (j, i-1) and (j, i) by 2-D GRP solver.
+ * @details It is the body of the sweeps of flux_generator_y() and flux_generator_y_tile().
+ * @param[in] ifv_D, ifv_U: Variables on both sides of the interface, the normal direction and gamma of which have been set.
+ * @param[out] flux_err: Miscalculation indicator of the GRP solver (0: successful calculation).
+ * @return    Miscalculation indicator of the downside/upper states by ifvar_check_code().
+ */
+ACC_ROUTINE_SEQ
+static int flux_y_face(const struct run_ctx * ctx, const int n, const int nt, const double tau, struct cell_var_stru * CV,
+		       const struct b_f_var * bfv_D, const struct b_f_var * bfv_U, const _Bool Transversal, const _Bool single,
+		       const struct gamma_const * gc, const struct gamma_const * gt,
+		       struct i_f_var * ifv_D, struct i_f_var * ifv_U, const int j, const int i, int * flux_err)
+{
+  double const h_y = ctx->conf[11]; // the length of the initial y spatial grids
+  int data_err;
+
+  if(i)
+  {
+      ifv_D->d_rho = CV->t_rho[j][i-1];
+      ifv_D->d_u   =   CV->t_u[j][i-1];
+      ifv_D->d_v   =   CV->t_v[j][i-1];
+      ifv_D->d_p   =   CV->t_p[j][i-1];
+      ifv_D->RHO  = CV[nt].RHO[j][i-1] + 0.5*h_y*CV->t_rho[j][i-1];
+      ifv_D->U    =   CV[nt].U[j][i-1] + 0.5*h_y*  CV->t_u[j][i-1];
+      ifv_D->V    =   CV[nt].V[j][i-1] + 0.5*h_y*  CV->t_v[j][i-1];
+      ifv_D->P    =   CV[nt].P[j][i-1] + 0.5*h_y*  CV->t_p[j][i-1];
+  }
+  else
+  {
+      ifv_D->d_rho = bfv_D[j].TRHO;
+      ifv_D->d_u   = bfv_D[j].TU;
+      ifv_D->d_v   = bfv_D[j].TV;
+      ifv_D->d_p   = bfv_D[j].TP;
+      ifv_D->RHO   = bfv_D[j].RHO + 0.5*h_y*bfv_D[j].TRHO;
+      ifv_D->U     = bfv_D[j].U   + 0.5*h_y*bfv_D[j].TU;
+      ifv_D->V     = bfv_D[j].V   + 0.5*h_y*bfv_D[j].TV;
+      ifv_D->P     = bfv_D[j].P   + 0.5*h_y*bfv_D[j].TP;
+  }
+  if(i < n)
+  {
+      ifv_U->d_rho = CV->t_rho[j][i];
+      ifv_U->d_u   =   CV->t_u[j][i];
+      ifv_U->d_v   =   CV->t_v[j][i];
+      ifv_U->d_p   =   CV->t_p[j][i];
+      ifv_U->RHO  = CV[nt].RHO[j][i] - 0.5*h_y*CV->t_rho[j][i];
+      ifv_U->U    =   CV[nt].U[j][i] - 0.5*h_y*  CV->t_u[j][i];
+      ifv_U->V    =   CV[nt].V[j][i] - 0.5*h_y*  CV->t_v[j][i];
+      ifv_U->P    =   CV[nt].P[j][i] - 0.5*h_y*  CV->t_p[j][i];
+  }
+  else
+  {
+      ifv_U->d_rho = bfv_U[j].TRHO;
+      ifv_U->d_u   = bfv_U[j].TU;
+      ifv_U->d_v   = bfv_U[j].TV;
+      ifv_U->d_p   = bfv_U[j].TP;
+      ifv_U->RHO   = bfv_U[j].RHO - 0.5*h_y*bfv_U[j].TRHO;
+      ifv_U->U     = bfv_U[j].U   - 0.5*h_y*bfv_U[j].TU;
+      ifv_U->V     = bfv_U[j].V   - 0.5*h_y*bfv_U[j].TV;
+      ifv_U->P     = bfv_U[j].P   - 0.5*h_y*bfv_U[j].TP;
+  }
+
+//===========================
+  if (Transversal)
+      {
+	  if(i)
+	      {
+		  ifv_D->t_rho = -CV->s_rho[j][i-1];
+		  ifv_D->t_u   = -  CV->s_u[j][i-1];
+		  ifv_D->t_v   = -  CV->s_v[j][i-1];
+		  ifv_D->t_p   = -  CV->s_p[j][i-1];
+	      }
+	  else
+	      {
+		  ifv_D->t_rho = -bfv_D[j].SRHO;
+		  ifv_D->t_u   = -bfv_D[j].SU;
+		  ifv_D->t_v   = -bfv_D[j].SV;
+		  ifv_D->t_p   = -bfv_D[j].SP;
+	      }
+	  if(i < n)
+	      {
+		  ifv_U->t_rho = -CV->s_rho[j][i];
+		  ifv_U->t_u   = -  CV->s_u[j][i];
+		  ifv_U->t_v   = -  CV->s_v[j][i];
+		  ifv_U->t_p   = -  CV->s_p[j][i];
+	      }
+	  else
+	      {
+		  ifv_U->t_rho = -bfv_U[j].SRHO;
+		  ifv_U->t_u   = -bfv_U[j].SU;
+		  ifv_U->t_v   = -bfv_U[j].SV;
+		  ifv_U->t_p   = -bfv_U[j].SP;
+	      }
+      }
+  else
+      {
+	  ifv_D->t_rho = -0.0;
+	  ifv_D->t_u   = -0.0;
+	  ifv_D->t_v   = -0.0;
+	  ifv_D->t_p   = -0.0;
+	  ifv_U->t_rho = -0.0;
+	  ifv_U->t_u   = -0.0;
+	  ifv_U->t_v   = -0.0;
+	  ifv_U->t_p   = -0.0;
+      }
+  data_err = ifvar_check_code(ctx, ifv_D, ifv_U, 2);
+
+//===========================
+
+  if (single)
+      *flux_err = GRP_2D_flux_gc(ctx, gc, ifv_D, ifv_U, tau);
+  else
+      *flux_err = GRP_2D_flux_gt(ctx, gt, ifv_D, ifv_U, tau);
+
+  CV->G_rho[j][i] = ifv_D->F_rho;
+  CV->G_u[j][i]   = ifv_D->F_u;
+  CV->G_v[j][i]   = ifv_D->F_v;
+  CV->G_e[j][i]   = ifv_D->F_e;
+
+  CV->rhoIy[j][i] = ifv_D->RHO_int;
+  CV->uIy[j][i]   = ifv_D->U_int;
+  CV->vIy[j][i]   = ifv_D->V_int;
+  CV->pIy[j][i]   = ifv_D->P_int;
+  return data_err;
+}
+
 /**
  * @brief This function calculate Eulerian fluxes of 2-D Euler equations in y-direction by 2-D GRP solver.
  * @details Passes variable values on both sides of the interface to the structure variables b_f_var bfv_L and bfv_R,
  *          and use function GRP_2D_scheme() to calculate fluxes.
+ *          The miscalculations are recorded by each thread without any message,
+ *          and the first one in order of the interfaces is reported after the sweep by flux_err_report().
+ *          With MPI_2D, the interfaces on the edges of the block are swept after the exchange of the halo slopes,
+ *          which overlaps the sweep of the interior interfaces.
+ * @param[in] ctx:    Pointer to the run context.
  * @param[in] m:      Number of the x-grids: n_x.
  * @param[in] n:      Number of the y-grids: n_y.
  * @param[in] nt:     Current plot time step for computing updates of conservative variables.
@@ -28,138 +161,123 @@
  *   @retval  1: Calculation error of left/right states.
  *   @retval  2: Calculation error of interfacial fluxes.
  */
-int flux_generator_y(const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
+int flux_generator_y(const struct run_ctx * ctx, const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
 		      struct b_f_var * bfv_D, struct b_f_var * bfv_U, const _Bool Transversal)
 {
-  double const h_y = config[11]; // the length of the initial y spatial grids
-  struct i_f_var ifv_D = {.n_x = 0.0, .n_y = 1.0, .gamma = config[6]};
+  struct i_f_var ifv_D = {.n_x = 0.0, .n_y = 1.0, .gamma = ctx->conf[6]};
   struct i_f_var ifv_U = ifv_D;
-  int i, j, data_err, data_err_retval = 0;
+  int i, j, data_err, flux_err;
+  struct flux_err_rec fe = {0}; // the first miscalculation of the sweep
+  int i_t, j_t; // the first cells of a tile
+#ifdef _OPENACC
+  int const b_y = 1, b_x = 1; // one interface in a tile, the device threads run over the interfaces.
+  long e_key = LONG_MAX; // the smallest key of the miscalculations
+  int  e_num = 0, e_kind = 0;
+#else
+  int const b_y = MAX((int)ctx->conf[49], 1); // the tile lengths along y and x
+  int const b_x = MAX((int)ctx->conf[50], 1);
+#endif
+  _Bool const single = (int)ctx->conf[2] <= 1; // single-fluid flow with the constant gamma
+  struct gamma_const gc, gt[2]; // the constants of the perfect gas, and of the two components
+  gamma_const_set(&gc, ctx->conf[6]);
+  gt[0] = gc;
+  gamma_const_set(gt+1, ctx->conf[106]);
 
 //===========================
-#pragma omp parallel for firstprivate(ifv_U, ifv_D) collapse(2) schedule(dynamic, 8)
-  for(j = 0; j < m; ++j)
-    for(i = 0; i <= n; ++i)
+  // The interfaces are swept tile by tile, and along y (the contiguous index i) in a tile.
+#ifdef MPI_2D
+  int pass; // 0: the interfaces inside the block, 1: the interfaces on its edges after the exchange of the halo slopes.
+  for(pass = 0; pass < 2; ++pass)
+  {
+  if(pass)
+      halo_slope_finish_y(m, bfv_D, bfv_U);
+#endif
+#ifdef _OPENACC
+#pragma acc parallel loop collapse(2) firstprivate(ifv_U, ifv_D, gc, gt) private(i, j, data_err, flux_err) \
+  reduction(min:e_key) reduction(+:e_num) reduction(|:e_kind) default(present)
+#else
+#pragma omp parallel firstprivate(ifv_U, ifv_D) private(i, j, data_err, flux_err)
+  {
+  struct flux_err_rec fe_t = {0}; // the first miscalculation of the thread
+  PHASE_SPAN_BEGIN(t_span);
+#pragma omp for collapse(2) schedule(dynamic) nowait
+#endif
+  for(j_t = 0; j_t < m; j_t += b_x)
+    for(i_t = 0; i_t <= n; i_t += b_y)
+      for(j = j_t; j < MIN(j_t + b_x, m); ++j)
+	for(i = i_t; i < MIN(i_t + b_y, n+1); ++i)
     {
-      if(i)
-      {
-          ifv_D.d_rho = CV->t_rho[j][i-1];
-          ifv_D.d_u   =   CV->t_u[j][i-1];
-          ifv_D.d_v   =   CV->t_v[j][i-1];
-          ifv_D.d_p   =   CV->t_p[j][i-1];
-          ifv_D.RHO  = CV[nt].RHO[j][i-1] + 0.5*h_y*CV->t_rho[j][i-1];
-          ifv_D.U    =   CV[nt].U[j][i-1] + 0.5*h_y*  CV->t_u[j][i-1];
-          ifv_D.V    =   CV[nt].V[j][i-1] + 0.5*h_y*  CV->t_v[j][i-1];
-          ifv_D.P    =   CV[nt].P[j][i-1] + 0.5*h_y*  CV->t_p[j][i-1];
-      }
-      else
-      {
-          ifv_D.d_rho = bfv_D[j].TRHO;
-          ifv_D.d_u   = bfv_D[j].TU;
-          ifv_D.d_v   = bfv_D[j].TV;
-          ifv_D.d_p   = bfv_D[j].TP;
-          ifv_D.RHO   = bfv_D[j].RHO + 0.5*h_y*bfv_D[j].TRHO;
-          ifv_D.U     = bfv_D[j].U   + 0.5*h_y*bfv_D[j].TU;
-          ifv_D.V     = bfv_D[j].V   + 0.5*h_y*bfv_D[j].TV;
-          ifv_D.P     = bfv_D[j].P   + 0.5*h_y*bfv_D[j].TP;
-      }
-      if(i < n)
-      {
-          ifv_U.d_rho = CV->t_rho[j][i];
-          ifv_U.d_u   =   CV->t_u[j][i];
-          ifv_U.d_v   =   CV->t_v[j][i];
-          ifv_U.d_p   =   CV->t_p[j][i];
-          ifv_U.RHO  = CV[nt].RHO[j][i] - 0.5*h_y*CV->t_rho[j][i];
-          ifv_U.U    =   CV[nt].U[j][i] - 0.5*h_y*  CV->t_u[j][i];
-          ifv_U.V    =   CV[nt].V[j][i] - 0.5*h_y*  CV->t_v[j][i];
-          ifv_U.P    =   CV[nt].P[j][i] - 0.5*h_y*  CV->t_p[j][i];
-      }
-      else
-      {
-          ifv_U.d_rho = bfv_U[j].TRHO;
-          ifv_U.d_u   = bfv_U[j].TU;
-          ifv_U.d_v   = bfv_U[j].TV;
-          ifv_U.d_p   = bfv_U[j].TP;
-          ifv_U.RHO   = bfv_U[j].RHO - 0.5*h_y*bfv_U[j].TRHO;
-          ifv_U.U     = bfv_U[j].U   - 0.5*h_y*bfv_U[j].TU;
-          ifv_U.V     = bfv_U[j].V   - 0.5*h_y*bfv_U[j].TV;
-          ifv_U.P     = bfv_U[j].P   - 0.5*h_y*bfv_U[j].TP;
-      }
-
-//===========================
-      if (Transversal)
-	  {
-	      if(i)
-		  {
-		      ifv_D.t_rho = -CV->s_rho[j][i-1];
-		      ifv_D.t_u   = -  CV->s_u[j][i-1];
-		      ifv_D.t_v   = -  CV->s_v[j][i-1];
-		      ifv_D.t_p   = -  CV->s_p[j][i-1];
-		  }
-	      else
-		  {
-		      ifv_D.t_rho = -bfv_D[j].SRHO;
-		      ifv_D.t_u   = -bfv_D[j].SU;
-		      ifv_D.t_v   = -bfv_D[j].SV;
-		      ifv_D.t_p   = -bfv_D[j].SP;
-		  }
-	      if(i < n)
-		  {
-		      ifv_U.t_rho = -CV->s_rho[j][i];
-		      ifv_U.t_u   = -  CV->s_u[j][i];
-		      ifv_U.t_v   = -  CV->s_v[j][i];
-		      ifv_U.t_p   = -  CV->s_p[j][i];
-		  }
-	      else
-		  {
-		      ifv_U.t_rho = -bfv_U[j].SRHO;
-		      ifv_U.t_u   = -bfv_U[j].SU;
-		      ifv_U.t_v   = -bfv_U[j].SV;
-		      ifv_U.t_p   = -bfv_U[j].SP;
-		  }
-	  }
-      else
+#ifdef MPI_2D
+      if((i == 0 || i == n) != pass)
+	  continue;
+#endif
+      if((data_err = flux_y_face(ctx, n, nt, tau, CV, bfv_D, bfv_U, Transversal, single, &gc, gt, &ifv_D, &ifv_U, j, i, &flux_err)))
 	  {
-	      ifv_D.t_rho = -0.0;
-	      ifv_D.t_u   = -0.0;
-	      ifv_D.t_v   = -0.0;
-	      ifv_D.t_p   = -0.0;
-	      ifv_U.t_rho = -0.0;
-	      ifv_U.t_u   = -0.0;
-	      ifv_U.t_v   = -0.0;
-	      ifv_U.t_p   = -0.0;
-	  }
-      if(ifvar_check(&ifv_D, &ifv_U, 2))
-	  {
-	      printf(" on [%d, %d, %d] (nt, x, y).\n", nt, j, i);
-	      data_err_retval = 1;
+#ifdef _OPENACC
+	      e_key = MIN(e_key, FLUX_ERR_KEY(data_err, j, i, n));
+	      e_num++;
+	      e_kind |= 1;
+#else
+	      flux_err_add(&fe_t, data_err, j, i);
+#endif
 	  }
 
 //===========================
 
-      data_err = GRP_2D_flux(&ifv_D, &ifv_U, tau);
-      switch (data_err)
+      if(flux_err)
 	  {
-	  case 1:
-	      printf("<0.0 error on [%d, %d, %d] (nt, x, y) - STAR_y\n", nt, j, i);
-	      data_err_retval = 2;
-	  case 2:
-	      printf("NAN or INFinite error on [%d, %d, %d] (nt, x, y) - STAR_y\n", nt, j, i); 
-	      data_err_retval = 2;
-	  case 3:
-	      printf("NAN or INFinite error on [%d, %d, %d] (nt, x, y) - DIRE_y\n", nt, j, i); 
-	      data_err_retval = 2;
+#ifdef _OPENACC
+	      e_key = MIN(e_key, FLUX_ERR_KEY(3 + flux_err, j, i, n));
+	      e_num++;
+	      e_kind |= 2;
+#else
+	      flux_err_add(&fe_t, 3 + flux_err, j, i);
+#endif
 	  }
+    }
+#ifdef _OPENACC
+  flux_err_key_set(&fe, e_key, e_num, e_kind, n);
+#else
+  PHASE_SPAN_END(TR_FLUX_Y, t_span);
+#pragma omp critical
+  flux_err_merge(&fe, &fe_t);
+  } // End of parallel region
+#endif
+#ifdef MPI_2D
+  } // End of the passes
+#endif
+  return flux_err_report(&fe, nt, 'y');
+}
 
-      CV->G_rho[j][i] = ifv_D.F_rho;
-      CV->G_u[j][i]   = ifv_D.F_u;
-      CV->G_v[j][i]   = ifv_D.F_v;
-      CV->G_e[j][i]   = ifv_D.F_e;
+/**
+ * @brief This function calculate Eulerian fluxes of 2-D Euler equations at the y-interfaces of the columns j0 <= j < j1 of a tile
+ *        by 2-D GRP solver in one thread.
+ * @details It is a task of the pipelined time steps of GRP_solver_2D_EUL_source(), in which the fluxes of the tile
+ *          are calculated as soon as the slopes of its cells have been limited.
+ *          The miscalculations are recorded without any message in 'fe', which is merged and reported by the caller.
+ * @param[in] j0, j1: The first and the last but one columns of the tile.
+ * @param[in,out] fe: The first miscalculation of the tile.
+ * @sa flux_generator_y() for the other parameters.
+ */
+void flux_generator_y_tile(const struct run_ctx * ctx, const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
+			   struct b_f_var * bfv_D, struct b_f_var * bfv_U, const _Bool Transversal,
+			   const int j0, const int j1, struct flux_err_rec * fe)
+{
+  struct i_f_var ifv_D = {.n_x = 0.0, .n_y = 1.0, .gamma = ctx->conf[6]};
+  struct i_f_var ifv_U = ifv_D;
+  int i, j, data_err, flux_err;
+  _Bool const single = (int)ctx->conf[2] <= 1; // single-fluid flow with the constant gamma
+  struct gamma_const gc, gt[2]; // the constants of the perfect gas, and of the two components
+  gamma_const_set(&gc, ctx->conf[6]);
+  gt[0] = gc;
+  gamma_const_set(gt+1, ctx->conf[106]);
 
-      CV->rhoIy[j][i] = ifv_D.RHO_int;
-      CV->uIy[j][i]   = ifv_D.U_int;
-      CV->vIy[j][i]   = ifv_D.V_int;
-      CV->pIy[j][i]   = ifv_D.P_int;
-    } // End of parallel region
-  return data_err_retval;
+  for(j = j0; j < j1; ++j)
+      for(i = 0; i <= n; ++i)
+	  {
+	      if((data_err = flux_y_face(ctx, n, nt, tau, CV, bfv_D, bfv_U, Transversal, single, &gc, gt, &ifv_D, &ifv_U, j, i, &flux_err)))
+		  flux_err_add(fe, data_err, j, i);
+	      if(flux_err)
+		  flux_err_add(fe, 3 + flux_err, j, i);
+	  }
 }
@@ -5,66 +5,146 @@
  */
 #include <stdio.h>
 #include <math.h>
+#include <float.h>
+#include <string.h>
 
 #include "../include/var_struc.h"
 #include "../include/inter_process.h"
 #include "../include/riemann_solver.h"
+#include "../include/flux_calc.h"
+
+
+//! Numerical dissipation parameter of the entropy fix of Roe solver.
+#define ROE_DELTA 0.2
+
+//! The flux of 1-D Euler equations by Roe solver.
+static int Roe_1D_flux_kernel(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
+{
+	double F[4];
+	double lambda_max;
+	(void)ctx; (void)tau;
+	Roe_solver(F, &lambda_max, ifv, ifv_R, ROE_DELTA);
+	ifv->F_rho = F[0];
+	ifv->F_u   = F[1];
+	ifv->F_e   = F[2];
+	return 0;
+}
+
+//! The flux of 2-D Euler equations by Roe solver.
+ACC_ROUTINE_SEQ
+static int Roe_2D_flux_kernel(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
+{
+	double F[4];
+	double lambda_max;
+	(void)ctx; (void)tau;
+	Roe_2D_solver(F, &lambda_max, ifv, ifv_R, ROE_DELTA);
+	ifv->F_rho = F[0];
+	ifv->F_u   = F[1];
+	ifv->F_v   = F[2];
+	ifv->F_e   = F[3];
+	return 0;
+}
+
+//! The flux of 2-D Euler equations by HLL solver.
+ACC_ROUTINE_SEQ
+static int HLL_2D_flux_kernel(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
+{
+	double F[4];
+	double lambda_max;
+	(void)ctx; (void)tau;
+	HLL_2D_solver(F, &lambda_max, ifv, ifv_R);
+	ifv->F_rho = F[0];
+	ifv->F_u   = F[1];
+	ifv->F_v   = F[2];
+	ifv->F_e   = F[3];
+	return 0;
+}
+
+//! The flux of 2-D Euler equations by HLLC solver, with the two-component variables advected by the contact wave.
+ACC_ROUTINE_SEQ
+static int HLLC_2D_flux_kernel(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
+{
+	double F[4], mid[6];
+	double lambda_max;
+	(void)tau;
+	HLLC_2D_solver(F, &lambda_max, mid, ifv, ifv_R);
+	ifv->F_rho = F[0];
+	ifv->F_u   = F[1];
+	ifv->F_v   = F[2];
+	ifv->F_e   = F[3];
+
+#ifdef MULTIFLUID_BASICS
+	const double n_x = ifv->n_x, n_y = ifv->n_y;
+	const double rho_mid = mid[0], p_mid = mid[3], z_a_mid = mid[4], phi_mid = mid[5];
+	const double u_mid = mid[1]*n_x - mid[2]*n_y, v_mid = mid[1]*n_y + mid[2]*n_x;
+	ifv->F_phi = ifv->F_rho*phi_mid;
+	if ((_Bool)ctx->conf[60])
+		ifv->F_gamma = ifv->F_rho*(mid[1] >= 0.0 ? ifv->gamma : ifv_R->gamma);
+	ifv->F_e_a = z_a_mid/(ctx->conf[6]-1.0)*p_mid/rho_mid + 0.5*phi_mid*(u_mid*u_mid + v_mid*v_mid);
+	ifv->F_e_a = ifv->F_rho*ifv->F_e_a;
+
+	ifv->U_qt_add_c = ifv->F_rho*u_mid*phi_mid;
+	ifv->V_qt_add_c = ifv->F_rho*v_mid*phi_mid;
+	ifv->U_qt_star  = p_mid*n_x;
+	ifv->V_qt_star  = p_mid*n_y;
+	ifv->P_star     = p_mid/rho_mid*ifv->F_rho;
+#else
+	(void)ctx;
+#endif
+	return 0;
+}
+
+//! The fluxes of a block of interfaces of 2-D Euler equations by Roe solver.
+static void Roe_2D_flux_batch(const int n, double * const F[4], double * lambda_max,
+			      const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R)
+{
+	Roe_2D_solver_batch(n, F, lambda_max, ifv_L, ifv_R, ROE_DELTA);
+}
+
+//! The flux of Euler equations by exact Riemann solver.
+ACC_ROUTINE_SEQ
+static int Riemann_exact_flux_kernel(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
+{
+	(void)tau;
+	return Riemann_exact_flux(ctx, ifv, ifv_R);
+}
 
 
 /**
  * @brief This function calculate Eulerian fluxes of Euler equations by Roe solver.
+ * @param[in] ctx:     Pointer to the run context.
  * @param[in,out] ifv: Structure pointer of interfacial evaluated variables and fluxes and left state.
  * @param[in] ifv_R:   Structure pointer of interfacial right state.
  */
-void Roe_flux(struct i_f_var * ifv, struct i_f_var * ifv_R)
+void Roe_flux(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R)
 {
-	const int dim = (int)config[0];
-	const double delta = 0.2;
+	const int dim = (int)ctx->conf[0];
 
-	double F[4];
-	double lambda_max;
 	if (dim == 1)
-		{
-			Roe_solver(F, &lambda_max, ifv, ifv_R, delta);
-			ifv->F_rho = F[0];
-			ifv->F_u   = F[1];
-			ifv->F_e   = F[2];
-		}
+		Roe_1D_flux_kernel(ctx, ifv, ifv_R, 0.0);
 	else if (dim == 2)
-		{
-			Roe_2D_solver(F, &lambda_max, ifv, ifv_R, delta);
-			ifv->F_rho = F[0];
-			ifv->F_u   = F[1];
-			ifv->F_v   = F[2];
-			ifv->F_e   = F[3];
-		}
+		Roe_2D_flux_kernel(ctx, ifv, ifv_R, 0.0);
 }
 
 
 /**
  * @brief This function calculate Eulerian fluxes of 2-D Euler equations by HLL solver.
+ * @param[in] ctx:     Pointer to the run context.
  * @param[in,out] ifv: Structure pointer of interfacial evaluated variables and fluxes and left state.
  * @param[in] ifv_R:   Structure pointer of interfacial right state.
  */
-void HLL_flux(struct i_f_var * ifv, struct i_f_var * ifv_R)
+void HLL_flux(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R)
 {
-	const int dim = (int)config[0];
+	const int dim = (int)ctx->conf[0];
 
-	double F[4];
-	double lambda_max;
 	if (dim == 2)
-		{
-			HLL_2D_solver(F, &lambda_max, ifv, ifv_R);
-			ifv->F_rho = F[0];
-			ifv->F_u   = F[1];
-			ifv->F_v   = F[2];
-			ifv->F_e   = F[3];
-		}
+		HLL_2D_flux_kernel(ctx, ifv, ifv_R, 0.0);
 }
 
 
 /**
  * @brief This function calculate Eulerian fluxes of 2-D Euler equations by Riemann solver.
+ * @param[in] ctx:     Pointer to the run context.
  * @param[in,out] ifv: Structure pointer of interfacial evaluated variables and fluxes and left state.
  * @param[in] ifv_R:   Structure pointer of interfacial right state.
  * @return    miscalculation indicator.
@@ -72,10 +152,10 @@ void HLL_flux(struct i_f_var * ifv, struct i_f_var * ifv_R)
  *   @retval  1: < 0.0 error.
  *   @retval  2: NAN or INFinite error of mid[].
  */
-int Riemann_exact_flux(struct i_f_var * ifv, struct i_f_var * ifv_R)
+int Riemann_exact_flux(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R)
 {
-	const int dim = (int)config[0];
-	const double eps = config[4];
+	const int dim = (int)ctx->conf[0];
+	const double eps = ctx->conf[4];
 	const double n_x = ifv->n_x, n_y = ifv->n_y;
 	double gamma_mid = ifv->gamma;
 	ifv->lambda_u = 0.0;  ifv->lambda_v = 0.0;
@@ -97,8 +177,13 @@ int Riemann_exact_flux(struct i_f_var * ifv, struct i_f_var * ifv_R)
 
 	linear_GRP_solver_Edir_Q1D(wave_speed, dire, mid, star, ifv, ifv_R, eps, INFINITY);
 
-	if((retval = star_dire_check(mid, dire, 2)))
+#ifdef _OPENACC
+	if((retval = star_dire_check_code(ctx, mid, dire, 2))) // The message is given by the caller on the device.
 	    return retval;
+#else
+	if((retval = star_dire_check(ctx, mid, dire, 2)))
+	    return retval;
+#endif
 
 	double rho_mid = mid[0], p_mid = mid[3], u_mid = mid[1], v_mid = mid[2];
 #ifdef MULTIFLUID_BASICS
@@ -126,9 +211,9 @@ int Riemann_exact_flux(struct i_f_var * ifv, struct i_f_var * ifv_R)
 
 #ifdef MULTIFLUID_BASICS
 	ifv->F_phi = ifv->F_rho * phi_mid;
-	if ((_Bool)config[60])
+	if ((_Bool)ctx->conf[60])
 		ifv->F_gamma = ifv->F_rho*gamma_mid;
-	ifv->F_e_a  = z_a_mid/(config[6]-1.0)*p_mid/rho_mid + 0.5*phi_mid*u_mid*u_mid;
+	ifv->F_e_a  = z_a_mid/(ctx->conf[6]-1.0)*p_mid/rho_mid + 0.5*phi_mid*u_mid*u_mid;
 	if (dim >= 2)
 	    ifv->F_e_a += 0.5*phi_mid*v_mid*v_mid;
 	ifv->F_e_a  = ifv->F_rho*ifv->F_e_a;
@@ -144,8 +229,42 @@ int Riemann_exact_flux(struct i_f_var * ifv, struct i_f_var * ifv_R)
 }
 
 
+/**
+ * @brief This function is the sensor of the hybrid GRP flux (config[89]), which flags an interface near a shock
+ *        or a material interface by the relative jumps of the states on both sides.
+ * @details A smooth interface, whose relative jumps of the pressure and the density (and the jump of the volume
+ *          fraction of two-component flow) are all below tol, takes the acoustic path of the GRP solver: the
+ *          linearised Riemann solver and the acoustic approximation of the temporal derivatives, without the
+ *          iterations of the exact Riemann solver and the nonlinear GRP.
+ * @param[in] ifv:   Structure pointer of interfacial left state.
+ * @param[in] ifv_R: Structure pointer of interfacial right state.
+ * @param[in] tol:   Threshold of the relative jumps.
+ * @param[in] multi: Whether the volume fraction is read (two-component flow).
+ * @return    Whether the interface is flagged (given by the full GRP solver).
+ */
+ACC_ROUTINE_SEQ
+static inline _Bool GRP_hybrid_flag(const struct i_f_var * ifv, const struct i_f_var * ifv_R, const double tol, const _Bool multi)
+{
+	const double p_min   = fmin(ifv->P,   ifv_R->P);
+	const double rho_min = fmin(ifv->RHO, ifv_R->RHO);
+	_Bool flag = !(fabs(ifv_R->P - ifv->P) < tol*p_min && fabs(ifv_R->RHO - ifv->RHO) < tol*rho_min);
+#ifdef MULTIFLUID_BASICS
+	flag = flag || (multi && !(fabs(ifv_R->Z_a - ifv->Z_a) < tol));
+#else
+	(void)multi;
+#endif
+	return flag;
+}
+
 /**
  * @brief This function calculate Eulerian fluxes of 2-D Euler equations by 2-D GRP solver.
+ * @details It gives no message, which is given by star_dire_check_msg(), so that it is safe to be called in parallel regions.
+ *          The weak jumps below ctx->conf[62] take the acoustic path, and the star states are given by
+ *          the HLLC solver instead of the exact Riemann solver if ctx->conf[63] is true.
+ *          With ctx->conf[89] > 0 (hybrid flux), only the interfaces flagged by GRP_hybrid_flag() take the full GRP solver.
+ * @param[in] ctx:     Pointer to the run context.
+ * @param[in] gc:      Constants of the single-fluid perfect gas (NULL: two-component flow).
+ * @param[in] gt:      Constants of the two components of two-component flow (NULL: not given).
  * @param[in,out] ifv: Structure pointer of interfacial evaluated variables and fluxes and left state.
  * @param[in] ifv_R:   Structure pointer of interfacial right state.
  * @param[in] tau:     The length of the time step.
@@ -155,11 +274,16 @@ int Riemann_exact_flux(struct i_f_var * ifv, struct i_f_var * ifv_R)
  *   @retval  2: NAN or INFinite error of mid[].
  *   @retval  3: NAN or INFinite error of dire[].
  */
-int GRP_2D_flux(struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
+ACC_ROUTINE_SEQ
+static inline int GRP_2D_flux_core(const struct run_ctx * ctx, const struct gamma_const * gc, const struct gamma_const * gt,
+				   struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
 {
-	const double eps = config[4];
+	const double eps = ctx->conf[4];
+	const double hyb = ctx->conf[89]; // the smooth interfaces of the hybrid flux take the acoustic path
+	double atc = ctx->conf[62]; // the weak jumps below it take the acoustic path
+	const _Bool hllc = (_Bool)ctx->conf[63]; // the star states given by the HLLC solver
 	const double n_x = ifv->n_x, n_y = ifv->n_y;
-	double gamma_mid = ifv->gamma;
+	double gamma_mid = gc ? gc->gamma : ifv->gamma;
 	ifv->lambda_u = 0.0;  ifv->lambda_v = 0.0;
 
 	int retval;
@@ -186,13 +310,25 @@ int GRP_2D_flux(struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
 
 	double wave_speed[2], dire[6], mid[6], star[6];
 
+	if (hyb > 0.0)
+		{
+			const _Bool flag = GRP_hybrid_flag(ifv, ifv_R, hyb, !gc);
+			GRP_hybrid_count(flag);
+			// The weak jumps keep their path, and the other smooth interfaces take the acoustic path.
+			const double d_rho = ifv->RHO - ifv_R->RHO, d_u = ifv->U - ifv_R->U, d_p = ifv->P - ifv_R->P;
+			if (!flag && !(d_rho*d_rho + d_u*d_u + d_p*d_p < atc*atc))
+				atc = DBL_MAX;
+		}
 	// linear_GRP_solver_Edir_G2D(wave_speed, dire, mid, star, ifv, ifv_R, eps, eps);
 	// linear_GRP_solver_Edir_G2D(wave_speed, dire, mid, star, ifv, ifv_R, eps, INFINITY);
-	linear_GRP_solver_Edir_Q1D(wave_speed, dire, mid, star, ifv, ifv_R, eps, eps);
+	if (gc)
+		linear_GRP_solver_Edir_Q1D_gc(wave_speed, dire, mid, star, ifv, ifv_R, gc, eps, atc, hllc);
+	else
+		linear_GRP_solver_Edir_Q1D_gt(wave_speed, dire, mid, star, ifv, ifv_R, gt, eps, atc, hllc);
 	// linear_GRP_solver_Edir_Q1D(wave_speed, dire, mid, star, ifv, ifv_R, eps, -0.0);
 	// linear_GRP_solver_Edir_Q1D(wave_speed, dire, mid, star, ifv, ifv_R, eps, INFINITY);
 
-	if((retval = star_dire_check(mid, dire, 2)))
+	if((retval = star_dire_check_code(ctx, mid, dire, 2)))
 	    return retval;
 
 	double rho_mid, p_mid, u_mid, v_mid;
@@ -204,13 +340,14 @@ int GRP_2D_flux(struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
 	double phi_mid, z_a_mid;
 	phi_mid =  mid[5] + 0.5*tau*dire[5];
 	z_a_mid =  mid[4] + 0.5*tau*dire[4];
-	gamma_mid = 1.0/(z_a_mid/(config[6]-1.0)+(1.0-z_a_mid)/(config[106]-1.0))+1.0;
+	if (!gc)
+		gamma_mid = 1.0/(z_a_mid/(ctx->conf[6]-1.0)+(1.0-z_a_mid)/(ctx->conf[106]-1.0))+1.0;
 #endif
 
 	ifv->F_rho = rho_mid*(u_mid*n_x + v_mid*n_y);
 	ifv->F_u   = ifv->F_rho*u_mid + p_mid*n_x;
 	ifv->F_v   = ifv->F_rho*v_mid + p_mid*n_y;
-	ifv->F_e   = (gamma_mid/(gamma_mid-1.0))*p_mid/rho_mid + 0.5*(u_mid*u_mid + v_mid*v_mid);
+	ifv->F_e   = (gc ? gc->e_p : gamma_mid/(gamma_mid-1.0))*p_mid/rho_mid + 0.5*(u_mid*u_mid + v_mid*v_mid);
 	ifv->F_e   = ifv->F_rho*ifv->F_e;
 
 	ifv->U_int   = (mid[1] + tau*dire[1])*n_x - (mid[2] + tau*dire[2])*n_y;
@@ -219,10 +356,12 @@ int GRP_2D_flux(struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
 	ifv->P_int   =  mid[3] + tau*dire[3];
 
 #ifdef MULTIFLUID_BASICS
+	if (gc) // The multi-fluid fluxes are not computed in single-fluid flow.
+		return retval;
 	ifv->F_phi = ifv->F_rho*phi_mid;
-	if ((_Bool)config[60])
+	if ((_Bool)ctx->conf[60])
 		ifv->F_gamma = ifv->F_rho*gamma_mid;
-	ifv->F_e_a = z_a_mid/(config[6]-1.0)*p_mid/rho_mid + 0.5*phi_mid*(u_mid*u_mid + v_mid*v_mid);
+	ifv->F_e_a = z_a_mid/(ctx->conf[6]-1.0)*p_mid/rho_mid + 0.5*phi_mid*(u_mid*u_mid + v_mid*v_mid);
 	ifv->F_e_a = ifv->F_rho*ifv->F_e_a;	
 	ifv->PHI = mid[5] + tau*dire[5];
 	ifv->Z_a = mid[4] + tau*dire[4];
@@ -235,3 +374,220 @@ int GRP_2D_flux(struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
 #endif
 	return retval;
 }
+
+/**
+ * @brief This function calculate Eulerian fluxes of 2-D Euler equations by 2-D GRP solver.
+ * @details See GRP_2D_flux_core() for the parameters and the return values.
+ */
+int GRP_2D_flux(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
+{
+	return GRP_2D_flux_core(ctx, NULL, NULL, ifv, ifv_R, tau);
+}
+
+/**
+ * @brief This function calculate Eulerian fluxes of 2-D Euler equations of single-fluid flow with a constant gamma by 2-D GRP solver.
+ * @details The multi-fluid variables and fluxes of ifv and ifv_R are neither read nor written.
+ *          See GRP_2D_flux_core() for the other parameters and the return values.
+ * @param[in] gc: Constants of the perfect gas set by gamma_const_set().
+ */
+int GRP_2D_flux_gc(const struct run_ctx * ctx, const struct gamma_const * gc, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
+{
+	return GRP_2D_flux_core(ctx, gc, NULL, ifv, ifv_R, tau);
+}
+
+/**
+ * @brief This function calculate Eulerian fluxes of 2-D Euler equations of two-component flow by 2-D GRP solver
+ *        with the constants of the two components.
+ * @details See GRP_2D_flux_core() for the other parameters and the return values.
+ * @param[in] gt: Constants of the two components (ctx->conf[6] and ctx->conf[106]) set by gamma_const_set().
+ */
+int GRP_2D_flux_gt(const struct run_ctx * ctx, const struct gamma_const * gt, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
+{
+	return GRP_2D_flux_core(ctx, NULL, gt, ifv, ifv_R, tau);
+}
+
+
+/**
+ * @brief This function records a miscalculation at an interface, if it is the first one in order of the interfaces.
+ * @param[in,out] e: Pointer to the record of the first miscalculation.
+ * @param[in]   err: Miscalculation indicator (1-3: states, 4-6: fluxes).
+ * @param[in]     j: x-index of the interface.
+ * @param[in]     i: y-index of the interface.
+ */
+void flux_err_add(struct flux_err_rec * e, const int err, const int j, const int i)
+{
+	if (!e->num || j < e->j || (j == e->j && i < e->i))
+		{
+			e->err = err;
+			e->j   = j;
+			e->i   = i;
+		}
+	e->num++;
+	e->kind |= err > 3 ? 2 : 1;
+}
+
+/**
+ * @brief This function merges the record of the first miscalculation of a thread.
+ * @param[in,out] e: Pointer to the record of the first miscalculation of the sweep.
+ * @param[in]   e_t: Pointer to the record of the first miscalculation of the thread.
+ */
+void flux_err_merge(struct flux_err_rec * e, const struct flux_err_rec * e_t)
+{
+	if (!e_t->num)
+		return;
+	if (!e->num || e_t->j < e->j || (e_t->j == e->j && e_t->i < e->i))
+		{
+			e->err = e_t->err;
+			e->j   = e_t->j;
+			e->i   = e_t->i;
+		}
+	e->num  += e_t->num;
+	e->kind |= e_t->kind;
+}
+
+/**
+ * @brief This function sets the record of the first miscalculation of a sweep on the device by its key.
+ * @param[out] e:  Pointer to the record of the first miscalculation of the sweep.
+ * @param[in] key: The smallest key FLUX_ERR_KEY() of the miscalculations.
+ * @param[in] num: Number of the miscalculations.
+ * @param[in] kind: Kinds of the miscalculations.
+ * @param[in] n:   Number of the interfaces in a line minus one.
+ */
+void flux_err_key_set(struct flux_err_rec * e, const long key, const int num, const int kind, const int n)
+{
+	if (!num)
+		return;
+	e->err  = (int)(key % 8);
+	e->i    = (int)(key / 8 % (n + 1));
+	e->j    = (int)(key / 8 / (n + 1));
+	e->num  = num;
+	e->kind = kind;
+}
+
+/**
+ * @brief This function reports the first miscalculation of a sweep in one message.
+ * @param[in]  e: Pointer to the record of the first miscalculation of the sweep.
+ * @param[in] nt: Current plot time step.
+ * @param[in] dir: Direction of the sweep ('x' or 'y').
+ * @return    miscalculation indicator of the flux generators.
+ *   @retval  0: Successful calculation.
+ *   @retval  1: Calculation error of left/right states.
+ *   @retval  2: Calculation error of interfacial fluxes.
+ */
+int flux_err_report(const struct flux_err_rec * e, const int nt, const char dir)
+{
+	if (!e->num)
+		return 0;
+	printf("%s on [%d, %d, %d] (nt, x, y) - %c", e->err > 3 ? star_dire_check_msg(e->err - 3) : ifvar_check_msg(e->err, 2),
+	       nt, e->j, e->i, dir);
+	if (e->num > 1)
+		printf(", %d miscalculations in the sweep", e->num);
+	printf(".\n");
+	return e->kind & 1 ? 1 : 2;
+}
+
+
+/**
+ * @brief This function resolves the flux solver of a scheme once per run, so that the loops over the interfaces
+ *        call it without comparing the scheme names or checking the dimension at each interface.
+ * @param[in] ctx:    Pointer to the run context.
+ * @param[in] scheme: Scheme name (Roe, HLL, HLLC, Riemann_exact of order 1; GRP_2D of order 2).
+ * @param[in] order:  Order of the scheme.
+ * @return    Pointer to the flux solver (NULL: no such solver).
+ */
+flux_solver_fn flux_solver_select(const struct run_ctx * ctx, const char * scheme, const int order)
+{
+	const int dim = (int)ctx->conf[0];
+
+	if (order == 1)
+		{
+			if (strcmp(scheme,"Roe") == 0)
+				return dim == 1 ? Roe_1D_flux_kernel : (dim == 2 ? Roe_2D_flux_kernel : NULL);
+			else if (strcmp(scheme,"HLL") == 0)
+				return dim == 2 ? HLL_2D_flux_kernel : NULL;
+			else if (strcmp(scheme,"HLLC") == 0)
+				return dim == 2 ? HLLC_2D_flux_kernel : NULL;
+			else if (strcmp(scheme,"Riemann_exact") == 0)
+				return Riemann_exact_flux_kernel;
+		}
+	else if (order == 2)
+		{
+			if (strcmp(scheme,"GRP_2D") == 0 && dim == 2)
+				return GRP_2D_flux;
+		}
+	return NULL;
+}
+
+
+/**
+ * @brief This function resolves the batched flux solver of a scheme once per run, which gives the same fluxes as
+ *        the solver resolved by flux_solver_select() for a block of interfaces at a time.
+ * @param[in] ctx:    Pointer to the run context.
+ * @param[in] scheme: Scheme name (Roe, HLL of order 1).
+ * @param[in] order:  Order of the scheme.
+ * @return    Pointer to the batched flux solver (NULL: the scheme has no batched solver).
+ */
+flux_batch_fn flux_batch_select(const struct run_ctx * ctx, const char * scheme, const int order)
+{
+	const int dim = (int)ctx->conf[0];
+
+	if (order == 1 && dim == 2)
+		{
+			if (strcmp(scheme,"Roe") == 0)
+				return Roe_2D_flux_batch;
+			else if (strcmp(scheme,"HLL") == 0)
+				return HLL_2D_solver_batch;
+		}
+	return NULL;
+}
+
+
+/**
+ * @brief This function resolves the flux solver of a scheme once per run as its number for the device loops of OpenACC,
+ *        which call the solvers by flux_solver_call() instead of the pointers given by flux_solver_select().
+ * @param[in] ctx:    Pointer to the run context.
+ * @param[in] scheme: Scheme name.
+ * @param[in] order:  Order of the scheme.
+ * @return    Number of the flux solver (enum flux_solver_id, FLUX_NONE: no such solver of the 2-D interfaces).
+ */
+int flux_solver_id_select(const struct run_ctx * ctx, const char * scheme, const int order)
+{
+	const flux_solver_fn flux = flux_solver_select(ctx, scheme, order);
+
+	if (flux == Roe_2D_flux_kernel)
+		return FLUX_ROE_2D;
+	else if (flux == HLL_2D_flux_kernel)
+		return FLUX_HLL_2D;
+	else if (flux == HLLC_2D_flux_kernel)
+		return FLUX_HLLC_2D;
+	else if (flux == Riemann_exact_flux_kernel && (int)ctx->conf[0] == 2)
+		return FLUX_EXACT_2D;
+	else if (flux == GRP_2D_flux)
+		return FLUX_GRP_2D;
+	return FLUX_NONE;
+}
+
+
+/**
+ * @brief This function calculates the fluxes at an interface by the flux solver of its number.
+ * @details It is the same as the solver flux_solver_select(ctx, scheme, order), see flux_solver_fn.
+ * @param[in] id: Number of the flux solver given by flux_solver_id_select().
+ * @return    miscalculation indicator (-1: no such solver).
+ */
+int flux_solver_call(const int id, const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau)
+{
+	switch (id)
+		{
+		case FLUX_ROE_2D:
+			return Roe_2D_flux_kernel(ctx, ifv, ifv_R, tau);
+		case FLUX_HLL_2D:
+			return HLL_2D_flux_kernel(ctx, ifv, ifv_R, tau);
+		case FLUX_HLLC_2D:
+			return HLLC_2D_flux_kernel(ctx, ifv, ifv_R, tau);
+		case FLUX_EXACT_2D:
+			return Riemann_exact_flux_kernel(ctx, ifv, ifv_R, tau);
+		case FLUX_GRP_2D:
+			return GRP_2D_flux(ctx, ifv, ifv_R, tau);
+		}
+	return -1;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file  hydro_api_1D.c
+ * @brief This is the library API of the 1-D Lagrangian GRP scheme, which is embedded in other programs.
+ * @details An instance is a run context with the state of the time loop of GRP_solver_LAG_source(), so that the
+ *          instances in one process are independent of each other. The arrays of the density, velocity, pressure
+ *          and grid point coordinates belong to the caller, they are read and updated in place by the time steps,
+ *          without any copy or file. A time step is that of GRP_solver_LAG_source() with no plotting time,
+ *          whose interfaces are solved by GRP_LAG_interface() and whose cells are updated by LAG_update_cell().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#include "../include/var_struc.h"
+#include "../include/inter_process.h"
+#include "../include/finite_volume.h"
+#include "../include/file_io.h"
+#include "../include/hydro_api.h"
+
+
+//! The number of the scratch arrays of an instance at the cells or the interfaces.
+#define HD_NV 15
+
+//! An instance of the 1-D Lagrangian GRP scheme.
+struct hydro_1D {
+	struct run_ctx ctx;          //!< run context of the instance.
+	int m;                       //!< number of the cells.
+	int k;                       //!< number of the time steps done.
+	double time, tau_cfl;        //!< time of the state and length of the last time step before it is shortened by the caller.
+	double * RHO, * U, * P, * X; //!< arrays of the caller: m cell values and m+1 grid point coordinates.
+	double * E, * R_MASS;        //!< specific total energy and reciprocal of the mass of the cells.
+	_Bool uniform;               //!< whether the cells are of uniform mass.
+	double * s_rho, * s_u, * s_p;                  //!< slopes of the cells.
+	double * U_next, * P_next, * RHO_next_L, * RHO_next_R; //!< GRP solutions at the interfaces.
+	double * U_t, * P_t, * RHO_t_L, * RHO_t_R;     //!< temporal derivatives at the interfaces.
+	double * U_F, * P_F;                           //!< numerical fluxes at the interfaces.
+	struct cell_var_stru CV;     //!< the cell variables of one level on the arrays of the caller.
+	struct b_f_var bfv_L, bfv_R; //!< fluid variables at the left/right boundary.
+	_Bool find_bound;            //!< whether the boundary conditions have been found.
+};
+
+
+/**
+ * @brief This function initializes an instance on the state arrays of the caller.
+ * @details The configuration data not given are the defaults of 'doc/config.csv', the boundary condition
+ *          (config[17]) is given by the caller. The arrays of the caller are kept by the instance until
+ *          hydro_1D_finalize(), they are not copied.
+ * @param[in] n_conf: Number of the configuration data given (<= N_CONF).
+ * @param[in] conf:   Array of the configuration data config[0 … n_conf-1] (not finite: default).
+ * @param[in] m:      Number of the cells.
+ * @param[in,out] RHO, U, P: Arrays of the density, velocity and pressure of the m cells.
+ * @param[in,out] X:  Array of the m+1 grid point coordinates.
+ * @return    Instance of the scheme (NULL: invalid arguments or not enough memory).
+ */
+struct hydro_1D * hydro_1D_init(const int n_conf, const double conf[], const int m,
+				double RHO[], double U[], double P[], double X[])
+{
+    struct hydro_1D * hd;
+    double * block;
+    int i;
+    if(m < 2 || n_conf < 0 || n_conf > N_CONF || RHO == NULL || U == NULL || P == NULL || X == NULL)
+	{
+	    printf("Invalid arguments of the 1-D hydrocode instance!\n");
+	    return NULL;
+	}
+    hd = (struct hydro_1D *)calloc(1, sizeof(struct hydro_1D));
+    block = (double *)malloc((size_t)HD_NV * (m+1) * sizeof(double));
+    if(hd == NULL || block == NULL)
+	{
+	    printf("NOT enough memory! hydro_1D\n");
+	    free(hd);
+	    free(block);
+	    return NULL;
+	}
+
+    for(i = 0; i < N_CONF; ++i)
+	hd->ctx.conf[i] = i < n_conf && isfinite(conf[i]) ? conf[i] : INFINITY;
+    hd->ctx.conf[0] = 1.0; // dimension
+    hd->ctx.conf[3] = (double)m;
+    hd->ctx.conf[8] = 1.0; // Lagrangian coordinate
+    if(!isfinite(hd->ctx.conf[1]) && !isfinite(hd->ctx.conf[5]))
+	hd->ctx.conf[1] = INFINITY, hd->ctx.conf[5] = (double)INT_MAX; // The time is given by each call.
+    if(!isfinite(hd->ctx.conf[9]))
+	hd->ctx.conf[9] = 2.0;
+    if(!isfinite(hd->ctx.conf[10]))
+	hd->ctx.conf[10] = (X[m] - X[0]) / m;
+    configurate_conf(&hd->ctx);
+
+    hd->m   = m;
+    hd->RHO = RHO;
+    hd->U   = U;
+    hd->P   = P;
+    hd->X   = X;
+    hd->E          = block;
+    hd->R_MASS     = block +  1*(m+1);
+    hd->s_rho      = block +  2*(m+1);
+    hd->s_u        = block +  3*(m+1);
+    hd->s_p        = block +  4*(m+1);
+    hd->U_next     = block +  5*(m+1);
+    hd->P_next     = block +  6*(m+1);
+    hd->RHO_next_L = block +  7*(m+1);
+    hd->RHO_next_R = block +  8*(m+1);
+    hd->U_t        = block +  9*(m+1);
+    hd->P_t        = block + 10*(m+1);
+    hd->RHO_t_L    = block + 11*(m+1);
+    hd->RHO_t_R    = block + 12*(m+1);
+    hd->U_F        = block + 13*(m+1);
+    hd->P_F        = block + 14*(m+1);
+    for(i = 0; i < m; ++i)
+	hd->s_rho[i] = hd->s_u[i] = hd->s_p[i] = 0.0;
+    // the levels of one time on the arrays of the caller
+    hd->CV.RHO = &hd->RHO;
+    hd->CV.U   = &hd->U;
+    hd->CV.P   = &hd->P;
+    hd->CV.E   = &hd->E;
+    hd->CV.d_rho = hd->s_rho;
+    hd->CV.d_u   = hd->s_u;
+    hd->CV.d_p   = hd->s_p;
+    hd->bfv_L = (struct b_f_var){.H = hd->ctx.conf[10]};
+    hd->bfv_R = hd->bfv_L;
+    hd->tau_cfl = hd->ctx.conf[16];
+    hydro_1D_sync(hd);
+    return hd;
+}
+
+/**
+ * @brief This function gives the changes of the state arrays made by the caller between the time steps to the instance.
+ * @details The specific total energy and the mass of the cells are calculated from the arrays of the caller,
+ *          and the update kernel is chosen as in GRP_solver_LAG_source(): one reciprocal mass for the uniform-mass cells,
+ *          or the array of the reciprocal masses otherwise.
+ */
+void hydro_1D_sync(struct hydro_1D * hd)
+{
+    double const gamma = hd->ctx.conf[6];
+    double mass, mass_0 = 0.0;
+    int j;
+    hd->uniform = true;
+    for(j = 0; j < hd->m; ++j)
+	{
+	    hd->E[j]      = 0.5*hd->U[j]*hd->U[j] + hd->P[j]/(gamma - 1.0)/hd->RHO[j];
+	    mass          = hd->RHO[j] * (hd->X[j+1] - hd->X[j]);
+	    hd->R_MASS[j] = 1.0 / mass;
+	    if(j == 0)
+		mass_0 = mass;
+	    hd->uniform = hd->uniform && mass == mass_0;
+	}
+}
+
+/**
+ * @brief This function gives the time of the state of the instance.
+ */
+double hydro_1D_time(const struct hydro_1D * hd)
+{
+    return hd->time;
+}
+
+/**
+ * @brief This function runs one time step of the instance, which updates the arrays of the caller.
+ * @details The time step by the CFL condition is cut to 'tau', or stretched to it if the step ends within eps of it,
+ *          as the last time step of GRP_solver_LAG_source() lands on the total time.
+ * @param[in,out] hd:  Instance of the scheme.
+ * @param[in,out] tau: Largest length of the time step (not finite: by the CFL condition), and then the length of the time step.
+ * @return    miscalculation indicator.
+ *   @retval  0: Successful calculation.
+ *   @retval  1: Error in the GRP solutions or the updated cells, the computation should stop after this time step.
+ *   @retval  2: Error in the reconstructed states or the boundary conditions, the state is not updated.
+ *   @retval  3: Error in the length of the time step, the state is not updated.
+ */
+int hydro_1D_step(struct hydro_1D * hd, double * tau)
+{
+    double const eps   = hd->ctx.conf[4];
+    double const gamma = hd->ctx.conf[6];
+    double const CFL   = hd->ctx.conf[7];
+    double const C_m   = 1.01; // a multiplicative coefficient allows the time step to increase.
+    int const m = hd->m;
+    double * const RHO = hd->RHO, * const U = hd->U, * const P = hd->P, * const E = hd->E, * const X = hd->X;
+    double h_S_max = INFINITY, dt, tau_cfl;
+    int j, err = 0, err_I;
+
+    hd->find_bound = bound_cond_slope_limiter(&hd->ctx, true, m, 0, &hd->CV, &hd->bfv_L, &hd->bfv_R, hd->find_bound, true, hd->time, X);
+    if(!hd->find_bound)
+	return 2;
+
+#pragma omp parallel for private(err_I) reduction(min:h_S_max) reduction(max:err)
+    for(j = 0; j <= m; ++j)
+	{
+	    err_I = GRP_LAG_interface(&hd->ctx, j, m, hd->k+1, RHO, U, P, hd->s_rho, hd->s_u, hd->s_p, X,
+				      &hd->bfv_L, &hd->bfv_R, &h_S_max, hd->RHO_next_L, hd->RHO_next_R, hd->U_next, hd->P_next,
+				      hd->RHO_t_L, hd->RHO_t_R, hd->U_t, hd->P_t);
+	    err = err_I > err ? err_I : err;
+	}
+    if(err > 1)
+	return 2;
+
+    dt = tau_cfl = fmin(CFL * h_S_max, C_m * hd->tau_cfl);
+    if(isfinite(*tau) && dt > *tau - eps)
+	dt = *tau;
+    if(!isfinite(dt) || dt < eps)
+	{
+	    printf("The length of the time step is wrong on [%d, %g, %g] (t_n, time_c, tau)\n", hd->k+1, hd->time, dt);
+	    return 3;
+	}
+
+#pragma omp parallel for
+    for(j = 0; j <= m; ++j)
+	{
+	    hd->U_F[j] = hd->U_next[j] + 0.5 * dt * hd->U_t[j];
+	    hd->P_F[j] = hd->P_next[j] + 0.5 * dt * hd->P_t[j];
+
+	    hd->RHO_next_L[j] += dt * hd->RHO_t_L[j];
+	    hd->RHO_next_R[j] += dt * hd->RHO_t_R[j];
+	    hd->U_next[j]     += dt * hd->U_t[j];
+	    hd->P_next[j]     += dt * hd->P_t[j];
+
+	    X[j] += dt * hd->U_F[j]; // motion along the contact discontinuity
+	}
+
+    if(hd->uniform)
+	{
+	    double const dt_m = dt * hd->R_MASS[0];
+#pragma omp parallel for simd reduction(|:err)
+	    for(j = 0; j < m; ++j) // forward Euler
+		err |= LAG_update_cell(j, dt_m, gamma, eps, RHO, U, E, RHO, U, P, E, X, hd->U_F, hd->P_F,
+				       hd->U_next, hd->P_next, hd->RHO_next_L, hd->RHO_next_R, hd->s_rho, hd->s_u, hd->s_p);
+	}
+    else
+#pragma omp parallel for simd reduction(|:err)
+	for(j = 0; j < m; ++j) // forward Euler
+	    err |= LAG_update_cell(j, dt * hd->R_MASS[j], gamma, eps, RHO, U, E, RHO, U, P, E, X, hd->U_F, hd->P_F,
+				   hd->U_next, hd->P_next, hd->RHO_next_L, hd->RHO_next_R, hd->s_rho, hd->s_u, hd->s_p);
+    if(err)
+	printf("<0.0 error on [%d, %g] (t_n, time_c) - Update\n", hd->k+1, hd->time);
+
+    hd->tau_cfl = tau_cfl;
+    hd->time   += dt;
+    hd->k++;
+    *tau = dt;
+    return err;
+}
+
+/**
+ * @brief This function runs the time steps of the instance until the time t_end.
+ * @details The last time step is shortened to reach t_end.
+ * @param[in,out] hd:     Instance of the scheme.
+ * @param[in]     t_end:  Time to reach.
+ * @param[out]    n_step: Number of the time steps run (NULL: not given).
+ * @return    miscalculation indicator of the last time step (see hydro_1D_step()).
+ */
+int hydro_1D_advance(struct hydro_1D * hd, const double t_end, int * n_step)
+{
+    double const eps = hd->ctx.conf[4];
+    double tau;
+    int n = 0, err = 0;
+    while(hd->time < t_end - eps && !err)
+	{
+	    tau = t_end - hd->time;
+	    err = hydro_1D_step(hd, &tau);
+	    n += err < 2;
+	}
+    if(n_step)
+	*n_step = n;
+    return err;
+}
+
+/**
+ * @brief This function frees an instance, the arrays of the caller are kept.
+ */
+void hydro_1D_finalize(struct hydro_1D * hd)
+{
+    if(hd == NULL)
+	return;
+    free(hd->E);
+    free(hd);
+}
@@ -49,6 +49,8 @@
  * @section Usage_description Usage description
  *          - Input files are stored in folder 'data_in/one-dim/name_of_test_example/'.
  *          - Input files may be produced by MATLAB/Octave script 'value_start.m'.
+ *          - The initial data of a fluid variable (e.g. RHO) is read from the first one of 'RHO.bin' (raw little-endian doubles),
+ *            the dataset '/RHO' in 'FLU_VAR.h5' and the text files 'RHO.txt/.dat'.
  *          - Description of configuration file 'config.txt/.dat' refers to 'doc/config.csv'.
  *          - Run program:
  *            - Linux/Unix: Run 'shell/hydrocode_run.sh' command on the terminal. \n
@@ -58,7 +60,9 @@
  *                          e.g. 'hydrocode.out GRP_Book/6_1 GRP_Book/6_1 2[_GRP] LAG 5=100' (second-order Lagrangian GRP scheme).
  *                          - order: Order of numerical scheme (= 1 or 2).
  *                          - scheme: Scheme name (= Riemann_exact/Godunov, GRP or …).
- *                          - coordinate: Lagrangian/Eulerian coordinate framework (= LAG or EUL).
+ *                          - coordinate: Lagrangian/Eulerian/ALE coordinate framework (= LAG, EUL or ALE).
+ *                            ALE (second order) moves the grids with the fluid and relaxes them toward the uniform
+ *                            spacing at the rate config[91] per time step.
  *            - Windows: Run 'hydrocode.bat' command on the terminal. \n
  *                       The details are as follows: \n
  *                       Run 'hydrocode.exe name_of_test_example name_of_numeric_result order[_scheme] 
@@ -73,12 +77,42 @@
  *             <tr><th> Subsystem <td> (/SUBSYSTEM:CONSOLE)
  *             </table>
  * 
+ *          - Run an ensemble of runs in one process:
+ *            - Run 'hydrocode.out -e ensemble_specification name_of_numeric_results' command on the terminal. \n
+ *              Each line of the specification file is 'name_of_test_example order[_scheme] coordinate n=C1,C2,…',
+ *              and all the combinations of the swept values C1,C2,… are computed.
+ *            - The results are written in 'data_out/one-dim/ensemble/name_of_numeric_results/ensemble.dat'.
+ *            - Add '75=W' to run the members of a case of the second-order Lagrangian GRP scheme W at a time
+ *              in the lanes of the batched GRP solver, and '76=1' to share the minimum time step of them.
+ * 
+ *          - Checkpoint and restart a long run:
+ *            - Add '43=K' to write the binary file 'checkpoint.bin' in the output folder every K time steps.
+ *            - Run the same command with '44=1' to restart from the last checkpoint bit-for-bit.
+ * 
+ *          - Run on the parts of MPI processes (second-order Lagrangian GRP scheme):
+ *            - Compile with 'make CC=mpicc CFLAGD="-DHDF5PLOT -DMPI_1D"', and run 'mpirun -np P hydrocode.out …'.
+ *            - Each process writes the output files of its part into the folder 'rank_r/' of the numerical results,
+ *              and 'FLU_VAR.h5' of the whole grids maps the HDF5 files of the parts in order.
+ * 
+ *          - Watch a run live:
+ *            - Add '87=T' to publish the current fields every T seconds of wall-clock time into the shared memory
+ *              '/dev/shm/hydrocode_<name_of_numeric_result>_r0' (with '88=S', every S-th cell), which an external
+ *              viewer maps without stopping the run; the layout is described in 'live_publish.c'.
+ * 
+ *          - Select the fields of the '.dat' and HDF5 output:
+ *            - Add '94=F' with F the sum of the bits of the fields (RHO = 1, U = 2, P = 8, E = 16, e_int = 32, c = 64,
+ *              Ma = 128, S = 256), e.g. '94=137' for the density, the pressure and the Mach number
+ *              (Default: RHO, U, P and E).
+ *            - The derived fields are computed from the primitive variables when they are written, so they are never stored.
+ * 
  *          - Output files can be found in folder 'data_out/one-dim/'.
  *          - Output files may be visualized by MATLAB/Octave script 'value_plot.m'.
  * 
  * @section Precompiler_options Precompiler options
  *          - NODATPLOT: in hydrocode.c. (Default: undef)
  *          - HDF5PLOT:  in hydrocode.c. (Default: undef)
+ *          - PERFCOUNTER: in phase_timer.c and perf_counter.c, hardware counters of the phases (Linux perf_event). (Default: undef)
+ *          - MPI_1D:    in hydrocode.c and halo_exchange_1D.c. (Default: undef)
  *          - Riemann_solver_exact_single: in riemann_solver.h.            (Default: Riemann_solver_exact_Ben)
  *          - MULTIFLUID_BASICS: 'Switch whether to compute multi-fluids.' (Default: undef)
  */
@@ -89,10 +123,21 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdbool.h>
+#ifdef MPI_1D
+#include <mpi.h>
+#endif
 
 #include "../include/var_struc.h"
 #include "../include/file_io.h"
 #include "../include/finite_volume.h"
+#include "../include/riemann_solver.h"
+#include "../include/inter_process.h"
+#include "../include/tools.h"
+#include "../include_cii/arena.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 #ifdef DOXYGEN_PREDEFINED
@@ -106,9 +151,14 @@
  * @brief Switch whether to plot with HDF5 data.
  */
 #define HDF5PLOT
+/**
+ * @def MPI_1D
+ * @brief Switch whether to decompose the grids into parts of the MPI processes.
+ */
+#define MPI_1D
 #endif
 
-double config[N_CONF]; //!< Initial configuration data array.
+struct run_ctx run_ctx_global; //!< Run context of the process.
 
 /**
  * @brief N memory allocations to the initial fluid variable 'v' in the structure cell_var_stru.
@@ -135,6 +185,407 @@ double config[N_CONF]; //!< Initial configuration data array.
 	    }								\
     } while (0)
 
+/**
+ * @brief This function solves the 1-D problem with the scheme of the given order and coordinate framework.
+ * @param[in,out] ctx:    Pointer to the run context.
+ * @param[in] coord:      Lagrangian/Eulerian/ALE coordinate framework (= LAG, EUL or ALE).
+ * @param[in] order:      Order of numerical scheme.
+ * @param[in] m:          Number of the grids.
+ * @param[in,out] CV:     Structure of cell variable data.
+ * @param[in,out] X:      Array of the coordinate data.
+ * @param[out] cpu_time:  Array of the CPU time recording.
+ * @param[in]  problem:   Name of the numerical results for the test problem.
+ * @param[in]  N:         Number of levels storing fluid variables in memory.
+ * @param[in,out] N_plot: Pointer to the number of time steps for plotting.
+ * @param[in,out] time_plot: Array of the plotting time recording.
+ * @return Program exit status code (0 or 4: Arguments error).
+ */
+static int hydrocode_1D_solve(struct run_ctx * ctx, const char * coord, const int order, const int m, struct cell_var_stru CV,
+			      double ** X, double * cpu_time, const char * problem, const int N, int * N_plot, double * time_plot)
+{
+  int k, j;
+  if (strcmp(coord,"LAG") == 0) // Use GRP/Godunov scheme to solve it on Lagrangian coordinate.
+      {
+	  ctx->conf[8] = (double)1;
+	  switch(order)
+	      {
+	      case 1:
+		  Godunov_solver_LAG_source(ctx, m, CV, X, cpu_time, problem, N, N_plot, time_plot);
+		  break;
+	      case 2:
+		  if ((int)ctx->conf[80] > 0 && m > 3) // fused cache-blocked sweep
+		      GRP_solver_LAG_fused(ctx, m, CV, X, cpu_time, problem, N, N_plot, time_plot);
+		  else if ((int)ctx->conf[37] > 0) // local time stepping
+		      GRP_solver_LAG_LTS(ctx, m, CV, X, cpu_time, problem, N, N_plot, time_plot);
+		  else
+		      GRP_solver_LAG_source(ctx, m, CV, X, cpu_time, problem, N, N_plot, time_plot);
+		  break;
+	      default:
+		  printf("NOT appropriate order of the scheme! The order is %d.\n", order);
+		  return 4;
+ 	      }
+      }
+  else if (strcmp(coord,"EUL") == 0) // Use GRP/Godunov scheme to solve it on Eulerian coordinate.
+      {
+	  ctx->conf[8] = (double)0;
+	  for (k = 1; k < N; ++k)
+	      for (j = 0; j <= m; ++j)
+		  X[k][j] = X[0][j];
+	  switch(order)
+	      {
+	      case 1:
+		  Godunov_solver_EUL_source(ctx, m, CV, cpu_time, problem, N, N_plot, time_plot);
+		  break;
+	      case 2:
+		  if ((int)ctx->conf[38] > 0) // adaptive mesh refinement
+		      GRP_solver_EUL_AMR(ctx, m, CV, cpu_time, problem, N, N_plot, time_plot);
+		  else
+		      GRP_solver_EUL_source(ctx, m, CV, cpu_time, problem, N, N_plot, time_plot);
+		  break;
+	      default:
+		  printf("NOT appropriate order of the scheme! The order is %d.\n", order);
+		  return 4;
+	      }
+      }
+  else if (strcmp(coord,"ALE") == 0) // Use GRP scheme to solve it on ALE coordinate.
+      {
+	  ctx->conf[8] = (double)2;
+	  switch(order)
+	      {
+	      case 2:
+		  GRP_solver_ALE_source(ctx, m, CV, X, cpu_time, problem, N, N_plot, time_plot);
+		  break;
+	      default:
+		  printf("NOT appropriate order of the scheme! The order is %d.\n", order);
+		  return 4;
+	      }
+      }
+  else
+      {
+	  printf("NOT appropriate coordinate framework! The framework is %s.\n", coord);
+	  return 4;
+      }
+  return 0;
+}
+
+//! The run of one member of the ensemble and its arrays.
+struct ens_run {
+	struct run_ctx * ctx;        //!< run context of the member.
+	struct cell_var_stru CV;     //!< current level of the fluid variables.
+	double * RHO, * U, * P, * E; //!< fluid variables of the cells.
+	double * X;                  //!< grid point coordinates.
+	double tic;                  //!< wall-clock time of the start.
+};
+
+/**
+ * @brief This function prepares the run context and the initial data of one member of the ensemble.
+ * @param[out] R:     Pointer to the run of the member.
+ * @param[in,out] EM: Pointer to the member (status 5: Memory error).
+ * @param[in]  FV0:   Structure of the initial data array pointer of the case (read-only).
+ * @param[in]  ctx0:  Pointer to the run context of the case.
+ * @return Whether the member is ready to run.
+ */
+static _Bool hydrocode_1D_member_init(struct ens_run * R, struct ens_member * EM, const struct flu_var FV0, const struct run_ctx * ctx0)
+{
+  int j, k;
+  *R = (struct ens_run){.tic = wall_time()};
+  R->ctx = (struct run_ctx *)malloc(sizeof(struct run_ctx));
+  EM->status = 5;
+  if(R->ctx == NULL)
+      {
+	  printf("NOT enough memory! Run context\n");
+	  return false;
+      }
+  struct run_ctx * ctx = R->ctx;
+  *ctx = *ctx0;
+  for(k = 0; k < EM->n_conf; ++k)
+      ctx->conf[EM->i_conf[k]] = EM->v_conf[k];
+  ctx->conf[34] = (double)0; // The results of the ensemble are written together.
+  ctx->conf[43] = (double)0; // The members are neither checkpointed nor restarted.
+  ctx->conf[44] = (double)0;
+  const int m = (int)ctx->conf[3];
+  const double h = ctx->conf[10], gamma = ctx->conf[6];
+
+  // Only the current level of fluid variables is kept in memory.
+  R->RHO = (double *)malloc(m * sizeof(double));
+  R->U   = (double *)malloc(m * sizeof(double));
+  R->P   = (double *)malloc(m * sizeof(double));
+  R->E   = (double *)malloc(m * sizeof(double));
+  R->X   = (double *)malloc((m+1) * sizeof(double));
+  EM->m = m;
+  if(R->RHO == NULL || R->U == NULL || R->P == NULL || R->E == NULL || R->X == NULL)
+      {
+	  printf("NOT enough memory! Ensemble member\n");
+	  return false;
+      }
+  memcpy(R->RHO, FV0.RHO, m * sizeof(double));
+  memcpy(R->U,   FV0.U,   m * sizeof(double));
+  memcpy(R->P,   FV0.P,   m * sizeof(double));
+  for(j = 0; j <= m; ++j)
+      R->X[j] = h * j;
+  for(j = 0; j < m; ++j)
+      R->E[j] = 0.5*R->U[j]*R->U[j] + R->P[j]/(gamma - 1.0)/R->RHO[j];
+  R->CV.RHO = &R->RHO;
+  R->CV.U   = &R->U;
+  R->CV.P   = &R->P;
+  R->CV.E   = &R->E;
+  EM->status = 0;
+  return true;
+}
+
+/**
+ * @brief This function fills in the results of one member of the ensemble and frees its run.
+ * @param[in,out] R:  Pointer to the run of the member.
+ * @param[in,out] EM: Pointer to the member, whose status, steps and final time have been given.
+ * @param[in]  run:   Whether the member has been run.
+ */
+static void hydrocode_1D_member_end(struct ens_run * R, struct ens_member * EM, const _Bool run)
+{
+  int j;
+  double dx;
+  const int m = EM->m;
+  if(!run)
+      goto return_NULL;
+  EM->wall = wall_time() - R->tic;
+  if(!EM->status && isfinite(R->ctx->conf[1]) && EM->time < R->ctx->conf[1] - R->ctx->conf[4])
+      EM->status = 3; // The computation stops before the total time.
+
+  EM->X   = (double *)malloc(m * sizeof(double));
+  EM->RHO = (double *)malloc(m * sizeof(double));
+  EM->U   = (double *)malloc(m * sizeof(double));
+  EM->P   = (double *)malloc(m * sizeof(double));
+  if(EM->X == NULL || EM->RHO == NULL || EM->U == NULL || EM->P == NULL)
+      {
+	  printf("NOT enough memory! Ensemble results\n");
+	  EM->status = 5;
+	  goto return_NULL;
+      }
+  for(j = 0; j < m; ++j)
+      {
+	  dx = R->X[j+1] - R->X[j];
+	  EM->X[j]   = 0.5 * (R->X[j] + R->X[j+1]);
+	  EM->RHO[j] = R->RHO[j];
+	  EM->U[j]   = R->U[j];
+	  EM->P[j]   = R->P[j];
+	  EM->mass  += R->RHO[j]*dx;
+	  EM->mom   += R->RHO[j]*R->U[j]*dx;
+	  EM->ene   += R->RHO[j]*R->E[j]*dx;
+      }
+
+ return_NULL:
+  free(R->RHO);
+  free(R->U);
+  free(R->P);
+  free(R->E);
+  free(R->X);
+  free(R->ctx);
+}
+
+/**
+ * @brief This function runs one member of the ensemble with its own configuration.
+ * @param[in,out] EM: Pointer to the member, whose results are filled in.
+ * @param[in]  EC:    Pointer to the case of the member.
+ * @param[in]  FV0:   Structure of the initial data array pointer of the case (read-only).
+ * @param[in]  ctx0:  Pointer to the run context of the case.
+ * @param[in]  N_plot: Number of time steps for plotting of the case.
+ * @param[in]  time_plot: Array of the plotting time of the case.
+ */
+static void hydrocode_1D_member(struct ens_member * EM, const struct ens_case * EC, const struct flu_var FV0,
+				const struct run_ctx * ctx0, int N_plot, const double * time_plot)
+{
+  struct ens_run R;
+  double cpu_time;
+  double * t_p = (double *)malloc(N_plot * sizeof(double));
+  _Bool run = hydrocode_1D_member_init(&R, EM, FV0, ctx0);
+  if(run && t_p == NULL)
+      {
+	  printf("NOT enough memory! Ensemble member\n");
+	  EM->status = 5;
+	  run = false;
+      }
+  if(run)
+      {
+	  memcpy(t_p, time_plot, N_plot * sizeof(double));
+	  EM->status = hydrocode_1D_solve(R.ctx, EC->coord, (int)R.ctx->conf[9], EM->m, R.CV, &R.X, &cpu_time, EC->example, 1, &N_plot, t_p);
+	  EM->steps  = (int)R.ctx->conf[5];
+	  EM->time   = t_p[N_plot-1];
+      }
+  hydrocode_1D_member_end(&R, EM, run);
+  free(t_p);
+}
+
+/**
+ * @brief This function runs a group of members of the same case in the lanes of GRP_solver_LAG_lanes().
+ * @param[in,out] EM:  Array of the members of the group, whose results are filled in.
+ * @param[in]  W:      Number of the members of the group (<= GRP_BATCH_SIZE).
+ * @param[in]  FV0:    Structure of the initial data array pointer of the case (read-only).
+ * @param[in]  ctx0:   Pointer to the run context of the case.
+ */
+static void hydrocode_1D_lanes(struct ens_member * EM, const int W, const struct flu_var FV0, const struct run_ctx * ctx0)
+{
+  struct ens_run R[GRP_BATCH_SIZE];
+  struct run_ctx * ctx[GRP_BATCH_SIZE];
+  struct cell_var_stru CV[GRP_BATCH_SIZE];
+  double * X[GRP_BATCH_SIZE], time_c[GRP_BATCH_SIZE];
+  int w, status = 0;
+  for(w = 0; w < W; ++w)
+      if(!hydrocode_1D_member_init(R+w, EM+w, FV0, ctx0))
+	  status = 5;
+      else
+	  {
+	      ctx[w] = R[w].ctx;
+	      ctx[w]->conf[8] = (double)1;
+	      CV[w]  = R[w].CV;
+	      X[w]   = R[w].X;
+	  }
+  if(!status)
+      status = GRP_solver_LAG_lanes(ctx, W, EM->m, CV, X, time_c);
+  for(w = 0; w < W; ++w)
+      {
+	  if(status)
+	      EM[w].status = status;
+	  else
+	      {
+		  EM[w].steps = (int)ctx[w]->conf[5];
+		  EM[w].time  = time_c[w];
+	      }
+	  hydrocode_1D_member_end(R+w, EM+w, !status);
+      }
+}
+
+/**
+ * @brief This function gives the configuration data n of a member of the ensemble.
+ */
+static double member_conf(const struct ens_member * EM, const struct run_ctx * ctx0, const int n)
+{
+  int k;
+  for(k = EM->n_conf-1; k >= 0; --k)
+      if(EM->i_conf[k] == n)
+	  return EM->v_conf[k];
+  return ctx0->conf[n];
+}
+
+/**
+ * @brief This function runs the ensemble of 1-D runs of the specification and writes the results into one file.
+ * @details The initial data of each case is read once and shared by its members. Each member runs
+ *          serially on its own run context, and the members run concurrently on the OpenMP threads.
+ *          The consecutive members of a case of the second-order Lagrangian GRP scheme with the lane width
+ *          config[75] > 1 (and the same eps) are grouped into the lanes of GRP_solver_LAG_lanes(), W members a group.
+ * @param[in] spec:    Address of the ensemble specification file.
+ * @param[in] results: Name of the numerical results of the ensemble.
+ * @return Program exit status code.
+ */
+static int hydrocode_1D_ensemble(const char * spec, const char * results)
+{
+  struct ens_case * EC = NULL;
+  struct ens_member * EM = NULL;
+  int n_case, n_member, c, k, N, W, n_group = 0, retval = 0;
+  char * scheme = NULL;
+  int * g_start = NULL, * g_W = NULL; // the first member and the lane width of each group (0: not in lanes)
+
+  n_member = ensemble_1D_read(spec, &EC, &n_case, &EM);
+  if(n_member < 0)
+      return 2;
+  struct flu_var * FV0 = (struct flu_var *)calloc(n_case, sizeof(struct flu_var));
+  struct run_ctx * ctx  = (struct run_ctx *)malloc(n_case * sizeof(struct run_ctx));
+  int * N_plot          = (int *)malloc(n_case * sizeof(int));
+  double ** t_p         = (double **)calloc(n_case, sizeof(double *));
+  if(FV0 == NULL || ctx == NULL || N_plot == NULL || t_p == NULL)
+      {
+	  printf("NOT enough memory! Ensemble cases\n");
+	  retval = 5;
+	  goto return_NULL;
+      }
+  for(c = 0; c < n_case; ++c) // Read the configuration and initial data of each case.
+      {
+	  for(k = 1; k < N_CONF; k++)
+	      ctx[c].conf[k] = INFINITY;
+	  ctx[c].conf[0] = (double)1;
+	  errno = 0;
+	  ctx[c].conf[9] = (double)strtoul(EC[c].order, &scheme, 10);
+	  if ((*scheme != '_' && *scheme != '\0') || errno == ERANGE)
+	      {
+		  printf("No order or Wrog scheme in case %d!\n", c);
+		  retval = 4;
+		  goto return_NULL;
+	      }
+	  FV0[c] = initialize_1D(ctx+c, EC[c].example, &N, N_plot+c, t_p+c);
+      }
+  printf("%d runs of %d cases in the ensemble.\n", n_member, n_case);
+
+  g_start = (int *)malloc((n_member+1) * sizeof(int));
+  g_W     = (int *)malloc(n_member * sizeof(int));
+  if(g_start == NULL || g_W == NULL)
+      {
+	  printf("NOT enough memory! Ensemble groups\n");
+	  retval = 5;
+	  goto return_NULL;
+      }
+  for(k = 0; k < n_member; ++k) // Group the members into the lanes.
+      {
+	  c = EM[k].c;
+	  W = (int)member_conf(EM+k, ctx+c, 75);
+	  W = W < GRP_BATCH_SIZE ? W : GRP_BATCH_SIZE;
+	  if(W < 2 || strcmp(EC[c].coord, "LAG") != 0 || (int)member_conf(EM+k, ctx+c, 9) != 2
+	     || (int)member_conf(EM+k, ctx+c, 80) > 0 || (int)member_conf(EM+k, ctx+c, 37) > 0)
+	      W = 0;
+	  if(n_group && W && g_W[n_group-1] == W && EM[g_start[n_group-1]].c == c && k - g_start[n_group-1] < W
+	     && member_conf(EM+k, ctx+c, 4) == member_conf(EM+g_start[n_group-1], ctx+c, 4))
+	      continue;
+	  g_start[n_group] = k;
+	  g_W[n_group++]   = W;
+      }
+  g_start[n_group] = n_member;
+  if(n_group < n_member)
+      printf("%d groups of the members in the lanes of the GRP solver.\n", n_group);
+
+#ifdef _OPENMP
+  omp_set_max_active_levels(1); // Each member runs serially.
+#endif
+#pragma omp parallel for private(k) schedule(dynamic)
+  for(c = 0; c < n_group; ++c)
+      {
+	  k = g_start[c];
+	  if(g_W[c])
+	      hydrocode_1D_lanes(EM+k, g_start[c+1]-k, FV0[EM[k].c], ctx+EM[k].c);
+	  else
+	      hydrocode_1D_member(EM+k, EC+EM[k].c, FV0[EM[k].c], ctx+EM[k].c, N_plot[EM[k].c], t_p[EM[k].c]);
+      }
+  for(k = 0; k < n_member; ++k)
+      if(EM[k].status)
+	  printf("Member %d of the ensemble exits with status %d.\n", k, EM[k].status);
+
+  PHASE_TIC(PT_IO);
+  ensemble_1D_write(results, EC, EM, n_member);
+  PHASE_TOC(PT_IO);
+
+ return_NULL:
+  for(c = 0; FV0 && c < n_case; ++c)
+      {
+	  free(FV0[c].RHO);
+	  free(FV0[c].U);
+	  free(FV0[c].P);
+	  free(FV0[c].Y);
+	  free(t_p[c]);
+      }
+  for(k = 0; k < n_member; ++k)
+      {
+	  free(EM[k].X);
+	  free(EM[k].RHO);
+	  free(EM[k].U);
+	  free(EM[k].P);
+      }
+  free(FV0);
+  free(ctx);
+  free(N_plot);
+  free(t_p);
+  free(EC);
+  free(EM);
+  free(g_start);
+  free(g_W);
+  return retval;
+}
+
 /**
  * @brief This is the main function which constructs the
  *        main structure of the 1-D Lagrangian/Eulerian hydrocode.
@@ -143,22 +594,44 @@ double config[N_CONF]; //!< Initial configuration data array.
  *          - argv[1]: Folder name of test example (input path).
  *          - argv[2]: Folder name of numerical results (output path).
  *          - argv[3]: Order of numerical scheme[_scheme name] (= 1[_Riemann_exact] or 2[_GRP]).
- *          - argv[4]: Lagrangian/Eulerian coordinate framework (= LAG or EUL).
+ *          - argv[4]: Lagrangian/Eulerian/ALE coordinate framework (= LAG, EUL or ALE).
  *          - argv[5,6,…]: Configuration supplement config[n]=(double)C (= n=C).
  * @return Program exit status code.
  */
 int main(int argc, char *argv[])
 {
   int k, j, retval = 0;
+  struct riemann_stat rs; // statistics of the exact Riemann solvers of the performance report
+  struct run_ctx * const ctx = &run_ctx_global;
   // Initialize configuration data array
   for(k = 1; k < N_CONF; k++)
-      config[k] = INFINITY;
+      ctx->conf[k] = INFINITY;
 
+  if (argc > 1 && strcmp(argv[1],"-e") == 0) // ensemble of runs
+      {
+	  if (argc != 4)
+	      {
+		  printf("Usage: hydrocode.out -e ensemble_specification name_of_numeric_results\n");
+		  return 4;
+	      }
+	  retval = hydrocode_1D_ensemble(argv[2], argv[3]);
+#ifndef NOPHASETIMER
+	  phase_timer_report();
+	  Arena_workspace_report();
+	  Riemann_exact_stat_report();
+#endif
+	  Arena_workspace_dispose();
+	  return retval;
+      }
+
+#ifdef MPI_1D
+  MPI_Init(&argc, &argv);
+#endif
   char * scheme = NULL; // Riemann_exact(Godunov), GRP
-  arg_preprocess(4, argc, argv, scheme);
+  arg_preprocess(ctx, 4, argc, argv, scheme);
 
   // Set dimension.
-  config[0] = (double)1; // Dimensionality = 1
+  ctx->conf[0] = (double)1; // Dimensionality = 1
 
   // The number of times steps of the fluid data stored for plotting.
   int N, N_plot;
@@ -169,21 +642,67 @@ int main(int argc, char *argv[])
      * of a block of memory consisting (m) variables of type double.
      * The (m) array elements of these variables are the initial value.
      */
-  struct flu_var FV0 = initialize_1D(argv[1], &N, &N_plot, &time_plot); // Structure of initial data array pointer.
+  struct flu_var FV0 = initialize_1D(ctx, argv[1], &N, &N_plot, &time_plot); // Structure of initial data array pointer.
     /* 
      * (m) is the number of initial value as well as the number of grids.
      * As (m) is frequently use to represent the number of grids,
      * we do not use the name such as num_cell here to correspond to
      * notation in the math theory.
      */
-  const int m = (int)config[3];
-  const double h = config[10], gamma = config[6];
-  const int order = (int)config[9];
+  const int M = (int)ctx->conf[3]; // the whole grids
+  int part[2]; // the part of the grids of this process {j0, m}
+  if((retval = halo_part_init_1D(ctx, M, part)))
+      exit(retval);
+  const int m = part[1];
+  const double h = ctx->conf[10], gamma = ctx->conf[6];
+  const int order = (int)ctx->conf[9];
+  // the framework of the output folder of the telemetry
+  ctx->conf[8] = (double)(strcmp(argv[4],"LAG") == 0 ? 1 : strcmp(argv[4],"ALE") == 0 ? 2 : 0);
+  char problem[FILENAME_MAX+40]; // the output folder of the numerical results of the part
+  if(halo_size_1D() > 1)
+      {
+	  sprintf(problem, "%.*s/rank_%d", FILENAME_MAX, argv[2], halo_rank_1D());
+	  if((int)ctx->conf[8] != 1 || order != 2 || (int)ctx->conf[80] > 0 || (int)ctx->conf[37] > 0)
+	      {
+		  printf("The grids decomposed into parts are only solved by the second-order Lagrangian GRP scheme!\n");
+		  exit(4);
+	      }
+	  for(j = 0; j < m; ++j) // The initial data of the part is moved to the front.
+	      {
+		  FV0.RHO[j] = FV0.RHO[part[0]+j];
+		  FV0.U[j]   =   FV0.U[part[0]+j];
+		  FV0.P[j]   =   FV0.P[part[0]+j];
+	      }
+	  for(k = 0; FV0.Y != NULL && k < (int)ctx->conf[71]; ++k)
+	      memmove(FV0.Y + (size_t)k*FV0.n_Y, FV0.Y + (size_t)k*FV0.n_Y + part[0], m * sizeof(double));
+	  if(halo_rank_1D()) // The messages of the other processes are written into the logs of their parts.
+	      {
+		  char add_log[FILENAME_MAX+80];
+		  example_io(ctx, problem, add_log, 0);
+		  strcat(add_log, "log.txt");
+		  if(freopen(add_log, "w", stdout) == NULL)
+		      exit(1);
+	      }
+      }
+  else
+      strcpy(problem, argv[2]);
+  if(FV0.Y != NULL && (int)ctx->conf[8] != 1)
+      {
+	  printf("The advected species (71) are only carried by the Lagrangian cells!\n");
+	  exit(4);
+      }
+  telemetry_open_io(ctx, argv[2], halo_rank_1D());
+  // Streaming output keeps only the current level of fluid variables in memory.
+  const _Bool stream = (_Bool)ctx->conf[34];
+  if (stream)
+      N = 1;
+  else
+      N_plot = N;
 
   // Structure of fluid variables in computational cells array pointer.
   struct cell_var_stru CV = {NULL};
   double ** X = NULL;
-  double * cpu_time = (double *)malloc(N * sizeof(double));
+  double * cpu_time = (double *)calloc(N, sizeof(double));
   X = (double **)malloc(N * sizeof(double *));
   if(cpu_time == NULL)
       {
@@ -230,66 +749,63 @@ int main(int argc, char *argv[])
   }
   // Initialize the values of energy in computational cells and x-coordinate of the cell interfaces.
   for(j = 0; j <= m; ++j)
-      X[0][j] = h * j;
+      X[0][j] = h * (part[0] + j);
   for(j = 0; j < m; ++j)
       CV.E[0][j] = 0.5*CV.U[0][j]*CV.U[0][j] + CV.P[0][j]/(gamma - 1.0)/CV.RHO[0][j];
 
-  if (strcmp(argv[4],"LAG") == 0) // Use GRP/Godunov scheme to solve it on Lagrangian coordinate.
+  retval = hydrocode_1D_solve(ctx, argv[4], order, m, CV, X, cpu_time, problem, N, &N_plot, time_plot);
+  if(retval)
+      goto return_NULL;
+
+  // Write the final data down.
+  PHASE_TIC(PT_IO);
+  if (stream)
+      file_1D_write_stream(ctx, m, N_plot-1, CV, 0, X[0], cpu_time, problem, time_plot[N_plot-1]);
+  else
       {
-	  config[8] = (double)1;
-	  switch(order)
-	      {
-	      case 1:
-		  Godunov_solver_LAG_source(m, CV, X, cpu_time, &N, time_plot);
-		  break;
-	      case 2:
-		  GRP_solver_LAG_source(m, CV, X, cpu_time, &N, time_plot);
-		  break;
-	      default:
-		  printf("NOT appropriate order of the scheme! The order is %d.\n", order);
-		  retval = 4;
-		  goto return_NULL;
- 	      }
+#ifndef NODATPLOT
+	  file_1D_write(ctx, m, N_plot, CV, X, cpu_time, problem, time_plot);
+#endif
+#ifdef HDF5PLOT
+	  file_1D_write_HDF5(ctx, m, N_plot, CV, X, cpu_time, problem, time_plot);
+#endif
       }
-  else if (strcmp(argv[4],"EUL") == 0) // Use GRP/Godunov scheme to solve it on Eulerian coordinate.
+#ifndef NODATPLOT
+  file_1D_write_species(ctx, m, N_plot, FV0, problem);
+#endif
+#ifdef HDF5PLOT
+  if(halo_size_1D() > 1 && halo_rank_1D() == 0) // The whole grids map the files of the parts.
       {
-	  config[8] = (double)0;
-	  for (k = 1; k < N; ++k)
-	      for (j = 0; j <= m; ++j)
-		  X[k][j] = X[0][j];
-	  switch(order)
+	  int * part_all = (int *)malloc(2 * halo_size_1D() * sizeof(int));
+	  if(part_all == NULL)
 	      {
-	      case 1:
-		  Godunov_solver_EUL_source(m, CV, cpu_time, &N, time_plot);
-		  break;
-	      case 2:
-		  GRP_solver_EUL_source(m, CV, cpu_time, &N, time_plot);
-		  break;
-	      default:
-		  printf("NOT appropriate order of the scheme! The order is %d.\n", order);
-		  retval = 4;
+		  printf("NOT enough memory! Parts\n");
+		  retval = 5;
 		  goto return_NULL;
 	      }
+	  for(k = 0; k < halo_size_1D(); ++k)
+	      halo_part_1D(k, part_all + 2*k);
+	  file_1D_write_HDF5_parts(ctx, M, N_plot, halo_size_1D(), part_all, stream ? NULL : cpu_time, argv[2], time_plot);
+	  free(part_all);
       }
-  else
-      {
-	  printf("NOT appropriate coordinate framework! The framework is %s.\n", argv[4]);
-	  retval = 4;
-	  goto return_NULL;
-      }
-
-  // Write the final data down.
-#ifndef NODATPLOT
-  file_1D_write(m, N, CV, X, cpu_time, argv[2], time_plot);
 #endif
-#ifdef HDF5PLOT
-  file_1D_write_HDF5(m, N, CV, X, cpu_time, argv[2], time_plot);
+  PHASE_TOC(PT_IO);
+#ifndef NOPHASETIMER
+  phase_timer_report();
+  Arena_workspace_report();
+  Riemann_exact_stat_report();
 #endif
+  if(halo_rank_1D() == 0)
+      {
+	  Riemann_exact_stat(&rs, 0);
+	  perf_report_write(ctx, argv[2], M, halo_size_1D(), &rs);
+      }
 
  return_NULL:
   free(FV0.RHO);
   free(FV0.U);
   free(FV0.P);
+  free(FV0.Y);
   FV0.RHO = NULL;
   FV0.U   = NULL;
   FV0.P   = NULL;
@@ -323,6 +839,12 @@ int main(int argc, char *argv[])
   X = NULL;
   free(cpu_time);
   cpu_time = NULL;
-  
+  telemetry_close();
+  Arena_workspace_dispose();
+  halo_part_free_1D();
+#ifdef MPI_1D
+  MPI_Finalize();
+#endif
+
   return retval;
 }
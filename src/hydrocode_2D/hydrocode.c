@@ -50,6 +50,8 @@
  * @section Usage_description Usage description
  *          - Input files are stored in folder 'data_in/two-dim/name_of_test_example/'.
  *          - Input files may be produced by MATLAB/Octave script 'value_start.m'.
+ *          - The initial data of a fluid variable (e.g. RHO) is read from the first one of 'RHO.bin' (raw little-endian doubles),
+ *            the dataset '/RHO' in 'FLU_VAR.h5' and the text files 'RHO.txt/.dat' (a binary file needs n_x in 'config.txt').
  *          - Description of configuration file 'config.txt/.dat' refers to 'doc/config.csv'.
  *          - Run program:
  *            - Linux/Unix: Run 'shell/hydrocode_run.sh' command on the terminal. \n
@@ -78,6 +80,32 @@
  *             <tr><th> OpenMP Support <td> (/openmp)
  *             </table>
  * 
+ *          - Checkpoint and restart a long run:
+ *            - Add '43=K' to write the binary file 'checkpoint.bin' in the output folder every K time steps.
+ *            - Run the same command with '44=1' to restart from the last checkpoint bit-for-bit.
+ * 
+ *          - Write many plotting times:
+ *            - Add '34=1' to append the data of each plotting time to the output files at once (streaming output),
+ *              so only the current fluid variables are kept in memory whatever the number of the plotting times.
+ *            - Add '83=1' (lossless) or '83=2 84=TOL' (error bound TOL) to keep the plotting times compressed in memory
+ *              instead, and write them into the output files at the end.
+ * 
+ *          - Run on the blocks of MPI processes:
+ *            - Compile with 'make CC=mpicc CFLAGD="-DHDF5PLOT -DMPI_2D"', and run 'mpirun -np P hydrocode.out …'.
+ *            - Each process writes the output files of its block into the folder 'rank_r/' of the numerical results,
+ *              and 'FLU_VAR.h5' of the whole grids maps the HDF5 files of the blocks.
+ * 
+ *          - Watch a run live:
+ *            - Add '87=T' to publish the current fields every T seconds of wall-clock time into the shared memory
+ *              '/dev/shm/hydrocode_<name_of_numeric_result>_r0' (with '88=S', every S-th cell), which an external
+ *              viewer maps without stopping the run; the layout is described in 'live_publish.c'.
+ * 
+ *          - Select the fields of the '.dat' and HDF5 output:
+ *            - Add '94=F' with F the sum of the bits of the fields (RHO = 1, U = 2, V = 4, P = 8, E = 16, e_int = 32, c = 64,
+ *              Ma = 128, S = 256, omega = 512), e.g. '94=649' for the density, the pressure, the Mach number and the vorticity
+ *              (Default: RHO, U, V, P and E).
+ *            - The derived fields are computed from the primitive variables when they are written, so they are never stored.
+ * 
  *          - Output files can be found in folder 'data_out/two-dim/'.
  *          - Output files may be visualized by MATLAB/Octave script 'value_plot.m'.
  * 
@@ -85,6 +113,8 @@
  *          - NODATPLOT: in hydrocode.c. (Default: undef)
  *          - NOTECPLOT: in hydrocode.c. (Default: undef)
  *          - HDF5PLOT:  in hydrocode.c. (Default: undef)
+ *          - PERFCOUNTER: in phase_timer.c and perf_counter.c, hardware counters of the phases (Linux perf_event). (Default: undef)
+ *          - MPI_2D:    in hydrocode.c and halo_exchange_2D.c. (Default: undef)
  *          - EXACT_TANGENT_DERIVATIVE: in linear_GRP_solver_Edir_G2D.c.   (Default: undef)
  *          - Riemann_solver_exact_single: in riemann_solver.h.            (Default: Riemann_solver_exact_Ben)
  *          - MULTIFLUID_BASICS: 'Switch whether to compute multi-fluids.' (Default: undef)
@@ -96,10 +126,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#ifdef MPI_2D
+#include <mpi.h>
+#endif
 
 #include "../include/var_struc.h"
 #include "../include/file_io.h"
 #include "../include/finite_volume.h"
+#include "../include/riemann_solver.h"
+#include "../include/inter_process.h"
+#include "../include/tools.h"
 
 
 #ifdef DOXYGEN_PREDEFINED
@@ -118,34 +154,30 @@
  * @brief Switch whether to plot without Tecplot data.
  */
 #define NOTECPLOT
+/**
+ * @def MPI_2D
+ * @brief Switch whether to decompose the grids into blocks of the MPI processes.
+ */
+#define MPI_2D
 #endif
 
-double config[N_CONF]; //!< Initial configuration data array.
+struct run_ctx run_ctx_global; //!< Run context of the process.
 
 /**
  * @brief N memory allocations to the initial fluid variable 'v' in the structure cell_var_stru.
+ * @details Each field is one aligned memory block with the row pointers CV[k].v[j], accounted to the snapshots.
  */
 #define CV_INIT_MEM(v, N)						\
     do {								\
     for(k = 0; k < N; ++k)						\
 	{								\
-	    CV[k].v = (double **)malloc(n_x * sizeof(double *));	\
+	    CV[k].v = (double **)field_alloc_2D(n_x, n_y, sizeof(double), MA_SNAPSHOT, #v); \
 	    if(CV[k].v == NULL)						\
 		{							\
 		    printf("NOT enough memory! CV[%d].%s\n", k, #v);	\
 		    retval = 5;						\
 		    goto return_NULL;					\
 		}							\
-	    for(j = 0; j < n_x; ++j)					\
-		{							\
-		    CV[k].v[j] = (double *)malloc(n_y * sizeof(double)); \
-		    if(CV[k].v[j] == NULL)				\
-			{						\
-			    printf("NOT enough memory! CV[%d].%s[%d]\n", k, #v, j); \
-			    retval = 5;					\
-			    goto return_NULL;				\
-			}						\
-		}							\
 	}								\
     } while (0)
 
@@ -163,12 +195,16 @@ double config[N_CONF]; //!< Initial configuration data array.
  */
 int main(int argc, char *argv[])
 {
+#ifdef MPI_2D
+  MPI_Init(&argc, &argv);
+#endif
   int k, i, j, retval = 0;
+  struct riemann_stat rs; // statistics of the exact Riemann solvers of the performance report
   // Initialize configuration data array
   for(k = 1; k < N_CONF; k++)
       config[k] = INFINITY;
   char * scheme = NULL; // Riemann_exact(Godunov), GRP
-  arg_preprocess(4, argc, argv, scheme);
+  arg_preprocess(&run_ctx_global, 4, argc, argv, scheme);
 
   // Set dimension.
   config[0] = (double)2; // Dimensionality = 2
@@ -182,22 +218,65 @@ int main(int argc, char *argv[])
      * of a block of memory consisting (n_x*n_y) variables of type double.
      * The (n_x*n_y) array elements of these variables are the initial value.
      */
-  struct flu_var FV0 = initialize_2D(argv[1], &N, &N_plot, &time_plot); // Structure of initial data array pointer.
+  struct flu_var FV0 = initialize_2D(&run_ctx_global, argv[1], &N, &N_plot, &time_plot); // Structure of initial data array pointer.
+  if(FV0.Y != NULL)
+      {
+	  printf("The advected species (71) are not solved on the structured grids!\n");
+	  exit(4);
+      }
+  warm_start(&run_ctx_global, argv[1], &FV0, NULL, &N_plot, time_plot); // the coarse solution of the 'warm' row
+  thread_place((int)config[81], (int)config[82]); // the threads pinned before the fields are first touched
     /* 
      * (n_x*n_y) is the number of initial value as well as the number of grids.
      * As (n_x*n_y) is frequently use to represent the number of grids,
      * we do not use the name such as num_cell here to correspond to
      * notation in the math theory.
      */
-  const int n_x = (int)config[13], n_y = (int)config[14];
+  const int n_X = (int)config[13], n_Y = (int)config[14]; // the whole grids
+  int blk[4]; // the block of the grids of this process {j0, i0, n_x, n_y}
+  if((retval = halo_block_init_2D(&run_ctx_global, n_X, n_Y, blk)))
+      exit(retval);
+  const int n_x = blk[2], n_y = blk[3];
+  const long xy_bytes = 2L * (n_x+1) * (long)((n_y+1) * sizeof(double) + sizeof(double *)); // bytes of the coordinates X and Y
+  char problem[FILENAME_MAX+40]; // the output folder of the numerical results of the block
+  if(halo_size_2D() > 1)
+      sprintf(problem, "%.*s/rank_%d", FILENAME_MAX, argv[2], halo_rank_2D());
+  else
+      strcpy(problem, argv[2]);
   const double h_x = config[10], h_y = config[11], gamma = config[6];
   const int order = (int)config[9];
   const _Bool dim_split = (_Bool)config[33]; // Dimensional splitting?
+  // Streaming output writes each plotting time at once and keeps only the current level of fluid variables in memory.
+  const _Bool stream = (_Bool)config[34];
+  if (stream)
+      N = 1;
+
+  if((_Bool)config[65]) // Predict the memory footprint of the fields without running.
+      {
+	  mem_account(MA_SNAPSHOT, "RHO", N * field_bytes_2D(n_x, n_y, sizeof(double)));
+	  mem_account(MA_SNAPSHOT, "U",   N * field_bytes_2D(n_x, n_y, sizeof(double)));
+	  mem_account(MA_SNAPSHOT, "V",   N * field_bytes_2D(n_x, n_y, sizeof(double)));
+	  mem_account(MA_SNAPSHOT, "P",   N * field_bytes_2D(n_x, n_y, sizeof(double)));
+	  mem_account(MA_SNAPSHOT, "E",   N * field_bytes_2D(n_x, n_y, sizeof(double)));
+	  mem_account(MA_MESH, "X, Y", xy_bytes);
+	  GRP_solver_2D_mem(n_x, n_y);
+	  mem_account_report("Predicted memory", 1);
+	  free(FV0.RHO);
+	  free(FV0.U);
+	  free(FV0.V);
+	  free(FV0.P);
+	  halo_block_free_2D();
+#ifdef MPI_2D
+	  MPI_Finalize();
+#endif
+	  return 0;
+      }
+  telemetry_open_io(&run_ctx_global, argv[2], halo_rank_2D());
 
   // Structure of fluid variables in computational cells array pointer.
   struct cell_var_stru * CV = (struct cell_var_stru*)malloc(N * sizeof(struct cell_var_stru));
   double ** X, ** Y;
-  double * cpu_time = (double *)malloc(N * sizeof(double));
+  double * cpu_time = (double *)calloc(N, sizeof(double));
   X = (double **)malloc((n_x+1) * sizeof(double *));
   Y = (double **)malloc((n_x+1) * sizeof(double *));
   if(cpu_time == NULL)
@@ -223,6 +302,7 @@ int main(int argc, char *argv[])
       goto return_NULL;
     }
   }
+  mem_account(MA_MESH, "X, Y", xy_bytes);
   if(CV == NULL)
       {
 	  printf("NOT enough memory! Cell Variables\n");
@@ -235,20 +315,25 @@ int main(int argc, char *argv[])
   CV_INIT_MEM(V, N);
   CV_INIT_MEM(P, N);
   CV_INIT_MEM(E, N);
-  // Initialize the values of energy in computational cells and (x,y)-coordinate of the cell interfaces.
+  /*
+   * Initialize the values of energy in computational cells and (x,y)-coordinate of the cell interfaces.
+   * The rows are filled with the static decomposition of the loops of the schemes, which first touch the pages of X and Y.
+   */
+#pragma omp parallel for private(i) schedule(static)
   for(j = 0; j <= n_x; ++j)
       for(i = 0; i <= n_y; ++i)	
 	  {
-	      X[j][i] = j * h_x;
-	      Y[j][i] = i * h_y;
+	      X[j][i] = (blk[0] + j) * h_x;
+	      Y[j][i] = (blk[1] + i) * h_y;
 	  }
+#pragma omp parallel for private(i) schedule(static)
   for(j = 0; j < n_x; ++j)
       for(i = 0; i < n_y; ++i)	
 	  {
-	      CV[0].RHO[j][i] = FV0.RHO[i*n_x + j];
-	      CV[0].U[j][i]   = FV0.U[i*n_x + j];
-	      CV[0].V[j][i]   = FV0.V[i*n_x + j];
-	      CV[0].P[j][i]   = FV0.P[i*n_x + j];
+	      CV[0].RHO[j][i] = FV0.RHO[(blk[1]+i)*n_X + blk[0]+j];
+	      CV[0].U[j][i]   =   FV0.U[(blk[1]+i)*n_X + blk[0]+j];
+	      CV[0].V[j][i]   =   FV0.V[(blk[1]+i)*n_X + blk[0]+j];
+	      CV[0].P[j][i]   =   FV0.P[(blk[1]+i)*n_X + blk[0]+j];
 	      CV[0].E[j][i]   = 0.5*CV[0].U[j][i]*CV[0].U[j][i] + CV[0].P[j][i]/(gamma - 1.0)/CV[0].RHO[j][i];
 	      CV[0].E[j][i]  += 0.5*CV[0].V[j][i]*CV[0].V[j][i];
 	  }
@@ -256,15 +341,26 @@ int main(int argc, char *argv[])
   if (strcmp(argv[4],"EUL") == 0) // Use GRP/Godunov scheme to solve it on Eulerian coordinate.
       {
 	  config[8] = (double)0;
+	  if(halo_rank_2D()) // The messages of the other processes are written into the logs of their blocks.
+	      {
+		  char add_log[FILENAME_MAX+80];
+		  example_io(&run_ctx_global, problem, add_log, 0);
+		  strcat(add_log, "log.txt");
+		  if(freopen(add_log, "w", stdout) == NULL)
+		      {
+			  retval = 1;
+			  goto return_NULL;
+		      }
+	      }
 	  switch(order)
 	      {
 	      case 1:
 		  config[41] = 0.0; // alpha = 0.0
 	      case 2:
 		  if (dim_split)
-		      GRP_solver_2D_split_EUL_source(n_x, n_y, CV, X, Y, cpu_time, argv[2], N, &N_plot, time_plot);
+		      GRP_solver_2D_split_EUL_source(&run_ctx_global, n_x, n_y, CV, X, Y, cpu_time, problem, N, &N_plot, time_plot);
 		  else
-		      GRP_solver_2D_EUL_source(n_x, n_y, CV, X, Y, cpu_time, argv[2], N, &N_plot, time_plot);
+		      GRP_solver_2D_EUL_source(&run_ctx_global, n_x, n_y, CV, X, Y, cpu_time, problem, N, &N_plot, time_plot);
 		  break;
 	      default:
 		  printf("NOT appropriate order of the scheme! The order is %d.\n", order);
@@ -280,15 +376,48 @@ int main(int argc, char *argv[])
       }
 
   // Write the final data down.
+  PHASE_TIC(PT_IO);
+  if (stream)
+      file_2D_write_stream(&run_ctx_global, n_x, n_y, N_plot-1, CV, X, Y, cpu_time, problem, time_plot[N_plot-1]);
+  else
+      {
 #ifndef NODATPLOT
-  file_2D_write(n_x, n_y, N_plot, CV, X, Y, cpu_time, argv[2], time_plot);
+	  file_2D_write(&run_ctx_global, n_x, n_y, N_plot, CV, X, Y, cpu_time, problem, time_plot);
 #endif
 #ifdef HDF5PLOT
-  file_2D_write_HDF5(n_x, n_y, N_plot, CV, X, Y, cpu_time, argv[2], time_plot);
+	  file_2D_write_HDF5(&run_ctx_global, n_x, n_y, N_plot, CV, X, Y, cpu_time, problem, time_plot);
+#endif
+      }
+#ifdef HDF5PLOT
+  if(halo_size_2D() > 1 && halo_rank_2D() == 0) // The whole grids map the files of the blocks.
+      {
+	  int * blk_all = (int *)malloc(4 * halo_size_2D() * sizeof(int));
+	  if(blk_all == NULL)
+	      {
+		  printf("NOT enough memory! Blocks\n");
+		  retval = 5;
+		  goto return_NULL;
+	      }
+	  for(k = 0; k < halo_size_2D(); ++k)
+	      halo_block_2D(k, blk_all + 4*k);
+	  file_2D_write_HDF5_blocks(&run_ctx_global, n_X, n_Y, N_plot, halo_size_2D(), blk_all, stream ? NULL : cpu_time, argv[2], time_plot);
+	  free(blk_all);
+      }
 #endif
 #ifndef NOTECPLOT
-  file_2D_write_POINT_TEC(n_x, n_y, 1, CV + N_plot-1, X, Y, cpu_time, argv[2], time_plot + N_plot-1);
+  file_2D_write_POINT_TEC(&run_ctx_global, n_x, n_y, 1, CV + (stream ? 0 : N_plot-1), X, Y, cpu_time, problem, time_plot + N_plot-1);
 #endif
+  PHASE_TOC(PT_IO);
+#ifndef NOPHASETIMER
+  phase_timer_report();
+  Riemann_exact_stat_report();
+#endif
+  if(halo_rank_2D() == 0)
+      {
+	  Riemann_exact_stat(&rs, 0);
+	  perf_report_write(&run_ctx_global, argv[2], (long)n_X*n_Y, halo_size_2D(), &rs);
+      }
+  mem_account_report("Memory", 1);
 
  return_NULL:
   free(FV0.RHO);
@@ -301,24 +430,11 @@ int main(int argc, char *argv[])
   FV0.P   = NULL;
   for(k = 0; k < N; ++k)
   {
-    for(j = 0; j < n_x; ++j)
-	{
-            free(CV[k].RHO[j]);
-            free(CV[k].U[j]);
-            free(CV[k].V[j]);
-            free(CV[k].P[j]);
-            free(CV[k].E[j]);
-            CV[k].RHO[j] = NULL;
-            CV[k].U[j]   = NULL;
-            CV[k].V[j]   = NULL;
-            CV[k].P[j]   = NULL;
-            CV[k].E[j]   = NULL;
-	}
-    free(CV[k].RHO);
-    free(CV[k].U);
-    free(CV[k].V);
-    free(CV[k].P);
-    free(CV[k].E);
+    field_free_2D(CV[k].RHO, n_x);
+    field_free_2D(CV[k].U,   n_x);
+    field_free_2D(CV[k].V,   n_x);
+    field_free_2D(CV[k].P,   n_x);
+    field_free_2D(CV[k].E,   n_x);
     CV[k].RHO = NULL;
     CV[k].U   = NULL;
     CV[k].V   = NULL;
@@ -338,8 +454,14 @@ int main(int argc, char *argv[])
   free(Y);
   X = NULL;
   Y = NULL; 
+  mem_account(MA_MESH, "X, Y", -xy_bytes);
   free(cpu_time);
   cpu_time = NULL;
+  telemetry_close();
+  halo_block_free_2D();
+#ifdef MPI_2D
+  MPI_Finalize();
+#endif
   
   return retval;
 }
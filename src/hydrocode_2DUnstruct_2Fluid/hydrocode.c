@@ -55,6 +55,11 @@
  *          - Input files are stored in folder 'data_in/two-dim/name_of_test_example/'.
  *          - Input files may be produced by MATLAB/Octave script 'value_start.m'.
  *          - Description of configuration file 'config.txt/.dat' refers to 'doc/config.csv'.
+ *          - The mass fractions of the K = '71' passively advected species are read from 'Y_1', …, 'Y_K' of the input folder,
+ *            and written as the cell data 'Y_1', …, 'Y_K' of the '.vtu' files.
+ *          - Mesh files 'mesh.msh' of Gmsh in the format 2.2 (ASCII) or 4.1 (ASCII or binary) are read from the input folder.
+ *            With '55=1', the mesh read and the geometry of its cells are kept in 'mesh.msh.cache', which is loaded at once
+ *            by the later runs while it is newer than 'mesh.msh'.
  *          - Run program:
  *            - Linux/Unix: Run 'shell/hydrocode_run.sh' command on the terminal. \n
  *                          The details are as follows: \n
@@ -83,13 +88,29 @@
  *             <tr><th> OpenMP Support <td> (/openmp)
  *             </table>
  * 
+ *          - Watch a run live:
+ *            - Add '87=T' to publish the current fields every T seconds of wall-clock time into the shared memory
+ *              '/dev/shm/hydrocode_<name_of_numeric_result>_r0' (with '88=S', every S-th cell), which an external
+ *              viewer maps without stopping the run; the layout is described in 'live_publish.c'.
+ * 
  *          - Output files can be found in folder 'data_out/two-dim/'.
+ *          - The '.vtu' files of all the plotting times are listed in 'FLU_VAR.pvd', which may be opened in ParaView.
+ * 
+ *          - Run on the parts of MPI processes:
+ *            - Compile with 'make CC=mpicc CFLAGD="-DMULTIFLUID_BASICS -DMPI_UNSTRUCT"', and run 'mpirun -np P hydrocode.out …'.
+ *            - The grids are split along the order of the cells given by '52' (reverse Cuthill–McKee by default).
+ *            - Each process writes the output files of its part into the folder 'rank_r/' of the numerical results,
+ *              and 'FLU_VAR_t.pvtu' of the whole grids lists the '.vtu' pieces of the parts ('FLU_VAR.pvd' lists these files).
  *          - Output files may be visualized by MATLAB/Octave script 'value_plot.m'.
  * 
  * @section Precompiler_options Precompiler options
  *          - NODATPLOT: in hydrocode.c. (Default: undef)
  *          - NOVTKPLOT: in hydrocode.c. (Default: undef)
  *          - NOTECPLOT: in hydrocode.c. (Default: undef)
+ *          - NOVTUPLOT: in hydrocode.c and finite_volume_scheme_unstruct.c. (Default: undef)
+ *          - VTUZLIB:   in file_2D_unstruct_out.c, zlib compression of the VTU output (link with -lz). (Default: undef)
+ *          - PERFCOUNTER: in phase_timer.c and perf_counter.c, hardware counters of the phases (Linux perf_event). (Default: undef)
+ *          - MPI_UNSTRUCT: in hydrocode.c and halo_exchange_unstruct.c. (Default: undef)
  *          - EXACT_TANGENT_DERIVATIVE: in linear_GRP_solver_Edir_G2D.c. (Default: undef)
  *          - Riemann_solver_exact_single: in riemann_solver.h.          (Default: Riemann_solver_exact_Ben)
  *          - MULTIFLUID_BASICS: in var_struc.h.                         (Default: def)
@@ -101,11 +122,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#ifdef MPI_UNSTRUCT
+#include <mpi.h>
+#endif
 
 #include "../include/var_struc.h"
 #include "../include/file_io.h"
 #include "../include/meshing.h"
 #include "../include/finite_volume.h"
+#include "../include/riemann_solver.h"
+#include "../include/inter_process_unstruct.h"
+#include "../include/tools.h"
+#include "../include_cii/arena.h"
 
 
 #ifdef DOXYGEN_PREDEFINED
@@ -124,9 +152,19 @@
  * @brief Switch whether to plot without VTK data.
  */
 #define NOVTKPLOT
+/**
+ * @def NOVTUPLOT
+ * @brief Switch whether to plot without VTK XML data and its '.pvd' time series.
+ */
+#define NOVTUPLOT
+/**
+ * @def MPI_UNSTRUCT
+ * @brief Switch whether to partition the grids into parts of the MPI processes.
+ */
+#define MPI_UNSTRUCT
 #endif
 
-double config[N_CONF]; //!< Initial configuration data array.
+struct run_ctx run_ctx_global; //!< Run context of the process.
 
 /**
  * @brief This is the main function which constructs the
@@ -142,12 +180,19 @@ double config[N_CONF]; //!< Initial configuration data array.
  */
 int main(int argc, char *argv[])
 {
+#ifdef MPI_UNSTRUCT
+  MPI_Init(&argc, &argv);
+#endif
   int k, retval = 0;
+  struct riemann_stat rs; // statistics of the exact Riemann solvers of the performance report
   // Initialize configuration data array
   for(k = 1; k < N_CONF; k++)
       config[k] = INFINITY;
   char * scheme = NULL; // Riemann_exact(Godunov), GRP
-  arg_preprocess(4, argc, argv, scheme);
+  arg_preprocess(&run_ctx_global, 4, argc, argv, scheme);
+  // The scheme name follows the order in argv[3] (e.g. '1_Roe').
+  scheme = strchr(argv[3], '_');
+  scheme = scheme ? scheme + 1 : argv[3] + strlen(argv[3]);
 
   // Set dimension.
   config[0] = (double)2; // Dimensionality = 2
@@ -161,31 +206,84 @@ int main(int argc, char *argv[])
      * of a block of memory consisting (num_cell) variables of type double.
      * The (num_cell) array elements of these variables are the initial value.
      */
-  struct flu_var FV0 = initialize_2D(argv[1], &N, &N_plot, &time_plot);
+  { // The mesh file and the initial data files are read by the I/O threads of the kernel while the earlier ones are parsed.
+      char add_in[FILENAME_MAX+40], msh[FILENAME_MAX], msh_cache[FILENAME_MAX+10];
+      example_io(&run_ctx_global, argv[1], add_in, 1);
+      snprintf(msh, sizeof(msh), "%s.msh", argv[4]);
+      snprintf(msh_cache, sizeof(msh_cache), "%s.msh.cache", argv[4]);
+      const char * const name[] = {msh_cache, msh, "RHO", "U", "V", "P", "PHI", "Z_a", "gamma"};
+      file_prefetch(add_in, name, (int)(sizeof(name)/sizeof(name[0])));
+  }
+  struct flu_var FV0 = initialize_2D(&run_ctx_global, argv[1], &N, &N_plot, &time_plot);
+  thread_place((int)config[81], (int)config[82]); // the threads pinned before the cells are first touched
   struct mesh_var mv = mesh_init(argv[1], argv[4]);
+  warm_start(&run_ctx_global, argv[1], &FV0, &mv, &N_plot, time_plot); // the coarse solution of the 'warm' row
+  mesh_reorder(&mv, &FV0, (int)config[52]);
+  const long n_cell_all = (long)config[3]; // the cells of the whole grids
+  if ((retval = halo_part_init_unstruct(&mv, &FV0)))
+      exit(retval);
+  char problem[FILENAME_MAX+40]; // the output folder of the numerical results of the part
+  if (halo_size_unstruct() > 1)
+      sprintf(problem, "%.*s/rank_%d", FILENAME_MAX, argv[2], halo_rank_unstruct());
+  else
+      strcpy(problem, argv[2]);
+  if (halo_rank_unstruct()) // The messages of the other processes are written into the logs of their parts.
+      {
+	  char add_log[FILENAME_MAX+80];
+	  example_io(&run_ctx_global, problem, add_log, 0);
+	  strcat(add_log, "log.txt");
+	  if (freopen(add_log, "w", stdout) == NULL)
+	      exit(1);
+      }
+#ifndef NOVTUPLOT
+  else if (halo_size_unstruct() > 1) // The whole grids list the pieces of the parts.
+      file_write_2D_PVTU_init(argv[2], halo_size_unstruct());
+#endif
+  telemetry_open_io(&run_ctx_global, argv[2], halo_rank_unstruct());
 
   if ((_Bool)config[32])
       {
 #ifndef NOTECPLOT
-	  file_write_2D_BLOCK_TEC(FV0, mv, argv[2], 0.0);
+	  file_write_2D_BLOCK_TEC(FV0, mv, problem, time_plot[0]);
 #endif
 #ifndef NOVTKPLOT
-	  file_write_3D_VTK(FV0, mv, argv[2], 0.0);
+	  file_write_3D_VTK(FV0, mv, problem, time_plot[0]);
+#endif
+#ifndef NOVTUPLOT
+	  file_write_2D_VTU(FV0, mv, problem, time_plot[0]);
 #endif
       }
 
   config[8] = (double)0;  // Use GRP/Godunov scheme to solve it on Eulerian coordinate.
-  finite_volume_scheme_unstruct(&FV0, &mv, scheme, argv[2], &N_plot, time_plot);
+  finite_volume_scheme_unstruct(&FV0, &mv, scheme, problem, &N_plot, time_plot);
 
   // Write the final data down.
+  PHASE_TIC(PT_IO);
 #ifndef NOTECPLOT
-  file_write_2D_BLOCK_TEC(FV0, mv, argv[2], time_plot[N_plot-1]);
+  file_write_2D_BLOCK_TEC(FV0, mv, problem, time_plot[N_plot-1]);
 #endif
 #ifndef NOVTKPLOT
-  file_write_3D_VTK(FV0, mv, argv[2], time_plot[N_plot-1]);
+  file_write_3D_VTK(FV0, mv, problem, time_plot[N_plot-1]);
+#endif
+#ifndef NOVTUPLOT
+  file_write_2D_VTU(FV0, mv, problem, time_plot[N_plot-1]);
+  file_write_2D_VTU_free();
+#endif
+  PHASE_TOC(PT_IO);
+#ifndef NOPHASETIMER
+  phase_timer_report();
+  Arena_workspace_report();
+  Riemann_exact_stat_report();
 #endif
+  if (halo_rank_unstruct() == 0)
+      {
+	  Riemann_exact_stat(&rs, 0);
+	  perf_report_write(&run_ctx_global, argv[2], n_cell_all, halo_size_unstruct(), &rs);
+      }
+  mem_account_report("Memory", 1);
 
   mesh_mem_free(&mv);
+  halo_part_free_unstruct();
 
   free(FV0.RHO);
   free(FV0.U);
@@ -195,6 +293,8 @@ int main(int argc, char *argv[])
   FV0.U   = NULL;
   FV0.V   = NULL;
   FV0.P   = NULL;
+  free(FV0.Y);
+  FV0.Y   = NULL;
 #ifdef MULTIFLUID_BASICS
   free(FV0.Z_a);
   free(FV0.PHI);
@@ -204,5 +304,11 @@ int main(int argc, char *argv[])
   FV0.gamma = NULL;
 #endif
 
+  telemetry_close();
+  Arena_workspace_dispose();
+
+#ifdef MPI_UNSTRUCT
+  MPI_Finalize();
+#endif
   return retval;
 }
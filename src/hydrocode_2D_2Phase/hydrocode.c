@@ -115,7 +115,7 @@
 #define NOTECPLOT
 #endif
 
-double config[N_CONF]; //!< Initial configuration data array.
+struct run_ctx run_ctx_global; //!< Run context of the process.
 
 /**
  * @brief This is the main function which constructs the
@@ -136,7 +136,7 @@ int main(int argc, char *argv[])
   for(k = 1; k < N_CONF; k++)
       config[k] = INFINITY;
   char * scheme = NULL; // Riemann_exact(Godunov), GRP
-  arg_preprocess(4, argc, argv, scheme);
+  arg_preprocess(&run_ctx_global, 4, argc, argv, scheme);
 
   // Set dimension.
   config[0] = (double)2; // Dimensionality = 2
@@ -150,7 +150,7 @@ int main(int argc, char *argv[])
      * of a block of memory consisting (n_x*n_y) variables of type double.
      * The (n_x*n_y) array elements of these variables are the initial value.
      */
-  struct flu_var FV0 = initialize_2D(argv[1], &N, &N_plot, &time_plot);
+  struct flu_var FV0 = initialize_2D(&run_ctx_global, argv[1], &N, &N_plot, &time_plot);
   struct mesh_var mv = mesh_init(argv[1], argv[4]);
 
   if ((_Bool)config[32])
@@ -79,6 +79,15 @@
  *             <tr><th> Subsystem <td> (/SUBSYSTEM:CONSOLE)
  *             </table>
  * 
+ *          - Watch a run live:
+ *            - Add '87=T' to publish the current fields every T seconds of wall-clock time into the shared memory
+ *              '/dev/shm/hydrocode_<name_of_numeric_result>_r0' (with '88=S', every S-th cell), which an external
+ *              viewer maps without stopping the run; the layout is described in 'live_publish.c'.
+ * 
+ *          - Rezone the compressed cells:
+ *            - Add '90=0.1' to rezone the cells narrower than 0.1 of the mean cell width conservatively
+ *              (near r = 0 and at the shell in A3_shell), so that they do not collapse the time step.
+ * 
  *          - Output files can be found in folder 'data_out/one-dim/Radial_Symmetry/'.
  *          - Output files may be visualized by MATLAB/Octave script 'value_plot.m'.
  * 
@@ -86,6 +95,7 @@
  *          - NODATPLOT: in hydrocode.c. (Default: undef)
  *          - NOTECPLOT: in hydrocode.c. (Default: undef)
  *          - HDF5PLOT:  in hydrocode.c. (Default: undef)
+ *          - PERFCOUNTER: in phase_timer.c and perf_counter.c, hardware counters of the phases (Linux perf_event). (Default: undef)
  *          - MULTIFLUID_BASICS: in var_struc.h. (Default: def)
  *          - RADIAL_BASICS:     in var_struc.h. (Default: def)
  */
@@ -97,9 +107,12 @@
 #include <math.h>
 
 #include "../include/var_struc.h"
+#include "../include/tools.h"
 #include "../include/file_io.h"
 #include "../include/finite_volume.h"
+#include "../include/riemann_solver.h"
 #include "../include/meshing.h"
+#include "../include_cii/arena.h"
 
 
 #ifdef DOXYGEN_PREDEFINED
@@ -120,7 +133,7 @@
 #define NOTECPLOT
 #endif
 
-double config[N_CONF]; //!< Initial configuration data array.
+struct run_ctx run_ctx_global; //!< Run context of the process.
 
 #define CV_INIT_FV_RESET_MEM(v, N)					\
     do {								\
@@ -164,12 +177,13 @@ double config[N_CONF]; //!< Initial configuration data array.
 int main(int argc, char *argv[])
 {
   int k, j, retval = 0;
+  struct riemann_stat rs; // statistics of the exact Riemann solvers of the performance report
   // Initialize configuration data array
   for(k = 1; k < N_CONF; k++)
       config[k] = INFINITY;
 
   char * scheme = NULL; // Riemann_exact(Godunov), GRP
-  arg_preprocess(4, argc, argv, scheme);
+  arg_preprocess(&run_ctx_global, 4, argc, argv, scheme);
 
   // Set dimension.
   config[0] = (double)1; // Dimension of input data = 1
@@ -183,7 +197,7 @@ int main(int argc, char *argv[])
    * of a block of memory consisting (Ncell) variables of type double.
    * The (Ncell) array elements of these variables are the initial value.
    */
-  struct flu_var FV0 = initialize_1D(argv[1], &N, &N_plot, &time_plot); // Structure of initial data array pointer.
+  struct flu_var FV0 = initialize_1D(&run_ctx_global, argv[1], &N, &N_plot, &time_plot); // Structure of initial data array pointer.
   const int Ncell = (int)config[3]; // Number of computing cells in r direction
   const int Md    = Ncell+2;        // Max vector dimension
   const int order = (int)config[9];
@@ -201,7 +215,7 @@ int main(int argc, char *argv[])
   // Structure of fluid variables in computational cells array pointer.
   struct cell_var_stru CV = {NULL};
   double ** R = NULL;
-  double * cpu_time = (double *)malloc(N * sizeof(double));
+  double * cpu_time = (double *)calloc(N, sizeof(double));
   R = (double **)malloc(N * sizeof(double *));
   if(cpu_time == NULL)
       {
@@ -229,6 +243,26 @@ int main(int argc, char *argv[])
   CV_INIT_FV_RESET_MEM(U, N);
   CV_INIT_FV_RESET_MEM(P, N);
   CV_INIT_FV_RESET_MEM(RHO, N);
+  if(FV0.Y != NULL) // The rows of the species are moved to the cells 1, …, Ncell of the stride Md, with the ghost cells.
+      {
+	  const int K = (int)config[71];
+	  double * Y = (double *)calloc((size_t)K * Md, sizeof(double));
+	  if(Y == NULL)
+	      {
+		  printf("NOT enough memory! Y\n");
+		  retval = 5;
+		  goto return_NULL;
+	      }
+	  for(k = 0; k < K; ++k)
+	      {
+		  memcpy(Y + (size_t)k*Md + 1, FV0.Y + (size_t)k*FV0.n_Y, Ncell * sizeof(double));
+		  Y[(size_t)k*Md]           = Y[(size_t)k*Md + 1];
+		  Y[(size_t)k*Md + Ncell+1] = Y[(size_t)k*Md + Ncell];
+	      }
+	  free(FV0.Y);
+	  FV0.Y   = Y;
+	  FV0.n_Y = Md;
+      }
 #ifdef MULTIFLUID_BASICS
   CV_INIT_FV_RESET_MEM(gamma, N);
   FV0.gamma = CV.gamma[0];
@@ -265,6 +299,7 @@ int main(int argc, char *argv[])
 
   // Use GRP/Godunov scheme to solve it on Lagrangian coordinate.
   config[8] = (double)1;
+  telemetry_open_io(&run_ctx_global, argv[2], 0);
   switch(order)
       {
       case 1:
@@ -279,11 +314,15 @@ int main(int argc, char *argv[])
       }
 
   memmove(R[N_plot-1], rmv.RR, (Ncell+1) * sizeof(double));
+  PHASE_TIC(PT_IO);
 #ifndef NODATPLOT
-  file_1D_write(Ncell+1, N_plot, CV, R, cpu_time, argv[2], time_plot);
+  file_1D_write(&run_ctx_global, Ncell+1, N_plot, CV, R, cpu_time, argv[2], time_plot);
+#endif
+#ifndef NODATPLOT
+  file_1D_write_species(&run_ctx_global, Ncell+1, N_plot, FV0, argv[2]);
 #endif
 #ifdef HDF5PLOT
-  file_1D_write_HDF5(Ncell+1, N_plot, CV, R, cpu_time, argv[2], time_plot);
+  file_1D_write_HDF5(&run_ctx_global, Ncell+1, N_plot, CV, R, cpu_time, argv[2], time_plot);
 #endif
 #ifndef NOTECPLOT
   FV0.RHO = CV.RHO[N_plot-1];
@@ -291,9 +330,19 @@ int main(int argc, char *argv[])
   FV0.P   = CV.P[N_plot-1];
   file_radial_write_TEC(FV0, rmv.RR, argv[2], time_plot[N_plot-1]);
 #endif
+  PHASE_TOC(PT_IO);
+#ifndef NOPHASETIMER
+  phase_timer_report();
+  Arena_workspace_report();
+  Riemann_exact_stat_report();
+#endif
+  Riemann_exact_stat(&rs, 0);
+  perf_report_write(&run_ctx_global, argv[2], Ncell, 1, &rs);
 
 return_NULL:
   radial_mesh_mem_free(&rmv);
+  free(FV0.Y);
+  FV0.Y     = NULL;
 
   FV0.RHO   = NULL;
   FV0.U     = NULL;
@@ -331,6 +380,8 @@ return_NULL:
   R = NULL;
   free(cpu_time);
   cpu_time = NULL;
+  telemetry_close();
+  Arena_workspace_dispose();
 
   return retval;
 }
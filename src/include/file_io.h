@@ -10,66 +10,167 @@
 //////////////////////////
 // io_control.c
 //////////////////////////
-void example_io(const char * example, char * add_mkdir, const int i_or_o);
+void example_io(const struct run_ctx * ctx, const char * example, char * add_mkdir, const int i_or_o);
+void telemetry_open_io(const struct run_ctx * ctx, const char * problem, const int rank);
 
-int flu_var_count     (FILE * fp, const char * add);
-int flu_var_count_line(FILE * fp, const char * add, int * n_x);
+int flu_var_count(FILE * fp, const char * add);
 
 int flu_var_read(FILE * fp, double * U, const int num);
 
-int time_plot_read(const char * add_in, const int N_max, int * N_plot, double * time_plot[]);
+void file_prefetch(const char * add_in, const char * const name[], const int n);
+
+int flu_var_load(const char * add_in, const char * name, double ** U, int * line, int * n_x, const _Bool by_line);
+
+int species_load(const struct run_ctx * ctx, const char * add_in, const int num_cell, const _Bool by_line, struct flu_var * FV);
+
+int double_to_str(char * s, const double x);
+
+int time_plot_read(struct run_ctx * ctx, const char * add_in, const int N_max, int * N_plot, double * time_plot[]);
 
 //////////////////////////
 // terminal_io.c
 //////////////////////////
-void arg_preprocess(const int argc_least, const int argc, char *argv[], char * scheme);
+void arg_preprocess(struct run_ctx * ctx, const int argc_least, const int argc, char *argv[], char * scheme);
 
 //////////////////////////
 // config_handle.c
 //////////////////////////
-void configurate(const char * name);
+void configurate(struct run_ctx * ctx, const char * name);
+void configurate_conf(struct run_ctx * ctx);
+
+void config_write(const struct run_ctx * ctx, const char * add_out, const double * cpu_time, const char * name);
 
-void config_write(const char * add_out, const double * cpu_time, const char * name);
+//////////////////////////
+// file_perf_out.c
+//////////////////////////
+void perf_report_write(const struct run_ctx * ctx, const char * problem, const long n_cell, const int n_rank, const struct riemann_stat * rs);
 
 //////////////////////////
 // file_1D_in.c
 //////////////////////////
-struct flu_var initialize_1D(const char * name, int * N, int * N_plot, double * time_plot[]);
+struct flu_var initialize_1D(struct run_ctx * ctx, const char * name, int * N, int * N_plot, double * time_plot[]);
+//////////////////////////
+// file_1D_ensemble.c
+//////////////////////////
+int  ensemble_1D_read (const char * add, struct ens_case ** EC, int * n_case, struct ens_member ** EM);
+void ensemble_1D_write(const char * results, const struct ens_case * EC, const struct ens_member * EM, const int n_member);
+//////////////////////////
+// file_checkpoint.c
+//////////////////////////
+int  checkpoint_init (const struct run_ctx * ctx, struct ckpt_var * cv, const char * problem);
+void checkpoint_add  (struct ckpt_var * cv, void * p, const long size);
+void checkpoint_add_1D(struct ckpt_var * cv, const int m, const int N_T, const struct cell_var_stru CV, double ** X);
+void checkpoint_add_2D(struct ckpt_var * cv, const int m, const int n, const int N_T, const struct cell_var_stru * CV);
+int  checkpoint_write(struct ckpt_var * cv);
+int  checkpoint_read (struct ckpt_var * cv);
+void checkpoint_free (struct ckpt_var * cv);
+//////////////////////////
+// file_init_gen.c
+//////////////////////////
+int init_gen(struct run_ctx * ctx, const char * add_in, const int dim, struct flu_var * FV0);
+//////////////////////////
+// file_warm_start.c
+//////////////////////////
+int  warm_start(struct run_ctx * ctx, const char * name, struct flu_var * FV0, const struct mesh_var * mv, int * N_plot, double time_plot[]);
+void warm_start_report(FILE * fp);
+//////////////////////////
+// file_snapshot.c
+//////////////////////////
+_Bool snap_store_put_1D  (const struct run_ctx * ctx, const int m, const int k, const struct cell_var_stru CV, const int nt,
+			  const double * X, const double time);
+_Bool snap_store_put_2D  (const struct run_ctx * ctx, const int n_x, const int n_y, const int k, const struct cell_var_stru * CV,
+			  const double time);
+int   snap_store_drain   (const _Bool on);
+int   snap_store_get     (const int k, double * x, double * time);
+void  snap_store_report  (FILE * fp);
 //////////////////////////
 // file_2D_in.c
 //////////////////////////
-struct flu_var initialize_2D(const char * name, int * N, int * N_plot, double * time_plot[]);
+struct flu_var initialize_2D(struct run_ctx * ctx, const char * name, int * N, int * N_plot, double * time_plot[]);
 
 //////////////////////////
 // file_1D_out.c
 //////////////////////////
-void file_1D_write          (const int m,                  const int N, const struct cell_var_stru CV, 
+void file_1D_write          (const struct run_ctx * ctx, const int m,                  const int N, const struct cell_var_stru CV, 
                     double * X[], const double * cpu_time, const char * problem, const double time_plot[]);
+void file_1D_write_stream   (const struct run_ctx * ctx, const int m, const int k, const struct cell_var_stru CV, const int nt,
+			  const double * X, const double * cpu_time, const char * problem, const double time);
+void file_1D_write_species  (const struct run_ctx * ctx, const int m, const int N, const struct flu_var FV, const char * problem);
+void file_1D_publish        (const struct run_ctx * ctx, const int m, const int k, const struct cell_var_stru CV, const int nt,
+			     const double * X, const double time);
 //////////////////////////
 // file_2D_out.c
 //////////////////////////
-void file_2D_write          (const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
+void file_2D_write          (const struct run_ctx * ctx, const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
 		    double ** X, double ** Y, const double * cpu_time, const char * problem, const double time_plot[]);
-void file_2D_write_POINT_TEC(const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
+void file_2D_write_POINT_TEC(const struct run_ctx * ctx, const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
 			double ** X, double ** Y, const double * cpu_time, const char * problem, const double time_plot[]);
+void file_2D_write_stream   (const struct run_ctx * ctx, const int n_x, const int n_y, const int k, const struct cell_var_stru * CV,
+			  double ** X, double ** Y, const double * cpu_time, const char * problem, const double time);
+void file_2D_publish        (const int n_x, const int n_y, const int k, const struct cell_var_stru * CV, const double time);
+
+//////////////////////////
+// file_out_field.c
+//////////////////////////
+//! Fields of the '.dat' and HDF5 output of the structured solutions, selected by the bits 1 << f of config[94].
+enum out_field {OUT_RHO, OUT_U, OUT_V, OUT_P, OUT_E, OUT_EINT, OUT_SOUND, OUT_MACH, OUT_ENTROPY, OUT_VORT, OUT_FIELD_N};
+extern const char * const out_field_name[OUT_FIELD_N];
+int    out_field_list(const struct run_ctx * ctx, const int dim, int * f);
+_Bool  out_field_on  (const struct run_ctx * ctx, const int f);
+void   out_field_1D  (const struct run_ctx * ctx, const int f, const int m, const struct cell_var_stru * CV, const int nt, double * v);
+double out_field_2D  (const struct run_ctx * ctx, const int f, const int n_x, const int n_y, const struct cell_var_stru * CV,
+		      double ** X, double ** Y, const int j, const int i);
 
 //////////////////////////
 // file_out_hdf5.c
 //////////////////////////
-void file_1D_write_HDF5(const int m, const int N, const struct cell_var_stru CV, 
+void file_1D_write_HDF5(const struct run_ctx * ctx, const int m, const int N, const struct cell_var_stru CV, 
 			double * X[], const double * cpu_time, const char * problem, double time_plot[]);
-void file_2D_write_HDF5(const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
+void file_1D_write_HDF5_parts(const struct run_ctx * ctx, const int M, const int N, const int num_p, const int * part,
+			      const double * cpu_time, const char * problem, double time_plot[]);
+void file_1D_write_HDF5_stream(const struct run_ctx * ctx, const int m, const int k, const struct cell_var_stru CV, const int nt,
+			       const double * X, const double * cpu_time, const char * problem, double time);
+void file_2D_write_HDF5(const struct run_ctx * ctx, const int n_x, const int n_y, const int N, const struct cell_var_stru CV[],
 			double ** X, double ** Y, const double * cpu_time, const char * problem, double time_plot[]);
+void file_2D_write_HDF5_stream(const struct run_ctx * ctx, const int n_x, const int n_y, const int k, const struct cell_var_stru * CV,
+			       double ** X, double ** Y, const double * cpu_time, const char * problem, double time);
+void file_2D_write_HDF5_blocks(const struct run_ctx * ctx, const int n_x, const int n_y, const int N, const int num_b, const int * blk,
+			       const double * cpu_time, const char * problem, double time_plot[]);
+
+//////////////////////////
+// file_tec_plt.c
+//////////////////////////
+//! Types of the binary Tecplot files: the whole data, the mesh only or the solution on a mesh loaded with it.
+enum tec_file_type {TEC_FULL, TEC_GRID, TEC_SOLUTION};
+//! Types of the zones of the binary Tecplot files.
+enum tec_zone_type {TEC_ORDERED = 0, TEC_FETRIANGLE = 2, TEC_FEQUADRILATERAL = 3};
+
+FILE * tec_plt_open(const char * file, const int file_type, const char * title, const int nv, const char * const var[]);
+void tec_plt_zone(FILE * fp, const char * name, const double time, const int zone_type,
+		  const int n_1, const int n_2, const int nv, const int loc[]);
+void tec_plt_eoh (FILE * fp);
+void tec_plt_data(FILE * fp, const int nv, const double * const v[], const long n[], const int share,
+		  const int con_share, const int * con, const long n_con);
 
 //////////////////////////
 // file_radial_out.c
 //////////////////////////
 void file_radial_write_TEC(const struct flu_var FV, const double * R, const char * problem, const double time);
+struct radial_mesh_var;
+void file_radial_write_diag(FILE ** out, const struct flu_var FV, const double * E, const double * mass,
+			    const struct radial_mesh_var * rmv, const char * problem, const int k, const double time);
 
 //////////////////////////
 // file_2D_unstruct_out.c
 //////////////////////////
 void file_write_2D_BLOCK_TEC(const struct flu_var FV, const struct mesh_var mv, const char * problem, const double time);
 void file_write_3D_VTK      (const struct flu_var FV, const struct mesh_var mv, const char * problem, const double time);
+void file_write_2D_VTU      (const struct flu_var FV, const struct mesh_var mv, const char * problem, const double time);
+void file_write_2D_VTU_free (void);
+void file_write_2D_PVTU_init(const char * problem, const int num_piece);
+int  file_2D_unstruct_async_init (struct out_queue * q, const struct mesh_var * mv, const char * problem, const int num_cell);
+void file_2D_unstruct_async_write(struct out_queue * q, const struct flu_var * FV, const double time, const int plot);
+void file_2D_unstruct_async_free (struct out_queue * q);
+void file_2D_unstruct_publish    (const struct flu_var * FV, const int num_cell, const int k, const double time);
 
 #endif
@@ -13,11 +13,86 @@
 //////////////////////////////////////
 // godunov_solver_LAG_source.c
 //////////////////////////////////////
-void Godunov_solver_LAG_source(const int m, struct cell_var_stru CV, double * X[], double * cpu_time, int * N_plot, double time_plot[]);
+void Godunov_solver_LAG_source(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[]);
 //////////////////////////////////////
 // grp_solver_LAG_source.c
 //////////////////////////////////////
-void     GRP_solver_LAG_source(const int m, struct cell_var_stru CV, double * X[], double * cpu_time, int * N_plot, double time_plot[]);
+void     GRP_solver_LAG_source(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[]);
+
+/**
+ * @brief This function updates the state of the Lagrangian cell j by the increases of the specific volume,
+ *        the momentum and the total energy over the time step.
+ * @details The reciprocal of the cell mass replaces the division of the forward Euler step,
+ *          the specific volume of the cell is updated by the increase relative to it.
+ *          The old values RHO0, U0 and E0 may be the same arrays as the new ones RHO, U and E (in place).
+ * @param[in] j:    Index of the cell.
+ * @param[in] dt_m: Length of the time step divided by the mass of the cell
+ *                  (the reciprocal of the mass if the increases are multiplied by the time steps).
+ * @param[in] d_v:  Increase of the volume flux (the velocity) across the cell.
+ * @param[in] d_u:  Increase of the momentum flux (the pressure) across the cell.
+ * @param[in] d_e:  Increase of the energy flux across the cell.
+ * @return    Whether the updated density or pressure is not positive (in the sense of eps).
+ */
+static inline int LAG_update_state(const int j, const double dt_m, const double gamma, const double eps,
+				   const double * RHO0, const double * U0, const double * E0,
+				   double * RHO, double * U, double * P, double * E,
+				   const double d_v, const double d_u, const double d_e)
+{
+  RHO[j] = RHO0[j] / (1.0 + RHO0[j]*dt_m*d_v);
+  U[j]   = U0[j] - dt_m*d_u;
+  E[j]   = E0[j] - dt_m*d_e;
+  P[j]   = (E[j] - 0.5 * U[j]*U[j]) * (gamma - 1.0) * RHO[j];
+  return P[j] < eps || RHO[j] < eps;
+}
+
+/**
+ * @brief This function updates the Lagrangian cell j by the numerical fluxes and computes its slopes for the next time step.
+ * @details It is the forward Euler step of all the 1-D Lagrangian schemes, dt_m is tau/MASS[0] on the grids of uniform
+ *          mass and tau/MASS[j] otherwise, by the reciprocals of the masses.
+ * @param[in] j:    Index of the cell.
+ * @param[in] dt_m: Length of the time step divided by the mass of the cell.
+ * @param[in] s_rho, s_u, s_p: Slopes of the cells (NULL: the first-order scheme, no slope).
+ * @return    Whether the updated density or pressure is not positive (in the sense of eps).
+ */
+static inline int LAG_update_cell(const int j, const double dt_m, const double gamma, const double eps,
+				  const double * RHO0, const double * U0, const double * E0,
+				  double * RHO, double * U, double * P, double * E, const double * X,
+				  const double * U_F, const double * P_F, const double * U_next, const double * P_next,
+				  const double * RHO_next_L, const double * RHO_next_R, double * s_rho, double * s_u, double * s_p)
+{ /*
+   *  j-1          j          j+1
+   * j-1/2  j-1  j+1/2   j   j+3/2  j+1
+   *   o-----X-----o-----X-----o-----X--...
+   */
+  const int err = LAG_update_state(j, dt_m, gamma, eps, RHO0, U0, E0, RHO, U, P, E,
+				   U_F[j+1] - U_F[j], P_F[j+1] - P_F[j], P_F[j+1]*U_F[j+1] - P_F[j]*U_F[j]);
+  if(s_rho == NULL)
+      return err;
+
+//============================compute the slopes============================
+  double const r_h = 1.0 / (X[j+1] - X[j]);
+  s_u[j]   = (    U_next[j+1] -     U_next[j])*r_h;
+  s_p[j]   = (    P_next[j+1] -     P_next[j])*r_h;
+  s_rho[j] = (RHO_next_L[j+1] - RHO_next_R[j])*r_h;
+  return err;
+}
+//////////////////////////////////////
+// grp_solver_LAG_fused.c
+//////////////////////////////////////
+void     GRP_solver_LAG_fused (struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[]);
+int GRP_LAG_interface(const struct run_ctx * ctx, const int j, const int m, const int k, double * RHO, double * U, double * P,
+		      const double * s_rho, const double * s_u, const double * s_p, const double * X,
+		      const struct b_f_var * bfv_L, const struct b_f_var * bfv_R, double * h_S_max,
+		      double * RHO_next_L, double * RHO_next_R, double * U_next, double * P_next,
+		      double * RHO_t_L, double * RHO_t_R, double * U_t, double * P_t);
+//////////////////////////////////////
+// grp_solver_LAG_lanes.c
+//////////////////////////////////////
+int GRP_solver_LAG_lanes(struct run_ctx * const ctx[], const int W, const int m, struct cell_var_stru CV[], double * X[], double time_c[]);
+//////////////////////////////////////
+// grp_solver_LAG_LTS.c
+//////////////////////////////////////
+void     GRP_solver_LAG_LTS   (struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[]);
 
 /* radially symmertric Godunov/GRP scheme (Lagrangian, two-component flow, radial structured grid) */
 //////////////////////////////////////
@@ -30,22 +105,33 @@ void GRP_solver_radial_LAG_source(struct cell_var_stru CV, struct radial_mesh_va
 //////////////////////////////////////
 // godunov_solver_EUL_source.c
 //////////////////////////////////////
-void Godunov_solver_EUL_source(const int m, struct cell_var_stru CV, double * cpu_time, int * N_plot, double time_plot[]);
+void Godunov_solver_EUL_source(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[]);
 //////////////////////////////////////
 // grp_solver_EUL_source.c
 //////////////////////////////////////
-void     GRP_solver_EUL_source(const int m, struct cell_var_stru CV, double * cpu_time, int * N_plot, double time_plot[]);
+void     GRP_solver_EUL_source(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[]);
+//////////////////////////////////////
+// grp_solver_EUL_AMR.c
+//////////////////////////////////////
+void     GRP_solver_EUL_AMR   (struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[]);
+
+/* 1-D GRP scheme (ALE, single-component flow) */
+//////////////////////////////////////
+// grp_solver_ALE_source.c
+//////////////////////////////////////
+void     GRP_solver_ALE_source(struct run_ctx * ctx, const int m, struct cell_var_stru CV, double * X[], double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[]);
 
 /* 2-D Godunov/GRP scheme (Eulerian, single-component flow, structured grid) */
 //////////////////////////////////////
 // grp_solver_2D_EUL_source.c
 //////////////////////////////////////
-void GRP_solver_2D_EUL_source(const int m, const int n, struct cell_var_stru * CV, double ** X, double **Y, 
+void GRP_solver_2D_EUL_source(struct run_ctx * ctx, const int m, const int n, struct cell_var_stru * CV, double ** X, double **Y, 
 			      double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[]);
+void GRP_solver_2D_mem(const int m, const int n);
 //////////////////////////////////////
 // grp_solver_2D_split_EUL_source.c
 //////////////////////////////////////
-void GRP_solver_2D_split_EUL_source(const int m, const int n, struct cell_var_stru * CV, double ** X, double **Y, 
+void GRP_solver_2D_split_EUL_source(struct run_ctx * ctx, const int m, const int n, struct cell_var_stru * CV, double ** X, double **Y, 
                                     double * cpu_time, const char * problem, int N_T, int * N_plot, double time_plot[]);
 
 /* 2-D Godunov/GRP scheme (Eulerian, two-component flow, unstructured grid) */
@@ -9,27 +9,92 @@
 
 #include "../include/var_struc.h"
 
+//! The first miscalculation in a sweep of the 2-D flux generators, recorded by each thread and merged after the sweep.
+struct flux_err_rec {
+	int err;  //!< miscalculation indicator (1-3: ifvar_check_code() of the states, 4-6: 3 + the code of the GRP solver).
+	int j, i; //!< x- and y-index of the first miscalculated interface.
+	int num;  //!< number of the miscalculations.
+	int kind; //!< kinds of the miscalculations (bit 1: states, bit 2: fluxes).
+};
+/**
+ * @brief Key of a miscalculation at the interface (j, i) of n+1 interfaces in a line, the smallest key is the first one.
+ * @details The loops on the device of OpenACC find the first miscalculation by the min-reduction of the key,
+ *          and the key is decoded by flux_err_key_set() after the sweep.
+ */
+#define FLUX_ERR_KEY(err, j, i, n) ((((long)(j)) * ((n) + 1) + (i)) * 8 + (err))
+
+/**
+ * @brief Pointer to a flux solver at an interface, resolved once per run by flux_solver_select().
+ * @details It gives the fluxes in 'ifv' from the left state 'ifv' and the right state 'ifv_R',
+ *          and returns the miscalculation indicator (0: successful calculation).
+ */
+typedef int (*flux_solver_fn)(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau);
+
+//! Numbers of the flux solvers of the 2-D interfaces, called by flux_solver_call() in the device loops of OpenACC.
+enum flux_solver_id {FLUX_NONE, FLUX_ROE_2D, FLUX_HLL_2D, FLUX_HLLC_2D, FLUX_EXACT_2D, FLUX_GRP_2D};
+
+/**
+ * @brief Number of interfaces handled together by a batched flux solver.
+ */
+#ifndef FLUX_BATCH_SIZE
+#define FLUX_BATCH_SIZE 64
+#endif
+/**
+ * @brief Pointer to a batched flux solver over a block of interfaces, resolved once per run by flux_batch_select().
+ * @details It gives the four fluxes F[0-3] (mass, x-/y-momentum, energy) of 'n' interfaces from the left states 'ifv_L'
+ *          and the right states 'ifv_R', and the maximum characteristic velocity of the block in 'lambda_max'.
+ */
+typedef void (*flux_batch_fn)(const int n, double * const F[4], double * lambda_max,
+			      const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R);
+
 /* Generate fluxes for 2-D Godunov/GRP scheme (Eulerian, single-component flow) */
 /////////////////////////
 // flux_generator_x.c
 /////////////////////////
-int flux_generator_x(const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
+int flux_generator_x(const struct run_ctx * ctx, const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
 		      struct b_f_var * bfv_L, struct b_f_var * bfv_R, const _Bool Transversal);
+void flux_generator_x_tile(const struct run_ctx * ctx, const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
+			   struct b_f_var * bfv_L, struct b_f_var * bfv_R, const _Bool Transversal,
+			   const int j0, const int j1, struct flux_err_rec * fe);
 /////////////////////////
 // flux_generator_y.c
 /////////////////////////
-int flux_generator_y(const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
+int flux_generator_y(const struct run_ctx * ctx, const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
 		      struct b_f_var * bfv_D, struct b_f_var * bfv_U, const _Bool Transversal);
+void flux_generator_y_tile(const struct run_ctx * ctx, const int m, const int n, const int nt, const double tau, struct cell_var_stru * CV,
+			   struct b_f_var * bfv_D, struct b_f_var * bfv_U, const _Bool Transversal,
+			   const int j0, const int j1, struct flux_err_rec * fe);
 
 /////////////////////////
 // flux_solver.c
 /////////////////////////
 // Flux of 2-D GRP solver (Eulerian, two-component flow)
-int GRP_2D_flux       (struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau);
+ACC_ROUTINE_SEQ
+int GRP_2D_flux       (const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau);
+// Flux of 2-D GRP solver (Eulerian, single-fluid flow with a constant gamma)
+ACC_ROUTINE_SEQ
+int GRP_2D_flux_gc    (const struct run_ctx * ctx, const struct gamma_const * gc, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau);
+// Flux of 2-D GRP solver (Eulerian, two-component flow with the constants of the components)
+ACC_ROUTINE_SEQ
+int GRP_2D_flux_gt    (const struct run_ctx * ctx, const struct gamma_const * gt, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau);
 // Flux of exact Riemann solver (Eulerian, two-component flow)
-int Riemann_exact_flux(struct i_f_var * ifv, struct i_f_var * ifv_R);
+ACC_ROUTINE_SEQ
+int Riemann_exact_flux(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R);
 // Flux of approximate Riemann solver (Eulerian, two-component flow)
-void Roe_flux(struct i_f_var * ifv, struct i_f_var * ifv_R);
-void HLL_flux(struct i_f_var * ifv, struct i_f_var * ifv_R);
+void Roe_flux(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R);
+void HLL_flux(const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R);
+// Flux solver of a scheme resolved once per run
+flux_solver_fn flux_solver_select(const struct run_ctx * ctx, const char * scheme, const int order);
+// Batched flux solver of a scheme resolved once per run (NULL: the scheme is solved one interface at a time)
+flux_batch_fn  flux_batch_select (const struct run_ctx * ctx, const char * scheme, const int order);
+// Number of the flux solver of a scheme for the device loops, and the solver of the number
+int flux_solver_id_select(const struct run_ctx * ctx, const char * scheme, const int order);
+ACC_ROUTINE_SEQ
+int flux_solver_call(const int id, const struct run_ctx * ctx, struct i_f_var * ifv, struct i_f_var * ifv_R, const double tau);
+// Records of the miscalculations in the flux generators
+void flux_err_add   (struct flux_err_rec * e, const int err, const int j, const int i);
+void flux_err_merge (struct flux_err_rec * e, const struct flux_err_rec * e_t);
+int  flux_err_report(const struct flux_err_rec * e, const int nt, const char dir);
+void flux_err_key_set(struct flux_err_rec * e, const long key, const int num, const int kind, const int n);
 
 #endif
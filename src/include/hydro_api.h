@@ -0,0 +1,25 @@
+/**
+ * @file hydro_api.h
+ * @brief This file is the header file of the library API of the hydrocodes embedded in other programs.
+ * @details This header file declares functions in the folder 'hydro_api'.
+ *          It needs no other header file of the hydrocodes, so that it is the only one included by the callers.
+ */
+
+#ifndef HYDROAPI_H
+#define HYDROAPI_H
+
+//! An instance of the 1-D Lagrangian GRP scheme, independent of the other instances in the process.
+struct hydro_1D;
+
+///////////////////////////////////
+// hydro_api_1D.c
+///////////////////////////////////
+struct hydro_1D * hydro_1D_init(const int n_conf, const double conf[], const int m,
+				double RHO[], double U[], double P[], double X[]);
+int    hydro_1D_step    (struct hydro_1D * hd, double * tau);
+int    hydro_1D_advance (struct hydro_1D * hd, const double t_end, int * n_step);
+void   hydro_1D_sync    (struct hydro_1D * hd);
+double hydro_1D_time    (const struct hydro_1D * hd);
+void   hydro_1D_finalize(struct hydro_1D * hd);
+
+#endif
@@ -9,24 +9,96 @@
 
 #include "../include/var_struc.h"
 
+struct radial_mesh_var; // It is defined with RADIAL_BASICS.
+
 
 ///////////////////////////////////
 // fluid_var_check.c
 ///////////////////////////////////
-int ifvar_check(struct i_f_var *ifv_L, struct i_f_var *ifv_R, const int dim);
-int star_dire_check(double *mid, double *dire, const int dim);
+int ifvar_check(const struct run_ctx * ctx, struct i_f_var *ifv_L, struct i_f_var *ifv_R, const int dim);
+int star_dire_check(const struct run_ctx * ctx, double *mid, double *dire, const int dim);
+ACC_ROUTINE_SEQ
+int ifvar_check_code(const struct run_ctx * ctx, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const int dim);
+ACC_ROUTINE_SEQ
+int star_dire_check_code(const struct run_ctx * ctx, const double *mid, const double *dire, const int dim);
+int ifvar_check_batch(const struct run_ctx * ctx, const int n, const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R, int * err);
+int star_dire_check_batch(const struct run_ctx * ctx, const int n, const double * const mid[], const double * const dire[], const int dim, int * err);
+const char * ifvar_check_msg(const int err, const int dim);
+const char * star_dire_check_msg(const int err);
+_Bool ifvar_quiescent(const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps);
+
+
+///////////////////////////////////
+// device_data_2D.c
+///////////////////////////////////
+void device_data_enter_2D(const struct run_ctx * ctx, const int m, const int n, const int N_T, struct cell_var_stru * CV,
+			  struct b_f_var * bfv_L, struct b_f_var * bfv_R, struct b_f_var * bfv_D, struct b_f_var * bfv_U);
+void device_data_update_host_2D(const int m, const int n, struct cell_var_stru * CV);
+void device_data_update_ckpt_2D(const int m, const int n, const int nt, struct cell_var_stru * CV,
+				struct b_f_var * bfv_L, struct b_f_var * bfv_R, struct b_f_var * bfv_D, struct b_f_var * bfv_U);
+void device_data_exit_2D (const struct run_ctx * ctx, const int m, const int n, const int N_T, const int nt, struct cell_var_stru * CV,
+			  struct b_f_var * bfv_L, struct b_f_var * bfv_R, struct b_f_var * bfv_D, struct b_f_var * bfv_U);
+///////////////////////////////////
+// halo_exchange_1D.c
+///////////////////////////////////
+int    halo_part_init_1D(const struct run_ctx * ctx, const int M, int part[2]);
+void   halo_part_1D(const int r, int part[2]);
+int    halo_rank_1D(void);
+int    halo_size_1D(void);
+_Bool  halo_inner_1D(const int s);
+void   halo_part_free_1D(void);
+double halo_min_1D(double v);
+int    halo_max_1D(int v);
+void   halo_sum_1D(double v[], const int n);
+struct repro_sum;
+void   halo_repro_sum_1D(struct repro_sum * s, const int n);
+void halo_state_1D(const int m, const int nt, const struct cell_var_stru * CV, const double * X, const double h,
+		   struct b_f_var * bfv_L, struct b_f_var * bfv_R);
+void halo_slope_1D(const int m, const struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R);
+///////////////////////////////////
+// halo_exchange_2D.c
+///////////////////////////////////
+int    halo_block_init_2D(const struct run_ctx * ctx, const int M, const int N, int blk[4]);
+void   halo_block_2D(const int r, int blk[4]);
+int    halo_rank_2D(void);
+int    halo_size_2D(void);
+void   halo_block_free_2D(void);
+double halo_min_2D(double v);
+int    halo_max_2D(int v);
+void halo_state_x(const int m, const int n, const struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R);
+void halo_state_y(const int m, const int n, const struct cell_var_stru * CV, struct b_f_var * bfv_D, struct b_f_var * bfv_U);
+void halo_slope_start_x (const int m, const int n, const struct cell_var_stru * CV);
+void halo_slope_start_y (const int m, const int n, const struct cell_var_stru * CV);
+void halo_slope_finish_x(const int n, struct b_f_var * bfv_L, struct b_f_var * bfv_R);
+void halo_slope_finish_y(const int m, struct b_f_var * bfv_D, struct b_f_var * bfv_U);
 
 
 ///////////////////////////////////
 // slope_limiter.c
 ///////////////////////////////////
-void minmod_limiter(const _Bool NO_h, const int m, const _Bool i_f_var_get, double s[],
-		    const double U[], const double UL, const double UR, const double HL, ...);
+void minmod_limiter_h(const double alpha, const _Bool i_f_var_get, const int m, double s[],
+		      const double U[], const double UL, const double UR, const double h);
+void minmod_limiter_X(const double alpha, const _Bool i_f_var_get, const int m, double s[],
+		      const double U[], const double UL, const double UR, const double HL, const double HR, const double X[]);
+void minmod_limiter_vars(const struct run_ctx * ctx, const _Bool NO_h, const int m, const _Bool i_f_var_get, const int nv,
+			 double * const s[], const double * const U[], const double UL[], const double UR[],
+			 const double HL, const double HR, const double X[]);
+void minmod_limiter_row(const double alpha, const _Bool i_f_var_get, const int n, Real_Store s[],
+			const double Um[], const double U0[], const double Up[], const double h);
 ///////////////////////////////////
 // slope_limiter_2D_x.c
 ///////////////////////////////////
-void minmod_limiter_2D_x(const _Bool NO_h, const int m, const int i, const _Bool i_f_var_x_get, double ** s,
-			 double ** U, const double UL, const double UR, const double HL, ...);
+ACC_ROUTINE_SEQ
+void minmod_limiter_2D_x_cell(const double alpha, const _Bool i_f_var_x_get, const int m, const int j, const int i, Real_Store ** s,
+			      double ** U, const double UL, const double UR, const double h);
+///////////////////////////////////
+// slope_limiter_2D_y.c
+///////////////////////////////////
+void minmod_limiter_2D_y(const double alpha, const _Bool i_f_var_y_get, const int n, const int j, Real_Store ** s,
+			 double ** U, const double UL, const double UR, const double h);
+ACC_ROUTINE_SEQ
+void minmod_limiter_2D_y_cell(const double alpha, const _Bool i_f_var_y_get, const int n, const int j, const int i, Real_Store ** s,
+			      double ** U, const double UL, const double UR, const double h);
 ///////////////////////////////////
 // slope_limiter_radial.c
 ///////////////////////////////////
@@ -43,17 +115,25 @@ void VIP_limiter_radial(const int Ncell, const _Bool i_f_var_get, double DmU[],
 ///////////////////////////////////
 // bound_cond_slope_limiter.c
 ///////////////////////////////////
-_Bool bound_cond_slope_limiter(const _Bool NO_h, const int m, const int nt, struct cell_var_stru * CV,
+_Bool bound_cond_slope_limiter(const struct run_ctx * ctx, const _Bool NO_h, const int m, const int nt, struct cell_var_stru * CV,
 			       struct b_f_var * bfv_L, struct b_f_var * bfv_R, _Bool find_bound, const _Bool Slope, const double t_c, ...);
 ///////////////////////////////////
 // bound_cond_slope_limiter_x.c
 ///////////////////////////////////
-_Bool bound_cond_slope_limiter_x(const int m, const int n, const int nt, struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R,
+_Bool bound_cond_slope_limiter_x(const struct run_ctx * ctx, const int m, const int n, const int nt, struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R,
 				 struct b_f_var * bfv_D, struct b_f_var * bfv_U, _Bool find_bound_x, const _Bool Slope, const double t_c);
+void slope_bound_x_edge  (const struct run_ctx * ctx, const int m, const int n, const struct cell_var_stru * CV,
+			  struct b_f_var * bfv_L, struct b_f_var * bfv_R);
+void slope_limiter_x_tile(const struct run_ctx * ctx, const int m, const int n, const int nt, struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R,
+			  struct b_f_var * bfv_D, struct b_f_var * bfv_U, const _Bool find_bound_x, const int j0, const int j1);
 ///////////////////////////////////
 // bound_cond_slope_limiter_y.c
 ///////////////////////////////////
-_Bool bound_cond_slope_limiter_y(const int m, const int n, const int nt, struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R,
+_Bool bound_cond_slope_limiter_y(const struct run_ctx * ctx, const int m, const int n, const int nt, struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R,
 				 struct b_f_var * bfv_D, struct b_f_var * bfv_U, _Bool find_bound_y, const _Bool Slope, const double t_c);
+void slope_bound_y_edge  (const struct run_ctx * ctx, const int m, const int n, const struct cell_var_stru * CV,
+			  struct b_f_var * bfv_L, struct b_f_var * bfv_R);
+void slope_limiter_y_tile(const struct run_ctx * ctx, const int n, const int nt, struct cell_var_stru * CV,
+			  struct b_f_var * bfv_D, struct b_f_var * bfv_U, const _Bool find_bound_y, const int j0, const int j1);
 
 #endif
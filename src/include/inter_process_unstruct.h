@@ -14,14 +14,17 @@
 // cons_qty_calc.c
 /////////////////////////
 void cons_qty_init(const struct cell_var * cv, const struct flu_var * FV);
+ACC_ROUTINE_SEQ
 int cons2prim(struct i_f_var * ifv);
 int cons_qty_update(const struct cell_var * cv, const struct mesh_var * mv,
 					const struct flu_var *  FV, const double tau);
 /////////////////////////
 // cons_qty_update_P_ave.c
 /////////////////////////
+int ssp_rk_stages(void);
+double ssp_rk_time(const int RK);
 int cons_qty_update_corr_ave_P(struct cell_var * cv, const struct mesh_var * mv,
-							   const struct flu_var * FV, double tau, const int RK);
+							   const struct flu_var * FV, double tau, const int RK, double * res);
 
 /////////////////////////
 // cell_init_free.c
@@ -30,29 +33,60 @@ void cell_mem_init_free(struct cell_var * cv, const struct mesh_var * mv, struct
 void vol_comp(const struct cell_var * cv, const struct mesh_var * mv);
 void cell_pt_clockwise(const struct mesh_var * mv);
 void cell_rel(const struct cell_var * cv, const struct mesh_var * mv);
+void face_rel(struct face_var * fv, const struct cell_var * cv, const struct mesh_var * mv, const int i_or_f);
 void cell_centroid(const struct cell_var * cv, const struct mesh_var * mv);
+void face_geom_comp(const struct cell_var * cv, const struct mesh_var * mv);
+void node_rel(struct node_var * nv, const struct mesh_var * mv, const int i_or_f);
+int geom_move_unstruct(struct node_var * nv, const struct cell_var * cv, const struct mesh_var * mv);
 
 /////////////////////////
 // slope_limiter_unstruct.c
 /////////////////////////
+void lsq_geom_cell(const struct cell_var * cv, const int k);
+void lsq_geom_comp(const struct cell_var * cv, const struct mesh_var * mv);
 void slope_limiter_prim(const struct cell_var * cv,const struct mesh_var * mv, const struct flu_var * FV);
 
 /////////////////////////
 // copy_func.c
 /////////////////////////
+ACC_ROUTINE_SEQ
 void cons_qty_copy_cv2ifv(struct i_f_var * ifv, const struct cell_var * cv, const int c);
+ACC_ROUTINE_SEQ
 void cons_qty_copy_ifv2cv(const struct i_f_var * ifv, struct cell_var * cv, const int c);
+ACC_ROUTINE_SEQ
 void prim_var_copy_ifv2FV(const struct i_f_var * ifv, const struct flu_var * FV,const int c);
+ACC_ROUTINE_SEQ
 void flux_copy_ifv2cv(const struct i_f_var * ifv, const struct cell_var *cv, const int k, const int j);
+ACC_ROUTINE_SEQ
+void flux_opposite_ifv2cv(const struct i_f_var * ifv, const struct cell_var * cv, const int k, const int j);
 void flux_add_ifv2cv(const struct i_f_var * ifv, const struct cell_var * cv, const int k, const int j);
 
 /////////////////////////
 // assist_func.c
 /////////////////////////
 int fluid_var_update(struct flu_var *FV, struct cell_var *cv);
+ACC_ROUTINE_SEQ
 int interface_var_init(const struct cell_var * cv, const struct mesh_var * mv,
 					   struct i_f_var * ifv, struct i_f_var * ifv_R,
 					   const int k, const int j, const int i, const double gauss);
 double tau_calc(const struct cell_var * cv, const struct mesh_var * mv);
 
+/////////////////////////
+// device_data_unstruct.c
+/////////////////////////
+void device_data_enter_unstruct      (struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, struct face_var * fv);
+void device_data_update_host_unstruct(const struct mesh_var * mv, struct flu_var * FV);
+void device_data_exit_unstruct       (struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, struct face_var * fv);
+
+/////////////////////////
+// halo_exchange_unstruct.c
+/////////////////////////
+int    halo_part_init_unstruct(struct mesh_var * mv, struct flu_var * FV);
+int    halo_rank_unstruct(void);
+int    halo_size_unstruct(void);
+void   halo_part_free_unstruct(void);
+double halo_min_unstruct(double v);
+int    halo_max_unstruct(int v);
+void   halo_ghost_unstruct(struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, const double t, const int part);
+
 #endif
@@ -23,25 +23,35 @@ void Saltzman_Lag_mesh       (struct mesh_var * mv);
 //////////////////////////
 // msh_load.c
 //////////////////////////
-int msh_read(FILE * fp, struct mesh_var * mv);
+int  msh_read(FILE * fp, struct mesh_var * mv);
+int  msh_cache_read(const char * msh, const char * cache, struct mesh_var * mv);
+void msh_cache_write(const char * cache, struct mesh_var * mv);
+
+//////////////////////////
+// mesh_reorder.c
+//////////////////////////
+void mesh_reorder(struct mesh_var * mv, struct flu_var * FV, const int order);
 
 //////////////////////////
 // mesh_int_free.c
 //////////////////////////
 struct mesh_var mesh_init(const char *example, const char *mesh_name);
+void cell_pt_csr(struct mesh_var * mv);
 void mesh_mem_free(struct mesh_var * mv);
 
 //////////////////////////
 // ghost_cell.c
 //////////////////////////
 void period_cell_modify(struct mesh_var * mv);
-void period_ghost(struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, const double t);
+void period_ghost(struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, const double t, const int part);
 
 //////////////////////////
 // radial_mesh.c
 //////////////////////////
 struct radial_mesh_var radial_mesh_init(const char *example);
 void radial_mesh_update  (struct radial_mesh_var *rmv);
+int  radial_mesh_rezone  (struct radial_mesh_var *rmv, const double frac, double * mass, double * RHO, double * U, double * P,
+			  double * E, const double * gamma, double * d_rho, double * d_u, double * d_p);
 void radial_mesh_mem_free(struct radial_mesh_var *rmv);
 
 #endif
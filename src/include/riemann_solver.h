@@ -7,6 +7,8 @@
 #ifndef RIEMANNSOLVER_H
 #define RIEMANNSOLVER_H
 
+#include <math.h>
+
 #include "../include/var_struc.h"
 
 
@@ -16,15 +18,86 @@
 #ifndef Riemann_solver_exact_single
 #define Riemann_solver_exact_single Riemann_solver_exact_Ben
 #endif
+//! The exact Riemann solver for single-component flow started from a given guess of the star pressure.
+#define Riemann_solver_exact_single_warm RIEMANN_WARM_NAME(Riemann_solver_exact_single)
+#define RIEMANN_WARM_NAME(solver)  RIEMANN_WARM_NAME_(solver)
+#define RIEMANN_WARM_NAME_(solver) solver ## _warm
+
+/**
+ * @brief Number of interfaces handled together in the batched GRP solvers.
+ */
+#ifndef GRP_BATCH_SIZE
+#define GRP_BATCH_SIZE 64
+#endif
+
+/**
+ * @brief The largest half-integer exponent evaluated by multiplications in gamma_pow().
+ */
+#ifndef GAMMA_POW_MAX
+#define GAMMA_POW_MAX 31.5
+#endif
+
+/**
+ * @brief Vector math of the batched solvers: vmath_pow() and vmath_exp() in the loops of 'omp simd'.
+ * @details With GCC, OpenMP and glibc on x86-64, pow() and exp() are declared 'omp declare simd' as glibc does
+ *          with '-ffast-math', so that a vectorized loop calls their variants of the vector function ABI
+ *          (e.g. _ZGVdN4vv_pow for AVX2) from libmvec, linked by '-lm'. The same symbols are given by the library
+ *          'sleefgnuabi' of SLEEF. The variants are called only if the module is compiled with '-fno-math-errno',
+ *          and the loops with branches are if-converted only with '-fno-trapping-math' (see CFLAGR of the Makefiles).
+ *          sqrt() is vectorized by the instructions of the CPU, correctly rounded in both modes.
+ * <table>
+ * <tr><th> Mode   <th> Functions                               <th> Relative error of pow() and exp()
+ * <tr><td> vector <td> libmvec (or SLEEF) in vectorized loops  <td> ≤ 4 ulp (glibc manual)
+ * <tr><td> scalar <td> libm, macro VMATH_SCALAR or other platforms <td> < 1 ulp
+ * </table>
+ *          The scalar mode is the validation build, whose results are compared with those of the vector mode,
+ *          e.g. by the errors of 'bench_Riemann'. The declarations affect every loop of 'omp simd' calling pow()
+ *          or exp() in a file including this header.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__) && defined(_OPENMP) && !defined(VMATH_SCALAR)
+#ifndef __FAST_MATH__
+#pragma omp declare simd notinbranch
+double pow(double x, double e);
+#pragma omp declare simd notinbranch
+double exp(double x);
+#endif
+#define VMATH_MODE "vector (libmvec, <= 4 ulp)"
+#else
+#define VMATH_MODE "scalar (libm, < 1 ulp)"
+#endif
+#define vmath_pow(x, e) pow(x, e)
+#define vmath_exp(x)    exp(x)
+
+#ifdef _WIN32
+inline void gamma_const_set(struct gamma_const * gc, const double gamma);
+inline int  gamma_pow_code(const double e);
+ACC_ROUTINE_SEQ
+inline const struct gamma_const * gamma_const_find(const struct gamma_const * gt, const double gamma);
+ACC_ROUTINE_SEQ
+inline double gamma_pow(const double x, const double e, const int h);
+#elif __linux__
+inline void gamma_const_set(struct gamma_const * gc, const double gamma) __attribute__((always_inline));
+inline int  gamma_pow_code(const double e) __attribute__((always_inline));
+ACC_ROUTINE_SEQ
+inline const struct gamma_const * gamma_const_find(const struct gamma_const * gt, const double gamma) __attribute__((always_inline));
+ACC_ROUTINE_SEQ
+inline double gamma_pow(const double x, const double e, const int h) __attribute__((always_inline));
+#endif
 
 /* exact Riemann solver (two-component flow) */
 //////////////////////////////////////
 // riemann_solver_exact_Ben.c
 //////////////////////////////////////
+ACC_ROUTINE_SEQ
 double Riemann_solver_exact(double * U_star, double * P_star, const double gammaL, const double gammaR,
 			    const double u_L, const double u_R, const double p_L, const double p_R, 
 			    const double c_L, const double c_R, _Bool * CRW,
 			    const double eps, const double tol, int N);
+ACC_ROUTINE_SEQ
+double Riemann_solver_exact_warm(double * U_star, double * P_star, const double gammaL, const double gammaR,
+				 const double u_L, const double u_R, const double p_L, const double p_R,
+				 const double c_L, const double c_R, _Bool * CRW,
+				 const double eps, const double tol, const int N, int * n_iter);
 //////////////////////////////////////
 // riemann_solver_starPU.c
 //////////////////////////////////////
@@ -40,6 +113,10 @@ double Riemann_solver_exact_Ben(double * U_star, double * P_star, const double g
 				const double u_L, const double u_R, const double p_L, const double p_R,
 				const double c_L, const double c_R, _Bool * CRW,
 				const double eps, const double tol, const int N);
+double Riemann_solver_exact_Ben_warm(double * U_star, double * P_star, const double gamma,
+				     const double u_L, const double u_R, const double p_L, const double p_R,
+				     const double c_L, const double c_R, _Bool * CRW,
+				     const double eps, const double tol, const int N, int * n_iter);
 //////////////////////////////////////
 // riemann_solver_exact_Toro.c
 //////////////////////////////////////
@@ -47,27 +124,65 @@ double Riemann_solver_exact_Toro(double * U_star, double * P_star, const double
 				 const double U_l, const double U_r, const double P_l, const double P_r,
 				 const double c_l, const double c_r, _Bool * CRW,
 				 const double eps, const double tol, const int N);
+double Riemann_solver_exact_Toro_warm(double * U_star, double * P_star, const double gamma,
+				      const double U_l, const double U_r, const double P_l, const double P_r,
+				      const double c_l, const double c_r, _Bool * CRW,
+				      const double eps, const double tol, const int N, int * n_iter);
+//////////////////////////////////////
+// riemann_solver_exact_adapt.c
+//////////////////////////////////////
+ACC_ROUTINE_SEQ
+double Riemann_guess_P(const double gammaL, const double gammaR, const double u_L, const double u_R,
+		       const double p_L, const double p_R, const double c_L, const double c_R,
+		       const double eps, int * guess);
+ACC_ROUTINE_SEQ
+void Riemann_exact_count(const int guess, const int n_iter, const _Bool * CRW);
+ACC_ROUTINE_SEQ
+void GRP_path_count(const int path);
+void GRP_hybrid_count(const _Bool flagged);
+void Riemann_exact_stat(struct riemann_stat * rs, const _Bool reset);
+void Riemann_exact_stat_report(void);
 
 //////////////////////////////////////
 // linear_grp_solver_LAG.c
 //////////////////////////////////////
 /* 1-D GRP solver (Lagrangian, two-component flow) */
 void linear_GRP_solver_LAG (double *D, double *U, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc);
+void linear_GRP_solver_LAG_batch (const int n, double * const D[4], double * const U[4],
+				  const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R, const double eps, const double atc);
+void linear_GRP_solver_LAG_batch_gc(const int n, double * const D[4], double * const U[4],
+				    const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R, const struct gamma_const * gc,
+				    const double eps, const double atc);
 //////////////////////////////////////
 // linear_grp_solver_Edir.c
 //////////////////////////////////////
 /* 1-D GRP solver (Eulerian, single-component flow) */
 void linear_GRP_solver_Edir(double *D, double *U, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc);
+void linear_GRP_solver_Edir_moving(double *D, double *U, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc);
+void linear_GRP_solver_Edir_warm(double *D, double *U, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc,
+				 double * P_star, int * n_iter);
+void linear_GRP_solver_Edir_batch(const int n, double * const D[3], double * const U[3],
+				  const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R, const double eps, const double atc);
+void linear_GRP_solver_Edir_batch_gc(const int n, double * const D[3], double * const U[3],
+				     const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R, const struct gamma_const * gc,
+				     const double eps, const double atc);
 
 /* 2-D GRP solver (ALE, two-component flow) */
 //////////////////////////////////////
 // linear_grp_solver_Edir_Q1D.c
 //////////////////////////////////////
+ACC_ROUTINE_SEQ
 void linear_GRP_solver_Edir_Q1D(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double  eps, const double atc);
+ACC_ROUTINE_SEQ
+void linear_GRP_solver_Edir_Q1D_gc(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R,
+				   const struct gamma_const * gc, const double  eps, const double atc, const _Bool hllc);
+ACC_ROUTINE_SEQ
+void linear_GRP_solver_Edir_Q1D_gt(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R,
+				   const struct gamma_const * gt, const double  eps, const double atc, const _Bool hllc);
 //////////////////////////////////////
 // linear_grp_solver_Edir_G2D.c
 //////////////////////////////////////
-void linear_GRP_solver_Edir_G2D(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double  eps, const double atc);
+void linear_GRP_solver_Edir_G2D(const struct run_ctx * ctx, double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double  eps, const double atc);
 
 //////////////////////////////////////
 // linear_grp_solver_radial_LAG.c
@@ -76,13 +191,33 @@ void AcousticRLagTangent(double *dire, double *U_star, const struct i_f_var * if
 			 const double r, const double M, const double eps);
 void GRPsolverRLag(double *wave_speed, double *dire, double *U_star, const struct i_f_var * ifv_L, const struct i_f_var * ifv_R,
 		   const double r, const double M, const double eps, const double atc);
+void AcousticRLagTangent_batch(const int n, double * const D[2], double * const U[2],
+			       const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R,
+			       const double * r, const double M, const double eps);
+void GRPsolverRLag_batch(const int n, double * const wave_speed[2], double * const D[4], double * const U[4],
+			 const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R,
+			 const double * r, const double M, const double eps, const double atc);
 
 
 /* HLL solver (single-component flow) */
 //////////////////////////////////////
 // hll_2D_solver.c
 //////////////////////////////////////
+ACC_ROUTINE_SEQ
 void HLL_2D_solver(double *F, double *lambda_max, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R);
+void HLL_2D_solver_batch(const int n, double * const F[4], double *lambda_max,
+			 const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R);
+
+/* HLLC solver (two-component flow) */
+//////////////////////////////////////
+// hllc_2D_solver.c
+//////////////////////////////////////
+ACC_ROUTINE_SEQ
+void HLLC_star(double * U_star, double * P_star, double * S, _Bool * CRW, const double gammaL, const double gammaR,
+	       const double rho_L, const double rho_R, const double u_L, const double u_R,
+	       const double p_L, const double p_R, const double c_L, const double c_R);
+ACC_ROUTINE_SEQ
+void HLLC_2D_solver(double *F, double *lambda_max, double *U, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R);
 
 /* Roe solver (single-component flow) */
 //////////////////////////////////////
@@ -92,10 +227,92 @@ void Roe_solver   (double *F, double *lambda_max, const struct i_f_var *ifv_L, c
 //////////////////////////////////////
 // roe_2D_solver.c
 //////////////////////////////////////
+ACC_ROUTINE_SEQ
 void Roe_2D_solver(double *F, double *lambda_max, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double delta);
+void Roe_2D_solver_batch(const int n, double * const F[4], double *lambda_max,
+			 const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R, const double delta);
 //////////////////////////////////////
 // roe_hll_solver.c
 //////////////////////////////////////
 void Roe_HLL_solver(double *V_mk, double *F, double *lambda_max, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double delta);
 
+/**
+ * @brief This function sets the derived constants of a perfect gas with the specific heat ratio gamma.
+ * @details The constants are evaluated by the same expressions as in the GRP solvers for two-component flow,
+ *          so that the single-fluid solvers give identical results.
+ */
+inline void gamma_const_set(struct gamma_const * gc, const double gamma)
+{
+    gc->gamma = gamma;
+    gc->zeta  = (gamma-1.0)/(gamma+1.0);
+    gc->zts   = gc->zeta*gc->zeta;
+    gc->e_rho = 1.0/gamma;
+    gc->e_c   = 0.5*(gamma-1.0)/gamma;
+    gc->e_p   = gamma/(gamma-1.0);
+    gc->e_s   = 2.0*gamma/(gamma-1.0);
+    gc->e_A   = 0.5/gc->zeta;
+    gc->e_B   = (1.0+gc->zeta)/gc->zeta;
+    gc->e_D   = (3.0*gamma-1.0)/2.0/(gamma+1.0);
+    gc->h_rho = gamma_pow_code(gc->e_rho);
+    gc->h_c   = gamma_pow_code(gc->e_c);
+    gc->h_p   = gamma_pow_code(gc->e_p);
+    gc->h_s   = gamma_pow_code(gc->e_s);
+    gc->h_A   = gamma_pow_code(gc->e_A);
+    gc->h_B   = gamma_pow_code(gc->e_B);
+    gc->h_D   = gamma_pow_code(gc->e_D);
+}
+
+/**
+ * @brief This function finds the constants of a gas in the table of the two components of two-component flow.
+ * @param[in] gt:    The constants of the two components set by gamma_const_set() (NULL: not given).
+ * @param[in] gamma: The specific heat ratio.
+ * @return  The constants of the component whose specific heat ratio is gamma (NULL: a mixture or not given).
+ */
+inline const struct gamma_const * gamma_const_find(const struct gamma_const * gt, const double gamma)
+{
+    if (gt == NULL)
+	return NULL;
+    return gt[0].gamma == gamma ? gt : (gt[1].gamma == gamma ? gt+1 : NULL);
+}
+
+/**
+ * @brief This function gives the code of an exponent for gamma_pow().
+ * @details The exponents of a perfect gas are often half-integers, e.g. e_s = 7, e_A = 3 and e_p = 3.5 for γ = 1.4,
+ *          which are evaluated with rounding errors by the expressions of γ.
+ * @param[in] e: The exponent.
+ * @return  \b h: 2e if it is a nonzero integer (to a relative error of 1e-12) not greater than 2*GAMMA_POW_MAX in magnitude, 0 otherwise.
+ */
+inline int gamma_pow_code(const double e)
+{
+    const double h = 2.0*e, r = floor(h + 0.5);
+    if (r == 0.0 || fabs(r) > 2.0*GAMMA_POW_MAX || fabs(h - r) > 1e-12*fabs(r))
+	return 0;
+    return (int)r;
+}
+
+/**
+ * @brief This function evaluates x^e for an exponent coded by gamma_pow_code().
+ * @details A half-integer power is given by at most 4 squarings, 5 products and a square root, without branches,
+ *          so that it has a relative error below (|e|+6) ulp and the batched loops stay vectorizable.
+ *          Other powers are evaluated by vmath_pow().
+ * @param[in] x: The base (x ≥ 0).
+ * @param[in] e: The exponent.
+ * @param[in] h: The code of e (0: pow(x, e) is called).
+ * @return  x^e.
+ */
+inline double gamma_pow(const double x, const double e, const int h)
+{
+    if (!h)
+	return vmath_pow(x, e);
+    const int n = (h < 0 ? -h : h) >> 1;
+    const double x2 = x*x, x4 = x2*x2, x8 = x4*x4, x16 = x8*x8;
+    double y = (h & 1) ? sqrt(x) : 1.0;
+    y *= (n &  1) ? x   : 1.0;
+    y *= (n &  2) ? x2  : 1.0;
+    y *= (n &  4) ? x4  : 1.0;
+    y *= (n &  8) ? x8  : 1.0;
+    y *= (n & 16) ? x16 : 1.0;
+    return h < 0 ? 1.0/y : y;
+}
+
 #endif
@@ -7,7 +7,11 @@
 #ifndef TOOLS_H
 #define TOOLS_H
 
+#include <math.h>
+#include <stdint.h>
+
 #define MAX(a,b) (((a) > (b)) ? (a) : (b))
+#define MIN(a,b) (((a) < (b)) ? (a) : (b))
 
 /* minmod function */
 #ifdef _WIN32
@@ -17,6 +21,10 @@ inline double minmod3(const double s_L, const double s_R, const double s_m);
 inline double minmod2(const double s_L, const double s_R)                   __attribute__((always_inline));
 inline double minmod3(const double s_L, const double s_R, const double s_m) __attribute__((always_inline));
 #endif
+#ifdef _OPENACC
+#pragma acc routine(minmod2) seq
+#pragma acc routine(minmod3) seq
+#endif
 
 //////////////////////////
 // sys_pro.c
@@ -25,8 +33,82 @@ void DispPro(const double pro, const int step);
 
 int CreateDir(const char* pPath);
 
-void init_mem (double * p[], const int n, int ** cell_pt);
-void init_mem_int(int * p[], const int n, int ** cell_pt);
+void init_mem (double * p[], const int n, const int * off);
+void init_mem_int(int * p[], const int n, const int * off);
+
+void * field_alloc_2D(const int M, const int N, const size_t size, const int tag, const char * field);
+void   field_free_2D (void * p, const int M);
+long   field_bytes_2D(const int M, const int N, const size_t size);
+void   field_device_enter_2D      (void * p, const int M, const int N, const size_t size, const int copy);
+void   field_device_update_host_2D(void * p, const int M, const int N, const size_t size);
+void   field_device_exit_2D       (void * p, const int M, const int N, const size_t size);
+void   field_device_enter_CSR      (void * p, const int * off, const int M, const size_t size, const int copy);
+void   field_device_update_host_CSR(void * p, const int * off, const int M, const size_t size);
+void   field_device_exit_CSR       (void * p, const int * off, const int M, const size_t size);
+
+//////////////////////////
+// telemetry.c
+//////////////////////////
+void telemetry_open (const char * file, const double interval, const int bar);
+void telemetry_close(void);
+int  telemetry_due  (void);
+int  telemetry_stat (double tau[3], double * wall);
+void telemetry_conserve(const int nq, const double q[]);
+void telemetry_step (const double pro, const int step, const double time, const double tau);
+
+//////////////////////////
+// work_chunk.c
+//////////////////////////
+//! Cost-weighted chunks of a loop over the items 0 <= k < n, stolen by the threads as the tasks of OpenMP.
+struct work_chunk {
+	int n;          //!< number of the items of the loop.
+	int num;        //!< number of the chunks (0: no chunk).
+	int * start;    //!< first items of the chunks, start[num] = n.
+	double * cost;  //!< wall time of the chunks measured in the last sweep.
+};
+
+int  work_chunk_init   (struct work_chunk * wc, const int n, const int per_thread);
+void work_chunk_free   (struct work_chunk * wc);
+void work_chunk_balance(struct work_chunk * wc);
+
+//////////////////////////
+// steady_state.c
+//////////////////////////
+//! Residuals of the steady state: L1 and L∞ norms of the changes of the density and the total energy.
+enum steady_res_id {SS_L1_RHO, SS_L1_E, SS_LI_RHO, SS_LI_E, SS_NUM};
+
+//! Monitor of the residuals of a run marching to a steady state.
+struct steady_state {
+	double tol;          //!< tolerance of the relative residuals (0: no steady-state mode).
+	double res0[SS_NUM]; //!< residuals per unit time of the first time step.
+	double rel;          //!< largest residual relative to that of the first time step.
+	int n;               //!< number of the time steps checked.
+};
+
+void steady_state_init (struct steady_state * ss, const double tol);
+int  steady_state_check(struct steady_state * ss, const double res[SS_NUM], const long n_cell, const double tau);
+
+//////////////////////////
+// repro_sum.c
+//////////////////////////
+#define RSUM_BINS 70 //!< number of the bins of 32-bit chunks covering the exponents of the doubles.
+
+//! Exact sum of doubles independent of the order of the summands.
+struct repro_sum {
+	int64_t b[RSUM_BINS]; //!< integer sums of the chunks in the bins of weights 2^(32*i-1152).
+	long n;               //!< number of the sums in the bins since the last normalization.
+};
+
+void   repro_sum_init   (struct repro_sum * s);
+void   repro_sum_add    (struct repro_sum * s, const double x);
+void   repro_sum_merge  (struct repro_sum * s, struct repro_sum * t);
+void   repro_sum_prepare(struct repro_sum * s);
+double repro_sum_value  (const struct repro_sum * s);
+
+#ifdef _OPENMP
+//! Reduction of the exact sums of the threads, e.g. 'reduction(rsum:s)'.
+#pragma omp declare reduction(rsum : struct repro_sum : repro_sum_merge(&omp_out, &omp_in)) initializer(repro_sum_init(&omp_priv))
+#endif
 
 //////////////////////////
 // mat_algo.c
@@ -37,6 +119,87 @@ void mat_sub(const double A[], const double B[], double C[], const int m,
 
 int rinv(double a[], const int n);
 
+//////////////////////////
+// phase_timer.c
+//////////////////////////
+//! Phases of a time step timed by the phase timers.
+enum phase_timer_id {PT_SLOPE, PT_BOUND, PT_SOLVE, PT_FLUX, PT_UPDATE, PT_CFL, PT_IO, PT_NUM};
+
+double wall_time(void);
+void phase_timer_start(const int ph);
+void phase_timer_stop (const int ph);
+void phase_timer_report(void);
+double phase_timer_get(const int ph, long * count, const char ** name);
+long peak_rss_kb(void);
+//////////////////////////
+// phase_trace.c
+//////////////////////////
+//! Spans of the threads in the trace of the phases, besides the phases of the phase timers.
+enum phase_trace_id {TR_FLUX_X = PT_NUM, TR_FLUX_Y, TR_NUM};
+
+void phase_trace_open (const char * file, const int sample, const long cap, const int pid);
+void phase_trace_event(const int id, const int ph, const double t0, const double t1);
+double phase_trace_tic(void);
+void phase_trace_toc  (const int ph, const double t0);
+void phase_trace_step (const int step);
+void phase_trace_close(void);
+
+//////////////////////////
+// live_publish.c
+//////////////////////////
+void live_publish_open (const char * name, const double interval, const int stride);
+int  live_publish_due  (void);
+double * live_publish_buffer(const size_t n);
+void live_publish_frame(const int step, const double time, const int n_f, const char * const name[],
+			double * const * const v[], const int M, const int N);
+void live_publish_close(void);
+
+//////////////////////////
+// mem_account.c
+//////////////////////////
+//! Subsystems of the accounted memory.
+enum mem_account_id {MA_SNAPSHOT, MA_SLOPE, MA_INTERFACE, MA_FLUX, MA_MESH, MA_OTHER, MA_NUM};
+
+void mem_account(const int tag, const char * field, const long nbytes);
+long mem_account_current(const int tag);
+long mem_account_peak(const int tag);
+void mem_account_report(const char * title, const int by_field);
+
+//////////////////////////
+// thread_place.c
+//////////////////////////
+void thread_place(const int policy, const int huge);
+void place_huge_advise(void * p, const size_t bytes);
+
+//////////////////////////
+// perf_counter.c
+//////////////////////////
+void perf_counter_start (const int ph);
+void perf_counter_stop  (const int ph);
+void perf_counter_report(const char * const name[], const double t[]);
+
+/**
+ * @brief Start/Stop the timer of a phase, removed by the macro NOPHASETIMER.
+ */
+#ifdef NOPHASETIMER
+#define PHASE_TIC(ph) ((void)0)
+#define PHASE_TOC(ph) ((void)0)
+#else
+#define PHASE_TIC(ph) phase_timer_start(ph)
+#define PHASE_TOC(ph) phase_timer_stop(ph)
+#endif
+/**
+ * @brief Begin/End the span 't0' of a phase on the calling thread in the trace of the phases (phase_trace.c),
+ *        such as a part of a parallel loop, removed by the macro NOPHASETIMER.
+ */
+#ifdef NOPHASETIMER
+#define PHASE_SPAN_BEGIN(t0)     ((void)0)
+#define PHASE_SPAN_END(ph, t0)   ((void)0)
+#else
+#define PHASE_SPAN_BEGIN(t0)     const double t0 = phase_trace_tic()
+#define PHASE_SPAN_END(ph, t0)   phase_trace_toc(ph, t0)
+#endif
+
 
 /**
  * @brief Minmod limiter function of two variables.
@@ -72,4 +235,54 @@ inline double minmod3(const double s_L, const double s_R, const double s_m)
 	return s_L;
 }
 
+#ifdef _OPENMP
+#define MINMOD_SIMD _Pragma("omp simd")
+#else
+#define MINMOD_SIMD
+#endif
+/**
+ * @brief The minmod limiter of the slopes s[j] of the cells j0 <= j < j1 in a loop without branches on the cells.
+ * @details SL and SR are the expressions in j of the left and right slopes of the cell j.
+ *          The choice between minmod3() and minmod2() is hoisted out of the loop,
+ *          so that the loop over the contiguous arrays is vectorised.
+ */
+#define MINMOD_LOOP(i_f_var_get, alpha, j, j0, j1, s, SL, SR)		\
+    do {								\
+	if (i_f_var_get)						\
+	    {								\
+		MINMOD_SIMD						\
+		for (int j = (j0); j < (j1); ++j)			\
+		    (s)[j] = minmod3((alpha)*(SL), (alpha)*(SR), (s)[j]); \
+	    }								\
+	else								\
+	    {								\
+		MINMOD_SIMD						\
+		for (int j = (j0); j < (j1); ++j)			\
+		    (s)[j] = minmod2((SL), (SR));			\
+	    }								\
+    } while (0)
+
+/**
+ * @brief The loop of the macro G(B_L, B_R) over the interfaces jb <= j < jn of the m cells, whose boundary interfaces
+ *        j = 0 (G(1, 0)) and j = m (G(0, 1)) are peeled out of the loop.
+ * @details G gives the interface j with the constant flags of the boundaries B_L and B_R, so that the branches of
+ *          the boundary data are removed by the compiler from the interior interfaces (G(0, 0)).
+ */
+#define IFACE_PEEL_LOOP(j, jb, jn, m, G)				\
+    do {								\
+	j = (jb);							\
+	if (j == 0)							\
+	    {								\
+		G(1, 0);						\
+		j++;							\
+	    }								\
+	for ( ; j < MIN((jn), (m)); ++j)				\
+	    G(0, 0);							\
+	if ((jn) > (m))							\
+	    {								\
+		j = (m);						\
+		G(0, 1);						\
+	    }								\
+    } while (0)
+
 #endif
@@ -31,6 +31,27 @@
 #define RADIAL_BASICS
 #endif
 
+/**
+ * @def ACC_ROUTINE_SEQ
+ * @brief Declare the following function as a sequential device routine of OpenACC, which is called in the device loops.
+ */
+#ifdef _OPENACC
+#define ACC_ROUTINE_SEQ _Pragma("acc routine seq")
+#else
+#define ACC_ROUTINE_SEQ
+#endif
+
+/**
+ * @def ERR_PRINTF
+ * @brief Print an error message in the routines which are also called in the device loops
+ *        (stdout of the device of OpenACC, stderr on the host).
+ */
+#ifdef _OPENACC
+#define ERR_PRINTF(...) printf(__VA_ARGS__)
+#else
+#define ERR_PRINTF(...) fprintf(stderr, __VA_ARGS__)
+#endif
+
 //! If the system does not set, the default largest value can be seen as zero is EPS.
 #ifndef EPS
 #define EPS 1e-9
@@ -41,12 +62,32 @@
 #define N_CONF 400
 #endif
 
-extern double config[]; //!< Initial configuration data array.
+//! RUN ConTeXt of one simulation.
+typedef struct run_ctx {
+	double conf[N_CONF]; //!< Initial configuration data array of the run.
+} Run_Context;
+
+extern struct run_ctx run_ctx_global; //!< Run context of the process.
+#ifdef _OPENACC
+#pragma acc declare create(run_ctx_global) // read by the device routines of the unstructured grids through 'config'
+#endif
+/**
+ * @def config
+ * @brief Initial configuration data array of the run context of the process.
+ * @note  It is kept for the compatibility of the codes which are not passed a run context.
+ */
+#define config (run_ctx_global.conf)
 
 
 //! pointer structure of FLUid VARiables array.
 typedef struct flu_var {
 	double * RHO,   * U,   * V,   * P;
+	/**
+	 * @brief Mass fractions of the K = config[71] passively advected species in one block [K][n_Y] (NULL: No species).
+	 * @details The mass fraction of the s-th species on the j-th cell is Y[s*n_Y + j].
+	 */
+	double * Y;
+	int n_Y; //!< Number of the values of a species in 'Y' (the stride of the rows).
 #ifdef MULTIFLUID_BASICS
 	double * Z_a;
 	double * PHI, * gamma;
@@ -57,15 +98,29 @@ typedef struct flu_var {
 } Fluid_Variable;
 
 
+#ifdef  MIXED_PRECISION
+#undef  MIXED_PRECISION
+/**
+ * @def MIXED_PRECISION
+ * @brief Switch whether to store the slopes and interfacial values of structural grids in single precision.
+ */
+#define MIXED_PRECISION
+//! REAL number type of the slopes and interfacial values STOREd on structural grids.
+typedef float  Real_Store;
+#else
+//! REAL number type of the slopes and interfacial values STOREd on structural grids.
+typedef double Real_Store;
+#endif
+
 //! pointer structure of VARiables on STRUctural computational grid CELLs.
 typedef struct cell_var_stru {
 	double **    E;                      //!< specific total energy.
 	double **  RHO, **  U, **  V, **  P; //!< density, velocity components in direction x and y, pressure.
 	double * d_rho, * d_u, * d_v, * d_p; //!< spatial derivatives in one dimension.
-	double **s_rho, **s_u, **s_v, **s_p; //!< spatial derivatives in coordinate x (slopes).
-	double **t_rho, **t_u, **t_v, **t_p; //!< spatial derivatives in coordinate y (slopes).
-	double **rhoIx, **uIx, **vIx, **pIx; //!< interfacial variable values in coordinate x at t_{n+1}.
-	double **rhoIy, **uIy, **vIy, **pIy; //!< interfacial variable values in coordinate y at t_{n+1}.
+	Real_Store **s_rho, **s_u, **s_v, **s_p; //!< spatial derivatives in coordinate x (slopes).
+	Real_Store **t_rho, **t_u, **t_v, **t_p; //!< spatial derivatives in coordinate y (slopes).
+	Real_Store **rhoIx, **uIx, **vIx, **pIx; //!< interfacial variable values in coordinate x at t_{n+1}.
+	Real_Store **rhoIy, **uIy, **vIy, **pIy; //!< interfacial variable values in coordinate y at t_{n+1}.
 	double **F_rho, **F_e, **F_u, **F_v; //!< numerical fluxes at (x_{j-1/2}, t_{n}).
 	double **G_rho, **G_e, **G_u, **G_v; //!< numerical fluxes at (y_{j-1/2}, t_{n}).
 #ifdef MULTIFLUID_BASICS
@@ -82,14 +137,34 @@ typedef struct cell_var {
 	 *  @arg  cell_cell[i][j](j>0), serial number of j-th adjacent cell to the i-th cell.
 	 */
 	int    **cell_cell;  
+	/**
+	 * @brief Compressed sparse row (CSR) offsets of the interfaces of the grid cells.
+	 * @details The interfacial arrays (cell_cell, n_x, n_y, F_rho, …) store the values of all the grid cells in one block v[0],
+	 *          and v[k] = v[0] + face_off[k]. The number of interfaces of the k-th cell is face_off[k+1] - face_off[k].
+	 */
+	int    * face_off;
 	double * vol;        //!< area(volume) of each grid cell.
 	double **n_x, **n_y; //!< x- and y-coordinates of the interfacial unit normal vector.
 	double * X_c, * Y_c; //!< x- and y-coordinates of the center point of grid cells.
+	/**
+	 * @brief Geometry of the interfaces, FACE_GEOM values {length, delta_x, delta_y, delta_x_R, delta_y_R} of the interface CSR_FACE(cv, k, j).
+	 * @details delta_x/y (delta_x/y_R) are the x-/y-distances from the centroid of the k-th (adjacent) cell to the midpoint of the interface.
+	 */
+	double * face_geom;
+	double * lsq_inv; //!< inverse matrices {M_00, M_01, M_10, M_11} of the least-squares normal equations of each cell (order > 1 & 30=1).
+	double * lsq_d;   //!< x- and y-distances {dx, dy} between the centroids of the k-th cell and the cell adjacent through interface CSR_FACE(cv, k, j).
 	double **   F_rho, **   F_e, **   F_u, **   F_v; //!< interfacial fluxes.
 	double *    U_rho, *    U_e, *    U_u, *    U_v; //!< conservative variables.
+	double *    U_RK; //!< conservative variables at t_{n} of the Runge-Kutta stages, NUM_CONS_RK blocks of num_cell values (53>0).
+	double * tau_loc; //!< local time steps of the grid cells in the steady-state mode (73>0 & 74=1).
 	double **   RHO_p, **   U_p, **   V_p, **   P_p;
 	double *gradx_rho, *gradx_e, *gradx_u, *gradx_v; //!< spatial derivatives in coordinate x (gradients).
 	double *grady_rho, *grady_e, *grady_u, *grady_v; //!< spatial derivatives in coordinate y (gradients).
+	/**
+	 * @brief Partial densities ρY of the advected species, the partial densities at t_{n} of the Runge-Kutta stages (53>0)
+	 *        and the gradients of the mass fractions (order > 1), in the blocks [K][n_Y] of the rows of 'FV->Y'.
+	 */
+	double *U_Y, *U_Y_RK, *gradx_Y, *grady_Y;
 #ifdef MULTIFLUID_BASICS
 	double **F_e_a,   *U_e_a,   **Z_a_p,   *gradx_z_a,   *grady_z_a;   //!< Total energy OR volume fraction of fluid a.
 	double **F_phi,   *U_phi,   **PHI_p,   *gradx_phi,   *grady_phi;   //!< Mass fraction of fluid a.
@@ -111,6 +186,50 @@ typedef struct cell_var {
 #endif
 } Cell_Variable;
 
+/**
+ * @name Accessors of the flat (CSR) interfacial arrays of the unstructured grid cells.
+ * @details E.g., the flux of the j-th interface of the k-th cell is cv->F_rho[0][CSR_FACE(cv, k, j)].
+ */
+///@{
+#define CSR_FACE(cv, k, j) ((cv)->face_off[k] + (j))                 //!< Serial number of the j-th interface of the k-th cell.
+#define FACE_GEOM 5                                                  //!< Number of the values of an interface in 'face_geom'.
+#ifdef MULTIFLUID_BASICS
+#define NUM_CONS_RK 7 //!< Number of the conservative variables {U_rho, U_e, U_u, U_v, U_e_a, U_phi, U_gamma} in 'U_RK'.
+#else
+#define NUM_CONS_RK 4 //!< Number of the conservative variables {U_rho, U_e, U_u, U_v} in 'U_RK'.
+#endif
+#define CSR_NUM(cv, k)     ((cv)->face_off[(k)+1] - (cv)->face_off[k]) //!< Number of the interfaces of the k-th cell.
+#define CSR_PT_N(cp, k, j) ((cp)[k][(j)+1])                          //!< Starting node of the j-th interface of the k-th cell.
+#define CSR_PT_P(cp, k, j) ((cp)[k][(j) == (cp)[k][0]-1 ? 1 : (j)+2]) //!< Ending node of the j-th interface of the k-th cell.
+///@}
+
+/**
+ * @brief list of the unique interFACEs between unstructured computational grid cells.
+ * @details The interface is the face_L-th one of the owner cell cell_L, and its normal vector is cv->n_x/n_y[cell_L][face_L].
+ *          It is the face_R-th interface of the neighbour cell cell_R, whose flux is opposite to that of the owner cell.
+ */
+typedef struct face_var {
+	int num_face;           //!< number of the interfaces.
+	int *cell_L, *face_L;   //!< owner cell and the serial number of the interface on it.
+	int *cell_R, *face_R;   //!< neighbour cell and the serial number of the interface on it (-1: boundary or periodic interface).
+} Face_Variable;
+
+/**
+ * @brief list of the unstructured grid cells around the grid NODEs, to update the geometry of the moving grids incrementally.
+ * @details The grid movement writes the displacements of the nodes in dX/dY, and geom_move_unstruct() moves the nodes
+ *          and updates the geometry of the cells around the moved nodes only.
+ */
+typedef struct node_var {
+	int *cell_off;          //!< compressed sparse row (CSR) offsets of the cells around each node.
+	int *cell;              //!< cells around each node.
+	double *dX, *dY;        //!< x- and y-displacements of the nodes in the step, reset to zero when they are applied.
+	int num_moved;          //!< number of the cells whose nodes moved in the last update.
+	int *moved;             //!< cells whose nodes moved, followed by their neighbours whose interfacial geometry changed.
+	char *mark;             //!< flags of the cells listed in 'moved'.
+	double *vol_gcl;        //!< areas of the moved cells given by the geometric conservation law.
+	double gcl;             //!< maximum relative residual of the geometric conservation law in the last update.
+} Node_Variable;
+
 
 //! Interfacial Fluid VARiables.
 typedef struct i_f_var {
@@ -142,6 +261,90 @@ typedef struct i_f_var {
 } Interface_Fluid_Variable;
 
 
+//! Interfacial Fluid VARiables of a block of interfaces on one side (structure of arrays).
+typedef struct i_f_var_batch {
+	double * RHO, * U, * P;       //!< primitive variable values at t_{n}.
+	double * s_rho, * s_u, * s_p; //!< spatial derivatives (ξ-Lagrangian OR x-Eulerian).
+	double * gamma;               //!< specific heat ratio.
+	double * V;                   //!< y-velocity of 2-D flow (NULL: 1-D flow).
+	double * n_x, * n_y;          //!< unit normal vector coordinates of 2-D flow, on the left side.
+} Interface_Fluid_Variable_Batch;
+
+
+//! Derived constants of a perfect GAS with a constant specific heat ratio (single-fluid flow).
+typedef struct gamma_const {
+	double gamma; //!< specific heat ratio γ.
+	double zeta;  //!< (γ-1)/(γ+1).
+	double zts;   //!< ζ^2.
+	double e_rho; //!< exponent 1/γ of the density along an isentrope.
+	double e_c;   //!< exponent (γ-1)/(2γ) of the sound speed along an isentrope.
+	double e_p;   //!< exponent γ/(γ-1) of the pressure at a sonic point.
+	double e_s;   //!< exponent 2γ/(γ-1) of the pressure ratio to the sound speed ratio along an isentrope.
+	double e_A;   //!< exponent 1/(2ζ) of the CRW coefficients.
+	double e_B;   //!< exponent (1+ζ)/ζ of the CRW coefficients.
+	double e_D;   //!< exponent (3γ-1)/(2(γ+1)) of the CRW coefficient in the Lagrangian GRP solver.
+	//! Twice the exponents e_rho, e_c, e_p, e_s, e_A, e_B, e_D if they are half-integers, 0 otherwise (see gamma_pow()).
+	int h_rho, h_c, h_p, h_s, h_A, h_B, h_D;
+} Gamma_Constant;
+
+
+//! Initial guesses of the star pressure in the exact Riemann solvers.
+enum riemann_guess_id {RG_PVRS, RG_TRRS, RG_TSRS, RG_WARM, RG_NUM};
+
+//! Paths of the quasi-1D GRP solver: trivial case, acoustic approximation without iteration, nonlinear GRP.
+enum grp_path_id {GP_TRIVIAL, GP_ACOUSTIC, GP_NONLINEAR, GP_NUM};
+
+//! STATistics of the exact Riemann solvers and of the paths of the GRP solvers.
+typedef struct riemann_stat {
+	long solve;        //!< number of the solutions.
+	long iter;         //!< number of the iterations.
+	long exact;        //!< solutions given by the initial guess without any iteration.
+	long guess[RG_NUM]; //!< initial guesses (enum riemann_guess_id).
+	long wave[4];      //!< wave patterns: rarefaction-rarefaction, rarefaction-shock, shock-rarefaction, shock-shock.
+	long grp[GP_NUM];  //!< interfaces of the quasi-1D GRP solver on the paths (enum grp_path_id).
+	long hyb[2];       //!< interfaces of the hybrid GRP flux (config[89]): smooth, flagged.
+} Riemann_Statistics;
+
+
+//! Number of configuration supplements in each line of the ensemble specification.
+#ifndef N_ENS_CONF
+#define N_ENS_CONF 16
+#endif
+
+//! one CASE (line) of the ENSemble specification of 1-D runs.
+typedef struct ens_case {
+	char example[256];             //!< name of the test example (initial data).
+	char order[40];                //!< order of numerical scheme[_scheme name].
+	char coord[8];                 //!< Lagrangian/Eulerian coordinate framework (= LAG or EUL).
+} Ensemble_Case;
+
+//! one MEMBER (run) of the ENSemble of 1-D runs and its results.
+typedef struct ens_member {
+	int c;                          //!< index of the case in the ensemble specification.
+	int n_conf;                     //!< number of configuration supplements.
+	int    i_conf[N_ENS_CONF];      //!< indexes of the supplemented configuration.
+	double v_conf[N_ENS_CONF];      //!< values of the supplemented configuration.
+	int status;                     //!< exit status code of the run.
+	int m;                          //!< number of the grids.
+	int steps;                      //!< number of the time steps.
+	double time, wall;              //!< final time and wall-clock time of the run.
+	double mass, mom, ene;          //!< total mass, momentum and energy at the final time.
+	double * X, * RHO, * U, * P;    //!< cell centers and fluid variables at the final time.
+} Ensemble_Member;
+
+//! CheckPoinT of a run: the list of the memory blocks holding the state of the time loop.
+typedef struct ckpt_var {
+	int n;                  //!< number of the memory blocks.
+	void ** p;              //!< addresses of the memory blocks.
+	long * size;            //!< sizes of the memory blocks in bytes.
+	char * buf;             //!< buffer of the checkpoint being written.
+	long buf_size;          //!< size of the buffer in bytes.
+	char * add;             //!< address of the checkpoint file.
+	void * thread;          //!< handle of the thread writing the buffer (NULL: no writing).
+	int err;                //!< whether there is an error in the list or in the last writing.
+} Checkpoint_Variable;
+
+
 //! Fluid VARiables at Boundary in one direction.
 typedef struct b_f_var {
 	double    H;              //!< cell width of the ghost grid at boundary.
@@ -156,6 +359,7 @@ typedef struct mesh_var {
 	int num_pt;      //!< Total number of grid nodes.
 	int num_ghost;   //!< Total number of ghost grid cells.
 	int **cell_pt;   //!< Serial number of each grid node on a grid cell in the clockwise direction.
+	int * cell_pt_csr; //!< Block of the rows {number of nodes, nodes} of 'cell_pt' stored consecutively (NULL: one allocation per row).
 	int * cell_type; //!< @todo Grid cell type read from mesh file '*.msh' 
 	/**
 	 * @brief num_border[0] is the total number of connected boundaries on the entire computational domain.
@@ -172,10 +376,45 @@ typedef struct mesh_var {
 	int *period_cell; //!< Serial number of ghost grid cells at the periodic boundary.
 	double *normal_v; //!< @todo Normal velocity on grid cell interfaces at the boundary.
 	double *X, *Y;    //!< x- and y-coordinates of the grid nodes with fixed serial number.
-	//! Pointer to the boundary condition function.
-	void (*bc)(struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, double t);
+	int *cell_perm;   //!< Serial number in the mesh file of each inner grid cell renumbered by mesh_reorder() (NULL: file order).
+	int *pt_perm;     //!< Serial number in the mesh file of each grid node renumbered by mesh_reorder() (NULL: file order).
+	double *geom;     //!< Areas, x- and y-centroids of the grid cells, 3 blocks, of the preprocessed mesh file (NULL: computed by the scheme).
+	int *cell_cell_csr; //!< Relationships between the cells of the preprocessed mesh file, in the layout of 'cell_pt_csr' (NULL: computed by cell_rel()).
+	/**
+	 * @brief Numbers of the cells in the x- and y-directions of the logically rectangular grids of quad_mesh() (0: unstructured grids).
+	 * @details The cell k = i + j*quad_nx lies in column i and row j, and its interfaces 0-3 are the lower, right, upper and left ones,
+	 *          so that the relationships between the cells are implicit. The grids with ghost cells, renumbered or partitioned are untagged.
+	 */
+	int quad_nx, quad_ny;
+	//! Pointer to the boundary condition function, which fills the parts (enum ghost_part) of the variables on the ghost cells.
+	void (*bc)(struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, double t, int part);
 } Mesh_Variable;
 
+//! Parts of the variables on the ghost cells filled by the boundary condition function 'mv->bc'.
+enum ghost_part {
+	GHOST_VAL  = 1, //!< conservative and fluid variables.
+	GHOST_GRAD = 2, //!< spatial derivatives (slopes) of the reconstruction.
+	GHOST_ALL  = 3  //!< all of them.
+};
+
+//! Staging SLOT of the asynchronous OUTput of the fluid variables on unstructured grids.
+typedef struct out_slot {
+	struct flu_var FV;             //!< copy of the fluid variables being written.
+	double time;                   //!< plotting time of the copy.
+	int plot;                      //!< files being written (bits 1: Tecplot, 2: VTK, 4: VTU).
+	void * thread;                 //!< handle of the thread writing the copy (NULL: no writing).
+	const struct mesh_var * mv;    //!< meshing variables of the run.
+	const char * problem;          //!< name of the numerical results for the test problem.
+} Output_Slot;
+
+//! Double-buffered QUEUE of the asynchronous OUTput on unstructured grids.
+typedef struct out_queue {
+	struct out_slot slot[2];       //!< staging slots, filled in turn.
+	int next;                      //!< index of the slot to be filled next.
+	int num_cell;                  //!< number of the grid cells.
+	_Bool sync;                    //!< whether the output is written synchronously.
+} Output_Queue;
+
 
 #ifdef RADIAL_BASICS
 //! RADIALly symmetric MESHing VARiables.
@@ -0,0 +1,38 @@
+/**
+ * @file arena.h
+ * @brief This file is a header file of the workspace arenas after the interface 'Arena' in the book 'C Interfaces and Implementations'.
+ * @details This header file declares functions in the source file 'src_cii/arena.c'.
+ */
+
+#ifndef ARENA_INCLUDED
+#define ARENA_INCLUDED
+#include "except.h"
+#define T Arena_T
+typedef struct Arena *T; // the tag differs from the type name in C++
+extern const Except_T Arena_Failed;
+extern T     Arena_new    (long nbytes,
+	const char *file, int line);
+extern void  Arena_dispose(T *ap);
+extern void  Arena_reserve(T arena, long nbytes,
+	const char *file, int line);
+extern void *Arena_alloc  (T arena, long nbytes,
+	const char *file, int line);
+extern void *Arena_calloc (T arena, long count, long nbytes,
+	const char *file, int line);
+extern void  Arena_free   (T arena);
+extern long  Arena_peak   (T arena);
+extern long  Arena_size   (T arena);
+extern T     Arena_workspace(void);
+extern void  Arena_workspace_report (void);
+extern void  Arena_workspace_dispose(void);
+#define ARENA_ALIGN 64 //!< Alignment in bytes of the region and of each allocation of an arena.
+#define ARENA_NEW(nbytes) \
+	Arena_new((nbytes), __FILE__, __LINE__)
+#define ARENA_RESERVE(arena, nbytes) \
+	Arena_reserve((arena), (nbytes), __FILE__, __LINE__)
+#define ARENA_ALLOC(arena, nbytes) \
+	Arena_alloc((arena), (nbytes), __FILE__, __LINE__)
+#define ARENA_CALLOC(arena, count, nbytes) \
+	Arena_calloc((arena), (count), (nbytes), __FILE__, __LINE__)
+#undef T
+#endif
@@ -14,7 +14,11 @@ extern "C" {
 ///////////////////////////////////
 // VIPLimiter.cpp
 ///////////////////////////////////
+#define VIP_NEIGH_MAX 4 //!< Maximum number of the face neighbor cells of the VIP limiter.
+
 double useVIPLimiter(const int neigh_cell_num, const double Vave[][2], double* V0, double* Vp);
+void   useVIPLimiter_batch(const int n_cell, const int neigh_cell_num, const int n_p,
+			   const double Vave[][VIP_NEIGH_MAX][2], double V0[][2], double Vp[][2], double lambda[]);
 #ifdef __cplusplus
 }
 #endif
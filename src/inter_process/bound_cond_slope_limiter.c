@@ -8,10 +8,12 @@
 
 #include "../include/var_struc.h"
 #include "../include/inter_process.h"
+#include "../include/tools.h"
 
 
 /**
  * @brief This function apply the minmod limiter to the slope in one dimension.
+ * @param[in] ctx:        Pointer to the run context.
  * @param[in] NO_h:       Whether there are moving grid point coordinates.
  *                  - true: There are moving spatial grid point coordinates *X.
  *                  - false: There is fixed spatial grid length.
@@ -27,17 +29,18 @@
  *            - \b double \c *X: Array of moving spatial grid point coordinates.
  * @return find_bound:    Whether the boundary conditions have been found.
  */
-_Bool bound_cond_slope_limiter(const _Bool NO_h, const int m, const int nt, struct cell_var_stru * CV,
+_Bool bound_cond_slope_limiter(const struct run_ctx * ctx, const _Bool NO_h, const int m, const int nt, struct cell_var_stru * CV,
 			       struct b_f_var * bfv_L, struct b_f_var * bfv_R, _Bool find_bound, const _Bool Slope, const double t_c, ...)
 {
     va_list ap;
     va_start(ap, t_c);
-    int const bound = (int)(config[17]);// the boundary condition in x-direction
-    double const h  = config[10];       // the length of the initial x-spatial grids
+    int const bound = (int)(ctx->conf[17]);// the boundary condition in x-direction
+    double const h  = ctx->conf[10];       // the length of the initial x-spatial grids
     double * X = NULL;
     if (NO_h)
 	X  = va_arg(ap, double *);
 
+    PHASE_TIC(PT_BOUND);
     switch (bound)
 	{
 	case -1: // initial boudary conditions
@@ -79,6 +82,8 @@ _Bool bound_cond_slope_limiter(const _Bool NO_h, const int m, const int nt, stru
 	    break;
 	default:
 	    printf("No suitable boundary coditions in x direction!\n");
+	    PHASE_TOC(PT_BOUND);
+	    va_end(ap);
 	    return false;
 	}
 
@@ -99,22 +104,19 @@ _Bool bound_cond_slope_limiter(const _Bool NO_h, const int m, const int nt, stru
 		    break;
 		}
 	}
+    // the ghost cells inside the grids decomposed into parts
+    halo_state_1D(m, nt, CV, X, h, bfv_L, bfv_R);
+    PHASE_TOC(PT_BOUND);
 //=================Initialize slopes=====================
       // Reconstruct slopes
     if (Slope)
 	{
-    if (NO_h)
-	{
-	    minmod_limiter(NO_h, m, find_bound, CV->d_u,   CV->U[nt],   bfv_L->U,   bfv_R->U,   bfv_L->H, bfv_R->H, X);
-	    minmod_limiter(NO_h, m, find_bound, CV->d_p,   CV->P[nt],   bfv_L->P,   bfv_R->P,   bfv_L->H, bfv_R->H, X);
-	    minmod_limiter(NO_h, m, find_bound, CV->d_rho, CV->RHO[nt], bfv_L->RHO, bfv_R->RHO, bfv_L->H, bfv_R->H, X);
-	}
-	else
-	{
-	    minmod_limiter(NO_h, m, find_bound, CV->d_u,   CV->U[nt],   bfv_L->U,   bfv_R->U,   h);
-	    minmod_limiter(NO_h, m, find_bound, CV->d_p,   CV->P[nt],   bfv_L->P,   bfv_R->P,   h);
-	    minmod_limiter(NO_h, m, find_bound, CV->d_rho, CV->RHO[nt], bfv_L->RHO, bfv_R->RHO, h);
-	}
+    PHASE_TIC(PT_SLOPE);
+    double * const s_lim[3] = {CV->d_u,   CV->d_p,   CV->d_rho};
+    const double * const U_lim[3] = {CV->U[nt], CV->P[nt], CV->RHO[nt]};
+    const double UL_lim[3] = {bfv_L->U, bfv_L->P, bfv_L->RHO};
+    const double UR_lim[3] = {bfv_R->U, bfv_R->P, bfv_R->RHO};
+    minmod_limiter_vars(ctx, NO_h, m, find_bound, 3, s_lim, U_lim, UL_lim, UR_lim, NO_h ? bfv_L->H : h, bfv_R->H, X);
 
 	    switch(bound)
 		{
@@ -130,6 +132,8 @@ _Bool bound_cond_slope_limiter(const _Bool NO_h, const int m, const int nt, stru
 		    bfv_L->SU   =   CV->d_u[0];
 		    break;
 		}
+	    halo_slope_1D(m, CV, bfv_L, bfv_R);
+	    PHASE_TOC(PT_SLOPE);
 	}
     va_end(ap);
     return true;
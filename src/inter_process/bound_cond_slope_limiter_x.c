@@ -7,10 +7,121 @@
 
 #include "../include/var_struc.h"
 #include "../include/inter_process.h"
+#include "../include/tools.h"
 
 
+/**
+ * @brief This function applies the minmod limiter to the x-slopes of the cells of the column j.
+ * @details The interior columns between the adjacent columns j-1 and j+1 are limited along y (the contiguous index i)
+ *          by minmod_limiter_row(), and the columns next to the left/right boundary cell by cell.
+ */
+static void slope_limiter_x_col(const double alpha, const _Bool find_bound_x, const int m, const int n, const int nt, struct cell_var_stru * CV,
+				const struct b_f_var * bfv_L, const struct b_f_var * bfv_R, const double h_x, const int j)
+{
+    int i;
+    if (j && j < m-1)
+	{
+	    minmod_limiter_row(alpha, find_bound_x, n, CV->s_u[j],   CV[nt].U[j-1],   CV[nt].U[j],   CV[nt].U[j+1],   h_x);
+	    minmod_limiter_row(alpha, find_bound_x, n, CV->s_v[j],   CV[nt].V[j-1],   CV[nt].V[j],   CV[nt].V[j+1],   h_x);
+	    minmod_limiter_row(alpha, find_bound_x, n, CV->s_p[j],   CV[nt].P[j-1],   CV[nt].P[j],   CV[nt].P[j+1],   h_x);
+	    minmod_limiter_row(alpha, find_bound_x, n, CV->s_rho[j], CV[nt].RHO[j-1], CV[nt].RHO[j], CV[nt].RHO[j+1], h_x);
+	}
+    else
+	for(i = 0; i < n; ++i)
+	    {
+		minmod_limiter_2D_x_cell(alpha, find_bound_x, m, j, i, CV->s_u,   CV[nt].U,   bfv_L[i].U,   bfv_R[i].U,   h_x);
+		minmod_limiter_2D_x_cell(alpha, find_bound_x, m, j, i, CV->s_v,   CV[nt].V,   bfv_L[i].V,   bfv_R[i].V,   h_x);
+		minmod_limiter_2D_x_cell(alpha, find_bound_x, m, j, i, CV->s_p,   CV[nt].P,   bfv_L[i].P,   bfv_R[i].P,   h_x);
+		minmod_limiter_2D_x_cell(alpha, find_bound_x, m, j, i, CV->s_rho, CV[nt].RHO, bfv_L[i].RHO, bfv_R[i].RHO, h_x);
+	    }
+}
+
+/**
+ * @brief This function sets the x-slopes of the ghost cells at the downside/upper boundary of the column j.
+ */
+ACC_ROUTINE_SEQ
+static void slope_bound_x_col(const int bound_y, const int n, const int j, const struct cell_var_stru * CV,
+			      struct b_f_var * bfv_D, struct b_f_var * bfv_U)
+{
+    switch(bound_y)
+	{
+	case -2: case -4: case -24: // reflective OR free boundary conditions in y-direction
+	    bfv_D[j].SU   =   CV->s_u[j][0];   bfv_U[j].SU   =   CV->s_u[j][n-1];
+	    bfv_D[j].SV   =   CV->s_v[j][0];   bfv_U[j].SV   =   CV->s_v[j][n-1];
+	    bfv_D[j].SP   =   CV->s_p[j][0];   bfv_U[j].SP   =   CV->s_p[j][n-1];
+	    bfv_D[j].SRHO = CV->s_rho[j][0];   bfv_U[j].SRHO = CV->s_rho[j][n-1];
+	    break;
+	case -7: // periodic boundary conditions in y-direction
+	    bfv_D[j].SU   =   CV->s_u[j][n-1]; bfv_U[j].SU   =   CV->s_u[j][0];
+	    bfv_D[j].SV   =   CV->s_v[j][n-1]; bfv_U[j].SV   =   CV->s_v[j][0];
+	    bfv_D[j].SP   =   CV->s_p[j][n-1]; bfv_U[j].SP   =   CV->s_p[j][0];
+	    bfv_D[j].SRHO = CV->s_rho[j][n-1]; bfv_U[j].SRHO = CV->s_rho[j][0];
+	    break;
+	}
+}
+
+/**
+ * @brief This function sets the x-slopes of the ghost cells at the left/right boundary
+ *        from those of the columns 0 and m-1.
+ * @param[in] ctx:        Pointer to the run context.
+ * @param[in] m:          Number of the x-grids: n_x.
+ * @param[in] n:          Number of the y-grids: n_y.
+ * @param[in] CV:         Structure of cell variable data.
+ * @param[in,out] bfv_L:  Fluid variables at left boundary.
+ * @param[in,out] bfv_R:  Fluid variables at right boundary.
+ */
+void slope_bound_x_edge(const struct run_ctx * ctx, const int m, const int n, const struct cell_var_stru * CV,
+			struct b_f_var * bfv_L, struct b_f_var * bfv_R)
+{
+    int const bound_x = (int)(ctx->conf[17]);// the boundary condition in x-direction
+    int i;
+#ifdef _OPENACC
+#pragma acc parallel loop default(present)
+#endif
+    for(i = 0; i < n; ++i)
+	switch(bound_x)
+	    {
+	    case -2: // reflective boundary conditions
+		bfv_L[i].SU   =   CV->s_u[0][i];   bfv_R[i].SU   =   CV->s_u[m-1][i];
+		break;
+	    case -7: // periodic boundary conditions
+		bfv_L[i].SU   =   CV->s_u[m-1][i]; bfv_R[i].SU   =   CV->s_u[0][i];
+		bfv_L[i].SV   =   CV->s_v[m-1][i]; bfv_R[i].SV   =   CV->s_v[0][i];
+		bfv_L[i].SP   =   CV->s_p[m-1][i]; bfv_R[i].SP   =   CV->s_p[0][i];
+		bfv_L[i].SRHO = CV->s_rho[m-1][i]; bfv_R[i].SRHO = CV->s_rho[0][i];
+		break;
+	    case -24: // reflective + free boundary conditions
+		bfv_L[i].SU   =   CV->s_u[0][i];
+		break;
+	    }
+}
+
+/**
+ * @brief This function applies the minmod limiter to the x-slopes of the columns j0 <= j < j1 of a tile in one thread,
+ *        and sets the x-slopes of their ghost cells at the downside/upper boundary.
+ * @details It is a task of the pipelined time steps of GRP_solver_2D_EUL_source(),
+ *          after the boundary conditions have been set by bound_cond_slope_limiter_x() without slopes.
+ *          The ghost cells at the left/right boundary are set by slope_bound_x_edge() after the tiles of the columns 0 and m-1.
+ * @param[in] j0, j1: The first and the last but one columns of the tile.
+ * @sa bound_cond_slope_limiter_x() for the other parameters.
+ */
+void slope_limiter_x_tile(const struct run_ctx * ctx, const int m, const int n, const int nt, struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R,
+			  struct b_f_var * bfv_D, struct b_f_var * bfv_U, const _Bool find_bound_x, const int j0, const int j1)
+{
+    int const bound_y = (int)(ctx->conf[18]);// the boundary condition in y-direction
+    double const h_x  = ctx->conf[10];       // the length of the initial x-spatial grids
+    double const alpha = ctx->conf[41];      // the paramater in slope limiters.
+    int j;
+    for(j = j0; j < j1; ++j)
+	{
+	    slope_limiter_x_col(alpha, find_bound_x, m, n, nt, CV, bfv_L, bfv_R, h_x, j);
+	    slope_bound_x_col(bound_y, n, j, CV, bfv_D, bfv_U);
+	}
+}
+
 /**
  * @brief This function apply the minmod limiter to the slope in the x-direction of two dimension.
+ * @param[in] ctx:        Pointer to the run context.
  * @param[in] m:          Number of the x-grids: n_x.
  * @param[in] n:          Number of the y-grids: n_y.
  * @param[in] nt:         Current plot time step for computing updates of conservative variables.
@@ -24,106 +135,114 @@
  * @param[in] t_c:        Time of current time step.
  * @return find_bound_x:  Whether the boundary conditions in x-direction have been found.
  */
-_Bool bound_cond_slope_limiter_x(const int m, const int n, const int nt, struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R,
+_Bool bound_cond_slope_limiter_x(const struct run_ctx * ctx, const int m, const int n, const int nt, struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R,
 				 struct b_f_var * bfv_D, struct b_f_var * bfv_U, _Bool find_bound_x, const _Bool Slope, const double t_c)
 {
-    int const bound_x = (int)(config[17]);// the boundary condition in x-direction
-    int const bound_y = (int)(config[18]);// the boundary condition in y-direction
-    double const h_x  = config[10];       // the length of the initial x-spatial grids
+    int const bound_x = (int)(ctx->conf[17]);// the boundary condition in x-direction
+    int const bound_y = (int)(ctx->conf[18]);// the boundary condition in y-direction
+    double const h_x  = ctx->conf[10];       // the length of the initial x-spatial grids
     int i, j;
+    PHASE_TIC(PT_BOUND);
+    switch (bound_x)
+	{
+	case -1: // initial boudary conditions
+	    if(!find_bound_x)
+		printf("Initial boudary conditions in x direction at time %g .\n", t_c);
+	    break;
+	case -2: // reflective boundary conditions
+	    if(!find_bound_x)
+		printf("Reflective boudary conditions in x direction.\n");
+	    break;
+	case -4: // free boundary conditions
+	    if(!find_bound_x)
+		printf("Free boudary conditions in x direction.\n");
+	    break;
+	case -7: // periodic boundary conditions
+	    if(!find_bound_x)
+		printf("Periodic boudary conditions in x direction.\n");
+	    break;
+	case -24: // reflective + free boundary conditions
+	    if(!find_bound_x)
+		printf("Reflective + Free boudary conditions in x direction.\n");
+	    break;
+	default:
+	    printf("No suitable boundary coditions in x direction!\n");
+	    PHASE_TOC(PT_BOUND);
+	    return false;
+	}
+#ifdef _OPENACC
+#pragma acc parallel loop default(present)
+#endif
     for(i = 0; i < n; ++i)
 	switch (bound_x)
 	    {
 	    case -1: // initial boudary conditions
 		if(find_bound_x)
 		    break;
-		else if(!i)
-		    printf("Initial boudary conditions in x direction at time %g .\n", t_c);
 		bfv_L[i].U   =   CV->U[0][i]; bfv_R[i].U   =   CV->U[m-1][i];
 		bfv_L[i].V   =   CV->V[0][i]; bfv_R[i].V   =   CV->V[m-1][i];
 		bfv_L[i].P   =   CV->P[0][i]; bfv_R[i].P   =   CV->P[m-1][i];
 		bfv_L[i].RHO = CV->RHO[0][i]; bfv_R[i].RHO = CV->RHO[m-1][i];
 		break;
 	    case -2: // reflective boundary conditions
-		if(!find_bound_x && !i)
-		    printf("Reflective boudary conditions in x direction.\n");
 		bfv_L[i].U   = - CV[nt].U[0][i]; bfv_R[i].U   = - CV[nt].U[m-1][i];
 		bfv_L[i].V   =   CV[nt].V[0][i]; bfv_R[i].V   =   CV[nt].V[m-1][i];
 		bfv_L[i].P   =   CV[nt].P[0][i]; bfv_R[i].P   =   CV[nt].P[m-1][i];
 		bfv_L[i].RHO = CV[nt].RHO[0][i]; bfv_R[i].RHO = CV[nt].RHO[m-1][i];
 		break;
 	    case -4: // free boundary conditions
-		if(!find_bound_x && !i)
-		    printf("Free boudary conditions in x direction.\n");
 		bfv_L[i].U   =   CV[nt].U[0][i]; bfv_R[i].U   =   CV[nt].U[m-1][i];
 		bfv_L[i].V   =   CV[nt].V[0][i]; bfv_R[i].V   =   CV[nt].V[m-1][i];
 		bfv_L[i].P   =   CV[nt].P[0][i]; bfv_R[i].P   =   CV[nt].P[m-1][i];
 		bfv_L[i].RHO = CV[nt].RHO[0][i]; bfv_R[i].RHO = CV[nt].RHO[m-1][i];
 		break;
 	    case -7: // periodic boundary conditions
-		if(!find_bound_x && !i)
-		    printf("Periodic boudary conditions in x direction.\n");
 		bfv_L[i].U   =   CV[nt].U[m-1][i]; bfv_R[i].U   =   CV[nt].U[0][i];
 		bfv_L[i].V   =   CV[nt].V[m-1][i]; bfv_R[i].V   =   CV[nt].V[0][i];
 		bfv_L[i].P   =   CV[nt].P[m-1][i]; bfv_R[i].P   =   CV[nt].P[0][i];
 		bfv_L[i].RHO = CV[nt].RHO[m-1][i]; bfv_R[i].RHO = CV[nt].RHO[0][i];
 		break;
 	    case -24: // reflective + free boundary conditions
-		if(!find_bound_x && !i)
-		    printf("Reflective + Free boudary conditions in x direction.\n");
 		bfv_L[i].U   = - CV[nt].U[0][i]; bfv_R[i].U   =   CV[nt].U[m-1][i];
 		bfv_L[i].V   =   CV[nt].V[0][i]; bfv_R[i].V   =   CV[nt].V[m-1][i];
 		bfv_L[i].P   =   CV[nt].P[0][i]; bfv_R[i].P   =   CV[nt].P[m-1][i];
 		bfv_L[i].RHO = CV[nt].RHO[0][i]; bfv_R[i].RHO = CV[nt].RHO[m-1][i];
 		break;
-	    default:
-		printf("No suitable boundary coditions in x direction!\n");
-		return false;
 	    }
+    // the ghost cells inside the grids decomposed into blocks
+    halo_state_x(m, n, CV + nt, bfv_L, bfv_R);
+    PHASE_TOC(PT_BOUND);
     if (Slope)
 	{
-#pragma omp parallel for  schedule(dynamic, 8)
-	    for(i = 0; i < n; ++i)
-		{
-		    minmod_limiter_2D_x(false, m, i, find_bound_x, CV->s_u,   CV[nt].U,   bfv_L[i].U,   bfv_R[i].U,   h_x);
-		    minmod_limiter_2D_x(false, m, i, find_bound_x, CV->s_v,   CV[nt].V,   bfv_L[i].V,   bfv_R[i].V,   h_x);
-		    minmod_limiter_2D_x(false, m, i, find_bound_x, CV->s_p,   CV[nt].P,   bfv_L[i].P,   bfv_R[i].P,   h_x);
-		    minmod_limiter_2D_x(false, m, i, find_bound_x, CV->s_rho, CV[nt].RHO, bfv_L[i].RHO, bfv_R[i].RHO, h_x);
-		} // End of parallel region
-
-	    for(i = 0; i < n; ++i)
-		switch(bound_x)
+	    PHASE_TIC(PT_SLOPE);
+	    double const alpha = ctx->conf[41]; // the paramater in slope limiters.
+	    /*
+	     * The x-slopes are limited column by column and along y (the contiguous index i) in a column,
+	     * as the y-slopes, so that both directions run over the unit-stride lines of the fields.
+	     */
+#ifdef _OPENACC
+#pragma acc parallel loop collapse(2) default(present)
+	    for(j = 0; j < m; ++j)
+		for(i = 0; i < n; ++i)
 		    {
-		    case -2: // reflective boundary conditions
-			bfv_L[i].SU   =   CV->s_u[0][i];   bfv_R[i].SU   =   CV->s_u[m-1][i];
-			break;
-		    case -7: // periodic boundary conditions
-			bfv_L[i].SU   =   CV->s_u[m-1][i]; bfv_R[i].SU   =   CV->s_u[0][i];
-			bfv_L[i].SV   =   CV->s_v[m-1][i]; bfv_R[i].SV   =   CV->s_v[0][i];
-			bfv_L[i].SP   =   CV->s_p[m-1][i]; bfv_R[i].SP   =   CV->s_p[0][i];
-			bfv_L[i].SRHO = CV->s_rho[m-1][i]; bfv_R[i].SRHO = CV->s_rho[0][i];
-			break;
-		    case -24: // reflective + free boundary conditions
-			bfv_L[i].SU   =   CV->s_u[0][i];
-			break;
-		    }
+			minmod_limiter_2D_x_cell(alpha, find_bound_x, m, j, i, CV->s_u,   CV[nt].U,   bfv_L[i].U,   bfv_R[i].U,   h_x);
+			minmod_limiter_2D_x_cell(alpha, find_bound_x, m, j, i, CV->s_v,   CV[nt].V,   bfv_L[i].V,   bfv_R[i].V,   h_x);
+			minmod_limiter_2D_x_cell(alpha, find_bound_x, m, j, i, CV->s_p,   CV[nt].P,   bfv_L[i].P,   bfv_R[i].P,   h_x);
+			minmod_limiter_2D_x_cell(alpha, find_bound_x, m, j, i, CV->s_rho, CV[nt].RHO, bfv_L[i].RHO, bfv_R[i].RHO, h_x);
+		    } // End of parallel region
+#else
+#pragma omp parallel for schedule(static)
+	    for(j = 0; j < m; ++j)
+		slope_limiter_x_col(alpha, find_bound_x, m, n, nt, CV, bfv_L, bfv_R, h_x, j);
+#endif
 
+	    slope_bound_x_edge(ctx, m, n, CV, bfv_L, bfv_R);
+#ifdef _OPENACC
+#pragma acc parallel loop default(present)
+#endif
 	    for(j = 0; j < m; ++j)
-		switch(bound_y)
-		    {
-		    case -2: case -4: case -24: // reflective OR free boundary conditions in y-direction
-			bfv_D[j].SU   =   CV->s_u[j][0];   bfv_U[j].SU   =   CV->s_u[j][n-1];
-			bfv_D[j].SV   =   CV->s_v[j][0];   bfv_U[j].SV   =   CV->s_v[j][n-1];
-			bfv_D[j].SP   =   CV->s_p[j][0];   bfv_U[j].SP   =   CV->s_p[j][n-1];
-			bfv_D[j].SRHO = CV->s_rho[j][0];   bfv_U[j].SRHO = CV->s_rho[j][n-1];
-			break;
-		    case -7: // periodic boundary conditions in y-direction
-			bfv_D[j].SU   =   CV->s_u[j][n-1]; bfv_U[j].SU   =   CV->s_u[j][0];
-			bfv_D[j].SV   =   CV->s_v[j][n-1]; bfv_U[j].SV   =   CV->s_v[j][0];
-			bfv_D[j].SP   =   CV->s_p[j][n-1]; bfv_U[j].SP   =   CV->s_p[j][0];
-			bfv_D[j].SRHO = CV->s_rho[j][n-1]; bfv_U[j].SRHO = CV->s_rho[j][0];
-			break;
-		    }
+		slope_bound_x_col(bound_y, n, j, CV, bfv_D, bfv_U);
+	    PHASE_TOC(PT_SLOPE);
 	}
     return true;
 }
@@ -7,10 +7,107 @@
 
 #include "../include/var_struc.h"
 #include "../include/inter_process.h"
+#include "../include/tools.h"
 
 
+/**
+ * @brief This function applies the minmod limiter to the y-slopes of the cells of the column j.
+ */
+static void slope_limiter_y_col(const double alpha, const _Bool find_bound_y, const int n, const int nt, struct cell_var_stru * CV,
+				const struct b_f_var * bfv_D, const struct b_f_var * bfv_U, const double h_y, const int j)
+{
+    minmod_limiter_2D_y(alpha, find_bound_y, n, j, CV->t_u,   CV[nt].U,   bfv_D[j].U,   bfv_U[j].U,   h_y);
+    minmod_limiter_2D_y(alpha, find_bound_y, n, j, CV->t_v,   CV[nt].V,   bfv_D[j].V,   bfv_U[j].V,   h_y);
+    minmod_limiter_2D_y(alpha, find_bound_y, n, j, CV->t_p,   CV[nt].P,   bfv_D[j].P,   bfv_U[j].P,   h_y);
+    minmod_limiter_2D_y(alpha, find_bound_y, n, j, CV->t_rho, CV[nt].RHO, bfv_D[j].RHO, bfv_U[j].RHO, h_y);
+}
+
+/**
+ * @brief This function sets the y-slopes of the ghost cells at the downside/upper boundary of the column j.
+ */
+ACC_ROUTINE_SEQ
+static void slope_bound_y_col(const int bound_y, const int n, const int j, const struct cell_var_stru * CV,
+			      struct b_f_var * bfv_D, struct b_f_var * bfv_U)
+{
+    switch(bound_y)
+	{
+	case -2: // reflective boundary conditions
+	    bfv_D[j].TV   =   CV->t_v[j][0];   bfv_U[j].TV   =   CV->t_v[j][n-1];
+	    break;
+	case -7: // periodic boundary conditions
+	    bfv_D[j].TU   =   CV->t_u[j][n-1]; bfv_U[j].TU   =   CV->t_u[j][0];
+	    bfv_D[j].TV   =   CV->t_v[j][n-1]; bfv_U[j].TV   =   CV->t_v[j][0];
+	    bfv_D[j].TP   =   CV->t_p[j][n-1]; bfv_U[j].TP   =   CV->t_p[j][0];
+	    bfv_D[j].TRHO = CV->t_rho[j][n-1]; bfv_U[j].TRHO = CV->t_rho[j][0];
+	    break;
+	case -24: // reflective + free boundary conditions
+	    bfv_D[j].TV   =   CV->t_v[j][0];
+	    break;
+	}
+}
+
+/**
+ * @brief This function sets the y-slopes of the ghost cells at the left/right boundary
+ *        from those of the columns 0 and m-1.
+ * @param[in] ctx:        Pointer to the run context.
+ * @param[in] m:          Number of the x-grids: n_x.
+ * @param[in] n:          Number of the y-grids: n_y.
+ * @param[in] CV:         Structure of cell variable data.
+ * @param[in,out] bfv_L:  Fluid variables at left boundary.
+ * @param[in,out] bfv_R:  Fluid variables at right boundary.
+ */
+void slope_bound_y_edge(const struct run_ctx * ctx, const int m, const int n, const struct cell_var_stru * CV,
+			struct b_f_var * bfv_L, struct b_f_var * bfv_R)
+{
+    int const bound_x = (int)(ctx->conf[17]);// the boundary condition in x-direction
+    int i;
+#ifdef _OPENACC
+#pragma acc parallel loop default(present)
+#endif
+    for(i = 0; i < n; ++i)
+	switch(bound_x)
+	    {
+	    case -2: case -4: case -24: // reflective OR free boundary conditions in x-direction
+		bfv_L[i].TU   =   CV->t_u[0][i];   bfv_R[i].TU   =   CV->t_u[m-1][i];
+		bfv_L[i].TV   =   CV->t_v[0][i];   bfv_R[i].TV   =   CV->t_v[m-1][i];
+		bfv_L[i].TP   =   CV->t_p[0][i];   bfv_R[i].TP   =   CV->t_p[m-1][i];
+		bfv_L[i].TRHO = CV->t_rho[0][i];   bfv_R[i].TRHO = CV->t_rho[m-1][i];
+		break;
+	    case -7: // periodic boundary conditions in x-direction
+		bfv_L[i].TU   =   CV->t_u[m-1][i]; bfv_R[i].TU   =   CV->t_u[0][i];
+		bfv_L[i].TV   =   CV->t_v[m-1][i]; bfv_R[i].TV   =   CV->t_v[0][i];
+		bfv_L[i].TP   =   CV->t_p[m-1][i]; bfv_R[i].TP   =   CV->t_p[0][i];
+		bfv_L[i].TRHO = CV->t_rho[m-1][i]; bfv_R[i].TRHO = CV->t_rho[0][i];
+		break;
+	    }
+}
+
+/**
+ * @brief This function applies the minmod limiter to the y-slopes of the columns j0 <= j < j1 of a tile in one thread,
+ *        and sets the y-slopes of their ghost cells at the downside/upper boundary.
+ * @details It is a task of the pipelined time steps of GRP_solver_2D_EUL_source(),
+ *          after the boundary conditions have been set by bound_cond_slope_limiter_y() without slopes.
+ *          The ghost cells at the left/right boundary are set by slope_bound_y_edge() after the tiles of the columns 0 and m-1.
+ * @param[in] j0, j1: The first and the last but one columns of the tile.
+ * @sa bound_cond_slope_limiter_y() for the other parameters.
+ */
+void slope_limiter_y_tile(const struct run_ctx * ctx, const int n, const int nt, struct cell_var_stru * CV,
+			  struct b_f_var * bfv_D, struct b_f_var * bfv_U, const _Bool find_bound_y, const int j0, const int j1)
+{
+    int const bound_y = (int)(ctx->conf[18]);// the boundary condition in y-direction
+    double const h_y  = ctx->conf[11];       // the length of the initial y-spatial grids
+    double const alpha = ctx->conf[41];      // the paramater in slope limiters.
+    int j;
+    for(j = j0; j < j1; ++j)
+	{
+	    slope_limiter_y_col(alpha, find_bound_y, n, nt, CV, bfv_D, bfv_U, h_y, j);
+	    slope_bound_y_col(bound_y, n, j, CV, bfv_D, bfv_U);
+	}
+}
+
 /**
  * @brief This function apply the minmod limiter to the slope in the y-direction of two dimension.
+ * @param[in] ctx:        Pointer to the run context.
  * @param[in] m:          Number of the x-grids: n_x.
  * @param[in] n:          Number of the y-grids: n_y.
  * @param[in] nt:         Current plot time step for computing updates of conservative variables.
@@ -24,106 +121,109 @@
  * @param[in] t_c:        Time of current time step.
  * @return find_bound_y:  Whether the boundary conditions in y-direction have been found.
  */
-_Bool bound_cond_slope_limiter_y(const int m, const int n, const int nt, struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R,
+_Bool bound_cond_slope_limiter_y(const struct run_ctx * ctx, const int m, const int n, const int nt, struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R,
 				 struct b_f_var * bfv_D, struct b_f_var * bfv_U, _Bool find_bound_y, const _Bool Slope, const double t_c)
 {
-    int const bound_x = (int)(config[17]);// the boundary condition in x-direction
-    int const bound_y = (int)(config[18]);// the boundary condition in y-direction
-    double const h_y  = config[11];       // the length of the initial y-spatial grids
-    int i, j;
+    int const bound_y = (int)(ctx->conf[18]);// the boundary condition in y-direction
+    double const h_y  = ctx->conf[11];       // the length of the initial y-spatial grids
+    int j;
+    PHASE_TIC(PT_BOUND);
+    switch (bound_y)
+	{
+	case -1: // initial boudary conditions
+	    if(!find_bound_y)
+		printf("Initial boudary conditions in y direction at time %g .\n", t_c);
+	    break;
+	case -2: // reflective boundary conditions
+	    if(!find_bound_y)
+		printf("Reflective boudary conditions in y direction.\n");
+	    break;
+	case -4: // free boundary conditions
+	    if(!find_bound_y)
+		printf("Free boudary conditions in y direction.\n");
+	    break;
+	case -7: // periodic boundary conditions
+	    if(!find_bound_y)
+		printf("Periodic boudary conditions in y direction.\n");
+	    break;
+	case -24: // reflective + free boundary conditions
+	    if(!find_bound_y)
+		printf("Reflective + Free boudary conditions in y direction.\n");
+	    break;
+	default:
+	    printf("No suitable boundary coditions in y direction!\n");
+	    PHASE_TOC(PT_BOUND);
+	    return false;
+	}
+#ifdef _OPENACC
+#pragma acc parallel loop default(present)
+#endif
     for(j = 0; j < m; ++j)
 	switch (bound_y)
 	    {
 	    case -1: // initial boudary conditions
 		if(find_bound_y)
 		    break;
-		else if (!j)
-		    printf("Initial boudary conditions in y direction at time %g .\n", t_c);
 		bfv_D[j].U   =   CV->U[j][0]; bfv_U[j].U   =   CV->U[j][n-1];
 		bfv_D[j].V   =   CV->V[j][0]; bfv_U[j].V   =   CV->V[j][n-1];
 		bfv_D[j].P   =   CV->P[j][0]; bfv_U[j].P   =   CV->P[j][n-1];
 		bfv_D[j].RHO = CV->RHO[j][0]; bfv_U[j].RHO = CV->RHO[j][n-1];
 		break;
 	    case -2: // reflective boundary conditions
-		if(!find_bound_y && !j)
-		    printf("Reflective boudary conditions in y direction.\n");
 		bfv_D[j].U   =   CV[nt].U[j][0]; bfv_U[j].U   =   CV[nt].U[j][n-1];
 		bfv_D[j].V   = - CV[nt].V[j][0]; bfv_U[j].V   = - CV[nt].V[j][n-1];
 		bfv_D[j].P   =   CV[nt].P[j][0]; bfv_U[j].P   =   CV[nt].P[j][n-1];
 		bfv_D[j].RHO = CV[nt].RHO[j][0]; bfv_U[j].RHO = CV[nt].RHO[j][n-1];
 		break;
 	    case -4: // free boundary conditions
-		if(!find_bound_y && !j)
-		    printf("Free boudary conditions in y direction.\n");
 		bfv_D[j].U   =   CV[nt].U[j][0]; bfv_U[j].U   =   CV[nt].U[j][n-1];
 		bfv_D[j].V   =   CV[nt].V[j][0]; bfv_U[j].V   =   CV[nt].V[j][n-1];
 		bfv_D[j].P   =   CV[nt].P[j][0]; bfv_U[j].P   =   CV[nt].P[j][n-1];
 		bfv_D[j].RHO = CV[nt].RHO[j][0]; bfv_U[j].RHO = CV[nt].RHO[j][n-1];
 		break;
 	    case -7: // periodic boundary conditions
-		if(!find_bound_y && !j)
-		    printf("Periodic boudary conditions in y direction.\n");
 		bfv_D[j].U   =   CV[nt].U[j][n-1]; bfv_U[j].U   =   CV[nt].U[j][0];
 		bfv_D[j].V   =   CV[nt].V[j][n-1]; bfv_U[j].V   =   CV[nt].V[j][0];
 		bfv_D[j].P   =   CV[nt].P[j][n-1]; bfv_U[j].P   =   CV[nt].P[j][0];
 		bfv_D[j].RHO = CV[nt].RHO[j][n-1]; bfv_U[j].RHO = CV[nt].RHO[j][0];
 		break;
 	    case -24: // reflective + free boundary conditions
-		if(!find_bound_y && !j)
-		    printf("Reflective + Free boudary conditions in y direction.\n");
 		bfv_D[j].U   =   CV[nt].U[j][0]; bfv_U[j].U   =   CV[nt].U[j][n-1];
 		bfv_D[j].V   = - CV[nt].V[j][0]; bfv_U[j].V   =   CV[nt].V[j][n-1];
 		bfv_D[j].P   =   CV[nt].P[j][0]; bfv_U[j].P   =   CV[nt].P[j][n-1];
 		bfv_D[j].RHO = CV[nt].RHO[j][0]; bfv_U[j].RHO = CV[nt].RHO[j][n-1];
 		break;
-	    default:
-		printf("No suitable boundary coditions in y direction!\n");
-		return false;
 	    }
+    // the ghost cells inside the grids decomposed into blocks
+    halo_state_y(m, n, CV + nt, bfv_D, bfv_U);
+    PHASE_TOC(PT_BOUND);
     if (Slope)
 	{
+	    PHASE_TIC(PT_SLOPE);
+	    double const alpha = ctx->conf[41]; // the paramater in slope limiters.
+#ifdef _OPENACC
+#pragma acc parallel loop collapse(2) default(present)
+	    for(j = 0; j < m; ++j)
+		for(int i = 0; i < n; ++i)
+		    {
+			minmod_limiter_2D_y_cell(alpha, find_bound_y, n, j, i, CV->t_u,   CV[nt].U,   bfv_D[j].U,   bfv_U[j].U,   h_y);
+			minmod_limiter_2D_y_cell(alpha, find_bound_y, n, j, i, CV->t_v,   CV[nt].V,   bfv_D[j].V,   bfv_U[j].V,   h_y);
+			minmod_limiter_2D_y_cell(alpha, find_bound_y, n, j, i, CV->t_p,   CV[nt].P,   bfv_D[j].P,   bfv_U[j].P,   h_y);
+			minmod_limiter_2D_y_cell(alpha, find_bound_y, n, j, i, CV->t_rho, CV[nt].RHO, bfv_D[j].RHO, bfv_U[j].RHO, h_y);
+		    } // End of parallel region
+#else
 #pragma omp parallel for  schedule(dynamic, 8)
 	    for(j = 0; j < m; ++j)
-		{
-		    minmod_limiter(false, n, find_bound_y, CV->t_u[j],   CV[nt].U[j],   bfv_D[j].U,   bfv_U[j].U,   h_y);
-		    minmod_limiter(false, n, find_bound_y, CV->t_v[j],   CV[nt].V[j],   bfv_D[j].V,   bfv_U[j].V,   h_y);
-		    minmod_limiter(false, n, find_bound_y, CV->t_p[j],   CV[nt].P[j],   bfv_D[j].P,   bfv_U[j].P,   h_y);
-		    minmod_limiter(false, n, find_bound_y, CV->t_rho[j], CV[nt].RHO[j], bfv_D[j].RHO, bfv_U[j].RHO, h_y);
-		} // End of parallel region
+		slope_limiter_y_col(alpha, find_bound_y, n, nt, CV, bfv_D, bfv_U, h_y, j);
+#endif
 
+#ifdef _OPENACC
+#pragma acc parallel loop default(present)
+#endif
 	    for(j = 0; j < m; ++j)
-		switch(bound_y)
-		    {
-		    case -2: // reflective boundary conditions
-			bfv_D[j].TV   =   CV->t_v[j][0];   bfv_U[j].TV   =   CV->t_v[j][n-1];
-			break;
-		    case -7: // periodic boundary conditions
-			bfv_D[j].TU   =   CV->t_u[j][n-1]; bfv_U[j].TU   =   CV->t_u[j][0];
-			bfv_D[j].TV   =   CV->t_v[j][n-1]; bfv_U[j].TV   =   CV->t_v[j][0];
-			bfv_D[j].TP   =   CV->t_p[j][n-1]; bfv_U[j].TP   =   CV->t_p[j][0];
-			bfv_D[j].TRHO = CV->t_rho[j][n-1]; bfv_U[j].TRHO = CV->t_rho[j][0];
-			break;
-		    case -24: // reflective + free boundary conditions
-			bfv_D[j].TV   =   CV->t_v[j][0];
-			break;
-		    }
-
-	    for(i = 0; i < n; ++i)
-		switch(bound_x)
-		    {
-		    case -2: case -4: case -24: // reflective OR free boundary conditions in x-direction
-			bfv_L[i].TU   =   CV->t_u[0][i];   bfv_R[i].TU   =   CV->t_u[m-1][i];
-			bfv_L[i].TV   =   CV->t_v[0][i];   bfv_R[i].TV   =   CV->t_v[m-1][i];
-			bfv_L[i].TP   =   CV->t_p[0][i];   bfv_R[i].TP   =   CV->t_p[m-1][i];
-			bfv_L[i].TRHO = CV->t_rho[0][i];   bfv_R[i].TRHO = CV->t_rho[m-1][i];
-			break;
-		    case -7: // periodic boundary conditions in x-direction
-			bfv_L[i].TU   =   CV->t_u[m-1][i]; bfv_R[i].TU   =   CV->t_u[0][i];
-			bfv_L[i].TV   =   CV->t_v[m-1][i]; bfv_R[i].TV   =   CV->t_v[0][i];
-			bfv_L[i].TP   =   CV->t_p[m-1][i]; bfv_R[i].TP   =   CV->t_p[0][i];
-			bfv_L[i].TRHO = CV->t_rho[m-1][i]; bfv_R[i].TRHO = CV->t_rho[0][i];
-			break;
-		    }
+		slope_bound_y_col(bound_y, n, j, CV, bfv_D, bfv_U);
+	    slope_bound_y_edge(ctx, m, n, CV, bfv_L, bfv_R);
+	    PHASE_TOC(PT_SLOPE);
 	}
     return true;
 }
@@ -0,0 +1,152 @@
+/**
+ * @file  device_data_2D.c
+ * @brief This is a set of functions which keep the 2-D structured fluid variables resident on the device of OpenACC.
+ * @details The fields are entered into the device memory once before the time loop, and all the stages of a time step
+ *          run on the device. They are copied back to the host only for the output and the checkpoints.
+ *          Without OpenACC, these functions do nothing.
+ */
+
+#include <stdio.h>
+
+#include "../include/var_struc.h"
+#include "../include/tools.h"
+
+
+#ifdef _OPENACC
+//! Give the directive x of OpenACC in a macro.
+#define ACC_PRAGMA(x) _Pragma(#x)
+/**
+ * @brief Enter the M*N field 'v' of the structure cell_var_stru 'C' into the device memory (copy: whether the values are copied).
+ * @details The pointer 'C.v' in the structure on the device is attached to the field on the device.
+ */
+#define FIELD_ENTER(C, v, M, N, copy)					\
+    do {								\
+	field_device_enter_2D(C.v, (M), (N), sizeof(**C.v), (copy));	\
+	ACC_PRAGMA(acc enter data attach(C.v))				\
+    } while (0)
+//! Copy the M*N field 'v' of the structure cell_var_stru 'C' from the device back to the host.
+#define FIELD_UPDATE(C, v, M, N) field_device_update_host_2D(C.v, (M), (N), sizeof(**C.v))
+//! Delete the M*N field 'v' of the structure cell_var_stru 'C' from the device memory.
+#define FIELD_EXIT(C, v, M, N)   field_device_exit_2D(C.v, (M), (N), sizeof(**C.v))
+#endif
+
+/**
+ * @brief This function enters the run context, the cell variables and the boundary variables into the device memory.
+ * @details The N_T levels of the fluid variables and the slopes are copied into the device,
+ *          and the interfacial variables and fluxes are only created there.
+ * @param[in] ctx:   Pointer to the run context.
+ * @param[in] m:     Number of the x-grids: n_x.
+ * @param[in] n:     Number of the y-grids: n_y.
+ * @param[in] N_T:   Number of 2-D data dimension storing fluid variables in memory.
+ * @param[in] CV:    Structure of cell variable data.
+ * @param[in] bfv_L, bfv_R, bfv_D, bfv_U: Fluid variables at left/right/downside/upper boundary.
+ */
+void device_data_enter_2D(const struct run_ctx * ctx, const int m, const int n, const int N_T, struct cell_var_stru * CV,
+			  struct b_f_var * bfv_L, struct b_f_var * bfv_R, struct b_f_var * bfv_D, struct b_f_var * bfv_U)
+{
+#ifdef _OPENACC
+    int k;
+#pragma acc enter data copyin(ctx[0:1], CV[0:N_T])
+    for(k = 0; k < N_T; ++k)
+	{
+	    FIELD_ENTER(CV[k], RHO, m, n, 1);
+	    FIELD_ENTER(CV[k], U,   m, n, 1);
+	    FIELD_ENTER(CV[k], V,   m, n, 1);
+	    FIELD_ENTER(CV[k], P,   m, n, 1);
+	    FIELD_ENTER(CV[k], E,   m, n, 1);
+	}
+    FIELD_ENTER(CV[0], s_rho, m, n, 1); FIELD_ENTER(CV[0], t_rho, m, n, 1);
+    FIELD_ENTER(CV[0], s_u,   m, n, 1); FIELD_ENTER(CV[0], t_u,   m, n, 1);
+    FIELD_ENTER(CV[0], s_v,   m, n, 1); FIELD_ENTER(CV[0], t_v,   m, n, 1);
+    FIELD_ENTER(CV[0], s_p,   m, n, 1); FIELD_ENTER(CV[0], t_p,   m, n, 1);
+    FIELD_ENTER(CV[0], rhoIx, m+1, n, 0); FIELD_ENTER(CV[0], F_rho, m+1, n, 0);
+    FIELD_ENTER(CV[0], uIx,   m+1, n, 0); FIELD_ENTER(CV[0], F_u,   m+1, n, 0);
+    FIELD_ENTER(CV[0], vIx,   m+1, n, 0); FIELD_ENTER(CV[0], F_v,   m+1, n, 0);
+    FIELD_ENTER(CV[0], pIx,   m+1, n, 0); FIELD_ENTER(CV[0], F_e,   m+1, n, 0);
+    FIELD_ENTER(CV[0], rhoIy, m, n+1, 0); FIELD_ENTER(CV[0], G_rho, m, n+1, 0);
+    FIELD_ENTER(CV[0], uIy,   m, n+1, 0); FIELD_ENTER(CV[0], G_u,   m, n+1, 0);
+    FIELD_ENTER(CV[0], vIy,   m, n+1, 0); FIELD_ENTER(CV[0], G_v,   m, n+1, 0);
+    FIELD_ENTER(CV[0], pIy,   m, n+1, 0); FIELD_ENTER(CV[0], G_e,   m, n+1, 0);
+#pragma acc enter data copyin(bfv_L[0:n], bfv_R[0:n], bfv_D[0:m], bfv_U[0:m])
+    printf("The fluid variables are resident on the device.\n");
+#endif
+}
+
+/**
+ * @brief This function copies the fluid variables of a level on the device back to the host for the output.
+ * @param[in] m:     Number of the x-grids: n_x.
+ * @param[in] n:     Number of the y-grids: n_y.
+ * @param[in,out] CV: Structure of cell variable data of the level.
+ */
+void device_data_update_host_2D(const int m, const int n, struct cell_var_stru * CV)
+{
+#ifdef _OPENACC
+    FIELD_UPDATE(CV[0], RHO, m, n);
+    FIELD_UPDATE(CV[0], U,   m, n);
+    FIELD_UPDATE(CV[0], V,   m, n);
+    FIELD_UPDATE(CV[0], P,   m, n);
+    FIELD_UPDATE(CV[0], E,   m, n);
+#endif
+}
+
+/**
+ * @brief This function copies the state of the time loop on the device back to the host for a checkpoint.
+ * @details The levels before nt have been copied back at the plotting times, and they have not been changed since then.
+ * @param[in] m:     Number of the x-grids: n_x.
+ * @param[in] n:     Number of the y-grids: n_y.
+ * @param[in] nt:    Current plot time step for computing updates of conservative variables.
+ * @param[in,out] CV: Structure of cell variable data.
+ * @param[in,out] bfv_L, bfv_R, bfv_D, bfv_U: Fluid variables at left/right/downside/upper boundary.
+ */
+void device_data_update_ckpt_2D(const int m, const int n, const int nt, struct cell_var_stru * CV,
+				struct b_f_var * bfv_L, struct b_f_var * bfv_R, struct b_f_var * bfv_D, struct b_f_var * bfv_U)
+{
+#ifdef _OPENACC
+    device_data_update_host_2D(m, n, CV + nt);
+    FIELD_UPDATE(CV[0], s_rho, m, n); FIELD_UPDATE(CV[0], t_rho, m, n);
+    FIELD_UPDATE(CV[0], s_u,   m, n); FIELD_UPDATE(CV[0], t_u,   m, n);
+    FIELD_UPDATE(CV[0], s_v,   m, n); FIELD_UPDATE(CV[0], t_v,   m, n);
+    FIELD_UPDATE(CV[0], s_p,   m, n); FIELD_UPDATE(CV[0], t_p,   m, n);
+#pragma acc update self(bfv_L[0:n], bfv_R[0:n], bfv_D[0:m], bfv_U[0:m])
+#endif
+}
+
+/**
+ * @brief This function copies the current level back to the host and deletes all the data entered by device_data_enter_2D().
+ * @param[in] ctx:   Pointer to the run context.
+ * @param[in] m:     Number of the x-grids: n_x.
+ * @param[in] n:     Number of the y-grids: n_y.
+ * @param[in] N_T:   Number of 2-D data dimension storing fluid variables in memory.
+ * @param[in] nt:    Current plot time step for computing updates of conservative variables.
+ * @param[in,out] CV: Structure of cell variable data.
+ * @param[in] bfv_L, bfv_R, bfv_D, bfv_U: Fluid variables at left/right/downside/upper boundary.
+ */
+void device_data_exit_2D(const struct run_ctx * ctx, const int m, const int n, const int N_T, const int nt, struct cell_var_stru * CV,
+			 struct b_f_var * bfv_L, struct b_f_var * bfv_R, struct b_f_var * bfv_D, struct b_f_var * bfv_U)
+{
+#ifdef _OPENACC
+    int k;
+    device_data_update_host_2D(m, n, CV + nt);
+#pragma acc exit data delete(bfv_L[0:n], bfv_R[0:n], bfv_D[0:m], bfv_U[0:m], CV[0:N_T], ctx[0:1])
+    for(k = 0; k < N_T; ++k)
+	{
+	    FIELD_EXIT(CV[k], RHO, m, n);
+	    FIELD_EXIT(CV[k], U,   m, n);
+	    FIELD_EXIT(CV[k], V,   m, n);
+	    FIELD_EXIT(CV[k], P,   m, n);
+	    FIELD_EXIT(CV[k], E,   m, n);
+	}
+    FIELD_EXIT(CV[0], s_rho, m, n); FIELD_EXIT(CV[0], t_rho, m, n);
+    FIELD_EXIT(CV[0], s_u,   m, n); FIELD_EXIT(CV[0], t_u,   m, n);
+    FIELD_EXIT(CV[0], s_v,   m, n); FIELD_EXIT(CV[0], t_v,   m, n);
+    FIELD_EXIT(CV[0], s_p,   m, n); FIELD_EXIT(CV[0], t_p,   m, n);
+    FIELD_EXIT(CV[0], rhoIx, m+1, n); FIELD_EXIT(CV[0], F_rho, m+1, n);
+    FIELD_EXIT(CV[0], uIx,   m+1, n); FIELD_EXIT(CV[0], F_u,   m+1, n);
+    FIELD_EXIT(CV[0], vIx,   m+1, n); FIELD_EXIT(CV[0], F_v,   m+1, n);
+    FIELD_EXIT(CV[0], pIx,   m+1, n); FIELD_EXIT(CV[0], F_e,   m+1, n);
+    FIELD_EXIT(CV[0], rhoIy, m, n+1); FIELD_EXIT(CV[0], G_rho, m, n+1);
+    FIELD_EXIT(CV[0], uIy,   m, n+1); FIELD_EXIT(CV[0], G_u,   m, n+1);
+    FIELD_EXIT(CV[0], vIy,   m, n+1); FIELD_EXIT(CV[0], G_v,   m, n+1);
+    FIELD_EXIT(CV[0], pIy,   m, n+1); FIELD_EXIT(CV[0], G_e,   m, n+1);
+#endif
+}
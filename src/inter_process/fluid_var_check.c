@@ -4,55 +4,147 @@
  */
 #include <stdio.h>
 #include <math.h>
+#include <stdbool.h>
 
 #include "../include/var_struc.h"
 
 
 /**
- * @brief This function checks whether interfacial fluid variables are within the value range.
+ * @brief Messages of the miscalculation indicators returned by ifvar_check_code().
+ */
+static const char * ifvar_check_str[] = {"", "<0.0 error - Reconstruction", "NAN or INFinite error - Slope", "NAN or INFinite error - t_Slope_x"};
+/**
+ * @brief Messages of the miscalculation indicators returned by star_dire_check_code().
+ */
+static const char * star_dire_check_str[] = {"", "<0.0 error - STAR", "NAN or INFinite error - STAR", "NAN or INFinite error - DIRE"};
+
+/**
+ * @brief This function checks whether interfacial fluid variables are within the value range, without any message.
+ * @details It is safe to be called in parallel regions, the message is given by ifvar_check_msg().
+ * @param[in] ctx:   Pointer to the run context.
  * @param[in] ifv_L: Structure pointer of interfacial left state.
  * @param[in] ifv_R: Structure pointer of interfacial right state.
  * @param[in] dim:   Spatial dimension.
  * @return    miscalculation indicator.
  *   @retval  0: Successful calculation.
  *   @retval  1: < 0.0 error.
- *   @retval  2: NAN or INFinite error of Slope.
+ *   @retval  2: NAN or INFinite error of Slope (d_Slope_x in 2-D).
+ *   @retval  3: NAN or INFinite error of t_Slope_x in 2-D.
  */
-int ifvar_check(struct i_f_var *ifv_L, struct i_f_var *ifv_R, const int dim)
+int ifvar_check_code(const struct run_ctx * ctx, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const int dim)
 {
-    double const eps = config[4];
+    double const eps = ctx->conf[4];
     if(ifv_L->P < eps || ifv_R->P < eps || ifv_L->RHO < eps || ifv_R->RHO < eps)
-	{
-	    printf("<0.0 error - Reconstruction");
-	    return 1;
-	}
+	return 1;
     if(dim == 1)
 	{
 	    if(!isfinite(ifv_L->d_p)|| !isfinite(ifv_R->d_p)|| !isfinite(ifv_L->d_u)|| !isfinite(ifv_R->d_u)|| !isfinite(ifv_L->d_rho)|| !isfinite(ifv_R->d_rho))
-		{
-		    printf("NAN or INFinite error - Slope"); 
-		    return 2;
-		}
+		return 2;
 	}
     else if (dim == 2)
 	{
 	    if(!isfinite(ifv_L->d_p)|| !isfinite(ifv_R->d_p)|| !isfinite(ifv_L->d_u)|| !isfinite(ifv_R->d_u)|| !isfinite(ifv_L->d_v)|| !isfinite(ifv_R->d_v)|| !isfinite(ifv_L->d_rho)|| !isfinite(ifv_R->d_rho))
-		{
-		    printf("NAN or INFinite error - d_Slope_x"); 
-		    return 2;
-		}
+		return 2;
 	    if(!isfinite(ifv_L->t_p)|| !isfinite(ifv_R->t_p)|| !isfinite(ifv_L->t_u)|| !isfinite(ifv_R->t_u)|| !isfinite(ifv_L->t_v)|| !isfinite(ifv_R->t_v)|| !isfinite(ifv_L->t_rho)|| !isfinite(ifv_R->t_rho))
-		{
-		    printf("NAN or INFinite error - t_Slope_x"); 
-		    return 2;
-		}
+		return 3;
 	}
     return 0;
 }
 
+/**
+ * @brief This function checks whether the flow is quiescent at an interface in one dimension.
+ * @details The left and right states are equal and all the slopes vanish, within the tolerance eps.
+ *          Then the solution of the GRP is the uniform state and its temporal derivatives are zero.
+ * @param[in] ifv_L: Structure pointer of interfacial left state.
+ * @param[in] ifv_R: Structure pointer of interfacial right state.
+ * @param[in] eps:   The largest value can be seen as zero.
+ * @return    Whether the flow is quiescent.
+ */
+_Bool ifvar_quiescent(const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps)
+{
+    if(fabs(ifv_L->RHO - ifv_R->RHO) > eps || fabs(ifv_L->U - ifv_R->U) > eps || fabs(ifv_L->P - ifv_R->P) > eps)
+	return false;
+    if(fabs(ifv_L->d_rho) > eps || fabs(ifv_L->d_u) > eps || fabs(ifv_L->d_p) > eps)
+	return false;
+    if(fabs(ifv_R->d_rho) > eps || fabs(ifv_R->d_u) > eps || fabs(ifv_R->d_p) > eps)
+	return false;
+    return true;
+}
 
 /**
- * @brief This function checks whether fluid variables of mid[] and dire[] are within the value range.
+ * @brief This function gives the message of the miscalculation indicator returned by ifvar_check_code().
+ * @param[in] err: Miscalculation indicator.
+ * @param[in] dim: Spatial dimension.
+ * @return    Message of the miscalculation indicator.
+ */
+const char * ifvar_check_msg(const int err, const int dim)
+{
+    if (dim == 2 && err == 2)
+	return "NAN or INFinite error - d_Slope_x";
+    return ifvar_check_str[err];
+}
+
+/**
+ * @brief This function checks whether interfacial fluid variables are within the value range.
+ * @param[in] ctx:   Pointer to the run context.
+ * @param[in] ifv_L: Structure pointer of interfacial left state.
+ * @param[in] ifv_R: Structure pointer of interfacial right state.
+ * @param[in] dim:   Spatial dimension.
+ * @return    miscalculation indicator.
+ *   @retval  0: Successful calculation.
+ *   @retval  1: < 0.0 error.
+ *   @retval  2: NAN or INFinite error of Slope.
+ */
+int ifvar_check(const struct run_ctx * ctx, struct i_f_var *ifv_L, struct i_f_var *ifv_R, const int dim)
+{
+    const int err = ifvar_check_code(ctx, ifv_L, ifv_R, dim);
+    if(err)
+	printf("%s", ifvar_check_msg(err, dim));
+    return err > 2 ? 2 : err;
+}
+
+
+/**
+ * @brief This function checks the interfacial states of a batch in one dimension, in a pass without any branch.
+ * @details The lanes are checked as by ifvar_check_code() in a vectorized reduction over the arrays of the batch,
+ *          and only if it finds an error, the lanes are checked one by one for the first offending lane.
+ *          So the loops building the batch need no check.
+ * @param[in]  ctx:   Pointer to the run context.
+ * @param[in]  n:     Number of the lanes of the batch.
+ * @param[in]  ifv_L: Structure pointer of the left states of the batch.
+ * @param[in]  ifv_R: Structure pointer of the right states of the batch.
+ * @param[out] err:   Miscalculation indicator of the first offending lane (ifvar_check_code()).
+ * @return     First offending lane (-1: Successful calculation).
+ */
+int ifvar_check_batch(const struct run_ctx * ctx, const int n, const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R, int * err)
+{
+    double const eps = ctx->conf[4];
+    int l, bad = 0;
+#pragma omp simd reduction(|:bad)
+    for(l = 0; l < n; ++l)
+	bad |= (ifv_L->P[l] < eps) | (ifv_R->P[l] < eps) | (ifv_L->RHO[l] < eps) | (ifv_R->RHO[l] < eps)
+	    | !isfinite(ifv_L->s_rho[l]) | !isfinite(ifv_R->s_rho[l]) | !isfinite(ifv_L->s_u[l]) | !isfinite(ifv_R->s_u[l])
+	    | !isfinite(ifv_L->s_p[l])   | !isfinite(ifv_R->s_p[l]);
+    if(!bad)
+	return -1;
+    for(l = 0; l < n; ++l)
+	{
+	    if(ifv_L->P[l] < eps || ifv_R->P[l] < eps || ifv_L->RHO[l] < eps || ifv_R->RHO[l] < eps)
+		*err = 1;
+	    else if(!isfinite(ifv_L->s_rho[l]) || !isfinite(ifv_R->s_rho[l]) || !isfinite(ifv_L->s_u[l]) || !isfinite(ifv_R->s_u[l])
+		    || !isfinite(ifv_L->s_p[l]) || !isfinite(ifv_R->s_p[l]))
+		*err = 2;
+	    else
+		continue;
+	    return l;
+	}
+    return -1;
+}
+
+/**
+ * @brief This function checks whether fluid variables of mid[] and dire[] are within the value range, without any message.
+ * @details It is safe to be called in parallel regions, the message is given by star_dire_check_msg().
+ * @param[in] ctx:  Pointer to the run context.
  * @param[in] mid:  Intermediate Riemann solutions at t-axis OR in star region.
  * @param[in] dire: Temporal derivative of fluid variables.
  * @param[in] dim:  Spatial dimension.
@@ -62,70 +154,116 @@ int ifvar_check(struct i_f_var *ifv_L, struct i_f_var *ifv_R, const int dim)
  *   @retval  2: NAN or INFinite error of mid[].
  *   @retval  3: NAN or INFinite error of dire[].
  */
-int star_dire_check(double *mid, double *dire, const int dim)
+int star_dire_check_code(const struct run_ctx * ctx, const double *mid, const double *dire, const int dim)
 {
-    double const eps = config[4];
-    int    const el  = (int)config[8];
-    double * star = NULL;
+    double const eps = ctx->conf[4];
+    int    const el  = (int)ctx->conf[8];
+    const double * star = NULL;
     if (dim == 1)
 	{
 	    switch(el)
 		{
 		case 1:
-			star = mid;
+		    star = mid;
 		    if(star[2] < eps || star[0] < eps || star[3] < eps)
-			{
-			    printf("<0.0 error - STAR");
-			    return 1;
-			}
+			return 1;
 		    if(!isfinite(star[1])|| !isfinite(star[2])|| !isfinite(star[0])|| !isfinite(star[3]))
-			{
-			    printf("NAN or INFinite error - STAR"); 
-			    return 2;
-			}
+			return 2;
 		    if(!isfinite(dire[1])|| !isfinite(dire[2])|| !isfinite(dire[0])|| !isfinite(dire[3]))
-			{
-			    printf("NAN or INFinite error - DIRE"); 
-			    return 3;
-			}
+			return 3;
 		    break;
 		default:
 		    if(mid[2] < eps || mid[0] < eps)
-			{
-			    printf("<0.0 error - STAR");
-			    return 1;
-			}
+			return 1;
 		    if(!isfinite(mid[1])|| !isfinite(mid[2])|| !isfinite(mid[0]))
-			{
-			    printf("NAN or INFinite error - STAR"); 
-			    return 2;
-			}
+			return 2;
 		    if(!isfinite(dire[1])|| !isfinite(dire[2])|| !isfinite(dire[0]))
-			{
-			    printf("NAN or INFinite error - DIRE"); 
-			    return 3;
-			}
+			return 3;
 		    break;
 		}
 	}
     else if(dim == 2)
 	{
 	    if(mid[3] < eps || mid[0] < eps)
-		{
-		    printf("<0.0 error - STAR");
-		    return 1;
-		}
+		return 1;
 	    if(!isfinite(mid[1])|| !isfinite(mid[2])|| !isfinite(mid[0])|| !isfinite(mid[3]))
-		{
-		    printf("NAN or INFinite error - STAR"); 
-		    return 2;
-		}
+		return 2;
 	    if(!isfinite(dire[1])|| !isfinite(dire[2])|| !isfinite(dire[0])|| !isfinite(dire[3]))
+		return 3;
+	}
+    return 0;
+}
+
+/**
+ * @brief This function checks the Riemann solutions and their temporal derivatives at the interfaces in a pass without any branch.
+ * @details The arrays are checked as by star_dire_check_code() in vectorized reductions, once for a time step
+ *          (or every some time steps), and only if they find an error, the interfaces are checked one by one
+ *          for the first offending interface.
+ * @param[in]  ctx:  Pointer to the run context.
+ * @param[in]  n:    Number of the interfaces.
+ * @param[in]  mid:  Arrays of the intermediate Riemann solutions (in the order of mid[] of star_dire_check_code()).
+ * @param[in]  dire: Arrays of the temporal derivatives of fluid variables.
+ * @param[in]  dim:  Spatial dimension.
+ * @param[out] err:  Miscalculation indicator of the first offending interface (star_dire_check_code()).
+ * @return     First offending interface (-1: Successful calculation).
+ */
+int star_dire_check_batch(const struct run_ctx * ctx, const int n, const double * const mid[], const double * const dire[], const int dim, int * err)
+{
+    double const eps = ctx->conf[4];
+    int    const el  = (int)ctx->conf[8];
+    int    const nv  = dim == 1 && el != 1 ? 3 : 4; // the number of the variables
+    double m_l[4], d_l[4];
+    int l, v, bad = 0;
+    for(v = 0; v < nv; ++v)
+	{
+	    const double * const s = mid[v], * const d = dire[v];
+	    // whether the variable is positive: the densities (and the pressure in 1-D)
+	    const int pos = v == 0 || (dim == 1 ? v == 2 || v == 3 : v == 3);
+#pragma omp simd reduction(|:bad)
+	    for(l = 0; l < n; ++l)
+		bad |= !isfinite(s[l]) | !isfinite(d[l]) | (pos & (s[l] < eps));
+	}
+    if(!bad)
+	return -1;
+    for(l = 0; l < n; ++l)
+	{
+	    for(v = 0; v < nv; ++v)
 		{
-		    printf("NAN or INFinite error - DIRE"); 
-		    return 3;
+		    m_l[v] = mid[v][l];
+		    d_l[v] = dire[v][l];
 		}
+	    if((*err = star_dire_check_code(ctx, m_l, d_l, dim)))
+		return l;
 	}
+    return -1;
+}
 
-    return 0;
+/**
+ * @brief This function gives the message of the miscalculation indicator returned by star_dire_check_code().
+ * @param[in] err: Miscalculation indicator.
+ * @return    Message of the miscalculation indicator.
+ */
+const char * star_dire_check_msg(const int err)
+{
+    return star_dire_check_str[err];
+}
+
+/**
+ * @brief This function checks whether fluid variables of mid[] and dire[] are within the value range.
+ * @param[in] ctx:  Pointer to the run context.
+ * @param[in] mid:  Intermediate Riemann solutions at t-axis OR in star region.
+ * @param[in] dire: Temporal derivative of fluid variables.
+ * @param[in] dim:  Spatial dimension.
+ * @return    miscalculation indicator.
+ *   @retval  0: Successful calculation.
+ *   @retval  1: < 0.0 error of mid[].
+ *   @retval  2: NAN or INFinite error of mid[].
+ *   @retval  3: NAN or INFinite error of dire[].
+ */
+int star_dire_check(const struct run_ctx * ctx, double *mid, double *dire, const int dim)
+{
+    const int err = star_dire_check_code(ctx, mid, dire, dim);
+    if(err)
+	printf("%s", star_dire_check_msg(err));
+    return err;
 }
@@ -0,0 +1,272 @@
+/**
+ * @file  halo_exchange_1D.c
+ * @brief This is a set of functions which decompose the 1-D grids into parts of the MPI processes
+ *        and exchange the halos of the parts.
+ * @details The m cells of the mass coordinate are decomposed into contiguous parts, one part for each process.
+ *          The ghost cells of a part at the ends inside the grids are the structures b_f_var of the boundaries,
+ *          which are filled with the state, the length and the slopes of the edge cells of the neighbouring parts.
+ *          Without MPI_1D, there is one part of the whole grids and these functions do nothing.
+ * @attention  Library Dependency: MPI (Compile with '-DMPI_1D' by mpicc)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/var_struc.h"
+#include "../include/inter_process.h"
+#include "../include/tools.h"
+#ifdef MPI_1D
+#include <mpi.h>
+
+
+//! The number of variables of a ghost cell in a message: the states and the length or the slopes.
+#define HALO_NV 4
+
+//! The side of a part: Left/Right
+enum halo_side {HALO_L, HALO_R};
+
+//! The part of the grids of this process.
+static struct halo_part {
+	MPI_Comm comm;  //!< Cartesian communicator of the parts.
+	int size, rank; //!< Number of the processes and the rank of this process.
+	int nb[2];      //!< Ranks of the neighbouring parts on each side (MPI_PROC_NULL: physical boundary).
+	int M;          //!< Number of the cells of the whole grids.
+	double buf_s[2][HALO_NV], buf_r[2][HALO_NV]; //!< Buffers of the sent and received ghost cells on each side.
+} hp = {.comm = MPI_COMM_NULL, .size = 1, .nb = {MPI_PROC_NULL, MPI_PROC_NULL}};
+
+
+/**
+ * @brief This function exchanges the buffers of the ghost cells with the neighbouring parts.
+ * @details The edge of a part on side s is the ghost cell on the opposite side (s^1) of the neighbour,
+ *          which is the tag of the message, in case that both neighbours are the same process.
+ */
+static void halo_swap(void)
+{
+    MPI_Request req[4];
+    int s;
+    for(s = HALO_L; s <= HALO_R; ++s)
+	MPI_Irecv(hp.buf_r[s], HALO_NV, MPI_DOUBLE, hp.nb[s], s,     hp.comm, req + s);
+    for(s = HALO_L; s <= HALO_R; ++s)
+	MPI_Isend(hp.buf_s[s], HALO_NV, MPI_DOUBLE, hp.nb[s], s ^ 1, hp.comm, req + 2 + s);
+    MPI_Waitall(4, req, MPI_STATUSES_IGNORE);
+}
+#endif
+
+
+/**
+ * @brief This function decomposes the whole grids into the parts of the processes.
+ * @details The parts are periodic for the periodic boundary conditions.
+ * @param[in]  ctx:  Pointer to the run context.
+ * @param[in]  M:    Number of the cells of the whole grids.
+ * @param[out] part: First cell and number of the cells of the part of this process {j0, m}.
+ * @return     Whether there is an error (0: Success, 4: Too many processes for the grids).
+ */
+int halo_part_init_1D(const struct run_ctx * ctx, const int M, int part[2])
+{
+    part[0] = 0;
+    part[1] = M;
+#ifdef MPI_1D
+    int periods = (int)ctx->conf[17] == -7;
+    MPI_Comm_size(MPI_COMM_WORLD, &hp.size);
+    hp.M = M;
+    if(hp.size > M)
+	{
+	    printf("Too many processes (%d) for the %d grids!\n", hp.size, M);
+	    return 4;
+	}
+    periods = periods && hp.size > 1; // One process keeps the periodic boundary conditions of the serial run.
+    MPI_Cart_create(MPI_COMM_WORLD, 1, &hp.size, &periods, 0, &hp.comm);
+    MPI_Comm_rank(hp.comm, &hp.rank);
+    MPI_Cart_shift(hp.comm, 0, 1, &hp.nb[HALO_L], &hp.nb[HALO_R]);
+    halo_part_1D(hp.rank, part);
+    if(hp.rank == 0)
+	printf("The %d grids are decomposed into %d parts.\n", M, hp.size);
+#endif
+    return 0;
+}
+
+/**
+ * @brief This function gives the part of the process of rank r.
+ * @param[in]  r:    Rank of the process.
+ * @param[out] part: First cell and number of the cells of the part {j0, m}.
+ */
+void halo_part_1D(const int r, int part[2])
+{
+#ifdef MPI_1D
+    part[0] = r * (hp.M / hp.size) + MIN(r, hp.M % hp.size);
+    part[1] = hp.M / hp.size + (r < hp.M % hp.size);
+#endif
+}
+
+//! This function returns the rank of this process.
+int halo_rank_1D(void)
+{
+#ifdef MPI_1D
+    return hp.rank;
+#else
+    return 0;
+#endif
+}
+
+//! This function returns the number of the processes.
+int halo_size_1D(void)
+{
+#ifdef MPI_1D
+    return hp.size;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief This function tells whether the side s of the part (0: left, 1: right) lies inside the grids.
+ */
+_Bool halo_inner_1D(const int s)
+{
+#ifdef MPI_1D
+    return hp.nb[s] != MPI_PROC_NULL;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief This function frees the communicator of the parts.
+ */
+void halo_part_free_1D(void)
+{
+#ifdef MPI_1D
+    if(hp.comm != MPI_COMM_NULL)
+	MPI_Comm_free(&hp.comm);
+#endif
+}
+
+/**
+ * @brief This function returns the global minimum of the values of the processes.
+ * @param[in] v: Value of this process.
+ */
+double halo_min_1D(double v)
+{
+#ifdef MPI_1D
+    MPI_Allreduce(MPI_IN_PLACE, &v, 1, MPI_DOUBLE, MPI_MIN, hp.comm);
+#endif
+    return v;
+}
+
+/**
+ * @brief This function returns the global maximum of the values of the processes.
+ * @details It is used for the stop indicators and the error codes, so that all processes stop together.
+ * @param[in] v: Value of this process.
+ */
+int halo_max_1D(int v)
+{
+#ifdef MPI_1D
+    MPI_Allreduce(MPI_IN_PLACE, &v, 1, MPI_INT, MPI_MAX, hp.comm);
+#endif
+    return v;
+}
+
+/**
+ * @brief This function sums the values of the processes in place, such as the totals of the conserved quantities.
+ * @param[in,out] v: Values of this process and then the global sums.
+ * @param[in]     n: Number of the values.
+ */
+void halo_sum_1D(double v[], const int n)
+{
+#ifdef MPI_1D
+    MPI_Allreduce(MPI_IN_PLACE, v, n, MPI_DOUBLE, MPI_SUM, hp.comm);
+#endif
+}
+
+/**
+ * @brief This function sums the exact sums of the processes in place, the result does not depend on the order of the processes.
+ * @param[in,out] s: Exact sums of this process and then the global exact sums.
+ * @param[in]     n: Number of the sums.
+ */
+void halo_repro_sum_1D(struct repro_sum * s, const int n)
+{
+#ifdef MPI_1D
+    int i;
+    for(i = 0; i < n; i++)
+	{
+	    repro_sum_prepare(s+i);
+	    MPI_Allreduce(MPI_IN_PLACE, s[i].b, RSUM_BINS, MPI_INT64_T, MPI_SUM, hp.comm);
+	}
+#else
+    (void)s; (void)n;
+#endif
+}
+
+/**
+ * @brief This function exchanges the states and the lengths of the edge cells of the part
+ *        and sets them as the ghost cells at the left/right boundary inside the grids.
+ * @param[in] m:   Number of the cells of the part.
+ * @param[in] nt:  Current plot time step.
+ * @param[in] CV:  Structure of cell variable data.
+ * @param[in] X:   Array of moving spatial grid point coordinates (NULL: fixed grid length h).
+ * @param[in] h:   Fixed spatial grid length.
+ * @param[in,out] bfv_L: Fluid variables at left boundary.
+ * @param[in,out] bfv_R: Fluid variables at right boundary.
+ */
+void halo_state_1D(const int m, const int nt, const struct cell_var_stru * CV, const double * X, const double h,
+		   struct b_f_var * bfv_L, struct b_f_var * bfv_R)
+{
+#ifdef MPI_1D
+    int s, j;
+    if(hp.size == 1)
+	return;
+    for(s = HALO_L; s <= HALO_R; ++s)
+	{
+	    j = s == HALO_L ? 0 : m-1;
+	    hp.buf_s[s][0] = CV->RHO[nt][j];
+	    hp.buf_s[s][1] = CV->U[nt][j];
+	    hp.buf_s[s][2] = CV->P[nt][j];
+	    hp.buf_s[s][3] = X ? X[j+1] - X[j] : h;
+	}
+    halo_swap();
+    if(hp.nb[HALO_L] != MPI_PROC_NULL)
+	{
+	    bfv_L->RHO = hp.buf_r[HALO_L][0]; bfv_L->U = hp.buf_r[HALO_L][1];
+	    bfv_L->P   = hp.buf_r[HALO_L][2]; bfv_L->H = hp.buf_r[HALO_L][3];
+	}
+    if(hp.nb[HALO_R] != MPI_PROC_NULL)
+	{
+	    bfv_R->RHO = hp.buf_r[HALO_R][0]; bfv_R->U = hp.buf_r[HALO_R][1];
+	    bfv_R->P   = hp.buf_r[HALO_R][2]; bfv_R->H = hp.buf_r[HALO_R][3];
+	}
+#endif
+}
+
+/**
+ * @brief This function exchanges the slopes of the edge cells of the part
+ *        and sets them as the slopes of the ghost cells at the left/right boundary inside the grids.
+ * @param[in] m:   Number of the cells of the part.
+ * @param[in] CV:  Structure of cell variable data.
+ * @param[in,out] bfv_L: Fluid variables at left boundary.
+ * @param[in,out] bfv_R: Fluid variables at right boundary.
+ */
+void halo_slope_1D(const int m, const struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R)
+{
+#ifdef MPI_1D
+    int s, j;
+    if(hp.size == 1)
+	return;
+    for(s = HALO_L; s <= HALO_R; ++s)
+	{
+	    j = s == HALO_L ? 0 : m-1;
+	    hp.buf_s[s][0] = CV->d_rho[j];
+	    hp.buf_s[s][1] = CV->d_u[j];
+	    hp.buf_s[s][2] = CV->d_p[j];
+	    hp.buf_s[s][3] = 0.0;
+	}
+    halo_swap();
+    if(hp.nb[HALO_L] != MPI_PROC_NULL)
+	{
+	    bfv_L->SRHO = hp.buf_r[HALO_L][0]; bfv_L->SU = hp.buf_r[HALO_L][1]; bfv_L->SP = hp.buf_r[HALO_L][2];
+	}
+    if(hp.nb[HALO_R] != MPI_PROC_NULL)
+	{
+	    bfv_R->SRHO = hp.buf_r[HALO_R][0]; bfv_R->SU = hp.buf_r[HALO_R][1]; bfv_R->SP = hp.buf_r[HALO_R][2];
+	}
+#endif
+}
@@ -0,0 +1,383 @@
+/**
+ * @file  halo_exchange_2D.c
+ * @brief This is a set of functions which decompose the 2-D structured grids into blocks of the MPI processes
+ *        and exchange the halos of the blocks.
+ * @details The n_x*n_y grids are decomposed into a Cartesian topology of blocks, one block for each process.
+ *          The ghost cells of a block on the edges inside the grids are the arrays of structure b_f_var of the boundaries,
+ *          which are filled with the states and the slopes of the cells of the neighbouring blocks by non-blocking messages.
+ *          The exchange of the slopes is started before the flux computation and finished after the interior interfaces,
+ *          so that it overlaps the flux computation inside the block.
+ *          Without MPI_2D, there is one block of the whole grids and these functions do nothing.
+ * @attention  Library Dependency: MPI (Compile with '-DMPI_2D' by mpicc)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/var_struc.h"
+#include "../include/inter_process.h"
+#include "../include/tools.h"
+#ifdef MPI_2D
+#include <mpi.h>
+#ifdef _OPENACC
+#error "The halos of the blocks are exchanged on the host, MPI_2D does not support the fields resident on the device of OpenACC."
+#endif
+
+
+//! The number of variables of a ghost cell in a message: the states or the x/y-slopes.
+#define HALO_NV 8
+
+//! The side of a block: Left/Right/Downside/Upper
+enum halo_side {HALO_L, HALO_R, HALO_D, HALO_U};
+
+//! The block of the grids of this process.
+static struct halo_block {
+	MPI_Comm comm;  //!< Cartesian communicator of the blocks.
+	int size, rank; //!< Number of the processes and the rank of this process.
+	int dims[2];    //!< Number of the blocks in x/y-direction.
+	int coords[2];  //!< Coordinates of the block in the topology.
+	int nb[4];      //!< Ranks of the neighbouring blocks on each side (MPI_PROC_NULL: physical boundary).
+	int M, N;       //!< Number of the x/y-grids of the whole grids.
+	double * buf_s[4], * buf_r[4]; //!< Buffers of the sent and received ghost cells on each side.
+	MPI_Request req[2][4];         //!< Requests of the messages in x/y-direction.
+} hb = {.comm = MPI_COMM_NULL, .size = 1, .nb = {MPI_PROC_NULL, MPI_PROC_NULL, MPI_PROC_NULL, MPI_PROC_NULL}};
+
+
+/**
+ * @brief This function gives the block of the process with the coordinates c in the topology.
+ * @param[in]  c:   Coordinates of the block.
+ * @param[out] blk: First x/y-grids and number of the x/y-grids of the block {j0, i0, m, n}.
+ */
+static void halo_block_coords(const int c[2], int blk[4])
+{
+    blk[0] = c[0] * (hb.M / hb.dims[0]) + MIN(c[0], hb.M % hb.dims[0]);
+    blk[1] = c[1] * (hb.N / hb.dims[1]) + MIN(c[1], hb.N % hb.dims[1]);
+    blk[2] = hb.M / hb.dims[0] + (c[0] < hb.M % hb.dims[0]);
+    blk[3] = hb.N / hb.dims[1] + (c[1] < hb.N % hb.dims[1]);
+}
+
+/**
+ * @brief This function posts the non-blocking messages of the ghost cells in a direction.
+ * @details The edge of a block on side s is the ghost cells on the opposite side (s^1) of the neighbour,
+ *          which is the tag of the message, in case that both neighbours are the same process.
+ * @param[in] d:   Direction (0: x, 1: y).
+ * @param[in] len: Number of the cells on an edge.
+ * @param[in] tag: Tag of the messages (0: states, 4: slopes).
+ */
+static void halo_post(const int d, const int len, const int tag)
+{
+    int s;
+    for(s = 2*d; s < 2*d+2; ++s)
+	MPI_Irecv(hb.buf_r[s], len*HALO_NV, MPI_DOUBLE, hb.nb[s], tag + s,     hb.comm, &hb.req[d][s-2*d]);
+    for(s = 2*d; s < 2*d+2; ++s)
+	MPI_Isend(hb.buf_s[s], len*HALO_NV, MPI_DOUBLE, hb.nb[s], tag + (s^1), hb.comm, &hb.req[d][s-2*d+2]);
+}
+
+/**
+ * @brief Pack the 2-D field 'v' of cell (j, i) into the l-th variable of the c-th cell in the buffer of side s.
+ */
+#define HALO_PACK(v, l, c)  hb.buf_s[s][(c)*HALO_NV + (l)] = CV->v[j][i]
+#endif
+
+
+/**
+ * @brief This function decomposes the whole grids into the blocks of the processes.
+ * @details The blocks are periodic in the direction of the periodic boundary conditions.
+ *          The number of blocks in a direction is larger for the more grids.
+ * @param[in]  ctx: Pointer to the run context.
+ * @param[in]  M:   Number of the x-grids of the whole grids.
+ * @param[in]  N:   Number of the y-grids of the whole grids.
+ * @param[out] blk: First x/y-grids and number of the x/y-grids of the block of this process {j0, i0, m, n}.
+ * @return     Whether there is an error (0: Success, 4: Too many processes for the grids, 5: Memory error).
+ */
+int halo_block_init_2D(const struct run_ctx * ctx, const int M, const int N, int blk[4])
+{
+    blk[0] = 0;
+    blk[1] = 0;
+    blk[2] = M;
+    blk[3] = N;
+#ifdef MPI_2D
+    int periods[2] = {(int)ctx->conf[17] == -7, (int)ctx->conf[18] == -7}, dims[2] = {0, 0}, s;
+    MPI_Comm_size(MPI_COMM_WORLD, &hb.size);
+    MPI_Dims_create(hb.size, 2, dims);
+    hb.dims[0] = M >= N ? dims[0] : dims[1];
+    hb.dims[1] = M >= N ? dims[1] : dims[0];
+    hb.M = M;
+    hb.N = N;
+    if(hb.dims[0] > M || hb.dims[1] > N)
+	{
+	    printf("Too many processes (%d*%d) for the %d*%d grids!\n", hb.dims[0], hb.dims[1], M, N);
+	    return 4;
+	}
+    MPI_Cart_create(MPI_COMM_WORLD, 2, hb.dims, periods, 0, &hb.comm);
+    MPI_Comm_rank(hb.comm, &hb.rank);
+    MPI_Cart_coords(hb.comm, hb.rank, 2, hb.coords);
+    MPI_Cart_shift(hb.comm, 0, 1, &hb.nb[HALO_L], &hb.nb[HALO_R]);
+    MPI_Cart_shift(hb.comm, 1, 1, &hb.nb[HALO_D], &hb.nb[HALO_U]);
+    halo_block_coords(hb.coords, blk);
+    for(s = 0; s < 4; ++s)
+	{
+	    hb.buf_s[s] = (double *)malloc((s < 2 ? blk[3] : blk[2]) * HALO_NV * sizeof(double));
+	    hb.buf_r[s] = (double *)malloc((s < 2 ? blk[3] : blk[2]) * HALO_NV * sizeof(double));
+	    if(hb.buf_s[s] == NULL || hb.buf_r[s] == NULL)
+		{
+		    printf("NOT enough memory! Halo buffers\n");
+		    return 5;
+		}
+	}
+    if(hb.rank == 0)
+	printf("The %d*%d grids are decomposed into %d*%d blocks.\n", M, N, hb.dims[0], hb.dims[1]);
+#endif
+    return 0;
+}
+
+/**
+ * @brief This function gives the block of the process of rank r.
+ * @param[in]  r:   Rank of the process.
+ * @param[out] blk: First x/y-grids and number of the x/y-grids of the block {j0, i0, m, n}.
+ */
+void halo_block_2D(const int r, int blk[4])
+{
+#ifdef MPI_2D
+    int c[2];
+    MPI_Cart_coords(hb.comm, r, 2, c);
+    halo_block_coords(c, blk);
+#endif
+}
+
+//! This function returns the rank of this process.
+int halo_rank_2D(void)
+{
+#ifdef MPI_2D
+    return hb.rank;
+#else
+    return 0;
+#endif
+}
+
+//! This function returns the number of the processes.
+int halo_size_2D(void)
+{
+#ifdef MPI_2D
+    return hb.size;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief This function frees the buffers and the communicator of the blocks.
+ */
+void halo_block_free_2D(void)
+{
+#ifdef MPI_2D
+    int s;
+    for(s = 0; s < 4; ++s)
+	{
+	    free(hb.buf_s[s]);
+	    free(hb.buf_r[s]);
+	    hb.buf_s[s] = NULL;
+	    hb.buf_r[s] = NULL;
+	}
+    if(hb.comm != MPI_COMM_NULL)
+	MPI_Comm_free(&hb.comm);
+#endif
+}
+
+/**
+ * @brief This function returns the global minimum of the values of the processes.
+ * @param[in] v: Value of this process.
+ */
+double halo_min_2D(double v)
+{
+#ifdef MPI_2D
+    MPI_Allreduce(MPI_IN_PLACE, &v, 1, MPI_DOUBLE, MPI_MIN, hb.comm);
+#endif
+    return v;
+}
+
+/**
+ * @brief This function returns the global maximum of the values of the processes.
+ * @details It is used for the stop indicators and the error codes, so that all processes stop together.
+ * @param[in] v: Value of this process.
+ */
+int halo_max_2D(int v)
+{
+#ifdef MPI_2D
+    MPI_Allreduce(MPI_IN_PLACE, &v, 1, MPI_INT, MPI_MAX, hb.comm);
+#endif
+    return v;
+}
+
+/**
+ * @brief This function exchanges the states of the cells on the x-edges of the block
+ *        and sets them as the ghost cells at the left/right boundary inside the grids.
+ * @param[in] m:    Number of the x-grids of the block.
+ * @param[in] n:    Number of the y-grids of the block.
+ * @param[in] CV:   Structure of cell variable data of the current level.
+ * @param[in,out] bfv_L: Fluid variables at left boundary.
+ * @param[in,out] bfv_R: Fluid variables at right boundary.
+ */
+void halo_state_x(const int m, const int n, const struct cell_var_stru * CV, struct b_f_var * bfv_L, struct b_f_var * bfv_R)
+{
+#ifdef MPI_2D
+    int s, i, j;
+    for(s = HALO_L; s <= HALO_R; ++s)
+	for(i = 0, j = (s == HALO_L ? 0 : m-1); i < n; ++i)
+	    {
+		HALO_PACK(RHO, 0, i); HALO_PACK(U, 1, i); HALO_PACK(V, 2, i); HALO_PACK(P, 3, i);
+	    }
+    halo_post(0, n, 0);
+    MPI_Waitall(4, hb.req[0], MPI_STATUSES_IGNORE);
+    for(i = 0; i < n; ++i)
+	{
+	    if(hb.nb[HALO_L] != MPI_PROC_NULL)
+		{
+		    bfv_L[i].RHO = hb.buf_r[HALO_L][i*HALO_NV];   bfv_L[i].U = hb.buf_r[HALO_L][i*HALO_NV+1];
+		    bfv_L[i].V   = hb.buf_r[HALO_L][i*HALO_NV+2]; bfv_L[i].P = hb.buf_r[HALO_L][i*HALO_NV+3];
+		}
+	    if(hb.nb[HALO_R] != MPI_PROC_NULL)
+		{
+		    bfv_R[i].RHO = hb.buf_r[HALO_R][i*HALO_NV];   bfv_R[i].U = hb.buf_r[HALO_R][i*HALO_NV+1];
+		    bfv_R[i].V   = hb.buf_r[HALO_R][i*HALO_NV+2]; bfv_R[i].P = hb.buf_r[HALO_R][i*HALO_NV+3];
+		}
+	}
+#endif
+}
+
+/**
+ * @brief This function exchanges the states of the cells on the y-edges of the block
+ *        and sets them as the ghost cells at the downside/upper boundary inside the grids.
+ * @param[in] m:    Number of the x-grids of the block.
+ * @param[in] n:    Number of the y-grids of the block.
+ * @param[in] CV:   Structure of cell variable data of the current level.
+ * @param[in,out] bfv_D: Fluid variables at downside boundary.
+ * @param[in,out] bfv_U: Fluid variables at upper boundary.
+ */
+void halo_state_y(const int m, const int n, const struct cell_var_stru * CV, struct b_f_var * bfv_D, struct b_f_var * bfv_U)
+{
+#ifdef MPI_2D
+    int s, i, j;
+    for(s = HALO_D; s <= HALO_U; ++s)
+	for(j = 0, i = (s == HALO_D ? 0 : n-1); j < m; ++j)
+	    {
+		HALO_PACK(RHO, 0, j); HALO_PACK(U, 1, j); HALO_PACK(V, 2, j); HALO_PACK(P, 3, j);
+	    }
+    halo_post(1, m, 0);
+    MPI_Waitall(4, hb.req[1], MPI_STATUSES_IGNORE);
+    for(j = 0; j < m; ++j)
+	{
+	    if(hb.nb[HALO_D] != MPI_PROC_NULL)
+		{
+		    bfv_D[j].RHO = hb.buf_r[HALO_D][j*HALO_NV];   bfv_D[j].U = hb.buf_r[HALO_D][j*HALO_NV+1];
+		    bfv_D[j].V   = hb.buf_r[HALO_D][j*HALO_NV+2]; bfv_D[j].P = hb.buf_r[HALO_D][j*HALO_NV+3];
+		}
+	    if(hb.nb[HALO_U] != MPI_PROC_NULL)
+		{
+		    bfv_U[j].RHO = hb.buf_r[HALO_U][j*HALO_NV];   bfv_U[j].U = hb.buf_r[HALO_U][j*HALO_NV+1];
+		    bfv_U[j].V   = hb.buf_r[HALO_U][j*HALO_NV+2]; bfv_U[j].P = hb.buf_r[HALO_U][j*HALO_NV+3];
+		}
+	}
+#endif
+}
+
+/**
+ * @brief This function starts the exchange of the x/y-slopes of the cells on the x-edges of the block.
+ * @details It is finished by halo_slope_finish_x() after the fluxes on the interior interfaces are computed.
+ * @param[in] m:    Number of the x-grids of the block.
+ * @param[in] n:    Number of the y-grids of the block.
+ * @param[in] CV:   Structure of cell variable data.
+ */
+void halo_slope_start_x(const int m, const int n, const struct cell_var_stru * CV)
+{
+#ifdef MPI_2D
+    int s, i, j;
+    for(s = HALO_L; s <= HALO_R; ++s)
+	for(i = 0, j = (s == HALO_L ? 0 : m-1); i < n; ++i)
+	    {
+		HALO_PACK(s_rho, 0, i); HALO_PACK(s_u, 1, i); HALO_PACK(s_v, 2, i); HALO_PACK(s_p, 3, i);
+		HALO_PACK(t_rho, 4, i); HALO_PACK(t_u, 5, i); HALO_PACK(t_v, 6, i); HALO_PACK(t_p, 7, i);
+	    }
+    halo_post(0, n, 4);
+#endif
+}
+
+/**
+ * @brief This function starts the exchange of the x/y-slopes of the cells on the y-edges of the block.
+ * @details It is finished by halo_slope_finish_y() after the fluxes on the interior interfaces are computed.
+ * @param[in] m:    Number of the x-grids of the block.
+ * @param[in] n:    Number of the y-grids of the block.
+ * @param[in] CV:   Structure of cell variable data.
+ */
+void halo_slope_start_y(const int m, const int n, const struct cell_var_stru * CV)
+{
+#ifdef MPI_2D
+    int s, i, j;
+    for(s = HALO_D; s <= HALO_U; ++s)
+	for(j = 0, i = (s == HALO_D ? 0 : n-1); j < m; ++j)
+	    {
+		HALO_PACK(s_rho, 0, j); HALO_PACK(s_u, 1, j); HALO_PACK(s_v, 2, j); HALO_PACK(s_p, 3, j);
+		HALO_PACK(t_rho, 4, j); HALO_PACK(t_u, 5, j); HALO_PACK(t_v, 6, j); HALO_PACK(t_p, 7, j);
+	    }
+    halo_post(1, m, 4);
+#endif
+}
+
+#ifdef MPI_2D
+/**
+ * @brief This function sets the slopes of a ghost cell from the l-th cell in the received buffer of side s.
+ * @param[out] bfv: Fluid variables of the ghost cell.
+ * @param[in]  s:   Side of the block.
+ * @param[in]  l:   Index of the cell on the edge.
+ */
+static void halo_slope_set(struct b_f_var * bfv, const int s, const int l)
+{
+    const double * b = hb.buf_r[s] + l*HALO_NV;
+    bfv->SRHO = b[0]; bfv->SU = b[1]; bfv->SV = b[2]; bfv->SP = b[3];
+    bfv->TRHO = b[4]; bfv->TU = b[5]; bfv->TV = b[6]; bfv->TP = b[7];
+}
+#endif
+
+/**
+ * @brief This function waits for the exchange of the slopes on the x-edges
+ *        and sets them as the slopes of the ghost cells at the left/right boundary inside the grids.
+ * @param[in] n:    Number of the y-grids of the block.
+ * @param[in,out] bfv_L: Fluid variables at left boundary.
+ * @param[in,out] bfv_R: Fluid variables at right boundary.
+ */
+void halo_slope_finish_x(const int n, struct b_f_var * bfv_L, struct b_f_var * bfv_R)
+{
+#ifdef MPI_2D
+    int i;
+    MPI_Waitall(4, hb.req[0], MPI_STATUSES_IGNORE);
+    for(i = 0; i < n; ++i)
+	{
+	    if(hb.nb[HALO_L] != MPI_PROC_NULL)
+		halo_slope_set(bfv_L + i, HALO_L, i);
+	    if(hb.nb[HALO_R] != MPI_PROC_NULL)
+		halo_slope_set(bfv_R + i, HALO_R, i);
+	}
+#endif
+}
+
+/**
+ * @brief This function waits for the exchange of the slopes on the y-edges
+ *        and sets them as the slopes of the ghost cells at the downside/upper boundary inside the grids.
+ * @param[in] m:    Number of the x-grids of the block.
+ * @param[in,out] bfv_D: Fluid variables at downside boundary.
+ * @param[in,out] bfv_U: Fluid variables at upper boundary.
+ */
+void halo_slope_finish_y(const int m, struct b_f_var * bfv_D, struct b_f_var * bfv_U)
+{
+#ifdef MPI_2D
+    int j;
+    MPI_Waitall(4, hb.req[1], MPI_STATUSES_IGNORE);
+    for(j = 0; j < m; ++j)
+	{
+	    if(hb.nb[HALO_D] != MPI_PROC_NULL)
+		halo_slope_set(bfv_D + j, HALO_D, j);
+	    if(hb.nb[HALO_U] != MPI_PROC_NULL)
+		halo_slope_set(bfv_U + j, HALO_U, j);
+	}
+#endif
+}
@@ -11,8 +11,11 @@
 #include "../include_cpp/inter_process_cpp.hpp"
 
 
+#define VIP_BATCH 64 //!< Number of the cells of a block limited by useVIPLimiter_batch().
+
 /**
  * @brief This function apply the VIP/minmod limiter to the slope of the fluid velocity in radially symmetric case.
+ * @details The cells are limited in blocks of VIP_BATCH cells by useVIPLimiter_batch() without the heap memory.
  * @param[in] Ncell:      Number of the r-grids.
  * @param[in] i_f_var_get: Whether the cell interfacial variables have been obtained.
  *                        - true: interfacial variables at t_{n+1} are available, 
@@ -42,69 +45,79 @@ void VIP_limiter_radial(const int Ncell, const _Bool i_f_var_get, double DmU[],
     double * dRc  = rmv->dRc;
 
     double sU, sV;
-    double VIP_lim, Vave[4][2], V0[2], Vp1[2], Vp2[2], Vp3[2];//VIP limiter
+    // VIP limiter of a block of VIP_BATCH cells on the stack
+    double VIP_lim[VIP_BATCH], Vave[VIP_BATCH][VIP_NEIGH_MAX][2], V0[VIP_BATCH][2], Vp[VIP_BATCH*3][2];
+    int i, i0, b, nb;
 
     //VIP limiter update
-    for(int i = 1; i <= Ncell; i++)
+    for(i0 = 1; i0 <= Ncell; i0 += VIP_BATCH)
 	{
-	    //sV=0.0;
-	    //sV=VLmin[i]/(0.5*(Rb[i]+Rb[i+1])*tan(0.5*dtheta));
-	    sV=UU[i]/(0.5*(Rb[i]+Rb[i+1]));
-	    sU=DmU[i];
-	    Vave[0][0] = UU[i+1];
-	    Vave[0][1] = 0.0;
-	    Vave[1][0] = UU[i-1];
-	    Vave[1][1] = 0.0;
-	    Vave[2][0] = UU[i]*cos(dtheta);
-	    Vave[2][1] = UU[i]*sin(dtheta);
-	    Vave[3][0] = UU[i]*cos(dtheta);
-	    Vave[3][1] =-UU[i]*sin(dtheta);
-	    V0[0] = UU[i];
-	    V0[1] = 0.0;
-	    Vp1[0] = UU[i]+(0.5*(Rb[i]+Rb[i+1])-RR[i])*sU;
-	    Vp1[1] = 0.5*(Rb[i]+Rb[i+1])*tan(0.5*dtheta)*sV;
-	    Vp2[0] = UU[i]+DdrL[i]*sU;
-	    Vp2[1] = 0.0;
-	    Vp3[0] = UU[i]-DdrR[i]*sU;
-	    Vp3[1] = 0.0;
-	    VIP_lim = fmin(1.0,     useVIPLimiter(4, Vave, V0, Vp1));
-	    VIP_lim = fmin(VIP_lim, useVIPLimiter(4, Vave, V0, Vp2));
-	    VIP_lim = fmin(VIP_lim, useVIPLimiter(4, Vave, V0, Vp3));
-	    DmU[i]=VIP_lim*sU;
-	    TmV[i]=VIP_lim*sV;
-	    if (abs(LIMITER_VIP)==1)
+	    nb = Ncell+1-i0 < VIP_BATCH ? Ncell+1-i0 : VIP_BATCH;
+	    for(b = 0; b < nb; b++)
 		{
-		    if(LIMITER_VIP>0)
-			DmU[i]=minmod3(Alpha*(UU[i]-UU[i-1])/dRc[i],sU,Alpha*(UU[i+1]-UU[i])/dRc[i+1]);
+		    i = i0 + b;
+		    //sV=0.0;
+		    //sV=VLmin[i]/(0.5*(Rb[i]+Rb[i+1])*tan(0.5*dtheta));
+		    sV=UU[i]/(0.5*(Rb[i]+Rb[i+1]));
+		    sU=DmU[i];
+		    Vave[b][0][0] = UU[i+1];
+		    Vave[b][0][1] = 0.0;
+		    Vave[b][1][0] = UU[i-1];
+		    Vave[b][1][1] = 0.0;
+		    Vave[b][2][0] = UU[i]*cos(dtheta);
+		    Vave[b][2][1] = UU[i]*sin(dtheta);
+		    Vave[b][3][0] = UU[i]*cos(dtheta);
+		    Vave[b][3][1] =-UU[i]*sin(dtheta);
+		    V0[b][0] = UU[i];
+		    V0[b][1] = 0.0;
+		    Vp[3*b][0]   = UU[i]+(0.5*(Rb[i]+Rb[i+1])-RR[i])*sU;
+		    Vp[3*b][1]   = 0.5*(Rb[i]+Rb[i+1])*tan(0.5*dtheta)*sV;
+		    Vp[3*b+1][0] = UU[i]+DdrL[i]*sU;
+		    Vp[3*b+1][1] = 0.0;
+		    Vp[3*b+2][0] = UU[i]-DdrR[i]*sU;
+		    Vp[3*b+2][1] = 0.0;
 		}
-	    else if (abs(LIMITER_VIP)==2)
+	    useVIPLimiter_batch(nb, 4, 3, (const double (*)[VIP_NEIGH_MAX][2])Vave, V0, Vp, VIP_lim);
+	    for(b = 0; b < nb; b++)
 		{
-		    if(LIMITER_VIP>0)
-			DmU[i]=minmod3(Alpha*(UU[i]-UU[i-1])/2./DdrR[i],sU,Alpha*(UU[i+1]-UU[i])/2./DdrL[i]);
+		    i = i0 + b;
+		    sV=UU[i]/(0.5*(Rb[i]+Rb[i+1]));
+		    sU=DmU[i];
+		    DmU[i]=VIP_lim[b]*sU;
+		    TmV[i]=VIP_lim[b]*sV;
+		    if (abs(LIMITER_VIP)==1)
+			{
+			    if(LIMITER_VIP>0)
+				DmU[i]=minmod3(Alpha*(UU[i]-UU[i-1])/dRc[i],sU,Alpha*(UU[i+1]-UU[i])/dRc[i+1]);
+			}
+		    else if (abs(LIMITER_VIP)==2)
+			{
+			    if(LIMITER_VIP>0)
+				DmU[i]=minmod3(Alpha*(UU[i]-UU[i-1])/2./DdrR[i],sU,Alpha*(UU[i+1]-UU[i])/2./DdrL[i]);
+			}
+		    if (LIMITER_VIP>0)
+			TmV[i]=minmod2(Alpha*(UU[i]*sin(dtheta))/2./(0.5*(Rb[i]+Rb[i+1])*tan(0.5*dtheta)),sV);
 		}
-	    if (LIMITER_VIP>0)
-		TmV[i]=minmod2(Alpha*(UU[i]*sin(dtheta))/2./(0.5*(Rb[i]+Rb[i+1])*tan(0.5*dtheta)),sV);
 	}
     //sV=0.0;
     //sV=VLmin[1]/(0.5*Rb[1]*tan(0.5*dtheta));
     sU=DmU[0];
     sV=UU[0]/Rb[1];
-    Vave[0][0] = UU[1];
-    Vave[0][1] = 0.0;
-    Vave[1][0] = UU[0]*cos(dtheta);
-    Vave[1][1] = UU[0]*sin(dtheta);
-    Vave[2][0] = UU[0]*cos(dtheta);
-    Vave[2][1] =-UU[0]*sin(dtheta);
-    V0[0] = UU[0];
-    V0[1] = 0.0;
-    Vp1[0] = UU[0]+(0.5*Rb[1]-RR[0])*sU;
-    Vp1[1] = 0.5*Rb[1]*tan(0.5*dtheta)*sV;
-    Vp2[0] = UU[0]+DdrL[0]*sU;
-    Vp2[1] = 0.0;
-    VIP_lim = fmin(1.0,     useVIPLimiter(3, Vave, V0, Vp1));
-    VIP_lim = fmin(VIP_lim, useVIPLimiter(3, Vave, V0, Vp2));
-    DmU[0]=VIP_lim*sU;
-    TmV[0]=VIP_lim*sV;
+    Vave[0][0][0] = UU[1];
+    Vave[0][0][1] = 0.0;
+    Vave[0][1][0] = UU[0]*cos(dtheta);
+    Vave[0][1][1] = UU[0]*sin(dtheta);
+    Vave[0][2][0] = UU[0]*cos(dtheta);
+    Vave[0][2][1] =-UU[0]*sin(dtheta);
+    V0[0][0] = UU[0];
+    V0[0][1] = 0.0;
+    Vp[0][0] = UU[0]+(0.5*Rb[1]-RR[0])*sU;
+    Vp[0][1] = 0.5*Rb[1]*tan(0.5*dtheta)*sV;
+    Vp[1][0] = UU[0]+DdrL[0]*sU;
+    Vp[1][1] = 0.0;
+    useVIPLimiter_batch(1, 3, 2, (const double (*)[VIP_NEIGH_MAX][2])Vave, V0, Vp, VIP_lim);
+    DmU[0]=VIP_lim[0]*sU;
+    TmV[0]=VIP_lim[0]*sV;
     if (LIMITER_VIP>0)
 	{
 	    DmU[0]=minmod2(sU,DmU[1]);
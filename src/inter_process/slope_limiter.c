@@ -1,83 +1,156 @@
 /**
  * @file  slope_limiter.c
- * @brief This is a function of the minmod slope limiter in one dimension.
+ * @brief There are the kernels of the minmod slope limiter in one dimension.
+ * @details The interior cells are limited in the branch-free loops of MINMOD_LOOP() over contiguous arrays,
+ *          and the boundary cells are peeled out of the loops.
  */
 #include <stdio.h>
-#include <stdarg.h>
 
 #include "../include/var_struc.h"
 #include "../include/tools.h"
 
 
+#define MINMOD_BLOCK 256 //!< Number of the cells of a block in which all the variables are limited in one pass.
+
+/**
+ * @brief This function limits the slope of a boundary cell.
+ */
+static inline void minmod_cell(const double alpha, const _Bool i_f_var_get, double * s, const double s_L, const double s_R)
+{
+    if (i_f_var_get)
+	*s = minmod3(alpha*s_L, alpha*s_R, *s);
+    else
+	*s = minmod2(s_L, s_R);
+}
+
 /**
- * @brief This function apply the minmod limiter to the slope in one dimension.
- * @param[in] NO_h:       Whether there are moving grid point coordinates.
- *                  - true: There are moving spatial grid point coordinates *X.
- *                  - false: There is fixed spatial grid length.
- * @param[in] m:         Number of the x-grids: n_x.
+ * @brief This function limits the slopes of the cells j0 <= j < j1 of m cells with fixed grid length.
+ */
+static void minmod_range_h(const double alpha, const _Bool i_f_var_get, const int m, const int j0, const int j1, double s[],
+			   const double U[], const double UL, const double UR, const double h)
+{
+    const int i0 = j0 > 1 ? j0 : 1, i1 = j1 < m-1 ? j1 : m-1;
+    if (j0 == 0)
+	minmod_cell(alpha, i_f_var_get, s, (U[0] - UL) / h, ((m > 1 ? U[1] : UR) - U[0]) / h);
+    MINMOD_LOOP(i_f_var_get, alpha, j, i0, i1, s, (U[j] - U[j-1]) / h, (U[j+1] - U[j]) / h);
+    if (j1 == m && m > 1)
+	minmod_cell(alpha, i_f_var_get, s+m-1, (U[m-1] - U[m-2]) / h, (UR - U[m-1]) / h);
+}
+
+/**
+ * @brief This function limits the slopes of the cells j0 <= j < j1 of m cells with moving grid points.
+ */
+static void minmod_range_X(const double alpha, const _Bool i_f_var_get, const int m, const int j0, const int j1, double s[],
+			   const double U[], const double UL, const double UR, const double HL, const double HR, const double X[])
+{ /*
+   *  j-1          j          j+1
+   * j-1/2  j-1  j+1/2   j   j+3/2  j+1
+   *   o-----X-----o-----X-----o-----X--...
+   */
+    const int i0 = j0 > 1 ? j0 : 1, i1 = j1 < m-1 ? j1 : m-1;
+    if (j0 == 0)
+	minmod_cell(alpha, i_f_var_get, s, (U[0] - UL) / (0.5 * (X[1] - X[0] + HL)),
+		    m > 1 ? (U[1] - U[0]) / (0.5 * (X[2] - X[0])) : (UR - U[0]) / (0.5 * (X[1] - X[0] + HR)));
+    MINMOD_LOOP(i_f_var_get, alpha, j, i0, i1, s, (U[j] - U[j-1]) / (0.5 * (X[j+1] - X[j-1])),
+		(U[j+1] - U[j]) / (0.5 * (X[j+2] - X[j])));
+    if (j1 == m && m > 1)
+	minmod_cell(alpha, i_f_var_get, s+m-1, (U[m-1] - U[m-2]) / (0.5 * (X[m] - X[m-2])),
+		    (UR - U[m-1]) / (0.5 * (X[m] - X[m-1] + HR)));
+}
+
+/**
+ * @brief This function apply the minmod limiter to the slope in one dimension with fixed grid length.
+ * @param[in] alpha:      The paramater in slope limiters.
  * @param[in] i_f_var_get: Whether the cell interfacial variables have been obtained.
- *                        - true: interfacial variables at t_{n+1} are available, 
+ *                        - true: interfacial variables at t_{n+1} are available,
  *                                and then trivariate minmod3() function is used.
  *                        - false: bivariate minmod2() function is used.
- * @param[in,out] s[]:    Spatial derivatives of the fluid variable are stored here.
+ * @param[in] m:   Number of the x-grids: n_x.
+ * @param[in,out] s[]: Spatial derivatives of the fluid variable are stored here.
  * @param[in] U[]: Array to store fluid variable values.
  * @param[in] UL:  Fluid variable value at left boundary.
  * @param[in] UR:  Fluid variable value at right boundary.
- * @param[in] HL:  Spatial grid length at left boundary OR fixed spatial grid length.
- * @param[in] ...: Variable parameter if NO_h is true.
- *            - \b double \c HR: Spatial grid length at right boundary.
- *            - \b double \c *X: Array of moving spatial grid point coordinates.
+ * @param[in] h:   Fixed spatial grid length.
  */
-void minmod_limiter(const _Bool NO_h, const int m, const _Bool i_f_var_get, double s[],
-		    const double U[], const double UL, const double UR, const double HL, ...)
+void minmod_limiter_h(const double alpha, const _Bool i_f_var_get, const int m, double s[],
+		      const double U[], const double UL, const double UR, const double h)
 {
-    va_list ap;
-    va_start(ap, HL);
-    double const alpha = config[41]; // the paramater in slope limiters.
-    double s_L, s_R; // spatial derivatives in coordinate x (slopes) 
-    double h = HL, HR, * X;
-    if (NO_h)
-	{
-	    HR = va_arg(ap, double);
-	    X  = va_arg(ap, double *);
-	}
-#ifdef _OPENACC
-#pragma acc parallel loop private(s_L, s_R, h)
+    minmod_range_h(alpha, i_f_var_get, m, 0, m, s, U, UL, UR, h);
+}
+
+/**
+ * @brief This function apply the minmod limiter to the slope in one dimension with moving grid points.
+ * @param[in] alpha:       The paramater in slope limiters.
+ * @param[in] i_f_var_get: Whether the cell interfacial variables have been obtained.
+ * @param[in] m:   Number of the x-grids: n_x.
+ * @param[in,out] s[]: Spatial derivatives of the fluid variable are stored here.
+ * @param[in] U[]: Array to store fluid variable values.
+ * @param[in] UL:  Fluid variable value at left boundary.
+ * @param[in] UR:  Fluid variable value at right boundary.
+ * @param[in] HL:  Spatial grid length at left boundary.
+ * @param[in] HR:  Spatial grid length at right boundary.
+ * @param[in] X[]: Array of moving spatial grid point coordinates.
+ */
+void minmod_limiter_X(const double alpha, const _Bool i_f_var_get, const int m, double s[],
+		      const double U[], const double UL, const double UR, const double HL, const double HR, const double X[])
+{
+    minmod_range_X(alpha, i_f_var_get, m, 0, m, s, U, UL, UR, HL, HR, X);
+}
+
+/**
+ * @brief This function apply the minmod limiter to the slopes of several fluid variables in one dimension.
+ * @details The cells are limited block by block, and all the variables of a block are limited in one pass,
+ *          so that the grid point coordinates of the block are read from the cache.
+ * @param[in] ctx:  Pointer to the run context.
+ * @param[in] NO_h: Whether there are moving grid point coordinates.
+ *                  - true: There are moving spatial grid point coordinates X[].
+ *                  - false: There is fixed spatial grid length HL.
+ * @param[in] m:    Number of the x-grids: n_x.
+ * @param[in] i_f_var_get: Whether the cell interfacial variables have been obtained.
+ * @param[in] nv:   Number of the fluid variables.
+ * @param[in,out] s: Spatial derivatives of the fluid variables are stored here.
+ * @param[in] U:    Arrays to store fluid variable values.
+ * @param[in] UL[]: Fluid variable values at left boundary.
+ * @param[in] UR[]: Fluid variable values at right boundary.
+ * @param[in] HL:   Spatial grid length at left boundary OR fixed spatial grid length.
+ * @param[in] HR:   Spatial grid length at right boundary (used if NO_h is true).
+ * @param[in] X[]:  Array of moving spatial grid point coordinates (used if NO_h is true).
+ */
+void minmod_limiter_vars(const struct run_ctx * ctx, const _Bool NO_h, const int m, const _Bool i_f_var_get, const int nv,
+			 double * const s[], const double * const U[], const double UL[], const double UR[],
+			 const double HL, const double HR, const double X[])
+{
+    double const alpha = ctx->conf[41]; // the paramater in slope limiters.
+    const int n_blk = (m + MINMOD_BLOCK - 1) / MINMOD_BLOCK;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(n_blk > 1)
 #endif
-    for(int j = 0; j < m; ++j) // Reconstruct slopes
-	{ /*
-	   *  j-1          j          j+1
-	   * j-1/2  j-1  j+1/2   j   j+3/2  j+1
-	   *   o-----X-----o-----X-----o-----X--...
-	   */
-	    if(j)
-		{
-		    if (NO_h)
-			h = 0.5 * (X[j+1] - X[j-1]);
-		    s_L = (U[j] - U[j-1]) / h;
-		}
-	    else
-		{
-		    if (NO_h)
-			h = 0.5 * (X[j+1] - X[j] + HL);
-		    s_L = (U[j] - UL) / h;
-		}
-	    if(j < m-1)
-		{
-		    if (NO_h)
-			h = 0.5 * (X[j+2] - X[j]);
-		    s_R = (U[j+1] - U[j]) / h;
-		}
-	    else
-		{
-		    if (NO_h)
-			h = 0.5 * (X[j+1] - X[j] + HR);
-		    s_R = (UR - U[j]) / h;
-		}
-	    if (i_f_var_get)
-		s[j] = minmod3(alpha*s_L, alpha*s_R, s[j]);
-	    else
-		s[j] = minmod2(s_L, s_R);
+    for(int b = 0; b < n_blk; ++b)
+	{
+	    const int j0 = b*MINMOD_BLOCK, j1 = j0+MINMOD_BLOCK < m ? j0+MINMOD_BLOCK : m;
+	    for(int k = 0; k < nv; ++k)
+		if (NO_h)
+		    minmod_range_X(alpha, i_f_var_get, m, j0, j1, s[k], U[k], UL[k], UR[k], HL, HR, X);
+		else
+		    minmod_range_h(alpha, i_f_var_get, m, j0, j1, s[k], U[k], UL[k], UR[k], HL);
 	} // End of parallel region
-    va_end(ap);
+}
+
+/**
+ * @brief This function apply the minmod limiter to the slopes of a line of interior cells with fixed grid length.
+ * @details The cell i of the line lies between the cells Um[i] and Up[i],
+ *          as on the adjacent lines of the two-dimensional fields or on the shifted arrays of a line.
+ * @param[in] alpha:       The paramater in slope limiters.
+ * @param[in] i_f_var_get: Whether the cell interfacial variables have been obtained.
+ * @param[in] n:    Number of the cells of the line.
+ * @param[in,out] s[]: Spatial derivatives of the fluid variable are stored here.
+ * @param[in] Um[]: Fluid variable values of the left neighbours.
+ * @param[in] U0[]: Fluid variable values of the cells.
+ * @param[in] Up[]: Fluid variable values of the right neighbours.
+ * @param[in] h:    Fixed spatial grid length.
+ */
+void minmod_limiter_row(const double alpha, const _Bool i_f_var_get, const int n, Real_Store s[],
+			const double Um[], const double U0[], const double Up[], const double h)
+{
+    MINMOD_LOOP(i_f_var_get, alpha, i, 0, n, s, (U0[i] - Um[i]) / h, (Up[i] - U0[i]) / h);
 }
@@ -0,0 +1,66 @@
+/**
+ * @file  slope_limiter_2D_y.c
+ * @brief This is a function of the minmod slope limiter in the y-direction of two dimension.
+ */
+#include <stdio.h>
+
+#include "../include/var_struc.h"
+#include "../include/inter_process.h"
+#include "../include/tools.h"
+
+
+/**
+ * @brief This function apply the minmod limiter to the slope in the y-direction of two dimension with fixed grid length.
+ * @details The boundary cells are peeled out of the kernel minmod_limiter_row() of the contiguous interior cells.
+ * @param[in] alpha:      The paramater in slope limiters.
+ * @param[in] i_f_var_y_get: Whether the cell interfacial variables in y-direction have been obtained.
+ *                        - true: interfacial variables at t_{n+1} are available, 
+ *                                and then trivariate minmod3() function is used.
+ *                        - false: bivariate minmod2() function is used.
+ * @param[in] n:          Number of the y-grids.
+ * @param[in] j:          On the j-th column grid.
+ * @param[in,out] s:      y-spatial derivatives of the fluid variable are stored here.
+ * @param[in] U:   Array to store fluid variable values.
+ * @param[in] UL:  Fluid variable value at downside boundary.
+ * @param[in] UR:  Fluid variable value at upper boundary.
+ * @param[in] h:   Fixed y-spatial grid length.
+ */
+void minmod_limiter_2D_y(const double alpha, const _Bool i_f_var_y_get, const int n, const int j, Real_Store ** s,
+			 double ** U, const double UL, const double UR, const double h)
+{ /*
+   *  i-1          i          i+1
+   * i-1/2  i-1  i+1/2   i   i+3/2  i+1
+   *   o-----X-----o-----X-----o-----X--...
+   */
+    minmod_limiter_2D_y_cell(alpha, i_f_var_y_get, n, j, 0, s, U, UL, UR, h);
+    if (n > 2)
+	minmod_limiter_row(alpha, i_f_var_y_get, n-2, s[j]+1, U[j], U[j]+1, U[j]+2, h);
+    if (n > 1)
+	minmod_limiter_2D_y_cell(alpha, i_f_var_y_get, n, j, n-1, s, U, UL, UR, h);
+}
+
+/**
+ * @brief This function apply the minmod limiter to the slope of a cell in the y-direction of two dimension with fixed grid length.
+ * @details It is a device routine of OpenACC, called in the loops over the cells.
+ * @param[in] alpha:      The paramater in slope limiters.
+ * @param[in] i_f_var_y_get: Whether the cell interfacial variables in y-direction have been obtained.
+ * @param[in] n:          Number of the y-grids.
+ * @param[in] j:          On the j-th column grid.
+ * @param[in] i:          On the i-th line grid.
+ * @param[in,out] s:      y-spatial derivatives of the fluid variable are stored here.
+ * @param[in] U:   Array to store fluid variable values.
+ * @param[in] UL:  Fluid variable value at downside boundary.
+ * @param[in] UR:  Fluid variable value at upper boundary.
+ * @param[in] h:   Fixed y-spatial grid length.
+ */
+ACC_ROUTINE_SEQ
+void minmod_limiter_2D_y_cell(const double alpha, const _Bool i_f_var_y_get, const int n, const int j, const int i, Real_Store ** s,
+			      double ** U, const double UL, const double UR, const double h)
+{
+    const double s_L = (U[j][i] - (i ? U[j][i-1] : UL)) / h;
+    const double s_R = ((i < n-1 ? U[j][i+1] : UR) - U[j][i]) / h;
+    if (i_f_var_y_get)
+	s[j][i] = minmod3(alpha*s_L, alpha*s_R, s[j][i]);
+    else
+	s[j][i] = minmod2(s_L, s_R);
+}
@@ -25,30 +25,16 @@ void minmod_limiter_radial(const int Ncell, const _Bool i_f_var_get, double s[],
 {
     double const Alpha       =      config[41]; // the paramater in slope limiters.
     int    const LIMITER_VIP = (int)config[42];
-    double s_L, s_R; // spatial derivatives in coordinate x (slopes)
 
     //minmod limiter update
-    for(int j = 1; j <= Ncell; ++j) // Reconstruct slopes
+    if (abs(LIMITER_VIP)==1)
+	MINMOD_LOOP(i_f_var_get, Alpha, j, 1, Ncell+1, s, (U[j] - U[j-1]) / rmv->dRc[j], (U[j+1] - U[j]) / rmv->dRc[j+1]);
+    else if (abs(LIMITER_VIP)==2)
+	MINMOD_LOOP(i_f_var_get, Alpha, j, 1, Ncell+1, s, (U[j] - U[j-1]) / 2.0 / rmv->DdrR[j], (U[j+1] - U[j]) / 2.0 / rmv->DdrL[j]);
+    else
 	{
-	    if (abs(LIMITER_VIP)==1)
-		{
-		    s_L = (U[j]   - U[j-1]) / rmv->dRc[j];
-		    s_R = (U[j+1] - U[j])   / rmv->dRc[j+1];
-		}
-	    else if (abs(LIMITER_VIP)==2)
-		{
-		    s_L = (U[j]   - U[j-1]) / 2.0 / rmv->DdrR[j];
-		    s_R = (U[j+1] - U[j])   / 2.0 / rmv->DdrL[j];
-		}
-	    else
-		{
-		    fprintf(stderr, "ERROE! No suitable LIMITER_VIP Parameter.\n");
-		    exit(2);
-		}
-	    if (i_f_var_get)
-		s[j] = minmod3(Alpha*s_L, Alpha*s_R, s[j]);
-	    else
-		s[j] = minmod2(s_L, s_R);
+	    fprintf(stderr, "ERROE! No suitable LIMITER_VIP Parameter.\n");
+	    exit(2);
 	}
     s[0] = minmod2(s[0], s[1]);
     s[Ncell+1] = minmod2(s[Ncell], s[Ncell+1]);
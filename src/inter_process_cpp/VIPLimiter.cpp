@@ -2,6 +2,7 @@
 /// @file   VIPLimiter.cpp
 /// @brief  The subroutin implements the VIP limiter for simulations of 2D flows on structured grids.
 /// @note   Note, this is only a limiter to limit the velocity vector V=(u,v) for 2D flows. 
+///         The convex hull is kept on the stack, the limiter does not allocate memory.
 /// @sa     The specific implementation is mainly based on Section 2.1-2.3 of the paper [1]: \n
 ///         [1] G. Luttwak & J. Falcovitz, Slope limiting for vectors, A novel vector limiting algorithm,
 ///             Int. J. Numer. Meth. Fluids., 65:1365-1375, 2011.
@@ -11,10 +12,38 @@
 
 #include <iostream>
 #include <algorithm>
-#include <vector>
 #include <cmath>
 
 #include "../include/var_struc.h"
+#include "../include_cpp/inter_process_cpp.hpp"
+
+
+///////////////////////////////////////////////////
+/// @brief Convex hull (CH) of the face neighbor velocities with a fixed capacity on the stack.
+/// @note  The vertices are in counterclockwise order, there are at most VIP_NEIGH_MAX of them.
+///////////////////////////////////////////////////
+struct VIPHull
+{
+	int    n;                   //!< number of the vertices.
+	double v[VIP_NEIGH_MAX][2]; //!< coordinates of the vertices.
+
+	double*       operator[](const int k)       { return v[k]; }
+	const double* operator[](const int k) const { return v[k]; }
+	int size() const { return n; }
+
+	/// @brief Insert the vertex (x, y) before the k-th vertex (k = n: append it).
+	void insert(const int k, const double x, const double y)
+	{
+		for(int i = n; i > k; --i)
+		{
+			v[i][0] = v[i-1][0];
+			v[i][1] = v[i-1][1];
+		}
+		v[k][0] = x;
+		v[k][1] = y;
+		++n;
+	}
+};
 
 
 ///////////////////////////////////////////////////
@@ -25,10 +54,10 @@ static void getPerpendFoot  (double x0, double y0, double x1, double y1, double
 static bool obtuseAngle     (double x0, double y0, double xa, double ya, double xb, double yb);
 static bool insideSegment   (double x0, double y0, double x1, double y1, double xp, double yp);
 static double insectionPoint(double x0, double y0, double x1, double y1, double x2, double y2, double x3, double y3, double* Vp);
-static bool insideTriCH (std::vector<std::vector<double> >& CH, const bool flag, double* Vp);
-static bool insideQuadCH(std::vector<std::vector<double> >& CH, const bool flag, double* Vp);
-static bool insideTriCH (std::vector<std::vector<double> >& CH, const bool flag, double* V0, double* Vp, double& lambda);
-static bool insideQuadCH(std::vector<std::vector<double> >& CH, const bool flag, double* V0, double* Vp, double& lambda);
+static bool insideTriCH (const VIPHull& CH, const bool flag, double* Vp);
+static bool insideQuadCH(const VIPHull& CH, const bool flag, double* Vp);
+static bool insideTriCH (const VIPHull& CH, const bool flag, double* V0, double* Vp, double& lambda);
+static bool insideQuadCH(const VIPHull& CH, const bool flag, double* V0, double* Vp, double& lambda);
 
 
 ///////////////////////////////////////////////////
@@ -56,7 +85,8 @@ double useVIPLimiter(const int neigh_cell_num, const double Vave[][2], double* V
 	bool colinear(true);
 	int count(0);
 	double area(0);
-	std::vector<std::vector<double> > CH(2, std::vector<double>(2));
+	VIPHull CH;
+	CH.n = 2;
 
 	//Temporally, we choose to do noting in these cases...
 	if(neigh_cell_num != 3 && neigh_cell_num != 4)
@@ -104,14 +134,11 @@ double useVIPLimiter(const int neigh_cell_num, const double Vave[][2], double* V
 		{
 			count = e+1;
 
-			std::vector<double> new_node(2);
-			new_node[0] = Vave[e][0];
-			new_node[1] = Vave[e][1];
 			//CH 0->1->2 counterclockwise
 			if( area > 0 )
-				CH.push_back(new_node);
+				CH.insert(2, Vave[e][0], Vave[e][1]);
 			else
-				CH.insert(CH.begin()+1,new_node);
+				CH.insert(1, Vave[e][0], Vave[e][1]);
 
 			colinear = false;
 
@@ -207,24 +234,15 @@ double useVIPLimiter(const int neigh_cell_num, const double Vave[][2], double* V
 		}
 		else if (face0)
 		{
-			std::vector<double> new_node(2);
-			new_node[0] = Vave[count][0];
-			new_node[1] = Vave[count][1];
-			CH.insert(CH.begin() + 2, new_node);
+			CH.insert(2, Vave[count][0], Vave[count][1]);
 		}
 		else if (face1)
 		{
-			std::vector<double> new_node(2);
-			new_node[0] = Vave[count][0];
-			new_node[1] = Vave[count][1];
-			CH.insert(CH.begin() + 3, new_node);
+			CH.insert(3, Vave[count][0], Vave[count][1]);
 		}
 		else if (face2)
 		{
-			std::vector<double> new_node(2);
-			new_node[0] = Vave[count][0];
-			new_node[1] = Vave[count][1];
-			CH.insert(CH.begin() + 1, new_node);
+			CH.insert(1, Vave[count][0], Vave[count][1]);
 		}
 		else
 		{
@@ -265,6 +283,28 @@ double useVIPLimiter(const int neigh_cell_num, const double Vave[][2], double* V
 
 	return lambda;
 }
+
+///////////////////////////////////////////////////
+/// @brief Subroutine of using VIP limiter for the 2D velocity vectors of a sweep of cells.
+/// @note  The limiting coefficient of a cell is the smallest one of its given locations, see useVIPLimiter().
+/// @param[in] n_cell: number of the cells.
+/// @param[in] neigh_cell_num: number of neighbor cells of each cell (3 or 4).
+/// @param[in] n_p: number of the given locations in each cell.
+/// @param[in] Vave: the average velocity vectors of neighbor cells of each cell.
+/// @param[in] V0: the cell average velocity of each cell.
+/// @param[in,out] Vp: the velocities of the n_p given locations of each cell, those of the i-th cell are Vp[i*n_p], ...
+/// @param[out] lambda: the limiting coefficient ( in [0, 1] ) for gradient vector of each cell.
+///////////////////////////////////////////////////
+void useVIPLimiter_batch(const int n_cell, const int neigh_cell_num, const int n_p,
+			 const double Vave[][VIP_NEIGH_MAX][2], double V0[][2], double Vp[][2], double lambda[])
+{
+	for(int i = 0; i < n_cell; ++i)
+	{
+		lambda[i] = 1.0;
+		for(int p = 0; p < n_p; ++p)
+			lambda[i] = fmin(lambda[i], useVIPLimiter(neigh_cell_num, Vave[i], V0[i], Vp[i*n_p+p]));
+	}
+}
 #ifdef __cplusplus
 }
 #endif
@@ -333,7 +373,7 @@ static double insectionPoint(double x0, double y0, double x1, double y1, double
 	return t;
 }
 
-static bool insideTriCH(std::vector<std::vector<double> >& CH, const bool flag, double* Vp)
+static bool insideTriCH(const VIPHull& CH, const bool flag, double* Vp)
 {
 	bool face0(false), face1(false), face2(false);
 
@@ -433,7 +473,7 @@ static bool insideTriCH(std::vector<std::vector<double> >& CH, const bool flag,
 	return true;
 }
 
-static bool insideQuadCH(std::vector<std::vector<double> >& CH, const bool flag, double* Vp)
+static bool insideQuadCH(const VIPHull& CH, const bool flag, double* Vp)
 {
 	bool face0(false), face1(false), face2(false), face3(false);
 
@@ -555,7 +595,7 @@ static bool insideQuadCH(std::vector<std::vector<double> >& CH, const bool flag,
 	return true;
 }
 
-static bool insideTriCH(std::vector<std::vector<double> >& CH, const bool flag, double* V0, double* Vp, double& lambda)
+static bool insideTriCH(const VIPHull& CH, const bool flag, double* V0, double* Vp, double& lambda)
 {
 	bool face0(false), face1(false), face2(false);
 
@@ -648,7 +688,7 @@ static bool insideTriCH(std::vector<std::vector<double> >& CH, const bool flag,
 	}
 }
 
-static bool insideQuadCH(std::vector<std::vector<double> >& CH, const bool flag, double* V0, double* Vp, double& lambda)
+static bool insideQuadCH(const VIPHull& CH, const bool flag, double* V0, double* Vp, double& lambda)
 {
 	bool face0(false), face1(false), face2(false), face3(false);
 
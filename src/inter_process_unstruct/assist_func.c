@@ -11,25 +11,42 @@ int fluid_var_update(struct flu_var * FV, struct cell_var * cv)
 {
 	const int num_cell = (int)config[3];
 	struct i_f_var ifv;
+	int err = 0;
 
+#ifdef _OPENACC
+#pragma acc parallel loop private(ifv) reduction(|:err) present(FV[0:1], cv[0:1]) default(present)
+#else
+#pragma omp parallel for private(ifv) reduction(|:err)
+#endif
 	for(int k = 0; k < num_cell; ++k)
 		{
 			cons_qty_copy_cv2ifv(&ifv, cv, k);			
 
 			if(cons2prim(&ifv) == 0)
 				{
-					fprintf(stderr, "Wrong in copying cons_var to prim_var!\n");
-					return 0;
+					ERR_PRINTF("Wrong in copying cons_var to prim_var!\n");
+					err = 1;
+					continue;
 				}
 			prim_var_copy_ifv2FV(&ifv, FV, k);
 
 			cons_qty_copy_ifv2cv(&ifv, cv, k);			
 		}
+	// the mass fractions of the species, row by row
+	for(int s = 0; FV->Y != NULL && s < (int)config[71]; s++)
+		{
+			double * Y = FV->Y + (size_t)s*FV->n_Y;
+			const double * U_Y = cv->U_Y + (size_t)s*FV->n_Y;
+#pragma omp parallel for simd
+			for(int k = 0; k < num_cell; ++k)
+				Y[k] = U_Y[k] / cv->U_rho[k];
+		}
 
-	return 1;
+	return !err;
 }
 
 
+ACC_ROUTINE_SEQ
 static int order2_i_f_var_init(const struct cell_var * cv, struct i_f_var * ifv, const int k)
 {
 	const double n_x = ifv->n_x, n_y = ifv->n_y;
@@ -52,7 +69,7 @@ static int order2_i_f_var_init(const struct cell_var * cv, struct i_f_var * ifv,
 
 	if (cons2prim(ifv) == 0)
 		{
-			fprintf(stderr, "Error happens on primitive variable!\n");
+			ERR_PRINTF("Error happens on primitive variable!\n");
 			return 0;
 		}
 
@@ -90,7 +107,7 @@ static int order2_i_f_var_init(const struct cell_var * cv, struct i_f_var * ifv,
 #endif
 			if(cons2prim(ifv) == 0)
 				{
-					fprintf(stderr, "Error happens on primitive variable!\n");
+					ERR_PRINTF("Error happens on primitive variable!\n");
 					return 0;
 				}
 		}
@@ -98,6 +115,7 @@ static int order2_i_f_var_init(const struct cell_var * cv, struct i_f_var * ifv,
 }
 
 
+ACC_ROUTINE_SEQ
 static int order2_i_f_var0(struct i_f_var * ifv)
 {		
 	ifv->d_rho = 0.0;
@@ -119,7 +137,7 @@ static int order2_i_f_var0(struct i_f_var * ifv)
 
 	if(cons2prim(ifv) == 0)
 		{
-			fprintf(stderr, "Error happens on primitive variable!\n");
+			ERR_PRINTF("Error happens on primitive variable!\n");
 			return 0;
 		}
 		
@@ -132,34 +150,38 @@ int interface_var_init(const struct cell_var * cv, const struct mesh_var * mv,
 					   const int k, const int j, const int i, const double gauss)
 {
 	const int order = (int)config[9];
-	int **cc = cv->cell_cell;
-	int **cp = mv->cell_pt;
+	const int f  = CSR_FACE(cv, k, j); // serial number in the flat interfacial arrays
+	const int cc = cv->cell_cell[0][f];
 
-	int p_p, p_n;
-	if(j == cp[k][0]-1) 
-		{
-			p_p=cp[k][1];
-			p_n=cp[k][j+1];
-		}				  
-	else
-		{
-			p_p=cp[k][j+2];
-			p_n=cp[k][j+1];
-		}
+	// The geometry of the interfaces at the midpoints is computed by face_geom_comp(),
+	// so that the grids are not read there (nor on the device).
+	const double * fg = (cv->face_geom != NULL && gauss == 0.0) ? cv->face_geom + FACE_GEOM * f : NULL;
+	const int p_p = fg ? 0 : CSR_PT_P(mv->cell_pt, k, j), p_n = fg ? 0 : CSR_PT_N(mv->cell_pt, k, j);
 
-	ifv->n_x = cv->n_x[k][j];
-	ifv->n_y = cv->n_y[k][j];
-	ifv->length = sqrt((mv->X[p_p] - mv->X[p_n])*(mv->X[p_p] - mv->X[p_n]) + (mv->Y[p_p] - mv->Y[p_n])*(mv->Y[p_p] - mv->Y[p_n]));
+	ifv->n_x = cv->n_x[0][f];
+	ifv->n_y = cv->n_y[0][f];
+	if (fg)
+		ifv->length = fg[0];
+	else
+		ifv->length = sqrt((mv->X[p_p] - mv->X[p_n])*(mv->X[p_p] - mv->X[p_n]) + (mv->Y[p_p] - mv->Y[p_n])*(mv->Y[p_p] - mv->Y[p_n]));
 
 	cons_qty_copy_cv2ifv(ifv, cv, k);
    
 	if (order == 2)
 		{
-			ifv->delta_x = 0.5*(mv->X[p_p]*(1.0+gauss) + mv->X[p_n]*(1.0-gauss)) - cv->X_c[k];
-			ifv->delta_y = 0.5*(mv->Y[p_p]*(1.0+gauss) + mv->Y[p_n]*(1.0-gauss)) - cv->Y_c[k];
+			if (fg)
+				{
+					ifv->delta_x = fg[1];
+					ifv->delta_y = fg[2];
+				}
+			else
+				{
+					ifv->delta_x = 0.5*(mv->X[p_p]*(1.0+gauss) + mv->X[p_n]*(1.0-gauss)) - cv->X_c[k];
+					ifv->delta_y = 0.5*(mv->Y[p_p]*(1.0+gauss) + mv->Y[p_n]*(1.0-gauss)) - cv->Y_c[k];
+				}
 			if(order2_i_f_var_init(cv, ifv, k) == 0)			
 				{
-					fprintf(stderr, "Error happens on primitive variable!\n");
+					ERR_PRINTF("Error happens on primitive variable!\n");
 					return 0;
 				}
 		}
@@ -169,23 +191,31 @@ int interface_var_init(const struct cell_var * cv, const struct mesh_var * mv,
 	ifv_R->length = ifv->length;
 	
 	int cR; //cell_right	
-	if (cc[k][j] >= 0)
+	if (cc >= 0)
 		{
-			cR = cc[k][j];
+			cR = cc;
 			cons_qty_copy_cv2ifv(ifv_R, cv, cR);			
 
 			if (order == 2)
 				{
-					ifv_R->delta_x = 0.5*(mv->X[p_p]*(1.0+gauss) + mv->X[p_n]*(1.0-gauss)) - cv->X_c[cR];
-					ifv_R->delta_y = 0.5*(mv->Y[p_p]*(1.0+gauss) + mv->Y[p_n]*(1.0-gauss)) - cv->Y_c[cR];
+					if (fg)
+						{
+							ifv_R->delta_x = fg[3];
+							ifv_R->delta_y = fg[4];
+						}
+					else
+						{
+							ifv_R->delta_x = 0.5*(mv->X[p_p]*(1.0+gauss) + mv->X[p_n]*(1.0-gauss)) - cv->X_c[cR];
+							ifv_R->delta_y = 0.5*(mv->Y[p_p]*(1.0+gauss) + mv->Y[p_n]*(1.0-gauss)) - cv->Y_c[cR];
+						}
 					if(order2_i_f_var_init(cv, ifv_R, cR) == 0)
 						{
-							fprintf(stderr, "Error happens on primitive variable!\n");
+							ERR_PRINTF("Error happens on primitive variable!\n");
 							return 0;
 						}
 				}
 		}
-	else if (cc[k][j] == -1)//initial boundary condition.
+	else if (cc == -1)//initial boundary condition.
 		{
 			if (i > 1)
 				return -1;
@@ -194,24 +224,24 @@ int interface_var_init(const struct cell_var * cv, const struct mesh_var * mv,
 			if (order == 2)
 				if(order2_i_f_var0(ifv_R) == 0)
 					{
-						fprintf(stderr, "Error happens on primitive variable!\n");
+						ERR_PRINTF("Error happens on primitive variable!\n");
 						return 0;
 					}
 		}
-	else if (cc[k][j] == -3)//prescribed boundary condition.
+	else if (cc == -3)//prescribed boundary condition.
 		{
 			cons_qty_copy_cv2ifv(ifv_R, cv, k);			
 
 			if (order == 2)
 				if(order2_i_f_var0(ifv_R) == 0)
 					{
-						fprintf(stderr, "Error happens on primitive variable!\n");
+						ERR_PRINTF("Error happens on primitive variable!\n");
 						return 0;
 					}
 		}		
-	else if (cc[k][j] != -2&&cc[k][j] != -4)
+	else if (cc != -2&&cc != -4)
 		{
-			printf("No suitable boundary!cc = %d!\n",cc[k][j]);
+			printf("No suitable boundary!cc = %d!\n",cc);
 			return 0;
 		}
 
@@ -219,19 +249,19 @@ int interface_var_init(const struct cell_var * cv, const struct mesh_var * mv,
 		{
 			if(cons2prim(ifv) == 0)
 				{
-					fprintf(stderr, "Error happens on primitive variable!\n");
+					ERR_PRINTF("Error happens on primitive variable!\n");
 					return 0;
 				}
-			if (cc[k][j] != -2&&cc[k][j] != -4)
+			if (cc != -2&&cc != -4)
 				if(cons2prim(ifv_R) == 0)
 					{
-						fprintf(stderr, "Error happens on primitive variable!\n");
+						ERR_PRINTF("Error happens on primitive variable!\n");
 						return 0;
 					}
 		}
 
 	double u_R, v_R;
-	if (cc[k][j] == -2)//reflecting boundary condition.
+	if (cc == -2)//reflecting boundary condition.
 		{
 			*ifv_R = *ifv;
 			u_R =  ifv_R->U*ifv_R->n_x + ifv_R->V*ifv_R->n_y;
@@ -240,7 +270,7 @@ int interface_var_init(const struct cell_var * cv, const struct mesh_var * mv,
 			ifv_R->U = u_R*ifv_R->n_x - v_R*ifv_R->n_y;
 			ifv_R->V = u_R*ifv_R->n_y + v_R*ifv_R->n_x;
 		}
-	else if (cc[k][j] == -4)//symmetry boundary condition.
+	else if (cc == -4)//symmetry boundary condition.
 		*ifv_R = *ifv;
 
 	return 1;
@@ -253,27 +283,36 @@ double tau_calc(const struct cell_var * cv, const struct mesh_var * mv)
 	if (CFL < 0.0)
 		return -CFL;
 	const int num_cell = (int)config[3];
-	int ** cp = mv->cell_pt;
 	
 	double tau = config[1];
 	struct i_f_var ifv, ifv_R;
-	double cum, lambda_max;
-	int ivi;
+	double cum, lambda_max, tau_k;
+	int ivi, err = 0;
 	
 	double qn, qn_R;
 	double c, c_R;	
 	
+	// The grids 'mv' are not read by interface_var_init() on the device, see device_data_enter_unstruct().
+#ifdef _OPENACC
+#pragma acc parallel loop private(ifv, ifv_R, cum, lambda_max, tau_k, ivi, qn, qn_R, c, c_R) reduction(min:tau) reduction(|:err) \
+	present(cv[0:1]) default(present)
+#else
+#pragma omp parallel for private(ifv, ifv_R, cum, lambda_max, tau_k, ivi, qn, qn_R, c, c_R) reduction(min:tau) reduction(|:err)
+#endif
 	for(int k = 0; k < num_cell; ++k)
 		{
 			cum = 0.0;
 			
-			for(int j = 0; j < cp[k][0]; ++j)
+			for(int j = 0; j < CSR_NUM(cv, k); ++j)
 				{
 					ivi = interface_var_init(cv, mv, &ifv, &ifv_R, k, j, 0, 0.0);
 					if (ivi < 0)
 						;
 					else if(ivi == 0)
-						return -1.0;
+						{
+							err = 1;
+							break;
+						}
 					else
 						{
 							qn = ifv.U*ifv.n_x + ifv.V*ifv.n_y; 
@@ -284,7 +323,10 @@ double tau_calc(const struct cell_var * cv, const struct mesh_var * mv)
 							cum += 0.5*lambda_max * ifv.length;
 						}
 				}
-			tau = fmin(tau, cv->vol[k]/cum * CFL);
+			tau_k = cv->vol[k]/cum * CFL;
+			if (cv->tau_loc) // the local time steps of the steady-state mode
+				cv->tau_loc[k] = tau_k;
+			tau = fmin(tau, tau_k);
 		} //To decide tau.
-	return tau;
+	return err ? -1.0 : tau;
 }
@@ -7,6 +7,8 @@
 #include "../include/var_struc.h"
 #include "../include/tools.h"
 #include "../include/inter_process_unstruct.h"
+#include "../include_cii/mem.h"
+#include "../include_cii/arena.h"
 
 
 #define FV_RESET_MEM(v, n)						\
@@ -23,75 +25,55 @@
     } while (0)								\
 		
 
-#define CV_INIT_MEM(v, n)						\
+#define CV_INIT_MEM(v, n, tag)						\
     do {								\
+	const long nbytes = (long)((n) > 0 ? (n) : 1) * (long)sizeof(double); \
 	if(i_or_f)							\
-	    {								\
-		cv->v = (double *)calloc(n, sizeof(double));		\
-		if(cv->v == NULL)					\
-		    {							\
-			fprintf(stderr, "Not enough memory in DOUBLE cell center variable initialize!\n"); \
-			exit(5);					\
-		    }							\
-	    }								\
+		cv->v = (double *)ARENA_CALLOC(ws, (n) > 0 ? (n) : 1, sizeof(double)); \
 	else								\
-	    {								\
-		free(cv->v);						\
 		cv->v = NULL;						\
-	    }								\
+	mem_account((tag), #v, i_or_f ? nbytes : -nbytes);		\
     } while (0)								\
 	
-#define CP_INIT_MEM(v, n)						\
+#define CP_INIT_MEM(v, n, tag)						\
     do {								\
+	const long nbytes = (long)((n) > 0 ? (n) : 1) * (long)sizeof(double *) + \
+		(long)(cv->face_off[n] > 0 ? cv->face_off[n] : 1) * (long)sizeof(double); \
 	if(i_or_f)							\
 	    {								\
-		cv->v = (double **)malloc((n) * sizeof(double *));	\
-		if(cv->v == NULL)					\
-		    {							\
-			fprintf(stderr, "Not enough memory in DOUBLE cell point variable initialize!\n"); \
-			exit(5);					\
-		    }							\
-		init_mem(cv->v, n, mv->cell_pt);			\
+		cv->v = (double **)ARENA_ALLOC(ws, ((n) > 0 ? (n) : 1) * sizeof(double *)); \
+		double * block = (double *)ARENA_CALLOC(ws, cv->face_off[n] > 0 ? cv->face_off[n] : 1, sizeof(double)); \
+		for(int k = 0; k < (n); ++k)				\
+			cv->v[k] = block + cv->face_off[k];		\
 	    }								\
 	else								\
-	    {								\
-		for(int j = 0; j < (n); j++)				\
-		    {							\
-			free(cv->v[j]);					\
-			cv->v[j] = NULL;				\
-		    }							\
-		free(cv->v);						\
 		cv->v = NULL;						\
-	    }								\
+	mem_account((tag), #v, i_or_f ? nbytes : -nbytes);		\
     } while (0)								\
 
-#define CP_INIT_MEM_INT(v, n)						\
+#define CP_INIT_MEM_INT(v, n, tag)					\
     do {								\
+	const long nbytes = (long)((n) > 0 ? (n) : 1) * (long)sizeof(int *) + \
+		(long)(cv->face_off[n] > 0 ? cv->face_off[n] : 1) * (long)sizeof(int); \
 	if(i_or_f)							\
 	    {								\
-		cv->v = (int **)malloc((n) * sizeof(int *));		\
-		if(cv->v == NULL)					\
-		    {							\
-			fprintf(stderr, "Not enough memory in INT cell point variable initialize!\n"); \
-			exit(5);					\
-		    }							\
-		init_mem_int(cv->v, n, mv->cell_pt);			\
+		cv->v = (int **)ARENA_ALLOC(ws, ((n) > 0 ? (n) : 1) * sizeof(int *)); \
+		int * block = (int *)ARENA_ALLOC(ws, (cv->face_off[n] > 0 ? cv->face_off[n] : 1) * sizeof(int)); \
+		for(int k = 0; k < (n); ++k)				\
+			cv->v[k] = block + cv->face_off[k];		\
 	    }								\
  	else								\
-	    {								\
-		for(int j = 0; j < (n); j++)				\
-		    {							\
-			free(cv->v[j]);					\
-			cv->v[j] = NULL;				\
-		    }							\
-		free(cv->v);						\
 		cv->v = NULL;						\
-	    }								\
+	mem_account((tag), #v, i_or_f ? nbytes : -nbytes);		\
     } while (0)								\
 
 
 /**
  * @brief Initialize or free memory for pointers in struct 'cv'. While initialize, reset memory for pointers in struct 'FV'.
+ * @details Each interfacial variable is one block in the CSR offsets 'cv->face_off' of the interfaces of the cells.
+ *          The variables are carved from the workspace of the thread, reserved from the numbers of the cells and
+ *          the interfaces, and they are released together by resetting the workspace.
+ *          The bytes of each variable are accounted to its subsystem (mem_account()).
  * @param[in] cv:     Structure of grid variable data in computational grid cells.
  * @param[in] mv:     Structure of meshing variable data.
  * @param[in] FV:     Structure of initial fluid variable data array pointer.
@@ -105,201 +87,442 @@ void cell_mem_init_free(struct cell_var * cv, const struct mesh_var * mv, struct
 	const int order = (int)config[9];
 	const int num_cell_ghost = mv->num_ghost + (int)config[3];
 	const int num_cell = (int)config[3];
+	const int K = FV->Y != NULL ? (int)config[71] : 0; // the species
+	Arena_T ws = Arena_workspace();
 
-	CP_INIT_MEM_INT(cell_cell, num_cell_ghost);
-	CP_INIT_MEM(n_x, num_cell_ghost);
-	CP_INIT_MEM(n_y, num_cell_ghost);
-	CV_INIT_MEM(X_c, num_cell_ghost);
-	CV_INIT_MEM(Y_c, num_cell_ghost);
-	CV_INIT_MEM(vol, num_cell_ghost);
-
-	CP_INIT_MEM(F_u,   num_cell);
-	CP_INIT_MEM(F_v,   num_cell);
-	CP_INIT_MEM(F_rho, num_cell);
-	CP_INIT_MEM(F_e,   num_cell);
-	CV_INIT_MEM(U_u,   num_cell_ghost);
-	CV_INIT_MEM(U_v,   num_cell_ghost);
-	CV_INIT_MEM(U_rho, num_cell_ghost);
-	CV_INIT_MEM(U_e,   num_cell_ghost);
+	if(i_or_f)
+	    {
+		cv->face_off = (int *)malloc((num_cell_ghost + 1) * sizeof(int));
+		if(cv->face_off == NULL)
+		    {
+			fprintf(stderr, "Not enough memory in CSR offsets of cell interfaces initialize!\n");
+			exit(5);
+		    }
+		cv->face_off[0] = 0;
+		for(int k = 0; k < num_cell_ghost; k++)
+			cv->face_off[k+1] = cv->face_off[k] + mv->cell_pt[k][0];
+		// about 40 cell and 40 interfacial variables with the aligned padding
+		const long n_face = cv->face_off[num_cell_ghost];
+		ARENA_RESERVE(ws, (40L*num_cell_ghost + (40L+FACE_GEOM)*n_face + (NUM_CONS_RK+1)*num_cell + 4L*K*num_cell_ghost)
+			      * (long)sizeof(double) + 128L*ARENA_ALIGN);
+	    }
+
+	CP_INIT_MEM_INT(cell_cell, num_cell_ghost, MA_MESH);
+	CP_INIT_MEM(n_x, num_cell_ghost, MA_MESH);
+	CP_INIT_MEM(n_y, num_cell_ghost, MA_MESH);
+	CV_INIT_MEM(X_c, num_cell_ghost, MA_MESH);
+	CV_INIT_MEM(Y_c, num_cell_ghost, MA_MESH);
+	CV_INIT_MEM(vol, num_cell_ghost, MA_MESH);
+	CV_INIT_MEM(face_geom, FACE_GEOM * cv->face_off[num_cell_ghost], MA_MESH);
+
+	CP_INIT_MEM(F_u,   num_cell, MA_FLUX);
+	CP_INIT_MEM(F_v,   num_cell, MA_FLUX);
+	CP_INIT_MEM(F_rho, num_cell, MA_FLUX);
+	CP_INIT_MEM(F_e,   num_cell, MA_FLUX);
+	CV_INIT_MEM(U_u,   num_cell_ghost, MA_SNAPSHOT);
+	CV_INIT_MEM(U_v,   num_cell_ghost, MA_SNAPSHOT);
+	CV_INIT_MEM(U_rho, num_cell_ghost, MA_SNAPSHOT);
+	CV_INIT_MEM(U_e,   num_cell_ghost, MA_SNAPSHOT);
+	if ((int)config[53] > 0)
+		CV_INIT_MEM(U_RK, NUM_CONS_RK * num_cell, MA_SNAPSHOT);
+	if (config[73] > 0.0 && (_Bool)config[74] && config[7] > 0.0) // local time stepping of the steady-state mode
+		CV_INIT_MEM(tau_loc, num_cell, MA_OTHER);
 	FV_RESET_MEM(U,    num_cell_ghost);
 	FV_RESET_MEM(V,    num_cell_ghost);
 	FV_RESET_MEM(RHO,  num_cell_ghost);
 	FV_RESET_MEM(P,    num_cell_ghost);
 
-	CP_INIT_MEM(U_p,   num_cell_ghost);
-	CP_INIT_MEM(V_p,   num_cell_ghost);
-	CP_INIT_MEM(RHO_p, num_cell);
-	CP_INIT_MEM(P_p,   num_cell);
+	CP_INIT_MEM(U_p,   num_cell_ghost, MA_INTERFACE);
+	CP_INIT_MEM(V_p,   num_cell_ghost, MA_INTERFACE);
+	CP_INIT_MEM(RHO_p, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(P_p,   num_cell, MA_INTERFACE);
 
 	if (order > 1)
 		{
-			CV_INIT_MEM(gradx_rho, num_cell_ghost);
-			CV_INIT_MEM(grady_rho, num_cell_ghost);
-			CV_INIT_MEM(gradx_e,   num_cell_ghost);
-			CV_INIT_MEM(grady_e,   num_cell_ghost);
-			CV_INIT_MEM(gradx_u,   num_cell_ghost);			
-			CV_INIT_MEM(grady_u,   num_cell_ghost);
-			CV_INIT_MEM(gradx_v,   num_cell_ghost);
-			CV_INIT_MEM(grady_v,   num_cell_ghost);
+			CV_INIT_MEM(gradx_rho, num_cell_ghost, MA_SLOPE);
+			CV_INIT_MEM(grady_rho, num_cell_ghost, MA_SLOPE);
+			CV_INIT_MEM(gradx_e,   num_cell_ghost, MA_SLOPE);
+			CV_INIT_MEM(grady_e,   num_cell_ghost, MA_SLOPE);
+			CV_INIT_MEM(gradx_u,   num_cell_ghost, MA_SLOPE);			
+			CV_INIT_MEM(grady_u,   num_cell_ghost, MA_SLOPE);
+			CV_INIT_MEM(gradx_v,   num_cell_ghost, MA_SLOPE);
+			CV_INIT_MEM(grady_v,   num_cell_ghost, MA_SLOPE);
+			if ((int)config[30] == 1)
+				{
+					CV_INIT_MEM(lsq_inv, 4 * num_cell, MA_MESH);
+					CV_INIT_MEM(lsq_d,   2 * cv->face_off[num_cell], MA_MESH);
+				}
 		}
 
-#ifdef MULTIPHASE_BASICS
-	CP_INIT_MEM(F_phi, num_cell);
-	CV_INIT_MEM(U_phi, num_cell_ghost);
+	if (K > 0)
+	    {
+		CV_INIT_MEM(U_Y, K * num_cell_ghost, MA_SNAPSHOT);
+		if ((int)config[53] > 0)
+			CV_INIT_MEM(U_Y_RK, K * num_cell_ghost, MA_SNAPSHOT);
+		if (order > 1)
+		    {
+			CV_INIT_MEM(gradx_Y, K * num_cell_ghost, MA_SLOPE);
+			CV_INIT_MEM(grady_Y, K * num_cell_ghost, MA_SLOPE);
+		    }
+		if (i_or_f && FV->n_Y != num_cell_ghost) // The rows are moved to the stride of the cells with the ghost cells.
+		    {
+			FV->Y = (double *)realloc(FV->Y, (size_t)K * num_cell_ghost * sizeof(double));
+			if(FV->Y == NULL)
+			    {
+				fprintf(stderr, "Not enough memory in fluid variable reset!\n");
+				exit(5);
+			    }
+			for(int s = K-1; s > 0; s--)
+				memmove(FV->Y + (size_t)s*num_cell_ghost, FV->Y + (size_t)s*FV->n_Y, num_cell * sizeof(double));
+			FV->n_Y = num_cell_ghost;
+		    }
+	    }
+
+#ifdef MULTIFLUID_BASICS
+	CP_INIT_MEM(F_phi, num_cell, MA_FLUX);
+	CV_INIT_MEM(U_phi, num_cell_ghost, MA_SNAPSHOT);
 	FV_RESET_MEM(PHI, num_cell_ghost);
-	CP_INIT_MEM(F_e_a, num_cell);
-	CV_INIT_MEM(U_e_a, num_cell_ghost);
+	CP_INIT_MEM(F_e_a, num_cell, MA_FLUX);
+	CV_INIT_MEM(U_e_a, num_cell_ghost, MA_SNAPSHOT);
 	FV_RESET_MEM(Z_a, num_cell_ghost);
-	CP_INIT_MEM(F_gamma, num_cell);
-	CV_INIT_MEM(U_gamma, num_cell_ghost);
+	CP_INIT_MEM(F_gamma, num_cell, MA_FLUX);
+	CV_INIT_MEM(U_gamma, num_cell_ghost, MA_SNAPSHOT);
 	FV_RESET_MEM(gamma, num_cell_ghost);
-	CP_INIT_MEM(PHI_p, num_cell);
-	CP_INIT_MEM(Z_a_p, num_cell);
-	CP_INIT_MEM(gamma_p, num_cell);
+	CP_INIT_MEM(PHI_p, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(Z_a_p, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(gamma_p, num_cell, MA_INTERFACE);
 	if (order > 1)
 	    {
-		CV_INIT_MEM(gradx_z_a, num_cell_ghost);
-		CV_INIT_MEM(grady_z_a, num_cell_ghost);
-		CV_INIT_MEM(gradx_phi, num_cell_ghost);
-		CV_INIT_MEM(grady_phi, num_cell_ghost);
+		CV_INIT_MEM(gradx_z_a, num_cell_ghost, MA_SLOPE);
+		CV_INIT_MEM(grady_z_a, num_cell_ghost, MA_SLOPE);
+		CV_INIT_MEM(gradx_phi, num_cell_ghost, MA_SLOPE);
+		CV_INIT_MEM(grady_phi, num_cell_ghost, MA_SLOPE);
 		if ((_Bool)config[60])
 		    {
-			CV_INIT_MEM(gradx_gamma, num_cell_ghost);
-			CV_INIT_MEM(grady_gamma, num_cell_ghost);
+			CV_INIT_MEM(gradx_gamma, num_cell_ghost, MA_SLOPE);
+			CV_INIT_MEM(grady_gamma, num_cell_ghost, MA_SLOPE);
 		    }
 	    }
 #endif
 
-#ifdef MULTIPHASE_BASICS
-	CP_INIT_MEM(P_star, num_cell);
-	CP_INIT_MEM(U_qt_star, num_cell);
-	CP_INIT_MEM(V_qt_star, num_cell);
-	CP_INIT_MEM(U_qt_add_c, num_cell);
-	CP_INIT_MEM(V_qt_add_c, num_cell);
+#ifdef MULTIFLUID_BASICS
+	CP_INIT_MEM(P_star, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(U_qt_star, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(V_qt_star, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(U_qt_add_c, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(V_qt_add_c, num_cell, MA_INTERFACE);
 #endif
 #ifdef MULTIPHASE_BASICS_abandoned
-	CP_INIT_MEM(RHO_star, num_cell);
-	CP_INIT_MEM(gamma_star, num_cell);
-
-	CP_INIT_MEM(RHO_minus_c, num_cell);
-	CP_INIT_MEM(P_minus_c, num_cell);
-	CP_INIT_MEM(U_qt_minus_c, num_cell);
-	CP_INIT_MEM(V_qt_minus_c, num_cell);
-	CP_INIT_MEM(gamma_minus_c, num_cell);
-
-	CP_INIT_MEM(RHO_add_c, num_cell);
-	CP_INIT_MEM(P_add_c, num_cell);
-	CP_INIT_MEM(gamma_add_c, num_cell);
-
-	CP_INIT_MEM(u_star, num_cell);
-	CP_INIT_MEM(u_minus_c, num_cell);
-	CP_INIT_MEM(u_add_c, num_cell);
+	CP_INIT_MEM(RHO_star, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(gamma_star, num_cell, MA_INTERFACE);
+
+	CP_INIT_MEM(RHO_minus_c, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(P_minus_c, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(U_qt_minus_c, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(V_qt_minus_c, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(gamma_minus_c, num_cell, MA_INTERFACE);
+
+	CP_INIT_MEM(RHO_add_c, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(P_add_c, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(gamma_add_c, num_cell, MA_INTERFACE);
+
+	CP_INIT_MEM(u_star, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(u_minus_c, num_cell, MA_INTERFACE);
+	CP_INIT_MEM(u_add_c, num_cell, MA_INTERFACE);
 #endif
 
 #ifdef LAGRANGIAN_MAIRE
-	CP_INIT_MEM(F_p_x, num_cell);
-	CP_INIT_MEM(F_p_y, num_cell);
-	CP_INIT_MEM(dt_U_p,    num_cell_ghost);
-	CP_INIT_MEM(dt_V_p,    num_cell_ghost);
-	CP_INIT_MEM(dt_F_p_x,  num_cell);
-	CP_INIT_MEM(dt_F_p_y,  num_cell);
+	CP_INIT_MEM(F_p_x, num_cell, MA_FLUX);
+	CP_INIT_MEM(F_p_y, num_cell, MA_FLUX);
+	CP_INIT_MEM(dt_U_p,    num_cell_ghost, MA_INTERFACE);
+	CP_INIT_MEM(dt_V_p,    num_cell_ghost, MA_INTERFACE);
+	CP_INIT_MEM(dt_F_p_x,  num_cell, MA_FLUX);
+	CP_INIT_MEM(dt_F_p_y,  num_cell, MA_FLUX);
 #endif
+
+	if(!i_or_f)
+	    {
+		Arena_free(ws);
+		free(cv->face_off);
+		cv->face_off = NULL;
+	    }
+}
+
+
+//! Area(volume) of the k-th grid cell.
+static inline void vol_cell(const struct cell_var * cv, const struct mesh_var * mv, const int k)
+{
+	int **cp = mv->cell_pt;
+	int p_p, p_n;
+
+	cv->vol[k] = 0.0;
+	for(int j = 0; j < cp[k][0]; j++)
+	    {
+		if(j == cp[k][0]-1) 
+		    {
+			p_p = cp[k][1];
+			p_n = cp[k][j+1];
+		    }				  
+		else
+		    {
+			p_p = cp[k][j+2];
+			p_n = cp[k][j+1];
+		    } 
+		cv->vol[k] = cv->vol[k] + 0.5 * (mv->X[p_n]*mv->Y[p_p] - mv->Y[p_n]*mv->X[p_p]);
+	    }
+}
+
+//! Interfacial unit normal vectors of the k-th grid cell.
+static inline void normal_cell(const struct cell_var * cv, const struct mesh_var * mv, const int k)
+{
+	int **cp = mv->cell_pt;
+	int p_p, p_n;
+	double length;
+
+	for(int j = 0; j < cp[k][0]; j++)
+	    {
+		p_p = CSR_PT_P(cp, k, j);
+		p_n = CSR_PT_N(cp, k, j);
+		length = sqrt((mv->Y[p_p] - mv->Y[p_n])*(mv->Y[p_p] - mv->Y[p_n])+(mv->X[p_n] - mv->X[p_p])*(mv->X[p_n] - mv->X[p_p]));
+		cv->n_x[k][j] = (mv->Y[p_p] - mv->Y[p_n]) / length;
+		cv->n_y[k][j] = (mv->X[p_n] - mv->X[p_p]) / length;
+		//Inner normal 
+	    }
+}
+
+//! Centroid of the k-th grid cell.
+static inline void centroid_cell(const struct cell_var * cv, const struct mesh_var * mv, const int k)
+{
+	const double *X = mv->X, *Y = mv->Y;
+	int **cp = mv->cell_pt;
+
+	double S = 0.0, S_tri;
+
+	cv->X_c[k] = 0.0;
+	cv->Y_c[k] = 0.0;
+	for(int j = 2; j < cp[k][0]; j++)
+	    {
+		S_tri = X[cp[k][1]]*Y[cp[k][j]] + X[cp[k][j+1]]*Y[cp[k][1]] + X[cp[k][j]]*Y[cp[k][j+1]] - X[cp[k][j+1]]*Y[cp[k][j]] - X[cp[k][1]]*Y[cp[k][j+1]] - X[cp[k][j]]*Y[cp[k][1]];
+		cv->X_c[k] += (X[cp[k][1]] + X[cp[k][j]] + X[cp[k][j+1]]) * S_tri;
+		cv->Y_c[k] += (Y[cp[k][1]] + Y[cp[k][j]] + Y[cp[k][j+1]]) * S_tri;
+		S += S_tri;
+	    }
+	cv->X_c[k] /= S*3.0;
+	cv->Y_c[k] /= S*3.0;
+}
+
+//! Geometry of the interfaces of the k-th grid cell, see face_geom_comp().
+static inline void face_geom_cell(const struct cell_var * cv, const struct mesh_var * mv, const int k, const int order)
+{
+	const double *X = mv->X, *Y = mv->Y;
+	int **cp = mv->cell_pt;
+
+	for(int j = 0; j < cp[k][0]; j++)
+	    {
+		const int f = CSR_FACE(cv, k, j), cR = cv->cell_cell[0][f];
+		const int p_p = CSR_PT_P(cp, k, j), p_n = CSR_PT_N(cp, k, j);
+		double * fg = cv->face_geom + FACE_GEOM * f;
+		fg[0] = sqrt((X[p_p] - X[p_n])*(X[p_p] - X[p_n]) + (Y[p_p] - Y[p_n])*(Y[p_p] - Y[p_n]));
+		if (order < 2)
+			continue;
+		fg[1] = 0.5*(X[p_p] + X[p_n]) - cv->X_c[k];
+		fg[2] = 0.5*(Y[p_p] + Y[p_n]) - cv->Y_c[k];
+		fg[3] = cR >= 0 ? 0.5*(X[p_p] + X[p_n]) - cv->X_c[cR] : 0.0;
+		fg[4] = cR >= 0 ? 0.5*(Y[p_p] + Y[p_n]) - cv->Y_c[cR] : 0.0;
+	    }
 }
 
 
 /**
  * @brief Compute the area(volume) of each grid cell and store it in array 'cv->vol[]'.
+ * @details The areas of the preprocessed mesh file 'mv->geom' are copied if they are loaded.
  * @param[in,out] cv: Structure of grid variable data in computational grid cells.
  * @param[in]     mv: Structure of meshing variable data.
  */
 void vol_comp(const struct cell_var * cv, const struct mesh_var * mv)
 {
 	const int num_cell = mv->num_ghost + (int)config[3];
+
+	if (mv->geom != NULL)
+	    {
+		memcpy(cv->vol, mv->geom, num_cell * sizeof(double));
+		return;
+	    }
+#pragma omp parallel for
+	for(int k = 0; k < num_cell; k++)
+		vol_cell(cv, mv, k);
+}
+
+
+/**
+ * @brief Relationships of the k-th cell of the logically rectangular grids of quad_mesh() by its indices (i, j).
+ * @details The interfaces 0-3 are the lower, right, upper and left ones. At the boundary, the connected boundary
+ *          runs counterclockwise from the lower left node, so that the serial number of the interface is also implicit.
+ * @param[in,out] cv: Structure of grid variable data in computational grid cells.
+ * @param[in]     mv: Structure of meshing variable data, with mv->quad_nx/ny > 0.
+ * @param[in]     k:  Serial number of the grid cell.
+ */
+static void cell_rel_quad(const struct cell_var * cv, const struct mesh_var * mv, const int k)
+{
+	const int n_x = mv->quad_nx, n_y = mv->quad_ny;
+	const int i = k % n_x, j = k / n_x;
+	const int *bc = mv->border_cond;
+	int *cc = cv->cell_cell[k];
+
+	cc[0] = j > 0     ? k - n_x : bc[i];
+	cc[1] = i < n_x-1 ? k + 1   : bc[n_x + j];
+	cc[2] = j < n_y-1 ? k + n_x : bc[2*n_x + n_y - 1 - i];
+	cc[3] = i > 0     ? k - 1   : bc[2*n_x + 2*n_y - 1 - j];
+}
+
+/**
+ * @brief Build the list of the grid cells around each grid node in compressed sparse row (CSR) layout.
+ * @details The cells around the node p are cell[off[p]], …, cell[off[p+1]-1], in the ascending order.
+ * @param[in]  mv:       Structure of meshing variable data.
+ * @param[in]  num_cell: Number of the grid cells listed.
+ * @param[out] off:      The offsets of the nodes, allocated in this function.
+ * @param[out] cell:     The cells around the nodes, allocated in this function.
+ */
+static void node_cell_list(const struct mesh_var * mv, const int num_cell, int ** off, int ** cell)
+{
+	const int num_pt = mv->num_pt;
 	int **cp = mv->cell_pt;
+	int k, j, p;
 
-	int p_p, p_n;
+	*off = (int *)calloc(num_pt + 1, sizeof(int));
+	if(*off == NULL)
+	    {
+		fprintf(stderr, "Not enough memory in the list around grid nodes initialize!\n");
+		exit(5);
+	    }
+	for(k = 0; k < num_cell; k++)
+		for(j = 1; j <= cp[k][0]; j++)
+			(*off)[cp[k][j]+1]++;
+	for(p = 0; p < num_pt; p++)
+		(*off)[p+1] += (*off)[p];
+	*cell = (int *)malloc(((*off)[num_pt] + 1) * sizeof(int));
+	if(*cell == NULL)
+	    {
+		fprintf(stderr, "Not enough memory in the list around grid nodes initialize!\n");
+		exit(5);
+	    }
+	for(k = 0; k < num_cell; k++) // the offsets are moved back while the cells are filled in
+		for(j = 1; j <= cp[k][0]; j++)
+			(*cell)[(*off)[cp[k][j]]++] = k;
+	for(p = num_pt; p > 0; p--)
+		(*off)[p] = (*off)[p-1];
+	(*off)[0] = 0;
+}
 
-	for(int k = 0; k < num_cell; k++)
-	    {			
-		cv->vol[k] = 0.0;
-		for(int j = 0; j < cp[k][0]; j++)
+/**
+ * @brief Build the list of the interfaces of the connected boundaries around each grid node in CSR layout.
+ * @details The interface i of the boundaries lies between the nodes 'mv->border_pt[i]' and 'mv->border_pt[i+1]',
+ *          and the interfaces around the node p are seg[off[p]], …, seg[off[p+1]-1], in the order of the boundaries.
+ * @param[in]  mv:  Structure of meshing variable data.
+ * @param[out] off: The offsets of the nodes, allocated in this function.
+ * @param[out] seg: The interfaces of the boundaries around the nodes, allocated in this function.
+ */
+static void node_border_list(const struct mesh_var * mv, int ** off, int ** seg)
+{
+	const int num_pt = mv->num_pt;
+	const int *bp = mv->border_pt;
+	int i, l, p, n_border, pass;
+
+	*off = (int *)calloc(num_pt + 1, sizeof(int));
+	*seg = NULL;
+	if(*off == NULL)
+	    {
+		fprintf(stderr, "Not enough memory in the list around grid nodes initialize!\n");
+		exit(5);
+	    }
+	for(pass = 0; pass < 2; pass++) // count, and then fill in
+	    {
+		for(l = 1, n_border = -1; l <= mv->num_border[0]; l++)
 		    {
-			if(j == cp[k][0]-1) 
+			n_border += mv->num_border[l] + 1;
+			for(i = n_border-mv->num_border[l]; i < n_border; i++)
 			    {
-				p_p = cp[k][1];
-				p_n = cp[k][j+1];
-			    }				  
-			else
-			    {
-				p_p = cp[k][j+2];
-				p_n = cp[k][j+1];
-			    } 
-			cv->vol[k] = cv->vol[k] + 0.5 * (mv->X[p_n]*mv->Y[p_p] - mv->Y[p_n]*mv->X[p_p]);
+				if(pass)
+				    {
+					(*seg)[(*off)[bp[i]]++]   = i;
+					(*seg)[(*off)[bp[i+1]]++] = i;
+				    }
+				else
+				    {
+					(*off)[bp[i]+1]++;
+					(*off)[bp[i+1]+1]++;
+				    }
+			    }
+		    }
+		if(pass)
+		    break;
+		for(p = 0; p < num_pt; p++)
+			(*off)[p+1] += (*off)[p];
+		*seg = (int *)malloc(((*off)[num_pt] + 1) * sizeof(int));
+		if(*seg == NULL)
+		    {
+			fprintf(stderr, "Not enough memory in the list around grid nodes initialize!\n");
+			exit(5);
 		    }
 	    }
+	for(p = num_pt; p > 0; p--)
+		(*off)[p] = (*off)[p-1];
+	(*off)[0] = 0;
 }
 
-
 /**
  * @brief Determine interfacial normal directions ('cv->n_x/n_y[][]') and relationship between cells ('cv->cell_cell[][]').
+ * @details The relationships of the preprocessed mesh file 'mv->cell_cell_csr' are copied if they are loaded,
+ *          and those of the logically rectangular grids (mv->quad_nx > 0) are given by cell_rel_quad() without any search.
+ *          Otherwise the cell adjacent through an interface is sought among the cells around its starting node,
+ *          and the interface of the boundaries among those around the node, by node_cell_list() and node_border_list(),
+ *          so that the relationships are found in linear time and the cells are processed in parallel.
  * @param[in,out] cv: Structure of grid variable data in computational grid cells.
  * @param[in]     mv: Structure of meshing variable data.
  */
 void cell_rel(const struct cell_var * cv, const struct mesh_var * mv)
 {
 	const int num_cell = mv->num_ghost + (int)config[3];
-
+	const int *bp = mv->border_pt;
 	int **cp = mv->cell_pt;
-	int p_p, p_n, p2_p, p2_n;
+	int *c_off = NULL, *c_node = NULL, *b_off = NULL, *b_seg = NULL;
 
-	int cell_rec, n_border;
-	int i, l, ts;
-	double length;
+	if (mv->quad_nx <= 0 && mv->cell_cell_csr == NULL)
+	    {
+		node_cell_list(mv, num_cell, &c_off, &c_node);
+		node_border_list(mv, &b_off, &b_seg);
+	    }
 
+#pragma omp parallel for schedule(dynamic, 256)
 	for(int k = 0; k < num_cell; k++)
-	    { 						
+	    {
+		int p_p, p_n, p2_p, p2_n, i, l, c, cell_rec;
+		normal_cell(cv, mv, k);
+		if (mv->quad_nx > 0) // logically rectangular grids
+		    {
+			cell_rel_quad(cv, mv, k);
+			continue;
+		    }
 		for(int j = 0; j < cp[k][0]; j++)
 		    {
-			if(j == cp[k][0]-1) 
-			    {
-				p_p = cp[k][1];
-				p_n = cp[k][j+1];
-			    }				  
-			else
+			if (mv->cell_cell_csr != NULL)
 			    {
-				p_p = cp[k][j+2];
-				p_n = cp[k][j+1];
+				cv->cell_cell[k][j] = mv->cell_cell_csr[(cp[k] - mv->cell_pt_csr) + 1 + j];
+				continue;
 			    }
-			length = sqrt((mv->Y[p_p] - mv->Y[p_n])*(mv->Y[p_p] - mv->Y[p_n])+(mv->X[p_n] - mv->X[p_p])*(mv->X[p_n] - mv->X[p_p]));
-			cv->n_x[k][j] = (mv->Y[p_p] - mv->Y[p_n]) / length;
-			cv->n_y[k][j] = (mv->X[p_n] - mv->X[p_p]) / length;
-			//Inner normal 
+			p_p = CSR_PT_P(cp, k, j);
+			p_n = CSR_PT_N(cp, k, j);
 
 			cell_rec = 0;
-			ts = 1;
-			while (ts <= MAX(num_cell-k-1, k))
+			for(c = c_off[p_n]; c < c_off[p_n+1] && !cell_rec; c++)
 			    {
-				// seek in two side
-				i = k + ts;
-				if (ts > 0)
-				    ts = -ts;
-				else
-				    ts = -ts + 1;
-				if (i < 0 || i >= num_cell)
+				i = c_node[c];
+				if (i == k)
 				    continue;
-
 				for(l = 0; l < cp[i][0]; l++)
 				    {
-					if(l == cp[i][0]-1) 
-					    {
-						p2_p = cp[i][1];
-						p2_n = cp[i][l+1];
-					    }				  
-					else
-					    {
-						p2_p = cp[i][l+2];
-						p2_n = cp[i][l+1];
-					    }
+					p2_p = CSR_PT_P(cp, i, l);
+					p2_n = CSR_PT_N(cp, i, l);
 					if((p_p == p2_n) && (p2_p == p_n))
 					    {
 						cv->cell_cell[k][j] = i;
@@ -307,29 +530,21 @@ void cell_rel(const struct cell_var * cv, const struct mesh_var * mv)
 						break;
 					    }
 				    }
-				if (cell_rec)
-				    break;
 			    }
-
 			if (cell_rec)
 			    continue;
 
-			for(l = 1, n_border = -1; l <= mv->num_border[0]; l++)
+			for(c = b_off[p_n]; c < b_off[p_n+1]; c++)
 			    {
-				n_border += mv->num_border[l] + 1; 
-				for(i = n_border-mv->num_border[l]; i < n_border; i++)
-				    {				
-					p2_p = mv->border_pt[i+1];
-					p2_n = mv->border_pt[i];
-					if((p_p == p2_p && p_n == p2_n) || (p_p == p2_n && p_n == p2_p))
-					    {
-						cv->cell_cell[k][j] = mv->border_cond[i];
-						cell_rec = 1;
-						break;
-					    }
-				    }							
-				if (cell_rec)
-				    break;
+				i = b_seg[c];
+				p2_p = bp[i+1];
+				p2_n = bp[i];
+				if((p_p == p2_p && p_n == p2_n) || (p_p == p2_n && p_n == p2_p))
+				    {
+					cv->cell_cell[k][j] = mv->border_cond[i];
+					cell_rec = 1;
+					break;
+				    }
 			    }
 
 			if(!cell_rec && k < (int)config[3])
@@ -337,38 +552,282 @@ void cell_rel(const struct cell_var * cv, const struct mesh_var * mv)
 				fprintf(stderr, "Ther are some wrong cell relationships!\n");
 				exit(2);
 			    }
-		    }							
+		    }
+	    }
+	free(c_off);
+	free(c_node);
+	free(b_off);
+	free(b_seg);
+}
+
+
+/**
+ * @brief Build or free the list of the unique interfaces of the grid cells from 'cv->cell_cell[][]' and 'mv->cell_pt[][]'.
+ * @details An interface between two inner grid cells is listed once, by the cell with the smaller serial number.
+ *          Interfaces at the boundary or between an inner cell and a periodic ghost cell are listed for each inner cell.
+ * @param[in,out] fv: Structure of the interface list.
+ * @param[in]     cv: Structure of grid variable data in computational grid cells, after cell_rel().
+ * @param[in]     mv: Structure of meshing variable data.
+ * @param[in] i_or_f: Initialize or free memory.
+ *       @arg 1:      build the list.
+ *       @arg 0:      free the list.
+ */
+void face_rel(struct face_var * fv, const struct cell_var * cv, const struct mesh_var * mv, const int i_or_f)
+{
+	const int num_cell = (int)config[3];
+	int **cp = mv->cell_pt;
+	int **cc = cv->cell_cell;
+
+	int p_p, p_n, p2_p, p2_n;
+	int k, j, l, cR, n;
+
+	if(!i_or_f)
+	    {
+		free(fv->cell_L);
+		fv->cell_L = fv->face_L = fv->cell_R = fv->face_R = NULL;
+		fv->num_face = 0;
+		return;
 	    }
+
+	for(k = 0, n = 0; k < num_cell; k++)
+		n += cp[k][0];
+	fv->cell_L = (int *)malloc(4 * n * sizeof(int));
+	if(fv->cell_L == NULL)
+	    {
+		fprintf(stderr, "Not enough memory in the interface list initialize!\n");
+		exit(5);
+	    }
+	fv->face_L = fv->cell_L + n;
+	fv->cell_R = fv->face_L + n;
+	fv->face_R = fv->cell_R + n;
+
+	for(k = 0, n = 0; k < num_cell; k++)
+		for(j = 0; j < cp[k][0]; j++)
+		    {
+			cR = cc[k][j];
+			if (cR >= 0 && cR < k)
+			    continue; // listed by cell cR
+			fv->cell_L[n] = k;
+			fv->face_L[n] = j;
+			fv->cell_R[n] = -1;
+			fv->face_R[n] = -1;
+			if (cR >= 0 && cR < num_cell && mv->quad_nx > 0)
+			    { // the opposite interface of the logically rectangular grids
+				fv->cell_R[n] = cR;
+				fv->face_R[n] = (j + 2) % 4;
+			    }
+			else if (cR >= 0 && cR < num_cell)
+			    {
+				p_p = cp[k][j == cp[k][0]-1 ? 1 : j+2];
+				p_n = cp[k][j+1];
+				for(l = 0; l < cp[cR][0]; l++)
+				    {
+					p2_p = cp[cR][l == cp[cR][0]-1 ? 1 : l+2];
+					p2_n = cp[cR][l+1];
+					if((p_p == p2_n) && (p2_p == p_n))
+					    {
+						fv->cell_R[n] = cR;
+						fv->face_R[n] = l;
+						break;
+					    }
+				    }
+				if (fv->cell_R[n] < 0)
+				    {
+					fprintf(stderr, "There are some wrong interface relationships!\n");
+					exit(2);
+				    }
+			    }
+			n++;
+		    }
+	fv->num_face = n;
+}
+
+
+/**
+ * @brief Compute the geometry of the interfaces of the grid cells and store it in array 'cv->face_geom[]'.
+ * @details It is computed once on the Eulerian grids, after cell_rel() and cell_centroid(),
+ *          and again only when the grids move. The distances to the midpoints are computed in the second-order scheme.
+ * @param[in,out] cv: Structure of grid variable data in computational grid cells.
+ * @param[in]     mv: Structure of meshing variable data.
+ */
+void face_geom_comp(const struct cell_var * cv, const struct mesh_var * mv)
+{
+	const int num_cell = mv->num_ghost + (int)config[3];
+	const int order = (int)config[9];
+
+#pragma omp parallel for
+	for(int k = 0; k < num_cell; k++)
+		face_geom_cell(cv, mv, k, order);
 }
 
 
 /**
  * @brief Compute x- and y-coordinates of the cell centroid and store them in array 'cv->X_c[]' and 'cv->Y_c[]'.
+ * @details The centroids of the preprocessed mesh file 'mv->geom' are copied on the Eulerian grids if they are loaded.
  * @param[in,out] cv: Structure of grid variable data in computational grid cells.
  * @param[in]     mv: Structure of meshing variable data.
  */
 void cell_centroid(const struct cell_var * cv, const struct mesh_var * mv)
 {
 	const int num_cell = mv->num_ghost + (int)config[3];
-	const double *X = mv->X, *Y = mv->Y;
+
+	if (mv->geom != NULL && (int)config[8] == 0)
+	    {
+		memcpy(cv->X_c, mv->geom + num_cell,   num_cell * sizeof(double));
+		memcpy(cv->Y_c, mv->geom + 2*num_cell, num_cell * sizeof(double));
+		return;
+	    }
+#pragma omp parallel for
+	for(int k = 0; k < num_cell; ++k)
+		centroid_cell(cv, mv, k);
+}
+
+
+/**
+ * @brief Build or free the list of the grid cells around the grid nodes 'nv' from 'mv->cell_pt[][]'.
+ * @param[in,out] nv: Structure of the lists around the grid nodes.
+ * @param[in]     mv: Structure of meshing variable data.
+ * @param[in] i_or_f: Initialize or free memory.
+ *       @arg 1:      build the list.
+ *       @arg 0:      free the list.
+ */
+void node_rel(struct node_var * nv, const struct mesh_var * mv, const int i_or_f)
+{
+	const int num_cell = mv->num_ghost + (int)config[3];
+	const int num_pt = mv->num_pt;
+
+	if(!i_or_f)
+	    {
+		free(nv->cell_off);
+		free(nv->cell);
+		free(nv->dX);
+		free(nv->moved);
+		free(nv->mark);
+		free(nv->vol_gcl);
+		nv->cell_off = nv->cell = nv->moved = NULL;
+		nv->dX = nv->dY = nv->vol_gcl = NULL;
+		nv->mark = NULL;
+		nv->num_moved = 0;
+		return;
+	    }
+
+	nv->dX       = (double *)calloc(2 * num_pt, sizeof(double));
+	nv->moved    = (int *)malloc(num_cell * sizeof(int));
+	nv->mark     = (char *)calloc(num_cell, sizeof(char));
+	nv->vol_gcl  = (double *)malloc(num_cell * sizeof(double));
+	if(nv->dX == NULL || nv->moved == NULL || nv->mark == NULL || nv->vol_gcl == NULL)
+	    {
+		fprintf(stderr, "Not enough memory in the list around grid nodes initialize!\n");
+		exit(5);
+	    }
+	nv->dY = nv->dX + num_pt;
+	node_cell_list(mv, num_cell, &nv->cell_off, &nv->cell);
+	nv->num_moved = 0;
+	nv->gcl = 0.0;
+}
+
+
+/**
+ * @brief Move the grid nodes by the displacements 'nv->dX/dY' and update the geometry of the grid cells around them.
+ * @details Only the areas, normals and centroids of the cells around the moved nodes, and the interfacial geometry of them and
+ *          their neighbours, are recomputed in parallel. The area of each moved cell is checked against the geometric conservation law:
+ *          it grows by the areas swept by its interfaces, which are exact for the linear movement of the nodes in a step
+ *          with the interfaces at the middle of the step. The maximum relative residual is given in 'nv->gcl'.
+ * @param[in,out] nv: Structure of the lists around the grid nodes, the displacements are reset to zero.
+ * @param[in,out] cv: Structure of grid variable data in computational grid cells.
+ * @param[in,out] mv: Structure of meshing variable data, the coordinates of the nodes are moved.
+ * @return The number of the cells whose nodes moved (-1: some cells are tangled).
+ */
+int geom_move_unstruct(struct node_var * nv, const struct cell_var * cv, const struct mesh_var * mv)
+{
+	const int num_cell = (int)config[3];
+	const int order = (int)config[9];
+	const int num_pt = mv->num_pt;
+	const int *cc = cv->cell_cell[0]; // flat (CSR) array
 	int **cp = mv->cell_pt;
+	double *X = mv->X, *Y = mv->Y;
+	const double *dX = nv->dX, *dY = nv->dY;
 
-	double S, S_tri;
+	double gcl = 0.0;
+	int k, p, c, f, n = 0, n_geom, tangle = 0;
 
-	for(int k = 0; k < num_cell; ++k)
+	for(p = 0; p < num_pt; p++)
+		if (dX[p] != 0.0 || dY[p] != 0.0)
+			for(c = nv->cell_off[p]; c < nv->cell_off[p+1]; c++)
+				if (!nv->mark[nv->cell[c]])
+				    {
+					nv->mark[nv->cell[c]] = 1;
+					nv->moved[n++] = nv->cell[c];
+				    }
+	nv->num_moved = n;
+	nv->gcl = 0.0;
+	if (n == 0)
+		return 0;
+
+#pragma omp parallel for private(k)
+	for(int m = 0; m < n; m++)
 	    {
-		S = 0.0;
-		cv->X_c[k] = 0.0;
-		cv->Y_c[k] = 0.0;
+		double swept = 0.0;
+		k = nv->moved[m];
+		for(int j = 0; j < cp[k][0]; j++)
+		    {
+			const int p_p = CSR_PT_P(cp, k, j), p_n = CSR_PT_N(cp, k, j);
+			swept += 0.5*(dX[p_n] + dX[p_p]) * ((Y[p_p] + 0.5*dY[p_p]) - (Y[p_n] + 0.5*dY[p_n]));
+			swept += 0.5*(dY[p_n] + dY[p_p]) * ((X[p_n] + 0.5*dX[p_n]) - (X[p_p] + 0.5*dX[p_p]));
+		    }
+		nv->vol_gcl[k] = cv->vol[k] + swept;
+	    }
 
-		for(int j = 2; j < cp[k][0]; j++)
+#pragma omp parallel for
+	for(int q = 0; q < num_pt; q++)
+		if (dX[q] != 0.0 || dY[q] != 0.0)
 		    {
-			S_tri = X[cp[k][1]]*Y[cp[k][j]] + X[cp[k][j+1]]*Y[cp[k][1]] + X[cp[k][j]]*Y[cp[k][j+1]] - X[cp[k][j+1]]*Y[cp[k][j]] - X[cp[k][1]]*Y[cp[k][j+1]] - X[cp[k][j]]*Y[cp[k][1]];
-			cv->X_c[k] += (X[cp[k][1]] + X[cp[k][j]] + X[cp[k][j+1]]) * S_tri;
-			cv->Y_c[k] += (Y[cp[k][1]] + Y[cp[k][j]] + Y[cp[k][j+1]]) * S_tri;
-			S += S_tri;
+			X[q] += dX[q];
+			Y[q] += dY[q];
+			nv->dX[q] = 0.0;
+			nv->dY[q] = 0.0;
 		    }
-		cv->X_c[k] /= S*3.0;
-		cv->Y_c[k] /= S*3.0;
+
+#pragma omp parallel for private(k) reduction(max:gcl) reduction(|:tangle)
+	for(int m = 0; m < n; m++)
+	    {
+		k = nv->moved[m];
+		vol_cell(cv, mv, k);
+		normal_cell(cv, mv, k);
+		if (order > 1)
+			centroid_cell(cv, mv, k);
+		if (cv->vol[k] <= 0.0)
+			tangle = 1;
+		else
+			gcl = fmax(gcl, fabs(cv->vol[k] - nv->vol_gcl[k]) / cv->vol[k]);
+	    }
+	nv->gcl = gcl;
+
+	// The interfacial geometry and the least-squares reconstruction of the neighbours depend on the moved centroids.
+	n_geom = n;
+	if (order > 1)
+		for(int m = 0; m < n; m++)
+			for(f = cv->face_off[nv->moved[m]]; f < cv->face_off[nv->moved[m]+1]; f++)
+				if (cc[f] >= 0 && !nv->mark[cc[f]])
+				    {
+					nv->mark[cc[f]] = 2;
+					nv->moved[n_geom++] = cc[f];
+				    }
+#pragma omp parallel for private(k)
+	for(int m = 0; m < n_geom; m++)
+	    {
+		k = nv->moved[m];
+		face_geom_cell(cv, mv, k, order);
+		if (cv->lsq_inv != NULL && k < num_cell)
+			lsq_geom_cell(cv, k);
+	    }
+	for(int m = 0; m < n_geom; m++)
+		nv->mark[nv->moved[m]] = 0;
+
+	if (tangle)
+	    {
+		fprintf(stderr, "There are some tangled grid cells after the grid movement!\n");
+		return -1;
 	    }
+	return n;
 }
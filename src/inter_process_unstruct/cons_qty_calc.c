@@ -5,6 +5,7 @@
 
 
 #include "../include/var_struc.h"
+#include "../include/inter_process_unstruct.h"
 
 
 /**
@@ -15,6 +16,7 @@
 void cons_qty_init(const struct cell_var * cv, const struct flu_var * FV)
 {
 	const int num_cell = (int)config[3];
+#pragma omp parallel for
 	for(int k = 0; k < num_cell; k++)
 		{
 			cv->U_rho[k] = FV->RHO[k];
@@ -31,6 +33,14 @@ void cons_qty_init(const struct cell_var * cv, const struct flu_var * FV)
 			cv->U_e[k]    += FV->P[k]/(config[6]-1.0);
 #endif
 		}
+	for(int s = 0; FV->Y != NULL && s < (int)config[71]; s++)
+		{
+			const double * Y = FV->Y + (size_t)s*FV->n_Y;
+			double * U_Y = cv->U_Y + (size_t)s*FV->n_Y;
+#pragma omp parallel for
+			for(int k = 0; k < num_cell; k++)
+				U_Y[k] = FV->RHO[k] * Y[k];
+		}
 }
 
 
@@ -5,82 +5,242 @@
 
 
 #include "../include/var_struc.h"
+#include "../include/tools.h"
 
+
+/**
+ * @brief Coefficients of the low-storage SSP Runge-Kutta methods in the Shu-Osher form.
+ * @details The RK-th stage of a method with n stages gives U = a*U^n + (1-a)*(U + tau*L(U)),
+ *          a = ssp_rk_a[n][RK], at time t_n + ssp_rk_c[n][RK]*tau. Only U^n is stored in 'cv->U_RK'.
+ */
+static const double ssp_rk_a[4][3] = {{0.0}, {0.0}, {0.0, 0.5}, {0.0, 0.75, 1.0/3.0}};
+static const double ssp_rk_c[4][3] = {{0.0}, {0.0}, {0.0, 1.0}, {0.0, 1.0, 0.5}};
+
+/**
+ * @brief Number of the stages of the SSP Runge-Kutta time discretization config[53].
+ * @return 1: forward Euler, 2: SSP-RK2 (config[53] = 1 or 2), 3: SSP-RK3.
+ */
+int ssp_rk_stages(void)
+{
+	const int n = (int)config[53];
+	return n >= 3 ? 3 : (n > 0 ? 2 : 1);
+}
+
+/**
+ * @brief Time of the RK-th stage of the SSP Runge-Kutta time discretization in the unit of the time step.
+ */
+double ssp_rk_time(const int RK)
+{
+	return ssp_rk_c[ssp_rk_stages()][RK];
+}
+
+
+/**
+ * @brief Update the partial densities of the species by the upwind fluxes in the RK-th stage of the time step.
+ * @details The flux of the s-th species through an interface is F_rho*Y_s, where Y_s is reconstructed at the midpoint
+ *          of the interface by the limited gradient on the upwind side of the mass flux F_rho (the cell itself
+ *          at the inflow boundaries). The geometry and the upwind cell of an interface are found once for all the
+ *          species, which are swept by the inner loops over the rows of the block [K][n_Y].
+ * @param[in,out] cv:  Structure of grid variable data in computational grid cells.
+ * @param[in]     FV:  Structure of fluid variable data array pointer.
+ * @param[in]     tau: The length of the time step of the stage, (1-a)*tau (the local time steps 'cv->tau_loc' instead).
+ * @param[in]     a:   Coefficient of U^n of the stage.
+ * @param[in]     RK:  Stage of the SSP Runge-Kutta time discretization.
+ */
+static void species_update_corr(struct cell_var * cv, const struct flu_var * FV, const double tau, const double a, const int RK)
+{
+	const int K = (int)config[71];
+	const int num_cell = (int)config[3];
+	const _Bool grad = cv->gradx_Y != NULL;
+	const size_t n = (size_t)FV->n_Y;
+	const int * cc = cv->cell_cell[0];
+	const double * F_rho = cv->F_rho[0];
+	const double * Y = FV->Y, * gx = cv->gradx_Y, * gy = cv->grady_Y;
+	double * U_Y = cv->U_Y, * U_Y_RK = cv->U_Y_RK;
+
+#pragma omp parallel for
+	for(int k = 0; k < num_cell; ++k)
+		{
+			if (U_Y_RK)
+				for(int s = 0; s < K; s++)
+					{
+						if (RK == 0)
+							U_Y_RK[s*n+k] = U_Y[s*n+k];
+						else
+							U_Y[s*n+k] = a*U_Y_RK[s*n+k] + (1.0 - a)*U_Y[s*n+k];
+					}
+			const double tau_k = cv->tau_loc ? (1.0 - a)*cv->tau_loc[k] : tau;
+			for(int f = cv->face_off[k]; f < cv->face_off[k+1]; f++)
+				{
+					const double * fg = cv->face_geom + FACE_GEOM * f;
+					const double w = tau_k*F_rho[f] * fg[0] / cv->vol[k];
+					int c = k; // the upwind cell
+					double dx = grad ? fg[1] : 0.0, dy = grad ? fg[2] : 0.0;
+					if (F_rho[f] < 0.0 && cc[f] >= 0)
+						{
+							c  = cc[f];
+							dx = grad ? fg[3] : 0.0;
+							dy = grad ? fg[4] : 0.0;
+						}
+					if (grad)
+						for(int s = 0; s < K; s++)
+							U_Y[s*n+k] -= w*(Y[s*n+c] + gx[s*n+c]*dx + gy[s*n+c]*dy);
+					else
+						for(int s = 0; s < K; s++)
+							U_Y[s*n+k] -= w*Y[s*n+c];
+				}
+		}
+}
+
+
+/**
+ * @brief Update the conservative variables by the interfacial fluxes in the RK-th stage of the time step.
+ * @param[in,out] cv:  Structure of grid variable data in computational grid cells.
+ * @param[in]     mv:  Structure of meshing variable data.
+ * @param[in]     FV:  Structure of fluid variable data array pointer.
+ * @param[in]     tau: The length of the time step (the local time steps 'cv->tau_loc' in the update instead).
+ * @param[in]     RK:  Stage of the SSP Runge-Kutta time discretization (0: the first stage OR forward Euler).
+ * @param[out]    res: Residuals of the first stage (steady_state_check()), the changes of the density and the energy
+ *                     by tau and the fluxes of the cells, which are summed up in the update loop (NULL: No residual).
+ * @return 1: success.
+ */
 int cons_qty_update_corr_ave_P(struct cell_var * cv, const struct mesh_var * mv,
-							   const struct flu_var * FV, double tau, const int RK)
+							   const struct flu_var * FV, double tau, const int RK, double * res)
 {
 	const int num_cell = (int)config[3];
 	const int order = (int)config[9];
-	int ** cp = mv->cell_pt;
+	(void)mv; // The lengths of the interfaces are given by face_geom_comp().
+	// flat (CSR) interfacial arrays
+	const double * F_rho = cv->F_rho[0], * F_e = cv->F_e[0], * F_u = cv->F_u[0], * F_v = cv->F_v[0];
+#ifdef MULTIFLUID_BASICS
+	const double * F_e_a = cv->F_e_a[0], * F_phi = cv->F_phi[0], * P_star = cv->P_star[0];
+	const double * U_qt_star = cv->U_qt_star[0], * V_qt_star = cv->V_qt_star[0];
+	const double * U_qt_add_c = cv->U_qt_add_c[0], * V_qt_add_c = cv->V_qt_add_c[0];
+#endif
 
 	double U_u_a = 0.0, U_v_a = 0.0;
-	int p_p, p_n;
 	double length, Z_a = 1.0;
-	int k,j;
+	int k, j, f;
 	
-	static double U_rho_bak[412164], U_e_bak[412164], U_u_bak[412164], U_v_bak[412164], U_phi_bak[412164];
-	if (RK == 1)
-		tau = 0.5*tau;
-//	for(k = (int)config[13]; k < num_cell; ++k)
-	for(k = 0; k < num_cell; ++k)
-		{
-			if (RK == 0 && (_Bool)config[53])
-				{
-					U_rho_bak[k] = cv->U_rho[k];
-					U_e_bak[k]   = cv->U_e[k];
-					U_u_bak[k]   = cv->U_u[k];
-					U_v_bak[k]   = cv->U_v[k];
+	const int n_RK = ssp_rk_stages();
+	const double a = ssp_rk_a[n_RK][RK];
+#ifdef _OPENACC
+	const int n_f = cv->face_off[num_cell]; // the interfaces of the cells
 #ifdef MULTIFLUID_BASICS
-					U_phi_bak[k] = cv->U_phi[k];
+#define FLUX_MF_PRESENT present(F_e_a[0:n_f], F_phi[0:n_f], P_star[0:n_f], U_qt_star[0:n_f], V_qt_star[0:n_f], \
+				U_qt_add_c[0:n_f], V_qt_add_c[0:n_f])
+#else
+#define FLUX_MF_PRESENT
 #endif
-				}
-			if (RK == 1)
-				{
-					cv->U_rho[k] = 0.5*(cv->U_rho[k] + U_rho_bak[k]);
-					cv->U_e[k]   = 0.5*(cv->U_e[k]   + U_e_bak[k]);
-					cv->U_u[k]   = 0.5*(cv->U_u[k]   + U_u_bak[k]);
-					cv->U_v[k]   = 0.5*(cv->U_v[k]   + U_v_bak[k]);
+	// The array of the conservative variables is not on the device, they are selected in the loop.
 #ifdef MULTIFLUID_BASICS
-					cv->U_phi[k] = 0.5*(cv->U_phi[k] + U_phi_bak[k]);
+#define CONS_VAR(v) ((v) == 0 ? cv->U_rho : (v) == 1 ? cv->U_e : (v) == 2 ? cv->U_u : (v) == 3 ? cv->U_v : \
+		     (v) == 4 ? cv->U_e_a : (v) == 5 ? cv->U_phi : cv->U_gamma)
+#else
+#define CONS_VAR(v) ((v) == 0 ? cv->U_rho : (v) == 1 ? cv->U_e : (v) == 2 ? cv->U_u : cv->U_v)
 #endif
-				}
+#else
+	double * U[] = {cv->U_rho, cv->U_e, cv->U_u, cv->U_v,
+#ifdef MULTIFLUID_BASICS
+			cv->U_e_a, cv->U_phi, cv->U_gamma,
+#endif
+	};
+#define CONS_VAR(v) U[v]
+#endif
+	int v;
+	const double tau_n = tau; // the time step of the residuals
+	double r1_rho = 0.0, r1_e = 0.0, ri_rho = 0.0, ri_e = 0.0, d_rho, d_e, tau_k;
+#ifndef _OPENACC
+	const _Bool repro = (int)config[77] > 0; // the exact L1 residuals independent of the number of the threads
+	struct repro_sum s1_rho, s1_e;
+	repro_sum_init(&s1_rho);
+	repro_sum_init(&s1_e);
+#endif
+	tau = (1.0 - a)*tau;
+//	for(k = (int)config[13]; k < num_cell; ++k)
+#ifdef _OPENACC
+#pragma acc parallel loop private(j, f, length, v, d_rho, d_e, tau_k) firstprivate(U_u_a, U_v_a, Z_a) \
+	reduction(+:r1_rho, r1_e) reduction(max:ri_rho, ri_e) present(cv[0:1], FV[0:1], F_rho[0:n_f], F_e[0:n_f], F_u[0:n_f], F_v[0:n_f]) \
+	FLUX_MF_PRESENT default(present)
+#else
+#pragma omp parallel for private(j, f, length, v, d_rho, d_e, tau_k) firstprivate(U_u_a, U_v_a, Z_a) \
+	reduction(+:r1_rho, r1_e) reduction(max:ri_rho, ri_e) reduction(rsum:s1_rho, s1_e)
+#endif
+	for(k = 0; k < num_cell; ++k)
+		{
+			tau_k = cv->tau_loc ? (1.0 - a)*cv->tau_loc[k] : tau;
+			if (n_RK > 1)
+				for(v = 0; v < NUM_CONS_RK; v++)
+					{
+						if (RK == 0)
+							cv->U_RK[v*num_cell+k] = CONS_VAR(v)[k];
+						else
+							CONS_VAR(v)[k] = a*cv->U_RK[v*num_cell+k] + (1.0 - a)*CONS_VAR(v)[k];
+					}
 #ifdef MULTIFLUID_BASICS
 			U_u_a = cv->U_phi[k]*cv->U_u[k]/cv->U_rho[k];
 			U_v_a = cv->U_phi[k]*cv->U_v[k]/cv->U_rho[k];			
 			if (order == 1)					
 				Z_a = FV->Z_a[k];
 			else if (order == 2)
-				Z_a = FV->Z_a[k]-0.5*tau*(cv->U_u[k]*cv->gradx_z_a[k]+cv->U_v[k]*cv->grady_z_a[k])/cv->U_rho[k];
+				Z_a = FV->Z_a[k]-0.5*tau_k*(cv->U_u[k]*cv->gradx_z_a[k]+cv->U_v[k]*cv->grady_z_a[k])/cv->U_rho[k];
 #endif
-			for(j = 0; j < cp[k][0]; j++)
+			d_rho = d_e = 0.0;
+			for(j = 0, f = CSR_FACE(cv, k, 0); j < CSR_NUM(cv, k); j++, f++)
 				{
-					if(j == cp[k][0]-1) 
-						{
-							p_p=cp[k][1];
-							p_n=cp[k][j+1];
-						}				  
-					else
-						{
-							p_p=cp[k][j+2];
-							p_n=cp[k][j+1];
-						}
-					length = sqrt((mv->X[p_p] - mv->X[p_n])*(mv->X[p_p]-mv->X[p_n]) + (mv->Y[p_p] - mv->Y[p_n])*(mv->Y[p_p]-mv->Y[p_n]));				
-					cv->U_rho[k] += - tau*cv->F_rho[k][j] * length / cv->vol[k];
-					cv->U_e[k]   += - tau*cv->F_e[k][j]   * length / cv->vol[k];	
-					cv->U_u[k]   += - tau*cv->F_u[k][j]   * length / cv->vol[k];
-					cv->U_v[k] += - tau*cv->F_v[k][j] * length / cv->vol[k];
+					length = cv->face_geom[FACE_GEOM * f];
+					cv->U_rho[k] += - tau_k*F_rho[f] * length / cv->vol[k];
+					cv->U_e[k]   += - tau_k*F_e[f]   * length / cv->vol[k];	
+					cv->U_u[k]   += - tau_k*F_u[f]   * length / cv->vol[k];
+					cv->U_v[k] += - tau_k*F_v[f] * length / cv->vol[k];
+					d_rho += F_rho[f] * length;
+					d_e   += F_e[f]   * length;
 #ifdef MULTIFLUID_BASICS
-					U_u_a += - tau*(cv->U_qt_add_c[k][j] + Z_a*cv->U_qt_star[k][j]) * length / cv->vol[k];
-					U_v_a += - tau*(cv->V_qt_add_c[k][j] + Z_a*cv->V_qt_star[k][j]) * length / cv->vol[k];
-					cv->U_e_a[k] += - tau*(cv->F_e_a[k][j] + Z_a*cv->P_star[k][j]) * length / cv->vol[k];
-					cv->U_phi[k] += - tau*cv->F_phi[k][j] * length / cv->vol[k];
+					U_u_a += - tau_k*(U_qt_add_c[f] + Z_a*U_qt_star[f]) * length / cv->vol[k];
+					U_v_a += - tau_k*(V_qt_add_c[f] + Z_a*V_qt_star[f]) * length / cv->vol[k];
+					cv->U_e_a[k] += - tau_k*(F_e_a[f] + Z_a*P_star[f]) * length / cv->vol[k];
+					cv->U_phi[k] += - tau_k*F_phi[f] * length / cv->vol[k];
 #endif
 				}
+			d_rho = fabs(tau_n*d_rho / cv->vol[k]);
+			d_e   = fabs(tau_n*d_e   / cv->vol[k]);
+#ifndef _OPENACC
+			if (repro)
+				{
+					repro_sum_add(&s1_rho, d_rho);
+					repro_sum_add(&s1_e,   d_e);
+				}
+			else
+#endif
+				{
+					r1_rho += d_rho;
+					r1_e   += d_e;
+				}
+			ri_rho  = fmax(ri_rho, d_rho);
+			ri_e    = fmax(ri_e,   d_e);
 #ifdef MULTIFLUID_BASICS
 			cv->U_e_a[k] += (cv->U_phi[k]*cv->U_u[k]/cv->U_rho[k]-U_u_a)*cv->U_u[k]/cv->U_rho[k];
 			cv->U_e_a[k] += (cv->U_phi[k]*cv->U_v[k]/cv->U_rho[k]-U_v_a)*cv->U_v[k]/cv->U_rho[k];
 			cv->U_e_a[k] = cv->U_e[k];
 #endif
 		}
+	if (FV->Y != NULL && (int)config[71] > 0)
+		species_update_corr(cv, FV, tau, a, RK);
+#ifndef _OPENACC
+	if (repro)
+		{
+			r1_rho = repro_sum_value(&s1_rho);
+			r1_e   = repro_sum_value(&s1_e);
+		}
+#endif
+	if (res != NULL && RK == 0)
+		{
+			res[SS_L1_RHO] = r1_rho;
+			res[SS_L1_E]   = r1_e;
+			res[SS_LI_RHO] = ri_rho;
+			res[SS_LI_E]   = ri_e;
+		}
+#undef CONS_VAR
+#undef FLUX_MF_PRESENT
 	return 1;
 }
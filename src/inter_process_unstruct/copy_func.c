@@ -2,6 +2,7 @@
 #include <math.h>
 
 #include "../include/var_struc.h"
+#include "../include/inter_process_unstruct.h"
 
 
 
@@ -98,6 +99,40 @@ void flux_copy_ifv2cv(const struct i_f_var * ifv, const struct cell_var * cv, co
 #endif
 }
 
+/**
+ * @brief Copy the interfacial variables to the k-th cell on the other side of the interface, whose normal vector is opposite.
+ * @details The fluxes change sign with the normal vector, and the interfacial values are the same as those of the owner cell.
+ */
+void flux_opposite_ifv2cv(const struct i_f_var * ifv, const struct cell_var * cv, const int k, const int j)
+{
+	cv->F_rho[k][j] = -ifv->F_rho;
+	cv->F_e[k][j]   = -ifv->F_e;
+	cv->F_u[k][j]   = -ifv->F_u;
+	cv->F_v[k][j]   = -ifv->F_v;
+#ifdef MULTIFLUID_BASICS
+	cv->F_phi[k][j] = -ifv->F_phi;
+	cv->F_e_a[k][j] = -ifv->F_e_a;
+	if ((_Bool)config[60])
+		cv->F_gamma[k][j] = -ifv->F_gamma;
+#endif
+
+	cv->RHO_p[k][j] = ifv->RHO_int;
+	cv->U_p[k][j]   = ifv->U_int;
+	cv->V_p[k][j]   = ifv->V_int;
+	cv->P_p[k][j]   = ifv->P_int;
+#ifdef MULTIFLUID_BASICS
+	cv->PHI_p[k][j] = ifv->PHI;
+	cv->Z_a_p[k][j] = ifv->Z_a;
+	cv->gamma_p[k][j] = ifv->gamma;
+
+	cv->P_star[k][j]       = -ifv->P_star;
+	cv->U_qt_star[k][j]    = -ifv->U_qt_star;
+	cv->V_qt_star[k][j]    = -ifv->V_qt_star;
+	cv->U_qt_add_c[k][j]   = -ifv->U_qt_add_c;
+	cv->V_qt_add_c[k][j]   = -ifv->V_qt_add_c;
+#endif
+}
+
 void flux_add_ifv2cv(const struct i_f_var * ifv, const struct cell_var * cv, const int k, const int j)
 {
 	cv->F_rho[k][j] = 0.5*(cv->F_rho[k][j] + ifv->F_rho);
@@ -0,0 +1,196 @@
+/**
+ * @file  device_data_unstruct.c
+ * @brief This is a set of functions which keep the variables of the unstructured grid cells resident on the device of OpenACC.
+ * @details The CSR offsets and connectivity, the geometry of the interfaces and all the cell and interfacial variables
+ *          are entered into the device memory once before the time loop. The interfaces of the list 'fv' are solved
+ *          one by one on the device, and the updates, the least-squares reconstruction and the CFL condition run
+ *          there too. The fluid variables are copied back to the host only for the output.
+ *          Without OpenACC, these functions do nothing.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/var_struc.h"
+#include "../include/tools.h"
+#include "../include/inter_process_unstruct.h"
+#ifdef _OPENACC
+#include <openacc.h>
+#endif
+
+
+#ifdef _OPENACC
+//! Give the directive x of OpenACC in a macro.
+#define ACC_PRAGMA(x) _Pragma(#x)
+/**
+ * @brief Enter the n values of the array 'v' of the structure pointer 'S' into the device memory, if it is allocated.
+ * @details The pointer 'S->v' in the structure on the device is attached to the array on the device.
+ */
+#define ARRAY_ENTER(S, v, n)						\
+    do {								\
+	if((S)->v != NULL)						\
+	    {								\
+		acc_copyin((S)->v, (size_t)(n) * sizeof(*(S)->v));	\
+		ACC_PRAGMA(acc enter data attach(S->v))			\
+	    }								\
+    } while (0)
+//! Copy the n values of the array 'v' of the structure pointer 'S' from the device back to the host.
+#define ARRAY_UPDATE(S, v, n) do { if((S)->v != NULL) acc_update_self((S)->v, (size_t)(n) * sizeof(*(S)->v)); } while (0)
+//! Delete the n values of the array 'v' of the structure pointer 'S' from the device memory.
+#define ARRAY_EXIT(S, v, n)   do { if((S)->v != NULL) acc_delete((S)->v, (size_t)(n) * sizeof(*(S)->v)); } while (0)
+/**
+ * @brief Enter the M CSR rows of the interfacial variable 'v' of 'cv' into the device memory (copy: whether the values are copied).
+ * @details The pointer 'cv->v' in the structure on the device is attached to the row pointers on the device.
+ */
+#define CSR_ENTER(v, M, copy)						\
+    do {								\
+	if(cv->v != NULL)						\
+	    {								\
+		field_device_enter_CSR(cv->v, cv->face_off, (M), sizeof(**cv->v), (copy)); \
+		ACC_PRAGMA(acc enter data attach(cv->v))		\
+	    }								\
+    } while (0)
+//! Delete the M CSR rows of the interfacial variable 'v' of 'cv' from the device memory.
+#define CSR_EXIT(v, M) do { if(cv->v != NULL) field_device_exit_CSR(cv->v, cv->face_off, (M), sizeof(**cv->v)); } while (0)
+
+/**
+ * @brief The lists of the variables of the cells (with the ghost cells) in struct 'cv' and 'FV' on the device.
+ * @details Each list applies the macro S (ARRAY_ENTER/UPDATE/EXIT) to the arrays.
+ */
+#ifdef MULTIFLUID_BASICS
+#define FV_LIST(S, n) S(FV, RHO, n); S(FV, U, n); S(FV, V, n); S(FV, P, n); S(FV, PHI, n); S(FV, Z_a, n); S(FV, gamma, n)
+#define CV_LIST(S, n)							\
+    S(cv, U_rho, n); S(cv, U_e, n); S(cv, U_u, n); S(cv, U_v, n);	\
+    S(cv, U_e_a, n); S(cv, U_phi, n); S(cv, U_gamma, n);		\
+    S(cv, gradx_rho, n); S(cv, gradx_e, n); S(cv, gradx_u, n); S(cv, gradx_v, n); \
+    S(cv, grady_rho, n); S(cv, grady_e, n); S(cv, grady_u, n); S(cv, grady_v, n); \
+    S(cv, gradx_z_a, n); S(cv, grady_z_a, n); S(cv, gradx_phi, n); S(cv, grady_phi, n); \
+    S(cv, gradx_gamma, n); S(cv, grady_gamma, n)
+//! The CSR interfacial variables of the two-component flows of the inner cells.
+#define CSR_LIST_MF(S, ...)						\
+    S(F_phi, __VA_ARGS__); S(F_e_a, __VA_ARGS__); S(F_gamma, __VA_ARGS__); \
+    S(PHI_p, __VA_ARGS__); S(Z_a_p, __VA_ARGS__); S(gamma_p, __VA_ARGS__); \
+    S(P_star, __VA_ARGS__); S(U_qt_star, __VA_ARGS__); S(V_qt_star, __VA_ARGS__); \
+    S(U_qt_add_c, __VA_ARGS__); S(V_qt_add_c, __VA_ARGS__)
+#else
+#define FV_LIST(S, n) S(FV, RHO, n); S(FV, U, n); S(FV, V, n); S(FV, P, n)
+#define CV_LIST(S, n)							\
+    S(cv, U_rho, n); S(cv, U_e, n); S(cv, U_u, n); S(cv, U_v, n);	\
+    S(cv, gradx_rho, n); S(cv, gradx_e, n); S(cv, gradx_u, n); S(cv, gradx_v, n); \
+    S(cv, grady_rho, n); S(cv, grady_e, n); S(cv, grady_u, n); S(cv, grady_v, n)
+#define CSR_LIST_MF(S, ...)
+#endif
+//! The CSR interfacial variables of the inner cells.
+#define CSR_LIST(S, ...)						\
+    S(F_rho, __VA_ARGS__); S(F_e, __VA_ARGS__); S(F_u, __VA_ARGS__); S(F_v, __VA_ARGS__); \
+    S(RHO_p, __VA_ARGS__); S(P_p, __VA_ARGS__);				\
+    CSR_LIST_MF(S, __VA_ARGS__)
+//! The CSR interfacial variables of the cells with the ghost cells.
+#define CSR_LIST_GHOST(S, ...)						\
+    S(cell_cell, __VA_ARGS__); S(n_x, __VA_ARGS__); S(n_y, __VA_ARGS__); \
+    S(U_p, __VA_ARGS__); S(V_p, __VA_ARGS__)
+#endif
+
+
+/**
+ * @brief This function enters the run context, the grid cells, the interfaces and the fluid variables into the device memory.
+ * @details The device loops are the conservative update, the least-squares reconstruction (config[30] = 1), the CFL condition
+ *          and the fluxes of the interface list, so that the moving grids, the minmod reconstruction, the advected species
+ *          and the halo exchange of the parts of the grids, which run on the host, are not supported with OpenACC.
+ * @param[in,out] cv: Structure of grid variable data in computational grid cells.
+ * @param[in]     mv: Structure of meshing variable data.
+ * @param[in,out] FV: Structure of fluid variable data array pointer.
+ * @param[in]     fv: Structure of the interfaces (NULL: No interface list).
+ */
+void device_data_enter_unstruct(struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, struct face_var * fv)
+{
+#ifdef _OPENACC
+    const int num_cell = (int)config[3];
+    const int num_cell_ghost = mv->num_ghost + num_cell;
+    const char * no = NULL;
+
+    if(fv == NULL)
+	no = "The solution of the interfaces cell by cell";
+    else if((int)config[8] != 0)
+	no = "The moving grids";
+    else if((int)config[9] > 1 && (int)config[30] != 1 && !(int)config[31])
+	no = "The reconstruction but the least-squares one";
+    else if(FV->Y != NULL && (int)config[71] > 0)
+	no = "The advected species";
+    else if(halo_size_unstruct() > 1)
+	no = "The parts of the grids";
+    if(no != NULL)
+	{
+	    printf("%s is not supported on the device!\n", no);
+	    exit(4);
+	}
+
+#pragma acc update device(run_ctx_global)
+#pragma acc enter data copyin(cv[0:1], FV[0:1], fv[0:1])
+    ARRAY_ENTER(cv, face_off, num_cell_ghost + 1);
+    ARRAY_ENTER(cv, vol, num_cell_ghost);
+    ARRAY_ENTER(cv, face_geom, FACE_GEOM * cv->face_off[num_cell_ghost]);
+    ARRAY_ENTER(cv, lsq_inv, 4 * num_cell);
+    ARRAY_ENTER(cv, lsq_d,   2 * cv->face_off[num_cell]);
+    ARRAY_ENTER(cv, U_RK, NUM_CONS_RK * num_cell);
+    ARRAY_ENTER(cv, tau_loc, num_cell);
+    CV_LIST(ARRAY_ENTER, num_cell_ghost);
+    FV_LIST(ARRAY_ENTER, num_cell_ghost);
+    CSR_LIST_GHOST(CSR_ENTER, num_cell_ghost, 1);
+    CSR_LIST(CSR_ENTER, num_cell, 0);
+    // The four lists of the interfaces are one block.
+    acc_copyin(fv->cell_L, 4 * (size_t)(fv->face_L - fv->cell_L) * sizeof(int));
+#pragma acc enter data attach(fv->cell_L, fv->face_L, fv->cell_R, fv->face_R)
+    if(mv->period_cell != NULL)
+	acc_copyin(mv->period_cell, num_cell_ghost * sizeof(int));
+    printf("The variables of the unstructured grid cells are resident on the device.\n");
+#endif
+}
+
+/**
+ * @brief This function copies the fluid variables on the device back to the host for the output.
+ * @param[in]     mv: Structure of meshing variable data.
+ * @param[in,out] FV: Structure of fluid variable data array pointer.
+ */
+void device_data_update_host_unstruct(const struct mesh_var * mv, struct flu_var * FV)
+{
+#ifdef _OPENACC
+    const int num_cell_ghost = mv->num_ghost + (int)config[3];
+    FV_LIST(ARRAY_UPDATE, num_cell_ghost);
+#endif
+}
+
+/**
+ * @brief This function copies the fluid and conservative variables back to the host and deletes all the data
+ *        entered by device_data_enter_unstruct().
+ * @param[in,out] cv: Structure of grid variable data in computational grid cells.
+ * @param[in]     mv: Structure of meshing variable data.
+ * @param[in,out] FV: Structure of fluid variable data array pointer.
+ * @param[in]     fv: Structure of the interfaces.
+ */
+void device_data_exit_unstruct(struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, struct face_var * fv)
+{
+#ifdef _OPENACC
+    const int num_cell = (int)config[3];
+    const int num_cell_ghost = mv->num_ghost + num_cell;
+
+    FV_LIST(ARRAY_UPDATE, num_cell_ghost);
+    ARRAY_UPDATE(cv, U_rho, num_cell_ghost); ARRAY_UPDATE(cv, U_e, num_cell_ghost);
+    ARRAY_UPDATE(cv, U_u,   num_cell_ghost); ARRAY_UPDATE(cv, U_v, num_cell_ghost);
+#pragma acc exit data delete(cv[0:1], FV[0:1], fv[0:1])
+    if(mv->period_cell != NULL)
+	acc_delete(mv->period_cell, num_cell_ghost * sizeof(int));
+    acc_delete(fv->cell_L, 4 * (size_t)(fv->face_L - fv->cell_L) * sizeof(int));
+    CSR_LIST(CSR_EXIT, num_cell);
+    CSR_LIST_GHOST(CSR_EXIT, num_cell_ghost);
+    FV_LIST(ARRAY_EXIT, num_cell_ghost);
+    CV_LIST(ARRAY_EXIT, num_cell_ghost);
+    ARRAY_EXIT(cv, tau_loc, num_cell);
+    ARRAY_EXIT(cv, U_RK, NUM_CONS_RK * num_cell);
+    ARRAY_EXIT(cv, lsq_d,   2 * cv->face_off[num_cell]);
+    ARRAY_EXIT(cv, lsq_inv, 4 * num_cell);
+    ARRAY_EXIT(cv, face_geom, FACE_GEOM * cv->face_off[num_cell_ghost]);
+    ARRAY_EXIT(cv, vol, num_cell_ghost);
+    ARRAY_EXIT(cv, face_off, num_cell_ghost + 1);
+#endif
+}
@@ -0,0 +1,483 @@
+/**
+ * @file  halo_exchange_unstruct.c
+ * @brief This is a set of functions which partition the unstructured grids into the parts of the MPI processes
+ *        and exchange the ghost cells of the parts.
+ * @details The inner cells are split into contiguous ranges of the order given by mesh_reorder(), one range for each process,
+ *          so that a part is a connected set of cells along the reverse Cuthill–McKee (graph) order or the space-filling curve.
+ *          Each process keeps the mesh of its cells and a layer of ghost cells, which are the cells sharing an interface
+ *          with its cells: the inner cells of the other parts and the ghost cells at the periodic boundary.
+ *          The ghost cells are filled by halo_ghost_unstruct() in place of period_ghost(),
+ *          with the variables of their source cells sent by non-blocking messages or copied in the process.
+ *          Without MPI_UNSTRUCT, or with one process, the grids are not partitioned and these functions do nothing.
+ * @attention  Library Dependency: MPI (Compile with '-DMPI_UNSTRUCT' by mpicc)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include_cii/mem.h"
+#include "../include/var_struc.h"
+#include "../include/meshing.h"
+#include "../include/inter_process_unstruct.h"
+#ifdef MPI_UNSTRUCT
+#include <mpi.h>
+
+
+//! The maximum number of variables of a ghost cell in a message.
+#define HALO_MAX_NV 26
+
+//! The part of the grids of this process.
+static struct halo_part {
+	MPI_Comm comm;   //!< Communicator of the parts.
+	int size, rank;  //!< Number of the processes and the rank of this process.
+	int * s_off, * s_cell; //!< Cells sent to the process q: s_cell[s_off[q]] … s_cell[s_off[q+1]-1].
+	int * r_off, * r_cell; //!< Ghost cells received from the process q: r_cell[r_off[q]] … r_cell[r_off[q+1]-1].
+	double * buf_s, * buf_r; //!< Buffers of the sent and received cells.
+	MPI_Request * req;       //!< Requests of the messages.
+} hp = {.comm = MPI_COMM_NULL, .size = 1};
+
+//! First inner cell of the part r of n inner cells.
+#define HALO_FIRST(r, n)  (int)((long long)(n) * (r) / hp.size)
+
+//! Rank of the part of the inner cell c of n inner cells.
+static int halo_owner(const int c, const int n)
+{
+	int r = (int)((long long)c * hp.size / n);
+	while (r > 0 && c < HALO_FIRST(r, n))
+		r--;
+	while (r < hp.size-1 && c >= HALO_FIRST(r+1, n))
+		r++;
+	return r;
+}
+
+//! Whether the grid cell c of the mesh has the node p.
+static _Bool halo_has_pt(int ** cp, const int c, const int p)
+{
+	for(int m = 1; m <= cp[c][0]; m++)
+		if (cp[c][m] == p)
+			return 1;
+	return 0;
+}
+
+/**
+ * @brief Reset the initial fluid data 'v' to those of the cells of the part.
+ */
+#define HALO_FV_PART(v)							\
+	do {								\
+		double * v_p = (double *)malloc(n_own * sizeof(double)); \
+		if(v_p == NULL)						\
+		    {							\
+			fprintf(stderr, "Not enough memory in the partition of the fluid variables!\n"); \
+			exit(5);					\
+		    }							\
+		memcpy(v_p, FV->v + c0, n_own * sizeof(double));	\
+		free(FV->v);						\
+		FV->v = v_p;						\
+	} while (0)
+#endif
+
+
+/**
+ * @brief This function partitions the whole grids into the parts of the processes and keeps the part of this process.
+ * @details The whole mesh and the initial data read by every process are replaced by those of its part:
+ *          - 'mv->cell_pt' are the cells of the part followed by the ghost cells, and the nodes are renumbered.
+ *          - 'config[3]' and 'mv->num_ghost' are the numbers of the cells and the ghost cells of the part.
+ *          - 'FV' are the initial data of the cells of the part.
+ *          - 'mv->bc' is halo_ghost_unstruct().
+ *
+ *          If the mesh is not renumbered by config[52], it is renumbered in the reverse Cuthill–McKee order.
+ *          The output in the file order (config[54]) and the cached geometry of the preprocessed mesh file (config[55])
+ *          are not available for the parts.
+ * @param[in,out] mv: Structure of meshing variable data.
+ * @param[in,out] FV: Structure of initial fluid variable data on the inner cells.
+ * @return     Whether there is an error (0: Success, 4: Too many processes for the grids).
+ */
+int halo_part_init_unstruct(struct mesh_var * mv, struct flu_var * FV)
+{
+#ifdef MPI_UNSTRUCT
+	const int num_cell = (int)config[3];
+	const int num_cell_ghost = mv->num_ghost + num_cell;
+	int k, j, l, c, p, q, n;
+
+	MPI_Comm_dup(MPI_COMM_WORLD, &hp.comm);
+	MPI_Comm_size(hp.comm, &hp.size);
+	MPI_Comm_rank(hp.comm, &hp.rank);
+	if (hp.size == 1)
+		return 0;
+	if (hp.size > num_cell)
+	    {
+		printf("Too many processes (%d) for the %d grid cells!\n", hp.size, num_cell);
+		return 4;
+	    }
+	// The geometry of the preprocessed mesh file is of the whole grids, and is computed again on the part.
+	FREE(mv->geom);
+	FREE(mv->cell_cell_csr);
+	if (mv->cell_perm == NULL)
+		mesh_reorder(mv, FV, 1);
+	int **cp = mv->cell_pt;
+	const int c0 = HALO_FIRST(hp.rank, num_cell), n_own = HALO_FIRST(hp.rank+1, num_cell) - c0;
+
+	// cells around each node
+	int * pt_off = (int *)CALLOC(mv->num_pt + 1, sizeof(int));
+	for(k = 0; k < num_cell_ghost; k++)
+		for(j = 1; j <= cp[k][0]; j++)
+			pt_off[cp[k][j]+1]++;
+	for(p = 0; p < mv->num_pt; p++)
+		pt_off[p+1] += pt_off[p];
+	int * pt_cell = (int *)ALLOC((pt_off[mv->num_pt] + 1) * sizeof(int));
+	int * fill    = (int *)CALLOC(mv->num_pt + 1, sizeof(int));
+	for(k = 0; k < num_cell_ghost; k++)
+		for(j = 1; j <= cp[k][0]; j++)
+		    {
+			p = cp[k][j];
+			pt_cell[pt_off[p] + fill[p]++] = k;
+		    }
+	FREE(fill);
+
+	// local serial numbers: the cells of the part, then the ghost cells in the ascending order
+	int * loc = (int *)ALLOC(num_cell_ghost * sizeof(int));
+	for(k = 0; k < num_cell_ghost; k++)
+		loc[k] = k >= c0 && k < c0 + n_own ? k - c0 : -1;
+	int n_ghost = 0;
+	for(k = c0; k < c0 + n_own; k++)
+		for(j = 1; j <= cp[k][0]; j++)
+		    {
+			p = cp[k][j];
+			q = cp[k][j == cp[k][0] ? 1 : j+1];
+			for(l = pt_off[p]; l < pt_off[p+1]; l++)
+			    {
+				c = pt_cell[l];
+				if (loc[c] == -1 && halo_has_pt(cp, c, q))
+				    {
+					loc[c] = -2; // marked ghost cell
+					n_ghost++;
+				    }
+			    }
+		    }
+	FREE(pt_off);
+	FREE(pt_cell);
+	const int n_loc = n_own + n_ghost;
+	int * glob = (int *)ALLOC((n_loc + 1) * sizeof(int)); // serial number in the whole grids of each local cell
+	for(k = 0; k < n_own; k++)
+		glob[k] = c0 + k;
+	for(k = 0, n = n_own; k < num_cell_ghost; k++)
+		if (loc[k] == -2)
+		    {
+			loc[k] = n;
+			glob[n++] = k;
+		    }
+
+	// ghost cells received from each process, in the ascending order of their local serial numbers
+	int * src = (int *)ALLOC((n_ghost + 1) * sizeof(int)); // source inner cell of each ghost cell
+	int * r_num = (int *)CALLOC(hp.size, sizeof(int)), * s_num = (int *)CALLOC(hp.size, sizeof(int));
+	for(k = 0; k < n_ghost; k++)
+	    {
+		c = glob[n_own+k];
+		src[k] = c < num_cell ? c : mv->period_cell[c];
+		r_num[halo_owner(src[k], num_cell)]++;
+	    }
+	MPI_Alltoall(r_num, 1, MPI_INT, s_num, 1, MPI_INT, hp.comm);
+	hp.r_off = (int *)CALLOC(hp.size + 1, sizeof(int));
+	hp.s_off = (int *)CALLOC(hp.size + 1, sizeof(int));
+	for(q = 0; q < hp.size; q++)
+	    {
+		hp.r_off[q+1] = hp.r_off[q] + r_num[q];
+		hp.s_off[q+1] = hp.s_off[q] + s_num[q];
+	    }
+	hp.r_cell = (int *)ALLOC((hp.r_off[hp.size] + 1) * sizeof(int));
+	hp.s_cell = (int *)ALLOC((hp.s_off[hp.size] + 1) * sizeof(int));
+	int * r_src = (int *)ALLOC((hp.r_off[hp.size] + 1) * sizeof(int));
+	memset(r_num, 0, hp.size * sizeof(int));
+	for(k = 0; k < n_ghost; k++)
+	    {
+		q = halo_owner(src[k], num_cell);
+		l = hp.r_off[q] + r_num[q]++;
+		hp.r_cell[l] = n_own + k;
+		r_src[l]     = src[k];
+	    }
+	// Each process is told which of its cells the others receive.
+	MPI_Alltoallv(r_src, r_num, hp.r_off, MPI_INT, hp.s_cell, s_num, hp.s_off, MPI_INT, hp.comm);
+	for(l = 0; l < hp.s_off[hp.size]; l++)
+		hp.s_cell[l] -= c0;
+	FREE(r_src);
+	FREE(src);
+	FREE(r_num);
+	FREE(s_num);
+	hp.buf_s = (double *)ALLOC((hp.s_off[hp.size] * HALO_MAX_NV + 1) * sizeof(double));
+	hp.buf_r = (double *)ALLOC((hp.r_off[hp.size] * HALO_MAX_NV + 1) * sizeof(double));
+	hp.req   = (MPI_Request *)ALLOC(2 * hp.size * sizeof(MPI_Request));
+
+	// mesh of the part with the nodes in the order of first use
+	int * pt_loc = (int *)ALLOC(mv->num_pt * sizeof(int));
+	for(p = 0; p < mv->num_pt; p++)
+		pt_loc[p] = -1;
+	int n_pt = 0, n_c = 0;
+	for(k = 0; k < n_loc; k++)
+	    {
+		c = glob[k];
+		n_c += cp[c][0] + 1;
+		for(j = 1; j <= cp[c][0]; j++)
+			if (pt_loc[cp[c][j]] < 0)
+				pt_loc[cp[c][j]] = n_pt++;
+	    }
+	double * X = (double *)ALLOC((n_pt + 1) * sizeof(double));
+	double * Y = (double *)ALLOC((n_pt + 1) * sizeof(double));
+	for(p = 0; p < mv->num_pt; p++)
+		if (pt_loc[p] >= 0)
+		    {
+			X[pt_loc[p]] = mv->X[p];
+			Y[pt_loc[p]] = mv->Y[p];
+		    }
+	int ** cp_l = (int **)ALLOC(n_loc * sizeof(int *));
+	int * block = (int *)ALLOC(n_c * sizeof(int));
+	for(k = 0, n_c = 0; k < n_loc; k++)
+	    {
+		c = glob[k];
+		cp_l[k] = block + n_c;
+		cp_l[k][0] = cp[c][0];
+		for(j = 1; j <= cp[c][0]; j++)
+			cp_l[k][j] = pt_loc[cp[c][j]];
+		n_c += cp[c][0] + 1;
+	    }
+	for(l = 1, n = 0; l <= mv->num_border[0]; l++)
+		n += mv->num_border[l] + 1;
+	for(k = 0; k < n; k++)
+		mv->border_pt[k] = pt_loc[mv->border_pt[k]]; // -1: a node out of the part
+	if (mv->cell_type != NULL)
+	    {
+		int * ct = (int *)ALLOC(n_loc * sizeof(int));
+		for(k = 0; k < n_loc; k++)
+			ct[k] = mv->cell_type[glob[k]];
+		FREE(mv->cell_type);
+		mv->cell_type = ct;
+	    }
+	FREE(pt_loc);
+	FREE(glob);
+	FREE(loc);
+
+	if (mv->cell_pt_csr != NULL)
+		FREE(mv->cell_pt_csr);
+	else
+		for(k = 0; k < num_cell_ghost; k++)
+			FREE(mv->cell_pt[k]);
+	FREE(mv->cell_pt);
+	FREE(mv->X);
+	FREE(mv->Y);
+	FREE(mv->period_cell);
+	FREE(mv->normal_v);
+	FREE(mv->cell_perm);
+	FREE(mv->pt_perm);
+	mv->cell_pt     = cp_l;
+	mv->cell_pt_csr = block;
+	mv->X           = X;
+	mv->Y           = Y;
+	mv->num_pt      = n_pt;
+	mv->num_ghost   = n_ghost;
+	mv->bc          = halo_ghost_unstruct;
+
+	HALO_FV_PART(RHO);
+	HALO_FV_PART(U);
+	HALO_FV_PART(V);
+	HALO_FV_PART(P);
+	if (FV->Y != NULL) // the rows of the species
+	    {
+		const int K = (int)config[71];
+		double * Y_p = (double *)malloc((size_t)K * n_own * sizeof(double));
+		if(Y_p == NULL)
+		    {
+			fprintf(stderr, "Not enough memory in the partition of the fluid variables!\n");
+			exit(5);
+		    }
+		for(l = 0; l < K; l++)
+			memcpy(Y_p + (size_t)l*n_own, FV->Y + (size_t)l*FV->n_Y + c0, n_own * sizeof(double));
+		free(FV->Y);
+		FV->Y   = Y_p;
+		FV->n_Y = n_own;
+	    }
+#ifdef MULTIFLUID_BASICS
+	HALO_FV_PART(Z_a);
+	HALO_FV_PART(PHI);
+	HALO_FV_PART(gamma);
+#ifdef MULTIPHASE_BASICS
+	HALO_FV_PART(RHO_b);
+	HALO_FV_PART(U_b);
+	HALO_FV_PART(V_b);
+	HALO_FV_PART(P_b);
+#endif
+#endif
+	config[3] = (double)n_own;
+
+	printf("The grids are partitioned into %d parts: part %d has %d cells and %d ghost cells.\n", hp.size, hp.rank, n_own, n_ghost);
+#else
+	(void)mv; (void)FV;
+#endif
+	return 0;
+}
+
+//! This function returns the rank of this process.
+int halo_rank_unstruct(void)
+{
+#ifdef MPI_UNSTRUCT
+	return hp.rank;
+#else
+	return 0;
+#endif
+}
+
+//! This function returns the number of the processes.
+int halo_size_unstruct(void)
+{
+#ifdef MPI_UNSTRUCT
+	return hp.size;
+#else
+	return 1;
+#endif
+}
+
+/**
+ * @brief This function frees the lists, the buffers and the communicator of the parts.
+ */
+void halo_part_free_unstruct(void)
+{
+#ifdef MPI_UNSTRUCT
+	FREE(hp.s_off);
+	FREE(hp.s_cell);
+	FREE(hp.r_off);
+	FREE(hp.r_cell);
+	FREE(hp.buf_s);
+	FREE(hp.buf_r);
+	FREE(hp.req);
+	if(hp.comm != MPI_COMM_NULL)
+		MPI_Comm_free(&hp.comm);
+#endif
+}
+
+/**
+ * @brief This function returns the global minimum of the values of the processes.
+ * @param[in] v: Value of this process.
+ */
+double halo_min_unstruct(double v)
+{
+#ifdef MPI_UNSTRUCT
+	if (hp.size > 1)
+		MPI_Allreduce(MPI_IN_PLACE, &v, 1, MPI_DOUBLE, MPI_MIN, hp.comm);
+#endif
+	return v;
+}
+
+/**
+ * @brief This function returns the global maximum of the values of the processes.
+ * @details It is used for the stop indicators, so that all processes stop together.
+ * @param[in] v: Value of this process.
+ */
+int halo_max_unstruct(int v)
+{
+#ifdef MPI_UNSTRUCT
+	if (hp.size > 1)
+		MPI_Allreduce(MPI_IN_PLACE, &v, 1, MPI_INT, MPI_MAX, hp.comm);
+#endif
+	return v;
+}
+
+#ifdef MPI_UNSTRUCT
+/**
+ * @brief This function exchanges the variables v[0..n_v-1] (n_v <= HALO_MAX_NV) of the ghost cells of the part.
+ * @details The messages of all the neighbouring parts are posted at once, and the source cells in this part
+ *          (at the periodic boundary) are copied while they are in flight.
+ */
+static void halo_swap_unstruct(double * const v[], const int n_v)
+{
+	int n_req = 0, q, l, m;
+
+	for(q = 0; q < hp.size; q++)
+		if (q != hp.rank && hp.r_off[q+1] > hp.r_off[q])
+			MPI_Irecv(hp.buf_r + hp.r_off[q]*n_v, (hp.r_off[q+1]-hp.r_off[q])*n_v, MPI_DOUBLE, q, 0, hp.comm, &hp.req[n_req++]);
+	for(l = 0; l < hp.s_off[hp.size]; l++)
+		for(m = 0; m < n_v; m++)
+			hp.buf_s[l*n_v + m] = v[m][hp.s_cell[l]];
+	for(q = 0; q < hp.size; q++)
+		if (q != hp.rank && hp.s_off[q+1] > hp.s_off[q])
+			MPI_Isend(hp.buf_s + hp.s_off[q]*n_v, (hp.s_off[q+1]-hp.s_off[q])*n_v, MPI_DOUBLE, q, 0, hp.comm, &hp.req[n_req++]);
+	// The cells of this part sent to itself are the sources of the ghost cells at the periodic boundary.
+	for(l = hp.r_off[hp.rank], q = hp.s_off[hp.rank]; l < hp.r_off[hp.rank+1]; l++, q++)
+		for(m = 0; m < n_v; m++)
+			v[m][hp.r_cell[l]] = v[m][hp.s_cell[q]];
+	MPI_Waitall(n_req, hp.req, MPI_STATUSES_IGNORE);
+	for(q = 0; q < hp.size; q++)
+		if (q != hp.rank)
+			for(l = hp.r_off[q]; l < hp.r_off[q+1]; l++)
+				for(m = 0; m < n_v; m++)
+					v[m][hp.r_cell[l]] = hp.buf_r[l*n_v + m];
+}
+#endif
+
+/**
+ * @brief This function fills the ghost cells of the part with the grid and fluid variables of their source cells.
+ * @details The variables are those copied by period_ghost(), and the rows of the species are exchanged
+ *          in the messages of at most HALO_MAX_NV rows after them.
+ * @param[in,out] cv: Structure of grid variable data in computational grid cells.
+ * @param[in]     mv: Structure of meshing variable data.
+ * @param[in,out] FV: Structure of fluid variable data array pointer.
+ * @param[in]     t:  Current computational time.
+ * @param[in]   part: Parts of the variables exchanged (enum ghost_part).
+ */
+void halo_ghost_unstruct(struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, const double t, const int part)
+{
+#ifdef MPI_UNSTRUCT
+	const int order = (int)config[9];
+	const int val = part & GHOST_VAL, grad = order > 1 && (part & GHOST_GRAD);
+	double * v[HALO_MAX_NV];
+	int n_v = 0, s;
+	(void)mv; (void)t;
+
+	if (val)
+	    {
+		v[n_v++] = cv->U_rho; v[n_v++] = cv->U_e; v[n_v++] = cv->U_u; v[n_v++] = cv->U_v;
+		v[n_v++] = FV->RHO;   v[n_v++] = FV->P;   v[n_v++] = FV->U;   v[n_v++] = FV->V;
+	    }
+	if (grad)
+	    {
+		v[n_v++] = cv->gradx_rho; v[n_v++] = cv->gradx_e; v[n_v++] = cv->gradx_u; v[n_v++] = cv->gradx_v;
+		v[n_v++] = cv->grady_rho; v[n_v++] = cv->grady_e; v[n_v++] = cv->grady_u; v[n_v++] = cv->grady_v;
+	    }
+#ifdef MULTIFLUID_BASICS
+	if (val)
+	    {
+		v[n_v++] = cv->U_e_a; v[n_v++] = cv->U_phi; v[n_v++] = cv->U_gamma;
+		v[n_v++] = FV->PHI;   v[n_v++] = FV->gamma; v[n_v++] = FV->Z_a;
+	    }
+	if (grad)
+	    {
+		v[n_v++] = cv->gradx_phi; v[n_v++] = cv->grady_phi;
+		v[n_v++] = cv->gradx_z_a; v[n_v++] = cv->grady_z_a;
+	    }
+#endif
+	if (n_v)
+		halo_swap_unstruct(v, n_v);
+
+	n_v = 0;
+	for(s = 0; FV->Y != NULL && s < (int)config[71]; s++)
+	    {
+		if (val)
+		    {
+			v[n_v++] = cv->U_Y + (size_t)s*FV->n_Y;
+			v[n_v++] = FV->Y   + (size_t)s*FV->n_Y;
+		    }
+		if (grad)
+		    {
+			v[n_v++] = cv->gradx_Y + (size_t)s*FV->n_Y;
+			v[n_v++] = cv->grady_Y + (size_t)s*FV->n_Y;
+		    }
+		if (n_v > HALO_MAX_NV - 4)
+		    {
+			halo_swap_unstruct(v, n_v);
+			n_v = 0;
+		    }
+	    }
+	if (n_v)
+		halo_swap_unstruct(v, n_v);
+#else
+	(void)cv; (void)mv; (void)FV; (void)t; (void)part;
+#endif
+}
@@ -6,122 +6,283 @@
 
 #include "../include/var_struc.h"
 #include "../include/tools.h"
+#ifdef _OPENACC
+#include <openacc.h>
+#endif
+
+
+#define LSQ_MAX_VAR 6 //!< Maximum number of the variables reconstructed together by lsq_limiter().
 
 
+ACC_ROUTINE_SEQ
 static inline double mu_BJ(double x)
 {
 	return (x<1.0?x:1.0);
 }
 
+ACC_ROUTINE_SEQ
 static inline double mu_Ven(double x)
 {
 	return ((x*x+2.0*x)/(x*x+x+2.0));
 }
 
+//! The limiter config[40] (0: Venkatakrishnan, 1: Barth-Jespersen) of the ratio x, lim = (int)config[40].
+#define MU_LIM(x) (lim ? mu_BJ(x) : mu_Ven(x))
 
-static void lsq_limiter(const struct cell_var * cv, const struct mesh_var * mv, 
-						double * grad_W_x, double * grad_W_y, double * W)
+
+/**
+ * @brief Compute the geometry of the least-squares reconstruction of the k-th inner cell.
+ * @details The normal equations only depend on the centroids of the cell and its neighbours,
+ *          their inverse matrix is stored in 'cv->lsq_inv[]' and the distances between the centroids in 'cv->lsq_d[]'.
+ * @param[in,out] cv: Structure of grid variable data in computational grid cells.
+ * @param[in]     k:  Serial number of the inner grid cell.
+ */
+void lsq_geom_cell(const struct cell_var * cv, const int k)
 {
-	const double eps = config[4];
-	const int num_cell = (int)config[3];
-	const int lim = (int)config[40]; //limiter
-	double (*mu[])(double) = { mu_Ven, mu_BJ };
-	
-	int **cp = mv->cell_pt;
-	int **cc = cv->cell_cell;
+	const int *cc = cv->cell_cell[0]; // flat (CSR) array
+	const int *off = cv->face_off;
 	const double *X_c = cv->X_c;
-	const double *Y_c = cv->Y_c;	
-	const double *X = mv->X;
-	const double *Y = mv->Y;
+	const double *Y_c = cv->Y_c;
 
 	int cell_R;
-	double tmp_x, tmp_y;
 	double M_c[2][2];
-	double W_c_min, W_c_max, W_c_x_p;
-	double fai_W;
-	int p_p,p_n;
-	
-	for(int k = 0; k < num_cell; ++k)
+	double dx, dy;
+
+	M_c[0][0] = 0.0;  M_c[0][1] = 0.0;
+	M_c[1][0] = 0.0;  M_c[1][1] = 0.0;
+
+	for(int f = off[k]; f < off[k+1]; f++)
 		{
-			M_c[0][0] = 0.0;  M_c[0][1] = 0.0;
-			M_c[1][0] = 0.0;  M_c[1][1] = 0.0;
-			grad_W_x[k] = 0.0;
-			grad_W_y[k] = 0.0;
+			if (cc[f] >= 0)
+				cell_R = cc[f];
+			else if (cc[f] == -1 || cc[f] == -2 || cc[f] == -3 || cc[f] == -4)
+				continue;
+			else
+				{
+					fprintf(stderr, "No suitable boundary!\n");
+					exit(2);
+				}
+
+			dx = X_c[cell_R] - X_c[k];
+			dy = Y_c[cell_R] - Y_c[k];
+			cv->lsq_d[2*f]   = dx;
+			cv->lsq_d[2*f+1] = dy;
+			M_c[0][0] += dx * dx;
+			M_c[0][1] += dx * dy;
+			M_c[1][0] += dy * dx;
+			M_c[1][1] += dy * dy;
+		}
+	//inverse
+	if(rinv(M_c[0], 2) == 0)
+		exit(3);
+	memcpy(cv->lsq_inv + 4*k, M_c[0], 4 * sizeof(double));
+}
+
+
+/**
+ * @brief Compute the geometry of the least-squares reconstruction of all the inner cells by lsq_geom_cell().
+ * @details It is computed once on the Eulerian grids.
+ *          Nothing is done if the least-squares procedure is not used (cv->lsq_inv == NULL).
+ * @param[in,out] cv: Structure of grid variable data in computational grid cells.
+ * @param[in]     mv: Structure of meshing variable data.
+ */
+void lsq_geom_comp(const struct cell_var * cv, const struct mesh_var * mv)
+{
+	const int num_cell = (int)config[3];
+	(void)mv;
 
-			for(int j = 0; j < cp[k][0]; j++)
+	if (cv->lsq_inv == NULL)
+		return;
+
+#pragma omp parallel for
+	for(int k = 0; k < num_cell; ++k)
+		lsq_geom_cell(cv, k);
+}
+
+
+#ifndef _OPENACC
+/**
+ * @brief Least-squares gradients of lsq_limiter() on the logically rectangular grids of quad_mesh() (mv->quad_nx > 0).
+ * @details The neighbours of the cell (i, j) are indexed implicitly, and the interfaces of the k-th cell are 4k, …, 4k+3,
+ *          in the same order as the relationships of cell_rel(), so that the gradients are the same as those of lsq_limiter().
+ */
+static void lsq_limiter_quad(const struct cell_var * cv, const struct mesh_var * mv, const int n_W,
+							 double * const grad_W_x[], double * const grad_W_y[], const double * const W[])
+{
+	const double eps = config[4];
+	const int lim = (int)config[40]; //limiter
+	const int n_x = mv->quad_nx, n_y = mv->quad_ny;
+
+	int nb[4], v;
+	const double *M_c, *d, *fg;
+	double g_x[LSQ_MAX_VAR], g_y[LSQ_MAX_VAR], tmp_x, tmp_y;
+	double W_c_min[LSQ_MAX_VAR], W_c_max[LSQ_MAX_VAR], W_c_x_p;
+	double fai_W[LSQ_MAX_VAR];
+#pragma omp parallel for private(nb, v, M_c, d, fg, g_x, g_y, tmp_x, tmp_y, W_c_min, W_c_max, W_c_x_p, fai_W)
+	for(int k = 0; k < n_x*n_y; ++k)
+		{
+			const int i = k % n_x, j = k / n_x;
+			nb[0] = j > 0     ? k - n_x : -1; // lower, right, upper and left neighbours
+			nb[1] = i < n_x-1 ? k + 1   : -1;
+			nb[2] = j < n_y-1 ? k + n_x : -1;
+			nb[3] = i > 0     ? k - 1   : -1;
+			for(v = 0; v < n_W; v++)
 				{
-					if (cc[k][j] >= 0)
-						cell_R = cc[k][j];
-					else if (cc[k][j] == -1 || cc[k][j] == -2 || cc[k][j] == -3 || cc[k][j] == -4)
+					g_x[v] = 0.0;
+					g_y[v] = 0.0;
+					W_c_min[v] = W[v][k];
+					W_c_max[v] = W[v][k];
+				}
+			for(int f = 0; f < 4; f++)
+				{
+					if (nb[f] < 0)
 						continue;
-					else
+					d = cv->lsq_d + 2*(4*k + f);
+					for(v = 0; v < n_W; v++)
+						{
+							g_x[v] += (W[v][nb[f]] - W[v][k]) * d[0];
+							g_y[v] += (W[v][nb[f]] - W[v][k]) * d[1];
+							if(W[v][nb[f]] < W_c_min[v])
+								W_c_min[v] = W[v][nb[f]];
+							else if(W[v][nb[f]] > W_c_max[v])
+								W_c_max[v] = W[v][nb[f]];
+						}
+				}
+			M_c = cv->lsq_inv + 4*k;
+			for(v = 0; v < n_W; v++)
+				{
+					tmp_x = M_c[0] * g_x[v] + M_c[1] * g_y[v];
+					tmp_y = M_c[2] * g_x[v] + M_c[3] * g_y[v];
+					g_x[v] = tmp_x;
+					g_y[v] = tmp_y;
+					fai_W[v] = 1.0;
+				}
+			for(int f = 0; f < 4; f++)
+				{
+					fg = cv->face_geom + FACE_GEOM * (4*k + f); // the midpoint of the interface
+					for(v = 0; v < n_W; v++)
 						{
-							fprintf(stderr, "No suitable boundary!\n");
-							exit(2);
+							W_c_x_p = W[v][k] + g_x[v] * fg[1] + g_y[v] * fg[2];
+							if (fabs(W_c_x_p - W[v][k]) < eps)
+								;
+							else if((W_c_x_p - W[v][k]) > 0.0)
+								fai_W[v] = fmin(fai_W[v], MU_LIM((W_c_max[v] - W[v][k])/(W_c_x_p - W[v][k])));
+							else
+								fai_W[v] = fmin(fai_W[v], MU_LIM((W_c_min[v] - W[v][k])/(W_c_x_p - W[v][k])));
 						}
-							
-					M_c[0][0] += (X_c[cell_R] - X_c[k]) * (X_c[cell_R] - X_c[k]);
-					M_c[0][1] += (X_c[cell_R] - X_c[k]) * (Y_c[cell_R] - Y_c[k]);
-					M_c[1][0] += (Y_c[cell_R] - Y_c[k]) * (X_c[cell_R] - X_c[k]);
-					M_c[1][1] += (Y_c[cell_R] - Y_c[k]) * (Y_c[cell_R] - Y_c[k]);
-					grad_W_x[k] += (W[cell_R] - W[k]) * (X_c[cell_R] - X_c[k]);
-					grad_W_y[k] += (W[cell_R] - W[k]) * (Y_c[cell_R] - Y_c[k]);
-				}		
-			//inverse
-			if(rinv(M_c[0], 2) == 0)
-				exit(3);
-
-			tmp_x = M_c[0][0] * grad_W_x[k] + M_c[0][1] * grad_W_y[k];
-			tmp_y = M_c[1][0] * grad_W_x[k] + M_c[1][1] * grad_W_y[k];
-			grad_W_x[k] = tmp_x;
-			grad_W_y[k] = tmp_y;
+				}
+			for(v = 0; v < n_W; v++)
+				{
+					grad_W_x[v][k] = g_x[v] * fai_W[v];
+					grad_W_y[v][k] = g_y[v] * fai_W[v];
+				}
 		}
+}
+#endif
+
 
+/**
+ * @brief Least-squares gradients of the variables W[0..n_W-1] limited by the limiter config[40].
+ * @details All the variables are reconstructed in one pass over the neighbours of each cell,
+ *          with the geometry computed by lsq_geom_comp() and the interfacial midpoints in 'cv->face_geom'.
+ *          On the logically rectangular grids, the neighbours are indexed implicitly by lsq_limiter_quad().
+ */
+static void lsq_limiter(const struct cell_var * cv, const struct mesh_var * mv, const int n_W,
+						double * const grad_W_x[], double * const grad_W_y[], const double * const W[])
+{
+#ifndef _OPENACC
+	if (mv->quad_nx > 0)
+		{
+			lsq_limiter_quad(cv, mv, n_W, grad_W_x, grad_W_y, W);
+			return;
+		}
+#endif
+	const double eps = config[4];
+	const int num_cell = (int)config[3];
+	const int lim = (int)config[40]; //limiter
+	
+	const int *cc = cv->cell_cell[0]; // flat (CSR) array
+	const int *off = cv->face_off;
+
+	int cell_R, v;
+	const double *M_c, *d, *fg;
+	double g_x[LSQ_MAX_VAR], g_y[LSQ_MAX_VAR], tmp_x, tmp_y;
+	double W_c_min[LSQ_MAX_VAR], W_c_max[LSQ_MAX_VAR], W_c_x_p;
+	double fai_W[LSQ_MAX_VAR];
+	double * gW_x[LSQ_MAX_VAR], * gW_y[LSQ_MAX_VAR]; // the variables in the loop (their addresses on the device of OpenACC)
+	const double * Wv[LSQ_MAX_VAR];
+	for(v = 0; v < n_W; v++)
+		{
+#ifdef _OPENACC
+			gW_x[v] = (double *)acc_deviceptr(grad_W_x[v]);
+			gW_y[v] = (double *)acc_deviceptr(grad_W_y[v]);
+			Wv[v]   = (const double *)acc_deviceptr((void *)W[v]);
+#else
+			gW_x[v] = grad_W_x[v];
+			gW_y[v] = grad_W_y[v];
+			Wv[v]   = W[v];
+#endif
+		}
+	
+#ifdef _OPENACC
+#pragma acc parallel loop firstprivate(gW_x, gW_y, Wv) private(cell_R, v, M_c, d, fg, g_x, g_y, tmp_x, tmp_y, W_c_min, W_c_max, W_c_x_p, fai_W) \
+	present(cv[0:1], cc[0:off[num_cell]], off[0:num_cell+1]) default(present)
+#else
+#pragma omp parallel for private(cell_R, v, M_c, d, fg, g_x, g_y, tmp_x, tmp_y, W_c_min, W_c_max, W_c_x_p, fai_W)
+#endif
 	for(int k = 0; k < num_cell; ++k)
 		{
-			W_c_min = W[k];
-			W_c_max = W[k];
-			for(int j = 0; j < cp[k][0]; ++j)
+			for(v = 0; v < n_W; v++)
+				{
+					g_x[v] = 0.0;
+					g_y[v] = 0.0;
+					W_c_min[v] = Wv[v][k];
+					W_c_max[v] = Wv[v][k];
+				}
+			for(int f = off[k]; f < off[k+1]; f++)
 				{
-					if (cc[k][j] >= 0)
-						cell_R = cc[k][j];
-					else if (cc[k][j] == -1 || cc[k][j] == -2 || cc[k][j] == -3 || cc[k][j] == -4)
+					cell_R = cc[f];
+					if (cell_R < 0) // The boundaries are checked by lsq_geom_comp().
 						continue;
-					else
+					d = cv->lsq_d + 2*f;
+					for(v = 0; v < n_W; v++)
 						{
-							printf("No suitable boundary!\n");
-							exit(2);
+							g_x[v] += (Wv[v][cell_R] - Wv[v][k]) * d[0];
+							g_y[v] += (Wv[v][cell_R] - Wv[v][k]) * d[1];
+							if(Wv[v][cell_R] < W_c_min[v])
+								W_c_min[v] = Wv[v][cell_R];
+							else if(Wv[v][cell_R] > W_c_max[v])
+								W_c_max[v] = Wv[v][cell_R];
 						}
-							
-					if(W[cell_R] < W_c_min)
-						W_c_min = W[cell_R];
-					else if(W[cell_R] > W_c_max)
-						W_c_max = W[cell_R];
 				}
-			fai_W = 1.0;
-			for(int j = 0; j < cp[k][0]; ++j)
+			M_c = cv->lsq_inv + 4*k;
+			for(v = 0; v < n_W; v++)
 				{
-					if(j == cp[k][0]-1) 
-						{
-							p_p=cp[k][1];
-							p_n=cp[k][j+1];
-						}  
-					else
+					tmp_x = M_c[0] * g_x[v] + M_c[1] * g_y[v];
+					tmp_y = M_c[2] * g_x[v] + M_c[3] * g_y[v];
+					g_x[v] = tmp_x;
+					g_y[v] = tmp_y;
+					fai_W[v] = 1.0;
+				}
+			for(int f = off[k]; f < off[k+1]; f++)
+				{
+					fg = cv->face_geom + FACE_GEOM * f; // the midpoint of the interface
+					for(v = 0; v < n_W; v++)
 						{
-							p_p=cp[k][j+2];
-							p_n=cp[k][j+1];
+							W_c_x_p = Wv[v][k] + g_x[v] * fg[1] + g_y[v] * fg[2];
+							if (fabs(W_c_x_p - Wv[v][k]) < eps)
+								;
+							else if((W_c_x_p - Wv[v][k]) > 0.0)
+								fai_W[v] = fmin(fai_W[v], MU_LIM((W_c_max[v] - Wv[v][k])/(W_c_x_p - Wv[v][k])));
+							else
+								fai_W[v] = fmin(fai_W[v], MU_LIM((W_c_min[v] - Wv[v][k])/(W_c_x_p - Wv[v][k])));
 						}
-					//					W_c_x_p = W[k] + grad_W_x[k] * (X[cp[k][j+1]] - X_c[k]) + grad_W_y[k] * (Y[cp[k][j+1]] - Y_c[k]);
-					W_c_x_p = W[k] + grad_W_x[k] * (0.5*(X[p_p]+X[p_n]) - X_c[k]) + grad_W_y[k] * (0.5*(Y[p_p]+Y[p_n]) - Y_c[k]);	
-					if (fabs(W_c_x_p - W[k]) < eps)
-						;	
-					else if((W_c_x_p - W[k]) > 0.0)
-						fai_W = fmin(fai_W, mu[lim]((W_c_max - W[k])/(W_c_x_p - W[k])));
-					else
-						fai_W = fmin(fai_W, mu[lim]((W_c_min - W[k])/(W_c_x_p - W[k])));
 				}
-			grad_W_x[k] = grad_W_x[k] * fai_W;
-			grad_W_y[k] = grad_W_y[k] * fai_W;
+			for(v = 0; v < n_W; v++)
+				{
+					gW_x[v][k] = g_x[v] * fai_W[v];
+					gW_y[v][k] = g_y[v] * fai_W[v];
+				}
 		}
 }
 
@@ -133,46 +294,40 @@ static void minmod_limiter_2D(const struct cell_var * cv, const struct mesh_var
 	// const double eps = config[4];
 	const int num_cell = (int)config[3];
 	double alpha = config[41];
-	int **cc = cv->cell_cell;
+	const int *cc = cv->cell_cell[0]; // flat (CSR) array
 	int **cp = mv->cell_pt;
 
-	int cell_R, p_p, p_n;
+	int cell_R, p_p, p_n, f;
 	double grad_W_tmp = 0.0;
+#pragma omp parallel for private(cell_R, p_p, p_n, f) firstprivate(grad_W_tmp)
 	for(int k = 0; k < num_cell; k++)
 		{
 			for(int j = 0; j < 4 ;j++)
 				{
+					f = CSR_FACE(cv, k, j);
 					if (j == 1 || j == 3)
 						{
-							if (cc[k][j] >= 0)
+							if (cc[f] >= 0)
 								{
-									cell_R = cc[k][j];
+									cell_R = cc[f];
 									grad_W_tmp = alpha*(W[cell_R] - W[k]) / (cv->X_c[cell_R] - cv->X_c[k]);
 								}
-							else if (cc[k][j] == -1 || cc[k][j] == -3 || cc[k][j] == -4)
+							else if (cc[f] == -1 || cc[f] == -3 || cc[f] == -4)
 								grad_W_tmp = 0.0;
-							else if (cc[k][j] == -2)
+							else if (cc[f] == -2)
 								{
 									if (isUorV == 0 || isUorV == -1)
 										grad_W_tmp = 0.0;
 									else if (isUorV == 1)
 										{
-											if(j == cp[k][0]-1) 
-												{
-													p_p=cp[k][1];
-													p_n=cp[k][j+1];
-												}  
-											else
-												{
-													p_p=cp[k][j+2];
-													p_n=cp[k][j+1];
-												}
+											p_p = CSR_PT_P(cp, k, j);
+											p_n = CSR_PT_N(cp, k, j);
 											grad_W_tmp = alpha*W[k] / (cv->X_c[k] - 0.5*(mv->X[p_p]+mv->X[p_n]));
 										}
 								}
 							else
 								{
-									fprintf(stderr, "No suitable boundary!cc = %d,%d,%d\n",cc[k][j],k,j);
+									fprintf(stderr, "No suitable boundary!cc = %d,%d,%d\n",cc[f],k,j);
 									exit(2);
 								}
 							if (isinf(gradx_W[k]))
@@ -197,35 +352,27 @@ static void minmod_limiter_2D(const struct cell_var * cv, const struct mesh_var
 						}
 					else
 						{
-							if (cc[k][j] >= 0)
+							if (cc[f] >= 0)
 								{
-									cell_R = cc[k][j];
+									cell_R = cc[f];
 									grad_W_tmp = alpha*(W[cell_R] - W[k]) / (cv->Y_c[cell_R] - cv->Y_c[k]);
 								}
-							else if (cc[k][j] == -1 || cc[k][j] == -3 || cc[k][j] == -4)
+							else if (cc[f] == -1 || cc[f] == -3 || cc[f] == -4)
 								grad_W_tmp = 0.0;
-							else if (cc[k][j] == -2)
+							else if (cc[f] == -2)
 								{
 									if (isUorV == 0 || isUorV == 1)
 										grad_W_tmp = 0.0;
 									else if (isUorV == -1)
 										{
-											if(j == cp[k][0]-1) 
-												{
-													p_p=cp[k][1];
-													p_n=cp[k][j+1];
-												}
-											else
-												{
-													p_p=cp[k][j+2];
-													p_n=cp[k][j+1];
-												}
+											p_p = CSR_PT_P(cp, k, j);
+											p_n = CSR_PT_N(cp, k, j);
 											grad_W_tmp = alpha*W[k] / (cv->Y_c[k] - 0.5*(mv->Y[p_p]+mv->Y[p_n]));
 										}
 								}
 							else
 								{
-									fprintf(stderr, "No suitable boundary!cc = %d,%d,%d\n",cc[k][j],k,j);
+									fprintf(stderr, "No suitable boundary!cc = %d,%d,%d\n",cc[f],k,j);
 									exit(2);
 								}
 							if (isinf(grady_W[k]))
@@ -253,27 +400,76 @@ static void minmod_limiter_2D(const struct cell_var * cv, const struct mesh_var
 }
 
 
+/**
+ * @brief Limited gradients of the mass fractions of the species, row by row of the block 'FV->Y'.
+ * @details With the least-squares procedure (30=1), the species are reconstructed LSQ_MAX_VAR rows in a pass;
+ *          otherwise each row is limited by the minmod of the one-sided differences on the quadrilateral cells.
+ */
+static void slope_limiter_species(const struct cell_var * cv, const struct mesh_var * mv, const struct flu_var * FV)
+{
+    const int K = FV->Y != NULL ? (int)config[71] : 0;
+    const int num_cell = (int)config[3];
+    const size_t n = (size_t)FV->n_Y;
+    double * gx[LSQ_MAX_VAR], * gy[LSQ_MAX_VAR];
+    const double * W[LSQ_MAX_VAR];
+    int s, v;
+
+    if ((int)config[30] == 1)
+	for(s = 0; s < K; s += LSQ_MAX_VAR)
+	    {
+		for(v = 0; v < LSQ_MAX_VAR && s + v < K; v++)
+		    {
+			gx[v] = cv->gradx_Y + (s+v)*n;
+			gy[v] = cv->grady_Y + (s+v)*n;
+			W[v]  = FV->Y + (s+v)*n;
+		    }
+		lsq_limiter(cv, mv, v, gx, gy, W);
+	    }
+    else if ((int)config[30] == 0)
+	for(s = 0; s < K; s++)
+	    {
+		for(int k = 0; k < num_cell; k++)
+		    {
+			cv->gradx_Y[s*n+k] = INFINITY;
+			cv->grady_Y[s*n+k] = INFINITY;
+		    }
+		minmod_limiter_2D(cv, mv, cv->gradx_Y + s*n, cv->grady_Y + s*n, FV->Y + s*n, 0);
+	    }
+}
+
+
 void slope_limiter_prim(const struct cell_var * cv,const struct mesh_var * mv, const struct flu_var * FV, const int i)
 {
     const int num_cell = (int)config[3];
-    int **cc = cv->cell_cell;
+    const int *cc = cv->cell_cell[0]; // flat (CSR) array
+    int f;
 
     if ((int)config[30] == 1)
 	{
-	    lsq_limiter(cv, mv, cv->gradx_rho, cv->grady_rho, FV->RHO);
-	    lsq_limiter(cv, mv, cv->gradx_e,   cv->grady_e,   FV->P);
-	    lsq_limiter(cv, mv, cv->gradx_u,   cv->grady_u,   FV->U);
-	    lsq_limiter(cv, mv, cv->gradx_v,   cv->grady_v,   FV->V);
+	    double * const gx[] = {cv->gradx_rho, cv->gradx_e, cv->gradx_u, cv->gradx_v,
+#ifdef MULTIFLUID_BASICS
+				   cv->gradx_phi, cv->gradx_z_a,
+#endif
+	    };
+	    double * const gy[] = {cv->grady_rho, cv->grady_e, cv->grady_u, cv->grady_v,
+#ifdef MULTIFLUID_BASICS
+				   cv->grady_phi, cv->grady_z_a,
+#endif
+	    };
+	    const double * const W[] = {FV->RHO, FV->P, FV->U, FV->V,
 #ifdef MULTIFLUID_BASICS
-	    lsq_limiter(cv, mv, cv->gradx_phi, cv->grady_phi, FV->PHI);
-	    lsq_limiter(cv, mv, cv->gradx_z_a, cv->grady_z_a, FV->Z_a);
+					FV->PHI, FV->Z_a,
 #endif
+	    };
+	    lsq_limiter(cv, mv, (int)(sizeof(W)/sizeof(W[0])), gx, gy, W);
 	}
     else if ((int)config[30] == 0)
 	{
+#pragma omp parallel for private(f)
 	    for(int k = 0; k < num_cell; k++)
 		{
-		    if (cc[k][0] < 0 || cc[k][1] < 0 || cc[k][2] < 0 || cc[k][3] < 0)
+		    f = CSR_FACE(cv, k, 0);
+		    if (cc[f] < 0 || cc[f+1] < 0 || cc[f+2] < 0 || cc[f+3] < 0)
 			{
 			    cv->gradx_u[k]   = INFINITY;
 			    cv->grady_u[k]   = INFINITY;
@@ -290,36 +486,36 @@ void slope_limiter_prim(const struct cell_var * cv,const struct mesh_var * mv, c
 			}
 		    else if(i == 0)
 			{
-			    cv->gradx_rho[k] = (FV->RHO[cc[k][1]] - FV->RHO[cc[k][3]]) /config[10]/2.0;
-			    cv->grady_rho[k] = (FV->RHO[cc[k][2]] - FV->RHO[cc[k][0]]) /config[11]/2.0;
-			    cv->gradx_u[k]   = (FV->U[cc[k][1]]   - FV->U[cc[k][3]])   /config[10]/2.0;
-			    cv->grady_u[k]   = (FV->U[cc[k][2]]   - FV->U[cc[k][0]])   /config[11]/2.0;
-			    cv->gradx_v[k]   = (FV->V[cc[k][1]]   - FV->V[cc[k][3]])   /config[10]/2.0;
-			    cv->grady_v[k]   = (FV->V[cc[k][2]]   - FV->V[cc[k][0]])   /config[11]/2.0;
-			    cv->gradx_e[k]   = (FV->P[cc[k][1]]   - FV->P[cc[k][3]])   /config[10]/2.0;
-			    cv->grady_e[k]   = (FV->P[cc[k][2]]   - FV->P[cc[k][0]])   /config[11]/2.0;
+			    cv->gradx_rho[k] = (FV->RHO[cc[f+1]] - FV->RHO[cc[f+3]]) /config[10]/2.0;
+			    cv->grady_rho[k] = (FV->RHO[cc[f+2]] - FV->RHO[cc[f]]) /config[11]/2.0;
+			    cv->gradx_u[k]   = (FV->U[cc[f+1]]   - FV->U[cc[f+3]])   /config[10]/2.0;
+			    cv->grady_u[k]   = (FV->U[cc[f+2]]   - FV->U[cc[f]])   /config[11]/2.0;
+			    cv->gradx_v[k]   = (FV->V[cc[f+1]]   - FV->V[cc[f+3]])   /config[10]/2.0;
+			    cv->grady_v[k]   = (FV->V[cc[f+2]]   - FV->V[cc[f]])   /config[11]/2.0;
+			    cv->gradx_e[k]   = (FV->P[cc[f+1]]   - FV->P[cc[f+3]])   /config[10]/2.0;
+			    cv->grady_e[k]   = (FV->P[cc[f+2]]   - FV->P[cc[f]])   /config[11]/2.0;
 #ifdef MULTIFLUID_BASICS
-			    cv->gradx_phi[k] = (FV->PHI[cc[k][1]] - FV->PHI[cc[k][3]])/config[10];
-			    cv->grady_phi[k] = (FV->PHI[cc[k][2]] - FV->PHI[cc[k][0]])/config[11];
-			    cv->gradx_z_a[k] = (FV->Z_a[cc[k][1]] - FV->Z_a[cc[k][3]])/config[10];
-			    cv->grady_z_a[k] = (FV->Z_a[cc[k][2]] - FV->Z_a[cc[k][0]])/config[11];
+			    cv->gradx_phi[k] = (FV->PHI[cc[f+1]] - FV->PHI[cc[f+3]])/config[10];
+			    cv->grady_phi[k] = (FV->PHI[cc[f+2]] - FV->PHI[cc[f]])/config[11];
+			    cv->gradx_z_a[k] = (FV->Z_a[cc[f+1]] - FV->Z_a[cc[f+3]])/config[10];
+			    cv->grady_z_a[k] = (FV->Z_a[cc[f+2]] - FV->Z_a[cc[f]])/config[11];
 #endif
 			}
 		    else
 			{
-			    cv->gradx_rho[k] = (cv->RHO_p[k][1] - cv->RHO_p[k][3])/config[10];
-			    cv->grady_rho[k] = (cv->RHO_p[k][2] - cv->RHO_p[k][0])/config[11];
-			    cv->gradx_u[k]   = (cv->U_p[k][1]   - cv->U_p[k][3])  /config[10];
-			    cv->grady_u[k]   = (cv->U_p[k][2]   - cv->U_p[k][0])  /config[11];
-			    cv->gradx_v[k]   = (cv->V_p[k][1]   - cv->V_p[k][3])  /config[10];
-			    cv->grady_v[k]   = (cv->V_p[k][2]   - cv->V_p[k][0])  /config[11];
-			    cv->gradx_e[k]   = (cv->P_p[k][1]   - cv->P_p[k][3])  /config[10];
-			    cv->grady_e[k]   = (cv->P_p[k][2]   - cv->P_p[k][0])  /config[11];
+			    cv->gradx_rho[k] = (cv->RHO_p[0][f+1] - cv->RHO_p[0][f+3])/config[10];
+			    cv->grady_rho[k] = (cv->RHO_p[0][f+2] - cv->RHO_p[0][f])/config[11];
+			    cv->gradx_u[k]   = (cv->U_p[0][f+1]   - cv->U_p[0][f+3])  /config[10];
+			    cv->grady_u[k]   = (cv->U_p[0][f+2]   - cv->U_p[0][f])  /config[11];
+			    cv->gradx_v[k]   = (cv->V_p[0][f+1]   - cv->V_p[0][f+3])  /config[10];
+			    cv->grady_v[k]   = (cv->V_p[0][f+2]   - cv->V_p[0][f])  /config[11];
+			    cv->gradx_e[k]   = (cv->P_p[0][f+1]   - cv->P_p[0][f+3])  /config[10];
+			    cv->grady_e[k]   = (cv->P_p[0][f+2]   - cv->P_p[0][f])  /config[11];
 #ifdef MULTIFLUID_BASICS
-			    cv->gradx_phi[k] = (cv->PHI_p[k][1] - cv->PHI_p[k][3])/config[10];
-			    cv->grady_phi[k] = (cv->PHI_p[k][2] - cv->PHI_p[k][0])/config[11];
-			    cv->gradx_z_a[k] = (cv->Z_a_p[k][1] - cv->Z_a_p[k][3])/config[10];
-			    cv->grady_z_a[k] = (cv->Z_a_p[k][2] - cv->Z_a_p[k][0])/config[11];	
+			    cv->gradx_phi[k] = (cv->PHI_p[0][f+1] - cv->PHI_p[0][f+3])/config[10];
+			    cv->grady_phi[k] = (cv->PHI_p[0][f+2] - cv->PHI_p[0][f])/config[11];
+			    cv->gradx_z_a[k] = (cv->Z_a_p[0][f+1] - cv->Z_a_p[0][f+3])/config[10];
+			    cv->grady_z_a[k] = (cv->Z_a_p[0][f+2] - cv->Z_a_p[0][f])/config[11];	
 #endif
 			}
 		}
@@ -332,4 +528,5 @@ void slope_limiter_prim(const struct cell_var * cv,const struct mesh_var * mv, c
 	    minmod_limiter_2D(cv, mv, cv->gradx_z_a, cv->grady_z_a, FV->Z_a, 0);
 #endif
 	}
+    slope_limiter_species(cv, mv, FV);
 }
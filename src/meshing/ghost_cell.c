@@ -10,77 +10,114 @@
 
 #include "../include_cii/mem.h"
 #include "../include/var_struc.h"
+#ifdef _OPENACC
+#include <openacc.h>
+#endif
+
+
+//! The maximum number of the variables gathered together onto the ghost cells.
+#define GHOST_MAX_NV 32
 
 
 /**
- * @brief Copy the grid variable data on the corresponding cell to the i-th ghost cell.
- */
-#define CV_COPY(var)  cv->var[i] = cv->var[pc[i]]
-/**
- * @brief Copy the fluid variable data on the corresponding cell to the i-th ghost cell.
+ * @brief Gather the n_v variables 'v' of the corresponding cells 'pc' onto the ghost cells.
+ * @details The ghost cells are the last ones, after period_cell_modify(), so that each variable is
+ *          a gather of the flat map 'pc' over the ghost cells. On the device of OpenACC, the addresses
+ *          of the variables on the device are gathered onto in one loop over the ghost cells.
  */
-#define FV_COPY(var)  FV->var[i] = FV->var[pc[i]]
-
+static void ghost_gather(double * const v[], const int n_v, const int * pc, const int num_cell, const int num_cell_ghost)
+{
+	int i, n;
+#ifdef _OPENACC
+	double * vd[GHOST_MAX_NV]; // the addresses of the variables on the device
+	for(n = 0; n < n_v; n++)
+		vd[n] = (double *)acc_deviceptr(v[n]);
+#pragma acc parallel loop firstprivate(vd) private(n) present(pc[0:num_cell_ghost])
+	for(i = num_cell; i < num_cell_ghost; i++)
+		for(n = 0; n < n_v; n++)
+			vd[n][i] = vd[n][pc[i]];
+#else
+	for(n = 0; n < n_v; n++)
+		{
+			double * const a = v[n];
+#pragma omp simd
+			for(i = num_cell; i < num_cell_ghost; i++)
+				a[i] = a[pc[i]];
+		}
+#endif
+}
 
 /**
- * @brief Copy the grid and fluid variable data in struct 'cv' and 'FV' on the corresponding cell to the i-th ghost cell.
- * @param[in] cv: Structure of grid variable data in computational grid cells.
- * @param[in] mv: Structure of meshing variable data.
- * @param[in] FV: Structure of fluid variable data array pointer.
- * @param[in] t:  Current computational time.
+ * @brief Copy the grid and fluid variable data in struct 'cv' and 'FV' on the corresponding cell to the ghost cells.
+ * @details The values are needed by the reconstruction, and the slopes of the reconstruction by the fluxes,
+ *          so that the parts of the variables are filled separately before and after the reconstruction.
+ * @param[in] cv:   Structure of grid variable data in computational grid cells.
+ * @param[in] mv:   Structure of meshing variable data.
+ * @param[in] FV:   Structure of fluid variable data array pointer.
+ * @param[in] t:    Current computational time.
+ * @param[in] part: Parts of the variables copied (enum ghost_part).
  */
-void period_ghost(struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, const double t)
+void period_ghost(struct cell_var * cv, const struct mesh_var * mv, struct flu_var * FV, const double t, const int part)
 {
 	const int order = (int)config[9];
 	const int num_cell = (int)config[3];
 	const int num_cell_ghost = mv->num_ghost + num_cell;
-	const int *pc = mv->period_cell;
-	
-	for(int i = num_cell; i < num_cell_ghost; i++)
-		{
-			CV_COPY(U_rho);			
-			CV_COPY(U_e);
-			CV_COPY(U_u);
-			CV_COPY(U_v);
-			FV_COPY(RHO);
-			FV_COPY(P);
-			FV_COPY(U);
-			FV_COPY(V);
-			if (order > 1)
-			    {
-				CV_COPY(gradx_rho);
-				CV_COPY(gradx_e);
-				CV_COPY(gradx_u);
-				CV_COPY(gradx_v);
-				CV_COPY(grady_rho);
-				CV_COPY(grady_e);
-				CV_COPY(grady_u);
-				CV_COPY(grady_v);
-			    }
+	const int val = part & GHOST_VAL, grad = order > 1 && (part & GHOST_GRAD);
+	double * v[GHOST_MAX_NV];
+	int n_v = 0;
+	(void)t;
+
+	if (val)
+	    {
+		v[n_v++] = cv->U_rho; v[n_v++] = cv->U_e; v[n_v++] = cv->U_u; v[n_v++] = cv->U_v;
+		v[n_v++] = FV->RHO;   v[n_v++] = FV->P;   v[n_v++] = FV->U;   v[n_v++] = FV->V;
+	    }
+	if (grad)
+	    {
+		v[n_v++] = cv->gradx_rho; v[n_v++] = cv->gradx_e; v[n_v++] = cv->gradx_u; v[n_v++] = cv->gradx_v;
+		v[n_v++] = cv->grady_rho; v[n_v++] = cv->grady_e; v[n_v++] = cv->grady_u; v[n_v++] = cv->grady_v;
+	    }
 #ifdef MULTIFLUID_BASICS
-			CV_COPY(U_e_a);
-			CV_COPY(U_phi);
-			CV_COPY(U_gamma);
-			FV_COPY(PHI);
-			FV_COPY(gamma);
-			if (order > 1)
-			    {
-				CV_COPY(gradx_phi);
-				CV_COPY(grady_phi);
-			    }
-			FV_COPY(Z_a);
-			if (order > 1)
-			    {
-				CV_COPY(gradx_z_a);
-				CV_COPY(grady_z_a);
-			    }
+	if (val)
+	    {
+		v[n_v++] = cv->U_e_a; v[n_v++] = cv->U_phi; v[n_v++] = cv->U_gamma;
+		v[n_v++] = FV->PHI;   v[n_v++] = FV->gamma; v[n_v++] = FV->Z_a;
+	    }
+	if (grad)
+	    {
+		v[n_v++] = cv->gradx_phi; v[n_v++] = cv->grady_phi;
+		v[n_v++] = cv->gradx_z_a; v[n_v++] = cv->grady_z_a;
+	    }
 #endif
-		}
+	// the rows of the species
+	for(int s = 0; FV->Y != NULL && s < (int)config[71]; s++)
+	    {
+		if (n_v > GHOST_MAX_NV - 4)
+		    {
+			ghost_gather(v, n_v, mv->period_cell, num_cell, num_cell_ghost);
+			n_v = 0;
+		    }
+		const size_t r = (size_t)s*FV->n_Y;
+		if (val)
+		    {
+			v[n_v++] = cv->U_Y + r;
+			v[n_v++] = FV->Y   + r;
+		    }
+		if (grad)
+		    {
+			v[n_v++] = cv->gradx_Y + r;
+			v[n_v++] = cv->grady_Y + r;
+		    }
+	    }
+	if (n_v)
+		ghost_gather(v, n_v, mv->period_cell, num_cell, num_cell_ghost);
 }
 
 
 /**
  * @brief Recount 'mv->cell_pt' according to the grid cell on the periodic boundary 'mv->period_cell'.
+ * @details The ghost cells are moved after the inner cells, so that 'mv->period_cell' of the ghost cells
+ *          is the flat map of their corresponding cells, which is gathered by period_ghost() without any search.
  * @param[in] mv: Structure of meshing variable data.
  */
 void period_cell_modify(struct mesh_var * mv)
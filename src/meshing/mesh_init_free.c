@@ -66,25 +66,101 @@ static void cell_pt_clockwise(const struct mesh_var * mv)
 }
 
 
+/**
+ * @brief This function keeps the tag 'mv->quad_nx/ny' of the logically rectangular grids only if the nodes of
+ *        every cell are still in the order of quad_mesh(), which gives the implicit relationships between the cells.
+ * @param[in,out] mv: Structure of meshing variable data.
+ */
+static void cell_pt_quad(struct mesh_var * mv)
+{
+	const int n_x = mv->quad_nx, n_y = mv->quad_ny;
+	int **cp = mv->cell_pt;
+	int k, p;
+
+	if (n_x <= 0 || n_y <= 0)
+	    return;
+	for(k = 0; k < n_x*n_y; k++)
+	    {
+		p = k + k/n_x; // the lower left node
+		if (cp[k][0] != 4 || cp[k][1] != p || cp[k][2] != p+1 || cp[k][3] != p+n_x+2 || cp[k][4] != p+n_x+1)
+		    {
+			mv->quad_nx = mv->quad_ny = 0;
+			return;
+		    }
+	    }
+}
+
+
+/**
+ * @brief This function stores the rows of 'mv->cell_pt' consecutively in one block (compressed sparse row).
+ * @details The block is kept in 'mv->cell_pt_csr', and the row pointers 'mv->cell_pt[k]' point into it.
+ *          The rows allocated one by one, or the previous block, are freed.
+ *          The cached relationships 'mv->cell_cell_csr' in the layout of the previous block follow the rows.
+ *          It is called again after the rows are permuted, so that the block is in the order of the cells.
+ * @param[in,out] mv: Structure of meshing variable data.
+ */
+void cell_pt_csr(struct mesh_var * mv)
+{
+	const int num_cell = mv->num_ghost + (int)config[3];
+	int **cp = mv->cell_pt;
+	int *block, *cc = NULL;
+	int k, n;
+
+	for(k = 0, n = 0; k < num_cell; k++)
+	    n += cp[k][0] + 1;
+	block = (int *)ALLOC(n * sizeof(int));
+	if (mv->cell_cell_csr != NULL)
+	    cc = (int *)ALLOC(n * sizeof(int));
+	for(k = 0, n = 0; k < num_cell; k++)
+	    {
+		memcpy(block + n, cp[k], (cp[k][0] + 1) * sizeof(int));
+		if (cc != NULL)
+		    memcpy(cc + n, mv->cell_cell_csr + (cp[k] - mv->cell_pt_csr), (cp[k][0] + 1) * sizeof(int));
+		if (mv->cell_pt_csr == NULL)
+		    FREE(cp[k]);
+		cp[k] = block + n;
+		n += cp[k][0] + 1;
+	    }
+	FREE(mv->cell_pt_csr);
+	mv->cell_pt_csr = block;
+	if (cc != NULL)
+	    {
+		FREE(mv->cell_cell_csr);
+		mv->cell_cell_csr = cc;
+	    }
+}
+
+
 struct mesh_var mesh_init(const char *example, const char *mesh_name)
 {
 	struct mesh_var mv = {0};
 	mv.num_border[0] = 1;
 
 	char add_mkdir[FILENAME_MAX];
-	example_io(example, add_mkdir, 1);
+	example_io(&run_ctx_global, example, add_mkdir, 1);
 	char add[FILENAME_MAX];
 	strcpy(add, add_mkdir);
 	strcat(add, mesh_name);
 	strcat(add, ".msh");
+	char add_cache[FILENAME_MAX+10];
+	strcpy(add_cache, add);
+	strcat(add_cache, ".cache");
 
+	if ((_Bool)config[55] && msh_cache_read(add, add_cache, &mv))
+		{
+		    printf("Preprocessed mesh file(%s.msh.cache) has been read!\n", mesh_name);
+		    return mv;
+		}
 	FILE * fp;
-	if ((fp = fopen(add, "r")) != NULL)
+	if ((fp = fopen(add, "rb")) != NULL)
 		{
 		    if(msh_read(fp, &mv))
 			{									
 			    fclose(fp);
 			    printf("Mesh file(%s.msh) has been read!\n", mesh_name);
+			    cell_pt_csr(&mv);
+			    if ((_Bool)config[55])
+				msh_cache_write(add_cache, &mv);
 			    return mv;
 			}
 			else
@@ -115,6 +191,8 @@ struct mesh_var mesh_init(const char *example, const char *mesh_name)
 	    }
 
 	cell_pt_clockwise(&mv);
+	cell_pt_quad(&mv);
+	cell_pt_csr(&mv);
 	return mv;
 }
 
@@ -122,8 +200,11 @@ void mesh_mem_free(struct mesh_var * mv)
 {
 	const int num_cell = (int)config[3];
 
-	for(int k = 0; k < num_cell; k++)
-	    FREE(mv->cell_pt[k]);
+	if (mv->cell_pt_csr != NULL)
+	    FREE(mv->cell_pt_csr);
+	else
+	    for(int k = 0; k < num_cell; k++)
+		FREE(mv->cell_pt[k]);
 	FREE(mv->cell_pt);
 	FREE(mv->cell_type);
 	FREE(mv->border_pt);
@@ -132,4 +213,8 @@ void mesh_mem_free(struct mesh_var * mv)
 	FREE(mv->normal_v);
 	FREE(mv->X);
 	FREE(mv->Y);
+	FREE(mv->cell_perm);
+	FREE(mv->pt_perm);
+	FREE(mv->geom);
+	FREE(mv->cell_cell_csr);
 }
@@ -0,0 +1,331 @@
+/**
+ * @file  mesh_reorder.c
+ * @brief This is a set of functions which renumber the grid cells and nodes of an unstructured mesh for the cache locality.
+ * @details The mesh files of Gmsh keep the cells in an order which is often far from the spatial locality,
+ *          so the accesses of the adjacent cells miss the cache. After the mesh is loaded, the inner cells are renumbered
+ *          in one of the orders given by config[52]:
+ *          - 1: reverse Cuthill–McKee order of the cell adjacency graph.
+ *          - 2: Hilbert space-filling curve order of the cell centers.
+ *          - 3: Morton (Z-order) space-filling curve order of the cell centers.
+ *
+ *          The nodes are then renumbered in the order in which the renumbered cells first use them.
+ *          The ghost cells keep their serial numbers at the end.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include_cii/mem.h"
+#include "../include/var_struc.h"
+#include "../include/meshing.h"
+
+
+//! Number of bits of each coordinate in the key of the space-filling curves.
+#define SFC_BITS 16
+
+//! Key of the space-filling curve of a grid cell.
+struct sfc_key {
+	unsigned long key; //!< position on the curve.
+	int cell;          //!< serial number of the cell in the file order.
+};
+
+static int sfc_key_cmp(const void * a, const void * b)
+{
+	const struct sfc_key * x = (const struct sfc_key *)a, * y = (const struct sfc_key *)b;
+	if (x->key != y->key)
+		return x->key < y->key ? -1 : 1;
+	return x->cell - y->cell;
+}
+
+//! Position of the point (x, y) on the Hilbert curve filling the 2^SFC_BITS * 2^SFC_BITS grid.
+static unsigned long hilbert_key(unsigned long x, unsigned long y)
+{
+	unsigned long rx, ry, s, t, d = 0;
+	for (s = 1UL << (SFC_BITS-1); s > 0; s >>= 1)
+	    {
+		rx = (x & s) > 0;
+		ry = (y & s) > 0;
+		d += s * s * ((3 * rx) ^ ry);
+		if (ry == 0) // rotate the quadrant
+		    {
+			if (rx == 1)
+			    {
+				x = s-1 - x;
+				y = s-1 - y;
+			    }
+			t = x; x = y; y = t;
+		    }
+	    }
+	return d;
+}
+
+//! Position of the point (x, y) on the Morton curve: the bits of x and y interleaved.
+static unsigned long morton_key(const unsigned long x, const unsigned long y)
+{
+	unsigned long d = 0;
+	for (int b = 0; b < SFC_BITS; b++)
+		d |= ((x >> b) & 1UL) << (2*b) | ((y >> b) & 1UL) << (2*b+1);
+	return d;
+}
+
+/**
+ * @brief This function orders the cells along a space-filling curve through the cell centers.
+ * @param[in]  mv:       Structure of meshing variable data.
+ * @param[in]  num_cell: Number of the inner cells.
+ * @param[in]  hilbert:  Hilbert (true) or Morton (false) curve.
+ * @param[out] perm:     Serial number in the file order of the k-th cell in the new order.
+ */
+static void sfc_order(const struct mesh_var * mv, const int num_cell, const _Bool hilbert, int * perm)
+{
+	int **cp = mv->cell_pt;
+	double x_min = INFINITY, x_max = -INFINITY, y_min = INFINITY, y_max = -INFINITY, x, y;
+	const double n_q = (double)((1UL << SFC_BITS) - 1);
+	int k, j;
+
+	struct sfc_key * sk = (struct sfc_key *)ALLOC(num_cell * sizeof(struct sfc_key));
+	for(k = 0; k < mv->num_pt; k++)
+	    {
+		x_min = fmin(x_min, mv->X[k]); x_max = fmax(x_max, mv->X[k]);
+		y_min = fmin(y_min, mv->Y[k]); y_max = fmax(y_max, mv->Y[k]);
+	    }
+	x_max = x_max > x_min ? x_max - x_min : 1.0;
+	y_max = y_max > y_min ? y_max - y_min : 1.0;
+	for(k = 0; k < num_cell; k++)
+	    {
+		x = y = 0.0;
+		for(j = 1; j <= cp[k][0]; j++)
+		    {
+			x += mv->X[cp[k][j]];
+			y += mv->Y[cp[k][j]];
+		    }
+		x = (x/cp[k][0] - x_min) / x_max * n_q;
+		y = (y/cp[k][0] - y_min) / y_max * n_q;
+		sk[k].cell = k;
+		sk[k].key  = hilbert ? hilbert_key((unsigned long)x, (unsigned long)y) : morton_key((unsigned long)x, (unsigned long)y);
+	    }
+	qsort(sk, num_cell, sizeof(struct sfc_key), sfc_key_cmp);
+	for(k = 0; k < num_cell; k++)
+		perm[k] = sk[k].cell;
+	FREE(sk);
+}
+
+/**
+ * @brief This function orders the cells by the reverse Cuthill–McKee algorithm on the graph of the cells sharing an interface.
+ * @details Each connected part of the mesh starts from a cell of the minimum degree, the neighbours are visited
+ *          in the ascending order of their degrees, and the whole order is reversed at last.
+ * @param[in]  mv:       Structure of meshing variable data.
+ * @param[in]  num_cell: Number of the inner cells.
+ * @param[out] perm:     Serial number in the file order of the k-th cell in the new order.
+ */
+static void rcm_order(const struct mesh_var * mv, const int num_cell, int * perm)
+{
+	int **cp = mv->cell_pt;
+	int k, j, l, m, p, q, c, n, head, tail, tmp;
+
+	// cells around each node
+	int * pt_off  = (int *)CALLOC(mv->num_pt + 1, sizeof(int));
+	for(k = 0; k < num_cell; k++)
+		for(j = 1; j <= cp[k][0]; j++)
+			pt_off[cp[k][j]+1]++;
+	for(p = 0; p < mv->num_pt; p++)
+		pt_off[p+1] += pt_off[p];
+	int * pt_cell = (int *)ALLOC((pt_off[mv->num_pt] + 1) * sizeof(int));
+	int * fill    = (int *)CALLOC(mv->num_pt + 1, sizeof(int));
+	for(k = 0; k < num_cell; k++)
+		for(j = 1; j <= cp[k][0]; j++)
+		    {
+			p = cp[k][j];
+			pt_cell[pt_off[p] + fill[p]++] = k;
+		    }
+	FREE(fill);
+
+	// cells sharing an interface with each cell
+	int * adj_off = (int *)CALLOC(num_cell + 1, sizeof(int));
+	for(k = 0; k < num_cell; k++)
+		adj_off[k+1] = adj_off[k] + cp[k][0];
+	int * adj = (int *)ALLOC((adj_off[num_cell] + 1) * sizeof(int));
+	int * deg = (int *)CALLOC(num_cell + 1, sizeof(int));
+	for(k = 0; k < num_cell; k++)
+		for(j = 1; j <= cp[k][0]; j++)
+		    {
+			p = cp[k][j];
+			q = cp[k][j == cp[k][0] ? 1 : j+1];
+			for(l = pt_off[p]; l < pt_off[p+1]; l++)
+			    {
+				c = pt_cell[l];
+				if (c == k)
+					continue;
+				for(m = 1; m <= cp[c][0] && cp[c][m] != q; m++)
+					;
+				if (m <= cp[c][0])
+				    {
+					adj[adj_off[k] + deg[k]++] = c;
+					break;
+				    }
+			    }
+		    }
+	FREE(pt_off);
+	FREE(pt_cell);
+
+	char * visited = (char *)CALLOC(num_cell + 1, sizeof(char));
+	for(n = 0, tail = 0; n < num_cell; )
+	    {
+		// the unvisited cell of the minimum degree starts a connected part
+		for(c = -1, k = 0; k < num_cell; k++)
+			if (!visited[k] && (c < 0 || deg[k] < deg[c]))
+				c = k;
+		visited[c] = 1;
+		perm[tail++] = c;
+		for(head = n; head < tail; head++)
+		    {
+			k = perm[head];
+			l = tail;
+			for(j = adj_off[k]; j < adj_off[k] + deg[k]; j++)
+				if (!visited[adj[j]])
+				    {
+					visited[adj[j]] = 1;
+					perm[tail++] = adj[j];
+				    }
+			// insertion sort of the new neighbours by the degree
+			for(j = l + 1; j < tail; j++)
+				for(m = j; m > l && deg[perm[m]] < deg[perm[m-1]]; m--)
+				    {
+					tmp = perm[m]; perm[m] = perm[m-1]; perm[m-1] = tmp;
+				    }
+		    }
+		n = tail;
+	    }
+	for(k = 0; k < num_cell/2; k++)
+	    {
+		tmp = perm[k]; perm[k] = perm[num_cell-1-k]; perm[num_cell-1-k] = tmp;
+	    }
+	FREE(visited);
+	FREE(adj_off);
+	FREE(adj);
+	FREE(deg);
+}
+
+//! Permute the first n values of the array v by perm (new serial number -> old serial number).
+#define PERMUTE(type, v, n)						\
+    do {								\
+	if ((v) != NULL)						\
+	    {								\
+		type * tmp_v = (type *)ALLOC((n) * sizeof(type));	\
+		for(k = 0; k < (n); k++)				\
+			tmp_v[k] = (v)[perm[k]];			\
+		memcpy((v), tmp_v, (n) * sizeof(type));			\
+		FREE(tmp_v);						\
+	    }								\
+    } while (0)
+
+/**
+ * @brief This function renumbers the inner cells and the nodes of the mesh, and the initial fluid data on the cells with them.
+ * @details 'mv->cell_pt', 'mv->cell_type', 'mv->period_cell', 'mv->border_pt', 'mv->X', 'mv->Y' and 'FV' are permuted consistently,
+ *          and so are the cached geometry 'mv->geom' and relationships 'mv->cell_cell_csr' of the preprocessed mesh file.
+ *          The serial numbers in the file order are kept in 'mv->cell_perm' and 'mv->pt_perm' for the output in the file order.
+ * @param[in,out] mv: Structure of meshing variable data.
+ * @param[in,out] FV: Structure of initial fluid variable data on the inner cells.
+ * @param[in]  order: Order of the cells (0: file order; 1: reverse Cuthill–McKee; 2: Hilbert curve; 3: Morton curve).
+ */
+void mesh_reorder(struct mesh_var * mv, struct flu_var * FV, const int order)
+{
+	const int num_cell = (int)config[3];
+	const int num_cell_ghost = mv->num_ghost + num_cell;
+	const char * name[] = {"", "reverse Cuthill-McKee", "Hilbert curve", "Morton curve"};
+	int k, j, l, n;
+	int * perm;
+
+	if (order <= 0)
+		return;
+	if (order > 3)
+	    {
+		fprintf(stderr, "No mesh reordering %d!\n", order);
+		exit(4);
+	    }
+
+	// inner cells
+	perm = (int *)ALLOC(num_cell * sizeof(int));
+	if (order == 1)
+		rcm_order(mv, num_cell, perm);
+	else
+		sfc_order(mv, num_cell, order == 2, perm);
+	int * inv = (int *)ALLOC(num_cell * sizeof(int));
+	for(k = 0; k < num_cell; k++)
+		inv[perm[k]] = k;
+
+	PERMUTE(int *, mv->cell_pt, num_cell);
+	PERMUTE(int, mv->cell_type, num_cell);
+	PERMUTE(double, FV->RHO, num_cell);
+	PERMUTE(double, FV->U,   num_cell);
+	PERMUTE(double, FV->V,   num_cell);
+	PERMUTE(double, FV->P,   num_cell);
+	for(l = 0; FV->Y != NULL && l < (int)config[71]; l++)
+		PERMUTE(double, FV->Y + (size_t)l*FV->n_Y, num_cell);
+#ifdef MULTIFLUID_BASICS
+	PERMUTE(double, FV->Z_a,   num_cell);
+	PERMUTE(double, FV->PHI,   num_cell);
+	PERMUTE(double, FV->gamma, num_cell);
+#ifdef MULTIPHASE_BASICS
+	PERMUTE(double, FV->RHO_b, num_cell);
+	PERMUTE(double, FV->U_b,   num_cell);
+	PERMUTE(double, FV->V_b,   num_cell);
+	PERMUTE(double, FV->P_b,   num_cell);
+#endif
+#endif
+	if (mv->period_cell != NULL)
+	    {
+		PERMUTE(int, mv->period_cell, num_cell);
+		for(k = 0; k < num_cell_ghost; k++)
+			if (mv->period_cell[k] >= 0 && mv->period_cell[k] < num_cell)
+				mv->period_cell[k] = inv[mv->period_cell[k]];
+	    }
+	if (mv->geom != NULL)
+	    {
+		PERMUTE(double, mv->geom, num_cell);
+		PERMUTE(double, mv->geom + num_cell_ghost, num_cell);
+		PERMUTE(double, mv->geom + 2*num_cell_ghost, num_cell);
+	    }
+	if (mv->cell_cell_csr != NULL) // The rows are moved with 'cell_pt' by cell_pt_csr() below.
+		for(k = 0; k < num_cell_ghost; k++)
+			for(j = 1; j <= mv->cell_pt[k][0]; j++)
+			    {
+				int * c = mv->cell_cell_csr + (mv->cell_pt[k] - mv->cell_pt_csr) + j;
+				if (*c >= 0 && *c < num_cell)
+					*c = inv[*c];
+			    }
+	mv->cell_perm = perm;
+	FREE(inv);
+
+	// nodes in the order of first use
+	int * pt_new = (int *)ALLOC(mv->num_pt * sizeof(int));
+	for(k = 0; k < mv->num_pt; k++)
+		pt_new[k] = -1;
+	for(k = 0, n = 0; k < num_cell_ghost; k++)
+		for(j = 1; j <= mv->cell_pt[k][0]; j++)
+			if (pt_new[mv->cell_pt[k][j]] < 0)
+				pt_new[mv->cell_pt[k][j]] = n++;
+	for(k = 0; k < mv->num_pt; k++)
+		if (pt_new[k] < 0)
+			pt_new[k] = n++;
+	perm = (int *)ALLOC(mv->num_pt * sizeof(int));
+	for(k = 0; k < mv->num_pt; k++)
+		perm[pt_new[k]] = k;
+
+	PERMUTE(double, mv->X, mv->num_pt);
+	PERMUTE(double, mv->Y, mv->num_pt);
+	for(k = 0; k < num_cell_ghost; k++)
+		for(j = 1; j <= mv->cell_pt[k][0]; j++)
+			mv->cell_pt[k][j] = pt_new[mv->cell_pt[k][j]];
+	for(l = 1, n = 0; l <= mv->num_border[0]; l++)
+		n += mv->num_border[l] + 1;
+	for(k = 0; k < n; k++)
+		mv->border_pt[k] = pt_new[mv->border_pt[k]];
+	mv->pt_perm = perm;
+	FREE(pt_new);
+	cell_pt_csr(mv); // the rows in the new order
+	mv->quad_nx = mv->quad_ny = 0; // The relationships between the cells are no longer implicit.
+
+	printf("The grid cells and nodes are renumbered in the %s order.\n", name[order]);
+}
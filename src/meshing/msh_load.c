@@ -1,15 +1,67 @@
+/**
+ * @file  msh_load.c
+ * @brief This is a set of functions which load the mesh files of Gmsh '.msh' and their preprocessed caches.
+ * @details The ASCII format 2.2 and the ASCII or binary format 4.1 are read.
+ *          The file is mapped into memory (or read at once where mmap() is not available),
+ *          and the lines or the records of the nodes and the elements are parsed in parallel.
+ *          Whatever the format, the nodes are numbered in the reverse order of the file, the grid cells
+ *          in the order of the file and the boundary lines backwards from the end of the elements,
+ *          so that a mesh saved in any format gives the same grids.
+ *          Only one boundary loop is supported.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <ctype.h>
+#include <limits.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include "../include_cii/mem.h"
 #include "../include/var_struc.h"
+#include "../include/tools.h"
+#include "../include/meshing.h"
+#include "../include/inter_process_unstruct.h"
 
 //! Define default boundary condition.
 #define DEFAULT_BC -3
 
+//! Maximum number of the nodes of the elements kept in the mesh (quadrangles).
+#define MSH_MAX_NODE 4
+
+//! Version of the layout of the preprocessed mesh file.
+#define MSH_CACHE_VERSION 1
+
+
+//! Elements of the mesh file parsed before they are placed into the mesh.
+struct msh_elem {
+	int num;    //!< number of the elements.
+	int * type; //!< element type (0: not kept).
+	int * phys; //!< physical tag (0: none).
+	int * node; //!< node tags, MSH_MAX_NODE of each element.
+};
+
+//! Header of the preprocessed mesh file.
+struct msh_cache_head {
+	char magic[8];       //!< "MSHCACHE"
+	int version;         //!< MSH_CACHE_VERSION
+	int size_int, size_double, endian;
+	int num_cell;        //!< number of the inner grid cells.
+	int num_ghost;       //!< number of the ghost grid cells.
+	int num_pt;          //!< number of the grid nodes.
+	int num_border[10];  //!< boundaries of the mesh.
+	int num_csr;         //!< length of 'cell_pt_csr'.
+};
+
 
 static int msh_border_cell_dis(int type)
 {
@@ -21,7 +73,19 @@ static int msh_border_cell_dis(int type)
 	return -1;
 }
 
+//! Number of the nodes of the element type of Gmsh (0: unknown).
+static int msh_elem_num_node(const int type)
+{
+	static const int nn[] = {0, 2, 3, 4, 4, 8, 6, 5, 3, 6, 9, 10, 27, 18, 14, 1, 8, 20, 15, 13, 9, 10, 12, 15, 15, 21, 4, 5, 6, 20, 35, 56};
+	return (type > 0 && type < (int)(sizeof(nn)/sizeof(nn[0]))) ? nn[type] : 0;
+}
+
 
+/**
+ * @brief This function links the boundary lines into the loop of the boundary nodes.
+ * @details The lines sharing a node are found in a list of the lines of each node,
+ *          and the line with the smallest serial number is taken if there are more than one.
+ */
 static int msh_border_build(struct mesh_var * mv, int num_bc_all)
 {
 	if (mv->num_border[0] != 1)
@@ -37,13 +101,42 @@ static int msh_border_build(struct mesh_var * mv, int num_bc_all)
 			return 0;
 		}
 
+	int ** cp = mv->cell_pt;
+	int  * ct = mv->cell_type;
+	const int first = num_bc_all-num_border;
+	int i, j, m, c;
+
+	for (i = first; i < num_bc_all; i++)
+		if (cp[i][0] != 2)
+			{
+				fprintf(stderr,"There are not 2 border point on a boundary cell in 2-D case!\n");
+				return 0;
+			}
+
+	// lines of each node, except the first line
+	int * pt_off  = (int *)CALLOC(mv->num_pt + 1, sizeof(int));
+	int * pt_line = (int *)ALLOC(2 * num_border * sizeof(int));
+	for (i = first; i < num_bc_all-1; i++)
+		{
+			pt_off[cp[i][1]+1]++;
+			pt_off[cp[i][2]+1]++;
+		}
+	for (m = 0; m < mv->num_pt; m++)
+		pt_off[m+1] += pt_off[m];
+	int * fill = (int *)ALLOC((mv->num_pt + 1) * sizeof(int));
+	memcpy(fill, pt_off, (mv->num_pt + 1) * sizeof(int));
+	for (i = first; i < num_bc_all-1; i++)
+		{
+			pt_line[fill[cp[i][1]]++] = i;
+			pt_line[fill[cp[i][2]]++] = i;
+		}
+	FREE(fill);
+
 	mv->border_pt   = (int*)ALLOC((num_border+1)* sizeof(int));
 	mv->border_cond = (int*)ALLOC(num_border* sizeof(int));
 
 	int  * bp = mv->border_pt;
-	int ** cp = mv->cell_pt;
 	int  * bc = mv->border_cond;
-	int  * ct = mv->cell_type;
 
 	bp[0] = cp[num_bc_all-1][1];
 	bc[0] = ct[num_bc_all-1];
@@ -51,218 +144,664 @@ static int msh_border_build(struct mesh_var * mv, int num_bc_all)
 	bp[1] = cp[num_bc_all-1][2];
 
 	// not num_border-1, the lastest one is used to test loop.
-	for (int j = 1; j < num_border; j++)
-	    for (int i = num_bc_all-2; i >= num_bc_all-num_border; i--)
+	for (j = 1; j < num_border; j++)
 		{
-		    if (cp[i][0] != 2)
-			{
-			    fprintf(stderr,"There are not 2 border point on a boundary cell in 2-D case!\n");
-			    return 0;
-			}
-		    if(bp[j] == cp[i][1] && bp[j-1] != cp[i][2])
-			{
-			    bp[j+1] = cp[i][2];
-			    bc[j] = ct[i];
-			}
-		    else if(bp[j] == cp[i][2] && bp[j-1] != cp[i][1])
-			{
-			    bp[j+1] = cp[i][1];
-			    bc[j] = ct[i];
-			}
+			bp[j+1] = -1;
+			for (m = pt_off[bp[j]], c = num_bc_all; m < pt_off[bp[j]+1]; m++)
+				{
+					i = pt_line[m];
+					if (i < c && ((bp[j] == cp[i][1] && bp[j-1] != cp[i][2]) || (bp[j] == cp[i][2] && bp[j-1] != cp[i][1])))
+						c = i;
+				}
+			if (c == num_bc_all)
+				break;
+			bp[j+1] = bp[j] == cp[c][1] ? cp[c][2] : cp[c][1];
+			bc[j]   = ct[c];
 		}
+	FREE(pt_off);
+	FREE(pt_line);
 	if (bp[num_border] != bp[0])
 	    {
 		fprintf(stderr,"The boundary isn't a loop!\n");
 		return 0;
 	    }
 
-	return 1;	
+	return 1;
 }
 
 
-// only one boundary loop is supported.
-int msh_read(FILE * fp, struct mesh_var * mv)
+/**
+ * @brief This function maps a file into memory, or reads it into memory where it cannot be mapped.
+ * @details The data are followed by a '\0', as the zeros filling the last page of a map when the size is not a multiple of the page.
+ * @param[in]  fp:     Pointer to the file opened.
+ * @param[out] len:    Length of the file.
+ * @param[out] mapped: Whether the file is mapped.
+ * @return The data of the file (NULL: failure).
+ */
+static char * msh_map(FILE * fp, size_t * len, _Bool * mapped)
 {
-	int s_now = -1, s_max = 0; //section index
-	int num_of = 0, num_tag; // number of section or tags.
-	int *idx_N = NULL; // order of NODE;
-	int num_cell = (int)config[3], num_border = 0;
-	int b_or_c, n_bc = 0, num_bc_all = 0; // boundary_or_cell
-	int temp[30]; // store cell_point data
-	int n_c, type, phy_entity;
-
-	const char *section[] = {
-		"MeshFormat", "PhysicalNames", "Nodes",
-		"Elements" , "Periodic", "NodeData", "ElementData",
-		"ElementNodeData", "InterpolationScheme" };
-	char one_line[1000]; // input one line
-	char *headptr, *endptr; // PTR of read data
-	char Endsection[25];
-
-	while (fgets(one_line, sizeof(one_line), fp) != NULL)
-		{
-			for (headptr = one_line; isspace(*headptr); )
-				headptr++;
-
-			if (*headptr == '$')
+	char * buf;
+	*mapped = 0;
+#ifndef _WIN32
+	struct stat st;
+	const long page = sysconf(_SC_PAGESIZE);
+	if (fstat(fileno(fp), &st) == 0 && st.st_size > 0 && page > 0 && st.st_size % page != 0)
+		{
+			buf = (char *)mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+			if (buf != MAP_FAILED)
 				{
-					for (endptr = (++headptr); !isspace(*endptr); )
-						endptr++;
-					*endptr = '\0';
+					*len = (size_t)st.st_size;
+					*mapped = 1;
+					return buf;
+				}
+		}
+#endif
+	long n;
+	if (fseek(fp, 0, SEEK_END) != 0 || (n = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET) != 0)
+		return NULL;
+	*len = (size_t)n;
+	if ((buf = (char *)malloc(*len + 1)) == NULL)
+		return NULL;
+	if (fread(buf, 1, *len, fp) != *len)
+		{
+			free(buf);
+			return NULL;
+		}
+	buf[*len] = '\0';
+	return buf;
+}
 
-					if (s_now >= 0)
-						{
-							strcpy(Endsection, "End");
-							strcat(Endsection, section[s_now]);
-							if (strcmp(headptr, Endsection) != 0)
-								{
-									fprintf(stderr, "End of the section in .msh file doesn't match!\n");
-									goto return_0;
-								}
-							else if (num_of > 0)
-								{
-									fprintf(stderr, "The count is not complete in the section in .msh file!\n");
-									goto return_0;
-								}
-							else
-								s_now = -1;
+//! This function releases the data of msh_map().
+static void msh_unmap(char * buf, const size_t len, const _Bool mapped)
+{
+#ifndef _WIN32
+	if (mapped)
+		{
+			munmap(buf, len);
+			return;
+		}
+#else
+	(void)len; (void)mapped;
+#endif
+	free(buf);
+}
 
-							continue;
-						}
+//! This function returns the next line after p.
+static const char * msh_next_line(const char * p, const char * end)
+{
+	const char * n = (const char *)memchr(p, '\n', (size_t)(end - p));
+	return n ? n + 1 : end;
+}
+
+/**
+ * @brief This function collects the starts of the next n lines which are not blank.
+ * @return The position after the lines (NULL: not enough lines).
+ */
+static const char * msh_lines(const char * p, const char * end, const int n, const char ** line)
+{
+	const char * q;
+	for(int i = 0; i < n; )
+		{
+			if (p >= end)
+				return NULL;
+			for (q = p; q < end && *q != '\n' && isspace((unsigned char)*q); q++)
+				;
+			if (q < end && *q != '\n')
+				line[i++] = p;
+			p = msh_next_line(p, end);
+		}
+	return p;
+}
+
+/**
+ * @brief This function finds the next section '$name' of the mesh file.
+ * @param[in,out] p: Position in the file, which is moved to the line after the head of the section.
+ * @param[out] name: Name of the section.
+ * @return Whether a section is found.
+ */
+static _Bool msh_section(const char ** p, const char * end, char name[32])
+{
+	const char * q = *p;
+	int n;
+	while (q < end)
+		{
+			while (q < end && isspace((unsigned char)*q))
+				q++;
+			if (q < end && *q == '$')
+				{
+					for (n = 0, q++; q < end && !isspace((unsigned char)*q) && n < 31; )
+						name[n++] = *q++;
+					name[n] = '\0';
+					*p = msh_next_line(q, end);
+					return 1;
+				}
+			q = msh_next_line(q, end);
+		}
+	return 0;
+}
+
+/**
+ * @brief This function checks the end '$Endname' of the section after the data at p, or finds it when skip is true.
+ * @return The position after the end of the section (NULL: not found).
+ */
+static const char * msh_section_end(const char * p, const char * end, const char * name, const _Bool skip)
+{
+	char tag[40];
+	const size_t n = (size_t)sprintf(tag, "$End%.31s", name);
+	while (p < end)
+		{
+			while (p < end && isspace((unsigned char)*p))
+				p++;
+			if ((size_t)(end - p) >= n && memcmp(p, tag, n) == 0)
+				return msh_next_line(p, end);
+			if (!skip)
+				return NULL;
+			p = msh_next_line(p, end);
+		}
+	return NULL;
+}
 
-					for (int s = s_max; s < 9; s++)
-						if (strcmp(headptr, section[s]) == 0)
+//! Read n bytes of binary data at p into v, if they are before the end.
+#define MSH_RD(v, n)							\
+    do {								\
+	if ((size_t)(end - p) < (size_t)(n))				\
+	    goto return_0;						\
+	memcpy((v), p, (n));						\
+	p += (n);							\
+    } while (0)
+
+//! Read a size_t of binary data, or a number of ASCII data, as an int.
+#define MSH_RD_SIZE(v)							\
+    do {								\
+	if (binary)							\
+	    {								\
+		size_t s_;						\
+		MSH_RD(&s_, sizeof(size_t));				\
+		if (s_ > INT_MAX)					\
+		    goto return_0;					\
+		(v) = (int)s_;						\
+	    }								\
+	else								\
+	    (v) = (int)strtol(p, (char **)&p, 10);			\
+    } while (0)
+
+#define MSH_RD_INT(v)							\
+    do {								\
+	if (binary)							\
+		MSH_RD(&(v), sizeof(int));				\
+	else								\
+	    (v) = (int)strtol(p, (char **)&p, 10);			\
+    } while (0)
+
+#define MSH_RD_DOUBLE(v)						\
+    do {								\
+	if (binary)							\
+		MSH_RD(&(v), sizeof(double));				\
+	else								\
+	    (v) = strtod(p, (char **)&p);				\
+    } while (0)
+
+/**
+ * @brief This function reads the section $Entities of the format 4.1 for the physical tags of the curves.
+ * @param[out] c_phys: First physical tag of each curve tag (0: none), allocated up to the largest curve tag.
+ * @param[out] c_max:  The largest curve tag.
+ * @return The position after the data (NULL: error).
+ */
+static const char * msh_entities_41(const char * p, const char * end, const _Bool binary, int ** c_phys, int * c_max)
+{
+	int num[4], d, e, tag, n_t, n_b, m, t;
+	double x;
+	int * cp = NULL;
+	const char * p0;
+
+	for(d = 0; d < 4; d++)
+		MSH_RD_SIZE(num[d]);
+	// The largest curve tag is found in a first pass.
+	for(int pass = 0, max = 0; pass < 2; pass++)
+		{
+			p0 = p;
+			if (pass == 1)
+				{
+					cp = (int *)CALLOC(max + 1, sizeof(int));
+					*c_max = max;
+				}
+			for(d = 0; d < 4; d++)
+				for(e = 0; e < num[d]; e++)
+					{
+						MSH_RD_INT(tag);
+						for(m = 0; m < (d ? 6 : 3); m++)
+							MSH_RD_DOUBLE(x);
+						MSH_RD_SIZE(n_t);
+						for(m = 0; m < n_t; m++)
 							{
-								s_now = s;
-								s_max = s;
-								break;
+								MSH_RD_INT(t);
+								if (d == 1 && m == 0 && pass == 1 && tag >= 0)
+									cp[tag] = abs(t);
 							}
-					if (s_now == 0 && num_of <= 0)
-						num_of = 1;
-				}
-			else if (strlen(headptr) <= 0)
-				continue;
-			else if (s_now == 0 && num_of == 1)
+						if (d == 1 && pass == 0)
+							max = tag > max ? tag : max;
+						if (d > 0)
+							{
+								MSH_RD_SIZE(n_b);
+								for(m = 0; m < n_b; m++)
+									MSH_RD_INT(t);
+							}
+					}
+			if (pass == 0)
+				p = p0;
+		}
+	(void)x;
+	*c_phys = cp;
+	return p;
+ return_0:
+	FREE(cp);
+	fprintf(stderr, "The entities are not complete in .msh file!\n");
+	return NULL;
+}
+
+/**
+ * @brief This function reads the section $Nodes of the format 2.2 or 4.1.
+ * @details The coordinates of the g-th node in the file are stored at the serial number num_pt-1-g.
+ * @param[out] tag: Node tag of each serial number.
+ * @return The position after the data (NULL: error).
+ */
+static const char * msh_nodes(const char * p, const char * end, const double version, const _Bool binary,
+			      struct mesh_var * mv, int ** tag)
+{
+	const char ** line = NULL;
+	int num_block = 1, num, n_b, dim, ent, para, b, g = 0, err = 0;
+	int * tg;
+
+	if (version < 4.0)
+		num = (int)strtol(p, (char **)&p, 10);
+	else
+		{
+			MSH_RD_SIZE(num_block);
+			MSH_RD_SIZE(num);
+			MSH_RD_SIZE(b); // minNodeTag
+			MSH_RD_SIZE(b); // maxNodeTag
+		}
+	if (num <= 0)
+		{
+			fprintf(stderr, "There is no node in .msh file!\n");
+			return NULL;
+		}
+	mv->num_pt = num;
+	mv->X = (double*)ALLOC(num * sizeof(double));
+	mv->Y = (double*)ALLOC(num * sizeof(double));
+	tg = *tag = (int*)ALLOC(num * sizeof(int));
+	if (!binary)
+		{
+			p = msh_next_line(p, end);
+			line = (const char **)ALLOC(2 * num * sizeof(const char *));
+		}
+
+	for(b = 0; b < num_block; b++)
+		{
+			if (version < 4.0)
 				{
-					if (strtod(headptr, &headptr) - 2.2 > EPS)
-						{
-							fprintf(stderr, "Version-number isn't not equal to 2.2 in .msh file!\n");
-							goto return_0;
-						}
-					if (strtol(headptr, &headptr, 10) != 0)
+					if ((p = msh_lines(p, end, num, line)) == NULL)
+						goto return_0;
+#pragma omp parallel for reduction(|:err)
+					for(int i = 0; i < num; i++)
 						{
-							fprintf(stderr, "The .msh file isn't ASCII file format!\n");
-							goto return_0;
+							char * q;
+							const long t = strtol(line[i], &q, 10);
+							err |= t <= 0 || t > INT_MAX;
+							tg[num-1-i]    = (int)t;
+							mv->X[num-1-i] = strtod(q, &q);
+							mv->Y[num-1-i] = strtod(q, &q);
 						}
-					if (strtol(headptr, NULL, 10) != 8)
+					g = num;
+					break;
+				}
+			MSH_RD_INT(dim);
+			MSH_RD_INT(ent);
+			MSH_RD_INT(para); // parametric
+			MSH_RD_SIZE(n_b);
+			dim = para ? dim : 0; // number of the parametric coordinates
+			(void)ent;
+			if (g + n_b > num)
+				goto return_0;
+			if (binary)
+				{
+					const size_t sz = (size_t)n_b * (sizeof(size_t) + (3 + dim) * sizeof(double));
+					if ((size_t)(end - p) < sz)
+						goto return_0;
+					const char * t0 = p, * x0 = p + (size_t)n_b * sizeof(size_t);
+#pragma omp parallel for reduction(|:err)
+					for(int i = 0; i < n_b; i++)
 						{
-							fprintf(stderr, "Currently only data-size = sizeof(double) is supported in .msh file!\n");
-							goto return_0;
+							size_t t;
+							double x[2];
+							memcpy(&t, t0 + i * sizeof(size_t), sizeof(size_t));
+							memcpy(x, x0 + (size_t)i * (3 + dim) * sizeof(double), 2 * sizeof(double));
+							err |= t == 0 || t > INT_MAX;
+							tg[num-1-g-i]    = (int)t;
+							mv->X[num-1-g-i] = x[0];
+							mv->Y[num-1-g-i] = x[1];
 						}
-					num_of--;
+					p += sz;
 				}
-			else if (s_now == 0)
+			else
 				{
-					fprintf(stderr, "Not only one line in Meshformat!\n");
-					goto return_0;
+					p = msh_next_line(p, end);
+					if ((p = msh_lines(p, end, 2 * n_b, line)) == NULL)
+						goto return_0;
+#pragma omp parallel for reduction(|:err)
+					for(int i = 0; i < n_b; i++)
+						{
+							char * q;
+							const long t = strtol(line[i], NULL, 10);
+							err |= t <= 0 || t > INT_MAX;
+							tg[num-1-g-i]    = (int)t;
+							mv->X[num-1-g-i] = strtod(line[n_b+i], &q);
+							mv->Y[num-1-g-i] = strtod(q, &q);
+						}
 				}
-			else if (s_now == 2 && num_of <= 0)
+			g += n_b;
+		}
+	FREE(line);
+	if (err || g != num)
+		{
+			fprintf(stderr, "Wrong nodes in .msh file!\n");
+			return NULL;
+		}
+	return p;
+ return_0:
+	FREE(line);
+	fprintf(stderr, "The nodes are not complete in .msh file!\n");
+	return NULL;
+}
+
+/**
+ * @brief This function reads the section $Elements of the format 2.2 or 4.1.
+ * @param[in] c_phys: First physical tag of each curve tag of the format 4.1.
+ * @param[out] el:    Elements parsed.
+ * @return The position after the data (NULL: error).
+ */
+static const char * msh_elements(const char * p, const char * end, const double version, const _Bool binary,
+				 const int * c_phys, const int c_max, struct msh_elem * el)
+{
+	const char ** line = NULL;
+	int num_block = 1, num, n_b, ent, type, nn, b, g = 0, err = 0, bad_tag = 0;
+
+	if (version < 4.0)
+		num = (int)strtol(p, (char **)&p, 10);
+	else
+		{
+			MSH_RD_SIZE(num_block);
+			MSH_RD_SIZE(num);
+			MSH_RD_SIZE(b); // minElementTag
+			MSH_RD_SIZE(b); // maxElementTag
+		}
+	if (num <= 0)
+		{
+			fprintf(stderr, "There is no element in .msh file!\n");
+			return NULL;
+		}
+	el->num  = num;
+	el->type = (int*)ALLOC(num * sizeof(int));
+	el->phys = (int*)ALLOC(num * sizeof(int));
+	el->node = (int*)ALLOC(MSH_MAX_NODE * num * sizeof(int));
+	if (!binary)
+		{
+			p = msh_next_line(p, end);
+			line = (const char **)ALLOC(num * sizeof(const char *));
+		}
+
+	for(b = 0; b < num_block; b++)
+		{
+			if (version < 4.0)
 				{
-					num_of = strtol(headptr, NULL, 10);
-					if (num_of > 0)
+					if ((p = msh_lines(p, end, num, line)) == NULL)
+						goto return_0;
+#pragma omp parallel for reduction(|:err, bad_tag)
+					for(int i = 0; i < num; i++)
 						{
-							mv->num_pt = num_of;
-							idx_N = (int*)   ALLOC(mv->num_pt * sizeof(int));
-							mv->X = (double*)ALLOC(mv->num_pt * sizeof(double));
-							mv->Y = (double*)ALLOC(mv->num_pt * sizeof(double));
-							if(mv->X == NULL || mv->Y == NULL)
+							char * q;
+							int tp, n_t, m;
+							strtol(line[i], &q, 10);
+							tp = (int)strtol(q, &q, 10);
+							el->type[i] = msh_border_cell_dis(tp) < 0 ? 0 : tp;
+							if (el->type[i] == 0)
+								continue;
+							n_t = (int)strtol(q, &q, 10);
+							if (n_t < 2)
 								{
-									printf("Not enough memory in msh_read!\n");
-									goto return_0;
+									bad_tag = 1;
+									el->type[i] = 0;
+									continue;
 								}
+							el->phys[i] = (int)strtol(q, &q, 10);
+							while(--n_t > 0)
+								strtol(q, &q, 10);
+							for(m = 0; m < msh_elem_num_node(tp); m++)
+								el->node[MSH_MAX_NODE*i+m] = (int)strtol(q, &q, 10);
 						}
+					g = num;
+					break;
 				}
-			else if (s_now == 2)
+			MSH_RD_INT(ent);  // entityDim
+			MSH_RD_INT(ent);  // entityTag
+			MSH_RD_INT(type);
+			MSH_RD_SIZE(n_b);
+			nn = msh_elem_num_node(type);
+			if (g + n_b > num || (binary && nn == 0))
+				goto return_0;
+			const int tp = msh_border_cell_dis(type) < 0 ? 0 : type;
+			const int ph = (type == 1 && ent >= 0 && ent <= c_max && c_phys != NULL) ? c_phys[ent] : 0;
+			if (binary)
 				{
-					idx_N[--num_of] = strtol(headptr, &headptr, 10);
-					mv->X[num_of]   = strtod(headptr, &headptr);
-					mv->Y[num_of]   = strtod(headptr, &headptr);
+					const size_t sz = (size_t)n_b * (1 + nn) * sizeof(size_t);
+					if ((size_t)(end - p) < sz)
+						goto return_0;
+					const char * e0 = p;
+#pragma omp parallel for reduction(|:err)
+					for(int i = 0; i < n_b; i++)
+						{
+							size_t t;
+							el->type[g+i] = tp;
+							el->phys[g+i] = ph;
+							for(int m = 0; tp && m < nn; m++)
+								{
+									memcpy(&t, e0 + ((size_t)i * (1 + nn) + 1 + m) * sizeof(size_t), sizeof(size_t));
+									err |= t == 0 || t > INT_MAX;
+									el->node[MSH_MAX_NODE*(g+i)+m] = (int)t;
+								}
+						}
+					p += sz;
 				}
-			else if (s_now == 3 && num_of <= 0 && idx_N != NULL)
+			else
 				{
-					num_of = strtol(headptr, NULL, 10);
-					if (num_of <= 0)
-						continue;
-
-					num_cell = 0;
-					num_border = 0;
-					num_bc_all = num_of;
-					mv->cell_type = (int*) ALLOC(num_bc_all * sizeof(int));
-					mv->cell_pt   = (int**)ALLOC(num_bc_all * sizeof(int *));
-					if(mv->cell_type == NULL || mv->cell_pt == NULL)
+					p = msh_next_line(p, end);
+					if ((p = msh_lines(p, end, n_b, line)) == NULL)
+						goto return_0;
+#pragma omp parallel for
+					for(int i = 0; i < n_b; i++)
 						{
-							fprintf(stderr, "Not enough memory in msh_read!\n");
-							goto return_0;
+							char * q;
+							el->type[g+i] = tp;
+							el->phys[g+i] = ph;
+							strtol(line[i], &q, 10);
+							for(int m = 0; tp && m < nn; m++)
+								el->node[MSH_MAX_NODE*(g+i)+m] = (int)strtol(q, &q, 10);
 						}
 				}
-			else if (s_now == 3 && idx_N != NULL)
+			g += n_b;
+		}
+	FREE(line);
+	if (bad_tag)
+		fprintf(stderr, "Using the MSH2 format require at least the first two tags!\n");
+	if (err || g != num)
+		{
+			fprintf(stderr, "Wrong elements in .msh file!\n");
+			return NULL;
+		}
+	return p;
+ return_0:
+	FREE(line);
+	fprintf(stderr, "The elements are not complete in .msh file!\n");
+	return NULL;
+}
+
+/**
+ * @brief This function places the grid cells and the boundary lines into the mesh.
+ * @details The grid cells are placed in the order of the file from the beginning of 'mv->cell_pt',
+ *          and the boundary lines backwards from the end. The rows are stored in the block 'mv->cell_pt_csr'.
+ * @param[in] tag: Node tag of each serial number.
+ * @return The number of the grid cells (-1: error).
+ */
+static int msh_place(struct mesh_var * mv, const struct msh_elem * el, const int * tag, int * num_border)
+{
+	const int num = el->num;
+	int max_tag = 0, num_cell = 0, n_bc, i, err = 0;
+
+	for(i = 0; i < mv->num_pt; i++)
+		max_tag = tag[i] > max_tag ? tag[i] : max_tag;
+	int * idx = (int *)ALLOC((max_tag + 1) * sizeof(int));
+	for(i = 0; i <= max_tag; i++)
+		idx[i] = -1;
+	for(i = 0; i < mv->num_pt; i++)
+		idx[tag[i]] = i;
+
+	int * row = (int *)ALLOC(num * sizeof(int)); // serial number of each element in 'mv->cell_pt'
+	int * off = (int *)ALLOC((num + 1) * sizeof(int));
+	mv->cell_type = (int*) ALLOC(num * sizeof(int));
+	mv->cell_pt   = (int**)CALLOC(num, sizeof(int *));
+	*num_border = 0;
+	for(i = 0, off[0] = 0; i < num; i++)
+		{
+			off[i+1] = off[i];
+			row[i] = -1;
+			if (el->type[i] == 0)
+				continue;
+			if (msh_border_cell_dis(el->type[i]) == 0)
 				{
-					--num_of;
-					strtol(headptr, &headptr, 10);
+					n_bc = num_cell++;
+					mv->cell_type[n_bc] = el->type[i];
+				}
+			else
+				{
+					n_bc = num - (++(*num_border));
+					mv->cell_type[n_bc] = el->phys[i] ? -el->phys[i] : DEFAULT_BC;
+				}
+			row[i] = n_bc;
+			off[i+1] += msh_elem_num_node(el->type[i]) + 1;
+		}
+	mv->cell_pt_csr = (int *)ALLOC((off[num] > 0 ? off[num] : 1) * sizeof(int));
 
-					type = strtol(headptr, &headptr, 10);
+#pragma omp parallel for reduction(|:err)
+	for(int e = 0; e < num; e++)
+		{
+			if (row[e] < 0)
+				continue;
+			int * r = mv->cell_pt_csr + off[e], t;
+			r[0] = off[e+1] - off[e] - 1;
+			for(int j = 0; j < r[0]; j++)
+				{
+					t = el->node[MSH_MAX_NODE*e+j];
+					r[j+1] = (t > 0 && t <= max_tag) ? idx[t] : -1;
+					err |= r[j+1] < 0;
+				}
+			mv->cell_pt[row[e]] = r;
+		}
+	FREE(idx);
+	FREE(row);
+	FREE(off);
+	if (err)
+		{
+			fprintf(stderr, "Some nodes of the elements are not found in .msh file!\n");
+			return -1;
+		}
+	return num_cell;
+}
 
-					b_or_c = msh_border_cell_dis(type);
-					if (b_or_c == -1)
-						continue;
-					if (b_or_c == 0)
-						{
-							n_bc = num_cell++;
-							mv->cell_type[n_bc] = type;
-						}
 
-					num_tag = strtol(headptr, &headptr, 10);
-					if (num_tag < 2)
+// only one boundary loop is supported.
+int msh_read(FILE * fp, struct mesh_var * mv)
+{
+	struct msh_elem el = {0};
+	int * tag = NULL, * c_phys = NULL, c_max = 0;
+	int num_cell, num_border = 0, num_bc_all = 0;
+	double version = 0.0;
+	_Bool binary = 0, mapped;
+	size_t len = 0;
+	char name[32];
+
+	char * buf = msh_map(fp, &len, &mapped);
+	if (buf == NULL)
+		{
+			fprintf(stderr, "Read error occurrs in .msh file!\n");
+			return 0;
+		}
+	const char * p = buf, * end = buf + len;
+
+	while (p != NULL && msh_section(&p, end, name))
+		{
+			if (strcmp(name, "MeshFormat") == 0)
+				{
+					version = strtod(p, (char **)&p);
+					binary  = strtol(p, (char **)&p, 10) != 0;
+					if (fabs(version - 2.2) > EPS && fabs(version - 4.1) > EPS)
 						{
-							fprintf(stderr, "Using the MSH2 format require at least the first two tags!\n");
-							continue;
+							fprintf(stderr, "Version-number isn't 2.2 or 4.1 in .msh file!\n");
+							goto return_0;
 						}
-					phy_entity = strtol(headptr, &headptr, 10);
-					if (b_or_c == 1)
+					if (binary && version < 4.0)
 						{
-							n_bc = num_bc_all - (++num_border);
-							mv->cell_type[n_bc] = phy_entity ? -phy_entity : DEFAULT_BC;
+							fprintf(stderr, "The .msh file of version 2.2 isn't ASCII file format!\n");
+							goto return_0;
 						}
-
-					while(--num_tag > 0)
-						strtol(headptr, &headptr, 10);
-
-					for(n_c = 0; (temp[n_c] = strtol(headptr, &headptr, 10)) > 0; )
-						n_c++;
-
-
-					mv->cell_pt[n_bc] = (int*)ALLOC((n_c+1) * sizeof(int));
-					if(mv->cell_pt[n_bc] == NULL)
+					if (strtol(p, (char **)&p, 10) != 8)
 						{
-							fprintf(stderr, "Not enough memory in msh_read!\n");
+							fprintf(stderr, "Currently only data-size = sizeof(double) is supported in .msh file!\n");
 							goto return_0;
 						}
-
-					mv->cell_pt[n_bc][0] = n_c;
-					for(int j = 0; j < n_c; j++)
-						for(int i = 0; i < mv->num_pt; i++)
-							if(temp[j] == idx_N[i])
-								mv->cell_pt[n_bc][j+1] = i;
+					p = msh_next_line(p, end);
+					if (binary)
+						{
+							int one = 0;
+							if ((size_t)(end - p) >= sizeof(int))
+								memcpy(&one, p, sizeof(int));
+							if (one != 1)
+								{
+									fprintf(stderr, "The byte order of the binary .msh file isn't supported!\n");
+									goto return_0;
+								}
+							p = msh_next_line(p + sizeof(int), end);
+						}
 				}
-
+			else if (version <= 0.0)
+				{
+					fprintf(stderr, "No MeshFormat at the beginning of .msh file!\n");
+					goto return_0;
+				}
+			else if (strcmp(name, "Entities") == 0 && version > 4.0)
+				p = msh_entities_41(p, end, binary, &c_phys, &c_max);
+			else if (strcmp(name, "Nodes") == 0 && tag == NULL)
+				p = msh_nodes(p, end, version, binary, mv, &tag);
+			else if (strcmp(name, "Elements") == 0 && tag != NULL && el.num == 0)
+				p = msh_elements(p, end, version, binary, c_phys, c_max, &el);
+			else
+				{
+					p = msh_section_end(p, end, name, 1);
+					continue;
+				}
+			if (p != NULL && (p = msh_section_end(p, end, name, 0)) == NULL)
+				fprintf(stderr, "End of the section in .msh file doesn't match!\n");
 		}
-
-	if (ferror(fp))
+	if (p == NULL || tag == NULL || el.num == 0)
 		{
-			fprintf(stderr, "Read error occurrs in .msh file!\n");
+			if (p != NULL)
+				fprintf(stderr, "There are no nodes or elements in .msh file!\n");
 			goto return_0;
 		}
 
+	num_bc_all = el.num;
+	if ((num_cell = msh_place(mv, &el, tag, &num_border)) < 0)
+		goto return_0;
+
 	if (num_cell > (int)config[3])
 		printf("There are %d ghost cell!\n", mv->num_ghost = num_cell - (int)config[3]);
 	else if (num_cell < (int)config[3])
@@ -281,20 +820,210 @@ int msh_read(FILE * fp, struct mesh_var * mv)
 			goto return_0;
 		}
 
-	FREE(idx_N);
+	FREE(tag);
+	FREE(c_phys);
+	FREE(el.type);
+	FREE(el.phys);
+	FREE(el.node);
+	msh_unmap(buf, len, mapped);
 	return 1;
 
  return_0:
 
-	FREE(idx_N);
+	FREE(tag);
+	FREE(c_phys);
+	FREE(el.type);
+	FREE(el.phys);
+	FREE(el.node);
+	msh_unmap(buf, len, mapped);
 	FREE(mv->X);
 	FREE(mv->Y);
 	FREE(mv->cell_type);
-	if (mv->cell_pt != NULL)
+	FREE(mv->cell_pt);
+	FREE(mv->cell_pt_csr);
+	return 0;
+}
+
+
+/**
+ * @brief This function computes the areas, the centroids and the relationships of the grid cells into the mesh.
+ * @details They are computed by vol_comp(), cell_centroid() and cell_rel() on a temporary structure 'cv',
+ *          and kept in 'mv->geom' and 'mv->cell_cell_csr' for the scheme.
+ * @param[in,out] mv: Structure of meshing variable data.
+ */
+static void msh_geom(struct mesh_var * mv)
+{
+	const int num_cell_ghost = mv->num_ghost + (int)config[3];
+	int ** cp = mv->cell_pt;
+	struct cell_var cv = {0};
+	int k, j;
+
+	cv.face_off = (int *)ALLOC((num_cell_ghost + 1) * sizeof(int));
+	cv.face_off[0] = 0;
+	for(k = 0; k < num_cell_ghost; k++)
+		cv.face_off[k+1] = cv.face_off[k] + cp[k][0];
+	cv.n_x       = (double **)ALLOC(num_cell_ghost * sizeof(double *));
+	cv.n_y       = (double **)ALLOC(num_cell_ghost * sizeof(double *));
+	cv.cell_cell = (int **)   ALLOC(num_cell_ghost * sizeof(int *));
+	init_mem(cv.n_x, num_cell_ghost, cv.face_off);
+	init_mem(cv.n_y, num_cell_ghost, cv.face_off);
+	init_mem_int(cv.cell_cell, num_cell_ghost, cv.face_off);
+	memset(cv.cell_cell[0], 0, (cv.face_off[num_cell_ghost] > 0 ? cv.face_off[num_cell_ghost] : 1) * sizeof(int));
+	double * geom = (double *)ALLOC(3 * num_cell_ghost * sizeof(double));
+	cv.vol = geom;
+	cv.X_c = geom + num_cell_ghost;
+	cv.Y_c = geom + 2 * num_cell_ghost;
+
+	vol_comp(&cv, mv);
+	cell_rel(&cv, mv);
+	cell_centroid(&cv, mv);
+
+	int * cc = (int *)ALLOC((cp[num_cell_ghost-1] - mv->cell_pt_csr + cp[num_cell_ghost-1][0] + 1) * sizeof(int));
+	for(k = 0; k < num_cell_ghost; k++)
 		{
-			for(int i = 0; i < num_bc_all; ++i)
-				FREE(mv->cell_pt[i]);
+			cc[cp[k] - mv->cell_pt_csr] = cp[k][0];
+			for(j = 0; j < cp[k][0]; j++)
+				cc[cp[k] - mv->cell_pt_csr + 1 + j] = cv.cell_cell[k][j];
+		}
+	mv->geom = geom;
+	mv->cell_cell_csr = cc;
+
+	free(cv.n_x[0]);
+	free(cv.n_y[0]);
+	free(cv.cell_cell[0]);
+	FREE(cv.n_x);
+	FREE(cv.n_y);
+	FREE(cv.cell_cell);
+	FREE(cv.face_off);
+}
+
+//! This function fills the header of the preprocessed mesh file of the mesh.
+static void msh_cache_head(struct msh_cache_head * h, const struct mesh_var * mv)
+{
+	const int endian = 1;
+	memset(h, 0, sizeof(*h));
+	memcpy(h->magic, "MSHCACHE", 8);
+	h->version     = MSH_CACHE_VERSION;
+	h->size_int    = (int)sizeof(int);
+	h->size_double = (int)sizeof(double);
+	h->endian      = *(const unsigned char *)&endian;
+	h->num_cell    = (int)config[3];
+	h->num_ghost   = mv->num_ghost;
+	h->num_pt      = mv->num_pt;
+	memcpy(h->num_border, mv->num_border, sizeof(h->num_border));
+}
+
+/**
+ * @brief This function loads the mesh from the preprocessed mesh file, if it is newer than the mesh file.
+ * @details The file keeps the nodes, the rows of the grid cells, the boundary, and the areas, the centroids
+ *          and the relationships of the grid cells, so that the mesh is not parsed and built again.
+ * @param[in]  msh:   Address of the mesh file '.msh'.
+ * @param[in]  cache: Address of the preprocessed mesh file.
+ * @param[out] mv:    Structure of meshing variable data.
+ * @return Whether the mesh is loaded.
+ */
+int msh_cache_read(const char * msh, const char * cache, struct mesh_var * mv)
+{
+	struct stat st_m, st_c;
+	struct msh_cache_head h, h_0;
+	_Bool mapped;
+	size_t len;
+	int k, ok = 0;
+
+	if (stat(cache, &st_c) != 0 || (stat(msh, &st_m) == 0 && st_m.st_mtime > st_c.st_mtime))
+		return 0;
+	FILE * fp = fopen(cache, "rb");
+	if (fp == NULL)
+		return 0;
+	char * buf = msh_map(fp, &len, &mapped);
+	fclose(fp);
+	if (buf == NULL)
+		return 0;
+	const char * p = buf, * end = buf + len;
+
+	MSH_RD(&h, sizeof(h));
+	mv->num_ghost = h.num_ghost;
+	mv->num_pt    = h.num_pt;
+	memcpy(mv->num_border, h.num_border, sizeof(h.num_border));
+	msh_cache_head(&h_0, mv);
+	h_0.num_csr = h.num_csr;
+	if (memcmp(&h, &h_0, sizeof(h)) != 0 || h.num_border[0] != 1)
+		goto return_0;
+
+	const int num_cell_ghost = h.num_ghost + h.num_cell;
+	const int num_bp = h.num_border[1] + 1;
+	mv->X           = (double *)ALLOC(h.num_pt * sizeof(double));
+	mv->Y           = (double *)ALLOC(h.num_pt * sizeof(double));
+	mv->cell_pt_csr = (int *)ALLOC(h.num_csr * sizeof(int));
+	mv->cell_type   = (int *)ALLOC(num_cell_ghost * sizeof(int));
+	mv->border_pt   = (int *)ALLOC(num_bp * sizeof(int));
+	mv->border_cond = (int *)ALLOC((num_bp-1) * sizeof(int));
+	mv->geom        = (double *)ALLOC(3 * num_cell_ghost * sizeof(double));
+	mv->cell_cell_csr = (int *)ALLOC(h.num_csr * sizeof(int));
+	mv->cell_pt     = (int **)ALLOC(num_cell_ghost * sizeof(int *));
+	MSH_RD(mv->X, h.num_pt * sizeof(double));
+	MSH_RD(mv->Y, h.num_pt * sizeof(double));
+	MSH_RD(mv->cell_pt_csr, h.num_csr * sizeof(int));
+	MSH_RD(mv->cell_type, num_cell_ghost * sizeof(int));
+	MSH_RD(mv->border_pt, num_bp * sizeof(int));
+	MSH_RD(mv->border_cond, (num_bp-1) * sizeof(int));
+	MSH_RD(mv->geom, 3 * num_cell_ghost * sizeof(double));
+	MSH_RD(mv->cell_cell_csr, h.num_csr * sizeof(int));
+	for(k = 0, len = 0; k < num_cell_ghost; k++)
+		{
+			if (len >= (size_t)h.num_csr)
+				goto return_0;
+			mv->cell_pt[k] = mv->cell_pt_csr + len;
+			len += mv->cell_pt[k][0] + 1;
+		}
+	ok = len == (size_t)h.num_csr;
+ return_0:
+	msh_unmap(buf, (size_t)(end - buf), mapped);
+	if (!ok)
+		{
+			FREE(mv->X);
+			FREE(mv->Y);
+			FREE(mv->cell_pt_csr);
+			FREE(mv->cell_type);
+			FREE(mv->border_pt);
+			FREE(mv->border_cond);
+			FREE(mv->geom);
+			FREE(mv->cell_cell_csr);
 			FREE(mv->cell_pt);
+			mv->num_ghost = mv->num_pt = 0;
 		}
-	return 0;
+	return ok;
+}
+
+/**
+ * @brief This function computes the geometry of the grid cells of the mesh read, and writes the preprocessed mesh file.
+ * @param[in]     cache: Address of the preprocessed mesh file.
+ * @param[in,out] mv:    Structure of meshing variable data, with the rows of 'cell_pt' in the block 'cell_pt_csr'.
+ */
+void msh_cache_write(const char * cache, struct mesh_var * mv)
+{
+	const int num_cell_ghost = mv->num_ghost + (int)config[3];
+	struct msh_cache_head h;
+	FILE * fp;
+
+	msh_geom(mv);
+	msh_cache_head(&h, mv);
+	h.num_csr = (int)(mv->cell_pt[num_cell_ghost-1] - mv->cell_pt_csr) + mv->cell_pt[num_cell_ghost-1][0] + 1;
+	if ((fp = fopen(cache, "wb")) == NULL)
+		{
+			printf("Cannot write the preprocessed mesh file(%s)!\n", cache);
+			return;
+		}
+	fwrite(&h, sizeof(h), 1, fp);
+	fwrite(mv->X, sizeof(double), mv->num_pt, fp);
+	fwrite(mv->Y, sizeof(double), mv->num_pt, fp);
+	fwrite(mv->cell_pt_csr, sizeof(int), h.num_csr, fp);
+	fwrite(mv->cell_type, sizeof(int), num_cell_ghost, fp);
+	fwrite(mv->border_pt, sizeof(int), mv->num_border[1] + 1, fp);
+	fwrite(mv->border_cond, sizeof(int), mv->num_border[1], fp);
+	fwrite(mv->geom, sizeof(double), 3 * num_cell_ghost, fp);
+	fwrite(mv->cell_cell_csr, sizeof(int), h.num_csr, fp);
+	if (ferror(fp))
+		printf("Write error occurrs in the preprocessed mesh file(%s)!\n", cache);
+	fclose(fp);
 }
@@ -68,6 +68,12 @@ static int quad_mesh_init(struct mesh_var * mv, int n_x_add, int n_y_add)
 			mv->cell_pt[k][4] = mv->cell_pt[k][3] - 1;
 		}
 
+	if(mv->num_ghost == 0) // logically rectangular grids without ghost cells
+		{
+			mv->quad_nx = n_x;
+			mv->quad_ny = n_y;
+		}
+
 	mv->num_border[0] = 1;	
 	mv->num_border[1] = num_border;	
 	mv->border_pt = (int*)ALLOC((num_border+1) * sizeof(int));	
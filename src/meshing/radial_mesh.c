@@ -51,7 +51,8 @@ struct radial_mesh_var radial_mesh_init(const char *example)
 
 
 /**
- * @brief This function updates radially symmetric meshing variables after each time step update.
+ * @brief This function updates radially symmetric meshing variables from the cell boundaries and centroids.
+ * @details The GRP scheme moves the mesh cell by cell in its update loop, so this is used for the initial mesh.
  * @param[in,out] rmv: Structure of radially symmetric meshing variable data.
  */
 void radial_mesh_update(struct radial_mesh_var *rmv)
@@ -70,7 +71,7 @@ void radial_mesh_update(struct radial_mesh_var *rmv)
 
 	for(int i = 0; i <= Ncell; i++)
 		{
-			dRc[i]  = RR[i]-RR[i-1];
+			dRc[i]  = i ? RR[i]-RR[i-1] : RR[0]; // distance from the center for cell 0
 			DdrL[i] = Rb[i+1]-RR[i]; // Right side length of cell i
 			DdrR[i] = RR[i]-Rb[i];   // Left  side length of cell i
 			Ddr[i]  = DdrL[i]+DdrR[i];
@@ -87,6 +88,91 @@ void radial_mesh_update(struct radial_mesh_var *rmv)
 }
 
 
+//! The first moment (centroidal radius × area) of the trapezoid of the wedge between the radii r_L < r_R.
+static inline double radial_moment(const double r_L, const double r_R, const double tan_h)
+{
+    const double L_L = 2.0*r_L*tan_h, L_R = 2.0*r_R*tan_h;
+    return (r_R-(2.*L_L+L_R)/(3.*(L_L+L_R))*(r_R-r_L))*0.5*(L_L+L_R)*(r_R-r_L);
+}
+
+//! This function updates the geometry of the cell i (> 0) from its boundaries Rb[i] and Rb[i+1].
+static inline void radial_cell_update(struct radial_mesh_var *rmv, const int i)
+{
+    double * Rb = rmv->Rb, * Lb = rmv->Lb, * RR = rmv->RR;
+    RR[i] = Rb[i+1]-(2.*Lb[i]+Lb[i+1])/(3.*(Lb[i]+Lb[i+1]))*(Rb[i+1]-Rb[i]);
+    rmv->DdrL[i] = Rb[i+1]-RR[i];
+    rmv->DdrR[i] = RR[i]-Rb[i];
+    rmv->Ddr[i]  = rmv->DdrL[i]+rmv->DdrR[i];
+    rmv->vol[i]  = RR[i]*0.5*(Lb[i]+Lb[i+1])*rmv->Ddr[i];
+}
+
+/**
+ * @brief This function rezones the compressed cells of the Lagrangian radial mesh locally, and remaps the fluid
+ *        variables conservatively, so that the length of the time step does not collapse.
+ * @details Each cell narrower than frac times the mean width of the cells 1, …, Ncell shares its widest neighbour
+ *          of the same gas (gamma), and the boundary between them is moved to the middle of the pair. The volume swept
+ *          by the boundary carries the mass, momentum and total energy of the cell which loses it to the other cell
+ *          (donor cell remap), so the mass, momentum and energy are conserved, the losing cell keeps its state,
+ *          and the gamma of the cells is unchanged. The boundaries between the gases (contact interfaces),
+ *          the boundary of the center cell 0 and the outer boundary are never moved.
+ *          The slopes of the rezoned cells are reset to zero.
+ * @param[in,out] rmv:   Structure of radially symmetric meshing variable data.
+ * @param[in]     frac:  Fraction of the mean width below which a cell is rezoned.
+ * @param[in,out] mass:  Mass of the cells.
+ * @param[in,out] RHO, U, P, E: Density, velocity, pressure and specific total energy of the cells.
+ * @param[in]     gamma: Ratio of specific heats of the cells.
+ * @param[out]    d_rho, d_u, d_p: Slopes of the density, velocity and pressure of the cells.
+ * @return    Number of the boundaries moved.
+ */
+int radial_mesh_rezone(struct radial_mesh_var *rmv, const double frac, double * mass, double * RHO, double * U, double * P,
+		       double * E, const double * gamma, double * d_rho, double * d_u, double * d_p)
+{
+    int    const Ncell = (int)config[3]; // Number of computing cells in r direction
+    double const tan_h = tan(0.5*config[11]);
+    double * Rb = rmv->Rb, * Lb = rmv->Lb, * Ddr = rmv->Ddr;
+    double const lim = frac*(Rb[Ncell+1]-Rb[1])/Ncell;
+    int i, j, b, a, c, d, r, n_move = 0;
+    double r_n, m_s;
+
+    for(i = 1; i <= Ncell; i++)
+	{
+	    if(!(Ddr[i] < lim))
+		continue;
+	    j = -1; // the widest neighbour of the same gas
+	    if(i > 1 && gamma[i-1] == gamma[i])
+		j = i-1;
+	    if(i < Ncell && gamma[i+1] == gamma[i] && (j < 0 || Ddr[i+1] > Ddr[j]))
+		j = i+1;
+	    if(j < 0 || !(Ddr[j] > Ddr[i]))
+		continue;
+	    a = i < j ? i : j; // the pair of cells [a, c] and their boundary b
+	    c = a+1;
+	    b = c;
+	    r_n = 0.5*(Rb[a]+Rb[c+1]);
+	    d = r_n > Rb[b] ? c : a; // the cell which loses the swept volume to the other one
+	    r = d == c ? a : c;
+	    m_s = RHO[d]*fabs(radial_moment(fmin(r_n, Rb[b]), fmax(r_n, Rb[b]), tan_h));
+	    U[r] = (mass[r]*U[r] + m_s*U[d])/(mass[r] + m_s);
+	    E[r] = (mass[r]*E[r] + m_s*E[d])/(mass[r] + m_s);
+	    mass[r] += m_s;
+	    mass[d] -= m_s;
+	    Rb[b] = r_n;
+	    Lb[b] = 2.0*r_n*tan_h;
+	    for(d = a; d <= c; d++)
+		{
+		    radial_cell_update(rmv, d);
+		    RHO[d] = mass[d]/rmv->vol[d];
+		    P[d]   = (E[d] - 0.5*U[d]*U[d]) * (gamma[d]-1.0) * RHO[d];
+		    d_rho[d] = d_u[d] = d_p[d] = 0.0;
+		}
+	    for(d = a; d <= c+1; d++)
+		rmv->dRc[d] = rmv->RR[d]-rmv->RR[d-1];
+	    n_move++;
+	}
+    return n_move;
+}
+
+
 /**
  * @brief This function free memory for storing radially symmetric meshing variables.
  * @param[out] rmv: Structure of radially symmetric meshing variable data.
@@ -10,27 +10,20 @@
 #include "../include/var_struc.h"
 
 
+#ifdef __linux__
+static inline void HLL_2D_flux_state(double F[4], double * lambda_max, const double gamma, const double n_x, const double n_y,
+				     const double RHO_L, const double U_L, const double V_L, const double P_L,
+				     const double RHO_R, const double U_R, const double V_R, const double P_R) __attribute__((always_inline));
+#endif
+
 /**
- * @brief A HLL approxiamate Riemann solver for unsteady compressible inviscid single-component flow in two space dimension.
- * @param[out] F:          All four fluxes.
- * @param[out] lambda_max: Maximum characteristic velocity.
- * @param[in] ifv_L: Left  States (rho_L, u_L, v_L, p_L, gamma, n_x, n_y).
- * @param[in] ifv_R: Right States (rho_R, u_R, v_R, p_R).
- *                   - gamma: the constant of the perfect gas.
- *                   - (n_x, n_y): unit normal vector coordinates.
- * @sa   Theory is found in Chapter 10 of Reference [1]. \n
- *       [1] E. F. Toro, "Riemann Solvers and Numerical Methods for Fluid Dynamics". 
- *           Springer-Verlag, Second Edition, 1999
+ * @brief The HLL flux at an interface given by the primitive variables on both sides,
+ *        shared by HLL_2D_solver() and HLL_2D_solver_batch().
  */
-void HLL_2D_solver(double * F, double * lambda_max, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R)
+static inline void HLL_2D_flux_state(double F[4], double * lambda_max, const double gamma, const double n_x, const double n_y,
+				     const double RHO_L, const double U_L, const double V_L, const double P_L,
+				     const double RHO_R, const double U_R, const double V_R, const double P_R)
 {
-	const double gamma = ifv_L->gamma;
-	const double n_x   = ifv_L->n_x, n_y   = ifv_L->n_y;
-	const double P_L   = ifv_L->P,   P_R   = ifv_R->P;
-	const double RHO_L = ifv_L->RHO, RHO_R = ifv_R->RHO;
-	const double U_L   = ifv_L->U,   U_R   = ifv_R->U;
-	const double V_L   = ifv_L->V,   V_R   = ifv_R->V;
-
 	double H_L, H_R;
 	H_L = gamma/(gamma-1.0)*P_L/RHO_L + 0.5*(U_L*U_L+V_L*V_L);
 	H_R = gamma/(gamma-1.0)*P_R/RHO_R + 0.5*(U_R*U_R+V_R*V_R);
@@ -73,3 +66,56 @@ void HLL_2D_solver(double * F, double * lambda_max, const struct i_f_var *ifv_L,
 }
 
 
+/**
+ * @brief A HLL approxiamate Riemann solver for unsteady compressible inviscid single-component flow in two space dimension.
+ * @param[out] F:          All four fluxes.
+ * @param[out] lambda_max: Maximum characteristic velocity.
+ * @param[in] ifv_L: Left  States (rho_L, u_L, v_L, p_L, gamma, n_x, n_y).
+ * @param[in] ifv_R: Right States (rho_R, u_R, v_R, p_R).
+ *                   - gamma: the constant of the perfect gas.
+ *                   - (n_x, n_y): unit normal vector coordinates.
+ * @sa   Theory is found in Chapter 10 of Reference [1]. \n
+ *       [1] E. F. Toro, "Riemann Solvers and Numerical Methods for Fluid Dynamics". 
+ *           Springer-Verlag, Second Edition, 1999
+ */
+void HLL_2D_solver(double * F, double * lambda_max, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R)
+{
+	HLL_2D_flux_state(F, lambda_max, ifv_L->gamma, ifv_L->n_x, ifv_L->n_y,
+			  ifv_L->RHO, ifv_L->U, ifv_L->V, ifv_L->P, ifv_R->RHO, ifv_R->U, ifv_R->V, ifv_R->P);
+}
+
+
+/**
+ * @brief A batched HLL solver for a block of interfaces of single-component flow in two space dimension.
+ * @details The states are given as structures of arrays, and the fluxes of each interface are the same as
+ *          those given by HLL_2D_solver(). The loop over the interfaces may be vectorized, with the maximum
+ *          characteristic velocity reduced over the block.
+ * @param[in]  n:          the number of interfaces in the block.
+ * @param[out] F:          the arrays of all four fluxes.
+ * @param[out] lambda_max: Maximum characteristic velocity of the block.
+ * @param[in] ifv_L: Left  States (rho_L, u_L, v_L, p_L, gamma, n_x, n_y).
+ * @param[in] ifv_R: Right States (rho_R, u_R, v_R, p_R).
+ */
+void HLL_2D_solver_batch(const int n, double * const F[4], double * lambda_max,
+			 const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R)
+{
+	const double * restrict gamma = ifv_L->gamma, * restrict n_x = ifv_L->n_x, * restrict n_y = ifv_L->n_y;
+	const double * restrict RHO_L = ifv_L->RHO, * restrict U_L = ifv_L->U, * restrict V_L = ifv_L->V, * restrict P_L = ifv_L->P;
+	const double * restrict RHO_R = ifv_R->RHO, * restrict U_R = ifv_R->U, * restrict V_R = ifv_R->V, * restrict P_R = ifv_R->P;
+	double * restrict F_0 = F[0], * restrict F_1 = F[1], * restrict F_2 = F[2], * restrict F_3 = F[3];
+	double lm = 0.0;
+	int k;
+#pragma omp simd reduction(max:lm)
+	for(k = 0; k < n; k++)
+		{
+			double F_k[4], lm_k;
+			HLL_2D_flux_state(F_k, &lm_k, gamma[k], n_x[k], n_y[k], RHO_L[k], U_L[k], V_L[k], P_L[k],
+					  RHO_R[k], U_R[k], V_R[k], P_R[k]);
+			F_0[k] = F_k[0];
+			F_1[k] = F_k[1];
+			F_2[k] = F_k[2];
+			F_3[k] = F_k[3];
+			lm = lm > lm_k ? lm : lm_k;
+		}
+	*lambda_max = lm;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file  hllc_2D_solver.c
+ * @brief This is a two-dimensional HLLC solver for compressible inviscid flow.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../include/var_struc.h"
+#include "../include/riemann_solver.h"
+
+
+/**
+ * @brief The star state and the wave speeds of the HLLC approximate Riemann solver with the pressure-based wave speed estimates.
+ * @details The outputs stand in for those of Riemann_solver_exact() without any iteration.
+ *          The pressure may be negative for the strong rarefaction waves near the vacuum.
+ * @param[out] U_star: Velocity in the star region (the speed of the contact wave).
+ * @param[out] P_star: Pressure in the star region.
+ * @param[out] S:      The speeds of the left and right waves.
+ * @param[out] CRW:    Centred Rarefaction Wave (CRW) Indicator of left and right waves.
+ *                     - true: CRW
+ *                     - false: Shock wave
+ * @param[in] gammaL, gammaR: Ratio of specific heats.
+ * @param[in] rho_L, rho_R, u_L, u_R, p_L, p_R, c_L, c_R: Left/Right initial states (density, velocity, pressure, sound speed).
+ * @sa   Theory is found in Chapter 10.6 of Reference [1]. \n
+ *       [1] E. F. Toro, "Riemann Solvers and Numerical Methods for Fluid Dynamics".
+ *           Springer-Verlag, Second Edition, 1999
+ */
+void HLLC_star(double * U_star, double * P_star, double * S, _Bool * CRW, const double gammaL, const double gammaR,
+	       const double rho_L, const double rho_R, const double u_L, const double u_R,
+	       const double p_L, const double p_R, const double c_L, const double c_R)
+{
+	double p_0, q_L, q_R, m_L, m_R;
+	// PVRS estimate of the pressure, which decides the shock or rarefaction speeds
+	p_0 = 0.5*(p_L+p_R) - 0.125*(u_R-u_L)*(rho_L+rho_R)*(c_L+c_R);
+	p_0 = fmax(0.0, p_0);
+	q_L = p_0 > p_L ? sqrt(1.0 + 0.5*(gammaL+1.0)/gammaL*(p_0/p_L-1.0)) : 1.0;
+	q_R = p_0 > p_R ? sqrt(1.0 + 0.5*(gammaR+1.0)/gammaR*(p_0/p_R-1.0)) : 1.0;
+	S[0] = u_L - c_L*q_L;
+	S[1] = u_R + c_R*q_R;
+
+	// the mass fluxes through the left and right waves
+	m_L = rho_L*(S[0]-u_L);
+	m_R = rho_R*(S[1]-u_R);
+	*U_star = (p_R-p_L + m_L*u_L - m_R*u_R)/(m_L-m_R);
+	*P_star = p_L + m_L*(*U_star-u_L);
+	CRW[0] = *P_star <= p_L;
+	CRW[1] = *P_star <= p_R;
+}
+
+
+/**
+ * @brief A HLLC approximate Riemann solver for unsteady compressible inviscid two-component flow in two space dimension.
+ * @details The contact wave is resolved in the star regions, so that the two-component variables are advected by it
+ *          as in the exact Riemann solver. The fluxes are those of the state at the t-axis, whose energy is given by
+ *          the Rankine-Hugoniot condition of the left or right wave.
+ * @param[out] F:          All four fluxes.
+ * @param[out] lambda_max: Maximum characteristic velocity.
+ * @param[out] U:          The state at the t-axis in the normal and tangential directions. \n
+ *                           [rho_mid, u_mid, v_mid, p_mid, z_a_mid, phi_mid]
+ * @param[in] ifv_L: Left  States (rho_L, u_L, v_L, p_L, z_a_L, phi_L, gammaL, n_x, n_y).
+ * @param[in] ifv_R: Right States (rho_R, u_R, v_R, p_R, z_a_R, phi_R, gammaR).
+ *                   - gamma: the constant of the perfect gas.
+ *                   - (n_x, n_y): unit normal vector coordinates.
+ * @sa   Theory is found in Chapter 10 of Reference [1]. \n
+ *       [1] E. F. Toro, "Riemann Solvers and Numerical Methods for Fluid Dynamics".
+ *           Springer-Verlag, Second Edition, 1999
+ */
+void HLLC_2D_solver(double * F, double * lambda_max, double * U, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R)
+{
+	const double gammaL = ifv_L->gamma, gammaR = ifv_R->gamma;
+	const double n_x   = ifv_L->n_x, n_y   = ifv_L->n_y;
+	const double P_L   = ifv_L->P,   P_R   = ifv_R->P;
+	const double RHO_L = ifv_L->RHO, RHO_R = ifv_R->RHO;
+
+	double qn_L, qt_L, qn_R, qt_R;
+	qn_L =  ifv_L->U*n_x + ifv_L->V*n_y;
+	qt_L = -ifv_L->U*n_y + ifv_L->V*n_x;
+	qn_R =  ifv_R->U*n_x + ifv_R->V*n_y;
+	qt_R = -ifv_R->U*n_y + ifv_R->V*n_x;
+
+	double C_L, C_R;
+	C_L = sqrt(gammaL*P_L/RHO_L);
+	C_R = sqrt(gammaR*P_R/RHO_R);
+
+	double S[2], S_star, P_star;
+	_Bool CRW[2];
+	HLLC_star(&S_star, &P_star, S, CRW, gammaL, gammaR, RHO_L, RHO_R, qn_L, qn_R, P_L, P_R, C_L, C_R);
+
+	// the side of the contact wave, and whether the t-axis is in its star region
+	const _Bool left = S_star >= 0.0;
+	const _Bool star = left ? S[0] < 0.0 : S[1] > 0.0;
+	const double rho = left ? RHO_L : RHO_R;
+	const double p   = left ?   P_L :   P_R;
+	const double qn  = left ?  qn_L :  qn_R;
+	const double qt  = left ?  qt_L :  qt_R;
+	const double S_K = left ?  S[0] :  S[1];
+	double E = p/((left ? gammaL : gammaR)-1.0)/rho + 0.5*(qn*qn+qt*qt);
+
+	if (star)
+		{
+			E   += (S_star-qn)*(S_star + p/(rho*(S_K-qn)));
+			U[0] = rho*(S_K-qn)/(S_K-S_star);
+			U[1] = S_star;
+			U[3] = P_star;
+		}
+	else
+		{
+			U[0] = rho;
+			U[1] = qn;
+			U[3] = p;
+		}
+	U[2] = qt;
+#ifdef MULTIFLUID_BASICS
+	U[4] = left ? ifv_L->Z_a : ifv_R->Z_a;
+	U[5] = left ? ifv_L->PHI : ifv_R->PHI;
+#else
+	U[4] = 0.0;
+	U[5] = 0.0;
+#endif
+
+	double Fn, Ft;
+	F[0] = U[0]*U[1];
+	Fn   = F[0]*U[1] + U[3];
+	Ft   = F[0]*U[2];
+	F[1] = Fn*n_x - Ft*n_y;
+	F[2] = Fn*n_y + Ft*n_x;
+	F[3] = (U[0]*E + U[3])*U[1];
+
+	*lambda_max = fmax(fabs(S[0]), fabs(S[1]));
+}
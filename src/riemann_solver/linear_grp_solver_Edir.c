@@ -5,6 +5,7 @@
 
 #include <math.h>
 #include <stdio.h>
+#include <stdbool.h>
 
 #include "../include/var_struc.h"
 #include "../include/riemann_solver.h"
@@ -31,6 +32,38 @@
  *           Journal of Computational Physics, 218.1: 19-43, 2006.
  */
 void linear_GRP_solver_Edir(double * D, double * U, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc)
+{
+  double p_star = 0.0; // no initial guess
+  linear_GRP_solver_Edir_warm(D, U, ifv_L, ifv_R, eps, atc, &p_star, NULL);
+}
+
+
+/**
+ * @brief A direct Eulerian GRP solver along the grid interface moving with the velocity ifv_L->lambda_u.
+ * @details By the Galilean invariance of the Euler equations, the solution along x = lambda_u*t is that on the t-axis
+ *          of the problem with the velocities relative to the interface, whose velocity is shifted back afterwards.
+ *          The temporal derivatives D are taken along the moving interface, (∂_t + lambda_u*∂_x)[rho, u, p].
+ * @sa    Other parameters are the same as linear_GRP_solver_Edir().
+ */
+void linear_GRP_solver_Edir_moving(double * D, double * U, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc)
+{
+  const double lambda_u = ifv_L->lambda_u;
+  struct i_f_var ifv_L_m = *ifv_L, ifv_R_m = *ifv_R; // the states in the frame of the interface
+  ifv_L_m.U -= lambda_u;
+  ifv_R_m.U -= lambda_u;
+  linear_GRP_solver_Edir(D, U, &ifv_L_m, &ifv_R_m, eps, atc);
+  U[1] += lambda_u;
+}
+
+
+/**
+ * @brief A direct Eulerian GRP solver whose exact Riemann solver is started from a given guess of the star pressure.
+ * @param[in,out] P_star: the star pressure, the initial guess of the Newton iteration on input (not used if it ≤ eps).
+ * @param[out] n_iter: Number of the Newton iterations (not given if it is NULL).
+ * @sa    Other parameters are the same as linear_GRP_solver_Edir().
+ */
+void linear_GRP_solver_Edir_warm(double * D, double * U, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc,
+				 double * P_star, int * n_iter)
 {
   const double   rho_L = ifv_L->RHO,     rho_R = ifv_R->RHO;
   const double s_rho_L = ifv_L->d_rho, s_rho_R = ifv_R->d_rho;
@@ -65,10 +98,13 @@ void linear_GRP_solver_Edir(double * D, double * U, const struct i_f_var *ifv_L,
 	  c_star_R = c_R;
 	  u_star = 0.5*(u_R+u_L);
 	  p_star = 0.5*(p_R+p_L);
+	  if(n_iter)
+	      *n_iter = 0;
       }
   else
       {
-	  Riemann_solver_exact_single(&u_star, &p_star, gamma, u_L, u_R, p_L, p_R, c_L, c_R, CRW, eps, eps, 50);
+	  p_star = *P_star;
+	  Riemann_solver_exact_single_warm(&u_star, &p_star, gamma, u_L, u_R, p_L, p_R, c_L, c_R, CRW, eps, eps, 50, n_iter);
 
 	  if(p_star > p_L)
 	      rho_star_L = rho_L*(p_star+zeta*p_L)/(p_L+zeta*p_star);
@@ -81,6 +117,7 @@ void linear_GRP_solver_Edir(double * D, double * U, const struct i_f_var *ifv_L,
 	  c_star_L = sqrt(gamma * p_star / rho_star_L);
 	  c_star_R = sqrt(gamma * p_star / rho_star_R);
       }
+  *P_star = p_star;
 
 //=========acoustic case==========
   if(dist < atc)
@@ -335,3 +372,276 @@ void linear_GRP_solver_Edir(double * D, double * U, const struct i_f_var *ifv_L,
   //----end of non-trivial case----
   }
 }
+
+
+/**
+ * @brief The batched direct Eulerian GRP solver shared by the general and the constant-gamma flows.
+ * @details The variables on both sides are given as structures of arrays. After the exact Riemann
+ *          solver has been called for each interface, the solutions of all the wave patterns are
+ *          evaluated and chosen by masks, so that the loop over the interfaces may be vectorized.
+ *          With a constant pointer gc, the compiler specialises the loop for the constant gamma.
+ * @param[in]  n:     the number of interfaces in the block.
+ * @param[out] D:     the temporal derivative arrays of fluid variables. \n
+ *                      [rho, u, p]_t
+ * @param[out] U:     the intermediate Riemann solution arrays at t-axis. \n
+ *                      [rho_mid, u_mid, p_mid]
+ * @param[in] ifv_L:  Left  States (rho_L, u_L, p_L, s_rho_L, s_u_L, s_p_L, gamma).
+ * @param[in] ifv_R:  Right States (rho_R, u_R, p_R, s_rho_R, s_u_R, s_p_R).
+ *                     - s_rho, s_u, s_p: x-spatial derivatives.
+ * @param[in] gc:     the constants of the perfect gas (NULL: gamma given on each interface).
+ * @param[in] eps:    the largest value could be seen as zero.
+ * @param[in] atc:    Parameter that determines the solver type, as in linear_GRP_solver_Edir().
+ */
+static inline void GRP_Edir_batch(const int n, double * const D[3], double * const U[3],
+				  const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R,
+				  const struct gamma_const * gc, const double eps, const double atc)
+{
+  double u_star[GRP_BATCH_SIZE], p_star[GRP_BATCH_SIZE];
+  double c_L[GRP_BATCH_SIZE], c_R[GRP_BATCH_SIZE];
+  _Bool CRW_L[GRP_BATCH_SIZE], CRW_R[GRP_BATCH_SIZE];
+  _Bool CRW[2];
+  double dist;
+  int i, j0, nb;
+
+  for(j0 = 0; j0 < n; j0 += GRP_BATCH_SIZE)
+      {
+	  nb = n - j0 < GRP_BATCH_SIZE ? n - j0 : GRP_BATCH_SIZE;
+	  // The iterative Riemann solver stays one interface at a time.
+	  for(i = 0; i < nb; ++i)
+	      {
+		  const int j = j0 + i;
+		  const double u_L = ifv_L->U[j], u_R = ifv_R->U[j];
+		  const double p_L = ifv_L->P[j], p_R = ifv_R->P[j];
+		  const double gamma = gc ? gc->gamma : ifv_L->gamma[j];
+		  c_L[i] = sqrt(gamma * p_L / ifv_L->RHO[j]);
+		  c_R[i] = sqrt(gamma * p_R / ifv_R->RHO[j]);
+		  dist = sqrt((u_L-u_R)*(u_L-u_R) + (p_L-p_R)*(p_L-p_R));
+		  if (dist < atc && atc < 2*eps)
+		      {
+			  u_star[i] = 0.5*(u_R+u_L);
+			  p_star[i] = 0.5*(p_R+p_L);
+			  CRW[0] = CRW[1] = false;
+		      }
+		  else
+		      Riemann_solver_exact_single(u_star+i, p_star+i, gamma, u_L, u_R, p_L, p_R, c_L[i], c_R[i], CRW, eps, eps, 50);
+		  CRW_L[i] = CRW[0];
+		  CRW_R[i] = CRW[1];
+	      }
+#pragma omp simd
+	  for(i = 0; i < nb; ++i)
+	      {
+		  const int j = j0 + i;
+		  const double   rho_L = ifv_L->RHO[j],     rho_R = ifv_R->RHO[j];
+		  const double s_rho_L = ifv_L->s_rho[j], s_rho_R = ifv_R->s_rho[j];
+		  const double     u_L = ifv_L->U[j],         u_R = ifv_R->U[j];
+		  const double   s_u_L = ifv_L->s_u[j],     s_u_R = ifv_R->s_u[j];
+		  const double     p_L = ifv_L->P[j],         p_R = ifv_R->P[j];
+		  const double   s_p_L = ifv_L->s_p[j],     s_p_R = ifv_R->s_p[j];
+		  const double   gamma = gc ? gc->gamma : ifv_L->gamma[j];
+		  const double zeta = gc ? gc->zeta : (gamma-1.0)/(gamma+1.0), zts = gc ? gc->zts : zeta*zeta;
+		  // the exponents of the isentropic relations
+		  const double e_rho = gc ? gc->e_rho : 1.0/gamma, e_p = gc ? gc->e_p : gamma/(gamma-1.0);
+		  const double e_A = gc ? gc->e_A : 0.5/zeta;
+		  const int    h_p = gc ? gc->h_p : 0, h_A = gc ? gc->h_A : 0;
+		  const double cL = c_L[i], cR = c_R[i], us = u_star[i], ps = p_star[i];
+		  const double dst = sqrt((u_L-u_R)*(u_L-u_R) + (p_L-p_R)*(p_L-p_R));
+		  const _Bool acs = dst < atc, triv = acs && atc < 2*eps;
+		  double rho_star_L, rho_star_R, c_star_L, c_star_R, speed_L, speed_R;
+		  double shk_rho, crw_rho;
+		  double TL_D0, TL_D1, TL_D2a, TL_D2n, TR_D0, TR_D1, TR_D2;
+		  double PI, rs_a, cs_a, AS_D1, AS_D2, AS_D0;
+		  double sc_L_U0, sc_L_U1, sc_L_U2, sc_R_U0, sc_R_U1, sc_R_U2;
+		  double sc_U0, sc_U1, sc_U2, sc_D0, sc_D1, sc_D2;
+		  double x_L, x_R, pA_L, pB_L, pA_R, pB_R, crw_d_L, crw_d_R;
+		  double H1, H2, H3, shk_spd, L_rho, L_u, L_p;
+		  double a_L, b_L, d_L, a_R, b_R, d_R, u_t_mat, p_t_mat;
+		  double rs, cs, rho_s, u_s, p_s, c_s, s_rho_s, s_u_s, s_p_s, pB_s;
+		  double g_rho, g_u, g_p, f, NS_D0, NS_D1, NS_D2, CR_D0, SH_D0;
+		  _Bool sonic_L, sonic_R, crw_s, m_L, m_R, m_S;
+
+		  //the star states
+		  shk_rho = rho_L*(ps+zeta*p_L)/(p_L+zeta*ps);
+		  crw_rho = rho_L*vmath_pow(ps/p_L,e_rho);
+		  rho_star_L = triv ? rho_L : (ps > p_L ? shk_rho : crw_rho);
+		  shk_rho = rho_R*(ps+zeta*p_R)/(p_R+zeta*ps);
+		  crw_rho = rho_R*vmath_pow(ps/p_R,e_rho);
+		  rho_star_R = triv ? rho_R : (ps > p_R ? shk_rho : crw_rho);
+		  c_star_L = triv ? cL : sqrt(gamma * ps / rho_star_L);
+		  c_star_R = triv ? cR : sqrt(gamma * ps / rho_star_R);
+
+		  //the t-axe is on the left or the right side of all the three waves
+		  TL_D0  = -s_rho_L*u_L - rho_L*s_u_L;
+		  TL_D1  = (TL_D0*u_L + s_rho_L*u_L*u_L + 2.0*rho_L*u_L*s_u_L + s_p_L) / -rho_L;
+		  TL_D2a = -(gamma-1.0) * (0.5*TL_D0*u_L*u_L + rho_L*u_L*TL_D1);
+		  TL_D2a = TL_D2a - s_u_L * (gamma*p_L + 0.5*(gamma-1.0)*rho_L*u_L*u_L);
+		  TL_D2a = TL_D2a - u_L * (gamma * s_p_L + (gamma-1.0)*(0.5*s_rho_L*u_L*u_L + rho_L*u_L*s_u_L));
+		  TL_D2n = (s_u_L*p_L + u_L*s_p_L)*gamma/(1.0-gamma) - 0.5*s_rho_L*u_L*u_L*u_L - 1.5*rho_L*u_L*u_L*s_u_L;
+		  TL_D2n = TL_D2n - 0.5*TL_D0*u_L*u_L - rho_L*u_L*TL_D1;
+		  TL_D2n = TL_D2n * (gamma-1.0);
+		  TR_D0 = -s_rho_R*u_R - rho_R*s_u_R;
+		  TR_D1 = (TR_D0*u_R + s_rho_R*u_R*u_R + 2.0*rho_R*u_R*s_u_R + s_p_R) / -rho_R;
+		  TR_D2 = -(gamma-1.0) * (0.5*TR_D0*u_R*u_R + rho_R*u_R*TR_D1);
+		  TR_D2 = TR_D2 - s_u_R * (gamma*p_R + 0.5*(gamma-1.0)*rho_R*u_R*u_R);
+		  TR_D2 = TR_D2 - u_R * (gamma * s_p_R + (gamma-1.0)*(0.5*s_rho_R*u_R*u_R + rho_R*u_R*s_u_R));
+
+		  //acoustic case in the star region
+		  rs_a    = us > 0.0 ? rho_star_L : rho_star_R;
+		  cs_a    = us > 0.0 ? c_star_L : c_star_R;
+		  s_p_s   = us > 0.0 ? s_p_L : s_p_R;
+		  s_rho_s = us > 0.0 ? s_rho_L : s_rho_R;
+		  PI = (us+c_star_R)*rho_star_L*c_star_L*c_star_L / (us-c_star_L)/rho_star_R/c_star_R/c_star_R;
+		  AS_D1 = (s_p_L/rho_L+cL*s_u_L)*PI/(1.0-PI) + (s_p_R/rho_R-cR*s_u_R)/(PI-1.0);
+		  AS_D2 = ((us+c_star_R)/rho_star_R/c_star_R/c_star_R) - ((us-c_star_L)/rho_star_L/c_star_L/c_star_L);
+		  AS_D2 = (s_p_R/rho_R-cR*s_u_R-s_p_L/rho_L-cL*s_u_L) / AS_D2;
+		  AS_D2 = AS_D2 * (1.0 - (us*us/cs_a/cs_a)) + rs_a*us*AS_D1;
+		  AS_D0 = (us*(s_p_s - s_rho_s*cs_a*cs_a) + AS_D2)/cs_a/cs_a;
+
+		  //the wave speeds
+		  speed_L = CRW_L[i] ? u_L - cL : (rho_star_L*us - rho_L*u_L) / (rho_star_L - rho_L);
+		  speed_R = CRW_R[i] ? u_R + cR : (rho_star_R*us - rho_R*u_R) / (rho_star_R - rho_R);
+		  sonic_L = CRW_L[i] && ((us-c_star_L) > 0.0);
+		  sonic_R = CRW_R[i] && ((us+c_star_R) < 0.0);
+
+		  //the sonic states in a 1-CRW and in a 3-CRW
+		  sc_L_U1 = zeta*(u_L+2.0*cL/(gamma-1.0));
+		  sc_L_U2 = sc_L_U1*sc_L_U1*rho_L/gamma/vmath_pow(p_L, e_rho);
+		  sc_L_U2 = gamma_pow(sc_L_U2, e_p, h_p);
+		  sc_L_U0 = gamma*sc_L_U2/sc_L_U1/sc_L_U1;
+		  sc_R_U1 = zeta*(u_R-2.0*cR/(gamma-1.0));
+		  sc_R_U2 = sc_R_U1*sc_R_U1*rho_R/gamma/vmath_pow(p_R, e_rho);
+		  sc_R_U2 = gamma_pow(sc_R_U2, e_p, h_p);
+		  sc_R_U0 = gamma*sc_R_U2/sc_R_U1/sc_R_U1;
+
+		  //the CRW coefficients share the same form at the sonic point and at the star state
+		  x_L  = sonic_L ? sc_L_U1/cL : c_star_L/cL;
+		  x_R  = sonic_R ? -sc_R_U1/cR : c_star_R/cR;
+		  pA_L = gamma_pow(x_L, e_A, h_A);
+		  pB_L = x_L*pA_L*pA_L; // e_B = 2*e_A + 1
+		  pA_R = gamma_pow(x_R, e_A, h_A);
+		  pB_R = x_R*pA_R*pA_R;
+		  crw_d_L = 0.5*(pA_L*(1.0+zeta) + pB_L*zeta)/(0.5+zeta);
+		  crw_d_L = crw_d_L * (s_p_L - s_rho_L*cL*cL)/(gamma-1.0)/rho_L;
+		  crw_d_L = crw_d_L - cL*pA_L*(s_u_L + (gamma*s_p_L/cL - cL*s_rho_L)/(gamma-1.0)/rho_L);
+		  crw_d_R = 0.5*(pA_R*(1.0+zeta) + pB_R*zeta)/(0.5+zeta);
+		  crw_d_R = crw_d_R * (s_p_R - s_rho_R*cR*cR)/(gamma-1.0)/rho_R;
+		  crw_d_R = crw_d_R + cR*pA_R*(s_u_R - (gamma*s_p_R/cR - cR*s_rho_R)/(gamma-1.0)/rho_R);
+
+		  //determine a_L, b_L and d_L
+		  H1 = 0.5*sqrt((1.0-zeta)/(rho_L*(ps+zeta*p_L))) * (ps + (1.0+2.0*zeta)*p_L)/(ps+zeta*p_L);
+		  H2 = -0.5*sqrt((1.0-zeta)/(rho_L*(ps+zeta*p_L))) * ((2.0+zeta)*ps + zeta*p_L)/(ps+zeta*p_L);
+		  H3 = -0.5*sqrt((1.0-zeta)/(rho_L*(ps+zeta*p_L))) * (ps-p_L) / rho_L;
+		  shk_spd = (rho_star_L*us - rho_L*u_L)/(rho_star_L - rho_L);
+		  L_rho = (u_L-shk_spd) * H3;
+		  L_u = shk_spd - u_L + rho_L*cL*cL*H2 + rho_L*H3;
+		  L_p = (u_L-shk_spd)*H2 - 1.0/rho_L;
+		  a_L = CRW_L[i] ? 1.0 : 1.0 - rho_star_L*(shk_spd-us)*H1;
+		  b_L = CRW_L[i] ? 1.0 / rho_star_L / c_star_L : (us - shk_spd)/rho_star_L/c_star_L/c_star_L + H1;
+		  d_L = CRW_L[i] ? crw_d_L : L_rho*s_rho_L + L_u*s_u_L + L_p*s_p_L;
+		  //determine a_R, b_R and d_R
+		  H1 = 0.5*sqrt((1.0-zeta)/(rho_R*(ps+zeta*p_R))) * (ps + (1.0+2.0*zeta)*p_R)/(ps+zeta*p_R);
+		  H2 = -0.5*sqrt((1.0-zeta)/(rho_R*(ps+zeta*p_R))) * ((2.0+zeta)*ps + zeta*p_R)/(ps+zeta*p_R);
+		  H3 = -0.5*sqrt((1.0-zeta)/(rho_R*(ps+zeta*p_R))) * (ps-p_R) / rho_R;
+		  shk_spd = (rho_star_R*us - rho_R*u_R)/(rho_star_R - rho_R);
+		  L_rho = (shk_spd-u_R) * H3;
+		  L_u = shk_spd - u_R - rho_R*cR*cR*H2 - rho_R*H3;
+		  L_p = (shk_spd-u_R)*H2 - 1.0/rho_R;
+		  a_R = CRW_R[i] ? 1.0 : 1.0 + rho_star_R*(shk_spd-us)*H1;
+		  b_R = CRW_R[i] ? -1.0 / rho_star_R / c_star_R : (us - shk_spd)/rho_star_R/c_star_R/c_star_R - H1;
+		  d_R = CRW_R[i] ? crw_d_R : L_rho*s_rho_R + L_u*s_u_R + L_p*s_p_R;
+
+		  p_t_mat = (d_L*a_R/a_L-d_R)/(b_L*a_R/a_L-b_R);
+		  u_t_mat = (d_L - b_L*p_t_mat)/a_L;
+
+		  //the t-axi is between the 1-wave and the contact discontinuety, or between the contact discontinuety and the 3-wave
+		  rs      = us < 0.0 ? rho_star_R : rho_star_L;
+		  cs      = us < 0.0 ? c_star_R : c_star_L;
+		  rho_s   = us < 0.0 ? rho_R : rho_L;
+		  u_s     = us < 0.0 ? u_R : u_L;
+		  p_s     = us < 0.0 ? p_R : p_L;
+		  c_s     = us < 0.0 ? cR : cL;
+		  s_rho_s = us < 0.0 ? s_rho_R : s_rho_L;
+		  s_u_s   = us < 0.0 ? s_u_R : s_u_L;
+		  s_p_s   = us < 0.0 ? s_p_R : s_p_L;
+		  pB_s    = us < 0.0 ? pB_R : pB_L;
+		  crw_s   = us < 0.0 ? CRW_R[i] : CRW_L[i];
+		  NS_D1 = u_t_mat + us*p_t_mat/rs/cs/cs;
+		  NS_D2 = p_t_mat + rs*us * u_t_mat;
+		  CR_D0 = rs*us*pB_s*(s_p_s - s_rho_s*c_s*c_s)/rho_s;
+		  CR_D0 = (CR_D0 + NS_D2) / cs/cs;
+		  shk_spd = (rs*us - rho_s*u_s)/(rs - rho_s);
+		  H1 = rho_s * p_s * (1.0 - zts) / (p_s + zeta*ps) / (p_s + zeta*ps);
+		  H2 = rho_s * ps  * (zts - 1.0) / (p_s + zeta*ps) / (p_s + zeta*ps);
+		  H3 = (ps + zeta*p_s) / (p_s + zeta*ps);
+		  g_rho = us-shk_spd;
+		  g_u   = us*rs*(shk_spd-us)*H1;
+		  g_p   = shk_spd/cs/cs - us*H1;
+		  f = (shk_spd-u_s)*(H2*s_p_s + H3*s_rho_s) - rho_s*(H2*c_s*c_s+H3)*s_u_s;
+		  SH_D0 = (f*us - g_p*p_t_mat - g_u*u_t_mat) / g_rho;
+		  NS_D0 = crw_s ? CR_D0 : SH_D0;
+
+		  //the t-axe is in a 1-CRW or a 3-CRW
+		  sc_U0 = sonic_L ? sc_L_U0 : sc_R_U0;
+		  sc_U1 = sonic_L ? sc_L_U1 : sc_R_U1;
+		  sc_U2 = sonic_L ? sc_L_U2 : sc_R_U2;
+		  sc_D1 = sonic_L ? crw_d_L : crw_d_R;
+		  sc_D2 = sc_U0*sc_U1*sc_D1;
+		  sc_D0 = sc_U0*sc_U1*(sonic_L ? pB_L : pB_R)*(sonic_L ? s_p_L - s_rho_L*cL*cL : s_p_R - s_rho_R*cR*cR)/(sonic_L ? rho_L : rho_R);
+		  sc_D0 = (sc_D0 + sc_D2) / sc_U1/sc_U1;
+
+		  //choose the wave pattern
+		  m_L = acs ? u_L-cL > 0.0 : speed_L > 0.0;
+		  m_R = !m_L && (acs ? u_R+cR < 0.0 : speed_R < 0.0);
+		  m_S = !m_L && !m_R && !acs && (sonic_L || sonic_R);
+		  U[0][j] = m_L ? rho_L : (m_R ? rho_R : (m_S ? sc_U0 : (acs ? rs_a : rs)));
+		  U[1][j] = m_L ? u_L   : (m_R ? u_R   : (m_S ? sc_U1 : us));
+		  U[2][j] = m_L ? p_L   : (m_R ? p_R   : (m_S ? sc_U2 : ps));
+		  D[0][j] = m_L ? TL_D0 : (m_R ? TR_D0 : (m_S ? sc_D0 : (acs ? AS_D0 : NS_D0)));
+		  D[1][j] = m_L ? TL_D1 : (m_R ? TR_D1 : (m_S ? sc_D1 : (acs ? AS_D1 : NS_D1)));
+		  D[2][j] = m_L ? (acs ? TL_D2a : TL_D2n) : (m_R ? TR_D2 : (m_S ? sc_D2 : (acs ? AS_D2 : NS_D2)));
+	      }
+      }
+}
+
+
+/**
+ * @brief A batched direct Eulerian GRP solver for a block of interfaces in one space dimension.
+ * @details The results agree with those of linear_GRP_solver_Edir() on each interface to rounding errors,
+ *          since the power with the exponent (1+ζ)/ζ is the product of x and the square of the power with 1/(2ζ).
+ * @param[in]  n:     the number of interfaces in the block.
+ * @param[out] D:     the temporal derivative arrays of fluid variables. \n
+ *                      [rho, u, p]_t
+ * @param[out] U:     the intermediate Riemann solution arrays at t-axis. \n
+ *                      [rho_mid, u_mid, p_mid]
+ * @param[in] ifv_L:  Left  States (rho_L, u_L, p_L, s_rho_L, s_u_L, s_p_L, gamma).
+ * @param[in] ifv_R:  Right States (rho_R, u_R, p_R, s_rho_R, s_u_R, s_p_R).
+ *                     - s_rho, s_u, s_p: x-spatial derivatives.
+ * @param[in] eps:    the largest value could be seen as zero.
+ * @param[in] atc:    Parameter that determines the solver type, as in linear_GRP_solver_Edir().
+ */
+void linear_GRP_solver_Edir_batch(const int n, double * const D[3], double * const U[3],
+				  const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R,
+				  const double eps, const double atc)
+{
+    GRP_Edir_batch(n, D, U, ifv_L, ifv_R, NULL, eps, atc);
+}
+
+/**
+ * @brief A batched direct Eulerian GRP solver for a block of interfaces of single-fluid flow with a constant gamma.
+ * @details The gamma array of ifv_L is not read, and gamma and its derived exponents are taken
+ *          from gc. The results agree with those of linear_GRP_solver_Edir_batch() to rounding errors,
+ *          since the half-integer powers are evaluated by multiplications in gamma_pow().
+ * @param[in]  n:     the number of interfaces in the block.
+ * @param[out] D:     the temporal derivative arrays of fluid variables.
+ * @param[out] U:     the intermediate Riemann solution arrays at t-axis.
+ * @param[in] ifv_L:  Left  States (rho_L, u_L, p_L, s_rho_L, s_u_L, s_p_L).
+ * @param[in] ifv_R:  Right States (rho_R, u_R, p_R, s_rho_R, s_u_R, s_p_R).
+ * @param[in] gc:     the constants of the perfect gas set by gamma_const_set().
+ * @param[in] eps:    the largest value could be seen as zero.
+ * @param[in] atc:    Parameter that determines the solver type, as in linear_GRP_solver_Edir().
+ */
+void linear_GRP_solver_Edir_batch_gc(const int n, double * const D[3], double * const U[3],
+				     const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R,
+				     const struct gamma_const * gc, const double eps, const double atc)
+{
+    GRP_Edir_batch(n, D, U, ifv_L, ifv_R, gc, eps, atc);
+}
@@ -32,6 +32,7 @@
  *                   - s_: normal derivatives.
  *                   - t_: tangential derivatives.
  *                   - gamma: the constant of the perfect gas.
+ * @param[in] ctx: Pointer to the run context.
  * @param[in] eps: the largest value could be seen as zero.
  * @param[in] atc: Parameter that determines the solver type.
  *              - INFINITY: acoustic approximation
@@ -46,7 +47,7 @@
  *       [1] 齐进, 二维欧拉方程广义黎曼问题数值建模及其应用. Ph.D Thesis, Beijing Normal University, 2017.
  */
 void linear_GRP_solver_Edir_G2D
-(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc)
+(const struct run_ctx * ctx, double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc)
 {
 	const double lambda_u = ifv_L->lambda_u, lambda_v = ifv_R->lambda_v;
 	const double  gammaL = ifv_L->gamma,  gammaR = ifv_R->gamma;
@@ -100,7 +101,7 @@ void linear_GRP_solver_Edir_G2D
 	double rho_x, f;
 	double speed_L, speed_R;
 #ifdef EXACT_TANGENT_DERIVATIVE
-	double da_y = 0.05*config[11];
+	double da_y = 0.05*ctx->conf[11];
 	double gammaL_up, gammaR_up, gammaL_dn, gammaR_dn;
 	double mid_up[6], star_up[6], mid_dn[6], star_dn[6];
 	double wave_speed_tmp[2], dire_tmp[6];
@@ -306,11 +307,11 @@ void linear_GRP_solver_Edir_G2D
 		{
 			// calculate T_rho, T_u, T_v, T_p, T_z, T_phi
 #ifdef EXACT_TANGENT_DERIVATIVE
-			gammaL_up = 1.0/((z_L+da_y*t_z_L)/(config[6]-1.0)+(1.0-(z_L+da_y*t_z_L))/(config[106]-1.0))+1.0;
-			gammaR_up = 1.0/((z_R+da_y*t_z_R)/(config[6]-1.0)+(1.0-(z_R+da_y*t_z_R))/(config[106]-1.0))+1.0;
+			gammaL_up = 1.0/((z_L+da_y*t_z_L)/(ctx->conf[6]-1.0)+(1.0-(z_L+da_y*t_z_L))/(ctx->conf[106]-1.0))+1.0;
+			gammaR_up = 1.0/((z_R+da_y*t_z_R)/(ctx->conf[6]-1.0)+(1.0-(z_R+da_y*t_z_R))/(ctx->conf[106]-1.0))+1.0;
 			linear_GRP_solver_Edir_Q1D(wave_speed_tmp, dire_tmp, mid_up, star_up, 0.0, 0.0, rho_L+da_y*t_rho_L, rho_R+da_y*t_rho_R, -0.0, -0.0, -0.0, -0.0, u_L+da_y*t_u_L, u_R+da_y*t_u_R, -0.0, -0.0, -0.0, -0.0, 0.0, 0.0, -0.0, -0.0, -0.0, -0.0, p_L+da_y*t_p_L, p_R+da_y*t_p_R, -0.0, -0.0, -0.0, -0.0, 0.0, 0.0, -0.0, -0.0, -0.0, -0.0, 0.0, 0.0, -0.0, -0.0, -0.0, -0.0, gammaL_up, gammaR_up, eps*da_y, -0.0);
-			gammaL_dn = 1.0/((z_L-da_y*t_z_L)/(config[6]-1.0)+(1.0-(z_L-da_y*t_z_L))/(config[106]-1.0))+1.0;
-			gammaR_dn = 1.0/((z_R-da_y*t_z_R)/(config[6]-1.0)+(1.0-(z_R-da_y*t_z_R))/(config[106]-1.0))+1.0;
+			gammaL_dn = 1.0/((z_L-da_y*t_z_L)/(ctx->conf[6]-1.0)+(1.0-(z_L-da_y*t_z_L))/(ctx->conf[106]-1.0))+1.0;
+			gammaR_dn = 1.0/((z_R-da_y*t_z_R)/(ctx->conf[6]-1.0)+(1.0-(z_R-da_y*t_z_R))/(ctx->conf[106]-1.0))+1.0;
 			linear_GRP_solver_Edir_Q1D(wave_speed_tmp, dire_tmp, mid_dn, star_dn, 0.0, 0.0, rho_L-da_y*t_rho_L, rho_R-da_y*t_rho_R, -0.0, -0.0, -0.0, -0.0, u_L-da_y*t_u_L, u_R-da_y*t_u_R, -0.0, -0.0, -0.0, -0.0, 0.0, 0.0, -0.0, -0.0, -0.0, -0.0, p_L-da_y*t_p_L, p_R-da_y*t_p_R, -0.0, -0.0, -0.0, -0.0, 0.0, 0.0, -0.0, -0.0, -0.0, -0.0, 0.0, 0.0, -0.0, -0.0, -0.0, -0.0, gammaL_dn, gammaR_dn, eps*da_y, -0.0);
 
 			if (CRW[0] && ((u_star-c_star_L) > lambda_u||(star_up[1]-star_up[4]) > lambda_u||(star_dn[1]-star_dn[4]) > lambda_u)) //the direction is in a 1-CRW
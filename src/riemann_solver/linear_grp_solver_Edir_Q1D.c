@@ -9,6 +9,92 @@
 #include "../include/var_struc.h"
 #include "../include/riemann_solver.h"
 
+/**
+ * @brief The acoustic path of GRP_Edir_Q1D() for a weak jump, which needs no iteration of the Riemann solver.
+ * @details The star state is given by the linearised Riemann solver, and the region of the t-axis is chosen
+ *          by ternaries, so that all the regions share the same formulae of the temporal derivatives:
+ *          - the left or the right side of all the three waves: the initial state and its slopes.
+ *          - the star region: the acoustic approximation of the GRP.
+ *          As an acoustic approximation, a sonic rarefaction wave is not resolved.
+ * @param[in] c_L, c_R: the sound speeds on both sides.
+ * @param[in] triv:     whether the star state is the mean of both sides (the trivial case).
+ * @param[in] multi:    whether the multi-fluid variables are read (two-component flow).
+ * @sa    Other parameters are the same as GRP_Edir_Q1D().
+ */
+ACC_ROUTINE_SEQ
+static inline void GRP_Edir_Q1D_acoustic
+(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R,
+ const double c_L, const double c_R, const _Bool triv, const _Bool multi)
+{
+	const double lambda_u = ifv_L->lambda_u, lambda_v = ifv_L->lambda_v;
+	const double rho_L = ifv_L->RHO, rho_R = ifv_R->RHO;
+	const double   u_L = ifv_L->U,     u_R = ifv_R->U;
+	const double   p_L = ifv_L->P,     p_R = ifv_R->P;
+	const double   g_L = rho_L*c_L,    g_R = rho_R*c_R;
+#ifdef MULTIFLUID_BASICS
+	const double   z_L = multi ? ifv_L->Z_a : 0.0,   z_R = multi ? ifv_R->Z_a : 0.0;
+	const double phi_L = multi ? ifv_L->PHI : 0.0, phi_R = multi ? ifv_R->PHI : 0.0;
+#else
+	const double   z_L = 0.0,          z_R = 0.0;
+	const double phi_L = 0.0,        phi_R = 0.0;
+#endif
+	double u_star, p_star, rho_star_L, rho_star_R, rs, C;
+	_Bool m_L, m_R, m_l, m_s;
+	const struct i_f_var * s_v; // the side of the slopes
+
+	//the linearised star state
+	u_star = triv ? 0.5*(u_L+u_R) : (g_L*u_L + g_R*u_R + p_L - p_R)/(g_L + g_R);
+	p_star = triv ? 0.5*(p_L+p_R) : (g_R*p_L + g_L*p_R + g_L*g_R*(u_L - u_R))/(g_L + g_R);
+	rho_star_L = triv ? rho_L : rho_L + (p_star - p_L)/(c_L*c_L);
+	rho_star_R = triv ? rho_R : rho_R + (p_star - p_R)/(c_R*c_R);
+	wave_speed[0] = triv ? u_star - c_L : u_L - c_L;
+	wave_speed[1] = triv ? u_star + c_R : u_R + c_R;
+
+	//the region of the t-axis
+	m_L = wave_speed[0] > lambda_u;
+	m_R = !m_L && wave_speed[1] < lambda_u;
+	m_s = !m_L && !m_R;
+	m_l = m_L || (m_s && u_star > lambda_u); // on the left side of the contact discontinuety
+	s_v = m_l ? ifv_L : ifv_R;
+	rs  = m_l ? rho_star_L : rho_star_R;
+	C   = m_l ? c_L : c_R;
+	U[0] = m_L ? rho_L : (m_R ? rho_R : rs);
+	U[1] = m_L ?   u_L : (m_R ?   u_R : u_star);
+	U[2] = s_v->V;
+	U[3] = m_L ?   p_L : (m_R ?   p_R : p_star);
+	U[4] = m_l ?   z_L : z_R;
+	U[5] = m_l ? phi_L : phi_R;
+
+	//the slopes at the t-axis, the acoustic approximation in the star region
+	const double g_s = U[0]*C;
+	const double D_p = m_s ? 0.5*((ifv_L->d_u*g_s + ifv_L->d_p) - (ifv_R->d_u*g_s - ifv_R->d_p)) : s_v->d_p;
+	const double T_p = m_s ? 0.5*((ifv_L->t_u*g_s + ifv_L->t_p) - (ifv_R->t_u*g_s - ifv_R->t_p)) : s_v->t_p;
+	const double D_u = m_s ? 0.5*(ifv_L->d_u + ifv_L->d_p/g_s + ifv_R->d_u - ifv_R->d_p/g_s) : s_v->d_u;
+	const double T_u = m_s ? 0.5*(ifv_L->t_u + ifv_L->t_p/g_s + ifv_R->t_u - ifv_R->t_p/g_s) : s_v->t_u;
+	const double D_rho = m_s ? s_v->d_rho - s_v->d_p/(C*C) + D_p/(C*C) : s_v->d_rho;
+	const double T_rho = m_s ? s_v->t_rho - s_v->t_p/(C*C) + T_p/(C*C) : s_v->t_rho;
+	const double D_v = s_v->d_v, T_v = s_v->t_v;
+#ifdef MULTIFLUID_BASICS
+	const double D_z   = multi ? s_v->d_z_a : -0.0, T_z   = multi ? s_v->t_z_a : -0.0;
+	const double D_phi = multi ? s_v->d_phi : -0.0, T_phi = multi ? s_v->t_phi : -0.0;
+#else
+	const double D_z = -0.0, T_z = -0.0, D_phi = -0.0, T_phi = -0.0;
+#endif
+	D[0] = -(U[1]-lambda_u)*D_rho - (U[2]-lambda_v)*T_rho - U[0]*(D_u+T_v);
+	D[1] = -(U[1]-lambda_u)*D_u   - (U[2]-lambda_v)*T_u   - D_p/U[0];
+	D[2] = -(U[1]-lambda_u)*D_v   - (U[2]-lambda_v)*T_v   - T_p/U[0];
+	D[3] = -(U[1]-lambda_u)*D_p   - (U[2]-lambda_v)*T_p   - U[0]*C*C*(D_u+T_v);
+	D[4] = -(U[1]-lambda_u)*D_z   - (U[2]-lambda_v)*T_z;
+	D[5] = -(U[1]-lambda_u)*D_phi - (U[2]-lambda_v)*T_phi;
+
+	U_star[0] = rho_star_L;
+	U_star[1] = u_star;
+	U_star[2] = rho_star_R;
+	U_star[3] = p_star;
+	U_star[4] = c_L;
+	U_star[5] = c_R;
+}
+
 /**
  * @brief A Quasi-1D direct Eulerian GRP solver for unsteady compressible inviscid two-component flow in two space dimension.
  * @param[out] wave_speed: the velocity of left and right waves.
@@ -23,23 +109,32 @@
  *                   - s_: normal derivatives.
  *                   - t_: tangential derivatives.
  *                   - gamma: the constant of the perfect gas.
+ * @param[in] gc:  the constants of the single-fluid perfect gas (NULL: two-component flow with gammaL and gammaR).
+ * @param[in] gt:  the constants of the two components of two-component flow, used on the sides where
+ *                 gammaL or gammaR is one of them (NULL: not given).
  * @param[in] eps: the largest value could be seen as zero.
  * @param[in] atc: Parameter that determines the solver type.
  *              - INFINITY: acoustic approximation
  *                - ifv_.s_, ifv_.t_ = -0.0: exact Riemann solver 
  *              - eps:      Quasi-1D GRP solver(nonlinear + acoustic case)
+ *                - A weak jump (the distance of the states < atc) takes GRP_Edir_Q1D_acoustic() only for a finite atc,
+ *                  which is the trivial case for atc < 2*eps.
  *                - ifv_.t_ = -0.0: Planar-1D GRP solver
  *              - -0.0:     Quasi-1D GRP solver(only nonlinear case)
  *                - ifv_.t_ = -0.0: Planar-1D GRP solver
+ * @param[in] hllc: Whether the star state is given by HLLC_star() instead of the exact Riemann solver,
+ *                  which still iterates if the HLLC pressure is below eps.
  * @sa   Theory is found in Reference [1]. \n
  *       [1] M. Ben-Artzi, J. Li & G. Warnecke, A direct Eulerian GRP scheme for compressible fluid flows.
  *           Journal of Computational Physics, 218.1: 19-43, 2006.
  */
-void linear_GRP_solver_Edir_Q1D
-(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc)
+ACC_ROUTINE_SEQ
+static inline void GRP_Edir_Q1D
+(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R,
+ const struct gamma_const * gc, const struct gamma_const * gt, const double eps, const double atc, const _Bool hllc)
 {
 	const double lambda_u = ifv_L->lambda_u, lambda_v = ifv_L->lambda_v;
-	const double  gammaL = ifv_L->gamma,  gammaR = ifv_R->gamma;
+	const double  gammaL = gc ? gc->gamma : ifv_L->gamma,  gammaR = gc ? gc->gamma : ifv_R->gamma;
 	const double   rho_L = ifv_L->RHO,     rho_R = ifv_R->RHO;
 	const double d_rho_L = ifv_L->d_rho, d_rho_R = ifv_R->d_rho;
 	const double t_rho_L = ifv_L->t_rho, t_rho_R = ifv_R->t_rho;
@@ -53,12 +148,13 @@ void linear_GRP_solver_Edir_Q1D
 	const double   d_p_L = ifv_L->d_p,     d_p_R = ifv_R->d_p;
 	const double   t_p_L = ifv_L->t_p,     t_p_R = ifv_R->t_p;
 #ifdef MULTIFLUID_BASICS
-	const double     z_L = ifv_L->Z_a,       z_R = ifv_R->Z_a;
-	const double   d_z_L = ifv_L->d_z_a,   d_z_R = ifv_R->d_z_a;
-	const double   t_z_L = ifv_L->t_z_a,   t_z_R = ifv_R->t_z_a;
-	const double   phi_L = ifv_L->PHI,     phi_R = ifv_R->PHI;
-	const double d_phi_L = ifv_L->d_phi, d_phi_R = ifv_R->d_phi;
-	const double t_phi_L = ifv_L->t_phi, t_phi_R = ifv_R->t_phi;
+	// The multi-fluid variables are not read in single-fluid flow.
+	const double     z_L = gc ?  0.0 : ifv_L->Z_a,       z_R = gc ?  0.0 : ifv_R->Z_a;
+	const double   d_z_L = gc ? -0.0 : ifv_L->d_z_a,   d_z_R = gc ? -0.0 : ifv_R->d_z_a;
+	const double   t_z_L = gc ? -0.0 : ifv_L->t_z_a,   t_z_R = gc ? -0.0 : ifv_R->t_z_a;
+	const double   phi_L = gc ?  0.0 : ifv_L->PHI,     phi_R = gc ?  0.0 : ifv_R->PHI;
+	const double d_phi_L = gc ? -0.0 : ifv_L->d_phi, d_phi_R = gc ? -0.0 : ifv_R->d_phi;
+	const double t_phi_L = gc ? -0.0 : ifv_L->t_phi, t_phi_R = gc ? -0.0 : ifv_R->t_phi;
 #else
 	const double     z_L =  0.0,     z_R =  0.0;
 	const double   d_z_L = -0.0,   d_z_R = -0.0;
@@ -83,8 +179,21 @@ void linear_GRP_solver_Edir_Q1D
 	double u_t_mat, p_t_mat;
 	double SmUs, SmUL, SmUR;
   
-	const double zetaL = (gammaL-1.0)/(gammaL+1.0);
-	const double zetaR = (gammaR-1.0)/(gammaR+1.0);
+	// the constants of the gases on both sides (NULL: evaluated by gammaL and gammaR)
+	const struct gamma_const * gcL = gc ? gc : gamma_const_find(gt, gammaL);
+	const struct gamma_const * gcR = gc ? gc : gamma_const_find(gt, gammaR);
+	const double zetaL = gcL ? gcL->zeta : (gammaL-1.0)/(gammaL+1.0);
+	const double zetaR = gcR ? gcR->zeta : (gammaR-1.0)/(gammaR+1.0);
+	// the exponents of the isentropic relations
+	const double   e_c_L = gcL ? gcL->e_c : 0.5*(gammaL-1.0)/gammaL, e_c_R = gcR ? gcR->e_c : 0.5*(gammaR-1.0)/gammaR;
+	const double   e_s_L = gcL ? gcL->e_s : 2.0*gammaL/(gammaL-1.0), e_s_R = gcR ? gcR->e_s : 2.0*gammaR/(gammaR-1.0);
+	const double   e_A_L = gcL ? gcL->e_A : 0.5/zetaL,               e_A_R = gcR ? gcR->e_A : 0.5/zetaR;
+	const double   e_B_L = gcL ? gcL->e_B : (1.0+zetaL)/zetaL,       e_B_R = gcR ? gcR->e_B : (1.0+zetaR)/zetaR;
+	const int      h_c_L = gcL ? gcL->h_c : 0,                       h_c_R = gcR ? gcR->h_c : 0;
+	const int      h_s_L = gcL ? gcL->h_s : 0,                       h_s_R = gcR ? gcR->h_s : 0;
+	const int      h_A_L = gcL ? gcL->h_A : 0,                       h_A_R = gcR ? gcR->h_A : 0;
+	const int      h_B_L = gcL ? gcL->h_B : 0,                       h_B_R = gcR ? gcR->h_B : 0;
+	double pA, pB; // the powers of c_frac in the CRW coefficients, where e_B = 2*e_A + 1
  
 	double rho_x, f;
 	double speed_L, speed_R;
@@ -93,6 +202,13 @@ void linear_GRP_solver_Edir_Q1D
 	c_R = sqrt(gammaR * p_R / rho_R);
 
 	dist = sqrt((rho_L-rho_R)*(rho_L-rho_R) + (u_L-u_R)*(u_L-u_R) + (p_L-p_R)*(p_L-p_R));
+	if (dist < atc && isfinite(atc))
+	    {
+		GRP_Edir_Q1D_acoustic(wave_speed, D, U, U_star, ifv_L, ifv_R, c_L, c_R, atc < 2*eps, !gc);
+		GRP_path_count(atc < 2*eps ? GP_TRIVIAL : GP_ACOUSTIC);
+		return;
+	    }
+	GRP_path_count(GP_NONLINEAR);
 	if (dist < atc && atc < 2*eps)
 	    {
 		u_star = 0.5*(u_R+u_L);
@@ -106,11 +222,16 @@ void linear_GRP_solver_Edir_Q1D
 	    }
 	else //=========Riemann solver==========
 	    {
-		Riemann_solver_exact(&u_star, &p_star, gammaL, gammaR, u_L, u_R, p_L, p_R, c_L, c_R, CRW, eps, eps, 500);
+		if (hllc)
+		    HLLC_star(&u_star, &p_star, wave_speed, CRW, gammaL, gammaR, rho_L, rho_R, u_L, u_R, p_L, p_R, c_L, c_R);
+		if (!hllc || p_star < eps)
+		    Riemann_solver_exact(&u_star, &p_star, gammaL, gammaR, u_L, u_R, p_L, p_R, c_L, c_R, CRW, eps, eps, 500);
 		if(CRW[0])
 		    {
-			rho_star_L = rho_L*pow(p_star/p_L, 1.0/gammaL);
-			c_star_L = c_L*pow(p_star/p_L, 0.5*(gammaL-1.0)/gammaL);
+			// x^(1/γ) = x/(x^((γ-1)/(2γ)))^2
+			c_star_L = gamma_pow(p_star/p_L, e_c_L, h_c_L);
+			rho_star_L = rho_L*(p_star/p_L)/(c_star_L*c_star_L);
+			c_star_L = c_L*c_star_L;
 			speed_L = u_L - c_L;
 		    }
 		else
@@ -121,8 +242,9 @@ void linear_GRP_solver_Edir_Q1D
 		    }
 		if(CRW[1])
 		    {
-			rho_star_R = rho_R*pow(p_star/p_R,1.0/gammaR);
-			c_star_R = c_R*pow(p_star/p_R, 0.5*(gammaR-1.0)/gammaR);
+			c_star_R = gamma_pow(p_star/p_R, e_c_R, h_c_R);
+			rho_star_R = rho_R*(p_star/p_R)/(c_star_R*c_star_R);
+			c_star_R = c_R*c_star_R;
 			speed_R = u_R + c_R;
 		    }
 		else
@@ -174,7 +296,7 @@ void linear_GRP_solver_Edir_Q1D
 						{
 							U[1] = zetaL*(u_L+2.0*(c_L+lambda_u)/(gammaL-1.0));
 							C = U[1] - lambda_u;
-							U[3] = pow(C/c_L, 2.0*gammaL/(gammaL-1.0)) * p_L;
+							U[3] = gamma_pow(C/c_L, e_s_L, h_s_L) * p_L;
 							U[0] = gammaL*U[3]/C/C;
 							U[2] = v_L;
 							U[4] = z_L;
@@ -184,7 +306,7 @@ void linear_GRP_solver_Edir_Q1D
 						{
 							U[1] = zetaR*(u_R-2.0*(c_R-lambda_u)/(gammaR-1.0));
 							C = lambda_u-U[1];
-							U[3] = pow(C/c_R, 2.0*gammaR/(gammaR-1.0)) * p_R;
+							U[3] = gamma_pow(C/c_R, e_s_R, h_s_R) * p_R;
 							U[0] = gammaR*U[3]/C/C;
 							U[2] = v_R;
 							U[4] = z_R;
@@ -291,21 +413,23 @@ void linear_GRP_solver_Edir_Q1D
 				{
 					U[1] = zetaL*(u_L+2.0*(c_L+lambda_u)/(gammaL-1.0));
 					C = U[1] - lambda_u;
-					U[3] = pow(C/c_L, 2.0*gammaL/(gammaL-1.0)) * p_L;
+					U[3] = gamma_pow(C/c_L, e_s_L, h_s_L) * p_L;
 					U[0] = gammaL*U[3]/C/C;
 					U[2] = v_L;
 					U[4] = z_L;
 					U[5] = phi_L;
 
 					c_frac = C/c_L;
+					pA = gamma_pow(c_frac, e_A_L, h_A_L);
+					pB = c_frac*pA*pA;
 					TdS = (d_p_L - d_rho_L*c_L*c_L)/(gammaL-1.0)/rho_L;
 					d_Psi = d_u_L + (gammaL*d_p_L/c_L - c_L*d_rho_L)/(gammaL-1.0)/rho_L;
-					D[1] = ((1.0+zetaL)*pow(c_frac, 0.5/zetaL) + zetaL*pow(c_frac, (1.0+zetaL)/zetaL));
+					D[1] = ((1.0+zetaL)*pA + zetaL*pB);
 					D[1] = D[1]/(1.0+2.0*zetaL) * TdS;
-					D[1] = D[1] - c_L*pow(c_frac, 0.5/zetaL) * d_Psi;
+					D[1] = D[1] - c_L*pA * d_Psi;
 					D[3] = U[0]*(U[1] - lambda_u)*D[1];
 
-					D[0] = U[0]*(U[1] - lambda_u)*pow(c_frac, (1.0+zetaL)/zetaL)*TdS*(gammaL-1.0);
+					D[0] = U[0]*(U[1] - lambda_u)*pB*TdS*(gammaL-1.0);
 					D[0] = (D[0] + D[3]) / C/C;
 
 					D[2] = -(U[1] - lambda_u)*d_v_L*U[0]/rho_L;
@@ -316,21 +440,23 @@ void linear_GRP_solver_Edir_Q1D
 				{
 					U[1] = zetaR*(u_R-2.0*(c_R-lambda_u)/(gammaR-1.0));
 					C = lambda_u-U[1];
-					U[3] = pow(C/c_R, 2.0*gammaR/(gammaR-1.0)) * p_R;
+					U[3] = gamma_pow(C/c_R, e_s_R, h_s_R) * p_R;
 					U[0] = gammaR*U[3]/C/C;
 					U[2] = v_R;
 					U[4] = z_R;
 					U[5] = phi_R;
 
 					c_frac = C/c_R;
+					pA = gamma_pow(c_frac, e_A_R, h_A_R);
+					pB = c_frac*pA*pA;
 					TdS = (d_p_R - d_rho_R*c_R*c_R)/(gammaR-1.0)/rho_R;
 					d_Phi = d_u_R - (gammaR*d_p_R/c_R - c_R*d_rho_R)/(gammaR-1.0)/rho_R;
-					D[1] = ((1.0+zetaR)*pow(c_frac, 0.5/zetaR) + zetaR*pow(c_frac, (1.0+zetaR)/zetaR));
+					D[1] = ((1.0+zetaR)*pA + zetaR*pB);
 					D[1] = D[1]/(1.0+2.0*zetaR) * TdS;
-					D[1] = D[1] + c_R*pow(c_frac, 0.5/zetaR)*d_Phi;
+					D[1] = D[1] + c_R*pA*d_Phi;
 					D[3] = U[0]*(U[1]-lambda_u)*D[1];
 
-					D[0] = U[0]*(U[1]-lambda_u)*pow(c_frac, (1.0+zetaR)/zetaR)*TdS*(gammaR-1.0);
+					D[0] = U[0]*(U[1]-lambda_u)*pB*TdS*(gammaR-1.0);
 					D[0] = (D[0] + D[3]) / C/C;
 
 					D[2] = -(U[1]-lambda_u)*d_v_R*U[0]/rho_R;
@@ -366,11 +492,13 @@ void linear_GRP_solver_Edir_Q1D
 							a_L = 1.0;
 							b_L = 1.0 / rho_star_L / c_star_L;
 							c_frac = c_star_L/c_L;
+							pA = gamma_pow(c_frac, e_A_L, h_A_L);
+							pB = c_frac*pA*pA;
 							TdS = (d_p_L - d_rho_L*c_L*c_L)/(gammaL-1.0)/rho_L;
 							d_Psi = d_u_L + (gammaL*d_p_L/c_L - c_L*d_rho_L)/(gammaL-1.0)/rho_L;
-							d_L = ((1.0+zetaL)*pow(c_frac, 0.5/zetaL) + zetaL*pow(c_frac, (1.0+zetaL)/zetaL));
+							d_L = ((1.0+zetaL)*pA + zetaL*pB);
 							d_L = d_L/(1.0+2.0*zetaL) * TdS;
-							d_L = d_L - c_L*pow(c_frac, 0.5/zetaL) * d_Psi;
+							d_L = d_L - c_L*pA * d_Psi;
 						}
 					else //the 1-wave is a shock
 						{
@@ -397,11 +525,13 @@ void linear_GRP_solver_Edir_Q1D
 							a_R = 1.0;
 							b_R = -1.0 / rho_star_R / c_star_R;
 							c_frac = c_star_R/c_R;
+							pA = gamma_pow(c_frac, e_A_R, h_A_R);
+							pB = c_frac*pA*pA;
 							TdS = (d_p_R - d_rho_R*c_R*c_R)/(gammaR-1.0)/rho_R;
 							d_Phi = d_u_R - (gammaR*d_p_R/c_R - c_R*d_rho_R)/(gammaR-1.0)/rho_R;
-							d_R = ((1.0+zetaR)*pow(c_frac, 0.5/zetaR) + zetaR*pow(c_frac, (1.0+zetaR)/zetaR));
+							d_R = ((1.0+zetaR)*pA + zetaR*pB);
 							d_R = d_R/(1.0+2.0*zetaR) * TdS;
-							d_R = d_R + c_R*pow(c_frac, 0.5/zetaR) * d_Phi;
+							d_R = d_R + c_R*pA * d_Phi;
 						}
 					else //the 3-wave is a shock
 						{
@@ -436,7 +566,7 @@ void linear_GRP_solver_Edir_Q1D
 							if(CRW[1]) //the 3-wave is a CRW
 								{
 									//already total D!
-									D[0] = rho_star_R*(u_star-lambda_u)*pow(c_star_R/c_R, (1.0+zetaR)/zetaR)*(d_p_R - d_rho_R*c_R*c_R)/rho_R;
+									D[0] = rho_star_R*(u_star-lambda_u)*gamma_pow(c_star_R/c_R, e_B_R, h_B_R)*(d_p_R - d_rho_R*c_R*c_R)/rho_R;
 									D[0] = (D[0] + D[3]) / c_star_R/c_star_R;
 
 									D[2] = -U[1]*d_v_R*U[0]/rho_R;
@@ -480,7 +610,7 @@ void linear_GRP_solver_Edir_Q1D
 							if(CRW[0]) //the 1-wave is a CRW
 								{
 									//already total D!
-									D[0] = rho_star_L*(u_star-lambda_u)*pow(c_star_L/c_L, (1.0+zetaL)/zetaL)*(d_p_L - d_rho_L*c_L*c_L)/rho_L;
+									D[0] = rho_star_L*(u_star-lambda_u)*gamma_pow(c_star_L/c_L, e_B_L, h_B_L)*(d_p_L - d_rho_L*c_L*c_L)/rho_L;
 									D[0] = (D[0] + D[3]) / c_star_L/c_star_L;
 
 									D[2] = -U[1]*d_v_L*U[0]/rho_L;
@@ -552,3 +682,42 @@ void linear_GRP_solver_Edir_Q1D
 	U_star[4] = c_star_L;
 	U_star[5] = c_star_R;
 }
+
+
+/**
+ * @brief A Quasi-1D direct Eulerian GRP solver for unsteady compressible inviscid two-component flow in two space dimension.
+ * @details See GRP_Edir_Q1D() for the parameters.
+ */
+void linear_GRP_solver_Edir_Q1D
+(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R, const double eps, const double atc)
+{
+	GRP_Edir_Q1D(wave_speed, D, U, U_star, ifv_L, ifv_R, NULL, NULL, eps, atc, 0);
+}
+
+/**
+ * @brief A Quasi-1D direct Eulerian GRP solver for unsteady compressible inviscid single-fluid flow with a constant gamma.
+ * @details The gamma and the multi-fluid variables of ifv_L and ifv_R are not read, gamma and its derived
+ *          exponents are taken from gc, and the outputs of phi and z_a are zero.
+ *          See GRP_Edir_Q1D() for the other parameters.
+ * @param[in] gc: the constants of the perfect gas set by gamma_const_set().
+ */
+void linear_GRP_solver_Edir_Q1D_gc
+(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R,
+ const struct gamma_const * gc, const double eps, const double atc, const _Bool hllc)
+{
+	GRP_Edir_Q1D(wave_speed, D, U, U_star, ifv_L, ifv_R, gc, NULL, eps, atc, hllc);
+}
+
+/**
+ * @brief A Quasi-1D direct Eulerian GRP solver for unsteady compressible inviscid two-component flow
+ *        with the constants of the two components.
+ * @details The exponents on a side of a pure component are taken from gt, otherwise they are evaluated by gamma.
+ *          See GRP_Edir_Q1D() for the other parameters.
+ * @param[in] gt: the constants of the two components set by gamma_const_set().
+ */
+void linear_GRP_solver_Edir_Q1D_gt
+(double *wave_speed, double *D, double *U, double *U_star, const struct i_f_var *ifv_L, const struct i_f_var *ifv_R,
+ const struct gamma_const * gt, const double eps, const double atc, const _Bool hllc)
+{
+	GRP_Edir_Q1D(wave_speed, D, U, U_star, ifv_L, ifv_R, NULL, gt, eps, atc, hllc);
+}
@@ -152,3 +152,178 @@ void linear_GRP_solver_LAG(double * D, double * U, const struct i_f_var *ifv_L,
   D[0] = D[2]/c_star_L/c_star_L;
   D[3] = D[2]/c_star_R/c_star_R;
 }
+
+
+/**
+ * @brief The batched Lagrangian GRP solver shared by the two-component and the single-fluid flows.
+ * @details The variables on both sides are given as structures of arrays. After the exact Riemann
+ *          solver has been called for each interface, the shock, CRW and acoustic coefficients are
+ *          all evaluated and chosen by masks, so that the loop over the interfaces may be vectorized.
+ *          With a constant pointer gc, the compiler specialises the loop for the constant gamma.
+ * @param[in]  n:     the number of interfaces in the block.
+ * @param[out] D:     the temporal derivative arrays in the Star Region. \n
+ *                      [rho_L, u, p, rho_R]_t
+ * @param[out] U:     the Riemann solution arrays in the Star Region. \n
+ *                      [rho_star_L, u_star, p_star, rho_star_R]
+ * @param[in] ifv_L:  Left  States (rho_L, u_L, p_L, s_rho_L, s_u_L, s_p_L, gammaL).
+ * @param[in] ifv_R:  Right States (rho_R, u_R, p_R, s_rho_R, s_u_R, s_p_R, gammaR).
+ *                     - s_rho, s_u, s_p: ξ-Lagrangian spatial derivatives.
+ * @param[in] gc:     the constants of the perfect gas (NULL: gamma given on each interface).
+ * @param[in] eps:    the largest value could be seen as zero.
+ * @param[in] atc:    Parameter that determines the solver type, as in linear_GRP_solver_LAG().
+ */
+static inline void GRP_LAG_batch(const int n, double * const D[4], double * const U[4],
+				 const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R,
+				 const struct gamma_const * gc, const double eps, const double atc)
+{
+  double u_star[GRP_BATCH_SIZE], p_star[GRP_BATCH_SIZE];
+  double c_L[GRP_BATCH_SIZE], c_R[GRP_BATCH_SIZE];
+  _Bool CRW_L[GRP_BATCH_SIZE], CRW_R[GRP_BATCH_SIZE];
+  _Bool CRW[2];
+  int i, j0, nb;
+
+  for(j0 = 0; j0 < n; j0 += GRP_BATCH_SIZE)
+      {
+	  nb = n - j0 < GRP_BATCH_SIZE ? n - j0 : GRP_BATCH_SIZE;
+	  // The iterative Riemann solver stays one interface at a time.
+	  for(i = 0; i < nb; ++i)
+	      {
+		  const int j = j0 + i;
+		  const double gammaL = gc ? gc->gamma : ifv_L->gamma[j], gammaR = gc ? gc->gamma : ifv_R->gamma[j];
+		  c_L[i] = sqrt(gammaL * ifv_L->P[j] / ifv_L->RHO[j]);
+		  c_R[i] = sqrt(gammaR * ifv_R->P[j] / ifv_R->RHO[j]);
+		  Riemann_solver_exact(u_star+i, p_star+i, gammaL, gammaR, ifv_L->U[j], ifv_R->U[j],
+				       ifv_L->P[j], ifv_R->P[j], c_L[i], c_R[i], CRW, eps, eps, 500);
+		  CRW_L[i] = CRW[0];
+		  CRW_R[i] = CRW[1];
+	      }
+#pragma omp simd
+	  for(i = 0; i < nb; ++i)
+	      {
+		  const int j = j0 + i;
+		  const double   rho_L = ifv_L->RHO[j],     rho_R = ifv_R->RHO[j];
+		  const double s_rho_L = ifv_L->s_rho[j], s_rho_R = ifv_R->s_rho[j];
+		  const double     u_L = ifv_L->U[j],         u_R = ifv_R->U[j];
+		  const double   s_u_L = ifv_L->s_u[j],     s_u_R = ifv_R->s_u[j];
+		  const double     p_L = ifv_L->P[j],         p_R = ifv_R->P[j];
+		  const double   s_p_L = ifv_L->s_p[j],     s_p_R = ifv_R->s_p[j];
+		  const double  gammaL = gc ? gc->gamma : ifv_L->gamma[j],  gammaR = gc ? gc->gamma : ifv_R->gamma[j];
+		  const double zetaL = gc ? gc->zeta : (gammaL-1.0)/(gammaL+1.0);
+		  const double zetaR = gc ? gc->zeta : (gammaR-1.0)/(gammaR+1.0);
+		  // the exponents of the isentropic relations
+		  const double e_c_L = gc ? gc->e_c : 0.5*(gammaL-1.0)/gammaL, e_c_R = gc ? gc->e_c : 0.5*(gammaR-1.0)/gammaR;
+		  const double e_D_L = gc ? gc->e_D : (3.0*gammaL-1.0)/2.0/(gammaL+1.0), e_D_R = gc ? gc->e_D : (3.0*gammaR-1.0)/2.0/(gammaR+1.0);
+		  const int    h_c = gc ? gc->h_c : 0, h_D = gc ? gc->h_D : 0;
+		  const double us = u_star[i], ps = p_star[i];
+		  const double g_L = rho_L*c_L[i], g_R = rho_R*c_R[i];
+		  const _Bool acs = sqrt((u_L-u_R)*(u_L-u_R) + (p_L-p_R)*(p_L-p_R)) < atc;
+		  double rho_star_L, rho_star_R, c_star_L, c_star_R, g_star_L, g_star_R;
+		  double a_L, b_L, d_L, a_R, b_R, d_R;
+		  double W, A, B, L_rho, L_u, L_p;
+		  double crw_rho, crw_c, crw_d, shk_rho, shk_c, shk_a, shk_b, shk_d;
+
+		  //the star states behind a CRW and behind a shock, where x^(1/γ) = x/(x^((γ-1)/(2γ)))^2
+		  crw_c   = gamma_pow(ps/p_L, e_c_L, h_c);
+		  crw_rho = rho_L*(ps/p_L)/(crw_c*crw_c);
+		  crw_c   = c_L[i]*crw_c;
+		  shk_rho = rho_L*(ps+zetaL*p_L)/(p_L+zetaL*ps);
+		  shk_c   = sqrt(gammaL * ps / shk_rho);
+		  rho_star_L = CRW_L[i] ? crw_rho : shk_rho;
+		  c_star_L   = CRW_L[i] ? crw_c   : shk_c;
+		  crw_c   = gamma_pow(ps/p_R, e_c_R, h_c);
+		  crw_rho = rho_R*(ps/p_R)/(crw_c*crw_c);
+		  crw_c   = c_R[i]*crw_c;
+		  shk_rho = rho_R*(ps+zetaR*p_R)/(p_R+zetaR*ps);
+		  shk_c   = sqrt(gammaR * ps / shk_rho);
+		  rho_star_R = CRW_R[i] ? crw_rho : shk_rho;
+		  c_star_R   = CRW_R[i] ? crw_c   : shk_c;
+		  g_star_L = rho_star_L*c_star_L;
+		  g_star_R = rho_star_R*c_star_R;
+
+		  //determine a_L, b_L and d_L
+		  crw_d = (s_u_L+s_p_L/g_L) + 1.0/g_L/(3.0*gammaL-1.0)*(c_L[i]*c_L[i]*s_rho_L-s_p_L)*(gamma_pow(g_star_L/g_L, e_D_L, h_D)-1.0);
+		  crw_d = - 1.0 * sqrt(g_L*g_star_L)*crw_d;
+		  W = (ps-p_L) / (us-u_L);
+		  A = - 0.5/(ps + zetaL * p_L);
+		  shk_a = 2.0 + A * (ps-p_L);
+		  shk_b = - W/g_star_L/g_star_L - (shk_a - 1.0)/W;
+		  L_rho = (ps-p_L)/2.0/rho_L;
+		  B = 1.0/(ps-p_L) - zetaL * A;
+		  L_u = rho_L * (us-u_L) * (gammaL*p_L*B + 0.5) + W;
+		  L_p = 1.0 + B * (ps-p_L);
+		  shk_d = L_u*s_u_L - L_p*s_p_L - L_rho*s_rho_L;
+		  a_L = acs || CRW_L[i] ? 1.0 : shk_a;
+		  b_L = acs || CRW_L[i] ? 1.0 / g_star_L : shk_b;
+		  d_L = acs ? - g_L*s_u_L - s_p_L : (CRW_L[i] ? crw_d : shk_d);
+
+		  //determine a_R, b_R and d_R (the CRW coefficient follows linear_GRP_solver_LAG)
+		  crw_d = (s_u_R-s_p_R/g_R) + 1.0/g_R/(3.0*gammaR-1.0)*(-c_L[i]*c_L[i]*s_rho_L+s_p_L)*(gamma_pow(g_star_R/g_R, e_D_R, h_D)-1.0);
+		  crw_d = - 1.0 * sqrt(g_R*g_star_R)*crw_d;
+		  W = (ps-p_R) / (us-u_R);
+		  A = - 0.5/(ps + zetaR * p_R);
+		  shk_a = - 2.0 - A * (ps-p_R);
+		  shk_b = W/g_star_R/g_star_R - (shk_a + 1.0)/W;
+		  L_rho = (ps-p_R)/2.0/rho_R;
+		  B = 1.0/(ps-p_R) - zetaR * A;
+		  L_u = rho_R * (u_R-us) * (gammaR*p_R*B + 0.5) - W;
+		  L_p = 1.0 + B * (ps-p_R);
+		  shk_d = L_u*s_u_R + L_p*s_p_R + L_rho*s_rho_R;
+		  a_R = acs || CRW_R[i] ? -1.0 : shk_a;
+		  b_R = acs || CRW_R[i] ? 1.0 / g_star_R : shk_b;
+		  d_R = acs ? - g_R*s_u_R + s_p_R : (CRW_R[i] ? crw_d : shk_d);
+
+		  U[1][j] =   us;
+		  U[2][j] =   ps;
+		  U[0][j] = rho_star_L;
+		  U[3][j] = rho_star_R;
+		  D[1][j] = (d_L*b_R-d_R*b_L)/(a_L*b_R-a_R*b_L);
+		  D[2][j] = (d_L*a_R-d_R*a_L)/(b_L*a_R-b_R*a_L);
+		  D[0][j] = D[2][j]/c_star_L/c_star_L;
+		  D[3][j] = D[2][j]/c_star_R/c_star_R;
+	      }
+      }
+}
+
+
+/**
+ * @brief A batched Lagrangian GRP solver for a block of interfaces in one space dimension.
+ * @details The results agree with those of linear_GRP_solver_LAG() on each interface to rounding errors,
+ *          since the density behind a CRW is derived from the power of the sound speed.
+ * @param[in]  n:     the number of interfaces in the block.
+ * @param[out] D:     the temporal derivative arrays in the Star Region. \n
+ *                      [rho_L, u, p, rho_R]_t
+ * @param[out] U:     the Riemann solution arrays in the Star Region. \n
+ *                      [rho_star_L, u_star, p_star, rho_star_R]
+ * @param[in] ifv_L:  Left  States (rho_L, u_L, p_L, s_rho_L, s_u_L, s_p_L, gammaL).
+ * @param[in] ifv_R:  Right States (rho_R, u_R, p_R, s_rho_R, s_u_R, s_p_R, gammaR).
+ *                     - s_rho, s_u, s_p: ξ-Lagrangian spatial derivatives.
+ * @param[in] eps:    the largest value could be seen as zero.
+ * @param[in] atc:    Parameter that determines the solver type, as in linear_GRP_solver_LAG().
+ */
+void linear_GRP_solver_LAG_batch(const int n, double * const D[4], double * const U[4],
+				 const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R,
+				 const double eps, const double atc)
+{
+    GRP_LAG_batch(n, D, U, ifv_L, ifv_R, NULL, eps, atc);
+}
+
+/**
+ * @brief A batched Lagrangian GRP solver for a block of interfaces of single-fluid flow with a constant gamma.
+ * @details The gamma arrays of ifv_L and ifv_R are not read, and gamma and its derived exponents are
+ *          taken from gc. The results agree with those of linear_GRP_solver_LAG_batch() to rounding errors,
+ *          since the half-integer powers are evaluated by multiplications in gamma_pow().
+ * @param[in]  n:     the number of interfaces in the block.
+ * @param[out] D:     the temporal derivative arrays in the Star Region.
+ * @param[out] U:     the Riemann solution arrays in the Star Region.
+ * @param[in] ifv_L:  Left  States (rho_L, u_L, p_L, s_rho_L, s_u_L, s_p_L).
+ * @param[in] ifv_R:  Right States (rho_R, u_R, p_R, s_rho_R, s_u_R, s_p_R).
+ * @param[in] gc:     the constants of the perfect gas set by gamma_const_set().
+ * @param[in] eps:    the largest value could be seen as zero.
+ * @param[in] atc:    Parameter that determines the solver type, as in linear_GRP_solver_LAG().
+ */
+void linear_GRP_solver_LAG_batch_gc(const int n, double * const D[4], double * const U[4],
+				    const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R,
+				    const struct gamma_const * gc, const double eps, const double atc)
+{
+    GRP_LAG_batch(n, D, U, ifv_L, ifv_R, gc, eps, atc);
+}
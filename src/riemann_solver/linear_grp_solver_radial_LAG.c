@@ -214,3 +214,214 @@ void GRPsolverRLag(double *wave_speed, double *dire, double *U_star, const struc
 	dire[0] = dire[2]/C_starL/C_starL;
 	dire[3] = dire[2]/C_starR/C_starR;
 }
+
+
+/**
+ * @brief A batched acoustic solver for the tangential case of a block of cells, Lagrangian version for cylindrical case.
+ * @details The variables on both sides are given as structures of arrays. After the exact Riemann solver
+ *          has been called for each cell, the star states behind a rarefaction wave and behind a shock are
+ *          both evaluated and chosen by masks, so that the loop over the cells may be vectorized.
+ *          The results are identical to those of AcousticRLagTangent() on each cell.
+ * @param[in]  n:     the number of cells in the block.
+ * @param[out] D:     the temporal derivative arrays in the Star Region. \n
+ *                      [u, p]_t
+ * @param[out] U:     the Riemann solution arrays in the Star Region. \n
+ *                      [u_star, p_star]
+ * @param[in] ifv_L:  Left  States (rho_L, u_L, p_L, s_u_L, s_p_L, gammaL).
+ * @param[in] ifv_R:  Right States (rho_R, u_R, p_R, gammaR).
+ * @param[in] r:      the r-coordinate values.
+ * @param[in] M:      Spatial dimension number for radially symmetric flow.
+ * @param[in] eps:    the largest value could be seen as zero.
+ */
+void AcousticRLagTangent_batch(const int n, double * const D[2], double * const U[2],
+			       const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R,
+			       const double * r, const double M, const double eps)
+{
+	double u_star[GRP_BATCH_SIZE], p_star[GRP_BATCH_SIZE];
+	_Bool CRW[2];
+	int i, j0, nb;
+
+	for(j0 = 0; j0 < n; j0 += GRP_BATCH_SIZE)
+	    {
+		nb = n - j0 < GRP_BATCH_SIZE ? n - j0 : GRP_BATCH_SIZE;
+		// The iterative Riemann solver stays one cell at a time.
+		for(i = 0; i < nb; ++i)
+		    {
+			const int j = j0 + i;
+			const double CL = sqrt(ifv_L->gamma[j]*ifv_L->P[j]/ifv_L->RHO[j]);
+			const double CR = sqrt(ifv_R->gamma[j]*ifv_R->P[j]/ifv_R->RHO[j]);
+			Riemann_solver_starPU(u_star+i, p_star+i, ifv_L->gamma[j], ifv_R->gamma[j], ifv_L->U[j], ifv_R->U[j],
+					      ifv_L->P[j], ifv_R->P[j], CL, CR, CRW, eps, eps, 100);
+		    }
+#pragma omp simd
+		for(i = 0; i < nb; ++i)
+		    {
+			const int j = j0 + i;
+			const double GammaL = ifv_L->gamma[j], GammaR = ifv_R->gamma[j];
+			const double DL = ifv_L->RHO[j], DR = ifv_R->RHO[j];
+			const double PL = ifv_L->P[j],   PR = ifv_R->P[j];
+			const double UM = u_star[i], PM = p_star[i];
+			double DML, DMR, DM, C_star;
+
+			DML = PM<=PL ? DL*vmath_pow(PM/PL,1./GammaL) //Left rarefaction wave
+			    : DL*(PM/PL+(GammaL-1.)/(GammaL+1.))/(PM/PL*(GammaL-1.)/(GammaL+1.)+1.); //Left shock wave
+			DMR = PM<=PR ? DR*vmath_pow(PM/PR,1./GammaR) //Right rarefaction wave
+			    : DR*(PM/PR+(GammaR-1.)/(GammaR+1.))/(PM/PR*(GammaR-1.)/(GammaR+1.)+1.); //Right shock wave
+			DM = 0.5*(DML+DMR);
+			C_star = 0.5*(sqrt(GammaL*PM/DML)+sqrt(GammaR*PM/DMR));
+
+			U[0][j] = UM;
+			U[1][j] = PM;
+			D[0][j] = -ifv_L->s_p[j]/DM;
+			D[1][j] = -DM*C_star*C_star*(ifv_L->s_u[j]+(M-1)*UM/r[j]);
+		    }
+	    }
+}
+
+
+/**
+ * @brief A batched GRP solver for a block of interfaces, Lagrangian version (moving mesh) cylindrical case.
+ * @details The variables on both sides are given as structures of arrays. After the exact Riemann solver
+ *          has been called for each interface, the acoustic, rarefaction and shock coefficients are all
+ *          evaluated and chosen by masks, so that the loop over the interfaces may be vectorized.
+ *          The results are identical to those of GRPsolverRLag() on each interface.
+ * @param[in]  n:          the number of interfaces in the block.
+ * @param[out] wave_speed: the velocity arrays of left and right waves.
+ * @param[out] D:          the temporal derivative arrays in the Star Region. \n
+ *                           [rho_L, u, p, rho_R]_t
+ * @param[out] U:          the Riemann solution arrays in the Star Region. \n
+ *                           [rho_star_L, u_star, p_star, rho_star_R]
+ * @param[in] ifv_L:       Left  States (rho_L, u_L, p_L, s_rho_L, s_u_L, s_p_L, gammaL).
+ * @param[in] ifv_R:       Right States (rho_R, u_R, p_R, s_rho_R, s_u_R, s_p_R, gammaR).
+ *                          - s_rho, s_u, s_p: r-spatial derivatives.
+ * @param[in] r:           the r-coordinate values.
+ * @param[in] M:           Spatial dimension number for radially symmetric flow.
+ * @param[in] eps:         the largest value could be seen as zero.
+ * @param[in] atc:         Parameter that determines the solver type, as in GRPsolverRLag().
+ */
+void GRPsolverRLag_batch(const int n, double * const wave_speed[2], double * const D[4], double * const U[4],
+			 const struct i_f_var_batch * ifv_L, const struct i_f_var_batch * ifv_R,
+			 const double * r, const double M, const double eps, const double atc)
+{
+	double u_star[GRP_BATCH_SIZE], p_star[GRP_BATCH_SIZE];
+	_Bool CRW[2];
+	int i, j0, nb;
+
+	for(j0 = 0; j0 < n; j0 += GRP_BATCH_SIZE)
+	    {
+		nb = n - j0 < GRP_BATCH_SIZE ? n - j0 : GRP_BATCH_SIZE;
+		// The iterative Riemann solver stays one interface at a time.
+		for(i = 0; i < nb; ++i)
+		    {
+			const int j = j0 + i;
+			const double CL = sqrt(ifv_L->gamma[j]*ifv_L->P[j]/ifv_L->RHO[j]);
+			const double CR = sqrt(ifv_R->gamma[j]*ifv_R->P[j]/ifv_R->RHO[j]);
+			Riemann_solver_starPU(u_star+i, p_star+i, ifv_L->gamma[j], ifv_R->gamma[j], ifv_L->U[j], ifv_R->U[j],
+					      ifv_L->P[j], ifv_R->P[j], CL, CR, CRW, eps, eps, 100);
+		    }
+#pragma omp simd
+		for(i = 0; i < nb; ++i)
+		    {
+			const int j = j0 + i;
+			const double GammaL = ifv_L->gamma[j], GammaR = ifv_R->gamma[j];
+			const double DL = ifv_L->RHO[j],    DR = ifv_R->RHO[j];
+			const double UL = ifv_L->U[j],      UR = ifv_R->U[j];
+			const double PL = ifv_L->P[j],      PR = ifv_R->P[j];
+			const double DDL = ifv_L->s_rho[j], DDR = ifv_R->s_rho[j];
+			const double DUL = ifv_L->s_u[j],   DUR = ifv_R->s_u[j];
+			const double DPL = ifv_L->s_p[j],   DPR = ifv_R->s_p[j];
+			const double CL = sqrt(GammaL*PL/DL), CR = sqrt(GammaR*PR/DR);
+			const double UM = u_star[i], PM = p_star[i];
+			const double musL=(GammaL-1.)/(GammaL+1.);
+			const double musR=(GammaR-1.)/(GammaR+1.);
+			const double TDSL=-CL*CL/(DL*(GammaL-1.))*DDL+1./(DL*(GammaL-1.))*DPL;
+			const double TDSR=-CR*CR/(DR*(GammaR-1.))*DDR+1./(DR*(GammaR-1.))*DPR;
+			const double DpsiL=DUL+GammaL/((GammaL-1.)*CL*DL)*DPL-CL/(DL*(GammaL-1.))*DDL;
+			const double DphiR=DUR-GammaR/((GammaR-1.)*CR*DR)*DPR+CR/(DR*(GammaR-1.))*DDR;
+			const _Bool fanL = PM<=PL, fanR = PM<=PR;
+			double DML, DMR, DM, C_starL, C_starR, C_star, theta, dist;
+			double aL, bL, dL, aR, bR, dR, phic, phi1, phi2, phi3, sigmaL, sigmaR;
+			double fan_d, shk_a, shk_b, shk_d, acs_u, acs_p;
+
+			//left fan OR left shock
+			DML = fanL ? DL*vmath_pow(PM/PL,1./GammaL) : DL*(PM/PL+(GammaL-1.)/(GammaL+1.))/(PM/PL*(GammaL-1.)/(GammaL+1.)+1.);
+			wave_speed[0][j] = fanL ? UL-CL : UL-CL*sqrt(PM/PL*(GammaL+1)/(2.*GammaL)+(GammaL-1.)/(2.*GammaL));
+			C_starL=sqrt(GammaL*PM/DML);
+			//right fan OR right shock
+			DMR = fanR ? DR*vmath_pow(PM/PR,1./GammaR) : DR*(PM/PR+(GammaR-1.)/(GammaR+1.))/(PM/PR*(GammaR-1.)/(GammaR+1.)+1.);
+			wave_speed[1][j] = fanR ? UR+CR : UR+CR*sqrt(PM/PR*(GammaR+1)/(2.*GammaR)+(GammaR-1.)/(2.*GammaR));
+			C_starR=sqrt(GammaR*PM/DMR);
+			U[1][j] = UM;
+			U[2][j] = PM;
+			U[0][j] = DML;
+			U[3][j] = DMR;
+
+			//GRP solver for acoustic case.
+			DM = 0.5*(DML + DMR);
+			C_star = 0.5*(C_starL+C_starR);
+			acs_p =  0.5*C_star*(DPR-DPL)-DM*C_star*C_star*(0.5*(DUL+DUR)+(M-1)*UM/r[j]);
+			acs_u = -0.5*(DPR+DPL)/DM+0.5*C_star*(DUR-DUL);
+
+			// GRP solver for non acoustic case.
+			//Left rarefaction wave
+			theta=C_starL/CL;
+			if(fabs(GammaL-5./3.)<eps)
+				phic=-2.*(3.*C_starL*log(theta)+(UL+2.*CL/(GammaL-1.))*(1.-theta));
+			else if(fabs(GammaL-3.)<eps)
+				phic=CL-C_starL+(UL+2.*CL/(GammaL-1.))*log(theta);
+			else
+				phic=(musL-1.)*C_starL/(musL*(4.*musL-1.))*(1.-vmath_pow(theta,(1.-4.*musL)/(2.*musL)))+(UL+2.*CL/(GammaL-1.))/(2.*musL-1.)*(1.-vmath_pow(theta,(1.-2*musL)/(2.*musL)));
+			fan_d=((1.+musL)/(1.+2.*musL)*vmath_pow(theta,0.5/musL)+musL/(1.+2.*musL)*vmath_pow(theta,(1.+musL)/musL))*TDSL
+				-vmath_pow(theta,0.5/musL)*CL*(DpsiL+(M-1.)/(2.*r[j])*UL)+(M-1.)/(2.*r[j])*C_starL*(phic-UM);
+			//Left shock wave
+			phi1=0.5*sqrt((1.-musL)/(DL*(PM+musL*PL)))*(PM+PL*(1.+2.*musL))/(PM+musL*PL);
+			phi2=-0.5*sqrt((1.-musL)/(DL*(PM+musL*PL)))*(PM*(2.+musL)+musL*PL)/(PM+musL*PL);
+			phi3=-0.5*(PM-PL)/DL*sqrt((1.-musL)/(DL*(PM+musL*PL)));
+			sigmaL=(DML*UM-DL*UL)/(DML-DL);
+			shk_a=1.-DML*(sigmaL-UM)*phi1;
+			shk_b=phi1-(sigmaL-UM)/(DML*C_starL*C_starL);
+			shk_d=(-(sigmaL-UL)*phi2-1./DL)*DPL+(sigmaL-UL+DL*phi3+CL*CL*DL*phi2)*DUL-(sigmaL-UL)*phi3*DDL+(DL*UL*CL*CL*phi2+DL*UL*phi3+(sigmaL-UM)*UM)*(M-1.)/r[j];
+			aL = fanL ? 1. : shk_a;
+			bL = fanL ? 1./(DML*C_starL) : shk_b;
+			dL = fanL ? fan_d : shk_d;
+
+			//Right rarefaction wave
+			theta=C_starR/CR;
+			if(fabs(GammaR-5./3.)<eps)
+				phic=-2.*(3.*C_starR*log(theta)-(UR-2.*CR/(GammaR-1.))*(1.-theta));
+			else if(fabs(GammaR-3.)<eps)
+				phic=CR-C_starR-(UR-2.*CR/(GammaR-1.))*log(theta);
+			else
+				phic=(musR-1.)*C_starR/(musR*(4.*musR-1.))*(1.-vmath_pow(theta,(1.-4.*musR)/(2.*musR)))-(UR-2.*CR/(GammaR-1.))/(2.*musR-1.)*(1.-vmath_pow(theta,(1.-2*musR)/(2.*musR)));
+			fan_d=((1.+musR)/(1.+2.*musR)*vmath_pow(theta,0.5/musR)+musR/(1.+2.*musR)*vmath_pow(theta,(1.+musR)/musR))*TDSR
+				+vmath_pow(theta,0.5/musR)*CR*(DphiR+(M-1.)/(2.*r[j])*UR)+(M-1.)/(2.*r[j])*C_starR*(phic+UM);
+			//Right shock wave
+			phi1=0.5*sqrt((1.-musR)/(DR*(PM+musR*PR)))*(PM+PR*(1.+2.*musR))/(PM+musR*PR);
+			phi2=-0.5*sqrt((1.-musR)/(DR*(PM+musR*PR)))*(PM*(2.+musR)+musR*PR)/(PM+musR*PR);
+			phi3=-0.5*(PM-PR)/DR*sqrt((1.-musR)/(DR*(PM+musR*PR)));
+			sigmaR=(DMR*UM-DR*UR)/(DMR-DR);
+			shk_a=1.+DMR*(sigmaR-UM)*phi1;
+			shk_b=-phi1-(sigmaR-UM)/(DMR*C_starR*C_starR);
+			shk_d=((sigmaR-UR)*phi2-1./DR)*DPR+(sigmaR-UR-DR*phi3-CR*CR*DR*phi2)*DUR+(sigmaR-UR)*phi3*DDR-(DR*UR*CR*CR*phi2+DR*UR*phi3-(sigmaR-UM)*UM)*(M-1.)/r[j];
+			aR = fanR ? 1. : shk_a;
+			bR = fanR ? -1./(DMR*C_starR) : shk_b;
+			dR = fanR ? fan_d : shk_d;
+
+			dist = (DL-DR)*(DL-DR)+(UL-UR)*(UL-UR)+(PL-PR)*(PL-PR)+(CL-CR)*(CL-CR);
+			if(dist < atc)
+			    {
+				D[1][j] = acs_u;
+				D[2][j] = acs_p;
+				D[0][j] = acs_p/C_star/C_star;
+				D[3][j] = D[0][j];
+			    }
+			else
+			    {
+				D[1][j] = (dL*bR-dR*bL)/(aL*bR-aR*bL);
+				D[2][j] = (dL*aR-dR*aL)/(bL*aR-bR*aL);
+				D[0][j] = D[2][j]/C_starL/C_starL;
+				D[3][j] = D[2][j]/C_starR/C_starR;
+			    }
+		    }
+	    }
+}
@@ -1,6 +1,8 @@
 /**
  * @file  riemann_solver_exact_Ben.c
  * @brief There are exact Riemann solvers in Ben-Artzi's book.
+ * @details The Newton iteration is started from the adaptive guess Riemann_guess_P(),
+ *          which is exact for two rarefaction waves in a γ-law gas, then the solution is returned without iteration.
  * @sa   Theory is found in Appendix C of Reference [1]. \n
  *       [1] M. Ben-Artzi & J. Falcovitz, "Generalized Riemann problems in computational fluid dynamics". 
  *           Cambridge University Press, 2003
@@ -10,6 +12,8 @@
 #include <stdio.h>
 #include <stdbool.h>
 
+#include "../include/riemann_solver.h"
+
 
 /**
  * @brief EXACT RIEMANN SOLVER FOR Two-Component γ-Law Gas
@@ -32,13 +36,34 @@ double Riemann_solver_exact(double * U_star, double * P_star, const double gamma
 			    const double c_L, const double c_R, _Bool * CRW,
 			    const double eps, const double tol, const int N)
 {
+  *P_star = 0.0; // no initial guess
+  return Riemann_solver_exact_warm(U_star, P_star, gammaL, gammaR, u_L, u_R, p_L, p_R, c_L, c_R, CRW, eps, tol, N, NULL);
+}
+
+
+/**
+ * @brief EXACT RIEMANN SOLVER FOR Two-Component γ-Law Gas, started from a given guess of the star pressure
+ * @details The star pressure of the last time step is a good initial guess of the Newton iteration in smooth flows.
+ *          The guess is not used if it lies on another branch (shock/rarefaction) of the left or right wave curve
+ *          than the solution does, i.e. if the sign of p_0-p_L or p_0-p_R changes.
+ * @param[in,out] P_star: Pressure in star region, the initial guess p_0 on input (not used if p_0 ≤ eps).
+ * @param[out] n_iter: Number of the Newton iterations (not given if it is NULL).
+ * @sa    Other parameters are the same as Riemann_solver_exact().
+ * @return  \b gap: Relative pressure change after the last iteration.
+ */
+double Riemann_solver_exact_warm(double * U_star, double * P_star, const double gammaL, const double gammaR,
+				 const double u_L, const double u_R, const double p_L, const double p_R,
+				 const double c_L, const double c_R, _Bool * CRW,
+				 const double eps, const double tol, const int N, int * n_iter)
+{
+  const double p_0 = *P_star;
   double muL, nuL;
   double muR, nuR;
   double delta_p, u_LR, u_RL;
   double k1, k3, p_INT, p_INT0, u_INT;
   double v_L, v_R, gap;
   double temp1, temp2, temp3;
-  int n = 0;
+  int n = 0, guess = RG_WARM;
 
   muL = (gammaL-1.0) / (2.0*gammaL);
   nuL = (gammaL+1.0) / (2.0*gammaL);
@@ -83,14 +108,13 @@ double Riemann_solver_exact(double * U_star, double * P_star, const double gamma
   else
     CRW[0] = false;
 
-  //======one step of the Newton ietration to get the intersection point of I1 and I3====
+  //======the initial guess of the Newton ietration, see Riemann_guess_P()====
   k1 = -c_L / p_L / gammaL;//the (p,u)-tangent slope on I1 at (u_L,p_L), i.e. [du/dp](p_L)
   k3 =  c_R / p_R / gammaR;//the (p,u)-tangent slope on I3 at (u_R,p_R), i.e. [du/dp](p_R)
-  //the intersect of (u-u_L)=k1*(p-p_L) and (u-u_R)=k3*(p-p_R)
-  p_INT = (k1*p_L - k3*p_R - u_L + u_R) / (k1 - k3);
-  if(p_INT < 0)
-    p_INT = (p_L<p_R)? p_L : p_R;
-  p_INT = 0.5*p_INT;
+  if(isfinite(p_0) && p_0 > eps && (p_0 > p_L) != CRW[0] && (p_0 > p_R) != CRW[1])
+    p_INT = p_0; // the initial guess lies on the same branches of I1 and I3 as the star pressure
+  else
+    p_INT = Riemann_guess_P(gammaL, gammaR, u_L, u_R, p_L, p_R, c_L, c_R, eps, &guess);
 
   //=======compute the gap between U^n_R and U^n_L(see Appendix C)=======
   if(p_INT > p_L)
@@ -120,11 +144,16 @@ double Riemann_solver_exact(double * U_star, double * P_star, const double gamma
     v_R = u_R + v_R;
   }
   gap = fabs(v_L - v_R);
+  if(guess == RG_TRRS && p_INT <= p_L && p_INT <= p_R)
+    gap = 0.0; // two rarefaction waves, the TRRS guess is exact without any iteration
 
   if (fabs(u_L - u_R) < tol && fabs(p_L - p_R) < tol)
       {
 	  *P_star = 0.5*(p_L + p_R);
 	  *U_star = 0.5*(u_L + u_R);
+	  if(n_iter)
+	      *n_iter = 0;
+	  Riemann_exact_count(guess, 0, CRW);
 
 	  return fabs(u_L - u_R);
       }
@@ -206,6 +235,9 @@ double Riemann_solver_exact(double * U_star, double * P_star, const double gamma
 
   *P_star = p_INT;
   *U_star = u_INT;
+  if(n_iter)
+    *n_iter = n;
+  Riemann_exact_count(guess, n, CRW);
 
   return gap;
 }
@@ -232,12 +264,31 @@ double Riemann_solver_exact_Ben(double * U_star, double * P_star, const double g
 			    const double c_L, const double c_R, _Bool * CRW,
 			    const double eps, const double tol, const int N)
 {
+  *P_star = 0.0; // no initial guess
+  return Riemann_solver_exact_Ben_warm(U_star, P_star, gamma, u_L, u_R, p_L, p_R, c_L, c_R, CRW, eps, tol, N, NULL);
+}
+
+
+/**
+ * @brief EXACT RIEMANN SOLVER FOR A γ-Law Gas, started from a given guess of the star pressure
+ * @details The guess is not used if the sign of p_0-p_L or p_0-p_R changes, see Riemann_solver_exact_warm().
+ * @param[in,out] P_star: Pressure in star region, the initial guess p_0 on input (not used if p_0 ≤ eps).
+ * @param[out] n_iter: Number of the Newton iterations (not given if it is NULL).
+ * @sa    Other parameters are the same as Riemann_solver_exact_Ben().
+ * @return  \b gap: Relative pressure change after the last iteration.
+ */
+double Riemann_solver_exact_Ben_warm(double * U_star, double * P_star, const double gamma,
+				     const double u_L, const double u_R, const double p_L, const double p_R,
+				     const double c_L, const double c_R, _Bool * CRW,
+				     const double eps, const double tol, const int N, int * n_iter)
+{
+  const double p_0 = *P_star;
   double mu, nu;
   double delta_p, u_LR, u_RL;
   double k1, k3, p_INT, p_INT0, u_INT;
   double v_L, v_R, gap;
   double temp1, temp2, temp3;
-  int n = 0;
+  int n = 0, guess = RG_WARM;
 
   mu = (gamma-1.0) / (2.0*gamma);
   nu = (gamma+1.0) / (2.0*gamma);
@@ -280,14 +331,13 @@ double Riemann_solver_exact_Ben(double * U_star, double * P_star, const double g
   else
     CRW[0] = false;
 
-  //======one step of the Newton ietration to get the intersection point of I1 and I3====
+  //======the initial guess of the Newton ietration, see Riemann_guess_P()====
   k1 = -c_L / p_L / gamma;//the (p,u)-tangent slope on I1 at (u_L,p_L), i.e. [du/dp](p_L)
   k3 =  c_R / p_R / gamma;//the (p,u)-tangent slope on I3 at (u_R,p_R), i.e. [du/dp](p_R)
-  //the intersect of (u-u_L)=k1*(p-p_L) and (u-u_R)=k3*(p-p_R)
-  p_INT = (k1*p_L - k3*p_R - u_L + u_R) / (k1 - k3);
-  if(p_INT < 0)
-    p_INT = (p_L<p_R)? p_L : p_R;
-  p_INT = 0.5*p_INT;
+  if(isfinite(p_0) && p_0 > eps && (p_0 > p_L) != CRW[0] && (p_0 > p_R) != CRW[1])
+    p_INT = p_0; // the initial guess lies on the same branches of I1 and I3 as the star pressure
+  else
+    p_INT = Riemann_guess_P(gamma, gamma, u_L, u_R, p_L, p_R, c_L, c_R, eps, &guess);
 
   //=======compute the gap between U^n_R and U^n_L(see Appendix C)=======
   if(p_INT > p_L)
@@ -317,11 +367,16 @@ double Riemann_solver_exact_Ben(double * U_star, double * P_star, const double g
     v_R = u_R + v_R;
   }
   gap = fabs(v_L - v_R);
+  if(guess == RG_TRRS && p_INT <= p_L && p_INT <= p_R)
+    gap = 0.0; // two rarefaction waves, the TRRS guess is exact without any iteration
 
   if (fabs(u_L - u_R) < tol && fabs(p_L - p_R) < tol)
       {
 	  *P_star = 0.5*(p_L + p_R);
 	  *U_star = 0.5*(u_L + u_R);
+	  if(n_iter)
+	      *n_iter = 0;
+	  Riemann_exact_count(guess, 0, CRW);
 
 	  return fabs(u_L - u_R);
       }
@@ -403,6 +458,9 @@ double Riemann_solver_exact_Ben(double * U_star, double * P_star, const double g
 
   *P_star = p_INT;
   *U_star = u_INT;
+  if(n_iter)
+    *n_iter = n;
+  Riemann_exact_count(guess, n, CRW);
 
   return gap;
 }
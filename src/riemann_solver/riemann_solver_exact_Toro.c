@@ -7,6 +7,8 @@
 #include <stdio.h>
 #include <stdbool.h>
 
+#include "../include/riemann_solver.h"
+
 
 /**
  * @brief EXACT RIEMANN SOLVER FOR THE EULER EQUATIONS
@@ -38,7 +40,27 @@ double Riemann_solver_exact_Toro(double * U_star, double * P_star, const double
 				 const double c_l, const double c_r, _Bool * CRW,
 				 const double eps, const double tol, const int N)
 {
-    int n = 0;		
+    *P_star = 0.0; // no initial guess
+    return Riemann_solver_exact_Toro_warm(U_star, P_star, gamma, U_l, U_r, P_l, P_r, c_l, c_r, CRW, eps, tol, N, NULL);
+}
+
+
+/**
+ * @brief EXACT RIEMANN SOLVER FOR THE EULER EQUATIONS, started from a given guess of the star pressure
+ * @details The guess is not used if the sign of P_0-P_l or P_0-P_r differs from that of the adaptive
+ *          approximation Riemann_guess_P() of the star pressure, since the Newton iteration may then cross a branch of the wave curves.
+ * @param[in,out] P_star: Pressure in star region, the initial guess P_0 on input (not used if P_0 ≤ eps).
+ * @param[out] n_iter: Number of the Newton iterations (not given if it is NULL).
+ * @sa    Other parameters are the same as Riemann_solver_exact_Toro().
+ * @return  \b gap: Relative pressure change after the last iteration.
+ */
+double Riemann_solver_exact_Toro_warm(double * U_star, double * P_star, const double gamma,
+				      const double U_l, const double U_r, const double P_l, const double P_r,
+				      const double c_l, const double c_r, _Bool * CRW,
+				      const double eps, const double tol, const int N, int * n_iter)
+{
+    const double P_0 = *P_star;
+    int n = 0, guess;
     double gap = INFINITY; // Relative pressure change after each iteration.
 	
     double P_int,U_int; // =>P_star,U_star
@@ -63,10 +85,22 @@ double Riemann_solver_exact_Toro(double * U_star, double * P_star, const double
     double B_R=g6*P_r;
 
     //======Set the approximate value of p_star================================
-    P_int  = pow( (c_l + c_r -  0.5*g8*(U_r-U_l)) / (c_l/pow(P_l,1/g3)+c_r/pow(P_r,1/g3)) , g3);
+    P_int  = Riemann_guess_P(gamma, gamma, U_l, U_r, P_l, P_r, c_l, c_r, eps, &guess);
+    if(isfinite(P_0) && P_0 > eps && (P_0 > P_l) == (P_int > P_l) && (P_0 > P_r) == (P_int > P_r))
+	{
+	    P_int = P_0;
+	    guess = RG_WARM;
+	}
+    else if(guess == RG_TRRS && P_int <= P_l && P_int <= P_r)
+	{ // two rarefaction waves, the TRRS guess is exact
+	    f_L = 2.0*c_l/g8*(pow(P_int/P_l,1.0/g3)-1.0);
+	    f_R = 2.0*c_r/g8*(pow(P_int/P_r,1.0/g3)-1.0);
+	    gap = 0.0;
+	    n = -1; // no iteration
+	}
 
     //===============THE NEWTON ITERATION=====================
-    while(n < N)
+    while(n >= 0 && n < N)
 	{
 	    P_int_save=P_int;
 
@@ -113,6 +147,10 @@ double Riemann_solver_exact_Toro(double * U_star, double * P_star, const double
 
     *P_star = P_int;
     *U_star = U_int;
+    n = gap < tol ? n+1 : n;
+    if(n_iter)
+	*n_iter = n;
+    Riemann_exact_count(guess, n, CRW);
   
     return gap;
 }
@@ -0,0 +1,190 @@
+/**
+ * @file  riemann_solver_exact_adapt.c
+ * @brief There are the adaptive initial guess and the statistics shared by the exact Riemann solvers and the GRP solvers.
+ * @details The star pressure is guessed by the PVRS, TRRS or TSRS approximation by the pressure ratio,
+ *          as in the adaptive Riemann solver of Toro. The TRRS guess is the exact solution of two rarefaction
+ *          waves with the same γ, then the exact solvers return it without any iteration.
+ *
+ *          Each thread counts the solutions, iterations, guesses and wave patterns of the exact solvers
+ *          and the paths of the quasi-1D GRP solver it has called, which are summed up by Riemann_exact_stat().
+ * @sa   Theory is found in Chapter 9 of Reference [1]. \n
+ *       [1] E. F. Toro, "Riemann Solvers and Numerical Methods for Fluid Dynamics". 
+ *           Springer-Verlag, Second Edition, 1999
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "../include/riemann_solver.h"
+
+
+#ifndef RIEMANN_Q_USER
+//! The largest pressure ratio p_max/p_min for which the PVRS guess is used.
+#define RIEMANN_Q_USER 2.0
+#endif
+
+#ifndef _OPENACC
+static struct riemann_stat rs_thread; // statistics of the calling thread
+#pragma omp threadprivate(rs_thread)
+#endif
+
+
+/**
+ * @brief This function gives an initial guess of the star pressure by the adaptive approximate Riemann solver.
+ * @param[in]  gammaL, gammaR: Ratio of specific heats.
+ * @param[in]  u_L, p_L, c_L:  Initial Velocity/Pressure/sound_speed on left  state.
+ * @param[in]  u_R, p_R, c_R:  Initial Velocity/Pressure/sound_speed on right state.
+ * @param[in]  eps:   The largest value can be seen as zero.
+ * @param[out] guess: The approximation given (enum riemann_guess_id).
+ *                    - RG_PVRS: primitive variable solver, if p_max/p_min ≤ RIEMANN_Q_USER and p_min ≤ p_PV ≤ p_max.
+ *                    - RG_TRRS: two-rarefaction solver, if p_PV < p_min and γL = γR (PVRS otherwise).
+ *                    - RG_TSRS: two-shock solver, otherwise.
+ * @return  \b p: A guess of the star pressure.
+ */
+double Riemann_guess_P(const double gammaL, const double gammaR, const double u_L, const double u_R,
+		       const double p_L, const double p_R, const double c_L, const double c_R,
+		       const double eps, int * guess)
+{
+    const double rho_L = gammaL*p_L/c_L/c_L, rho_R = gammaR*p_R/c_R/c_R;
+    const double p_min = p_L < p_R ? p_L : p_R;
+    const double p_max = p_L > p_R ? p_L : p_R;
+    double p_PV, p, z, g_L, g_R;
+
+    p_PV = 0.5*(p_L+p_R) + 0.125*(u_L-u_R)*(rho_L+rho_R)*(c_L+c_R);
+    p_PV = eps > p_PV ? eps : p_PV;
+    if (p_max/p_min <= RIEMANN_Q_USER && p_min <= p_PV && p_PV <= p_max)
+	{
+	    *guess = RG_PVRS;
+	    return p_PV;
+	}
+    if (p_PV < p_min)
+	{
+	    *guess = RG_PVRS;
+	    if (gammaL != gammaR)
+		return p_PV;
+	    z = 0.5*(gammaL-1.0)/gammaL;
+	    p = c_L + c_R - 0.5*(gammaL-1.0)*(u_R-u_L);
+	    if (p <= 0.0) // vacuum is generated
+		return eps;
+	    *guess = RG_TRRS;
+	    p = pow(p/(c_L/pow(p_L,z) + c_R/pow(p_R,z)), 1.0/z);
+	    return eps > p ? eps : p;
+	}
+    g_L = sqrt(2.0/((gammaL+1.0)*rho_L)/((gammaL-1.0)/(gammaL+1.0)*p_L + p_PV));
+    g_R = sqrt(2.0/((gammaR+1.0)*rho_R)/((gammaR-1.0)/(gammaR+1.0)*p_R + p_PV));
+    p = (g_L*p_L + g_R*p_R - (u_R-u_L))/(g_L + g_R);
+    *guess = RG_TSRS;
+    return eps > p ? eps : p;
+}
+
+
+/**
+ * @brief This function counts a solution of an exact Riemann solver on the calling thread.
+ * @param[in] guess:  The initial guess (enum riemann_guess_id).
+ * @param[in] n_iter: Number of the iterations.
+ * @param[in] CRW:    Centred Rarefaction Wave (CRW) Indicator of left and right waves.
+ */
+void Riemann_exact_count(const int guess, const int n_iter, const _Bool * CRW)
+{
+#ifndef _OPENACC
+    rs_thread.solve++;
+    rs_thread.iter += n_iter;
+    rs_thread.exact += !n_iter;
+    rs_thread.guess[guess]++;
+    rs_thread.wave[2*!CRW[0] + !CRW[1]]++;
+#else
+    (void)guess; (void)n_iter; (void)CRW;
+#endif
+}
+
+
+/**
+ * @brief This function counts an interface of the quasi-1D GRP solver on the calling thread.
+ * @param[in] path: The path of the solver (enum grp_path_id).
+ */
+void GRP_path_count(const int path)
+{
+#ifndef _OPENACC
+    rs_thread.grp[path]++;
+#else
+    (void)path;
+#endif
+}
+
+
+/**
+ * @brief This function counts an interface of the hybrid GRP flux on the calling thread.
+ * @param[in] flagged: Whether the interface is flagged by the sensor and given by the full GRP solver.
+ */
+void GRP_hybrid_count(const _Bool flagged)
+{
+#ifndef _OPENACC
+    rs_thread.hyb[flagged]++;
+#else
+    (void)flagged;
+#endif
+}
+
+
+/**
+ * @brief This function sums up the statistics of the exact Riemann solvers of all the threads.
+ * @param[out] rs:    The statistics.
+ * @param[in]  reset: Whether the statistics of the threads are reset.
+ */
+void Riemann_exact_stat(struct riemann_stat * rs, const _Bool reset)
+{
+    memset(rs, 0, sizeof(struct riemann_stat));
+#ifndef _OPENACC
+#pragma omp parallel
+    {
+#pragma omp critical
+	{
+	    int i;
+	    rs->solve += rs_thread.solve;
+	    rs->iter  += rs_thread.iter;
+	    rs->exact += rs_thread.exact;
+	    for (i = 0; i < RG_NUM; i++)
+		rs->guess[i] += rs_thread.guess[i];
+	    for (i = 0; i < 4; i++)
+		rs->wave[i] += rs_thread.wave[i];
+	    for (i = 0; i < GP_NUM; i++)
+		rs->grp[i] += rs_thread.grp[i];
+	    for (i = 0; i < 2; i++)
+		rs->hyb[i] += rs_thread.hyb[i];
+	}
+	if (reset)
+	    memset(&rs_thread, 0, sizeof(struct riemann_stat));
+    }
+#else
+    (void)reset;
+#endif
+}
+
+
+/**
+ * @brief This function prints the statistics of the exact Riemann solvers and of the paths of the GRP solvers.
+ */
+void Riemann_exact_stat_report(void)
+{
+    struct riemann_stat rs;
+    Riemann_exact_stat(&rs, false);
+    const long n_grp = rs.grp[GP_TRIVIAL] + rs.grp[GP_ACOUSTIC] + rs.grp[GP_NONLINEAR];
+    if (n_grp)
+	printf("\nQuasi-1D GRP solver: %ld interfaces, trivial %.2f%%, acoustic %.2f%%, nonlinear %.2f%%\n", n_grp,
+	       100.0*rs.grp[GP_TRIVIAL]/n_grp, 100.0*rs.grp[GP_ACOUSTIC]/n_grp, 100.0*rs.grp[GP_NONLINEAR]/n_grp);
+    const long n_hyb = rs.hyb[0] + rs.hyb[1];
+    if (n_hyb)
+	printf("Hybrid GRP flux: %ld interfaces, smooth (acoustic) %.2f%%, flagged (full GRP) %.2f%%\n", n_hyb,
+	       100.0*rs.hyb[0]/n_hyb, 100.0*rs.hyb[1]/n_hyb);
+    if (!rs.solve)
+	return;
+    const double s = 100.0/(double)rs.solve;
+    printf("\nExact Riemann solver: %ld solutions, %.3g iterations per solution, %.2f%% without iteration\n",
+	   rs.solve, (double)rs.iter/(double)rs.solve, s*rs.exact);
+    printf("  initial guess: PVRS %.2f%%, TRRS %.2f%%, TSRS %.2f%%, warm start %.2f%%\n",
+	   s*rs.guess[RG_PVRS], s*rs.guess[RG_TRRS], s*rs.guess[RG_TSRS], s*rs.guess[RG_WARM]);
+    printf("  waves (L-R):   RW-RW %.2f%%, RW-SW %.2f%%, SW-RW %.2f%%, SW-SW %.2f%%\n",
+	   s*rs.wave[0], s*rs.wave[1], s*rs.wave[2], s*rs.wave[3]);
+}
@@ -6,56 +6,7 @@
 #include <math.h>
 #include <stdbool.h>
 
-
-/**
- * @brief Provide a guess value for pressure PM in the Star Region.
- * @details The choice is made according to adaptive Riemann solver using the
- *          PVRS (or TRRS or TSRS) ApproxImate Riemann Solvers (AIRS).
- * @param[in]  DL, UL, PL, CL: Initial Density/Velocity/Pressure/Sound_speed on left  state.
- * @param[in]  DR, UR, PR, CR: Initial Density/Velocity/Pressure/Sound_speed on right state.
- * @param[in]  GammaL, GammaR: Ratio of specific heats.
- * @param[in]  eps: The largest value can be seen as zero.
- * @return   \b PM: A guess value for pressure in the Star Region.
- */
-static double GuessP(const double DL, const double DR, const double UL, const double UR, const double PL, const double PR,
-		     const double CL, const double CR, const double GammaL, const double GammaR, const double eps)
-{
-	double PM;
-	double CUP,GEL,GER,PMAX,PMIN,PPV,QMAX;
-	const double QUSER=2.0;
-
-	CUP=0.25*(DL+DR)*(CL+CR);
-	PPV=0.5*(PL+PR)+0.5*(UL-UR)*CUP;
-	PPV=(eps>PPV?eps:PPV);
-	PMIN=(PL<PR?PL:PR);
-	PMAX=(PL>PR?PL:PR);
-	QMAX=PMAX/PMIN;
-	if(QMAX<=QUSER&&PMIN<=PPV&&PPV<=PMAX)//PVRS solution
-		PM=PPV;
-	/*
-			 else if(PPV<PMIN)//Two rarefaction
-			 {
-			 //PQ=pow(PL/PR,(Gamma-1.)/(2.*Gamma));
-			 //UM=(PQ*UL/CL+UR/CR+2./(Gamma-1.)*(PQ-1.))/(PQ/CL+1./CR);
-			 //PTL=1.+(Gamma-1.)/2.*(UL-UM)/CL;
-			 //PTR=1.+(Gamma-1.)/2.*(UM-UR)/CR;
-			 //PM=0.5*(pow(PL*PTL,2.*Gamma/(Gamma-1.))+pow(PR*PTR,2.*Gamma/(Gamma-1.)));
-			 PNU=CL+CR-0.5*(Gamma-1.)*(UR-UL);
-			 PDE=CL/(pow(PL,0.5*(Gamma-1.)/Gamma))+CR/(pow(PR,0.5*(Gamma-1.)/Gamma));
-			 PM=pow(PNU/PDE,2.*Gamma/(Gamma-1.));
-			 }
-	*/
-	else if(PPV<PMIN)//No 2-GAMMA TRRS, We use PVRS too.
-		PM=PPV;
-	else//Two shock
-		{
-			GEL=sqrt((2./((GammaL+1.)*DL))/((GammaL-1.)/(GammaL+1.)*PL+PPV));
-			GER=sqrt((2./((GammaR+1.)*DR))/((GammaR-1.)/(GammaR+1.)*PR+PPV));
-			PM=(GEL*PL+GER*PR-(UR-UL))/(GEL+GER);
-			PM=(eps>PM?eps:PM);
-		}
-	return PM;
-}
+#include "../include/riemann_solver.h"
 
 
 /**
@@ -124,11 +75,22 @@ double Riemann_solver_starPU(double * U_star, double * P_star, const double Gamm
 	double DR=GammaR*PR/CR/CR;
 	double P=0.5*(PL+PR), U=0.5*(UL+UR);
 	double change = 0.0,FL,FR,FLD,FRD,POLD,PSTART,UDIFF;
-	PSTART = GuessP(DL,DR,UL,UR,PL,PR,CL,CR,GammaL,GammaR,eps);
+	int guess, n = 0;
+	_Bool exact;
+	PSTART = Riemann_guess_P(GammaL,GammaR,UL,UR,PL,PR,CL,CR,eps,&guess);
 	POLD=PSTART;
 	UDIFF=UR-UL;
-	for(int i=1;i<=NRITER;i++)
+	exact=guess==RG_TRRS&&PSTART<=PL&&PSTART<=PR;
+	if(exact)//Two rarefaction, the TRRS guess is exact
+		{
+			PreFun(&FL,&FLD,PSTART,DL,PL,CL,GammaL);
+			PreFun(&FR,&FRD,PSTART,DR,PR,CR,GammaR);
+			P=PSTART;
+			U=0.5*(UL+UR+FR-FL);
+		}
+	for(int i=1;i<=NRITER&&!exact;i++)
 		{
+			n=i;
 			PreFun(&FL,&FLD,POLD,DL,PL,CL,GammaL);
 			PreFun(&FR,&FRD,POLD,DR,PR,CR,GammaR);
 			P=POLD-(FL+FR+UDIFF)/(FLD+FRD);
@@ -154,6 +116,7 @@ double Riemann_solver_starPU(double * U_star, double * P_star, const double Gamm
 
 	* U_star = U;
 	* P_star = P;
+	Riemann_exact_count(guess, n, CRW);
 
 	return change;
 } 
@@ -0,0 +1,182 @@
+/**
+ * @file arena.c
+ * @brief This file is the source codes of the workspace arenas after the interface 'Arena' in the book 'C Interfaces and Implementations'.
+ * @details An arena is one aligned region allocated by the interface 'Mem', from which the scratch arrays are carved
+ *          and which is reset by Arena_free() rather than freed array by array. An allocation beyond the region is
+ *          given by an overflow chunk, and the region is grown to the peak usage at the next reset, so that the
+ *          region fits the solver after its first run. Each OpenMP thread has its workspace given by Arena_workspace(),
+ *          which is kept for the next runs on the thread (ensemble members, restarts) until Arena_workspace_dispose().
+ *          The large arrays given by Arena_calloc() are zeroed by all the OpenMP threads, so that their pages are
+ *          first touched by the threads of the static loops.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "../include_cii/except.h"
+#include "../include_cii/mem.h"
+#include "../include_cii/arena.h"
+#include "../include/tools.h"
+#define T Arena_T
+#define ARENA_MAX_THREADS 256 //!< Largest number of OpenMP threads having a workspace.
+#define ARENA_TOUCH (1L << 20) //!< Smallest bytes of an array zeroed by all the threads in Arena_calloc().
+const Except_T Arena_Failed = { (char*)"Arena Workspace Failed" };
+struct chunk {
+	struct chunk *next;
+};
+struct Arena {
+	char *base;          // address given by Mem_alloc
+	char *region;        // aligned start of the region
+	long size;           // bytes of the region
+	long used;           // bytes carved from the region
+	long over;           // bytes carved from the overflow chunks
+	long peak;           // largest usage since Arena_new
+	long n_over;         // number of the overflow chunks since Arena_new
+	struct chunk *chunk; // overflow chunks since the last reset
+};
+static T ws[ARENA_MAX_THREADS];
+static long align(long nbytes) {
+	return (nbytes + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+}
+static void region_new(T arena, long nbytes,
+	const char *file, int line) {
+	if (arena->base)
+		Mem_free(arena->base, file, line);
+	arena->base = NULL;
+	arena->region = NULL;
+	arena->size = 0;
+	if (nbytes > 0) {
+		nbytes = align(nbytes);
+		arena->base = (char *)Mem_alloc(nbytes + ARENA_ALIGN, file, line);
+		arena->region = arena->base
+			+ (ARENA_ALIGN - (uintptr_t)arena->base % ARENA_ALIGN) % ARENA_ALIGN;
+		arena->size = nbytes;
+		place_huge_advise(arena->region, nbytes);
+	}
+}
+T Arena_new(long nbytes, const char *file, int line) {
+	T arena;
+	assert(nbytes >= 0);
+	arena = (T)Mem_calloc(1, (long)sizeof(*arena), file, line);
+	region_new(arena, nbytes, file, line);
+	return arena;
+}
+void Arena_dispose(T *ap) {
+	assert(ap && *ap);
+	Arena_free(*ap);
+	if ((*ap)->base)
+		Mem_free((*ap)->base, __FILE__, __LINE__);
+	FREE(*ap);
+}
+void Arena_reserve(T arena, long nbytes,
+	const char *file, int line) {
+	assert(arena);
+	assert(nbytes >= 0);
+	if (arena->used == 0 && arena->over == 0 && arena->size < nbytes)
+		region_new(arena, nbytes, file, line);
+}
+void *Arena_alloc(T arena, long nbytes,
+	const char *file, int line) {
+	char *ptr;
+	assert(arena);
+	assert(nbytes >= 0);
+	nbytes = align(nbytes > 0 ? nbytes : 1);
+	if (arena->used + nbytes <= arena->size) {
+		ptr = arena->region + arena->used;
+		arena->used += nbytes;
+	} else {
+		const long head = align((long)sizeof(struct chunk));
+		char *b = (char *)Mem_alloc(head + nbytes + ARENA_ALIGN, file, line);
+		struct chunk *c = (struct chunk *)b;
+		c->next = arena->chunk;
+		arena->chunk = c;
+		ptr = b + head;
+		ptr += (ARENA_ALIGN - (uintptr_t)ptr % ARENA_ALIGN) % ARENA_ALIGN;
+		arena->over += nbytes;
+		arena->n_over++;
+	}
+	if (arena->used + arena->over > arena->peak)
+		arena->peak = arena->used + arena->over;
+	return ptr;
+}
+void *Arena_calloc(T arena, long count, long nbytes,
+	const char *file, int line) {
+	void *ptr;
+	assert(count >= 0);
+	assert(nbytes >= 0);
+	ptr = Arena_alloc(arena, count*nbytes, file, line);
+#ifdef _OPENMP
+	// A large array is first touched by the threads in the static parts of the loops over its items.
+	if (count*nbytes >= ARENA_TOUCH && !omp_in_parallel()) {
+#pragma omp parallel
+		{
+			const long n_t = omp_get_num_threads(), t = omp_get_thread_num();
+			const long k0 = count*t/n_t, k1 = count*(t+1)/n_t;
+			memset((char *)ptr + k0*nbytes, '\0', (k1-k0)*nbytes);
+		}
+		return ptr;
+	}
+#endif
+	memset(ptr, '\0', count*nbytes);
+	return ptr;
+}
+void Arena_free(T arena) {
+	struct chunk *c;
+	assert(arena);
+	while ((c = arena->chunk) != NULL) {
+		arena->chunk = c->next;
+		Mem_free(c, __FILE__, __LINE__);
+	}
+	if (arena->over > 0) // grown to the peak usage
+		region_new(arena, arena->peak, __FILE__, __LINE__);
+	arena->used = 0;
+	arena->over = 0;
+}
+long Arena_peak(T arena) {
+	assert(arena);
+	return arena->peak;
+}
+long Arena_size(T arena) {
+	assert(arena);
+	return arena->size;
+}
+T Arena_workspace(void) {
+#ifdef _OPENMP
+	const int id = omp_get_thread_num();
+#else
+	const int id = 0;
+#endif
+	if (id >= ARENA_MAX_THREADS)
+		RAISE(Arena_Failed);
+	if (ws[id] == NULL)
+		ws[id] = ARENA_NEW(0);
+	return ws[id];
+}
+void Arena_workspace_report(void) {
+	long peak = 0, size = 0, n_over = 0;
+	int id, n = 0;
+	for (id = 0; id < ARENA_MAX_THREADS; id++)
+		if (ws[id]) {
+			n++;
+			peak = ws[id]->peak > peak ? ws[id]->peak : peak;
+			size += ws[id]->size;
+			n_over += ws[id]->n_over;
+		}
+	if (n == 0)
+		return;
+	printf("%-22s%10d%16ld\n", "Workspace peak (kB)", n, (peak + 1023) / 1024); // in the column of the calls: threads
+	printf("%-22s%10s%16ld\n", "Workspace size (kB)", "", (size + 1023) / 1024);
+	if (n_over > 0)
+		printf("%-22s%10s%16ld\n", "Workspace overflows", "", n_over);
+}
+void Arena_workspace_dispose(void) {
+	int id;
+	for (id = 0; id < ARENA_MAX_THREADS; id++)
+		if (ws[id])
+			Arena_dispose(&ws[id]);
+}
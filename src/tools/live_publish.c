@@ -0,0 +1,274 @@
+/**
+ * @file  live_publish.c
+ * @brief There is the live publish of the current fluid variables into a shared-memory ring buffer.
+ * @details At an interval of wall-clock time, the solvers copy the current fields (downsampled by a stride)
+ *          into the next slot of a ring in a POSIX shared-memory object, which an external viewer or an adaptor
+ *          (e.g. ParaView Catalyst) maps while the run goes on. The solver never waits for the readers and does
+ *          no file I/O: a slot is guarded by a sequence number (seqlock), odd while the slot is written,
+ *          so a reader copies a slot and keeps the copy only if the sequence number is even and unchanged.
+ *
+ *          Layout of the object (native byte order, 8-byte aligned):
+ * <table>
+ * <tr><th> Offset               <th> Contents
+ * <tr><td> 0                    <td> struct lp_head: magic "HYDROPUB", version, n_slot, n_field, stride,
+ *                                    slot_bytes, cap, field names, frame, skipped
+ * <tr><td> LP_HEAD_BYTES + s*slot_bytes <td> struct lp_slot of the slot s: seq, step, time, dim[2]
+ * <tr><td> … + LP_SLOT_BYTES + f*cap*8  <td> field f of the slot, dim[0]×dim[1] doubles by rows
+ * </table>
+ *          The latest frame is in the slot (frame-1) % n_slot. The object is created at the first frame
+ *          (its capacity cap is that of the first frame) and removed at the end of the run.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "../include/tools.h"
+
+
+#define LP_N_SLOT     3  //!< Number of the slots of the ring.
+#define LP_FIELD_MAX  8  //!< Maximum number of the fields of a frame.
+#define LP_NAME_LEN   16 //!< Length of a field name (with the terminating zero).
+#define LP_HEAD_BYTES 256 //!< Bytes of the header of the object.
+#define LP_SLOT_BYTES 64  //!< Bytes of the header of a slot.
+
+//! Header of the shared-memory object.
+struct lp_head {
+	char magic[8];           //!< "HYDROPUB".
+	int32_t version;         //!< version of the layout (1).
+	int32_t n_slot;          //!< number of the slots.
+	int32_t n_field;         //!< number of the fields of a frame.
+	int32_t stride;          //!< stride of the downsampling in each direction.
+	int64_t slot_bytes;      //!< bytes of a slot, with its header.
+	int64_t cap;             //!< capacity (doubles) of a field of a slot.
+	char name[LP_FIELD_MAX][LP_NAME_LEN]; //!< names of the fields.
+	volatile int64_t frame;  //!< number of the frames published.
+	volatile int64_t skipped; //!< number of the frames larger than the capacity, not published.
+};
+
+//! Header of a slot.
+struct lp_slot {
+	volatile int64_t seq; //!< sequence number, odd while the slot is written.
+	int64_t step;         //!< time step.
+	double time;          //!< time of the solution.
+	int32_t dim[2];       //!< numbers of the rows and the columns of the fields.
+};
+
+static char   lp_name[LP_NAME_LEN*8]; // name of the shared-memory object
+static double lp_interval;            // wall-clock interval of the frames
+static int    lp_stride = 1;          // stride of the downsampling
+static int    lp_on = 0;              // whether the frames are published
+static double lp_last;                // wall-clock time of the last frame
+static long   lp_n_frame;             // number of the frames published
+static char * lp_base = NULL;         // mapping of the object
+static size_t lp_bytes;               // bytes of the object
+static double * lp_buf = NULL;        // work array of the fields computed for the frames
+static size_t lp_n_buf = 0;           // capacity of the work array
+
+/**
+ * @brief This function starts the live publish of the current fields.
+ * @param[in] name:     Name of the shared-memory object, such as "/hydrocode_example" (NULL: no publish).
+ * @param[in] interval: Wall-clock interval (s) of the frames (≤ 0: no publish).
+ * @param[in] stride:   Stride of the downsampling of the cells in each direction (1: full fields).
+ */
+void live_publish_open(const char * name, const double interval, const int stride)
+{
+    if (lp_on || name == NULL || !(interval > 0.0))
+	return;
+#ifdef _WIN32
+    printf("The live publish is not available on Windows.\n");
+#else
+    strncpy(lp_name, name, sizeof(lp_name)-1);
+    lp_interval = interval;
+    lp_stride   = stride > 1 ? stride : 1;
+    lp_last     = wall_time();
+    lp_n_frame  = 0;
+    lp_on       = 1;
+#endif
+}
+
+/**
+ * @brief This function tells whether a frame is due at this time step.
+ * @details The first time step is published, and then the time steps after the interval.
+ */
+int live_publish_due(void)
+{
+#ifdef _OPENMP
+    if (omp_in_parallel()) // the members of an ensemble running on the threads
+	return 0;
+#endif
+    return lp_on && (lp_n_frame == 0 || wall_time() - lp_last >= lp_interval);
+}
+
+/**
+ * @brief This function gives the work array of the live publish, for a field computed only for the frames
+ *        (such as the coordinates of the cell centers).
+ * @details The array is kept by the live publish and freed by live_publish_close().
+ * @param[in] n: Number of the values.
+ * @return    The work array of at least n values.
+ */
+double * live_publish_buffer(const size_t n)
+{
+    if (n > lp_n_buf)
+	{
+	    free(lp_buf);
+	    if ((lp_buf = (double *)malloc(n * sizeof(double))) == NULL)
+		{
+		    printf("NOT enough memory! Live publish\n");
+		    exit(5);
+		}
+	    lp_n_buf = n;
+	}
+    return lp_buf;
+}
+
+#ifndef _WIN32
+/**
+ * @brief This function creates the shared-memory object for the frames of n_f fields of cap values.
+ * @return 0 if the object is mapped, -1 otherwise (the publish is stopped).
+ */
+static int lp_create(const int n_f, const char * const name[], const long cap)
+{
+    struct lp_head * h;
+    const long slot_bytes = LP_SLOT_BYTES + (long)n_f*cap*(long)sizeof(double);
+    int fd, f;
+
+    lp_bytes = LP_HEAD_BYTES + (size_t)LP_N_SLOT*slot_bytes;
+    shm_unlink(lp_name); // an object left by a killed run
+    fd = shm_open(lp_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)lp_bytes) != 0)
+	{
+	    fprintf(stderr, "Shared-memory object '%s' of the live publish cannot be created!\n", lp_name);
+	    if (fd >= 0)
+		{
+		    close(fd);
+		    shm_unlink(lp_name);
+		}
+	    lp_on = 0;
+	    return -1;
+	}
+    lp_base = (char *)mmap(NULL, lp_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (lp_base == MAP_FAILED)
+	{
+	    fprintf(stderr, "Shared-memory object '%s' of the live publish cannot be mapped!\n", lp_name);
+	    lp_base = NULL;
+	    shm_unlink(lp_name);
+	    lp_on = 0;
+	    return -1;
+	}
+    // ftruncate() gives the zeros, so every slot starts with an even sequence number and no frame.
+    h = (struct lp_head *)lp_base;
+    h->version    = 1;
+    h->n_slot     = LP_N_SLOT;
+    h->n_field    = n_f;
+    h->stride     = lp_stride;
+    h->slot_bytes = slot_bytes;
+    h->cap        = cap;
+    for (f = 0; f < n_f; f++)
+	strncpy(h->name[f], name[f], LP_NAME_LEN-1);
+    __sync_synchronize();
+    memcpy(h->magic, "HYDROPUB", 8); // the magic is written last, so a mapped header is complete
+    printf("The live publish of %d fields of at most %ld values is in the shared memory '%s' (/dev/shm).\n",
+	   n_f, cap, lp_name);
+    return 0;
+}
+#endif
+
+/**
+ * @brief This function publishes a frame of the current fields, downsampled by the stride, into the next slot.
+ * @details The fields are given by the pointers of their rows, so that the 1-D fields (M = 1) and the rows of the 2-D
+ *          fields are copied in place. The first frame creates the shared-memory object; the frames whose downsampled
+ *          size is larger than that of the first frame are counted as skipped.
+ * @param[in] step: Time step.
+ * @param[in] time: Time of the solution.
+ * @param[in] n_f:  Number of the fields (≤ LP_FIELD_MAX).
+ * @param[in] name: Names of the fields.
+ * @param[in] v:    Fields, the row i of the field f is v[f][i].
+ * @param[in] M:    Number of the rows of the fields.
+ * @param[in] N:    Number of the columns of the fields.
+ */
+void live_publish_frame(const int step, const double time, const int n_f, const char * const name[],
+			double * const * const v[], const int M, const int N)
+{
+#ifndef _WIN32
+    const int s = lp_stride, Mp = (M + s - 1)/s, Np = (N + s - 1)/s;
+    const int nf = n_f < LP_FIELD_MAX ? n_f : LP_FIELD_MAX;
+    struct lp_head * h;
+    struct lp_slot * sl;
+    double * d;
+    int f, i, j;
+
+    if (!lp_on)
+	return;
+    lp_last = wall_time();
+    lp_n_frame++;
+    if (lp_base == NULL && lp_create(nf, name, (long)Mp*Np) != 0)
+	return;
+    h = (struct lp_head *)lp_base;
+    if ((long)Mp*Np > h->cap || nf != h->n_field)
+	{
+	    h->skipped = h->skipped + 1;
+	    return;
+	}
+    sl = (struct lp_slot *)(lp_base + LP_HEAD_BYTES + (h->frame % LP_N_SLOT)*h->slot_bytes);
+    d  = (double *)((char *)sl + LP_SLOT_BYTES);
+    sl->seq = sl->seq + 1; // odd: being written
+    __sync_synchronize();
+    sl->step   = step;
+    sl->time   = time;
+    sl->dim[0] = Mp;
+    sl->dim[1] = Np;
+    for (f = 0; f < nf; f++, d += h->cap)
+	for (i = 0; i < Mp; i++)
+	    {
+		const double * row = v[f][i*s];
+		if (s == 1)
+		    memcpy(d + (long)i*Np, row, (size_t)Np*sizeof(double));
+		else
+		    for (j = 0; j < Np; j++)
+			d[(long)i*Np + j] = row[j*s];
+	    }
+    __sync_synchronize();
+    sl->seq = sl->seq + 1; // even: complete
+    __sync_synchronize();
+    h->frame = h->frame + 1;
+#else
+    (void)step; (void)time; (void)n_f; (void)name; (void)v; (void)M; (void)N;
+#endif
+}
+
+/**
+ * @brief This function stops the live publish, removes the shared-memory object and frees the work array.
+ * @details The readers which have mapped the object keep their mappings.
+ */
+void live_publish_close(void)
+{
+#ifndef _WIN32
+    if (lp_base)
+	{
+	    printf("The live publish gave %ld frames into '%s'.\n", lp_n_frame, lp_name);
+	    munmap(lp_base, lp_bytes);
+	    shm_unlink(lp_name);
+	    lp_base = NULL;
+	}
+#endif
+    free(lp_buf);
+    lp_buf   = NULL;
+    lp_n_buf = 0;
+    lp_on = 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file  mem_account.c
+ * @brief There are the accounts of the memory of the fields, tagged by the subsystems and the names of the fields.
+ * @details The allocators of the fields (field_alloc_2D(), the CV_INIT_MEM-style macros) add the bytes of a field
+ *          to the account of its subsystem and name, and their deallocators release them, so that the current and
+ *          the peak footprints of the subsystems are known at the output times and at exit.
+ *          The same accounts give the predicted footprint of a dry run, where the fields are accounted without allocation.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../include/tools.h"
+
+
+#define MA_MAX_FIELDS 256 //!< Maximum number of the accounted fields, the others are accounted by their subsystems.
+
+static const char * ma_name[MA_NUM] = {"Snapshots", "Slopes", "Interface values", "Fluxes", "Mesh", "Others"};
+
+static const char * ma_field[MA_MAX_FIELDS]; // names of the fields
+static int  ma_field_tag [MA_MAX_FIELDS];    // subsystems of the fields
+static long ma_field_cur [MA_MAX_FIELDS];    // current bytes of the fields
+static long ma_field_peak[MA_MAX_FIELDS];    // peak bytes of the fields
+static int  ma_n_field = 0;                  // number of the accounted fields
+static long ma_cur [MA_NUM+1];               // current bytes of the subsystems and of all (MA_NUM)
+static long ma_peak[MA_NUM+1];               // peak bytes of the subsystems and of all (MA_NUM)
+
+/**
+ * @brief This function adds the bytes of a field to the accounts.
+ * @details The field is found by its subsystem and name, and a new field is given a new account.
+ *          The peak of a subsystem is that of the sum of its fields, which is not larger than the sum of their peaks.
+ * @param[in] tag:    Subsystem of the field (enum mem_account_id).
+ * @param[in] field:  Name of the field (a string kept to the report, NULL: no field account).
+ * @param[in] nbytes: Allocated bytes (< 0: released bytes).
+ */
+void mem_account(const int tag, const char * field, const long nbytes)
+{
+    int f;
+    const int t = tag >= 0 && tag < MA_NUM ? tag : MA_OTHER;
+#ifdef _OPENMP
+#pragma omp critical (mem_account)
+#endif
+    {
+	for (f = 0; field && f < ma_n_field; f++)
+	    if (ma_field_tag[f] == t && strcmp(ma_field[f], field) == 0)
+		break;
+	if (field && f == ma_n_field && ma_n_field < MA_MAX_FIELDS)
+	    {
+		ma_field[f]     = field;
+		ma_field_tag[f] = t;
+		ma_n_field++;
+	    }
+	if (field && f < ma_n_field)
+	    {
+		ma_field_cur[f] += nbytes;
+		ma_field_peak[f] = ma_field_cur[f] > ma_field_peak[f] ? ma_field_cur[f] : ma_field_peak[f];
+	    }
+	ma_cur[t]      += nbytes;
+	ma_cur[MA_NUM] += nbytes;
+	ma_peak[t]      = ma_cur[t]      > ma_peak[t]      ? ma_cur[t]      : ma_peak[t];
+	ma_peak[MA_NUM] = ma_cur[MA_NUM] > ma_peak[MA_NUM] ? ma_cur[MA_NUM] : ma_peak[MA_NUM];
+    }
+}
+
+/**
+ * @brief This function gives the current bytes of a subsystem.
+ * @param[in] tag: Subsystem (enum mem_account_id, MA_NUM: all the subsystems).
+ * @return    The current bytes accounted.
+ */
+long mem_account_current(const int tag)
+{
+    return tag >= 0 && tag <= MA_NUM ? ma_cur[tag] : 0;
+}
+
+/**
+ * @brief This function gives the peak bytes of a subsystem.
+ * @param[in] tag: Subsystem (enum mem_account_id, MA_NUM: all the subsystems).
+ * @return    The peak bytes accounted.
+ */
+long mem_account_peak(const int tag)
+{
+    return tag >= 0 && tag <= MA_NUM ? ma_peak[tag] : 0;
+}
+
+/**
+ * @brief This function prints the table of the current and the peak footprints of the subsystems.
+ * @param[in] title:    Title of the table, such as the time of the output.
+ * @param[in] by_field: Whether the fields are listed under their subsystems.
+ */
+void mem_account_report(const char * title, const int by_field)
+{
+    int t, f;
+
+    if (ma_peak[MA_NUM] <= 0)
+	return;
+    printf("\n%-32s%16s%16s\n", title, "Current (kB)", "Peak (kB)");
+    for (t = 0; t < MA_NUM; t++)
+	{
+	    if (ma_peak[t] <= 0)
+		continue;
+	    printf("%-32s%16ld%16ld\n", ma_name[t], (ma_cur[t]+1023)/1024, (ma_peak[t]+1023)/1024);
+	    for (f = 0; by_field && f < ma_n_field; f++)
+		if (ma_field_tag[f] == t)
+		    printf("  %-30s%16ld%16ld\n", ma_field[f], (ma_field_cur[f]+1023)/1024, (ma_field_peak[f]+1023)/1024);
+	}
+    printf("%-32s%16ld%16ld\n", "Total", (ma_cur[MA_NUM]+1023)/1024, (ma_peak[MA_NUM]+1023)/1024);
+}
@@ -0,0 +1,273 @@
+/**
+ * @file  perf_counter.c
+ * @brief There are hardware performance counters of the phases timed by the phase timers (Linux perf_event).
+ * @details With the macro PERFCOUNTER, the counters of all the threads of the process are read
+ *          when the master thread starts and stops the timer of a phase, so the counts of a phase
+ *          include the parallel loops it encloses. The summary gives a roofline-style estimate:
+ *          - The bytes moved are the misses of the last level cache times the cache line size.
+ *          - The FLOPs are the retired double-precision floating-point operations (Intel Skylake and later, AMD Zen).
+ *          - A phase is memory-bound if its arithmetic intensity FLOP/byte is below PERF_RIDGE.
+ *
+ *          Without PERFCOUNTER, or on other systems, these functions do nothing.
+ */
+
+#if defined(PERFCOUNTER) && defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+
+#include "../include/tools.h"
+
+
+#ifndef PERF_RIDGE
+//! Ridge point of the roofline (FLOP/byte): peak FLOP rate over peak memory bandwidth of the node.
+#define PERF_RIDGE 10.0
+#endif
+
+#if defined(PERFCOUNTER) && defined(__linux__)
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PC_MAX_THREADS 256 //!< Maximum number of threads whose counters are read.
+#define PC_LINE        64  //!< Size of a cache line in bytes.
+#define PC_MAX_FLOP    4   //!< Maximum number of the FLOP events.
+
+//! Counted values of a phase.
+enum pc_value_id {PC_CYCLES, PC_INSTR, PC_LLC_REF, PC_LLC_MISS, PC_FLOP, PC_NUM};
+
+static int    pc_state = 0;   // 0: not opened, 1: opened, -1: not available
+static int    pc_num_t = 0;   // number of the threads counted
+static int    pc_num_f = 0;   // number of the FLOP events
+static double pc_weight[PC_MAX_FLOP]; // FLOPs of an event, e.g. 4 for a 256-bit packed double instruction
+static int    pc_fd_hw[PC_MAX_THREADS];   // leaders of the groups of the events of cycles/instructions/LLC
+static int    pc_fd_fp[PC_MAX_THREADS];   // leaders of the groups of the FLOP events
+static double pc_tic[PT_NUM][PC_NUM];     // counts of all the threads when the phases are started
+static double pc_sum[PT_NUM][PC_NUM];     // accumulated counts of the phases
+
+/**
+ * @brief This function opens a counter of the thread 'tid' in the group of the leader 'group'.
+ * @return The file descriptor of the counter (-1: failure).
+ */
+static int pc_open(const uint32_t type, const uint64_t config, const pid_t tid, const int group)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = type;
+    attr.config         = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, tid, -1, group, 0);
+}
+
+/**
+ * @brief This function gives the raw events of the retired double-precision FLOPs of the processor.
+ * @param[out] config: Raw configurations of the events.
+ * @return The number of the events (0: unknown processor).
+ */
+static int pc_flop_events(uint64_t config[])
+{
+    char line[256];
+    int n = 0;
+    FILE * fp = fopen("/proc/cpuinfo", "r");
+    if (fp == NULL)
+	return 0;
+    while (fgets(line, sizeof(line), fp))
+	if (strncmp(line, "vendor_id", 9) == 0)
+	    {
+		if (strstr(line, "GenuineIntel")) // FP_ARITH_INST_RETIRED.{SCALAR,128B,256B,512B}_PACKED_DOUBLE
+		    {
+			config[0] = 0x01c7; pc_weight[0] = 1.0;
+			config[1] = 0x04c7; pc_weight[1] = 2.0;
+			config[2] = 0x10c7; pc_weight[2] = 4.0;
+			config[3] = 0x40c7; pc_weight[3] = 8.0;
+			n = 4;
+		    }
+		else if (strstr(line, "AuthenticAMD")) // Retired SSE/AVX FLOPs of all types
+		    {
+			config[0] = 0xff03; pc_weight[0] = 1.0;
+			n = 1;
+		    }
+		break;
+	    }
+    fclose(fp);
+    return n;
+}
+
+/**
+ * @brief This function opens the counters of all the threads of the OpenMP team.
+ */
+static void pc_init(void)
+{
+    pid_t tid[PC_MAX_THREADS];
+    uint64_t config[PC_MAX_FLOP];
+    int t, e;
+
+#ifdef _OPENMP
+    if (omp_in_parallel()) // The team is gathered at a later phase.
+	return;
+#endif
+    pc_state = -1;
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+	const int id = omp_get_thread_num();
+	if (id < PC_MAX_THREADS)
+	    tid[id] = (pid_t)syscall(SYS_gettid);
+#pragma omp single
+	pc_num_t = omp_get_num_threads() < PC_MAX_THREADS ? omp_get_num_threads() : PC_MAX_THREADS;
+    }
+#else
+    tid[0]   = (pid_t)syscall(SYS_gettid);
+    pc_num_t = 1;
+#endif
+    pc_num_f = pc_flop_events(config);
+    for (t = 0; t < pc_num_t; t++)
+	{
+	    pc_fd_hw[t] = pc_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, tid[t], -1);
+	    if (pc_fd_hw[t] < 0 ||
+		pc_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,     tid[t], pc_fd_hw[t]) < 0 ||
+		pc_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES, tid[t], pc_fd_hw[t]) < 0 ||
+		pc_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,     tid[t], pc_fd_hw[t]) < 0)
+		{
+		    printf("The hardware performance counters are not available (%s).\n", strerror(errno));
+		    return;
+		}
+	    // The FLOP events are in their own group, which is scheduled when there are enough counters.
+	    pc_fd_fp[t] = pc_num_f ? pc_open(PERF_TYPE_RAW, config[0], tid[t], -1) : -1;
+	    for (e = 1; e < pc_num_f && pc_fd_fp[t] >= 0; e++)
+		if (pc_open(PERF_TYPE_RAW, config[e], tid[t], pc_fd_fp[t]) < 0)
+		    pc_fd_fp[t] = -1;
+	    if (pc_fd_fp[t] < 0)
+		pc_num_f = 0;
+	}
+    pc_state = 1;
+}
+
+/**
+ * @brief This function reads the counts of a group, scaled up when the group is multiplexed.
+ * @return The number of the counts read.
+ */
+static int pc_read(const int fd, double v[])
+{
+    uint64_t buf[3 + PC_MAX_FLOP + PC_NUM]; // {nr, time_enabled, time_running, values[nr]}
+    uint64_t i;
+    if (fd < 0 || read(fd, buf, sizeof(buf)) < (ssize_t)(3 * sizeof(uint64_t)) || buf[2] == 0)
+	return 0;
+    for (i = 0; i < buf[0]; i++)
+	v[i] = (double)buf[3+i] * ((double)buf[1] / (double)buf[2]);
+    return (int)buf[0];
+}
+
+/**
+ * @brief This function gives the counts of all the threads.
+ * @param[out] v: Counts of the values (enum pc_value_id).
+ */
+static void pc_count(double v[])
+{
+    double hw[PC_NUM], fp[PC_MAX_FLOP];
+    int t, e;
+    for (e = 0; e < PC_NUM; e++)
+	v[e] = 0.0;
+    for (t = 0; t < pc_num_t; t++)
+	{
+	    if (pc_read(pc_fd_hw[t], hw) == 4)
+		for (e = 0; e < 4; e++)
+		    v[e] += hw[e];
+	    if (pc_num_f && pc_read(pc_fd_fp[t], fp) == pc_num_f)
+		for (e = 0; e < pc_num_f; e++)
+		    v[PC_FLOP] += pc_weight[e] * fp[e];
+	}
+}
+#endif
+
+/**
+ * @brief This function reads the counters when the master thread starts the timer of a phase.
+ * @param[in] ph: Index of the phase (enum phase_timer_id).
+ */
+void perf_counter_start(const int ph)
+{
+#if defined(PERFCOUNTER) && defined(__linux__)
+    if (pc_state == 0)
+	pc_init();
+    if (pc_state > 0)
+	pc_count(pc_tic[ph]);
+#else
+    (void)ph;
+#endif
+}
+
+/**
+ * @brief This function reads the counters when the master thread stops the timer of a phase and accumulates the counts.
+ * @param[in] ph: Index of the phase (enum phase_timer_id).
+ */
+void perf_counter_stop(const int ph)
+{
+#if defined(PERFCOUNTER) && defined(__linux__)
+    double v[PC_NUM];
+    int e;
+    if (pc_state <= 0)
+	return;
+    pc_count(v);
+    for (e = 0; e < PC_NUM; e++)
+	pc_sum[ph][e] += v[e] - pc_tic[ph][e];
+#else
+    (void)ph;
+#endif
+}
+
+/**
+ * @brief This function prints the roofline-style summary of the counters of the phases.
+ * @param[in] name: Names of the phases.
+ * @param[in] t:    Wall-clock time of the phases in seconds.
+ */
+void perf_counter_report(const char * const name[], const double t[])
+{
+#if defined(PERFCOUNTER) && defined(__linux__)
+    int ph;
+    double byte, ai = 0.0;
+    if (pc_state <= 0)
+	return;
+    printf("\n%-22s%10s%10s%10s%10s%10s%8s%11s%9s\n", "Phase", "GFLOP", "GB (LLC)", "FLOP/B", "GFLOP/s", "GB/s", "IPC", "LLC miss", "Bound");
+    for (ph = 0; ph < PT_NUM; ph++)
+	{
+	    if (t[ph] <= 0.0 || pc_sum[ph][PC_CYCLES] <= 0.0)
+		continue;
+	    byte = PC_LINE * pc_sum[ph][PC_LLC_MISS];
+	    printf("%-22s", name[ph]);
+	    if (pc_num_f)
+		printf("%10.3f", 1e-9 * pc_sum[ph][PC_FLOP]);
+	    else
+		printf("%10s", "-");
+	    printf("%10.3f", 1e-9 * byte);
+	    if (pc_num_f && byte > 0.0)
+		{
+		    ai = pc_sum[ph][PC_FLOP] / byte;
+		    printf("%10.3g%10.3f", ai, 1e-9 * pc_sum[ph][PC_FLOP] / t[ph]);
+		}
+	    else
+		printf("%10s%10s", "-", "-");
+	    printf("%10.3f%8.2f", 1e-9 * byte / t[ph], pc_sum[ph][PC_INSTR] / pc_sum[ph][PC_CYCLES]);
+	    if (pc_sum[ph][PC_LLC_REF] > 0.0)
+		printf("%10.2f%%", 100.0 * pc_sum[ph][PC_LLC_MISS] / pc_sum[ph][PC_LLC_REF]);
+	    else
+		printf("%11s", "-");
+	    if (pc_num_f && byte > 0.0)
+		printf("%9s\n", ai < PERF_RIDGE ? "memory" : "compute");
+	    else
+		printf("%9s\n", "-");
+	}
+    printf("(%d threads; bytes = %d * LLC misses; the ridge point is %g FLOP/B.)\n", pc_num_t, PC_LINE, (double)PERF_RIDGE);
+#else
+    (void)name; (void)t;
+#endif
+}
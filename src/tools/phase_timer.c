@@ -0,0 +1,170 @@
+/**
+ * @file  phase_timer.c
+ * @brief There are wall-clock timers for the phases of the time steps in the solvers.
+ * @details With the macro PERFCOUNTER, the master thread also reads the hardware counters of the phases (perf_counter.c).
+ *          The intervals are also recorded into the timeline of the phases, if it is traced (phase_trace.c).
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "../include/tools.h"
+
+
+#define PT_MAX_THREADS 256 //!< Maximum number of threads owning their own timers.
+
+static const char * phase_name[PT_NUM] = {"Slope limiter", "Boundary condition", "Riemann/GRP solver", "Flux assembly",
+					 "Conservative update", "CFL condition", "Output"};
+
+static double pt_tic[PT_MAX_THREADS][PT_NUM];   // starting time of the running timers
+static double pt_sum[PT_MAX_THREADS][PT_NUM];   // accumulated time
+static long   pt_count[PT_MAX_THREADS][PT_NUM]; // number of the timed intervals
+static double pt_origin = -1.0;                 // time when the first timer is started
+
+/**
+ * @brief This function gives the index of the timers owned by the calling thread.
+ */
+static int phase_timer_thread(void)
+{
+#ifdef _OPENMP
+    const int id = omp_get_thread_num();
+    return id < PT_MAX_THREADS ? id : PT_MAX_THREADS-1;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief This function gives the wall-clock time.
+ * @return Wall-clock time in seconds from an arbitrary origin.
+ */
+double wall_time(void)
+{
+#ifdef _OPENMP
+    return omp_get_wtime();
+#elif defined(_WIN32)
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief This function starts the timer of a phase on the calling thread.
+ * @param[in] ph: Index of the phase (enum phase_timer_id).
+ */
+void phase_timer_start(const int ph)
+{
+    const int id = phase_timer_thread();
+#ifdef PERFCOUNTER
+    if (id == 0)
+	perf_counter_start(ph);
+#endif
+    pt_tic[id][ph] = wall_time();
+    if (pt_origin < 0.0 && id == 0)
+	pt_origin = pt_tic[id][ph];
+}
+
+/**
+ * @brief This function stops the timer of a phase on the calling thread and accumulates the interval.
+ * @param[in] ph: Index of the phase (enum phase_timer_id).
+ */
+void phase_timer_stop(const int ph)
+{
+    const int id = phase_timer_thread();
+    const double toc = wall_time();
+    pt_sum[id][ph] += toc - pt_tic[id][ph];
+    pt_count[id][ph]++;
+    phase_trace_event(id, ph, pt_tic[id][ph], toc);
+#ifdef PERFCOUNTER
+    if (id == 0)
+	perf_counter_stop(ph);
+#endif
+}
+
+/**
+ * @brief This function gives the accumulated time of a phase on the master thread.
+ * @param[in]  ph:    Index of the phase (enum phase_timer_id, PT_NUM: the whole time from the first timer started).
+ * @param[out] count: Number of the timed intervals (NULL: not given).
+ * @param[out] name:  Name of the phase (NULL: not given).
+ * @return Wall-clock time in seconds (-1.0: no timer has been started).
+ */
+double phase_timer_get(const int ph, long * count, const char ** name)
+{
+    if (pt_origin < 0.0)
+	return -1.0;
+    if (count)
+	*count = ph < PT_NUM ? pt_count[0][ph] : 1;
+    if (name)
+	*name = ph < PT_NUM ? phase_name[ph] : "Total";
+    return ph < PT_NUM ? pt_sum[0][ph] : wall_time() - pt_origin;
+}
+
+/**
+ * @brief This function gives the peak resident set size of the process.
+ * @return Peak resident set size in kilobytes (-1: unknown).
+ */
+long peak_rss_kb(void)
+{
+#ifdef _WIN32
+    return -1;
+#else
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru))
+	return -1;
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024; // bytes on macOS
+#else
+    return ru.ru_maxrss;
+#endif
+#endif
+}
+
+/**
+ * @brief This function prints the summary table of the phase timers.
+ * @details The times are those of the master thread, which encloses the parallel loops.
+ *          The largest time on the other threads is given when they also timed that phase.
+ */
+void phase_timer_report(void)
+{
+    int ph, id;
+    double t_max, t_sum = 0.0, total;
+
+    if (pt_origin < 0.0)
+	return;
+    total = wall_time() - pt_origin;
+    printf("\n%-22s%10s%16s%10s%18s\n", "Phase", "Calls", "Wall time (s)", "Share", "Max thread (s)");
+    for (ph = 0; ph < PT_NUM; ph++)
+	{
+	    if (!pt_count[0][ph])
+		continue;
+	    t_max = 0.0;
+	    for (id = 1; id < PT_MAX_THREADS; id++)
+		t_max = pt_sum[id][ph] > t_max ? pt_sum[id][ph] : t_max;
+	    t_sum += pt_sum[0][ph];
+	    printf("%-22s%10ld%16.6f%9.2f%%", phase_name[ph], pt_count[0][ph], pt_sum[0][ph], 100.0*pt_sum[0][ph]/total);
+	    if (t_max > 0.0)
+		printf("%18.6f\n", t_max);
+	    else
+		printf("%18s\n", "-");
+	}
+    printf("%-22s%10s%16.6f%9.2f%%\n", "Others", "", total - t_sum, 100.0*(total - t_sum)/total);
+    printf("%-22s%10s%16.6f\n", "Total", "", total);
+    if (peak_rss_kb() >= 0)
+	printf("%-22s%10s%16ld\n", "Peak RSS (kB)", "", peak_rss_kb());
+#ifdef PERFCOUNTER
+    perf_counter_report(phase_name, pt_sum[0]);
+#endif
+}
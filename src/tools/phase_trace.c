@@ -0,0 +1,193 @@
+/**
+ * @file  phase_trace.c
+ * @brief There is the timeline of the phases of the time steps on each thread, written as a Chrome trace.
+ * @details Each interval of the phase timers (phase_timer.c) is recorded as an event into the ring buffer of its thread,
+ *          which is written only by that thread, so that no lock is taken in the parallel loops.
+ *          The events of every S-th time step and of all the output are recorded, and a ring keeps the last events of its thread,
+ *          so that the trace of a long run is bounded. At the end of the run, the events are written as the
+ *          Chrome trace JSON 'trace.json' of the output folder, which is opened by chrome://tracing or Perfetto.
+ *          Besides the phases timed on the master thread, the parallel loops and the tasks record the spans of their
+ *          threads (PHASE_SPAN_BEGIN/END), which show the load imbalance and the serial sections.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "../include/tools.h"
+
+
+#define TR_MAX_THREADS 256 //!< Maximum number of threads owning their own rings (that of phase_timer.c).
+
+//! An interval of a phase.
+struct tr_event {
+	double t0, t1; //!< starting and stopping wall-clock time.
+	int step;      //!< time step.
+	int ph;        //!< phase (enum phase_timer_id).
+};
+
+//! Ring buffer of the events of a thread, aligned to a cache line of its own.
+struct tr_ring {
+	struct tr_event * ev; //!< the events.
+	long head;            //!< number of the events recorded.
+	char pad[64 - sizeof(struct tr_event *) - sizeof(long)];
+};
+
+static struct tr_ring tr_ring[TR_MAX_THREADS];
+static FILE * tr_fp = NULL;  // file of the trace
+static int  tr_n_thread;     // number of the rings
+static long tr_cap;          // capacity of a ring
+static int  tr_sample = 1;   // interval of the time steps recorded
+static int  tr_step;         // current time step
+static int  tr_on = 0;       // whether the events of the current time step are recorded
+static int  tr_pid;          // process ID of the trace (rank)
+static double tr_t0;         // wall-clock time of the start of the trace
+static const char * tr_name[] = {"x-flux", "y-flux"}; // names of the spans besides the phases
+
+/**
+ * @brief This function starts the trace of the phases.
+ * @param[in] file:   Path of the trace file.
+ * @param[in] sample: Interval of the time steps recorded (1: every time step).
+ * @param[in] cap:    Capacity of the ring of a thread (the last events kept).
+ * @param[in] pid:    Process ID of the trace, such as the rank.
+ */
+void phase_trace_open(const char * file, const int sample, const long cap, const int pid)
+{
+    int id;
+    if (tr_fp || sample <= 0 || cap <= 0)
+	return;
+#ifdef _OPENMP
+    tr_n_thread = omp_get_max_threads() < TR_MAX_THREADS ? omp_get_max_threads() : TR_MAX_THREADS;
+#else
+    tr_n_thread = 1;
+#endif
+    for (id = 0; id < tr_n_thread; id++)
+	if ((tr_ring[id].ev = (struct tr_event *)malloc(cap * sizeof(struct tr_event))) == NULL)
+	    {
+		printf("NOT enough memory! Trace\n");
+		exit(5);
+	    }
+    if ((tr_fp = fopen(file, "w")) == NULL)
+	{
+	    fprintf(stderr, "Trace file '%s' cannot be opened!\n", file);
+	    for (id = 0; id < tr_n_thread; id++)
+		free(tr_ring[id].ev);
+	    return;
+	}
+    tr_cap    = cap;
+    tr_sample = sample;
+    tr_pid    = pid;
+    tr_step   = 0;
+    tr_on     = 1;
+    tr_t0     = wall_time();
+}
+
+/**
+ * @brief This function records an interval of a phase on the ring of the calling thread.
+ * @param[in] id: Index of the thread.
+ * @param[in] ph: Index of the phase or span (enum phase_timer_id, phase_trace_id).
+ * @param[in] t0: Starting wall-clock time.
+ * @param[in] t1: Stopping wall-clock time.
+ */
+void phase_trace_event(const int id, const int ph, const double t0, const double t1)
+{
+    if (!(tr_on || (ph == PT_IO && tr_fp)) || id >= tr_n_thread) // the output is always recorded
+	return;
+    struct tr_ring * r = tr_ring + id;
+    struct tr_event * e = r->ev + r->head % tr_cap;
+    e->t0   = t0;
+    e->t1   = t1;
+    e->step = tr_step;
+    e->ph   = ph;
+    r->head++;
+}
+
+/**
+ * @brief This function begins a span of a phase on the calling thread.
+ * @return The starting wall-clock time (0.0: The span is not recorded).
+ */
+double phase_trace_tic(void)
+{
+    return tr_on ? wall_time() : 0.0;
+}
+
+/**
+ * @brief This function ends a span of a phase on the calling thread.
+ * @param[in] ph: Index of the phase or span (enum phase_timer_id, phase_trace_id).
+ * @param[in] t0: The starting wall-clock time given by phase_trace_tic().
+ */
+void phase_trace_toc(const int ph, const double t0)
+{
+    if (t0 <= 0.0)
+	return;
+#ifdef _OPENMP
+    phase_trace_event(omp_get_thread_num(), ph, t0, wall_time());
+#else
+    phase_trace_event(0, ph, t0, wall_time());
+#endif
+}
+
+/**
+ * @brief This function goes on to the next time step of the trace.
+ * @param[in] step: Number of the time steps completed.
+ */
+void phase_trace_step(const int step)
+{
+    if (tr_fp == NULL)
+	return;
+    tr_step = step + 1;
+    tr_on   = tr_step % tr_sample == 0;
+}
+
+/**
+ * @brief This function writes the events of the rings as the Chrome trace JSON and ends the trace.
+ * @details The events of the threads are the complete events ("ph": "X") of the phases in microseconds,
+ *          with the time step in "args", and the metadata give the names of the threads and the dropped events.
+ */
+void phase_trace_close(void)
+{
+    const char * name;
+    long i, n, drop = 0;
+    int id, first = 1;
+
+    if (tr_fp == NULL)
+	return;
+    tr_on = 0;
+    fprintf(tr_fp, "{\"traceEvents\":[\n");
+    fprintf(tr_fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"rank %d\"}}", tr_pid, tr_pid);
+    for (id = 0; id < tr_n_thread; id++)
+	{
+	    if (tr_ring[id].head == 0)
+		continue;
+	    fprintf(tr_fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+		    tr_pid, id, id);
+	    n     = tr_ring[id].head < tr_cap ? tr_ring[id].head : tr_cap;
+	    drop += tr_ring[id].head - n;
+	    for (i = tr_ring[id].head - n; i < tr_ring[id].head; i++)
+		{
+		    const struct tr_event * e = tr_ring[id].ev + i % tr_cap;
+		    name = "Phase";
+		    if (e->ph >= PT_NUM)
+			name = tr_name[e->ph - PT_NUM];
+		    else
+			phase_timer_get(e->ph, NULL, &name);
+		    fprintf(tr_fp, ",\n{\"name\":\"%s\",\"cat\":\"phase\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"step\":%d}}",
+			    name, tr_pid, id, 1e6 * (e->t0 - tr_t0), 1e6 * (e->t1 - e->t0), e->step);
+		}
+	    first = 0;
+	}
+    fprintf(tr_fp, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"sample\":%d,\"ring\":%ld,\"dropped\":%ld}}\n",
+	    tr_sample, tr_cap, drop);
+    fclose(tr_fp);
+    tr_fp = NULL;
+    for (id = 0; id < tr_n_thread; id++)
+	{
+	    free(tr_ring[id].ev);
+	    tr_ring[id].ev   = NULL;
+	    tr_ring[id].head = 0;
+	}
+    if (first)
+	printf("No phase is traced!\n");
+}
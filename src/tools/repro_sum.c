@@ -0,0 +1,138 @@
+/**
+ * @file  repro_sum.c
+ * @brief There are the exact sums of doubles independent of the order of the summands (binned superaccumulators).
+ * @details Each summand x = u * 2^(e-53) with the integer mantissa u < 2^53 is split into the 32-bit chunks
+ *          that fall into the bins of the fixed exponents 2^(32*i-RSUM_OFF), which are accumulated as 64-bit integers.
+ *          The integer sums are exact and associative, so that the partial sums of the threads or the processes
+ *          merged in any order give the same bins, and the rounded value is a function of the exact sum alone.
+ *          Parallel runs are then bit-identical to the serial ones whatever the number of the threads is.
+ *          The bins are normalized (carried into the 32-bit chunks) before they may overflow.
+ *          The contributions below 2^(-RSUM_OFF+32) (deep subnormals) are dropped in the rounded value.
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "../include/tools.h"
+
+#define RSUM_OFF  1152                 //!< offset of the exponents of the bins.
+#define RSUM_NORM (1L << 28)           //!< number of the sums before the normalization (each of them < 2^33 in a bin).
+#define RSUM_MASK ((int64_t)0xFFFFFFFF) //!< mask of a 32-bit chunk.
+
+
+/**
+ * @brief This function initializes an exact sum as 0.
+ * @param[out] s: Pointer to the sum.
+ */
+void repro_sum_init(struct repro_sum * s)
+{
+    int i;
+    for (i = 0; i < RSUM_BINS; i++)
+	s->b[i] = 0;
+    s->n = 0;
+}
+
+/**
+ * @brief This function carries the bins into the 32-bit chunks, the top bin keeps the sign of the sum.
+ *        The normalized bins of an exact sum are unique.
+ */
+static void repro_sum_norm(struct repro_sum * s)
+{
+    int i;
+    int64_t lo;
+    for (i = 0; i < RSUM_BINS-1; i++)
+	{
+	    lo = s->b[i] & RSUM_MASK;
+	    s->b[i+1] += (s->b[i] - lo) / ((int64_t)1 << 32);
+	    s->b[i]    = lo;
+	}
+    s->n = 1;
+}
+
+/**
+ * @brief This function adds a finite value to an exact sum (the non-finite values are ignored).
+ * @param[in,out] s: Pointer to the sum.
+ * @param[in]     x: Summand.
+ */
+void repro_sum_add(struct repro_sum * s, const double x)
+{
+    int e, E, i, sh;
+    uint64_t u, c;
+    double f;
+    if (x == 0.0 || !isfinite(x))
+	return;
+    if (s->n >= RSUM_NORM)
+	repro_sum_norm(s);
+    f = frexp(fabs(x), &e);
+    u = (uint64_t)ldexp(f, 53); // exact
+    E  = e - 53 + RSUM_OFF;
+    if (E < 0)
+	return;
+    i  = E / 32;
+    sh = E % 32;
+    c = (u & RSUM_MASK) << sh; // < 2^63
+    if (x > 0.0)
+	{
+	    s->b[i]   += (int64_t)(c & RSUM_MASK);
+	    s->b[i+1] += (int64_t)(c >> 32) + (int64_t)(((u >> 32) << sh) & RSUM_MASK);
+	    s->b[i+2] += (int64_t)(((u >> 32) << sh) >> 32);
+	}
+    else
+	{
+	    s->b[i]   -= (int64_t)(c & RSUM_MASK);
+	    s->b[i+1] -= (int64_t)(c >> 32) + (int64_t)(((u >> 32) << sh) & RSUM_MASK);
+	    s->b[i+2] -= (int64_t)(((u >> 32) << sh) >> 32);
+	}
+    s->n++;
+}
+
+/**
+ * @brief This function adds an exact sum to another one, such as the partial sum of a thread.
+ * @param[in,out] s: Pointer to the sum.
+ * @param[in]     t: Pointer to the sum added (normalized if necessary).
+ */
+void repro_sum_merge(struct repro_sum * s, struct repro_sum * t)
+{
+    int i;
+    if (s->n + t->n >= RSUM_NORM)
+	{
+	    repro_sum_norm(s);
+	    repro_sum_norm(t);
+	}
+    for (i = 0; i < RSUM_BINS; i++)
+	s->b[i] += t->b[i];
+    s->n += t->n;
+}
+
+/**
+ * @brief This function normalizes an exact sum, so that the bins of the sums of the processes may be summed up
+ *        as integers (MPI_SUM) without overflow.
+ */
+void repro_sum_prepare(struct repro_sum * s)
+{
+    repro_sum_norm(s);
+}
+
+/**
+ * @brief This function rounds an exact sum to a double, the rounding only depends on the exact sum.
+ * @param[in] s: Pointer to the sum.
+ * @return    The rounded sum.
+ */
+double repro_sum_value(const struct repro_sum * s)
+{
+    struct repro_sum a = *s;
+    double r = 0.0;
+    int i, neg;
+    repro_sum_norm(&a);
+    neg = a.b[RSUM_BINS-1] < 0;
+    if (neg) // The magnitude has the non-negative chunks.
+	{
+	    for (i = 0; i < RSUM_BINS; i++)
+		a.b[i] = -a.b[i];
+	    repro_sum_norm(&a);
+	}
+    for (i = RSUM_BINS-1; i >= 0; i--)
+	if (a.b[i] != 0)
+	    r += ldexp((double)a.b[i], 32*i - RSUM_OFF);
+    return neg ? -r : r;
+}
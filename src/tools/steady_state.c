@@ -0,0 +1,58 @@
+/**
+ * @file  steady_state.c
+ * @brief There are the monitor of the residuals of the runs marching to a steady state.
+ * @details The residuals are the L1 (mean) and L∞ (maximum) norms of the changes of the density and the total energy
+ *          of the cells per unit time, which are summed up in the update loops of the solvers.
+ *          A run stops as the steady state is reached, when all the residuals are reduced by the tolerance
+ *          from those of the first time step.
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "../include/tools.h"
+
+
+/**
+ * @brief This function initializes the monitor of the residuals.
+ * @param[out] ss:  Pointer to the monitor.
+ * @param[in]  tol: Tolerance of the residuals relative to those of the first time step (0: no steady-state mode).
+ */
+void steady_state_init(struct steady_state * ss, const double tol)
+{
+    int r;
+    ss->tol = tol > 0.0 ? tol : 0.0;
+    ss->n   = 0;
+    ss->rel = INFINITY;
+    for (r = 0; r < SS_NUM; r++)
+	ss->res0[r] = 0.0;
+}
+
+/**
+ * @brief This function checks whether the steady state is reached at a time step.
+ * @param[in,out] ss:     Pointer to the monitor.
+ * @param[in]     res:    Residuals of the time step {L1(rho), L1(E), L∞(rho), L∞(E)},
+ *                        the L1 norms of which are the sums of the absolute changes of the cells.
+ * @param[in]     n_cell: Number of the cells of the sums.
+ * @param[in]     tau:    Length of the time step.
+ * @return        Whether the steady state is reached (always 0 without the steady-state mode).
+ */
+int steady_state_check(struct steady_state * ss, const double res[SS_NUM], const long n_cell, const double tau)
+{
+    int r;
+    double R;
+    if (!(ss->tol > 0.0) || !(tau > 0.0) || n_cell <= 0)
+	return 0;
+    ss->rel = 0.0;
+    for (r = 0; r < SS_NUM; r++)
+	{
+	    R = (r < SS_LI_RHO ? res[r] / n_cell : res[r]) / tau;
+	    if (ss->n == 0)
+		ss->res0[r] = R;
+	    // A residual vanishing at the first time step is reduced by the others.
+	    if (ss->res0[r] > 0.0)
+		ss->rel = fmax(ss->rel, R / ss->res0[r]);
+	}
+    ss->n++;
+    return ss->n > 1 && ss->rel <= ss->tol;
+}
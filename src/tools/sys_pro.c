@@ -7,6 +7,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef _OPENACC
+#include <openacc.h>
+#endif
 
 /*
  * To realize cross-platform programming.
@@ -28,6 +35,8 @@
 #define MKDIR(path)       mkdir((path), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH)
 #endif
 
+#include "../include/tools.h"
+
 
 /**
  * @brief This function print a progress bar on one line of standard output.
@@ -100,49 +109,247 @@ int CreateDir(const char * pPath)
 
 /**
  * @brief This is a function that initializes memory for double-precision floating-point data.
- * @param[out] p: Pointer of data.
- * @param[in]  n: Number of grid cells.
- * @param[in] cell_pt[]: cell_pt[k][0] is the number of grid node on the k-th grid cell in the clockwise direction..
+ * @details The data of all grid cells are stored in one block p[0] (compressed sparse row), which is freed by free(p[0]).
+ * @param[out] p:   Pointer of data, p[k] = p[0] + off[k].
+ * @param[in]  n:   Number of grid cells.
+ * @param[in]  off: off[k] is the offset of the data of the k-th grid cell, and off[n] is the total number of data.
  */
-void init_mem(double * p[], const int n, int ** cell_pt)
+void init_mem(double * p[], const int n, const int * off)
 {
-	for(int k = 0; k < n; ++k)
+	double * block = (double *)calloc(off[n] > 0 ? off[n] : 1, sizeof(double));
+	if(block == NULL)
 		{
-			p[k] = (double *)calloc(cell_pt[k][0], sizeof(double));
-			if(p[k] == NULL)
-				{
-					printf("Initialize memory fail! DOUBLE data at grid cell points.\n");
-					for(int j = 0; j < k; j++)
-						{
-							free(p[k]);
-							p[k] = NULL;
-						}
-					exit(5);
-				}
+			printf("Initialize memory fail! DOUBLE data at grid cell points.\n");
+			exit(5);
 		}
+	for(int k = 0; k < n; ++k)
+		p[k] = block + off[k];
 }
 
 
 /**
  * @brief This is a function that initializes memory for integer data.
- * @param[out] p: Pointer of data.
- * @param[in]  n: Number of grid cells.
- * @param[in] cell_pt[]: cell_pt[k][0] is the number of grid node on the k-th grid cell in the clockwise direction..
+ * @details The data of all grid cells are stored in one block p[0] (compressed sparse row), which is freed by free(p[0]).
+ * @param[out] p:   Pointer of data, p[k] = p[0] + off[k].
+ * @param[in]  n:   Number of grid cells.
+ * @param[in]  off: off[k] is the offset of the data of the k-th grid cell, and off[n] is the total number of data.
  */
-void init_mem_int(int * p[], const int n, int ** cell_pt)
+void init_mem_int(int * p[], const int n, const int * off)
 {
-	for(int k = 0; k < n; ++k)
+	int * block = (int *)malloc((off[n] > 0 ? off[n] : 1) * sizeof(int));
+	if(block == NULL)
 		{
-			p[k] = (int *)malloc(cell_pt[k][0] * sizeof(int));
-			if(p[k] == NULL)
-				{
-					printf("Initialize memory fail! INT data at grid cell points.\n");
-					for(int j = 0; j < k; j++)
-						{
-							free(p[k]);
-							p[k] = NULL;
-						}
-					exit(5);
-				}
+			printf("Initialize memory fail! INT data at grid cell points.\n");
+			exit(5);
 		}
+	for(int k = 0; k < n; ++k)
+		p[k] = block + off[k];
+}
+
+
+//! Alignment of the rows of the 2-D fields in bytes (a cache line).
+#define FIELD_ALIGN 64
+
+//! Account of a 2-D field at the head of its memory block, which is released by field_free_2D().
+struct field_head {
+    long bytes;         //!< bytes of the field.
+    int  tag;           //!< subsystem of the field (enum mem_account_id).
+    const char * field; //!< name of the field.
+};
+
+/**
+ * @brief This is a function that gives the bytes of a 2-D field allocated by field_alloc_2D().
+ * @details The bytes include the row pointers and the padding, so that they predict the footprint of the field.
+ * @param[in] M:    Number of the rows.
+ * @param[in] N:    Number of the elements in a row.
+ * @param[in] size: Size of an element in bytes.
+ * @return    The bytes of the field.
+ */
+long field_bytes_2D(const int M, const int N, const size_t size)
+{
+    const size_t row = (N * size + FIELD_ALIGN - 1) / FIELD_ALIGN * FIELD_ALIGN; // padded size of a row
+    return (long)((M + 1) * sizeof(char *) + sizeof(struct field_head) + M * row + FIELD_ALIGN);
+}
+
+/**
+ * @brief This is a function that allocates a 2-D field of M rows, which has N elements in each row, in one memory block.
+ * @details The rows are aligned to FIELD_ALIGN bytes and padded to a multiple of FIELD_ALIGN bytes in one block,
+ *          and the returned array p[0], …, p[M-1] of the row pointers keeps the 'v[j][i]' view of the field.
+ *          The address of the block is kept in p[M] for field_free_2D().
+ *          The rows are zeroed by the OpenMP threads with the static schedule of the loops over the rows,
+ *          so that the pages are first touched by the threads computing them (in the huge pages of place_huge_advise()).
+ *          The bytes of the field are added to its account (mem_account()) and kept at the head of the block.
+ * @param[in] M:     Number of the rows.
+ * @param[in] N:     Number of the elements in a row.
+ * @param[in] size:  Size of an element in bytes.
+ * @param[in] tag:   Subsystem of the field (enum mem_account_id).
+ * @param[in] field: Name of the field.
+ * @return    The array of the row pointers (NULL: Memory error).
+ */
+void * field_alloc_2D(const int M, const int N, const size_t size, const int tag, const char * field)
+{
+    const size_t row = (N * size + FIELD_ALIGN - 1) / FIELD_ALIGN * FIELD_ALIGN; // padded size of a row
+    char ** p = (char **)malloc((M + 1) * sizeof(char *));
+    char * b;
+    struct field_head * h;
+    int j;
+    if(p == NULL)
+	return NULL;
+    p[M] = (char *)malloc(sizeof(struct field_head) + M * row + FIELD_ALIGN);
+    if(p[M] == NULL)
+	{
+	    free(p);
+	    return NULL;
+	}
+    h = (struct field_head *)p[M];
+    h->bytes = field_bytes_2D(M, N, size);
+    h->tag   = tag;
+    h->field = field;
+    mem_account(tag, field, h->bytes);
+    b = p[M] + sizeof(struct field_head);
+    b += (FIELD_ALIGN - (uintptr_t)b % FIELD_ALIGN) % FIELD_ALIGN;
+    place_huge_advise(b, M * row);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(j = 0; j < M; ++j)
+	{
+	    p[j] = b + j * row;
+	    memset(p[j], 0, row);
+	}
+    return p;
+}
+
+/**
+ * @brief This is a function that frees a 2-D field allocated by field_alloc_2D(), and releases its account.
+ * @param[in] p: The array of the row pointers (NULL: Nothing is done).
+ * @param[in] M: Number of the rows.
+ */
+void field_free_2D(void * p, const int M)
+{
+    const struct field_head * h;
+    if(p == NULL)
+	return;
+    h = (const struct field_head *)((char **)p)[M];
+    mem_account(h->tag, h->field, -h->bytes);
+    free(((char **)p)[M]);
+    free(p);
+}
+
+/**
+ * @brief This is a function that enters a 2-D field allocated by field_alloc_2D() into the device memory of OpenACC.
+ * @details The memory block is copied or created on the device, and the row pointers on the device point to
+ *          the rows of the device block, so that the 'v[j][i]' view of the field also works in the device loops.
+ *          The pointers to the field in the structures on the device are set by the 'attach' clause afterwards.
+ *          Without OpenACC, nothing is done.
+ * @param[in] p:    The array of the row pointers.
+ * @param[in] M:    Number of the rows.
+ * @param[in] N:    Number of the elements in a row.
+ * @param[in] size: Size of an element in bytes.
+ * @param[in] copy: Whether the values are copied into the device (false: only created).
+ */
+void field_device_enter_2D(void * p, const int M, const int N, const size_t size, const int copy)
+{
+#ifdef _OPENACC
+    const size_t row = (N * size + FIELD_ALIGN - 1) / FIELD_ALIGN * FIELD_ALIGN;
+    char ** r = (char **)p;
+    char *  d = (char *)(copy ? acc_copyin(r[0], M * row) : acc_create(r[0], M * row));
+    char ** d_r = (char **)acc_create(r, M * sizeof(char *));
+    char ** t = (char **)malloc(M * sizeof(char *)); // the row pointers on the device
+    int j;
+    if(t == NULL)
+	{
+	    printf("NOT enough memory! Device row pointers\n");
+	    exit(5);
+	}
+    for(j = 0; j < M; ++j)
+	t[j] = d + j * row;
+    acc_memcpy_to_device(d_r, t, M * sizeof(char *));
+    free(t);
+#endif
+}
+
+/**
+ * @brief This is a function that copies a 2-D field entered by field_device_enter_2D() from the device back to the host.
+ * @param[in] p:    The array of the row pointers.
+ * @param[in] M:    Number of the rows.
+ * @param[in] N:    Number of the elements in a row.
+ * @param[in] size: Size of an element in bytes.
+ */
+void field_device_update_host_2D(void * p, const int M, const int N, const size_t size)
+{
+#ifdef _OPENACC
+    const size_t row = (N * size + FIELD_ALIGN - 1) / FIELD_ALIGN * FIELD_ALIGN;
+    acc_update_self(((char **)p)[0], M * row);
+#endif
+}
+
+/**
+ * @brief This is a function that deletes a 2-D field entered by field_device_enter_2D() from the device memory.
+ * @param[in] p:    The array of the row pointers.
+ * @param[in] M:    Number of the rows.
+ * @param[in] N:    Number of the elements in a row.
+ * @param[in] size: Size of an element in bytes.
+ */
+void field_device_exit_2D(void * p, const int M, const int N, const size_t size)
+{
+#ifdef _OPENACC
+    const size_t row = (N * size + FIELD_ALIGN - 1) / FIELD_ALIGN * FIELD_ALIGN;
+    acc_delete(p, M * sizeof(char *));
+    acc_delete(((char **)p)[0], M * row);
+#endif
+}
+
+/**
+ * @brief This is a function that enters an array of CSR rows (the rows k of the block p[0] at p[0] + off[k])
+ *        into the device memory of OpenACC, such as the interfacial variables of the unstructured grid cells.
+ * @details The block is copied or created on the device, and the row pointers on the device point into
+ *          the device block, so that the 'v[k][j]' view also works in the device loops, as field_device_enter_2D().
+ *          Without OpenACC, nothing is done.
+ * @param[in] p:    The array of the row pointers.
+ * @param[in] off:  The CSR offsets of the M rows (M+1 values).
+ * @param[in] M:    Number of the rows.
+ * @param[in] size: Size of an element in bytes.
+ * @param[in] copy: Whether the values are copied into the device (false: only created).
+ */
+void field_device_enter_CSR(void * p, const int * off, const int M, const size_t size, const int copy)
+{
+#ifdef _OPENACC
+    char ** r = (char **)p;
+    const size_t n = (size_t)(off[M] > 0 ? off[M] : 1) * size;
+    char *  d = (char *)(copy ? acc_copyin(r[0], n) : acc_create(r[0], n));
+    char ** d_r = (char **)acc_create(r, M * sizeof(char *));
+    char ** t = (char **)malloc(M * sizeof(char *)); // the row pointers on the device
+    int k;
+    if(t == NULL)
+	{
+	    printf("NOT enough memory! Device row pointers\n");
+	    exit(5);
+	}
+    for(k = 0; k < M; ++k)
+	t[k] = d + (size_t)off[k] * size;
+    acc_memcpy_to_device(d_r, t, M * sizeof(char *));
+    free(t);
+#endif
+}
+
+/**
+ * @brief This is a function that copies the CSR rows entered by field_device_enter_CSR() from the device back to the host.
+ */
+void field_device_update_host_CSR(void * p, const int * off, const int M, const size_t size)
+{
+#ifdef _OPENACC
+    acc_update_self(((char **)p)[0], (size_t)(off[M] > 0 ? off[M] : 1) * size);
+#endif
+}
+
+/**
+ * @brief This is a function that deletes the CSR rows entered by field_device_enter_CSR() from the device memory.
+ */
+void field_device_exit_CSR(void * p, const int * off, const int M, const size_t size)
+{
+#ifdef _OPENACC
+    acc_delete(p, M * sizeof(char *));
+    acc_delete(((char **)p)[0], (size_t)(off[M] > 0 ? off[M] : 1) * size);
+#endif
 }
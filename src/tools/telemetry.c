@@ -0,0 +1,213 @@
+/**
+ * @file  telemetry.c
+ * @brief There are the sinks of the progress of the time steps: the progress bar and the telemetry records.
+ * @details The solvers report every time step by telemetry_step(), and the telemetry records are written
+ *          at an interval of wall-clock time as JSON lines (one object per line), so that the progress,
+ *          the step rate, tau, the time, the conservation errors and the ETA of a run are read
+ *          without parsing the terminal output. The progress bar of DispPro() is an optional sink,
+ *          shown by default only if the standard output is a terminal.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef _WIN32
+#include <io.h>
+#define ISATTY_STDOUT() _isatty(_fileno(stdout))
+#else
+#include <unistd.h>
+#define ISATTY_STDOUT() isatty(fileno(stdout))
+#endif
+
+#include "../include/tools.h"
+
+
+#define TM_NQ_MAX 8 //!< Maximum number of the conserved quantities of the records.
+
+static FILE * tm_fp = NULL;    // file of the telemetry records
+static double tm_interval;     // wall-clock interval of the records
+static double tm_t0, tm_last;  // wall-clock time of the start and of the last record
+static int  tm_bar = 1;        // whether the progress bar is shown
+static int  tm_step_last;      // time step of the last record
+static int  tm_n_rec;          // number of the records of the time steps
+static int  tm_step;           // last time step reported
+static double tm_time;         // time of the solution of the last time step reported
+static int  tm_n_step;         // number of the time steps reported
+static double tm_tau[3];       // minimum, sum and maximum of tau of the time steps reported
+static int  tm_nq = 0;         // number of the conserved quantities
+static double tm_q0[TM_NQ_MAX], tm_q[TM_NQ_MAX]; // initial and current totals of the conserved quantities
+
+/**
+ * @brief This function prints a real number of JSON (null if not finite).
+ */
+static void tm_number(const char * key, const double x)
+{
+    if (isfinite(x))
+	fprintf(tm_fp, ",\"%s\":%.10g", key, x);
+    else
+	fprintf(tm_fp, ",\"%s\":null", key);
+}
+
+/**
+ * @brief This function opens the sinks of the progress.
+ * @param[in] file:     Path of the file of the telemetry records (NULL: no record).
+ *                      It may be a named pipe read by the orchestration of the runs.
+ * @param[in] interval: Wall-clock interval (s) of the records.
+ * @param[in] bar:      Progress bar (0: hidden, 1: shown, < 0: shown if the standard output is a terminal).
+ */
+void telemetry_open(const char * file, const double interval, const int bar)
+{
+    tm_bar      = bar < 0 ? ISATTY_STDOUT() : bar;
+    tm_interval = interval;
+    tm_t0       = wall_time();
+    tm_last     = tm_t0;
+    tm_step_last = 0;
+    tm_n_rec    = 0;
+    tm_step     = 0;
+    tm_time     = 0.0;
+    tm_n_step   = 0;
+    tm_tau[0]   = INFINITY;
+    tm_tau[1]   = 0.0;
+    tm_tau[2]   = 0.0;
+    tm_nq       = 0;
+    if (file == NULL || tm_fp)
+	return;
+    tm_fp = fopen(file, "w");
+    if (tm_fp == NULL)
+	{
+	    fprintf(stderr, "Telemetry file '%s' cannot be opened!\n", file);
+	    return;
+	}
+    fprintf(tm_fp, "{\"event\":\"start\",\"wall\":0,\"interval\":%g}\n", interval);
+    fflush(tm_fp);
+}
+
+/**
+ * @brief This function closes the sinks of the progress with the last record of the last time step reported.
+ * @details The trace of the phases is written too, and the live publish is stopped.
+ */
+void telemetry_close(void)
+{
+    phase_trace_close();
+    live_publish_close();
+    if (tm_fp == NULL)
+	return;
+    fprintf(tm_fp, "{\"event\":\"end\",\"step\":%d", tm_step);
+    tm_number("time", tm_time);
+    tm_number("wall", wall_time() - tm_t0);
+    fprintf(tm_fp, "}\n");
+    fclose(tm_fp);
+    tm_fp = NULL;
+}
+
+/**
+ * @brief This function gives the statistics of the time steps reported since the sinks were opened.
+ * @param[out] tau:  Minimum, mean and maximum of tau.
+ * @param[out] wall: Wall-clock time (s) since the sinks were opened.
+ * @return Number of the time steps reported.
+ */
+int telemetry_stat(double tau[3], double * wall)
+{
+    tau[0] = tm_tau[0];
+    tau[1] = tm_n_step > 0 ? tm_tau[1] / tm_n_step : 0.0;
+    tau[2] = tm_tau[2];
+    *wall  = wall_time() - tm_t0;
+    return tm_n_step;
+}
+
+/**
+ * @brief This function tells whether a telemetry record is due at this time step.
+ * @details The first time step is recorded, and then the time steps after the interval.
+ *          The solvers compute the totals of their conserved quantities for telemetry_conserve()
+ *          only at the time steps of the records.
+ */
+int telemetry_due(void)
+{
+#ifdef _OPENMP
+    if (omp_in_parallel()) // the members of an ensemble running on the threads
+	return 0;
+#endif
+    return tm_fp != NULL && (tm_n_rec == 0 || wall_time() - tm_last >= tm_interval);
+}
+
+/**
+ * @brief This function gives the totals of the conserved quantities to the next record.
+ * @details The records give the totals and the conservation errors, which are the relative changes of the totals
+ *          from those of the first record (the absolute changes if the first totals vanish).
+ *          They include the fluxes through the boundaries, such as the momentum of the pressure on the walls.
+ * @param[in] nq:  Number of the conserved quantities (such as mass, momentum and energy).
+ * @param[in] q[]: Totals of the conserved quantities.
+ */
+void telemetry_conserve(const int nq, const double q[])
+{
+    int i;
+    const int first = tm_nq == 0;
+    tm_nq = nq < TM_NQ_MAX ? nq : TM_NQ_MAX;
+    for (i = 0; i < tm_nq; i++)
+	{
+	    if (first)
+		tm_q0[i] = q[i];
+	    tm_q[i] = q[i];
+	}
+}
+
+/**
+ * @brief This function reports a time step to the sinks of the progress.
+ * @param[in] pro:  Numerator of percent that the process has completed.
+ * @param[in] step: Number of time steps.
+ * @param[in] time: Time of the solution.
+ * @param[in] tau:  Length of the time step.
+ */
+void telemetry_step(const double pro, const int step, const double time, const double tau)
+{
+    int i;
+    double wall, eta;
+
+    if (tm_bar)
+	DispPro(pro, step);
+#ifdef _OPENMP
+    if (omp_in_parallel())
+	return;
+#endif
+    phase_trace_step(step);
+    tm_step = step;
+    tm_time = time;
+    tm_n_step++;
+    tm_tau[0] = fmin(tm_tau[0], tau);
+    tm_tau[1] += tau;
+    tm_tau[2] = fmax(tm_tau[2], tau);
+    if (!telemetry_due())
+	return;
+    wall = wall_time();
+    eta  = pro > 0.0 ? (wall - tm_t0) * (100.0 - pro) / pro : INFINITY;
+    fprintf(tm_fp, "{\"event\":\"step\",\"step\":%d", step);
+    tm_number("time", time);
+    tm_number("tau", tau);
+    tm_number("progress", pro);
+    tm_number("wall", wall - tm_t0);
+    tm_number("step_rate", (step - tm_step_last) / (wall - tm_last));
+    tm_number("eta", eta);
+    if (tm_nq)
+	{
+	    fprintf(tm_fp, ",\"cons\":[");
+	    for (i = 0; i < tm_nq; i++)
+		fprintf(tm_fp, "%s%.10g", i ? "," : "", tm_q[i]);
+	    fprintf(tm_fp, "],\"cons_err\":[");
+	    for (i = 0; i < tm_nq; i++)
+		{
+		    const double err = fabs(tm_q[i] - tm_q0[i]) / (tm_q0[i] != 0.0 ? fabs(tm_q0[i]) : 1.0);
+		    if (isfinite(err))
+			fprintf(tm_fp, "%s%.6e", i ? "," : "", err);
+		    else
+			fprintf(tm_fp, "%snull", i ? "," : "");
+		}
+	    fprintf(tm_fp, "]");
+	}
+    fprintf(tm_fp, "}\n");
+    fflush(tm_fp);
+    tm_last      = wall;
+    tm_step_last = step;
+    tm_n_rec++;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file  thread_place.c
+ * @brief There are the placement of the OpenMP threads on the cores and the transparent huge pages of the large fields.
+ * @details The threads are pinned one per core of the CPUs allowed to the process, in the order of the cores of
+ *          each socket (compact) or alternating the sockets (spread), so that the static loops over the rows or the cells
+ *          keep their parts of the fields in the memory of their sockets. The fields are first touched by the threads
+ *          with the same static decomposition (field_alloc_2D(), Arena_calloc()).
+ *          The processes on a node (MPI) are pinned on the next cores by their local ranks.
+ *          If OMP_PROC_BIND or OMP_PLACES is given, the placement of the OpenMP runtime is kept.
+ *          The pinning needs Linux and OpenMP, otherwise the threads are left to the system.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../include/tools.h"
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+//! Size of a transparent huge page in bytes.
+#define HUGE_PAGE_SIZE (2L << 20)
+
+static int place_huge = 0; // whether the large fields are advised to be in the transparent huge pages
+
+/**
+ * @brief This function advises the kernel to back the aligned huge pages in the memory block of a field by
+ *        the transparent huge pages, before the block is first touched.
+ * @details Nothing is done unless it is enabled by thread_place(), or if the block is smaller than a huge page.
+ * @param[in] p:     Address of the memory block.
+ * @param[in] bytes: Bytes of the memory block.
+ */
+void place_huge_advise(void * p, const size_t bytes)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    const uintptr_t b = ((uintptr_t)p + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    const uintptr_t e = ((uintptr_t)p + bytes) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    if (place_huge && e > b)
+	madvise((void *)b, e - b, MADV_HUGEPAGE);
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
+
+#if defined(__linux__) && defined(_OPENMP)
+//! A core of the CPUs allowed to the process.
+struct place_core {
+    int socket, core; //!< physical package and core IDs.
+    int cpu;          //!< first CPU (hardware thread) of the core.
+    int rank;         //!< order of the core in its socket.
+    cpu_set_t set;    //!< CPUs of the core allowed to the process.
+};
+
+//! Read an ID of the topology of a CPU in sysfs (-1: unknown).
+static int place_topology(const int cpu, const char * name)
+{
+    char file[96];
+    int id = -1;
+    FILE * fp;
+    sprintf(file, "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+    if ((fp = fopen(file, "r")) != NULL)
+	{
+	    if (fscanf(fp, "%d", &id) != 1)
+		id = -1;
+	    fclose(fp);
+	}
+    return id;
+}
+
+static int place_compact(const void * a, const void * b)
+{
+    const struct place_core * p = (const struct place_core *)a, * q = (const struct place_core *)b;
+    if (p->socket != q->socket)
+	return p->socket - q->socket;
+    return p->core != q->core ? p->core - q->core : p->cpu - q->cpu;
+}
+
+static int place_spread(const void * a, const void * b)
+{
+    const struct place_core * p = (const struct place_core *)a, * q = (const struct place_core *)b;
+    if (p->rank != q->rank)
+	return p->rank - q->rank;
+    return p->socket - q->socket;
+}
+#endif
+
+/**
+ * @brief This function pins the OpenMP threads on the cores and reports the placement in the run log.
+ * @param[in] policy: Placement of the threads (0: by the system, 1: compact cores of the sockets, 2: spread over the sockets).
+ * @param[in] huge:   Whether the large fields are advised to be in the transparent huge pages.
+ */
+void thread_place(const int policy, const int huge)
+{
+    place_huge = huge;
+    if (huge)
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	printf("@@ The fields larger than %ld MB are advised to be in the transparent huge pages.\n", HUGE_PAGE_SIZE >> 20);
+#else
+	printf("The transparent huge pages are not supported on this system!\n");
+#endif
+    if (policy <= 0)
+	return;
+#if defined(__linux__) && defined(_OPENMP)
+    if (getenv("OMP_PROC_BIND") != NULL || getenv("OMP_PLACES") != NULL)
+	{
+	    printf("@@ Thread placement is given by OMP_PROC_BIND/OMP_PLACES of the OpenMP runtime.\n");
+	    return;
+	}
+    cpu_set_t mask;
+    struct place_core * pc;
+    int cpu, c, n_core = 0, n_socket = 0, local = 0;
+    const char * env;
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0
+	|| (pc = (struct place_core *)malloc(CPU_COUNT(&mask) * sizeof(struct place_core))) == NULL)
+	{
+	    printf("The CPUs of the process are unknown, the threads are not pinned!\n");
+	    return;
+	}
+    // one core of each (socket, core) of the allowed CPUs
+    for (cpu = 0; cpu < CPU_SETSIZE; cpu++)
+	if (CPU_ISSET(cpu, &mask))
+	    {
+		const int s = place_topology(cpu, "physical_package_id");
+		const int k = s < 0 ? cpu : place_topology(cpu, "core_id");
+		for (c = 0; c < n_core && (pc[c].socket != s || pc[c].core != k); c++) ;
+		if (c == n_core)
+		    {
+			pc[c].socket = s;
+			pc[c].core   = k;
+			pc[c].cpu    = cpu;
+			CPU_ZERO(&pc[c].set);
+			n_core++;
+		    }
+		CPU_SET(cpu, &pc[c].set);
+	    }
+    qsort(pc, n_core, sizeof(struct place_core), place_compact);
+    for (c = 0; c < n_core; c++)
+	{
+	    pc[c].rank = c && pc[c].socket == pc[c-1].socket ? pc[c-1].rank + 1 : 0;
+	    n_socket  += pc[c].rank == 0;
+	}
+    if (policy == 2)
+	qsort(pc, n_core, sizeof(struct place_core), place_spread);
+    // the local rank of the process on the node
+    if ((env = getenv("OMPI_COMM_WORLD_LOCAL_RANK")) != NULL || (env = getenv("MPI_LOCALRANKID")) != NULL
+	|| (env = getenv("SLURM_LOCALID")) != NULL)
+	local = atoi(env);
+
+    const int n_thread = omp_get_max_threads();
+    int * t_core = (int *)malloc(n_thread * sizeof(int)), err = 0;
+    if (t_core == NULL)
+	{
+	    free(pc);
+	    printf("NOT enough memory! thread placement\n");
+	    return;
+	}
+#pragma omp parallel reduction(+:err)
+    {
+	const int t = omp_get_thread_num();
+	t_core[t] = (int)(((long)local * n_thread + t) % n_core);
+	err += sched_setaffinity(0, sizeof(cpu_set_t), &pc[t_core[t]].set) != 0;
+    }
+    printf("@@ Thread placement (%s): %d threads pinned on %d cores of %d socket(s)%s\n",
+	   policy == 2 ? "spread over the sockets" : "compact cores", n_thread, MIN(n_thread, n_core), n_socket,
+	   err ? ", some threads failed to be pinned!" : n_thread > n_core ? ", more threads than the cores!" : ".");
+    for (c = 0; c < n_thread; c++)
+	printf("%s%d:%d/%d%s", c % 8 ? " " : "   thread:cpu/socket ", c, pc[t_core[c]].cpu, pc[t_core[c]].socket,
+	       c % 8 == 7 || c == n_thread-1 ? "\n" : "");
+    free(t_core);
+    free(pc);
+#else
+    printf("The threads are not pinned without OpenMP on Linux!\n");
+#endif
+}
@@ -0,0 +1,105 @@
+/**
+ * @file  work_chunk.c
+ * @brief There are the cost-weighted chunks of a loop, which are re-partitioned by the costs measured in the last sweep.
+ * @details The items of a loop (such as the interfaces or the cells of the unstructured grids) are split into contiguous
+ *          chunks, which are run as the tasks of OpenMP and stolen by the idle threads. The wall time of each chunk
+ *          is measured in a sweep, and the chunks of the next sweep are bounded so that they have the same measured cost,
+ *          which follows the costly items as the shocks move through the grids.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "../include/tools.h"
+
+
+/**
+ * @brief This function initializes the chunks of a loop of equal numbers of items.
+ * @param[out] wc:      Pointer to the chunks.
+ * @param[in]  n:       Number of the items of the loop.
+ * @param[in]  per_thread: Number of the chunks for each thread (0: no chunk).
+ * @return     Number of the chunks (0: no chunk or not enough memory).
+ */
+int work_chunk_init(struct work_chunk * wc, const int n, const int per_thread)
+{
+    int c, n_thread = 1;
+#ifdef _OPENMP
+    n_thread = omp_get_max_threads();
+#endif
+    wc->n     = n;
+    wc->num   = MIN(per_thread * n_thread, n);
+    wc->start = NULL;
+    wc->cost  = NULL;
+    if (wc->num <= 0)
+	{
+	    wc->num = 0;
+	    return 0;
+	}
+    wc->start = (int *)malloc((wc->num + 1) * sizeof(int));
+    wc->cost  = (double *)calloc(wc->num, sizeof(double));
+    if (wc->start == NULL || wc->cost == NULL)
+	{
+	    printf("NOT enough memory! work chunks\n");
+	    work_chunk_free(wc);
+	    return 0;
+	}
+    for (c = 0; c <= wc->num; c++)
+	wc->start[c] = (int)((long)n * c / wc->num);
+    return wc->num;
+}
+
+/**
+ * @brief This function frees the chunks of a loop.
+ */
+void work_chunk_free(struct work_chunk * wc)
+{
+    free(wc->start);
+    free(wc->cost);
+    wc->start = NULL;
+    wc->cost  = NULL;
+    wc->num   = 0;
+}
+
+/**
+ * @brief This function re-partitions the items into the chunks of the same cost measured in the last sweep.
+ * @details The measured cost of a chunk is spread evenly over its items, and the new bounds of the chunks are
+ *          the items at which the accumulated cost reaches the equal shares of the total cost.
+ *          Each chunk keeps at least one item. The chunks stay as they are if no cost has been measured.
+ * @param[in,out] wc: Pointer to the chunks, the costs of which have been measured.
+ */
+void work_chunk_balance(struct work_chunk * wc)
+{
+    int c, k, j;
+    double total = 0.0, share, acc, s;
+    const int num = wc->num;
+    int * start;
+
+    for (c = 0; c < num; c++)
+	total += wc->cost[c];
+    if (num <= 1 || !(total > 0.0))
+	return;
+    start = (int *)malloc((num + 1) * sizeof(int));
+    if (start == NULL)
+	return;
+    start[0] = 0;
+    acc = 0.0; // the cost accumulated before the chunk c of the last sweep
+    c = 0;
+    for (k = 1; k < num; k++)
+	{
+	    share = total * k / num;
+	    while (c < num-1 && acc + wc->cost[c] < share)
+		acc += wc->cost[c++];
+	    // the item of the chunk c at which the share is reached
+	    s = wc->cost[c] > 0.0 ? (share - acc) / wc->cost[c] : 0.0;
+	    j = wc->start[c] + (int)(s * (wc->start[c+1] - wc->start[c]) + 0.5);
+	    start[k] = MIN(MAX(j, start[k-1] + 1), wc->n - (num - k));
+	}
+    start[num] = wc->n;
+    free(wc->start);
+    wc->start = start;
+    for (c = 0; c < num; c++)
+	wc->cost[c] = 0.0;
+}